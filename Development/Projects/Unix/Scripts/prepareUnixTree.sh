@@ -48,6 +48,10 @@ ln -sf "../../../../SDK/Examples/Import Test/Import Test.c" ImportTest.c
 ln -sf "../../../../SDK/Examples/Camera Test/Camera Test.c" CameraTest.c
 ln -sf "../../../../SDK/Examples/Dump Group/Dump Group.c" DumpGroup.c
 ln -sf "../../../../SDK/Examples/Light Test/Light Test.c" LightTest.c
+ln -sf "../../../../SDK/Extras/Math Benchmark/Math Benchmark.cpp" MathBenchmark.cpp
+ln -sf "../../../../SDK/Extras/Pick Benchmark/Pick Benchmark.cpp" PickBenchmark.cpp
+ln -sf "../../../../SDK/Extras/Tessellation Benchmark/Tessellation Benchmark.cpp" TessellationBenchmark.cpp
+ln -sf "../../../../SDK/Extras/TriMesh Cache Report/TriMesh Cache Report.cpp" TriMeshCacheReport.cpp
 
 mkdir Models
 pushd Models
@@ -65,6 +65,7 @@
 #include "E3GeometryEllipse.h"
 #include "E3GeometryEllipsoid.h"
 #include "E3GeometryGeneralPolygon.h"
+#include "E3GeometryInstanceArray.h"
 #include "E3GeometryLine.h"
 #include "E3GeometryMarker.h"
 #include "E3GeometryMesh.h"
@@ -747,6 +748,9 @@ E3Geometry_RegisterClass ( void )
 	if ( qd3dStatus != kQ3Failure )
 		qd3dStatus = E3GeometryGeneralPolygon_RegisterClass () ;
 
+	if ( qd3dStatus != kQ3Failure )
+		qd3dStatus = E3GeometryInstanceArray_RegisterClass () ;
+
 	if ( qd3dStatus != kQ3Failure )
 		qd3dStatus = E3GeometryLine_RegisterClass () ;
 
@@ -813,6 +817,7 @@ E3Geometry_UnregisterClass(void)
 	E3GeometryEllipse_UnregisterClass();
 	E3GeometryEllipsoid_UnregisterClass();
 	E3GeometryGeneralPolygon_UnregisterClass();
+	E3GeometryInstanceArray_UnregisterClass();
 	E3GeometryLine_UnregisterClass();
 	E3GeometryMarker_UnregisterClass();
 	E3GeometryMesh_UnregisterClass();
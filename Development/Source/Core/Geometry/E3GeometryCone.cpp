@@ -48,11 +48,22 @@
 #include "E3Geometry.h"
 #include "E3GeometryTriMesh.h"
 #include "E3GeometryCone.h"
+#include "E3GeometryQuadricTemplate.h"
 #include "QuesaMathOperators.hpp"
 
 
 
 
+//=============================================================================
+//      Internal constants
+//-----------------------------------------------------------------------------
+// Face template flags
+const TQ3Uns32 kConeFaceTipPresent						= (1 << 0);
+
+
+
+
+
 //=============================================================================
 //      Internal types
 //-----------------------------------------------------------------------------
@@ -224,25 +235,25 @@ e3geom_cone_duplicate(TQ3Object fromObject, const void *fromPrivateData,
 
 
 //=============================================================================
-//      e3geom_cone_create_face : Helper for e3geom_cone_cache_new.
+//      e3geom_cone_build_face : Build the unit-cone face template.
 //-----------------------------------------------------------------------------
-static void e3geom_cone_create_face( TQ3GroupObject ioGroup, const TQ3ConeData* inData,
-	TQ3Uns32 inNumSides, TQ3Uns32 inNumBands, TQ3Boolean inTipPresent )
+//		Note :	The unit cone has the parametric equation
+//				f(u,v) = ((1-v)cos(u), (1-v)sin(u), v),
+//				where u ranges from 0 to 2pi and v ranges from 0 to 1 (0 being
+//				the base).  The cross product of the partial derivatives,
+//				less the nonnegative scalar 1-v, gives the outward normal
+//				(cos(u), sin(u), 1), the same at every v.
+//-----------------------------------------------------------------------------
+static void
+e3geom_cone_build_face( const TE3QuadricTemplateKey& inKey,
+						TE3QuadricTemplate& outTemplate )
 {
+	const TQ3Uns32		inNumSides = inKey.uSegments;
+	const TQ3Uns32		inNumBands = inKey.vSegments;
+	const bool			inTipPresent = (inKey.flags & kConeFaceTipPresent) != 0;
 	float				ang, dang, cosAngle, sinAngle;
 	float				startAngle, endAngle;
 	float				v, vStep;
-	TQ3Vector3D			sideVec, radialVec;
-	TQ3Vector3D			vertNormVec;
-	TQ3Point3D			bottomPt;
-	TQ3Vector3D			majXMinor, majXOrient, minXOrient;
-	TQ3Param2D			*uvs;
-	TQ3TriMeshData		triMeshData;
-	TQ3GeometryObject	theTriMesh;
-	TQ3Point3D 			*points;
-	TQ3Vector3D 		*normals;
-	TQ3TriMeshTriangleData *triangles;
-	TQ3TriMeshAttributeData vertexAttributes[2];
 	TQ3Uns32			numpoints, numFaces;
 	TQ3Uns32			i, j;
 
@@ -250,36 +261,14 @@ static void e3geom_cone_create_face( TQ3GroupObject ioGroup, const TQ3ConeData*
 
 	// Turn the u limits into a counterclockwise angle range in radians, and
 	// figure the angle step size.
-	startAngle = inData->uMin * kQ32Pi;
-	endAngle = inData->uMax * kQ32Pi;
+	startAngle = inKey.uMin * kQ32Pi;
+	endAngle = inKey.uMax * kQ32Pi;
 	dang = (endAngle - startAngle) / inNumSides;
 
 
 
 	// Band step size
-	vStep = (inData->vMax - inData->vMin) / inNumBands;
-
-
-
-	// Normal computation:
-	// The cone has a parametric equation
-	// f(u,v) = origin + v*orientation + (1-v)(cos(u)majorRadius + sin(u)minorRadius)
-	// where u ranges from 0 to 2pi and v ranges from 0 to 1 (0 being the base).
-	// Therefore we can get a surface normal as the cross product of partial
-	// derivatives,
-	// ((1-v)(-sin(u)majorRadius + cos(u)minorRadius) x
-	//		(orientation - cos(u) majorRadius - sin(u)minorRadius)
-	// = (1-v)[ -sin(u)majorRadius x orientation +sin(u)sin(u)majorRadius x minorRadius
-	//			+ cos(u)minorRadius x orientation - cos(u)cos(u)minorRadius x majorRadius ]
-	// = (1-v)[ -sin(u)majorRadius x orientation + cos(u)minorRadius x orientation
-	//			+ majorRadius x minorRadius ].
-	// So long as (majorRadius, minorRadius, orientation) forms a right-handed system,
-	// this will be an outward normal.  We can omit the nonnegative scalar 1-v.
-
-	// Best to compute those 3 cross products outside of any loops.
-	majXMinor = Q3Cross3D( inData->majorRadius, inData->minorRadius );
-	majXOrient = Q3Cross3D( inData->majorRadius, inData->orientation );
-	minXOrient = Q3Cross3D( inData->minorRadius, inData->orientation );
+	vStep = (inKey.vMax - inKey.vMin) / inNumBands;
 
 
 
@@ -300,22 +289,15 @@ static void e3geom_cone_create_face( TQ3GroupObject ioGroup, const TQ3ConeData*
 		numFaces = 2 * inNumSides * inNumBands;
 	}
 
-
-
-	// Allocate some memory for the TriMesh
-	points    = (TQ3Point3D *)             Q3Memory_Allocate( static_cast<TQ3Uns32>(numpoints*sizeof(TQ3Point3D)) );
-	normals   = (TQ3Vector3D *)            Q3Memory_Allocate( static_cast<TQ3Uns32>(numpoints*sizeof(TQ3Vector3D)) );
-	uvs       = (TQ3Param2D  *)            Q3Memory_Allocate( static_cast<TQ3Uns32>(numpoints * sizeof(TQ3Param2D)) );
-	triangles = (TQ3TriMeshTriangleData *) Q3Memory_Allocate( static_cast<TQ3Uns32>(numFaces*sizeof(TQ3TriMeshTriangleData)) );
-	if (points == nullptr || normals == nullptr || uvs == nullptr || triangles == nullptr)
-	{
-		Q3Memory_Free(&points);
-		Q3Memory_Free(&normals);
-		Q3Memory_Free(&uvs);
-		Q3Memory_Free(&triangles);
-		
-		return;
-	}
+	outTemplate.points.resize( numpoints );
+	outTemplate.normals.resize( numpoints );
+	outTemplate.uvs.resize( numpoints );
+	outTemplate.triangles.resize( numFaces );
+	
+	TQ3Point3D*					points = &outTemplate.points[0];
+	TQ3Vector3D*				normals = &outTemplate.normals[0];
+	TQ3Param2D*					uvs = &outTemplate.uvs[0];
+	TQ3TriMeshTriangleData*		triangles = &outTemplate.triangles[0];
 
 
 
@@ -331,35 +313,17 @@ static void e3geom_cone_create_face( TQ3GroupObject ioGroup, const TQ3ConeData*
 		cosAngle = (float) cos(ang);
 		sinAngle = (float) sin(ang);
 
-		// Compute part of what we need for points.
-		// In the parametric equation for the cone, for a fixed u let
-		//	radialVec = cos(u)majorRadius + sin(u)minorRadius
-		// and then the equation becomes
-		// f(u,v) = origin + v*orientation + (1-v)radialVec
-		//		  = origin + radialVec + v*(orientation - radialVec).
-		// We will let bottomPt stand for origin + radialVec, and let
-		// sideVec stand for orientation - radialVec, so the points at this
-		// value of u will be given by bottomPt + v * sideVec.
-		radialVec = cosAngle * inData->majorRadius + sinAngle * inData->minorRadius;
-		sideVec = inData->orientation - radialVec;
-		bottomPt = inData->origin + radialVec;
-		
-
-		// The vertex normal is the same for all points at this angle.
-		// One way to derive the direction is to take the cross product of the
-		// two partial derivatives of f(u,v) and simplify, bearing in mind that
-		// the cross of a vector with itself is zero.
-		vertNormVec = Q3Normalize3D( - sinAngle * majXOrient +
-			cosAngle * minXOrient + majXMinor );
-
-		
-		for (j = 0, v = inData->vMin; j <= inNumBands; ++j, v += vStep)
+		for (j = 0, v = inKey.vMin; j <= inNumBands; ++j, v += vStep)
 		{
 			// Compute a point
-			points[(inNumSides+1)*j + i] = bottomPt + v * sideVec;
+			points[(inNumSides+1)*j + i].x = (1.0f - v) * cosAngle;
+			points[(inNumSides+1)*j + i].y = (1.0f - v) * sinAngle;
+			points[(inNumSides+1)*j + i].z = v;
 			
 			// Vertex normal
-			normals[(inNumSides+1)*j + i] = vertNormVec;
+			normals[(inNumSides+1)*j + i].x = cosAngle;
+			normals[(inNumSides+1)*j + i].y = sinAngle;
+			normals[(inNumSides+1)*j + i].z = 1.0f;
 			
 			// Surface parameters
 			uvs[(inNumSides+1)*j + i].u = i / ((float) inNumSides);
@@ -399,6 +363,60 @@ static void e3geom_cone_create_face( TQ3GroupObject ioGroup, const TQ3ConeData*
 			}
 		}
 	}
+}
+
+
+
+
+
+//=============================================================================
+//      e3geom_cone_create_face : Helper for e3geom_cone_cache_new.
+//-----------------------------------------------------------------------------
+//		Note :	The cone is the image of the unit cone under the map taking
+//				x, y, z to majorRadius, minorRadius, orientation.  So long as
+//				that is a right-handed system, the normals point outward.
+//-----------------------------------------------------------------------------
+static void e3geom_cone_create_face( TQ3GroupObject ioGroup, const TQ3ConeData* inData,
+	TQ3Uns32 inNumSides, TQ3Uns32 inNumBands, TQ3Boolean inTipPresent )
+{
+	TQ3TriMeshData		triMeshData;
+	TQ3GeometryObject	theTriMesh;
+	TQ3Point3D 			*points;
+	TQ3Vector3D 		*normals;
+	TQ3TriMeshAttributeData vertexAttributes[2];
+	TQ3Uns32			numpoints;
+
+
+
+	// Find the template
+	TE3QuadricTemplateKey	theKey = { kE3QuadricCone, inNumSides, inNumBands,
+		inData->uMin, inData->uMax, inData->vMin, inData->vMax,
+		(inTipPresent ? kConeFaceTipPresent : 0) };
+	const TE3QuadricTemplate* theTemplate = E3QuadricTemplate_Get( theKey,
+		e3geom_cone_build_face );
+	if (theTemplate == nullptr)
+		return;
+	
+	numpoints = static_cast<TQ3Uns32>( theTemplate->points.size() );
+
+
+
+	// Allocate some memory for the TriMesh
+	points    = (TQ3Point3D *)             Q3Memory_Allocate( static_cast<TQ3Uns32>(numpoints*sizeof(TQ3Point3D)) );
+	normals   = (TQ3Vector3D *)            Q3Memory_Allocate( static_cast<TQ3Uns32>(numpoints*sizeof(TQ3Vector3D)) );
+	if (points == nullptr || normals == nullptr)
+	{
+		Q3Memory_Free(&points);
+		Q3Memory_Free(&normals);
+		
+		return;
+	}
+
+
+
+	// Map the template onto the cone
+	E3QuadricTemplate_Instantiate( *theTemplate, inData->origin, inData->majorRadius,
+		inData->minorRadius, inData->orientation, kQ3False, points, normals );
 
 
 
@@ -408,13 +426,13 @@ static void e3geom_cone_create_face( TQ3GroupObject ioGroup, const TQ3ConeData*
 	vertexAttributes[0].attributeUseArray = nullptr;
 
 	vertexAttributes[1].attributeType     = kQ3AttributeTypeSurfaceUV;
-	vertexAttributes[1].data              = uvs;
+	vertexAttributes[1].data              = const_cast<TQ3Param2D*>( &theTemplate->uvs[0] );
 	vertexAttributes[1].attributeUseArray = nullptr;
 	
 	triMeshData.numPoints                 = numpoints;
 	triMeshData.points                    = points;
-	triMeshData.numTriangles              = numFaces;
-	triMeshData.triangles                 = triangles;
+	triMeshData.numTriangles              = static_cast<TQ3Uns32>( theTemplate->triangles.size() );
+	triMeshData.triangles                 = const_cast<TQ3TriMeshTriangleData*>( &theTemplate->triangles[0] );
 	triMeshData.numTriangleAttributeTypes = 0;
 	triMeshData.triangleAttributeTypes    = nullptr;
 	triMeshData.numEdges                  = 0;
@@ -444,8 +462,6 @@ static void e3geom_cone_create_face( TQ3GroupObject ioGroup, const TQ3ConeData*
 	// Clean up
 	Q3Memory_Free(&points);
 	Q3Memory_Free(&normals);
-	Q3Memory_Free(&uvs);
-	Q3Memory_Free(&triangles);
 }
 
 
@@ -48,6 +48,7 @@
 #include "E3Geometry.h"
 #include "E3GeometryTriMesh.h"
 #include "E3GeometryCylinder.h"
+#include "E3GeometryQuadricTemplate.h"
 
 
 
@@ -232,6 +233,89 @@ e3geom_cylinder_duplicate(TQ3Object fromObject, const void *fromPrivateData,
 
 
 
+//=============================================================================
+//      e3geom_cylinder_build_side : Build the unit-cylinder side template.
+//-----------------------------------------------------------------------------
+//		Note :	The unit cylinder has the parametric equation
+//				f(s,t) = (cos(t), sin(t), s),
+//				and its outward normal is (cos(t), sin(t), 0).  The bottom
+//				points are at s = vMin, and each top point follows them at
+//				s = vMax.  Extra points close the seam with proper UVs.
+//-----------------------------------------------------------------------------
+static void
+e3geom_cylinder_build_side( const TE3QuadricTemplateKey& inKey,
+							TE3QuadricTemplate& outTemplate )
+{
+	const TQ3Uns32				sides = inKey.uSegments;
+	float						ang, dang, cosAngle, sinAngle;
+	float						startAngle, endAngle;
+	TQ3Uns32					i;
+
+
+
+	// Turn the u limits into an angle range in radians.
+	startAngle = inKey.uMin * kQ32Pi;
+	endAngle   = inKey.uMax * kQ32Pi;
+	if (startAngle > endAngle)
+		startAngle -= kQ32Pi;
+	dang = (endAngle - startAngle) / sides;
+
+	outTemplate.points.resize( 2 * sides + 2 );
+	outTemplate.normals.resize( 2 * sides + 2 );
+	outTemplate.uvs.resize( 2 * sides + 2 );
+	outTemplate.triangles.resize( 2 * sides );
+	
+	TQ3Point3D*					points = &outTemplate.points[0];
+	TQ3Vector3D*				normals = &outTemplate.normals[0];
+	TQ3Param2D*					uvs = &outTemplate.uvs[0];
+	TQ3TriMeshTriangleData*		triangles = &outTemplate.triangles[0];
+
+
+
+	// Compute points, normals, UVs, and triangles for each side
+	for (i=0, ang = startAngle; i <= sides; ++i, ang += dang)
+	{
+		cosAngle = (float) cos(ang);
+		sinAngle = (float) sin(ang);
+
+		// bottom point, and the corresponding top point
+		points[i].x = cosAngle;
+		points[i].y = sinAngle;
+		points[i].z = inKey.vMin;
+		points[i+sides+1] = points[i];
+		points[i+sides+1].z = inKey.vMax;
+
+		// the normal is the same at the top and the bottom
+		normals[i].x = cosAngle;
+		normals[i].y = sinAngle;
+		normals[i].z = 0.0f;
+		normals[i+sides+1] = normals[i];
+
+		// uvs come from the surface parameterisation
+		uvs[i].u         = i / (float) sides;
+		uvs[i].v         = 0.0f;
+		uvs[i + sides + 1].u = uvs[i].u;
+		uvs[i + sides + 1].v = 1.0f;
+
+		if (i<sides)
+		{
+			// make the triangle with point up
+			triangles[i].pointIndices[0] = i+sides+1;
+			triangles[i].pointIndices[1] = i;
+			triangles[i].pointIndices[2] = i+1;
+			
+			// make the triangle with point down
+			triangles[i+sides].pointIndices[0] = i+sides+1;
+			triangles[i+sides].pointIndices[1] = i+1;
+			triangles[i+sides].pointIndices[2] = i+sides+2;
+		}
+	}
+}
+
+
+
+
+
 //=============================================================================
 //      e3geom_cylinder_cache_new : Cylinder cache new method.
 //-----------------------------------------------------------------------------
@@ -240,9 +324,8 @@ e3geom_cylinder_cache_new(TQ3ViewObject theView, TQ3GeometryObject theGeom,
 	const void *geomDataParam)
 {
 	const TQ3CylinderData* geomData = (const TQ3CylinderData*) geomDataParam;
-	float						ang=0.0f, dang, cosAngle, sinAngle;
+	float						ang=0.0f, cosAngle, sinAngle;
 	float						startAngle, endAngle, angleRange;
-	TQ3Vector3D					orientCrossMaj, orientCrossMin;
 	float						uMin, uMax, vMin, vMax;
 	TQ3Point3D					bottomCenter, topCenter;
 	TQ3TriMeshAttributeData		vertexAttributes[2];
@@ -252,14 +335,11 @@ e3geom_cylinder_cache_new(TQ3ViewObject theView, TQ3GeometryObject theGeom,
 	TQ3TriMeshData				triMeshData;
 	TQ3GeometryObject			theTriMesh;
 	TQ3Uns32					sides = 10;
-	TQ3TriMeshTriangleData		*triangles;
 	TQ3Uns32					numpoints;
 	TQ3Vector3D					*normals;
 	TQ3StyleObject				theStyle;
 	TQ3GroupObject				theGroup;
 	TQ3Point3D					*points;
-	TQ3Param2D					*uvs;
-	TQ3Uns32					i;
 	TQ3Vector3D					v;
 
 
@@ -375,41 +455,6 @@ e3geom_cylinder_cache_new(TQ3ViewObject theView, TQ3GeometryObject theGeom,
 
 
 
-	// Allocate some memory for the TriMesh
-	points    = (TQ3Point3D *)             Q3Memory_Allocate(static_cast<TQ3Uns32>(numpoints*sizeof(TQ3Point3D)) );
-	normals   = (TQ3Vector3D *)            Q3Memory_Allocate(static_cast<TQ3Uns32>(numpoints*sizeof(TQ3Vector3D)) );
-	uvs       = (TQ3Param2D  *)            Q3Memory_Allocate(static_cast<TQ3Uns32>(numpoints*sizeof(TQ3Param2D)));
-	triangles = (TQ3TriMeshTriangleData *) Q3Memory_Allocate( static_cast<TQ3Uns32>(2*sides*sizeof(TQ3TriMeshTriangleData)) );
-
-	if (points == nullptr || normals == nullptr || uvs == nullptr || triangles == nullptr)
-		{
-		Q3Memory_Free(&points);
-		Q3Memory_Free(&normals);
-		Q3Memory_Free(&uvs);
-		Q3Memory_Free(&triangles);
-		
-		return(theGroup);
-		}
-
-
-
-	// now, define each side, as a cosine/sine combination of major and minor radius vectors
-	// (also compute vertex normals while we're at it)
-	
-	// A cylinder has a parametric equation
-	// f(s,t) = origin + s*orientation + cos(t)majorRadius + sin(t)minorRadius .
-	// We can derive a normal vector by taking the cross product of the two partial
-	// derivatives:
-	// (partial f with respect to s) x (partial f with respect to t) =
-	// 		orientation x (-sin(t)majorRadius + cos(t)minorRadius) =
-	//		-sin(t)(orientation x majorRadius) + cos(t)(orientation x minorRadius) .
-	// If (majorRadius, minorRadius, orientation) forms a right-handed system, then
-	// this normal points inward, so will need to be negated.
-	Q3Vector3D_Cross( &geomData->orientation, &geomData->minorRadius, &orientCrossMin );
-	Q3Vector3D_Cross( &geomData->orientation, &geomData->majorRadius, &orientCrossMaj );
-	
-	
-	
 	// Test whether the geometry is degenerate.
 	if (E3Geometry_IsDegenerateTriple( &geomData->orientation, &geomData->majorRadius,
 		&geomData->minorRadius ))
@@ -420,51 +465,33 @@ e3geom_cylinder_cache_new(TQ3ViewObject theView, TQ3GeometryObject theGeom,
 
 
 
-	// Compute points, normals, UVs, and triangles for each side
-	dang = angleRange / sides;
-	
-	for (i=0, ang = startAngle; i <= sides; ++i, ang += dang)
-	{
-		cosAngle = (float) cos(ang);
-		sinAngle = (float) sin(ang);
-
-		// bottom point is bottomCenter + cos(major) + sin(minor)
-		Q3Vector3D_Scale( &geomData->majorRadius, cosAngle, &v );
-		Q3Point3D_Vector3D_Add( &bottomCenter, &v, &points[i] );
-		Q3Vector3D_Scale( &geomData->minorRadius, sinAngle, &v );
-		Q3Point3D_Vector3D_Add( &points[i], &v, &points[i] );
-
-		// compute normal of bottom point
-		Q3Vector3D_Scale( &orientCrossMaj, -sinAngle, &normals[i] );
-		Q3Vector3D_Scale( &orientCrossMin, cosAngle, &v );
-		Q3Vector3D_Add( &normals[i], &v, &normals[i] );
-		Q3Vector3D_Negate( &normals[i], &normals[i] );
+	// Find the template of the side
+	TE3QuadricTemplateKey	theKey = { kE3QuadricCylinder, sides, 1,
+		uMin, uMax, vMin, vMax, 0 };
+	const TE3QuadricTemplate* theTemplate = E3QuadricTemplate_Get( theKey,
+		e3geom_cylinder_build_side );
+	if (theTemplate == nullptr)
+		return theGroup;
 
-		// corresponding top point is bottom point + sideVec
-		Q3Point3D_Vector3D_Add( &points[i], &sideVec, &points[i+sides+1] );
 
-		// and its normal is exactly the same as the bottom one
-		normals[i+sides+1] = normals[i];		
 
-		// uvs come from the surface parameterisation
-		uvs[i].u         = i / (float) sides;
-		uvs[i].v         = 0.0f;
-		uvs[i + sides + 1].u = uvs[i].u;
-		uvs[i + sides + 1].v = 1.0f;
+	// Allocate some memory for the TriMesh
+	points    = (TQ3Point3D *)             Q3Memory_Allocate(static_cast<TQ3Uns32>(numpoints*sizeof(TQ3Point3D)) );
+	normals   = (TQ3Vector3D *)            Q3Memory_Allocate(static_cast<TQ3Uns32>(numpoints*sizeof(TQ3Vector3D)) );
 
-		if (i<sides)
+	if (points == nullptr || normals == nullptr)
 		{
-			// make the triangle with point up
-			triangles[i].pointIndices[0] = i+sides+1;
-			triangles[i].pointIndices[1] = i;
-			triangles[i].pointIndices[2] = i+1;
-			
-			// make the triangle with point down
-			triangles[i+sides].pointIndices[0] = i+sides+1;
-			triangles[i+sides].pointIndices[1] = i+1;
-			triangles[i+sides].pointIndices[2] = i+sides+2;
+		Q3Memory_Free(&points);
+		Q3Memory_Free(&normals);
+		
+		return(theGroup);
 		}
-	}
+
+
+
+	// Map the template onto the cylinder
+	E3QuadricTemplate_Instantiate( *theTemplate, geomData->origin, geomData->majorRadius,
+		geomData->minorRadius, geomData->orientation, kQ3False, points, normals );
 
 
 
@@ -474,13 +501,13 @@ e3geom_cylinder_cache_new(TQ3ViewObject theView, TQ3GeometryObject theGeom,
 	vertexAttributes[0].attributeUseArray = nullptr;
 
 	vertexAttributes[1].attributeType     = kQ3AttributeTypeSurfaceUV;
-	vertexAttributes[1].data              = uvs;
+	vertexAttributes[1].data              = const_cast<TQ3Param2D*>( &theTemplate->uvs[0] );
 	vertexAttributes[1].attributeUseArray = nullptr;
 
 	triMeshData.numPoints                 = numpoints;
 	triMeshData.points                    = points;
 	triMeshData.numTriangles              = 2*sides;
-	triMeshData.triangles                 = triangles;
+	triMeshData.triangles                 = const_cast<TQ3TriMeshTriangleData*>( &theTemplate->triangles[0] );
 	triMeshData.numTriangleAttributeTypes = 0;
 	triMeshData.triangleAttributeTypes    = nullptr;
 	triMeshData.numEdges                  = 0;
@@ -670,8 +697,6 @@ e3geom_cylinder_cache_new(TQ3ViewObject theView, TQ3GeometryObject theGeom,
 	// Clean up
 	Q3Memory_Free(&points);
 	Q3Memory_Free(&normals);
-	Q3Memory_Free(&uvs);
-	Q3Memory_Free(&triangles);
 
 
 
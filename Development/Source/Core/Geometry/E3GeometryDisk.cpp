@@ -47,6 +47,7 @@
 #include "E3View.h"
 #include "E3Geometry.h"
 #include "E3GeometryDisk.h"
+#include "E3GeometryQuadricTemplate.h"
 #include "E3ErrorManager.h"
 
 
@@ -158,19 +159,15 @@ e3geom_disk_duplicate(TQ3Object fromObject, const void *fromPrivateData,
 
 
 //=============================================================================
-//      e3geom_disk_calc_point : Compute a point in the disk.
+//      e3geom_disk_calc_point : Compute a point in the unit disk.
 //-----------------------------------------------------------------------------
 static void
-e3geom_disk_calc_point( const TQ3DiskData *inGeomData, float inSine, float inCosine,
-	float inRadialScale, TQ3Point3D* outPoint )
+e3geom_disk_calc_point( float inSine, float inCosine, float inRadialScale,
+	TQ3Point3D* outPoint )
 {
-	TQ3Vector3D		theVector;
-
-	Q3Vector3D_Scale(&inGeomData->majorRadius, inRadialScale * inCosine, &theVector);
-	Q3Point3D_Vector3D_Add(&inGeomData->origin, &theVector, outPoint);
-
-	Q3Vector3D_Scale(&inGeomData->minorRadius, inRadialScale * inSine, &theVector);
-	Q3Point3D_Vector3D_Add(outPoint, &theVector, outPoint);
+	outPoint->x = inRadialScale * inCosine;
+	outPoint->y = inRadialScale * inSine;
+	outPoint->z = 0.0f;
 }
 
 
@@ -178,52 +175,28 @@ e3geom_disk_calc_point( const TQ3DiskData *inGeomData, float inSine, float inCos
 
 
 //=============================================================================
-//      e3geom_disk_cache_new : Disk cache new method.
+//      e3geom_disk_build : Build the unit-disk template.
 //-----------------------------------------------------------------------------
-static TQ3Object
-e3geom_disk_cache_new(TQ3ViewObject theView, TQ3GeometryObject theGeom, const void *geomDataParam)
+//		Note :	The unit disk is the set of points r(cos(u), sin(u), 0) with
+//				vMin <= r <= vMax, and its normal is (0, 0, 1).
+//-----------------------------------------------------------------------------
+static void
+e3geom_disk_build( const TE3QuadricTemplateKey& inKey, TE3QuadricTemplate& outTemplate )
 {
-	const TQ3DiskData* geomData = (const TQ3DiskData*) geomDataParam;
-	
+	const TQ3Uns32				numSides = inKey.uSegments;
+	const float					vMin = inKey.vMin;
+	const float					vMax = inKey.vMax;
 	float						theAngle, deltaAngle, cosAngle, sinAngle;
-	TQ3Uns32					numSides, numPoints, numTriangles, n;
+	TQ3Uns32					numPoints, numTriangles, n;
 	TQ3Boolean					isPartAngleRange, hasHoleInCenter;
 	float						startAngle, endAngle, angleRange;
-	float						uMin, uMax, vMin, vMax;
-	TQ3TriMeshAttributeData		vertexAttributes[2];
-	TQ3Vector3D					surfaceNormalVector;
-	TQ3SubdivisionStyleData		subdivisionData;
-	TQ3TriMeshTriangleData		*theTriangles;
-	TQ3TriMeshData				triMeshData;
-	TQ3Vector3D					*theNormals;
-	float						crossLength;
-	TQ3GeometryObject			theTriMesh;
-	TQ3Point3D					*thePoints;
-	TQ3Status					qd3dStatus;
-	TQ3GroupObject				theGroup;
-	TQ3Param2D					*theUVs;
 
 
 
-	// Get the UV limits and make sure they are valid.
-	// These are for specifying partial disks, and have little to do
-	// with surface UV coordinates.
-	uMin  = E3Num_Clamp(geomData->uMin, 0.0f, 1.0f);
-	uMax  = E3Num_Clamp(geomData->uMax, 0.0f, 1.0f);
-	vMin  = E3Num_Clamp(geomData->vMin, 0.0f, 1.0f);
-	vMax  = E3Num_Clamp(geomData->vMax, 0.0f, 1.0f);
-	// It is possible for uMin to be greater than uMax, so that
-	// we can specify which way to wrap around the circle.
-	// But it doesn't make sense for vMin to be greater than vMax.
-	if (vMin > vMax)
-		E3Float_Swap( vMin, vMax );
-	hasHoleInCenter = (vMin > kQ3RealZero)? kQ3True : kQ3False;
-	
-	
-	
 	// Turn the u limits into an angle range in radians.
-	startAngle = uMin * kQ32Pi;
-	endAngle = uMax * kQ32Pi;
+	hasHoleInCenter = (vMin > kQ3RealZero)? kQ3True : kQ3False;
+	startAngle = inKey.uMin * kQ32Pi;
+	endAngle = inKey.uMax * kQ32Pi;
 	if (startAngle > endAngle)
 		startAngle -= kQ32Pi;
 	angleRange = endAngle - startAngle;
@@ -232,52 +205,6 @@ e3geom_disk_cache_new(TQ3ViewObject theView, TQ3GeometryObject theGeom, const vo
 
 
 
-	// Get the subdivision style, to figure out how many sides we should have.
-	numSides   = 10;
-	qd3dStatus = Q3View_GetSubdivisionStyleState(theView, &subdivisionData);
-	if (qd3dStatus == kQ3Success)
-		{
-		switch (subdivisionData.method) {
-			case kQ3SubdivisionMethodConstant:
-				// For a disk, parameter c1 is the number of sides and c2 is unused
-				numSides = (TQ3Uns32) subdivisionData.c1;
-				break;
-			
-			case kQ3SubdivisionMethodWorldSpace:
-				// keep the length of any side less than or equal to c1
-				{
-					TQ3Matrix4x4	localToWorld;
-					TQ3Vector3D		bigRadius, workVec;
-					
-					// Find the longer of the two radius vectors.
-					bigRadius = geomData->majorRadius;
-					if (Q3Vector3D_LengthSquared( &geomData->majorRadius ) <
-						Q3Vector3D_LengthSquared( &geomData->minorRadius ) )
-					{
-						bigRadius = geomData->minorRadius;
-					}
-
-					// divide the circumference by c1
-					Q3View_GetLocalToWorldMatrixState( theView, &localToWorld );
-					Q3Vector3D_Transform( &bigRadius, &localToWorld, &workVec );
-					numSides = (TQ3Uns32) ((kQ32Pi * Q3Vector3D_Length(&workVec))
-							/ subdivisionData.c1);
-				}
-				break;
-
-			case kQ3SubdivisionMethodScreenSpace:
-				// Not implemented
-				break;
-			
-			default:
-				Q3_ASSERT(!"Unknown subdivision method");
-				break;
-			}
-		}
-	numSides  = E3Num_Clamp(numSides, 3, 256);
-	
-	
-	
 	// For a solid disk, we need one triangle for each side, but if there is a hole
 	// in the center, we need two triangles for each side.
 	// If the disk is not on the full angle range, we need extra points for the
@@ -297,27 +224,18 @@ e3geom_disk_cache_new(TQ3ViewObject theView, TQ3GeometryObject theGeom, const vo
 			numPoints += 1;
 	}
 
-
-
-	// Allocate the memory we need for the TriMesh data
-	thePoints    = (TQ3Point3D *)             Q3Memory_Allocate(static_cast<TQ3Uns32>(numPoints * sizeof(TQ3Point3D)));
-	theNormals   = (TQ3Vector3D *)            Q3Memory_Allocate(static_cast<TQ3Uns32>(numPoints * sizeof(TQ3Vector3D)));
-	theUVs       = (TQ3Param2D  *)            Q3Memory_Allocate(static_cast<TQ3Uns32>(numPoints * sizeof(TQ3Param2D)));
-	theTriangles = (TQ3TriMeshTriangleData *) Q3Memory_Allocate(static_cast<TQ3Uns32>(numTriangles * sizeof(TQ3TriMeshTriangleData)));
-
-	if (thePoints == nullptr || theNormals == nullptr || theUVs == nullptr || theTriangles == nullptr)
-		{
-		Q3Memory_Free(&thePoints);
-		Q3Memory_Free(&theNormals);
-		Q3Memory_Free(&theUVs);
-		Q3Memory_Free(&theTriangles);
-		
-		return(nullptr);
-		}
+	outTemplate.points.resize( numPoints );
+	outTemplate.normals.resize( numPoints );
+	outTemplate.uvs.resize( numPoints );
+	outTemplate.triangles.resize( numTriangles );
+	
+	TQ3Point3D*					thePoints = &outTemplate.points[0];
+	TQ3Param2D*					theUVs = &outTemplate.uvs[0];
+	TQ3TriMeshTriangleData*		theTriangles = &outTemplate.triangles[0];
 
 
 
-	// Define the sides, as a cosine/sine combination of major and minor radius vectors
+	// Define the sides, around the unit circle
 	deltaAngle = angleRange / (float) numSides;
 	for (n = 0, theAngle = startAngle; n < numSides; ++n, theAngle += deltaAngle)
 		{
@@ -329,12 +247,12 @@ e3geom_disk_cache_new(TQ3ViewObject theView, TQ3GeometryObject theGeom, const vo
 		// Set up the points
 		if (hasHoleInCenter)
 			{
-			e3geom_disk_calc_point( geomData, sinAngle, cosAngle, vMax, &thePoints[2*n] );
-			e3geom_disk_calc_point( geomData, sinAngle, cosAngle, vMin, &thePoints[2*n+1] );
+			e3geom_disk_calc_point( sinAngle, cosAngle, vMax, &thePoints[2*n] );
+			e3geom_disk_calc_point( sinAngle, cosAngle, vMin, &thePoints[2*n+1] );
 			}
 		else
 			{
-			e3geom_disk_calc_point( geomData, sinAngle, cosAngle, vMax, &thePoints[n] );
+			e3geom_disk_calc_point( sinAngle, cosAngle, vMax, &thePoints[n] );
 			}
 
 
@@ -403,9 +321,9 @@ e3geom_disk_cache_new(TQ3ViewObject theView, TQ3GeometryObject theGeom, const vo
 		sinAngle = (float) sin(theAngle);
 		if (hasHoleInCenter)
 			{
-			e3geom_disk_calc_point( geomData, sinAngle, cosAngle, vMax,
+			e3geom_disk_calc_point( sinAngle, cosAngle, vMax,
 				&thePoints[2*numSides] );
-			e3geom_disk_calc_point( geomData, sinAngle, cosAngle, vMin,
+			e3geom_disk_calc_point( sinAngle, cosAngle, vMin,
 				&thePoints[2*numSides+1] );
 			theUVs[2*numSides].u = (vMax * cosAngle + 1.0f) / 2.0f;
 			theUVs[2*numSides].v = (vMax * sinAngle + 1.0f) / 2.0f;
@@ -414,9 +332,9 @@ e3geom_disk_cache_new(TQ3ViewObject theView, TQ3GeometryObject theGeom, const vo
 			}
 		else
 			{
-			e3geom_disk_calc_point( geomData, sinAngle, cosAngle, vMax,
+			e3geom_disk_calc_point( sinAngle, cosAngle, vMax,
 				&thePoints[numSides] );
-			thePoints[numSides+1]  = geomData->origin;
+			e3geom_disk_calc_point( 0.0f, 1.0f, 0.0f, &thePoints[numSides+1] );
 			theUVs[numSides].u = (vMax * cosAngle + 1.0f) / 2.0f;
 			theUVs[numSides].v = (vMax * sinAngle + 1.0f) / 2.0f;
 			theUVs[numSides+1].u   = 0.5f;
@@ -427,7 +345,7 @@ e3geom_disk_cache_new(TQ3ViewObject theView, TQ3GeometryObject theGeom, const vo
 		{
 		if (hasHoleInCenter == kQ3False)
 			{
-			thePoints[numSides]  = geomData->origin;
+			e3geom_disk_calc_point( 0.0f, 1.0f, 0.0f, &thePoints[numSides] );
 			theUVs[numSides].u   = 0.5f;
 			theUVs[numSides].v   = 0.5f;
 			}
@@ -435,21 +353,146 @@ e3geom_disk_cache_new(TQ3ViewObject theView, TQ3GeometryObject theGeom, const vo
 
 
 
-	// Surface normal is the cross product of the majorRadius and minorRadius
+	// The normal is the same everywhere
+	for (n = 0; n < numPoints; ++n)
+		{
+		outTemplate.normals[n].x = 0.0f;
+		outTemplate.normals[n].y = 0.0f;
+		outTemplate.normals[n].z = 1.0f;
+		}
+}
+
+
+
+
+
+//=============================================================================
+//      e3geom_disk_cache_new : Disk cache new method.
+//-----------------------------------------------------------------------------
+static TQ3Object
+e3geom_disk_cache_new(TQ3ViewObject theView, TQ3GeometryObject theGeom, const void *geomDataParam)
+{
+	const TQ3DiskData* geomData = (const TQ3DiskData*) geomDataParam;
+	
+	TQ3Uns32					numSides, numPoints, n;
+	float						uMin, uMax, vMin, vMax;
+	TQ3TriMeshAttributeData		vertexAttributes[2];
+	TQ3Vector3D					surfaceNormalVector;
+	TQ3SubdivisionStyleData		subdivisionData;
+	TQ3TriMeshData				triMeshData;
+	TQ3Vector3D					*theNormals;
+	float						crossLength;
+	TQ3GeometryObject			theTriMesh;
+	TQ3Point3D					*thePoints;
+	TQ3Status					qd3dStatus;
+	TQ3GroupObject				theGroup;
+
+
+
+	// Get the UV limits and make sure they are valid.
+	// These are for specifying partial disks, and have little to do
+	// with surface UV coordinates.
+	uMin  = E3Num_Clamp(geomData->uMin, 0.0f, 1.0f);
+	uMax  = E3Num_Clamp(geomData->uMax, 0.0f, 1.0f);
+	vMin  = E3Num_Clamp(geomData->vMin, 0.0f, 1.0f);
+	vMax  = E3Num_Clamp(geomData->vMax, 0.0f, 1.0f);
+	// It is possible for uMin to be greater than uMax, so that
+	// we can specify which way to wrap around the circle.
+	// But it doesn't make sense for vMin to be greater than vMax.
+	if (vMin > vMax)
+		E3Float_Swap( vMin, vMax );
+
+
+
+	// Get the subdivision style, to figure out how many sides we should have.
+	numSides   = 10;
+	qd3dStatus = Q3View_GetSubdivisionStyleState(theView, &subdivisionData);
+	if (qd3dStatus == kQ3Success)
+		{
+		switch (subdivisionData.method) {
+			case kQ3SubdivisionMethodConstant:
+				// For a disk, parameter c1 is the number of sides and c2 is unused
+				numSides = (TQ3Uns32) subdivisionData.c1;
+				break;
+			
+			case kQ3SubdivisionMethodWorldSpace:
+				// keep the length of any side less than or equal to c1
+				{
+					TQ3Matrix4x4	localToWorld;
+					TQ3Vector3D		bigRadius, workVec;
+					
+					// Find the longer of the two radius vectors.
+					bigRadius = geomData->majorRadius;
+					if (Q3Vector3D_LengthSquared( &geomData->majorRadius ) <
+						Q3Vector3D_LengthSquared( &geomData->minorRadius ) )
+					{
+						bigRadius = geomData->minorRadius;
+					}
+
+					// divide the circumference by c1
+					Q3View_GetLocalToWorldMatrixState( theView, &localToWorld );
+					Q3Vector3D_Transform( &bigRadius, &localToWorld, &workVec );
+					numSides = (TQ3Uns32) ((kQ32Pi * Q3Vector3D_Length(&workVec))
+							/ subdivisionData.c1);
+				}
+				break;
+
+			case kQ3SubdivisionMethodScreenSpace:
+				// Not implemented
+				break;
+			
+			default:
+				Q3_ASSERT(!"Unknown subdivision method");
+				break;
+			}
+		}
+	numSides  = E3Num_Clamp(numSides, 3, 256);
+	
+	
+	
+	// Find the template
+	TE3QuadricTemplateKey	theKey = { kE3QuadricDisk, numSides, 1,
+		uMin, uMax, vMin, vMax, 0 };
+	const TE3QuadricTemplate* theTemplate = E3QuadricTemplate_Get( theKey,
+		e3geom_disk_build );
+	if (theTemplate == nullptr)
+		return(nullptr);
+	
+	numPoints = static_cast<TQ3Uns32>( theTemplate->points.size() );
+
+
+
+	// Allocate the memory we need for the TriMesh data
+	thePoints    = (TQ3Point3D *)             Q3Memory_Allocate(static_cast<TQ3Uns32>(numPoints * sizeof(TQ3Point3D)));
+	theNormals   = (TQ3Vector3D *)            Q3Memory_Allocate(static_cast<TQ3Uns32>(numPoints * sizeof(TQ3Vector3D)));
+
+	if (thePoints == nullptr || theNormals == nullptr)
+		{
+		Q3Memory_Free(&thePoints);
+		Q3Memory_Free(&theNormals);
+		
+		return(nullptr);
+		}
+
+
+
+	// Map the template onto the disk.  Its normal is the cross product of the
+	// majorRadius and minorRadius.
 	Q3Vector3D_Cross(&geomData->majorRadius, &geomData->minorRadius, &surfaceNormalVector);
+	E3QuadricTemplate_Instantiate( *theTemplate, geomData->origin, geomData->majorRadius,
+		geomData->minorRadius, surfaceNormalVector, kQ3False, thePoints, theNormals );
+
 	crossLength = Q3Vector3D_Length( &surfaceNormalVector );
 	if (crossLength <= kQ3RealZero)
 	{
 		surfaceNormalVector.x = 1.0f;	// arbitrary
+		surfaceNormalVector.y = 0.0f;
+		surfaceNormalVector.z = 0.0f;
 		E3ErrorManager_PostError( kQ3ErrorDegenerateGeometry, kQ3False );
-	}
-	else
-	{
-		Q3Vector3D_Scale( &surfaceNormalVector, 1.0f/crossLength, &surfaceNormalVector );
-	}
 
-	for (n = 0; n < numPoints; ++n)
-		theNormals[ n ] = surfaceNormalVector;
+		for (n = 0; n < numPoints; ++n)
+			theNormals[ n ] = surfaceNormalVector;
+	}
 
 
 
@@ -459,7 +502,7 @@ e3geom_disk_cache_new(TQ3ViewObject theView, TQ3GeometryObject theGeom, const vo
 	vertexAttributes[0].attributeUseArray = nullptr;
 
 	vertexAttributes[1].attributeType     = kQ3AttributeTypeSurfaceUV;
-	vertexAttributes[1].data              = theUVs;
+	vertexAttributes[1].data              = const_cast<TQ3Param2D*>( &theTemplate->uvs[0] );
 	vertexAttributes[1].attributeUseArray = nullptr;
 
 
@@ -467,8 +510,8 @@ e3geom_disk_cache_new(TQ3ViewObject theView, TQ3GeometryObject theGeom, const vo
 	// Initialise the TriMesh data
 	triMeshData.numPoints                 = numPoints;
 	triMeshData.points                    = thePoints;
-	triMeshData.numTriangles              = numTriangles;
-	triMeshData.triangles                 = theTriangles;
+	triMeshData.numTriangles              = static_cast<TQ3Uns32>( theTemplate->triangles.size() );
+	triMeshData.triangles                 = const_cast<TQ3TriMeshTriangleData*>( &theTemplate->triangles[0] );
 	triMeshData.numTriangleAttributeTypes = 0;
 	triMeshData.triangleAttributeTypes    = nullptr;
 	triMeshData.numEdges                  = 0;
@@ -492,8 +535,6 @@ e3geom_disk_cache_new(TQ3ViewObject theView, TQ3GeometryObject theGeom, const vo
 	// Clean up
 	Q3Memory_Free(&thePoints);
 	Q3Memory_Free(&theNormals);
-	Q3Memory_Free(&theUVs);
-	Q3Memory_Free(&theTriangles);
 
 
 
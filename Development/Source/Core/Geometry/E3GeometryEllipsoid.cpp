@@ -48,6 +48,7 @@
 #include "E3Geometry.h"
 #include "E3GeometryTriMesh.h"
 #include "E3GeometryEllipsoid.h"
+#include "E3GeometryQuadricTemplate.h"
 #include "CQ3ObjectRef.h"
 
 #include <vector>
@@ -56,6 +57,17 @@
 
 
 
+//=============================================================================
+//      Internal constants
+//-----------------------------------------------------------------------------
+// Face template flags
+const TQ3Uns32 kEllipsoidFaceNorthPresent				= (1 << 0);
+const TQ3Uns32 kEllipsoidFaceSouthPresent				= (1 << 1);
+
+
+
+
+
 //=============================================================================
 //      Internal types
 //-----------------------------------------------------------------------------
@@ -606,23 +618,26 @@ e3geom_ellipsoid_create_caps(
 
 
 //=============================================================================
-//      e3geom_ellipsoid_create_face : Create main surface
+//      e3geom_ellipsoid_build_face : Build the unit-sphere face template.
 //-----------------------------------------------------------------------------
-static CQ3ObjectRef
-e3geom_ellipsoid_create_face( const TQ3EllipsoidData& geomData,
-							float uMin, float uMax,
-							float vMin, float vMax,
-							bool isNorthPresent,
-							bool isSouthPresent,
-							TQ3Uns32 uSegments,
-							TQ3Uns32 vSegments )
+//		Note :	The unit sphere has the parametric equation
+//				f(u,v) = (sin(v)cos(u), sin(v)sin(u), -cos(v)),
+//				where u ranges from 0 to 2pi and v from 0 (south) to pi
+//				(north), and its outward normal at f(u,v) is f(u,v) itself.
+//				The ellipsoid is the image of the sphere under the map taking
+//				x, y, z to majorRadius, minorRadius, orientation.
+//-----------------------------------------------------------------------------
+static void
+e3geom_ellipsoid_build_face( const TE3QuadricTemplateKey& inKey,
+							TE3QuadricTemplate& outTemplate )
 {
-	TQ3TriMeshData				triMeshData;
+	const bool isNorthPresent = (inKey.flags & kEllipsoidFaceNorthPresent) != 0;
+	const bool isSouthPresent = (inKey.flags & kEllipsoidFaceSouthPresent) != 0;
+	const TQ3Uns32 uSegments = inKey.uSegments;
+	const TQ3Uns32 vSegments = inKey.vSegments;
 	TQ3Uns32 u, v, uMaxIndex;
 	float uang=0.0f, vang;
-	TQ3Vector3D vec, vec2, axis;	// (just temporaries used for intermediate results)
 	TQ3Uns32 pnum = 0, tnum = 0;
-	TQ3Vector3D		majXOrient, minXOrient, majXMinor;
 	float			sinUAngle, cosUAngle, sinVAngle, cosVAngle;
 
 
@@ -652,20 +667,16 @@ e3geom_ellipsoid_create_face( const TQ3EllipsoidData& geomData,
 		numPoints -= 1;
 	}
 
-
-
-	// Allocate some memory for the TriMesh
-	std::vector<TQ3Point3D>					points( numPoints );
-	std::vector<TQ3Vector3D>				normals( numPoints );
-	std::vector<TQ3Param2D>					uvs( numPoints );
-	std::vector<TQ3TriMeshTriangleData>		triangles( numTriangles );
-	std::vector<TQ3Vector3D>				faceNormals( numTriangles );
+	outTemplate.points.resize( numPoints );
+	outTemplate.normals.resize( numPoints );
+	outTemplate.uvs.resize( numPoints );
+	outTemplate.triangles.resize( numTriangles );
 
 
 
 	// Get the UV ranges
-	const float uDiff = uMax - uMin;
-	const float vDiff = vMax - vMin;
+	const float uDiff = inKey.uMax - inKey.uMin;
+	const float vDiff = inKey.vMax - inKey.vMin;
 	const float	uDelta = uDiff / uSegments;
 	const float vDelta = vDiff / vSegments;
 
@@ -674,59 +685,9 @@ e3geom_ellipsoid_create_face( const TQ3EllipsoidData& geomData,
 	const float uDeltaAngle = kQ32Pi * uDelta;
 	const float vDeltaAngle = kQ3Pi * vDelta;
 
-	// Normal vector computations:
-	// The ellipsoid has a parametric equation
-	// f(u,v) = origin - cos(v)orientation + sin(v)(cos(u)majorRadius + sin(u)minorRadius)
-	// where u ranges from 0 to 2 and v ranges from 0 to .
-	// If you consider the case where (majorRadius, minorRadius, orientation) form a
-	// right-handed system, with orientation pointing "up", then u increases in a
-	// counterclockwise direction and v increases from bottom to top.
-	// A normal vector can be computed as the cross product of the two partials,
-	// (-sin(u)sin(v)majorRadius + cos(u)sin(v)minorRadius) x
-	// (sin(v)orientation + cos(u)cos(v)majorRadius + sin(u)cos(v)minorRadius)
-	// = sin(v)[ -sin(u)sin(v)majorRadius x orientation
-	//			- sin(u)sin(u)cos(v)majorRadius x minorRadius
-	//			+ cos(u)sin(v)minorRadius x orientation
-	//			+ cos(u)cos(u)cos(v)minorRadius x majorRadius ]
-	// In the right-handed case, this gives us an inward-pointing normal, and in the
-	// left-handed case it's outward-pointing.
-	// Since we're going to normalize the vector anyway, we can forget the outer scalar
-	// factor of sin(v).  The rest simplifies to
-	// - sin(u)sin(v)majorRadius x orientation
-	// + cos(u)sin(v)minorRadius x orientation
-	//  - cos(v)majorRadius x minorRadius .
-	// Best to compute those 3 cross products outside of any loops.
-	Q3Vector3D_Cross( &geomData.majorRadius, &geomData.orientation, &majXOrient );
-	Q3Vector3D_Cross( &geomData.minorRadius, &geomData.orientation, &minXOrient );
-	Q3Vector3D_Cross( &geomData.majorRadius, &geomData.minorRadius, &majXMinor );
-	
-	// Right or left handed?
-	bool isRightHanded = (Q3Vector3D_Dot( &majXMinor, &geomData.orientation ) > 0.0);
-	
-	// At the v = 0 (south) pole, our normal vector formula boils down to -majXMinor, and
-	// at the v =  (north) pole it becomes majXMinor.  When the system is left-handed,
-	// the normals need to be negated to point outward.
-	TQ3Point3D		pole0, polePi;
-	Q3Point3D_Vector3D_Add( &geomData.origin, &geomData.orientation, &polePi );
-	Q3Point3D_Vector3D_Subtract( &geomData.origin, &geomData.orientation, &pole0 );
-	TQ3Vector3D		normPole0, normPolePi;
-	if (isRightHanded)
-	{
-		normPolePi = majXMinor;
-	}
-	else
-	{
-		Q3Vector3D_Negate( &majXMinor, &normPolePi );
-	}
-	Q3Vector3D_Normalize( &normPolePi, &normPolePi );
-	Q3Vector3D_Negate( &normPolePi, &normPole0 );
-
 
 	// Start filling in points, normals, uvs
-	pnum = 0;		// what point we're working on
-
-	
-	for (v = 0, vang = kQ3Pi * vMin;
+	for (v = 0, vang = kQ3Pi * inKey.vMin;
 		v <= vSegments;
 		++v, vang += vDeltaAngle)
 	{
@@ -743,41 +704,30 @@ e3geom_ellipsoid_create_face( const TQ3EllipsoidData& geomData,
 		}
 		
 		
-		for (u = 0, uang = kQ32Pi * uMin; u <= uMaxIndex; ++u, uang += uDeltaAngle)
+		for (u = 0, uang = kQ32Pi * inKey.uMin; u <= uMaxIndex; ++u, uang += uDeltaAngle)
 		{
 			sinUAngle = (float)sin(uang);
 			cosUAngle = (float)cos(uang);
 			
-			// start with point on equator around <0,0,0>: cos(major) + sin(minor)
-			Q3FastVector3D_Scale( &geomData.majorRadius, cosUAngle, &vec );
-			Q3FastVector3D_Scale( &geomData.minorRadius, sinUAngle, &vec2 );
-			Q3FastVector3D_Add( &vec2, &vec, &vec );
-			
-			// then, scale this and shift it into the proper row
-			Q3FastVector3D_Scale( &vec, sinVAngle, &vec );
-			Q3FastVector3D_Scale( &geomData.orientation, cosVAngle, &axis );
-			Q3FastVector3D_Subtract( &vec, &axis, &vec );
-			Q3FastPoint3D_Vector3D_Add( &geomData.origin, &vec, &points[pnum] );
-			
-			// Compute the vertex normal vector
-			Q3FastVector3D_Scale( &majXOrient, - sinUAngle * sinVAngle, &normals[pnum] );
-			Q3FastVector3D_Scale( &minXOrient, cosUAngle * sinVAngle, &vec );
-			Q3FastVector3D_Add( &vec, &normals[pnum], &normals[pnum] );
-			Q3FastVector3D_Scale( &majXMinor, - cosVAngle, &vec );
-			Q3FastVector3D_Add( &vec, &normals[pnum], &normals[pnum] );
-			if (! isRightHanded)
-				Q3FastVector3D_Negate( &normals[pnum], &normals[pnum] );
-			Q3FastVector3D_Normalize( &normals[pnum], &normals[pnum] );
+			// Point and normal on the unit sphere
+			outTemplate.points[pnum].x = sinVAngle * cosUAngle;
+			outTemplate.points[pnum].y = sinVAngle * sinUAngle;
+			outTemplate.points[pnum].z = -cosVAngle;
+			outTemplate.normals[pnum].x = outTemplate.points[pnum].x;
+			outTemplate.normals[pnum].y = outTemplate.points[pnum].y;
+			outTemplate.normals[pnum].z = outTemplate.points[pnum].z;
 
 			
 			// Set up the UVs
-			uvs[pnum].u = uDelta * u;
-			uvs[pnum].v = vDelta * v;
+			outTemplate.uvs[pnum].u = uDelta * u;
+			outTemplate.uvs[pnum].v = vDelta * v;
 
 
 			// Set up triangles for u, u+1 and v, v+1
 			if ( (u < uSegments) && (v < vSegments) )
 			{
+				TQ3TriMeshTriangleData* triangles = &outTemplate.triangles[0];
+
 				// end caps
 				if ( isSouthPresent && (v==0) )
 				{
@@ -809,12 +759,69 @@ e3geom_ellipsoid_create_face( const TQ3EllipsoidData& geomData,
 			pnum++;
 		}
 	}
+}
+
+
+
+
+
+//=============================================================================
+//      e3geom_ellipsoid_create_face : Create main surface
+//-----------------------------------------------------------------------------
+//		Note :	The points and normals are an affine image of a unit-sphere
+//				template shared by every ellipsoid with the same subdivision
+//				and parameter ranges.  In the right-handed case the
+//				transformed normals point outward; in the left-handed case
+//				they are negated to do so.
+//-----------------------------------------------------------------------------
+static CQ3ObjectRef
+e3geom_ellipsoid_create_face( const TQ3EllipsoidData& geomData,
+							float uMin, float uMax,
+							float vMin, float vMax,
+							bool isNorthPresent,
+							bool isSouthPresent,
+							TQ3Uns32 uSegments,
+							TQ3Uns32 vSegments )
+{
+	TQ3TriMeshData				triMeshData;
+
+
+
+	// Find the template
+	TE3QuadricTemplateKey	theKey = { kE3QuadricEllipsoid, uSegments, vSegments,
+		uMin, uMax, vMin, vMax, 0 };
+	if (isNorthPresent)
+		theKey.flags |= kEllipsoidFaceNorthPresent;
+	if (isSouthPresent)
+		theKey.flags |= kEllipsoidFaceSouthPresent;
+	
+	const TE3QuadricTemplate* theTemplate = E3QuadricTemplate_Get( theKey,
+		e3geom_ellipsoid_build_face );
+	if (theTemplate == nullptr)
+		return CQ3ObjectRef();
+
+	TQ3Uns32	numPoints = static_cast<TQ3Uns32>( theTemplate->points.size() );
+	TQ3Uns32	numTriangles = static_cast<TQ3Uns32>( theTemplate->triangles.size() );
+
+
+
+	// Allocate some memory for the TriMesh
+	std::vector<TQ3Point3D>					points( numPoints );
+	std::vector<TQ3Vector3D>				normals( numPoints );
+	std::vector<TQ3Vector3D>				faceNormals( numTriangles );
+
+
+
+	// Map the template onto the ellipsoid
+	E3QuadricTemplate_Instantiate( *theTemplate, geomData.origin,
+		geomData.majorRadius, geomData.minorRadius, geomData.orientation,
+		kQ3True, &points[0], &normals[0] );
 	
 	
 	
 	// Compute face normals
 	Q3Triangle_CrossProductArray( numTriangles, nullptr,
-		&triangles[0].pointIndices[0], &points[0], &faceNormals[0] );
+		&theTemplate->triangles[0].pointIndices[0], &points[0], &faceNormals[0] );
 
 
 
@@ -822,7 +829,8 @@ e3geom_ellipsoid_create_face( const TQ3EllipsoidData& geomData,
 	TQ3TriMeshAttributeData vertexAttributes[2] =
 	{
 		{ kQ3AttributeTypeNormal, &normals[0], nullptr },
-		{ kQ3AttributeTypeSurfaceUV, &uvs[0], nullptr }
+		{ kQ3AttributeTypeSurfaceUV,
+			const_cast<TQ3Param2D*>( &theTemplate->uvs[0] ), nullptr }
 	};
 	TQ3TriMeshAttributeData	faceAttributes[1] =
 	{
@@ -833,7 +841,8 @@ e3geom_ellipsoid_create_face( const TQ3EllipsoidData& geomData,
 	triMeshData.numPoints                 = numPoints;
 	triMeshData.points                    = &points[0];
 	triMeshData.numTriangles              = numTriangles;
-	triMeshData.triangles                 = &triangles[0];
+	triMeshData.triangles                 = const_cast<TQ3TriMeshTriangleData*>(
+												&theTemplate->triangles[0] );
 	triMeshData.numTriangleAttributeTypes = 1;
 	triMeshData.triangleAttributeTypes    = faceAttributes;
 	triMeshData.numEdges                  = 0;
@@ -856,6 +865,8 @@ e3geom_ellipsoid_create_face( const TQ3EllipsoidData& geomData,
 
 
 
+
+
 //=============================================================================
 //      e3geom_ellipsoid_cache_new : Ellipsoid cache new method.
 //-----------------------------------------------------------------------------
@@ -994,8 +1005,9 @@ e3geom_ellipsoid_cache_new( TQ3ViewObject theView, TQ3GeometryObject theGeom,
 	CQ3ObjectRef	theTriMesh( e3geom_ellipsoid_create_face( *geomData,
 		uMin, uMax, vMin, vMax, isNorthPolePresent, isSouthPolePresent,
 		uSegments, vSegments ) );
-	Q3Group_AddObject( (TQ3Object _Nonnull) resultGroup.get(),
-		(TQ3Object _Nonnull) theTriMesh.get() );
+	if (theTriMesh.isvalid())
+		Q3Group_AddObject( (TQ3Object _Nonnull) resultGroup.get(),
+			(TQ3Object _Nonnull) theTriMesh.get() );
 
 
 	// Do we need to add caps?
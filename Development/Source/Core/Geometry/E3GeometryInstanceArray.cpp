@@ -0,0 +1,1054 @@
+/*  NAME:
+        E3GeometryInstanceArray.cpp
+
+    DESCRIPTION:
+        Implementation of Quesa InstanceArray geometry class.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "E3Prefix.h"
+#include "E3View.h"
+#include "E3Pick.h"
+#include "E3Renderer.h"
+#include "E3Math.h"
+#include "E3Math_Intersect.h"
+#include "E3Geometry.h"
+#include "E3GeometryInstanceArray.h"
+#include "E3GeometryTriMesh.h"
+#include "CQ3ObjectRef.h"
+#include "QuesaMathOperators.hpp"
+
+#include <algorithm>
+#include <vector>
+
+
+
+
+
+//=============================================================================
+//      Internal types
+//-----------------------------------------------------------------------------
+class E3InstanceArray : public E3Geometry // This is a leaf class so no other classes use this,
+								// so it can be here in the .c file rather than in
+								// the .h file, hence all the fields can be public
+								// as nobody should be including this file
+	{
+Q3_CLASS_ENUMS ( kQ3GeometryTypeInstanceArray, E3InstanceArray, E3Geometry )
+public :
+
+	TQ3InstanceArrayData		instanceData ;
+
+	} ;
+
+
+
+typedef std::vector<TQ3Uns32>	InstanceIndexVec;
+
+
+
+
+
+//=============================================================================
+//      Internal functions
+//-----------------------------------------------------------------------------
+//      e3geom_instancearray_copydata : Copy TQ3InstanceArrayData.
+//-----------------------------------------------------------------------------
+//		Note :	If isDuplicate is true, we duplicate shared objects rather than
+//				obtaining new references to them.
+//-----------------------------------------------------------------------------
+static TQ3Status
+e3geom_instancearray_copydata( const TQ3InstanceArrayData* src,
+								TQ3InstanceArrayData* dst, TQ3Boolean isDuplicate )
+{
+	TQ3Status	q3status = kQ3Success;
+	TQ3Uns32	n;
+
+
+
+	// Copy the simple fields, and clear the rest so that a failure part way
+	// through leaves something we can safely empty
+	Q3Memory_Clear( dst, sizeof(TQ3InstanceArrayData) );
+	dst->numInstances = src->numInstances;
+	dst->bBox         = src->bBox;
+
+
+
+	// Copy the transforms
+	if (src->numInstances != 0)
+	{
+		TQ3Uns32 theSize = static_cast<TQ3Uns32>(src->numInstances * sizeof(TQ3Matrix4x4));
+		dst->transforms = (TQ3Matrix4x4 *) Q3Memory_Allocate( theSize );
+		if (dst->transforms == nullptr)
+			q3status = kQ3Failure;
+		else
+			Q3Memory_Copy( src->transforms, dst->transforms, theSize );
+	}
+
+
+
+	// Copy the per-instance attribute sets
+	if ( (q3status == kQ3Success) && (src->numInstances != 0) &&
+		(src->instanceAttributeSets != nullptr) )
+	{
+		TQ3Uns32 theSize = static_cast<TQ3Uns32>(src->numInstances * sizeof(TQ3AttributeSet));
+		dst->instanceAttributeSets = (TQ3AttributeSet *) Q3Memory_AllocateClear( theSize );
+		if (dst->instanceAttributeSets == nullptr)
+			q3status = kQ3Failure;
+
+		for (n = 0; (q3status == kQ3Success) && (n < src->numInstances); ++n)
+		{
+			TQ3AttributeSet atts = src->instanceAttributeSets[n];
+			if (atts == nullptr)
+				continue;
+			
+			if (isDuplicate)
+			{
+				dst->instanceAttributeSets[n] = Q3Object_Duplicate( atts );
+				if (dst->instanceAttributeSets[n] == nullptr)
+					q3status = kQ3Failure;
+			}
+			else
+			{
+				E3Shared_Acquire( &dst->instanceAttributeSets[n], atts );
+			}
+		}
+	}
+
+
+
+	// Copy the instanced object and the overall attribute set
+	if (q3status == kQ3Success)
+	{
+		if (isDuplicate)
+		{
+			dst->instancedObject = Q3Object_Duplicate( src->instancedObject );
+			if (dst->instancedObject == nullptr)
+				q3status = kQ3Failure;
+		}
+		else
+		{
+			E3Shared_Acquire( &dst->instancedObject, src->instancedObject );
+		}
+	}
+	
+	if ( (q3status == kQ3Success) && (src->instanceArrayAttributeSet != nullptr) )
+	{
+		if (isDuplicate)
+		{
+			dst->instanceArrayAttributeSet = Q3Object_Duplicate( src->instanceArrayAttributeSet );
+			if (dst->instanceArrayAttributeSet == nullptr)
+				q3status = kQ3Failure;
+		}
+		else
+		{
+			E3Shared_Acquire( &dst->instanceArrayAttributeSet, src->instanceArrayAttributeSet );
+		}
+	}
+
+
+
+	// Clean up after failure
+	if (q3status == kQ3Failure)
+	{
+		E3InstanceArray_EmptyData( dst );
+	}
+
+	return q3status;
+}
+
+
+
+
+
+//=============================================================================
+//      e3geom_instancearray_new : InstanceArray new method.
+//-----------------------------------------------------------------------------
+static TQ3Status
+e3geom_instancearray_new(TQ3Object theObject, void *privateData, const void *paramData)
+{	TQ3InstanceArrayData		*instanceData = (TQ3InstanceArrayData *)		privateData;
+	const TQ3InstanceArrayData	*arrayData    = (const TQ3InstanceArrayData *)	paramData;
+#pragma unused(theObject)
+
+
+
+	// Initialise our instance data
+	return e3geom_instancearray_copydata( arrayData, instanceData, kQ3False );
+}
+
+
+
+
+
+//=============================================================================
+//      e3geom_instancearray_delete : InstanceArray delete method.
+//-----------------------------------------------------------------------------
+static void
+e3geom_instancearray_delete(TQ3Object theObject, void *privateData)
+{	TQ3InstanceArrayData		*instanceData = (TQ3InstanceArrayData *) privateData;
+#pragma unused(theObject)
+
+
+
+	// Dispose of our instance data
+	E3InstanceArray_EmptyData(instanceData);
+}
+
+
+
+
+
+//=============================================================================
+//      e3geom_instancearray_duplicate : InstanceArray duplicate method.
+//-----------------------------------------------------------------------------
+static TQ3Status
+e3geom_instancearray_duplicate(TQ3Object fromObject, const void *fromPrivateData,
+							   TQ3Object toObject,   void       *toPrivateData)
+{	const TQ3InstanceArrayData	*fromInstanceData = (const TQ3InstanceArrayData *) fromPrivateData;
+	TQ3InstanceArrayData		*toInstanceData   = (TQ3InstanceArrayData *)       toPrivateData;
+#pragma unused(toObject)
+
+
+
+	// Validate our parameters
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(fromObject),    kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(toPrivateData), kQ3Failure);
+
+
+
+	// Copy the data from fromObject to toObject
+	return e3geom_instancearray_copydata( fromInstanceData, toInstanceData, kQ3True );
+}
+
+
+
+
+
+//=============================================================================
+//      e3geom_instancearray_get_local_bounds : Get the shared local bounds.
+//-----------------------------------------------------------------------------
+//		Note :	Returns false if we do not know the bounds of the instanced
+//				object, in which case instances can not be culled.
+//-----------------------------------------------------------------------------
+static bool
+e3geom_instancearray_get_local_bounds( const TQ3InstanceArrayData* instanceData,
+										TQ3BoundingBox& outBounds )
+{
+	// Use the bounds supplied by the application if we have them
+	if (! instanceData->bBox.isEmpty)
+	{
+		outBounds = instanceData->bBox;
+		return true;
+	}
+
+
+
+	// Otherwise see if the instanced object knows its own bounds. We ask each
+	// time rather than caching the answer, since the object may be edited.
+	TQ3Object theObject = instanceData->instancedObject;
+
+	if (Q3Object_IsType( theObject, kQ3GeometryTypeTriMesh ))
+	{
+		TQ3TriMeshData*		triMeshData;
+		if (kQ3Success == E3TriMesh_LockData( theObject, kQ3True, &triMeshData ))
+		{
+			outBounds = triMeshData->bBox;
+			E3TriMesh_UnlockData( theObject );
+			return ! outBounds.isEmpty;
+		}
+	}
+	
+	else if (Q3Object_IsType( theObject, kQ3GroupTypeDisplay ))
+	{
+		return (kQ3Success == Q3DisplayGroup_GetBoundingBox( theObject, &outBounds )) &&
+			! outBounds.isEmpty;
+	}
+
+	return false;
+}
+
+
+
+
+
+//=============================================================================
+//      e3geom_instancearray_cull : Find the instances visible to the camera.
+//-----------------------------------------------------------------------------
+//		Note :	The frustum planes are cached by the view in local coordinates,
+//				and we do not change the local to world matrix while culling,
+//				so the instance boxes are transformed to local coordinates and
+//				then classified against the frustum in one batch.
+//-----------------------------------------------------------------------------
+static void
+e3geom_instancearray_cull( TQ3ViewObject theView,
+							const TQ3InstanceArrayData* instanceData,
+							InstanceIndexVec& outVisible )
+{
+	TQ3BoundingBox		localBounds, instanceBounds;
+	TQ3Uns32			n;
+
+
+
+	outVisible.clear();
+	outVisible.reserve( instanceData->numInstances );
+
+
+
+	// If we can't cull, every instance is visible
+	if ( (! E3View_IsGroupCullingAllowed( theView )) ||
+		(! e3geom_instancearray_get_local_bounds( instanceData, localBounds )) )
+	{
+		for (n = 0; n < instanceData->numInstances; ++n)
+			outVisible.push_back( n );
+		return;
+	}
+
+
+
+	// Gather the instance bounds
+	const TQ3Uns32 numInstances = instanceData->numInstances;
+	std::vector<float> boxCoords( 6 * numInstances );
+	E3BoundingBoxArraySoA theBoxes;
+	theBoxes.minX  = &boxCoords[ 0 * numInstances ];
+	theBoxes.minY  = &boxCoords[ 1 * numInstances ];
+	theBoxes.minZ  = &boxCoords[ 2 * numInstances ];
+	theBoxes.maxX  = &boxCoords[ 3 * numInstances ];
+	theBoxes.maxY  = &boxCoords[ 4 * numInstances ];
+	theBoxes.maxZ  = &boxCoords[ 5 * numInstances ];
+	theBoxes.count = numInstances;
+
+	for (n = 0; n < numInstances; ++n)
+	{
+		E3BoundingBox_Transform( &localBounds, &instanceData->transforms[n], &instanceBounds );
+
+		boxCoords[ 0 * numInstances + n ] = instanceBounds.min.x;
+		boxCoords[ 1 * numInstances + n ] = instanceBounds.min.y;
+		boxCoords[ 2 * numInstances + n ] = instanceBounds.min.z;
+		boxCoords[ 3 * numInstances + n ] = instanceBounds.max.x;
+		boxCoords[ 4 * numInstances + n ] = instanceBounds.max.y;
+		boxCoords[ 5 * numInstances + n ] = instanceBounds.max.z;
+	}
+
+
+
+	// Test the instances against the view frustum
+	std::vector<TQ3Uns32> visibleMask( (numInstances + 31) / 32 );
+	E3BoundingBox_ClassifyViewFrustum( theView, theBoxes, nullptr, visibleMask.data() );
+
+	for (n = 0; n < numInstances; ++n)
+	{
+		if ((visibleMask[ n / 32 ] & (1U << (n % 32))) != 0)
+			outVisible.push_back( n );
+	}
+}
+
+
+
+
+
+//=============================================================================
+//      e3geom_instancearray_submit_instances : Submit a list of instances.
+//-----------------------------------------------------------------------------
+//		Note :	Rather than pushing the view state for every instance, we only
+//				replace the local to world matrix. The state is only pushed
+//				around an instance which has its own attributes.
+//
+//				The caller must restore the local to world matrix afterwards.
+//-----------------------------------------------------------------------------
+static TQ3Status
+e3geom_instancearray_submit_instances( TQ3ViewObject theView,
+										const TQ3InstanceArrayData* instanceData,
+										const TQ3Matrix4x4& localToWorld,
+										const InstanceIndexVec& theInstances )
+{
+	TQ3Status	qd3dStatus = kQ3Success;
+	TQ3Matrix4x4	instanceToWorld;
+
+
+
+	for (InstanceIndexVec::const_iterator i = theInstances.begin();
+		(qd3dStatus == kQ3Success) && (i != theInstances.end()); ++i)
+	{
+		// Move to the instance's coordinate system
+		instanceToWorld = instanceData->transforms[ *i ] * localToWorld;
+		qd3dStatus = E3View_State_SetMatrix( theView, kQ3MatrixStateLocalToWorld,
+			&instanceToWorld, nullptr, nullptr );
+		if (qd3dStatus == kQ3Failure)
+			break;
+
+
+
+		// Submit the instance, with its attributes if it has any
+		TQ3AttributeSet theAtts = (instanceData->instanceAttributeSets != nullptr) ?
+			instanceData->instanceAttributeSets[ *i ] : nullptr;
+
+		if (theAtts == nullptr)
+		{
+			qd3dStatus = E3View_SubmitRetained( theView, instanceData->instancedObject );
+		}
+		else
+		{
+			qd3dStatus = E3Push_Submit( theView );
+			if (qd3dStatus == kQ3Success)
+			{
+				qd3dStatus = E3View_SubmitRetained( theView, theAtts );
+				
+				if (qd3dStatus == kQ3Success)
+					qd3dStatus = E3View_SubmitRetained( theView, instanceData->instancedObject );
+				
+				E3Pop_Submit( theView );
+			}
+		}
+	}
+
+	return qd3dStatus;
+}
+
+
+
+
+
+//=============================================================================
+//      e3geom_instancearray_submit_all : Submit instances as a fallback.
+//-----------------------------------------------------------------------------
+//		Note :	Submits the supplied instances one by one, applying the array's
+//				attribute set and restoring the local to world matrix when done.
+//-----------------------------------------------------------------------------
+static TQ3Status
+e3geom_instancearray_submit_all( TQ3ViewObject theView,
+								const TQ3InstanceArrayData* instanceData,
+								const InstanceIndexVec& theInstances )
+{
+	TQ3Status	qd3dStatus = kQ3Success;
+
+
+
+	// Save the current local to world matrix
+	const TQ3Matrix4x4	localToWorld( *E3View_State_GetMatrixLocalToWorld( theView ) );
+
+
+
+	// If the array has its own attributes, they need a single push for the
+	// whole array; the pop then also restores the matrix for us.
+	if (instanceData->instanceArrayAttributeSet != nullptr)
+	{
+		qd3dStatus = E3Push_Submit( theView );
+		if (qd3dStatus == kQ3Failure)
+			return qd3dStatus;
+		
+		qd3dStatus = E3View_SubmitRetained( theView, instanceData->instanceArrayAttributeSet );
+		
+		if (qd3dStatus == kQ3Success)
+			qd3dStatus = e3geom_instancearray_submit_instances( theView, instanceData,
+				localToWorld, theInstances );
+		
+		E3Pop_Submit( theView );
+	}
+	else
+	{
+		qd3dStatus = e3geom_instancearray_submit_instances( theView, instanceData,
+			localToWorld, theInstances );
+
+		if (! theInstances.empty())
+			E3View_State_SetMatrix( theView, kQ3MatrixStateLocalToWorld,
+				&localToWorld, nullptr, nullptr );
+	}
+
+	return qd3dStatus;
+}
+
+
+
+
+
+//=============================================================================
+//      e3geom_instancearray_render : InstanceArray render method.
+//-----------------------------------------------------------------------------
+//		Note :	Instances outside the view frustum are culled first. If the
+//				renderer can draw an instance array, it receives the visible
+//				instances in one call, otherwise we submit them ourselves.
+//-----------------------------------------------------------------------------
+static TQ3Status
+e3geom_instancearray_render(TQ3ViewObject theView, TQ3ObjectType objectType, TQ3Object theObject, const void *objectData)
+{	const TQ3InstanceArrayData	*instanceData = (const TQ3InstanceArrayData *) objectData;
+	TQ3Status					qd3dStatus = kQ3Success;
+	InstanceIndexVec			visibleInstances;
+	TQ3Boolean					geomSupported = kQ3False;
+
+
+
+	// Find the visible instances
+	if (instanceData->numInstances == 0)
+		return kQ3Success;
+
+	e3geom_instancearray_cull( theView, instanceData, visibleInstances );
+	if (visibleInstances.empty())
+		return kQ3Success;
+
+
+
+	// If the renderer can draw all the instances at once, let it. If some were
+	// culled, we pass it data for just the visible ones.
+	TQ3RendererObject theRenderer = E3View_AccessRenderer( theView );
+	if ( (theRenderer != nullptr) &&
+		(theRenderer->GetMethod( kQ3GeometryTypeInstanceArray ) != nullptr) )
+	{
+		if (visibleInstances.size() == instanceData->numInstances)
+		{
+			qd3dStatus = E3Renderer_Method_SubmitGeometry( theView, objectType,
+				&geomSupported, theObject, instanceData );
+		}
+		else
+		{
+			TQ3Uns32						numVisible = static_cast<TQ3Uns32>(visibleInstances.size());
+			std::vector<TQ3Matrix4x4>		visibleTransforms( numVisible );
+			std::vector<TQ3AttributeSet>	visibleAtts;
+			TQ3InstanceArrayData			visibleData( *instanceData );
+
+			if (instanceData->instanceAttributeSets != nullptr)
+				visibleAtts.resize( numVisible );
+
+			for (TQ3Uns32 n = 0; n < numVisible; ++n)
+			{
+				visibleTransforms[n] = instanceData->transforms[ visibleInstances[n] ];
+				
+				if (! visibleAtts.empty())
+					visibleAtts[n] = instanceData->instanceAttributeSets[ visibleInstances[n] ];
+			}
+
+			visibleData.numInstances          = numVisible;
+			visibleData.transforms            = &visibleTransforms[0];
+			visibleData.instanceAttributeSets = visibleAtts.empty() ? nullptr : &visibleAtts[0];
+
+			qd3dStatus = E3Renderer_Method_SubmitGeometry( theView, objectType,
+				&geomSupported, theObject, &visibleData );
+		}
+	}
+
+
+
+	// Otherwise fall back to submitting each instance
+	if (! geomSupported)
+		qd3dStatus = e3geom_instancearray_submit_all( theView, instanceData, visibleInstances );
+
+	return qd3dStatus;
+}
+
+
+
+
+
+//=============================================================================
+//      e3geom_instancearray_pick : InstanceArray picking method.
+//-----------------------------------------------------------------------------
+//		Note :	Hits on any instance are reported as hits on the instance
+//				array. World ray picks reject instances whose bounds miss the
+//				ray, or every ray of a batch, and window picks reject instances
+//				outside the view frustum.
+//-----------------------------------------------------------------------------
+static TQ3Status
+e3geom_instancearray_pick(TQ3ViewObject theView, TQ3ObjectType objectType, TQ3Object theObject, const void *objectData)
+{	const TQ3InstanceArrayData	*instanceData = (const TQ3InstanceArrayData *) objectData;
+	TQ3PickObject				thePick = E3View_AccessPick( theView );
+	TQ3BoundingBox				localBounds, worldBounds;
+	InstanceIndexVec			pickInstances;
+	TQ3Status					qd3dStatus;
+#pragma unused(objectType)
+#pragma unused(theObject)
+
+
+
+	// Find the instances which might be hit
+	if (instanceData->numInstances == 0)
+		return kQ3Success;
+
+	if ( (E3Pick_GetType( thePick ) == kQ3PickTypeWorldRay) &&
+		e3geom_instancearray_get_local_bounds( instanceData, localBounds ) )
+	{
+		TQ3WorldRayPickData		pickData;
+		float					vertexTolerance, edgeTolerance, faceTolerance;
+		
+		E3WorldRayPick_GetData( thePick, &pickData );
+		E3Pick_GetVertexTolerance( thePick, &vertexTolerance );
+		E3Pick_GetEdgeTolerance( thePick, &edgeTolerance );
+		E3Pick_GetFaceTolerance( thePick, &faceTolerance );
+		float tolerance = std::max( vertexTolerance, std::max( edgeTolerance, faceTolerance ) );
+		
+		const TQ3Matrix4x4& localToWorld( *E3View_State_GetMatrixLocalToWorld( theView ) );
+		pickInstances.reserve( instanceData->numInstances );
+
+		for (TQ3Uns32 n = 0; n < instanceData->numInstances; ++n)
+		{
+			TQ3Matrix4x4 instanceToWorld = instanceData->transforms[n] * localToWorld;
+			E3BoundingBox_Transform( &localBounds, &instanceToWorld, &worldBounds );
+
+			worldBounds.min.x -= tolerance;
+			worldBounds.min.y -= tolerance;
+			worldBounds.min.z -= tolerance;
+			worldBounds.max.x += tolerance;
+			worldBounds.max.y += tolerance;
+			worldBounds.max.z += tolerance;
+
+			if (E3Ray3D_IntersectBoundingBox( &pickData.ray, &worldBounds, nullptr ))
+				pickInstances.push_back( n );
+		}
+	}
+	else if ( (E3Pick_GetType( thePick ) == kQ3PickTypeWorldRayBatch) &&
+		e3geom_instancearray_get_local_bounds( instanceData, localBounds ) )
+	{
+		TQ3Uns32 numRays;
+		E3WorldRayBatchPick_GetNumRays( thePick, &numRays );
+		const TQ3Ray3D* worldRays        = E3WorldRayBatchPick_AccessRays( thePick );
+		const float*    nearestDistances = E3WorldRayBatchPick_AccessNearestDistances( thePick );
+		
+		const TQ3Matrix4x4& localToWorld( *E3View_State_GetMatrixLocalToWorld( theView ) );
+		pickInstances.reserve( instanceData->numInstances );
+
+		for (TQ3Uns32 n = 0; n < instanceData->numInstances; ++n)
+		{
+			TQ3Matrix4x4 instanceToWorld = instanceData->transforms[n] * localToWorld;
+			E3BoundingBox_Transform( &localBounds, &instanceToWorld, &worldBounds );
+
+			for (TQ3Uns32 r = 0; r < numRays; ++r)
+			{
+				if ( (nearestDistances[r] >= 0.0f) &&
+					E3Ray3D_IntersectBoundingBox( &worldRays[r], &worldBounds, nullptr ) )
+				{
+					pickInstances.push_back( n );
+					break;
+				}
+			}
+		}
+	}
+	else
+	{
+		e3geom_instancearray_cull( theView, instanceData, pickInstances );
+	}
+
+	if (pickInstances.empty())
+		return kQ3Success;
+
+
+
+	// Submit the instances as the decomposed form of the array, so that the
+	// array is saved as the target for successful picks
+	E3View_PickStack_BeginDecomposedObject( theView );
+
+	qd3dStatus = e3geom_instancearray_submit_all( theView, instanceData, pickInstances );
+
+	E3View_PickStack_EndDecomposedObject( theView );
+
+	return qd3dStatus;
+}
+
+
+
+
+
+//=============================================================================
+//      e3geom_instancearray_bounds : InstanceArray bounds method.
+//-----------------------------------------------------------------------------
+//		Note :	For approximate bounds we only need the corners of the shared
+//				bounding box for each instance. Otherwise we have to submit the
+//				instanced object for each instance.
+//-----------------------------------------------------------------------------
+static TQ3Status
+e3geom_instancearray_bounds(TQ3ViewObject theView, TQ3ObjectType objectType, TQ3Object theObject, const void *objectData)
+{	const TQ3InstanceArrayData	*instanceData = (const TQ3InstanceArrayData *) objectData;
+	TQ3BoundingBox				localBounds;
+	TQ3Uns32					n;
+#pragma unused(objectType)
+#pragma unused(theObject)
+
+
+
+	if (instanceData->numInstances == 0)
+		return kQ3Success;
+
+
+
+	// Use the shared bounds if we can
+	TQ3BoundingMethod boundingMethod = E3View_GetBoundingMethod( theView );
+	
+	if ( ((boundingMethod == kQ3BoxBoundsApprox) || (boundingMethod == kQ3SphereBoundsApprox)) &&
+		e3geom_instancearray_get_local_bounds( instanceData, localBounds ) )
+	{
+		TQ3Point3D					localCorners[8];
+		std::vector<TQ3Point3D>		instanceCorners( instanceData->numInstances * 8 );
+		
+		E3BoundingBox_GetCorners( &localBounds, localCorners );
+		
+		for (n = 0; n < instanceData->numInstances; ++n)
+		{
+			E3Point3D_To3DTransformArray( localCorners, &instanceData->transforms[n],
+				&instanceCorners[ n * 8 ], 8, sizeof(TQ3Point3D), sizeof(TQ3Point3D) );
+		}
+		
+		E3View_UpdateBounds( theView, static_cast<TQ3Uns32>(instanceCorners.size()),
+			sizeof(TQ3Point3D), &instanceCorners[0] );
+		
+		return kQ3Success;
+	}
+
+
+
+	// Otherwise submit every instance
+	InstanceIndexVec allInstances( instanceData->numInstances );
+	for (n = 0; n < instanceData->numInstances; ++n)
+		allInstances[n] = n;
+
+	return e3geom_instancearray_submit_all( theView, instanceData, allInstances );
+}
+
+
+
+
+
+//=============================================================================
+//      e3geom_instancearray_cache_new : InstanceArray cache new method.
+//-----------------------------------------------------------------------------
+//		Note :	The decomposed form of an instance array is a display group
+//				holding a group for each instance. This is what gets written
+//				to files, since there is no file format for instance arrays.
+//-----------------------------------------------------------------------------
+static TQ3Object
+e3geom_instancearray_cache_new(TQ3ViewObject theView, TQ3GeometryObject theGeom, const void *inArrayData)
+{	const TQ3InstanceArrayData	*instanceData = (const TQ3InstanceArrayData *) inArrayData;
+	TQ3Status					qd3dStatus = kQ3Success;
+#pragma unused(theView)
+#pragma unused(theGeom)
+
+
+
+	// Create a group to hold the cached representation
+	TQ3GroupObject theGroup = Q3DisplayGroup_New();
+	if (theGroup == nullptr)
+		return nullptr;
+
+	if (instanceData->instanceArrayAttributeSet != nullptr)
+		Q3Group_AddObject( theGroup, instanceData->instanceArrayAttributeSet );
+
+
+
+	// Add a group for each instance
+	for (TQ3Uns32 n = 0; (qd3dStatus == kQ3Success) && (n < instanceData->numInstances); ++n)
+	{
+		qd3dStatus = kQ3Failure;
+		
+		CQ3ObjectRef instanceGroup( Q3DisplayGroup_New() );
+		CQ3ObjectRef instanceTransform( Q3MatrixTransform_New( &instanceData->transforms[n] ) );
+		if (instanceGroup.isvalid() && instanceTransform.isvalid())
+		{
+			Q3Group_AddObject( instanceGroup.get(), instanceTransform.get() );
+
+			if ( (instanceData->instanceAttributeSets != nullptr) &&
+				(instanceData->instanceAttributeSets[n] != nullptr) )
+				Q3Group_AddObject( instanceGroup.get(), instanceData->instanceAttributeSets[n] );
+
+			Q3Group_AddObject( instanceGroup.get(), instanceData->instancedObject );
+
+			if (Q3Group_AddObject( theGroup, instanceGroup.get() ) != nullptr)
+				qd3dStatus = kQ3Success;
+		}
+	}
+
+	if (qd3dStatus == kQ3Failure)
+		Q3Object_CleanDispose( &theGroup );
+
+	return theGroup;
+}
+
+
+
+
+
+//=============================================================================
+//      e3geom_instancearray_get_attribute : InstanceArray get attribute set pointer.
+//-----------------------------------------------------------------------------
+static TQ3AttributeSet *
+e3geom_instancearray_get_attribute ( TQ3GeometryObject theObject )
+{
+	// Return the address of the geometry attribute set
+	return & ((E3InstanceArray*)theObject)->instanceData.instanceArrayAttributeSet ;
+}
+
+
+
+
+
+//=============================================================================
+//      e3geom_instancearray_metahandler : InstanceArray metahandler.
+//-----------------------------------------------------------------------------
+static TQ3XFunctionPointer
+e3geom_instancearray_metahandler(TQ3XMethodType methodType)
+{	TQ3XFunctionPointer		theMethod = nullptr;
+
+
+
+	// Return our methods
+	switch (methodType) {
+		case kQ3XMethodTypeObjectNew:
+			theMethod = (TQ3XFunctionPointer) e3geom_instancearray_new;
+			break;
+
+		case kQ3XMethodTypeObjectDelete:
+			theMethod = (TQ3XFunctionPointer) e3geom_instancearray_delete;
+			break;
+
+		case kQ3XMethodTypeObjectDuplicate:
+			theMethod = (TQ3XFunctionPointer) e3geom_instancearray_duplicate;
+			break;
+
+		case kQ3XMethodTypeObjectSubmitRender:
+			theMethod = (TQ3XFunctionPointer) e3geom_instancearray_render;
+			break;
+
+		case kQ3XMethodTypeObjectSubmitPick:
+			theMethod = (TQ3XFunctionPointer) e3geom_instancearray_pick;
+			break;
+
+		case kQ3XMethodTypeObjectSubmitBounds:
+			theMethod = (TQ3XFunctionPointer) e3geom_instancearray_bounds;
+			break;
+
+		case kQ3XMethodTypeGeomCacheNew:
+			theMethod = (TQ3XFunctionPointer) e3geom_instancearray_cache_new;
+			break;
+
+		case kQ3XMethodTypeGeomGetAttribute:
+			theMethod = (TQ3XFunctionPointer) e3geom_instancearray_get_attribute;
+			break;
+		}
+	
+	return(theMethod);
+}
+
+
+
+
+
+//=============================================================================
+//      Public functions
+//-----------------------------------------------------------------------------
+//      E3GeometryInstanceArray_RegisterClass : Register the class.
+//-----------------------------------------------------------------------------
+#pragma mark -
+TQ3Status
+E3GeometryInstanceArray_RegisterClass(void)
+	{
+	// Register the class
+	return Q3_REGISTER_CLASS (	kQ3ClassNameGeometryInstanceArray,
+								e3geom_instancearray_metahandler,
+								E3InstanceArray ) ;
+	}
+
+
+
+
+
+//=============================================================================
+//      E3GeometryInstanceArray_UnregisterClass : Unregister the class.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3GeometryInstanceArray_UnregisterClass(void)
+{	TQ3Status		qd3dStatus;
+
+
+
+	// Unregister the class
+	qd3dStatus = E3ClassTree::UnregisterClass(kQ3GeometryTypeInstanceArray, kQ3True);
+
+	return(qd3dStatus);
+}
+
+
+
+
+
+//=============================================================================
+//      E3InstanceArray_New : Create an instance array object.
+//-----------------------------------------------------------------------------
+#pragma mark -
+TQ3GeometryObject
+E3InstanceArray_New(const TQ3InstanceArrayData *instanceArrayData)
+{	TQ3Object		theObject;
+
+
+
+	// Create the object
+	theObject = E3ClassTree::CreateInstance ( kQ3GeometryTypeInstanceArray, kQ3False, instanceArrayData);
+	return(theObject);
+}
+
+
+
+
+
+//=============================================================================
+//      E3InstanceArray_Submit : Submit an instance array.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3InstanceArray_Submit(const TQ3InstanceArrayData *instanceArrayData, TQ3ViewObject theView)
+{	TQ3Status		qd3dStatus;
+
+
+
+	// Submit the geometry
+	qd3dStatus = E3View_SubmitImmediate(theView, kQ3GeometryTypeInstanceArray, instanceArrayData);
+	return(qd3dStatus);
+}
+
+
+
+
+
+//=============================================================================
+//      E3InstanceArray_SetData : Set the data for an instance array.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3InstanceArray_SetData(TQ3GeometryObject instanceArray, const TQ3InstanceArrayData *instanceArrayData)
+	{
+	E3InstanceArray* theArray = (E3InstanceArray*) instanceArray ;
+	TQ3InstanceArrayData newData ;
+
+
+
+	// Copy the new data before releasing the old, in case they share objects
+	TQ3Status q3status = e3geom_instancearray_copydata ( instanceArrayData, &newData, kQ3False ) ;
+	if ( q3status == kQ3Failure )
+		return q3status ;
+
+	E3InstanceArray_EmptyData ( & theArray->instanceData ) ;
+	theArray->instanceData = newData ;
+
+	Q3Shared_Edited ( theArray ) ;
+
+	return kQ3Success ;
+	}
+
+
+
+
+
+//=============================================================================
+//      E3InstanceArray_GetData : Get the data for an instance array.
+//-----------------------------------------------------------------------------
+//		Note :	Allocates memory internally, you must call
+//				Q3InstanceArray_EmptyData to dispose of this memory
+//-----------------------------------------------------------------------------
+TQ3Status
+E3InstanceArray_GetData(TQ3GeometryObject instanceArray, TQ3InstanceArrayData *instanceArrayData)
+	{
+	E3InstanceArray* theArray = (E3InstanceArray*) instanceArray ;
+
+	return e3geom_instancearray_copydata ( & theArray->instanceData, instanceArrayData, kQ3False ) ;
+	}
+
+
+
+
+
+//=============================================================================
+//      E3InstanceArray_EmptyData : Empty the data for an instance array.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3InstanceArray_EmptyData(TQ3InstanceArrayData *instanceArrayData)
+	{
+	// Release the data
+	if ( instanceArrayData->instanceAttributeSets != nullptr )
+		{
+		for ( TQ3Uns32 n = 0 ; n < instanceArrayData->numInstances ; ++n )
+			Q3Object_CleanDispose ( & instanceArrayData->instanceAttributeSets [ n ] ) ;
+		}
+
+	Q3Memory_Free ( & instanceArrayData->instanceAttributeSets ) ;
+	Q3Memory_Free ( & instanceArrayData->transforms ) ;
+	Q3Object_CleanDispose ( & instanceArrayData->instancedObject ) ;
+	Q3Object_CleanDispose ( & instanceArrayData->instanceArrayAttributeSet ) ;
+
+	return kQ3Success ;
+	}
+
+
+
+
+
+//=============================================================================
+//      E3InstanceArray_GetTransform : Get the transform of an instance.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3InstanceArray_GetTransform(TQ3GeometryObject instanceArray, TQ3Uns32 index, TQ3Matrix4x4 *transform)
+	{
+	E3InstanceArray* theArray = (E3InstanceArray*) instanceArray ;
+
+	if ( index >= theArray->instanceData.numInstances )
+		{
+		E3ErrorManager_PostError ( kQ3ErrorParameterOutOfRange, kQ3False ) ;
+		return kQ3Failure ;
+		}
+
+	*transform = theArray->instanceData.transforms [ index ] ;
+
+	return kQ3Success ;
+	}
+
+
+
+
+
+//=============================================================================
+//      E3InstanceArray_SetTransform : Set the transform of an instance.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3InstanceArray_SetTransform(TQ3GeometryObject instanceArray, TQ3Uns32 index, const TQ3Matrix4x4 *transform)
+	{
+	E3InstanceArray* theArray = (E3InstanceArray*) instanceArray ;
+
+	if ( index >= theArray->instanceData.numInstances )
+		{
+		E3ErrorManager_PostError ( kQ3ErrorParameterOutOfRange, kQ3False ) ;
+		return kQ3Failure ;
+		}
+
+	theArray->instanceData.transforms [ index ] = *transform ;
+
+	Q3Shared_Edited ( theArray ) ;
+
+	return kQ3Success ;
+	}
@@ -0,0 +1,91 @@
+/*  NAME:
+        E3GeometryInstanceArray.h
+
+    DESCRIPTION:
+        Header file for E3GeometryInstanceArray.cpp.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+#ifndef E3GEOMETRY_INSTANCEARRAY_HDR
+#define E3GEOMETRY_INSTANCEARRAY_HDR
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+// Include files go here
+
+
+
+
+
+//=============================================================================
+//		C++ preamble
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+
+
+//=============================================================================
+//      Function prototypes
+//-----------------------------------------------------------------------------
+TQ3Status			E3GeometryInstanceArray_RegisterClass(void);
+TQ3Status			E3GeometryInstanceArray_UnregisterClass(void);
+
+TQ3GeometryObject	E3InstanceArray_New(const TQ3InstanceArrayData *instanceArrayData);
+TQ3Status			E3InstanceArray_Submit(const TQ3InstanceArrayData *instanceArrayData, TQ3ViewObject theView);
+TQ3Status			E3InstanceArray_SetData(TQ3GeometryObject instanceArray, const TQ3InstanceArrayData *instanceArrayData);
+TQ3Status			E3InstanceArray_GetData(TQ3GeometryObject instanceArray, TQ3InstanceArrayData *instanceArrayData);
+TQ3Status			E3InstanceArray_EmptyData(TQ3InstanceArrayData *instanceArrayData);
+TQ3Status			E3InstanceArray_GetTransform(TQ3GeometryObject instanceArray, TQ3Uns32 index, TQ3Matrix4x4 *transform);
+TQ3Status			E3InstanceArray_SetTransform(TQ3GeometryObject instanceArray, TQ3Uns32 index, const TQ3Matrix4x4 *transform);
+
+
+
+
+
+//=============================================================================
+//		C++ postamble
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
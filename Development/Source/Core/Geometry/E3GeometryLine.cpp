@@ -515,6 +515,11 @@ e3geom_line_pick(TQ3ViewObject theView, TQ3ObjectType objectType, TQ3Object theO
 			qd3dStatus = e3geom_line_pick_world_ray(theView, thePick, theObject, objectData);
 			break;
 
+		case kQ3PickTypeWorldRayBatch:
+			// Only surfaces are picked by a batch of rays
+			qd3dStatus = kQ3Success;
+			break;
+
 		default:
 			qd3dStatus = kQ3Failure;
 			break;
@@ -431,6 +431,7 @@ e3geom_marker_pick(TQ3ViewObject theView, TQ3ObjectType objectType, TQ3Object th
 			break;
 
 		case kQ3PickTypeWorldRay:
+		case kQ3PickTypeWorldRayBatch:
 			// Can't be picked, but don't stop picking
 			qd3dStatus = kQ3Success;
 			break;
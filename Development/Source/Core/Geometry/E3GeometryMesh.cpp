@@ -49,6 +49,10 @@
 #include "E3GeometryMesh.h"
 #include "E3ArrayOrList.h"
 #include "E3Pool.h"
+#include "E3GeometryMeshTopology.h"
+
+#include <new>
+#include <vector>
 
 
 
@@ -121,6 +125,7 @@ struct TE3MeshContourData {
 	TE3MeshPartData					part;					// base class
 	TE3MeshFaceData*				containerFacePtr;
 	TE3MeshVertexPtrArray			vertexPtrArray;
+	TQ3Uns32						topologyIndex;			// valid if mesh has topology
 };
 
 E3_ARRAY_OR_LIST_DECLARE(TE3MeshContourData, e3meshContour, static);
@@ -133,6 +138,7 @@ struct TE3MeshFaceData {
 	TE3MeshPartData					part;					// base class
 	TE3MeshContourDataArrayOrList	contourArrayOrList;
 	TQ3AttributeSet					attributeSet;
+	TQ3Uns32						topologyIndex;			// valid if mesh has topology
 };
 
 E3_ARRAY_OR_LIST_DECLARE(TE3MeshFaceData, e3meshFace, static);
@@ -164,6 +170,7 @@ struct TE3MeshVertexData {
 	TQ3Point3D						point;
 	TE3MeshCornerDataArrayOrList	cornerArrayOrList;
 	TQ3AttributeSet					attributeSet;
+	TQ3Uns32						topologyIndex;			// valid if mesh has topology
 };
 
 E3_ARRAY_OR_LIST_DECLARE(TE3MeshVertexData, e3meshVertex, static);
@@ -197,6 +204,10 @@ struct TE3MeshData {
 	TE3MeshVertexDataArrayOrList	vertexArrayOrList;
 	TE3MeshFaceDataArrayOrList		faceArrayOrList;
 	TQ3AttributeSet					attributeSet;
+
+	// Half-edge connectivity, built when first needed and then kept up to
+	// date by edits, or discarded by edits which it does not follow
+	E3MeshTopology*					topologyPtr;
 };
 
 
@@ -2826,6 +2837,9 @@ e3mesh_Create(
 	// Initialize attribute set
 	meshPtr->attributeSet = nullptr;
 
+	// Initialize topology
+	meshPtr->topologyPtr = nullptr;
+
 	return(kQ3Success);
 	
 	// Dead code to reverse e3meshFaceArray_Create
@@ -2914,6 +2928,9 @@ e3mesh_CreateFromExtData(
 	// Set attribute set
 	E3Shared_Acquire(&meshPtr->attributeSet, meshExtDataPtr->meshAttributeSet);
 
+	// Initialize topology
+	meshPtr->topologyPtr = nullptr;
+
 	return(kQ3Success);
 
 failure_7:
@@ -2958,6 +2975,10 @@ e3mesh_Destroy(
 	//	Release attribute set
 	Q3Object_CleanDispose(&meshPtr->attributeSet);
 
+	// Destroy topology
+	delete meshPtr->topologyPtr;
+	meshPtr->topologyPtr = nullptr;
+
 	// Destroy face array or list
 	e3meshFaceArrayOrList_Destroy(&meshPtr->faceArrayOrList, &e3meshFace_Destroy);
 
@@ -3393,26 +3414,26 @@ e3meshExtData_Empty(
 
 
 //=============================================================================
-//      e3meshIterator_Initialize : TQ3MeshIterator partial constructor.
+//      e3mesh_DiscardTopology : Discard half-edge topology, if any.
+//-----------------------------------------------------------------------------
+//		Note :	External references to edges become invalid, as if the edges
+//				had been deleted.
 //-----------------------------------------------------------------------------
 #pragma mark -
 static
 void
-e3meshIterator_Initialize(
-	TQ3MeshIterator* iteratorPtr,
-	TE3MeshData* meshPtr,
-	const char* iteratorKind)
+e3mesh_DiscardTopology(
+	TE3MeshData* meshPtr)
 {
-	// Save mesh
-	iteratorPtr->var4.field1 = meshPtr;
+	// Validate our parameters
+	Q3_ASSERT_VALID_PTR(meshPtr);
 
-	// Save iterator kind
-	strncpy(iteratorPtr->var4.field2, iteratorKind, 4);
-	
-	// Initialize other fields
-	iteratorPtr->var1 =
-	iteratorPtr->var2 =
-	iteratorPtr->var3 = nullptr;
+	if (meshPtr->topologyPtr != nullptr)
+	{
+		meshPtr->topologyPtr->ReleaseEdgeRefs();
+		delete meshPtr->topologyPtr;
+		meshPtr->topologyPtr = nullptr;
+	}
 }
 
 
@@ -3420,22 +3441,30 @@ e3meshIterator_Initialize(
 
 
 //=============================================================================
-//      e3geom_mesh_new : TE3MeshData constructor.
+//      e3meshContour_AddToTopology : Add contour to topology of mesh.
 //-----------------------------------------------------------------------------
-//		Note : If unable to create (out of memory), return kQ3Failure.
+//		Note : Throws std::bad_alloc if out of memory.
 //-----------------------------------------------------------------------------
-#pragma mark -
 static
-TQ3Status
-e3geom_mesh_new(
-	TQ3Object theObject,
-	void *privateData,
-	const void *paramData)
+void
+e3meshContour_AddToTopology(
+	TE3MeshContourData* contourPtr,
+	TQ3Uns32 faceIndex,
+	E3MeshTopology* topologyPtr,
+	std::vector<TQ3Uns32>& vertexIndices)
 {
-#pragma unused(theObject)
-#pragma unused(paramData)
+	const TE3MeshVertexPtr* vertexHdl;
 
-	return(e3mesh_Create(E3_DOWN_CAST(TE3MeshData*, privateData)));
+	vertexIndices.clear();
+	for (vertexHdl = e3meshVertexPtrArray_FirstItemConst(&contourPtr->vertexPtrArray);
+		vertexHdl != nullptr;
+		vertexHdl = e3meshVertexPtrArray_NextItemConst(&contourPtr->vertexPtrArray, vertexHdl))
+	{
+		vertexIndices.push_back((*vertexHdl)->topologyIndex);
+	}
+
+	contourPtr->topologyIndex = topologyPtr->AddContour(faceIndex,
+		(TQ3Uns32) vertexIndices.size(), vertexIndices.data());
 }
 
 
@@ -3443,17 +3472,32 @@ e3geom_mesh_new(
 
 
 //=============================================================================
-//      e3geom_mesh_delete : TE3MeshData destructor.
+//      e3meshFace_AddToTopology : Add face and its contours to topology.
+//-----------------------------------------------------------------------------
+//		Note : Throws std::bad_alloc if out of memory.
 //-----------------------------------------------------------------------------
 static
 void
-e3geom_mesh_delete(
-	TQ3Object theObject,
-	void *privateData)
+e3meshFace_AddToTopology(
+	TE3MeshFaceData* facePtr,
+	TE3MeshData* meshPtr,
+	std::vector<TQ3Uns32>& vertexIndices)
 {
-#pragma unused(theObject)
+	TE3MeshFaceExtRef faceExtRef;
+	TE3MeshContourData* contourPtr;
 
-	e3mesh_Destroy(E3_DOWN_CAST(TE3MeshData*, privateData));
+	if ((faceExtRef = e3meshFace_ExtRefInMesh(facePtr, meshPtr)) == nullptr)
+		throw std::bad_alloc();
+
+	facePtr->topologyIndex = meshPtr->topologyPtr->AddFace(faceExtRef);
+
+	for (contourPtr = e3meshContourArrayOrList_FirstItem(&facePtr->contourArrayOrList);
+		contourPtr != nullptr;
+		contourPtr = e3meshContourArrayOrList_NextItem(&facePtr->contourArrayOrList, contourPtr))
+	{
+		e3meshContour_AddToTopology(contourPtr, facePtr->topologyIndex,
+			meshPtr->topologyPtr, vertexIndices);
+	}
 }
 
 
@@ -3461,39 +3505,92 @@ e3geom_mesh_delete(
 
 
 //=============================================================================
-//      e3geom_mesh_duplicate : Mesh duplicate method.
+//      e3mesh_Topology : Return half-edge topology, building it if necessary.
+//-----------------------------------------------------------------------------
+//		Note :	Building takes time proportional to the size of the mesh,
+//				after which the mesh edit functions keep it up to date.
+//-----------------------------------------------------------------------------
+//		Note : If unable to build (out of memory), return nullptr.
 //-----------------------------------------------------------------------------
 static
-TQ3Status
-e3geom_mesh_duplicate(
-	TQ3Object fromObject,
-	const void *fromPrivateData,
-	TQ3Object toObject,
-	void *toPrivateData)
-{	const TE3MeshData*		fromInstanceData = (const TE3MeshData*) fromPrivateData;
-	TE3MeshData*			toInstanceData   = (TE3MeshData*)       toPrivateData;
-	TQ3Status				qd3dStatus;
+E3MeshTopology*
+e3mesh_Topology(
+	TE3MeshData* meshPtr)
+{
+	TE3MeshVertexData* vertexPtr;
+	TE3MeshVertexExtRef vertexExtRef;
+	TE3MeshFaceData* facePtr;
 
+	// Validate our parameters
+	Q3_ASSERT_VALID_PTR(meshPtr);
 
+	if (meshPtr->topologyPtr != nullptr)
+		return(meshPtr->topologyPtr);
 
-	// Validate our parameters
-	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(fromObject),      kQ3Failure);
-	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(fromPrivateData), kQ3Failure);
-	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(toObject),        kQ3Failure);
-	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(toPrivateData),   kQ3Failure);
+	try
+	{
+		std::vector<TQ3Uns32> vertexIndices;
 
+		meshPtr->topologyPtr = new E3MeshTopology;
 
+		for (vertexPtr = e3meshVertexArrayOrList_FirstItem(&meshPtr->vertexArrayOrList);
+			vertexPtr != nullptr;
+			vertexPtr = e3meshVertexArrayOrList_NextItem(&meshPtr->vertexArrayOrList, vertexPtr))
+		{
+			if ((vertexExtRef = e3meshVertex_ExtRefInMesh(vertexPtr, meshPtr)) == nullptr)
+				throw std::bad_alloc();
 
-	// Initialise the instance data of the new object
-	qd3dStatus = kQ3Success;
+			vertexPtr->topologyIndex = meshPtr->topologyPtr->AddVertex(vertexExtRef);
+		}
 
+		for (facePtr = e3meshFaceArrayOrList_FirstItem(&meshPtr->faceArrayOrList);
+			facePtr != nullptr;
+			facePtr = e3meshFaceArrayOrList_NextItem(&meshPtr->faceArrayOrList, facePtr))
+		{
+			e3meshFace_AddToTopology(facePtr, meshPtr, vertexIndices);
+		}
+	}
+	catch (const std::bad_alloc&)
+	{
+		e3mesh_DiscardTopology(meshPtr);
+		E3ErrorManager_PostError(kQ3ErrorOutOfMemory, kQ3False);
+	}
 
+	return(meshPtr->topologyPtr);
+}
 
-	// Handle failure
-	//if (qd3dStatus != kQ3Success)
-	//	nullptr;
 
-	return(qd3dStatus);
+
+
+
+//=============================================================================
+//      e3mesh_AddVertexToTopology : Add new vertex to topology, if any.
+//-----------------------------------------------------------------------------
+//		Note :	If unable to add vertex (out of memory), the topology is
+//				discarded, to be rebuilt when next needed.
+//-----------------------------------------------------------------------------
+static
+void
+e3mesh_AddVertexToTopology(
+	TE3MeshData* meshPtr,
+	TE3MeshVertexData* vertexPtr)
+{
+	TE3MeshVertexExtRef vertexExtRef;
+
+	if (meshPtr->topologyPtr == nullptr)
+		return;
+
+	try
+	{
+		if ((vertexExtRef = e3meshVertex_ExtRefInMesh(vertexPtr, meshPtr)) == nullptr)
+			throw std::bad_alloc();
+
+		vertexPtr->topologyIndex = meshPtr->topologyPtr->AddVertex(vertexExtRef);
+	}
+	catch (const std::bad_alloc&)
+	{
+		e3mesh_DiscardTopology(meshPtr);
+	}
 }
 
 
@@ -3501,93 +3598,551 @@ e3geom_mesh_duplicate(
 
 
 //=============================================================================
-//      e3geom_mesh_cache_new_as_polys : Mesh cache new method.
+//      e3mesh_AddFaceToTopology : Add new face to topology, if any.
 //-----------------------------------------------------------------------------
-static TQ3GroupObject
-e3geom_mesh_cache_new_as_polys(const TE3MeshData * meshPtr)
+//		Note :	If unable to add face (out of memory), the topology is
+//				discarded, to be rebuilt when next needed.
+//-----------------------------------------------------------------------------
+static
+void
+e3mesh_AddFaceToTopology(
+	TE3MeshData* meshPtr,
+	TE3MeshFaceData* facePtr)
 {
-#define _MESH_AS_POLYS_OBJECTS_TO_DELETE_GROW 16
+	if (meshPtr->topologyPtr == nullptr)
+		return;
 
-	const TE3MeshFaceData* 			facePtr;
-	const TE3MeshContourData* 		contourPtr;
-	const TE3MeshVertexPtr* 		vertexHdl;
-	const TE3MeshCornerData* 		cornerPtr;
-	
-	TQ3GroupObject 					thePolysGroup = nullptr;
-	TQ3GeneralPolygonData			polyData;
-	TQ3Object						*objectsToDelete;
-	TQ3Uns32						numObjectsToDelete;
-	TQ3Uns32						allocatedObjectsToDelete;
-	TQ3Vertex3D						*currentVertex;
-	TQ3Object 						thePoly;
-	TQ3Uns32						i,j;
-	
-	
-    polyData.contours = nullptr;
-    polyData.shapeHint = kQ3GeneralPolygonShapeHintComplex;
-    polyData.generalPolygonAttributeSet = nullptr;
-    
+	try
+	{
+		std::vector<TQ3Uns32> vertexIndices;
 
+		e3meshFace_AddToTopology(facePtr, meshPtr, vertexIndices);
+	}
+	catch (const std::bad_alloc&)
+	{
+		e3mesh_DiscardTopology(meshPtr);
+	}
+}
 
-	thePolysGroup = Q3OrderedDisplayGroup_New ();
-	if(thePolysGroup == nullptr)
-		return nullptr;
-	
-	objectsToDelete = (TQ3Object*) Q3Memory_Allocate(_MESH_AS_POLYS_OBJECTS_TO_DELETE_GROW * sizeof(TQ3Object));
-	if(objectsToDelete == nullptr)
-		return thePolysGroup;
-		
-	allocatedObjectsToDelete = _MESH_AS_POLYS_OBJECTS_TO_DELETE_GROW;
-	
-	// add the mesh attribute Set to the group
-	if(meshPtr->attributeSet != nullptr)
-		Q3Group_AddObject(thePolysGroup,meshPtr->attributeSet);
-		
-	numObjectsToDelete = 0;
-		
-	
-	for (facePtr = e3meshFaceArrayOrList_FirstItemConst(&meshPtr->faceArrayOrList);
-		facePtr != nullptr;
-		facePtr = e3meshFaceArrayOrList_NextItemConst(&meshPtr->faceArrayOrList, facePtr))
+
+
+
+
+//=============================================================================
+//      e3meshEdge_ExtRefInMesh : Return external reference to edge.
+//-----------------------------------------------------------------------------
+//		Note :	An edge record begins with a pointer to its master pointer,
+//				as a part does, so edges share the mesh's pool of master
+//				pointers. The topology keeps the master pointer up to date.
+//-----------------------------------------------------------------------------
+//		Note : If unable to get external reference (out of memory), return nullptr.
+//-----------------------------------------------------------------------------
+static
+TE3MeshEdgeExtRef
+e3meshEdge_ExtRefInMesh(
+	TQ3Uns32 edgeIndex,
+	TE3MeshData* meshPtr)
+{
+	E3MeshTopology::Edge& theEdge = meshPtr->topologyPtr->GetEdge(edgeIndex);
+
+	return(E3_DOWN_CAST(TE3MeshEdgeExtRef,
+		e3meshPart_HandleInMesh(
+			reinterpret_cast<TE3MeshPartData*>(&theEdge),
+			meshPtr)));
+}
+
+
+
+
+
+//=============================================================================
+//      e3meshEdgeExtRef_Edge : Return index of edge for external reference.
+//-----------------------------------------------------------------------------
+//		Note : If edge deleted, return E3MeshTopology::kNone.
+//-----------------------------------------------------------------------------
+static
+TQ3Uns32
+e3meshEdgeExtRef_Edge(
+	TE3MeshEdgeExtRef edgeExtRef,
+	const TE3MeshData* meshPtr)
+{
+	const E3MeshTopology::Edge* edgePtr;
+
+	if (edgeExtRef == nullptr || meshPtr->topologyPtr == nullptr)
+		return(E3MeshTopology::kNone);
+
+	edgePtr = *reinterpret_cast<E3MeshTopology::Edge**>(edgeExtRef);
+	if (edgePtr == nullptr)
+		return(E3MeshTopology::kNone);
+
+	return(meshPtr->topologyPtr->EdgeIndex(edgePtr));
+}
+
+
+
+
+
+//=============================================================================
+//      e3meshTopology_FirstUseFrom :	Return the first half-edge, starting
+//										from this one, that is the first use
+//										of its edge in its face or contour.
+//-----------------------------------------------------------------------------
+static
+TQ3Uns32
+e3meshTopology_FirstUseFrom(
+	const E3MeshTopology* topologyPtr,
+	TQ3Uns32 halfEdge,
+	TQ3Boolean byContour)
+{
+	while (halfEdge != E3MeshTopology::kNone)
+	{
+		if (byContour)
 		{
-		numObjectsToDelete = 0;
-		
-		polyData.numContours = e3meshFace_NumContours(facePtr);
-		polyData.contours = (TQ3GeneralPolygonContourData*) Q3Memory_AllocateClear(
-			polyData.numContours * sizeof(TQ3GeneralPolygonContourData));
-		if(polyData.contours == nullptr)
-			goto cleanup;
-		
-	    polyData.generalPolygonAttributeSet = facePtr->attributeSet;
-		
-		for (contourPtr = e3meshContourArrayOrList_FirstItemConst(&facePtr->contourArrayOrList), i = 0;
-			contourPtr != nullptr;
-			contourPtr = e3meshContourArrayOrList_NextItemConst(&facePtr->contourArrayOrList, contourPtr), ++i)
-			{
-			polyData.contours[i].numVertices = e3meshContour_NumVertices(contourPtr);
-			polyData.contours[i].vertices = (TQ3Vertex3D*) Q3Memory_Allocate(polyData.contours[i].numVertices * sizeof(TQ3Vertex3D));
-			if(polyData.contours == nullptr)
-				goto cleanup;
+			if (topologyPtr->IsFirstHalfEdgeOfEdgeInContour(halfEdge))
+				break;
+			halfEdge = topologyPtr->NextHalfEdgeInContour(halfEdge);
+		}
+		else
+		{
+			if (topologyPtr->IsFirstHalfEdgeOfEdgeInFace(halfEdge))
+				break;
+			halfEdge = topologyPtr->NextHalfEdgeInFace(halfEdge);
+		}
+	}
 
+	return(halfEdge);
+}
 
-			for (vertexHdl = e3meshVertexPtrArray_FirstItemConst(&contourPtr->vertexPtrArray), j = 0;
-				vertexHdl != nullptr;
-				vertexHdl = e3meshVertexPtrArray_NextItemConst(&contourPtr->vertexPtrArray, vertexHdl), ++j)
-				{
 
-				currentVertex = &polyData.contours[i].vertices[j];
-				currentVertex->point = (*vertexHdl)->point;
-				currentVertex->attributeSet = (*vertexHdl)->attributeSet;
 
-				cornerPtr = e3meshVertex_FaceCorner(*vertexHdl, facePtr);
-				if(cornerPtr != nullptr)
-					{
-					if(cornerPtr->attributeSet != nullptr)
-						{
-						if(currentVertex->attributeSet != nullptr)
-							{
-							currentVertex->attributeSet = Q3AttributeSet_New();
-							if (currentVertex->attributeSet == nullptr)
+
+
+//=============================================================================
+//      e3meshTopology_NextEdgeUse :	Return the half-edge for the next
+//										distinct edge of a face or contour.
+//-----------------------------------------------------------------------------
+static
+TQ3Uns32
+e3meshTopology_NextEdgeUse(
+	const E3MeshTopology* topologyPtr,
+	TQ3Uns32 halfEdge,
+	TQ3Boolean byContour)
+{
+	halfEdge = byContour ? topologyPtr->NextHalfEdgeInContour(halfEdge)
+						 : topologyPtr->NextHalfEdgeInFace(halfEdge);
+
+	return(e3meshTopology_FirstUseFrom(topologyPtr, halfEdge, byContour));
+}
+
+
+
+
+
+//=============================================================================
+//      e3meshTopology_NextNeighbor :	Step through the half-edges of other
+//										faces on the edges of a face or contour.
+//-----------------------------------------------------------------------------
+//		Note :	firstHalfEdge is the first half-edge of the face or contour.
+//				Starting after neighbor, or at the start if neighbor is kNone,
+//				return the next half-edge of another face on one of its edges,
+//				or kNone at the end.
+//-----------------------------------------------------------------------------
+static
+TQ3Uns32
+e3meshTopology_NextNeighbor(
+	const E3MeshTopology* topologyPtr,
+	TQ3Uns32 firstHalfEdge,
+	TQ3Boolean byContour,
+	TQ3Uns32 neighbor)
+{
+	TQ3Uns32 ownFace = topologyPtr->HalfEdgeFace(firstHalfEdge);
+	TQ3Uns32 halfEdge;
+
+	if (neighbor == E3MeshTopology::kNone)
+		halfEdge = e3meshTopology_FirstUseFrom(topologyPtr, firstHalfEdge, byContour);
+	else
+	{
+		// Find our first use of the neighbor's edge
+		halfEdge = topologyPtr->GetEdge(topologyPtr->HalfEdgeEdge(neighbor)).firstHalfEdge;
+		while (byContour ?
+			topologyPtr->HalfEdgeContour(halfEdge) != topologyPtr->HalfEdgeContour(firstHalfEdge) :
+			topologyPtr->HalfEdgeFace(halfEdge) != ownFace)
+		{
+			halfEdge = topologyPtr->HalfEdgeNextOnEdge(halfEdge);
+		}
+	}
+
+	while (halfEdge != E3MeshTopology::kNone)
+	{
+		neighbor = (neighbor == E3MeshTopology::kNone) ?
+			topologyPtr->GetEdge(topologyPtr->HalfEdgeEdge(halfEdge)).firstHalfEdge :
+			topologyPtr->HalfEdgeNextOnEdge(neighbor);
+
+		while (neighbor != E3MeshTopology::kNone &&
+			topologyPtr->HalfEdgeFace(neighbor) == ownFace)
+		{
+			neighbor = topologyPtr->HalfEdgeNextOnEdge(neighbor);
+		}
+
+		if (neighbor != E3MeshTopology::kNone)
+			break;
+
+		halfEdge = e3meshTopology_NextEdgeUse(topologyPtr, halfEdge, byContour);
+	}
+
+	return(neighbor);
+}
+
+
+
+
+
+//=============================================================================
+//      e3meshTopology_NextNeighborFace :	Step through the distinct faces
+//											sharing edges with a face or
+//											contour.
+//-----------------------------------------------------------------------------
+//		Note :	As e3meshTopology_NextNeighbor, but skipping half-edges whose
+//				faces were reached earlier.
+//-----------------------------------------------------------------------------
+static
+TQ3Uns32
+e3meshTopology_NextNeighborFace(
+	const E3MeshTopology* topologyPtr,
+	TQ3Uns32 firstHalfEdge,
+	TQ3Boolean byContour,
+	TQ3Uns32 neighbor)
+{
+	TQ3Uns32 earlier;
+
+	if (firstHalfEdge == E3MeshTopology::kNone)
+		return(E3MeshTopology::kNone);
+
+	for (;;)
+	{
+		neighbor = e3meshTopology_NextNeighbor(topologyPtr, firstHalfEdge, byContour, neighbor);
+		if (neighbor == E3MeshTopology::kNone)
+			break;
+
+		earlier = e3meshTopology_NextNeighbor(topologyPtr, firstHalfEdge, byContour, E3MeshTopology::kNone);
+		while (earlier != neighbor &&
+			topologyPtr->HalfEdgeFace(earlier) != topologyPtr->HalfEdgeFace(neighbor))
+		{
+			earlier = e3meshTopology_NextNeighbor(topologyPtr, firstHalfEdge, byContour, earlier);
+		}
+
+		if (earlier == neighbor)
+			break;
+	}
+
+	return(neighbor);
+}
+
+
+
+
+
+//=============================================================================
+//      e3meshTopology_NextVertexFace :	Step through the outgoing half-edges
+//										of a vertex in distinct faces.
+//-----------------------------------------------------------------------------
+//		Note :	Starting after halfEdge, or at the start if halfEdge is kNone,
+//				return the next outgoing half-edge of the vertex which is its
+//				first in its face, or kNone at the end.
+//-----------------------------------------------------------------------------
+static
+TQ3Uns32
+e3meshTopology_NextVertexFace(
+	const E3MeshTopology* topologyPtr,
+	TQ3Uns32 vertex,
+	TQ3Uns32 halfEdge)
+{
+	TQ3Uns32 earlier;
+
+	halfEdge = (halfEdge == E3MeshTopology::kNone) ?
+		topologyPtr->VertexFirstOut(vertex) : topologyPtr->HalfEdgeNextOut(halfEdge);
+
+	for (; halfEdge != E3MeshTopology::kNone; halfEdge = topologyPtr->HalfEdgeNextOut(halfEdge))
+	{
+		earlier = topologyPtr->VertexFirstOut(vertex);
+		while (topologyPtr->HalfEdgeFace(earlier) != topologyPtr->HalfEdgeFace(halfEdge))
+			earlier = topologyPtr->HalfEdgeNextOut(earlier);
+
+		if (earlier == halfEdge)
+			break;
+	}
+
+	return(halfEdge);
+}
+
+
+
+
+
+//=============================================================================
+//      e3meshTopology_IsNeighbor :	Is a half-edge on an edge of a face or
+//									contour?
+//-----------------------------------------------------------------------------
+//		Note :	Used to check a half-edge saved in an iterator, in case the
+//				mesh has been edited since.
+//-----------------------------------------------------------------------------
+static
+TQ3Boolean
+e3meshTopology_IsNeighbor(
+	const E3MeshTopology* topologyPtr,
+	TQ3Uns32 firstHalfEdge,
+	TQ3Boolean byContour,
+	TQ3Uns32 neighbor)
+{
+	TQ3Uns32 halfEdge;
+
+	if (firstHalfEdge == E3MeshTopology::kNone || ! topologyPtr->IsHalfEdge(neighbor))
+		return(kQ3False);
+
+	for (halfEdge = topologyPtr->GetEdge(topologyPtr->HalfEdgeEdge(neighbor)).firstHalfEdge;
+		halfEdge != E3MeshTopology::kNone;
+		halfEdge = topologyPtr->HalfEdgeNextOnEdge(halfEdge))
+	{
+		if (byContour ?
+			topologyPtr->HalfEdgeContour(halfEdge) == topologyPtr->HalfEdgeContour(firstHalfEdge) :
+			topologyPtr->HalfEdgeFace(halfEdge) == topologyPtr->HalfEdgeFace(firstHalfEdge))
+			return(kQ3True);
+	}
+
+	return(kQ3False);
+}
+
+
+
+
+
+//=============================================================================
+//      e3meshIterator_SetIndex : Save a topology index in an iterator.
+//-----------------------------------------------------------------------------
+static
+void
+e3meshIterator_SetIndex(
+	TQ3MeshIterator* iteratorPtr,
+	TQ3Uns32 index)
+{
+	iteratorPtr->var3 = (void*) (uintptr_t) index;
+}
+
+
+
+
+
+//=============================================================================
+//      e3meshIterator_Index : Return the topology index saved in an iterator.
+//-----------------------------------------------------------------------------
+static
+TQ3Uns32
+e3meshIterator_Index(
+	const TQ3MeshIterator* iteratorPtr)
+{
+	return((TQ3Uns32) (uintptr_t) iteratorPtr->var3);
+}
+
+
+
+
+
+//=============================================================================
+//      e3meshIterator_Initialize : TQ3MeshIterator partial constructor.
+//-----------------------------------------------------------------------------
+#pragma mark -
+static
+void
+e3meshIterator_Initialize(
+	TQ3MeshIterator* iteratorPtr,
+	TE3MeshData* meshPtr,
+	const char* iteratorKind)
+{
+	// Save mesh
+	iteratorPtr->var4.field1 = meshPtr;
+
+	// Save iterator kind
+	strncpy(iteratorPtr->var4.field2, iteratorKind, 4);
+	
+	// Initialize other fields
+	iteratorPtr->var1 =
+	iteratorPtr->var2 =
+	iteratorPtr->var3 = nullptr;
+}
+
+
+
+
+
+//=============================================================================
+//      e3geom_mesh_new : TE3MeshData constructor.
+//-----------------------------------------------------------------------------
+//		Note : If unable to create (out of memory), return kQ3Failure.
+//-----------------------------------------------------------------------------
+#pragma mark -
+static
+TQ3Status
+e3geom_mesh_new(
+	TQ3Object theObject,
+	void *privateData,
+	const void *paramData)
+{
+#pragma unused(theObject)
+#pragma unused(paramData)
+
+	return(e3mesh_Create(E3_DOWN_CAST(TE3MeshData*, privateData)));
+}
+
+
+
+
+
+//=============================================================================
+//      e3geom_mesh_delete : TE3MeshData destructor.
+//-----------------------------------------------------------------------------
+static
+void
+e3geom_mesh_delete(
+	TQ3Object theObject,
+	void *privateData)
+{
+#pragma unused(theObject)
+
+	e3mesh_Destroy(E3_DOWN_CAST(TE3MeshData*, privateData));
+}
+
+
+
+
+
+//=============================================================================
+//      e3geom_mesh_duplicate : Mesh duplicate method.
+//-----------------------------------------------------------------------------
+static
+TQ3Status
+e3geom_mesh_duplicate(
+	TQ3Object fromObject,
+	const void *fromPrivateData,
+	TQ3Object toObject,
+	void *toPrivateData)
+{	const TE3MeshData*		fromInstanceData = (const TE3MeshData*) fromPrivateData;
+	TE3MeshData*			toInstanceData   = (TE3MeshData*)       toPrivateData;
+	TQ3Status				qd3dStatus;
+
+
+
+	// Validate our parameters
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(fromObject),      kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(fromPrivateData), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(toObject),        kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(toPrivateData),   kQ3Failure);
+
+
+
+	// Initialise the instance data of the new object
+	qd3dStatus = kQ3Success;
+
+
+
+	// Handle failure
+	//if (qd3dStatus != kQ3Success)
+	//	nullptr;
+
+	return(qd3dStatus);
+}
+
+
+
+
+
+//=============================================================================
+//      e3geom_mesh_cache_new_as_polys : Mesh cache new method.
+//-----------------------------------------------------------------------------
+static TQ3GroupObject
+e3geom_mesh_cache_new_as_polys(const TE3MeshData * meshPtr)
+{
+#define _MESH_AS_POLYS_OBJECTS_TO_DELETE_GROW 16
+
+	const TE3MeshFaceData* 			facePtr;
+	const TE3MeshContourData* 		contourPtr;
+	const TE3MeshVertexPtr* 		vertexHdl;
+	const TE3MeshCornerData* 		cornerPtr;
+	
+	TQ3GroupObject 					thePolysGroup = nullptr;
+	TQ3GeneralPolygonData			polyData;
+	TQ3Object						*objectsToDelete;
+	TQ3Uns32						numObjectsToDelete;
+	TQ3Uns32						allocatedObjectsToDelete;
+	TQ3Vertex3D						*currentVertex;
+	TQ3Object 						thePoly;
+	TQ3Uns32						i,j;
+	
+	
+    polyData.contours = nullptr;
+    polyData.shapeHint = kQ3GeneralPolygonShapeHintComplex;
+    polyData.generalPolygonAttributeSet = nullptr;
+    
+
+
+	thePolysGroup = Q3OrderedDisplayGroup_New ();
+	if(thePolysGroup == nullptr)
+		return nullptr;
+	
+	objectsToDelete = (TQ3Object*) Q3Memory_Allocate(_MESH_AS_POLYS_OBJECTS_TO_DELETE_GROW * sizeof(TQ3Object));
+	if(objectsToDelete == nullptr)
+		return thePolysGroup;
+		
+	allocatedObjectsToDelete = _MESH_AS_POLYS_OBJECTS_TO_DELETE_GROW;
+	
+	// add the mesh attribute Set to the group
+	if(meshPtr->attributeSet != nullptr)
+		Q3Group_AddObject(thePolysGroup,meshPtr->attributeSet);
+		
+	numObjectsToDelete = 0;
+		
+	
+	for (facePtr = e3meshFaceArrayOrList_FirstItemConst(&meshPtr->faceArrayOrList);
+		facePtr != nullptr;
+		facePtr = e3meshFaceArrayOrList_NextItemConst(&meshPtr->faceArrayOrList, facePtr))
+		{
+		numObjectsToDelete = 0;
+		
+		polyData.numContours = e3meshFace_NumContours(facePtr);
+		polyData.contours = (TQ3GeneralPolygonContourData*) Q3Memory_AllocateClear(
+			polyData.numContours * sizeof(TQ3GeneralPolygonContourData));
+		if(polyData.contours == nullptr)
+			goto cleanup;
+		
+	    polyData.generalPolygonAttributeSet = facePtr->attributeSet;
+		
+		for (contourPtr = e3meshContourArrayOrList_FirstItemConst(&facePtr->contourArrayOrList), i = 0;
+			contourPtr != nullptr;
+			contourPtr = e3meshContourArrayOrList_NextItemConst(&facePtr->contourArrayOrList, contourPtr), ++i)
+			{
+			polyData.contours[i].numVertices = e3meshContour_NumVertices(contourPtr);
+			polyData.contours[i].vertices = (TQ3Vertex3D*) Q3Memory_Allocate(polyData.contours[i].numVertices * sizeof(TQ3Vertex3D));
+			if(polyData.contours == nullptr)
+				goto cleanup;
+
+
+			for (vertexHdl = e3meshVertexPtrArray_FirstItemConst(&contourPtr->vertexPtrArray), j = 0;
+				vertexHdl != nullptr;
+				vertexHdl = e3meshVertexPtrArray_NextItemConst(&contourPtr->vertexPtrArray, vertexHdl), ++j)
+				{
+
+				currentVertex = &polyData.contours[i].vertices[j];
+				currentVertex->point = (*vertexHdl)->point;
+				currentVertex->attributeSet = (*vertexHdl)->attributeSet;
+
+				cornerPtr = e3meshVertex_FaceCorner(*vertexHdl, facePtr);
+				if(cornerPtr != nullptr)
+					{
+					if(cornerPtr->attributeSet != nullptr)
+						{
+						if(currentVertex->attributeSet != nullptr)
+							{
+							currentVertex->attributeSet = Q3AttributeSet_New();
+							if (currentVertex->attributeSet == nullptr)
 								{
 								currentVertex->attributeSet = (*vertexHdl)->attributeSet;
 								}
@@ -3995,6 +4550,9 @@ E3Mesh_FaceNew(
 	if (e3meshFace_CreateFromVertexExtRefs(facePtr, meshPtr, kQ3True, numVertices, vertexExtRefs, attributeSet) == kQ3Failure)
 		goto failure_3;
 
+	// Add face to topology of mesh
+	e3mesh_AddFaceToTopology(meshPtr, facePtr);
+
 	Q3Shared_Edited(meshObject);
 
 	return(e3meshFace_ExtRefInMesh(facePtr, meshPtr));
@@ -4039,6 +4597,10 @@ E3Mesh_FaceDelete(
 	// Recheck face (in case relocated)
 	facePtr = e3meshFaceExtRef_Face(faceExtRef);
 
+	// Remove face from topology of mesh
+	if (meshPtr->topologyPtr != nullptr)
+		meshPtr->topologyPtr->RemoveFace(facePtr->topologyIndex);
+
 	// Erase face
 	e3meshFaceList_EraseItem(&meshPtr->faceArrayOrList.list, &e3meshFace_Destroy,
 		facePtr);
@@ -4127,6 +4689,9 @@ E3Mesh_FaceToContour(
 	e3meshFaceList_EraseItem(&meshPtr->faceArrayOrList.list, &e3meshFace_Destroy,
 		facePtr);
 
+	// Discard topology of mesh, since contours have changed faces
+	e3mesh_DiscardTopology(meshPtr);
+
 	Q3Shared_Edited(meshObject);
 
 	// Return contour
@@ -4195,6 +4760,9 @@ E3Mesh_ContourToFace(
 	// Splice contour from container face into new face
 	e3meshContourList_SpliceBackList(&containerFacePtr->contourArrayOrList.list, &facePtr->contourArrayOrList.list);
 
+	// Discard topology of mesh, since contours have changed faces
+	e3mesh_DiscardTopology(meshPtr);
+
 	Q3Shared_Edited(meshObject);
 
 success:
@@ -4250,6 +4818,9 @@ E3Mesh_VertexNew(
 	if (e3meshVertex_CreateEmptyArrayOfCorners(vertexPtr, meshPtr, kQ3True, vertexExtDataPtr) == kQ3Failure)
 		goto failure_3;
 
+	// Add vertex to topology of mesh
+	e3mesh_AddVertexToTopology(meshPtr, vertexPtr);
+
 	Q3Shared_Edited(meshObject);
 
 	return(e3meshVertex_ExtRefInMesh(vertexPtr, meshPtr));
@@ -4282,6 +4853,7 @@ E3Mesh_VertexDelete(
 	TE3MeshData* meshPtr = & ( (E3Mesh*) meshObject )->instanceData ;
 	TE3MeshVertexData* vertexPtr;
 	TE3MeshFaceData* facePtr;
+	E3MeshTopology* topologyPtr;
 
 	// Check vertex; if vertex already deleted, return kQ3Success
 	vertexPtr = e3meshVertexExtRef_Vertex(vertexExtRef);
@@ -4295,42 +4867,68 @@ E3Mesh_VertexDelete(
 	// Recheck vertex (in case relocated)
 	vertexPtr = e3meshVertexExtRef_Vertex(vertexExtRef);
 
-	// Get first face in mesh
-	facePtr = e3meshFaceArrayOrList_FirstItem(&meshPtr->faceArrayOrList);
-
-	// Delete each face having vertex
-	while (facePtr != nullptr)
+	// Delete each face having vertex, through the topology of the mesh if any
+	if ((topologyPtr = meshPtr->topologyPtr) != nullptr)
 	{
-		TE3MeshFaceData* markedMeshFacePtr = nullptr;
+		TQ3Uns32 halfEdge;
 
-		// Check if face has vertex
-		if (e3meshFace_HasVertex(facePtr, vertexPtr))
+		while ((halfEdge = topologyPtr->VertexFirstOut(vertexPtr->topologyIndex)) != E3MeshTopology::kNone)
 		{
-			TE3MeshFaceExtRef faceExtRef = nullptr;
-
-			// Save face
-			if ((faceExtRef = e3meshFace_ExtRefInMesh(facePtr, meshPtr)) == nullptr)
-				goto failure;
+			TQ3Uns32 face = topologyPtr->HalfEdgeFace(halfEdge);
+			TE3MeshFaceExtRef faceExtRef = (TE3MeshFaceExtRef) topologyPtr->FaceOwner(face);
 
 			// Use list of faces in mesh (*** MAY RELOCATE FACES ***)
 			if (e3mesh_UseFaceList(meshPtr) == kQ3Failure)
 				goto failure;
 
-			// Restore face (in case relocated)
-			if ((facePtr = e3meshFaceExtRef_Face(faceExtRef)) == nullptr)
-				goto failure;
-
-			// Mark face for erasure
-			markedMeshFacePtr = facePtr;
+			// Remove face from topology, and erase face
+			topologyPtr->RemoveFace(face);
+			e3meshFaceList_EraseItem(&meshPtr->faceArrayOrList.list, &e3meshFace_Destroy,
+				e3meshFaceExtRef_Face(faceExtRef));
 		}
 
-		// Get next face in mesh
-		facePtr = e3meshFaceArrayOrList_NextItem(&meshPtr->faceArrayOrList, facePtr);
+		// Remove vertex from topology
+		topologyPtr->RemoveVertex(vertexPtr->topologyIndex);
+	}
+	else
+	{
+		// Get first face in mesh
+		facePtr = e3meshFaceArrayOrList_FirstItem(&meshPtr->faceArrayOrList);
 
-		// If face marked for erasure, erase face
-		if (markedMeshFacePtr)
-			e3meshFaceList_EraseItem(&meshPtr->faceArrayOrList.list, &e3meshFace_Destroy,
-				markedMeshFacePtr);
+		// Delete each face having vertex
+		while (facePtr != nullptr)
+		{
+			TE3MeshFaceData* markedMeshFacePtr = nullptr;
+
+			// Check if face has vertex
+			if (e3meshFace_HasVertex(facePtr, vertexPtr))
+			{
+				TE3MeshFaceExtRef faceExtRef = nullptr;
+
+				// Save face
+				if ((faceExtRef = e3meshFace_ExtRefInMesh(facePtr, meshPtr)) == nullptr)
+					goto failure;
+
+				// Use list of faces in mesh (*** MAY RELOCATE FACES ***)
+				if (e3mesh_UseFaceList(meshPtr) == kQ3Failure)
+					goto failure;
+
+				// Restore face (in case relocated)
+				if ((facePtr = e3meshFaceExtRef_Face(faceExtRef)) == nullptr)
+					goto failure;
+
+				// Mark face for erasure
+				markedMeshFacePtr = facePtr;
+			}
+
+			// Get next face in mesh
+			facePtr = e3meshFaceArrayOrList_NextItem(&meshPtr->faceArrayOrList, facePtr);
+
+			// If face marked for erasure, erase face
+			if (markedMeshFacePtr)
+				e3meshFaceList_EraseItem(&meshPtr->faceArrayOrList.list, &e3meshFace_Destroy,
+					markedMeshFacePtr);
+		}
 	}
 
 	// Erase vertex from mesh
@@ -4535,20 +5133,26 @@ failure:
 
 
 //=============================================================================
-//      E3Mesh_GetNumEdges : One-line description of the method.
+//      E3Mesh_GetNumEdges : Get number of edges in mesh.
 //-----------------------------------------------------------------------------
-//		Note : More detailed comments can be placed here if required.
+//		Note : If unable to build topology (out of memory), return kQ3Failure.
 //-----------------------------------------------------------------------------
 TQ3Status
 E3Mesh_GetNumEdges(
 	TQ3GeometryObject meshObject,
 	TQ3Uns32* numEdgesPtr)
 {
-	//TE3MeshData* meshPtr = & ( (E3Mesh*) meshObject )->instanceData ;
+	TE3MeshData* meshPtr = & ( (E3Mesh*) meshObject )->instanceData ;
+	E3MeshTopology* topologyPtr;
 
+	// Get topology of mesh
+	if ((topologyPtr = e3mesh_Topology(meshPtr)) == nullptr)
+		return(kQ3Failure);
 
-	// To be implemented...
-	return(kQ3Failure);
+	// Get number of edges in mesh
+	*numEdgesPtr = topologyPtr->NumEdges();
+
+	return(kQ3Success);
 }
 
 
@@ -4556,19 +5160,46 @@ E3Mesh_GetNumEdges(
 
 
 //=============================================================================
-//      E3Mesh_FirstMeshEdge : One-line description of the method.
+//      E3Mesh_FirstMeshEdge : Get first edge in mesh.
 //-----------------------------------------------------------------------------
-//		Note : More detailed comments can be placed here if required.
+//		Note :	If no first edge, unable to build topology or unable to create
+//				external reference to edge, return nullptr.
 //-----------------------------------------------------------------------------
 TE3MeshEdgeExtRef
 E3Mesh_FirstMeshEdge(
 	TQ3GeometryObject meshObject,
 	TQ3MeshIterator* iteratorPtr)
 {
-	//TE3MeshData* meshPtr = & ( (E3Mesh*) meshObject )->instanceData ;
+	TE3MeshData* meshPtr = & ( (E3Mesh*) meshObject )->instanceData ;
+	E3MeshTopology* topologyPtr;
+	TE3MeshEdgeExtRef edgeExtRef;
+	TQ3Uns32 edge;
 
+	// Initialize iterator
+	e3meshIterator_Initialize(iteratorPtr, meshPtr, "meed");
 
-	// To be implemented...
+	// Get topology of mesh
+	if ((topologyPtr = e3mesh_Topology(meshPtr)) == nullptr)
+		goto failure;
+
+	// Get and save first edge in mesh
+	for (edge = 0; edge < topologyPtr->EdgeSlots(); ++edge)
+	{
+		if (topologyPtr->IsEdge(edge))
+			break;
+	}
+	if (edge == topologyPtr->EdgeSlots())
+		goto failure;
+	if ((edgeExtRef = e3meshEdge_ExtRefInMesh(edge, meshPtr)) == nullptr)
+		goto failure;
+	iteratorPtr->var1 = edgeExtRef;
+
+	// Return first edge in mesh
+	return(edgeExtRef);
+	
+failure:
+
+	iteratorPtr->var1 = nullptr;
 	return(nullptr);
 }
 
@@ -4577,17 +5208,45 @@ E3Mesh_FirstMeshEdge(
 
 
 //=============================================================================
-//      E3Mesh_NextMeshEdge : One-line description of the method.
+//      E3Mesh_NextMeshEdge : Get next edge in mesh.
 //-----------------------------------------------------------------------------
-//		Note : More detailed comments can be placed here if required.
+//		Note :	If iterator ended, current edge deleted, no next edge or
+//				unable to create external reference to edge, return nullptr.
 //-----------------------------------------------------------------------------
 TE3MeshEdgeExtRef
 E3Mesh_NextMeshEdge(
-TQ3MeshIterator* iteratorPtr)
+	TQ3MeshIterator* iteratorPtr)
 {
+	TE3MeshData* meshPtr = (TE3MeshData*) iteratorPtr->var4.field1;
+	E3MeshTopology* topologyPtr;
+	TE3MeshEdgeExtRef edgeExtRef;
+	TQ3Uns32 edge;
 
+	// Restore and check current edge in mesh
+	if ((edgeExtRef = (TE3MeshEdgeExtRef) iteratorPtr->var1) == nullptr)
+		goto failure;
+	if ((edge = e3meshEdgeExtRef_Edge(edgeExtRef, meshPtr)) == E3MeshTopology::kNone)
+		goto failure;
+	topologyPtr = meshPtr->topologyPtr;
 
-	// To be implemented...
+	// Get and save next edge in mesh
+	for (++edge; edge < topologyPtr->EdgeSlots(); ++edge)
+	{
+		if (topologyPtr->IsEdge(edge))
+			break;
+	}
+	if (edge == topologyPtr->EdgeSlots())
+		goto failure;
+	if ((edgeExtRef = e3meshEdge_ExtRefInMesh(edge, meshPtr)) == nullptr)
+		goto failure;
+	iteratorPtr->var1 = edgeExtRef;
+
+	// Return next edge in mesh
+	return(edgeExtRef);
+	
+failure:
+
+	iteratorPtr->var1 = nullptr;
 	return(nullptr);
 }
 
@@ -5035,18 +5694,55 @@ E3Mesh_GetFaceComponent(
 
 
 //=============================================================================
-//      E3Mesh_FirstFaceFace : One-line description of the method.
+//      E3Mesh_FirstFaceFace : Get first face sharing an edge with face.
 //-----------------------------------------------------------------------------
-//		Note : More detailed comments can be placed here if required.
+//		Note :	If face deleted, no first face or unable to build topology,
+//				return nullptr.
 //-----------------------------------------------------------------------------
 TE3MeshFaceExtRef
 E3Mesh_FirstFaceFace(
 	TE3MeshFaceExtRef faceExtRef,
 	TQ3MeshIterator* iteratorPtr)
 {
+	TE3MeshData* meshPtr;
+	TE3MeshFaceData* facePtr;
+	E3MeshTopology* topologyPtr;
+	TE3MeshFaceExtRef neighborExtRef;
+	TQ3Uns32 neighbor;
 
+	// Get mesh for face
+	if ((meshPtr = e3meshFaceExtRef_Mesh(faceExtRef)) == nullptr)
+		goto failure;
+	
+	// Initialize iterator
+	e3meshIterator_Initialize(iteratorPtr, meshPtr, "fafa");
 
-	// To be implemented...
+	// Check and save face
+	if ((facePtr = e3meshFaceExtRef_Face(faceExtRef)) == nullptr)
+		goto failure;
+	iteratorPtr->var2 = faceExtRef;
+
+	// Get topology of mesh
+	if ((topologyPtr = e3mesh_Topology(meshPtr)) == nullptr)
+		goto failure;
+
+	// Get and save first neighboring face
+	neighbor = e3meshTopology_NextNeighborFace(topologyPtr,
+		topologyPtr->FaceFirstHalfEdge(facePtr->topologyIndex), kQ3False,
+		E3MeshTopology::kNone);
+	if (neighbor == E3MeshTopology::kNone)
+		goto failure;
+	neighborExtRef = (TE3MeshFaceExtRef) topologyPtr->FaceOwner(topologyPtr->HalfEdgeFace(neighbor));
+	iteratorPtr->var1 = neighborExtRef;
+	e3meshIterator_SetIndex(iteratorPtr, neighbor);
+
+	// Return first neighboring face
+	return(neighborExtRef);
+	
+failure:
+
+	iteratorPtr->var2 = nullptr;
+	iteratorPtr->var1 = nullptr;
 	return(nullptr);
 }
 
@@ -5055,17 +5751,55 @@ E3Mesh_FirstFaceFace(
 
 
 //=============================================================================
-//      E3Mesh_NextFaceFace : One-line description of the method.
+//      E3Mesh_NextFaceFace : Get next face sharing an edge with face.
 //-----------------------------------------------------------------------------
-//		Note : More detailed comments can be placed here if required.
+//		Note :	If iterator ended, face deleted, current face deleted or no
+//				next face, return nullptr.
 //-----------------------------------------------------------------------------
 TE3MeshFaceExtRef
 E3Mesh_NextFaceFace(
 	TQ3MeshIterator* iteratorPtr)
 {
+	TE3MeshData* meshPtr = (TE3MeshData*) iteratorPtr->var4.field1;
+	TE3MeshFaceExtRef faceExtRef;
+	TE3MeshFaceData* facePtr;
+	E3MeshTopology* topologyPtr;
+	TE3MeshFaceExtRef neighborExtRef;
+	TQ3Uns32 firstHalfEdge;
+	TQ3Uns32 neighbor;
+
+	// Restore and check face
+	if ((faceExtRef = (TE3MeshFaceExtRef) iteratorPtr->var2) == nullptr)
+		goto failure;
+	if ((facePtr = e3meshFaceExtRef_Face(faceExtRef)) == nullptr)
+		goto failure;
+	if ((topologyPtr = meshPtr->topologyPtr) == nullptr)
+		goto failure;
+	firstHalfEdge = topologyPtr->FaceFirstHalfEdge(facePtr->topologyIndex);
+
+	// Restore and check current neighboring face
+	if ((neighborExtRef = (TE3MeshFaceExtRef) iteratorPtr->var1) == nullptr)
+		goto failure;
+	neighbor = e3meshIterator_Index(iteratorPtr);
+	if (! e3meshTopology_IsNeighbor(topologyPtr, firstHalfEdge, kQ3False, neighbor) ||
+		topologyPtr->FaceOwner(topologyPtr->HalfEdgeFace(neighbor)) != neighborExtRef)
+		goto failure;
 
+	// Get and save next neighboring face
+	neighbor = e3meshTopology_NextNeighborFace(topologyPtr, firstHalfEdge, kQ3False, neighbor);
+	if (neighbor == E3MeshTopology::kNone)
+		goto failure;
+	neighborExtRef = (TE3MeshFaceExtRef) topologyPtr->FaceOwner(topologyPtr->HalfEdgeFace(neighbor));
+	iteratorPtr->var1 = neighborExtRef;
+	e3meshIterator_SetIndex(iteratorPtr, neighbor);
 
-	// To be implemented...
+	// Return next neighboring face
+	return(neighborExtRef);
+	
+failure:
+
+	iteratorPtr->var2 = nullptr;
+	iteratorPtr->var1 = nullptr;
 	return(nullptr);
 }
 
@@ -5205,18 +5939,58 @@ failure:
 
 
 //=============================================================================
-//      E3Mesh_FirstFaceEdge : One-line description of the method.
+//      E3Mesh_FirstFaceEdge : Get first edge of face.
 //-----------------------------------------------------------------------------
-//		Note : More detailed comments can be placed here if required.
+//		Note :	If face deleted, no first edge, unable to build topology or
+//				unable to create external reference to edge, return nullptr.
+//-----------------------------------------------------------------------------
+//		Note :	The edges of all the contours of the face are iterated, each
+//				edge once.
 //-----------------------------------------------------------------------------
 TE3MeshEdgeExtRef
 E3Mesh_FirstFaceEdge(
 	TE3MeshFaceExtRef faceExtRef,
 	TQ3MeshIterator* iteratorPtr)
 {
+	TE3MeshData* meshPtr;
+	TE3MeshFaceData* facePtr;
+	E3MeshTopology* topologyPtr;
+	TE3MeshEdgeExtRef edgeExtRef;
+	TQ3Uns32 halfEdge;
 
+	// Get mesh for face
+	if ((meshPtr = e3meshFaceExtRef_Mesh(faceExtRef)) == nullptr)
+		goto failure;
+	
+	// Initialize iterator
+	e3meshIterator_Initialize(iteratorPtr, meshPtr, "faed");
 
-	// To be implemented...
+	// Check and save face
+	if ((facePtr = e3meshFaceExtRef_Face(faceExtRef)) == nullptr)
+		goto failure;
+	iteratorPtr->var2 = faceExtRef;
+
+	// Get topology of mesh
+	if ((topologyPtr = e3mesh_Topology(meshPtr)) == nullptr)
+		goto failure;
+
+	// Get and save first edge of face
+	halfEdge = e3meshTopology_FirstUseFrom(topologyPtr,
+		topologyPtr->FaceFirstHalfEdge(facePtr->topologyIndex), kQ3False);
+	if (halfEdge == E3MeshTopology::kNone)
+		goto failure;
+	if ((edgeExtRef = e3meshEdge_ExtRefInMesh(topologyPtr->HalfEdgeEdge(halfEdge), meshPtr)) == nullptr)
+		goto failure;
+	iteratorPtr->var1 = edgeExtRef;
+	e3meshIterator_SetIndex(iteratorPtr, halfEdge);
+
+	// Return first edge of face
+	return(edgeExtRef);
+	
+failure:
+
+	iteratorPtr->var2 = nullptr;
+	iteratorPtr->var1 = nullptr;
 	return(nullptr);
 }
 
@@ -5225,16 +5999,55 @@ E3Mesh_FirstFaceEdge(
 
 
 //=============================================================================
-//      E3Mesh_NextFaceEdge : One-line description of the method.
+//      E3Mesh_NextFaceEdge : Get next edge of face.
 //-----------------------------------------------------------------------------
-//		Note : More detailed comments can be placed here if required.
+//		Note :	If iterator ended, face deleted, current edge deleted, no
+//				next edge or unable to create external reference to edge,
+//				return nullptr.
 //-----------------------------------------------------------------------------
 TE3MeshEdgeExtRef
 E3Mesh_NextFaceEdge(TQ3MeshIterator* iteratorPtr)
 {
+	TE3MeshData* meshPtr = (TE3MeshData*) iteratorPtr->var4.field1;
+	TE3MeshFaceExtRef faceExtRef;
+	TE3MeshFaceData* facePtr;
+	E3MeshTopology* topologyPtr;
+	TE3MeshEdgeExtRef edgeExtRef;
+	TQ3Uns32 edge;
+	TQ3Uns32 halfEdge;
+
+	// Restore and check face
+	if ((faceExtRef = (TE3MeshFaceExtRef) iteratorPtr->var2) == nullptr)
+		goto failure;
+	if ((facePtr = e3meshFaceExtRef_Face(faceExtRef)) == nullptr)
+		goto failure;
 
+	// Restore and check current edge of face
+	if ((edge = e3meshEdgeExtRef_Edge((TE3MeshEdgeExtRef) iteratorPtr->var1, meshPtr)) == E3MeshTopology::kNone)
+		goto failure;
+	topologyPtr = meshPtr->topologyPtr;
+	halfEdge = e3meshIterator_Index(iteratorPtr);
+	if (! topologyPtr->IsHalfEdge(halfEdge) ||
+		topologyPtr->HalfEdgeEdge(halfEdge) != edge ||
+		topologyPtr->HalfEdgeFace(halfEdge) != facePtr->topologyIndex)
+		goto failure;
 
-	// To be implemented...
+	// Get and save next edge of face
+	halfEdge = e3meshTopology_NextEdgeUse(topologyPtr, halfEdge, kQ3False);
+	if (halfEdge == E3MeshTopology::kNone)
+		goto failure;
+	if ((edgeExtRef = e3meshEdge_ExtRefInMesh(topologyPtr->HalfEdgeEdge(halfEdge), meshPtr)) == nullptr)
+		goto failure;
+	iteratorPtr->var1 = edgeExtRef;
+	e3meshIterator_SetIndex(iteratorPtr, halfEdge);
+
+	// Return next edge of face
+	return(edgeExtRef);
+	
+failure:
+
+	iteratorPtr->var2 = nullptr;
+	iteratorPtr->var1 = nullptr;
 	return(nullptr);
 }
 
@@ -5471,18 +6284,55 @@ failure:
 
 
 //=============================================================================
-//      E3Mesh_FirstContourFace : One-line description of the method.
+//      E3Mesh_FirstContourFace : Get first face sharing an edge with contour.
 //-----------------------------------------------------------------------------
-//		Note : More detailed comments can be placed here if required.
+//		Note :	If contour deleted, no first face or unable to build topology,
+//				return nullptr.
 //-----------------------------------------------------------------------------
 TE3MeshFaceExtRef
 E3Mesh_FirstContourFace(
 	TE3MeshContourExtRef contourExtRef,
 	TQ3MeshIterator* iteratorPtr)
 {
+	TE3MeshData* meshPtr;
+	TE3MeshContourData* contourPtr;
+	E3MeshTopology* topologyPtr;
+	TE3MeshFaceExtRef neighborExtRef;
+	TQ3Uns32 neighbor;
+
+	// Get mesh for contour
+	if ((meshPtr = e3meshContourExtRef_Mesh(contourExtRef)) == nullptr)
+		goto failure;
+	
+	// Initialize iterator
+	e3meshIterator_Initialize(iteratorPtr, meshPtr, "ctfa");
 
+	// Check and save contour
+	if ((contourPtr = e3meshContourExtRef_Contour(contourExtRef)) == nullptr)
+		goto failure;
+	iteratorPtr->var2 = contourExtRef;
 
-	// To be implemented...
+	// Get topology of mesh
+	if ((topologyPtr = e3mesh_Topology(meshPtr)) == nullptr)
+		goto failure;
+
+	// Get and save first neighboring face
+	neighbor = e3meshTopology_NextNeighborFace(topologyPtr,
+		topologyPtr->ContourFirstHalfEdge(contourPtr->topologyIndex), kQ3True,
+		E3MeshTopology::kNone);
+	if (neighbor == E3MeshTopology::kNone)
+		goto failure;
+	neighborExtRef = (TE3MeshFaceExtRef) topologyPtr->FaceOwner(topologyPtr->HalfEdgeFace(neighbor));
+	iteratorPtr->var1 = neighborExtRef;
+	e3meshIterator_SetIndex(iteratorPtr, neighbor);
+
+	// Return first neighboring face
+	return(neighborExtRef);
+	
+failure:
+
+	iteratorPtr->var2 = nullptr;
+	iteratorPtr->var1 = nullptr;
 	return(nullptr);
 }
 
@@ -5491,17 +6341,55 @@ E3Mesh_FirstContourFace(
 
 
 //=============================================================================
-//      E3Mesh_NextContourFace : One-line description of the method.
+//      E3Mesh_NextContourFace : Get next face sharing an edge with contour.
 //-----------------------------------------------------------------------------
-//		Note : More detailed comments can be placed here if required.
+//		Note :	If iterator ended, contour deleted, current face deleted or no
+//				next face, return nullptr.
 //-----------------------------------------------------------------------------
 TE3MeshFaceExtRef
 E3Mesh_NextContourFace(
 	TQ3MeshIterator* iteratorPtr)
 {
+	TE3MeshData* meshPtr = (TE3MeshData*) iteratorPtr->var4.field1;
+	TE3MeshContourExtRef contourExtRef;
+	TE3MeshContourData* contourPtr;
+	E3MeshTopology* topologyPtr;
+	TE3MeshFaceExtRef neighborExtRef;
+	TQ3Uns32 firstHalfEdge;
+	TQ3Uns32 neighbor;
+
+	// Restore and check contour
+	if ((contourExtRef = (TE3MeshContourExtRef) iteratorPtr->var2) == nullptr)
+		goto failure;
+	if ((contourPtr = e3meshContourExtRef_Contour(contourExtRef)) == nullptr)
+		goto failure;
+	if ((topologyPtr = meshPtr->topologyPtr) == nullptr)
+		goto failure;
+	firstHalfEdge = topologyPtr->ContourFirstHalfEdge(contourPtr->topologyIndex);
+
+	// Restore and check current neighboring face
+	if ((neighborExtRef = (TE3MeshFaceExtRef) iteratorPtr->var1) == nullptr)
+		goto failure;
+	neighbor = e3meshIterator_Index(iteratorPtr);
+	if (! e3meshTopology_IsNeighbor(topologyPtr, firstHalfEdge, kQ3True, neighbor) ||
+		topologyPtr->FaceOwner(topologyPtr->HalfEdgeFace(neighbor)) != neighborExtRef)
+		goto failure;
 
+	// Get and save next neighboring face
+	neighbor = e3meshTopology_NextNeighborFace(topologyPtr, firstHalfEdge, kQ3True, neighbor);
+	if (neighbor == E3MeshTopology::kNone)
+		goto failure;
+	neighborExtRef = (TE3MeshFaceExtRef) topologyPtr->FaceOwner(topologyPtr->HalfEdgeFace(neighbor));
+	iteratorPtr->var1 = neighborExtRef;
+	e3meshIterator_SetIndex(iteratorPtr, neighbor);
 
-	// To be implemented...
+	// Return next neighboring face
+	return(neighborExtRef);
+	
+failure:
+
+	iteratorPtr->var2 = nullptr;
+	iteratorPtr->var1 = nullptr;
 	return(nullptr);
 }
 
@@ -5510,18 +6398,55 @@ E3Mesh_NextContourFace(
 
 
 //=============================================================================
-//      E3Mesh_FirstContourEdge : One-line description of the method.
+//      E3Mesh_FirstContourEdge : Get first edge of contour.
 //-----------------------------------------------------------------------------
-//		Note : More detailed comments can be placed here if required.
+//		Note :	If contour deleted, no first edge, unable to build topology or
+//				unable to create external reference to edge, return nullptr.
 //-----------------------------------------------------------------------------
 TE3MeshEdgeExtRef
 E3Mesh_FirstContourEdge(
 	TE3MeshContourExtRef contourExtRef,
 	TQ3MeshIterator* iteratorPtr)
 {
+	TE3MeshData* meshPtr;
+	TE3MeshContourData* contourPtr;
+	E3MeshTopology* topologyPtr;
+	TE3MeshEdgeExtRef edgeExtRef;
+	TQ3Uns32 halfEdge;
 
+	// Get mesh for contour
+	if ((meshPtr = e3meshContourExtRef_Mesh(contourExtRef)) == nullptr)
+		goto failure;
+	
+	// Initialize iterator
+	e3meshIterator_Initialize(iteratorPtr, meshPtr, "cted");
 
-	// To be implemented...
+	// Check and save contour
+	if ((contourPtr = e3meshContourExtRef_Contour(contourExtRef)) == nullptr)
+		goto failure;
+	iteratorPtr->var2 = contourExtRef;
+
+	// Get topology of mesh
+	if ((topologyPtr = e3mesh_Topology(meshPtr)) == nullptr)
+		goto failure;
+
+	// Get and save first edge of contour
+	halfEdge = e3meshTopology_FirstUseFrom(topologyPtr,
+		topologyPtr->ContourFirstHalfEdge(contourPtr->topologyIndex), kQ3True);
+	if (halfEdge == E3MeshTopology::kNone)
+		goto failure;
+	if ((edgeExtRef = e3meshEdge_ExtRefInMesh(topologyPtr->HalfEdgeEdge(halfEdge), meshPtr)) == nullptr)
+		goto failure;
+	iteratorPtr->var1 = edgeExtRef;
+	e3meshIterator_SetIndex(iteratorPtr, halfEdge);
+
+	// Return first edge of contour
+	return(edgeExtRef);
+	
+failure:
+
+	iteratorPtr->var2 = nullptr;
+	iteratorPtr->var1 = nullptr;
 	return(nullptr);
 }
 
@@ -5530,17 +6455,55 @@ E3Mesh_FirstContourEdge(
 
 
 //=============================================================================
-//      E3Mesh_NextContourEdge : One-line description of the method.
+//      E3Mesh_NextContourEdge : Get next edge of contour.
 //-----------------------------------------------------------------------------
-//		Note : More detailed comments can be placed here if required.
+//		Note :	If iterator ended, contour deleted, current edge deleted, no
+//				next edge or unable to create external reference to edge,
+//				return nullptr.
 //-----------------------------------------------------------------------------
 TE3MeshEdgeExtRef
-E3Mesh_NextContourEdge(
-	TQ3MeshIterator* iteratorPtr)
+E3Mesh_NextContourEdge(TQ3MeshIterator* iteratorPtr)
 {
+	TE3MeshData* meshPtr = (TE3MeshData*) iteratorPtr->var4.field1;
+	TE3MeshContourExtRef contourExtRef;
+	TE3MeshContourData* contourPtr;
+	E3MeshTopology* topologyPtr;
+	TE3MeshEdgeExtRef edgeExtRef;
+	TQ3Uns32 edge;
+	TQ3Uns32 halfEdge;
+
+	// Restore and check contour
+	if ((contourExtRef = (TE3MeshContourExtRef) iteratorPtr->var2) == nullptr)
+		goto failure;
+	if ((contourPtr = e3meshContourExtRef_Contour(contourExtRef)) == nullptr)
+		goto failure;
 
+	// Restore and check current edge of contour
+	if ((edge = e3meshEdgeExtRef_Edge((TE3MeshEdgeExtRef) iteratorPtr->var1, meshPtr)) == E3MeshTopology::kNone)
+		goto failure;
+	topologyPtr = meshPtr->topologyPtr;
+	halfEdge = e3meshIterator_Index(iteratorPtr);
+	if (! topologyPtr->IsHalfEdge(halfEdge) ||
+		topologyPtr->HalfEdgeEdge(halfEdge) != edge ||
+		topologyPtr->HalfEdgeContour(halfEdge) != contourPtr->topologyIndex)
+		goto failure;
 
-	// To be implemented...
+	// Get and save next edge of contour
+	halfEdge = e3meshTopology_NextEdgeUse(topologyPtr, halfEdge, kQ3True);
+	if (halfEdge == E3MeshTopology::kNone)
+		goto failure;
+	if ((edgeExtRef = e3meshEdge_ExtRefInMesh(topologyPtr->HalfEdgeEdge(halfEdge), meshPtr)) == nullptr)
+		goto failure;
+	iteratorPtr->var1 = edgeExtRef;
+	e3meshIterator_SetIndex(iteratorPtr, halfEdge);
+
+	// Return next edge of contour
+	return(edgeExtRef);
+	
+failure:
+
+	iteratorPtr->var2 = nullptr;
+	iteratorPtr->var1 = nullptr;
 	return(nullptr);
 }
 
@@ -5687,9 +6650,12 @@ failure:
 
 
 //=============================================================================
-//      E3Mesh_GetEdgeOnBoundary : One-line description of the method.
+//      E3Mesh_GetEdgeOnBoundary : Get whether edge is on a boundary.
 //-----------------------------------------------------------------------------
-//		Note : More detailed comments can be placed here if required.
+//		Note :	An edge is on a boundary if only one side of it is used by a
+//				contour.
+//-----------------------------------------------------------------------------
+//		Note : If edge deleted, return kQ3Failure.
 //-----------------------------------------------------------------------------
 #pragma mark -
 TQ3Status
@@ -5698,10 +6664,20 @@ E3Mesh_GetEdgeOnBoundary(
 	TE3MeshEdgeExtRef edgeExtRef,
 	TQ3Boolean* onBoundaryPtr)
 {
-	//TE3MeshData* meshPtr = & ( (E3Mesh*) meshObject )->instanceData ;
+	TE3MeshData* meshPtr = & ( (E3Mesh*) meshObject )->instanceData ;
+	TQ3Uns32 edge;
 
+	// Check edge
+	if ((edge = e3meshEdgeExtRef_Edge(edgeExtRef, meshPtr)) == E3MeshTopology::kNone)
+		goto failure;
+
+	// Get whether edge is on a boundary
+	*onBoundaryPtr = meshPtr->topologyPtr->IsEdgeOnBoundary(edge) ? kQ3True : kQ3False;
+
+	return(kQ3Success);
+	
+failure:
 
-	// To be implemented...
 	return(kQ3Failure);
 }
 
@@ -5779,9 +6755,11 @@ E3Mesh_GetEdgeComponent(
 
 
 //=============================================================================
-//      E3Mesh_GetEdgeFaces : One-line description of the method.
+//      E3Mesh_GetEdgeFaces : Get faces on either side of edge.
 //-----------------------------------------------------------------------------
-//		Note : More detailed comments can be placed here if required.
+//		Note :	If edge deleted, return kQ3Failure.
+//-----------------------------------------------------------------------------
+//		Note :	If the edge is on a boundary, the second face is nullptr.
 //-----------------------------------------------------------------------------
 TQ3Status
 E3Mesh_GetEdgeFaces(
@@ -5790,10 +6768,26 @@ E3Mesh_GetEdgeFaces(
 	TE3MeshFaceExtRef* faceExtRefPtr1,
 	TE3MeshFaceExtRef* faceExtRefPtr2)
 {
-	//TE3MeshData* meshPtr = & ( (E3Mesh*) meshObject )->instanceData ;
+	TE3MeshData* meshPtr = & ( (E3Mesh*) meshObject )->instanceData ;
+	E3MeshTopology* topologyPtr;
+	TQ3Uns32 edge;
+	TQ3Uns32 face1, face2;
+
+	// Check edge
+	if ((edge = e3meshEdgeExtRef_Edge(edgeExtRef, meshPtr)) == E3MeshTopology::kNone)
+		goto failure;
+	topologyPtr = meshPtr->topologyPtr;
 
+	// Get faces on either side of edge
+	topologyPtr->GetEdgeFaces(edge, &face1, &face2);
+	*faceExtRefPtr1 = (TE3MeshFaceExtRef) topologyPtr->FaceOwner(face1);
+	*faceExtRefPtr2 = (face2 == E3MeshTopology::kNone) ?
+		nullptr : (TE3MeshFaceExtRef) topologyPtr->FaceOwner(face2);
+
+	return(kQ3Success);
+	
+failure:
 
-	// To be implemented...
 	return(kQ3Failure);
 }
 
@@ -5802,9 +6796,9 @@ E3Mesh_GetEdgeFaces(
 
 
 //=============================================================================
-//      E3Mesh_GetEdgeVertices : One-line description of the method.
+//      E3Mesh_GetEdgeVertices : Get vertices at ends of edge.
 //-----------------------------------------------------------------------------
-//		Note : More detailed comments can be placed here if required.
+//		Note : If edge deleted, return kQ3Failure.
 //-----------------------------------------------------------------------------
 TQ3Status
 E3Mesh_GetEdgeVertices(
@@ -5813,10 +6807,23 @@ E3Mesh_GetEdgeVertices(
 	TE3MeshVertexExtRef* vertexExtRefPtr1,
 	TE3MeshVertexExtRef* vertexExtRefPtr2)
 {
-	//TE3MeshData* meshPtr = & ( (E3Mesh*) meshObject )->instanceData ;
+	TE3MeshData* meshPtr = & ( (E3Mesh*) meshObject )->instanceData ;
+	E3MeshTopology* topologyPtr;
+	TQ3Uns32 edge;
+
+	// Check edge
+	if ((edge = e3meshEdgeExtRef_Edge(edgeExtRef, meshPtr)) == E3MeshTopology::kNone)
+		goto failure;
+	topologyPtr = meshPtr->topologyPtr;
 
+	// Get vertices at ends of edge
+	*vertexExtRefPtr1 = (TE3MeshVertexExtRef) topologyPtr->VertexOwner(topologyPtr->GetEdge(edge).vertex[0]);
+	*vertexExtRefPtr2 = (TE3MeshVertexExtRef) topologyPtr->VertexOwner(topologyPtr->GetEdge(edge).vertex[1]);
+
+	return(kQ3Success);
+	
+failure:
 
-	// To be implemented...
 	return(kQ3Failure);
 }
 
@@ -5867,9 +6874,13 @@ failure:
 
 
 //=============================================================================
-//      E3Mesh_GetVertexOnBoundary : One-line description of the method.
+//      E3Mesh_GetVertexOnBoundary : Get whether vertex is on a boundary.
 //-----------------------------------------------------------------------------
-//		Note : More detailed comments can be placed here if required.
+//		Note :	A vertex is on a boundary if any of its edges is.  A vertex
+//				that is not used by any face is not on a boundary.
+//-----------------------------------------------------------------------------
+//		Note :	If vertex deleted or unable to build topology, return
+//				kQ3Failure.
 //-----------------------------------------------------------------------------
 TQ3Status
 E3Mesh_GetVertexOnBoundary(
@@ -5877,10 +6888,25 @@ E3Mesh_GetVertexOnBoundary(
 	TE3MeshVertexExtRef vertexExtRef,
 	TQ3Boolean* onBoundaryPtr)
 {
-	//TE3MeshData* meshPtr = & ( (E3Mesh*) meshObject )->instanceData ;
+	TE3MeshData* meshPtr = & ( (E3Mesh*) meshObject )->instanceData ;
+	TE3MeshVertexData* vertexPtr;
+	E3MeshTopology* topologyPtr;
+
+	// Check vertex
+	if ((vertexPtr = e3meshVertexExtRef_Vertex(vertexExtRef)) == nullptr)
+		goto failure;
 
+	// Get topology of mesh
+	if ((topologyPtr = e3mesh_Topology(meshPtr)) == nullptr)
+		goto failure;
+
+	// Get whether vertex is on a boundary
+	*onBoundaryPtr = topologyPtr->IsVertexOnBoundary(vertexPtr->topologyIndex) ? kQ3True : kQ3False;
+
+	return(kQ3Success);
+	
+failure:
 
-	// To be implemented...
 	return(kQ3Failure);
 }
 
@@ -6046,8 +7072,8 @@ E3Mesh_GetVertexComponent(
 //=============================================================================
 //      E3Mesh_FirstVertexFace : Get first face having vertex.
 //-----------------------------------------------------------------------------
-//		Note :	If vertex deleted, no first face or unable to create
-//				external reference to face, return nullptr.
+//		Note :	If vertex deleted, no first face or unable to build topology,
+//				return nullptr.
 //-----------------------------------------------------------------------------
 TE3MeshFaceExtRef
 E3Mesh_FirstVertexFace(
@@ -6056,8 +7082,9 @@ E3Mesh_FirstVertexFace(
 {
 	TE3MeshData* meshPtr;
 	TE3MeshVertexData* vertexPtr;
-	TE3MeshFaceData* facePtr;
+	E3MeshTopology* topologyPtr;
 	TE3MeshFaceExtRef faceExtRef;
+	TQ3Uns32 halfEdge;
 
 	// Get mesh for vertex
 	if ((meshPtr = e3meshVertexExtRef_Mesh(vertexExtRef)) == nullptr)
@@ -6071,26 +7098,17 @@ E3Mesh_FirstVertexFace(
 		goto failure;
 	iteratorPtr->var2 = vertexExtRef;
 
-	// Get first face in mesh
-	if ((facePtr = e3meshFaceArrayOrList_FirstItem(&meshPtr->faceArrayOrList)) == nullptr)
+	// Get topology of mesh
+	if ((topologyPtr = e3mesh_Topology(meshPtr)) == nullptr)
 		goto failure;
 
-	// Get first face having vertex
-	for (;;)
-	{
-		// If face has vertex, break
-		if (e3meshFace_HasVertex(facePtr, vertexPtr))
-			break;
-
-		// Otherwise, get next face in mesh
-		if ((facePtr = e3meshFaceArrayOrList_NextItem(&meshPtr->faceArrayOrList, facePtr)) == nullptr)
-			goto failure;
-	}
-
-	// Save first face having vertex
-	if ((faceExtRef = e3meshFace_ExtRefInMesh(facePtr, meshPtr)) == nullptr)
+	// Get and save first face having vertex
+	halfEdge = e3meshTopology_NextVertexFace(topologyPtr, vertexPtr->topologyIndex, E3MeshTopology::kNone);
+	if (halfEdge == E3MeshTopology::kNone)
 		goto failure;
+	faceExtRef = (TE3MeshFaceExtRef) topologyPtr->FaceOwner(topologyPtr->HalfEdgeFace(halfEdge));
 	iteratorPtr->var1 = faceExtRef;
+	e3meshIterator_SetIndex(iteratorPtr, halfEdge);
 
 	// Return first face having vertex
 	return(faceExtRef);
@@ -6109,9 +7127,8 @@ failure:
 //=============================================================================
 //      E3Mesh_NextVertexFace : Get next face having vertex.
 //-----------------------------------------------------------------------------
-//		Note :	If iterator ended, vertex deleted, current face deleted,
-//				no next face or unable to create external reference to face,
-//				return nullptr.
+//		Note :	If iterator ended, vertex deleted, current face deleted or
+//				no next face, return nullptr.
 //-----------------------------------------------------------------------------
 TE3MeshFaceExtRef
 E3Mesh_NextVertexFace(
@@ -6120,37 +7137,34 @@ E3Mesh_NextVertexFace(
 	TE3MeshData* meshPtr = (TE3MeshData*) iteratorPtr->var4.field1;
 	TE3MeshVertexExtRef vertexExtRef;
 	TE3MeshVertexData* vertexPtr;
+	E3MeshTopology* topologyPtr;
 	TE3MeshFaceExtRef faceExtRef;
-	TE3MeshFaceData* facePtr;
+	TQ3Uns32 halfEdge;
 
 	// Restore and check vertex
 	if ((vertexExtRef = (TE3MeshVertexExtRef) iteratorPtr->var2) == nullptr)
 		goto failure;
 	if ((vertexPtr = e3meshVertexExtRef_Vertex(vertexExtRef)) == nullptr)
 		goto failure;
+	if ((topologyPtr = meshPtr->topologyPtr) == nullptr)
+		goto failure;
 
 	// Restore and check current face having vertex
 	if ((faceExtRef = (TE3MeshFaceExtRef) iteratorPtr->var1) == nullptr)
 		goto failure;
-	if ((facePtr = e3meshFaceExtRef_Face(faceExtRef)) == nullptr)
+	halfEdge = e3meshIterator_Index(iteratorPtr);
+	if (! topologyPtr->IsHalfEdge(halfEdge) ||
+		topologyPtr->HalfEdgeOrigin(halfEdge) != vertexPtr->topologyIndex ||
+		topologyPtr->FaceOwner(topologyPtr->HalfEdgeFace(halfEdge)) != faceExtRef)
 		goto failure;
 
-	// Get next face having vertex
-	for (;;)
-	{
-		// Get next face in mesh
-		if ((facePtr = e3meshFaceArrayOrList_NextItem(&meshPtr->faceArrayOrList, facePtr)) == nullptr)
-			goto failure;
-
-		// If face has vertex, break
-		if (e3meshFace_HasVertex(facePtr, vertexPtr))
-			break;
-	}
-
-	// Save next face having vertex
-	if ((faceExtRef = e3meshFace_ExtRefInMesh(facePtr, meshPtr)) == nullptr)
+	// Get and save next face having vertex
+	halfEdge = e3meshTopology_NextVertexFace(topologyPtr, vertexPtr->topologyIndex, halfEdge);
+	if (halfEdge == E3MeshTopology::kNone)
 		goto failure;
+	faceExtRef = (TE3MeshFaceExtRef) topologyPtr->FaceOwner(topologyPtr->HalfEdgeFace(halfEdge));
 	iteratorPtr->var1 = faceExtRef;
+	e3meshIterator_SetIndex(iteratorPtr, halfEdge);
 
 	// Return next face having vertex
 	return(faceExtRef);
@@ -6167,18 +7181,52 @@ failure:
 
 
 //=============================================================================
-//      E3Mesh_FirstVertexEdge : One-line description of the method.
+//      E3Mesh_FirstVertexEdge : Get first edge having vertex.
 //-----------------------------------------------------------------------------
-//		Note : More detailed comments can be placed here if required.
+//		Note :	If vertex deleted, no first edge, unable to build topology or
+//				unable to create external reference to edge, return nullptr.
 //-----------------------------------------------------------------------------
 TE3MeshEdgeExtRef
 E3Mesh_FirstVertexEdge(
 	TE3MeshVertexExtRef vertexExtRef,
 	TQ3MeshIterator* iteratorPtr)
 {
+	TE3MeshData* meshPtr;
+	TE3MeshVertexData* vertexPtr;
+	E3MeshTopology* topologyPtr;
+	TE3MeshEdgeExtRef edgeExtRef;
+	TQ3Uns32 edge;
 
+	// Get mesh for vertex
+	if ((meshPtr = e3meshVertexExtRef_Mesh(vertexExtRef)) == nullptr)
+		goto failure;
+	
+	// Initialize iterator
+	e3meshIterator_Initialize(iteratorPtr, meshPtr, "veed");
 
-	// To be implemented...
+	// Check and save vertex
+	if ((vertexPtr = e3meshVertexExtRef_Vertex(vertexExtRef)) == nullptr)
+		goto failure;
+	iteratorPtr->var2 = vertexExtRef;
+
+	// Get topology of mesh
+	if ((topologyPtr = e3mesh_Topology(meshPtr)) == nullptr)
+		goto failure;
+
+	// Get and save first edge having vertex
+	if ((edge = topologyPtr->VertexFirstEdge(vertexPtr->topologyIndex)) == E3MeshTopology::kNone)
+		goto failure;
+	if ((edgeExtRef = e3meshEdge_ExtRefInMesh(edge, meshPtr)) == nullptr)
+		goto failure;
+	iteratorPtr->var1 = edgeExtRef;
+
+	// Return first edge having vertex
+	return(edgeExtRef);
+	
+failure:
+
+	iteratorPtr->var2 = nullptr;
+	iteratorPtr->var1 = nullptr;
 	return(nullptr);
 }
 
@@ -6187,17 +7235,53 @@ E3Mesh_FirstVertexEdge(
 
 
 //=============================================================================
-//      E3Mesh_NextVertexEdge : One-line description of the method.
+//      E3Mesh_NextVertexEdge : Get next edge having vertex.
 //-----------------------------------------------------------------------------
-//		Note : More detailed comments can be placed here if required.
+//		Note :	If iterator ended, vertex deleted, current edge deleted, no
+//				next edge or unable to create external reference to edge,
+//				return nullptr.
 //-----------------------------------------------------------------------------
 TE3MeshEdgeExtRef
 E3Mesh_NextVertexEdge(
 	TQ3MeshIterator* iteratorPtr)
 {
+	TE3MeshData* meshPtr = (TE3MeshData*) iteratorPtr->var4.field1;
+	TE3MeshVertexExtRef vertexExtRef;
+	TE3MeshVertexData* vertexPtr;
+	E3MeshTopology* topologyPtr;
+	TE3MeshEdgeExtRef edgeExtRef;
+	TQ3Uns32 vertex;
+	TQ3Uns32 edge;
 
+	// Restore and check vertex
+	if ((vertexExtRef = (TE3MeshVertexExtRef) iteratorPtr->var2) == nullptr)
+		goto failure;
+	if ((vertexPtr = e3meshVertexExtRef_Vertex(vertexExtRef)) == nullptr)
+		goto failure;
+	vertex = vertexPtr->topologyIndex;
 
-	// To be implemented...
+	// Restore and check current edge having vertex
+	if ((edge = e3meshEdgeExtRef_Edge((TE3MeshEdgeExtRef) iteratorPtr->var1, meshPtr)) == E3MeshTopology::kNone)
+		goto failure;
+	topologyPtr = meshPtr->topologyPtr;
+	if (topologyPtr->GetEdge(edge).vertex[0] != vertex &&
+		topologyPtr->GetEdge(edge).vertex[1] != vertex)
+		goto failure;
+
+	// Get and save next edge having vertex
+	if ((edge = topologyPtr->NextEdgeAtVertex(edge, vertex)) == E3MeshTopology::kNone)
+		goto failure;
+	if ((edgeExtRef = e3meshEdge_ExtRefInMesh(edge, meshPtr)) == nullptr)
+		goto failure;
+	iteratorPtr->var1 = edgeExtRef;
+
+	// Return next edge having vertex
+	return(edgeExtRef);
+	
+failure:
+
+	iteratorPtr->var2 = nullptr;
+	iteratorPtr->var1 = nullptr;
 	return(nullptr);
 }
 
@@ -6206,18 +7290,61 @@ E3Mesh_NextVertexEdge(
 
 
 //=============================================================================
-//      E3Mesh_FirstVertexVertex : One-line description of the method.
+//      E3Mesh_FirstVertexVertex : Get first vertex sharing an edge with
+//								   vertex.
 //-----------------------------------------------------------------------------
-//		Note : More detailed comments can be placed here if required.
+//		Note :	If vertex deleted, no first vertex or unable to build
+//				topology, return nullptr.
 //-----------------------------------------------------------------------------
 TE3MeshVertexExtRef
 E3Mesh_FirstVertexVertex(
 	TE3MeshVertexExtRef vertexExtRef,
 	TQ3MeshIterator* iteratorPtr)
 {
+	TE3MeshData* meshPtr;
+	TE3MeshVertexData* vertexPtr;
+	E3MeshTopology* topologyPtr;
+	TE3MeshVertexExtRef neighborExtRef;
+	TQ3Uns32 vertex;
+	TQ3Uns32 edge;
+
+	// Get mesh for vertex
+	if ((meshPtr = e3meshVertexExtRef_Mesh(vertexExtRef)) == nullptr)
+		goto failure;
+	
+	// Initialize iterator
+	e3meshIterator_Initialize(iteratorPtr, meshPtr, "veve");
 
+	// Check and save vertex
+	if ((vertexPtr = e3meshVertexExtRef_Vertex(vertexExtRef)) == nullptr)
+		goto failure;
+	iteratorPtr->var2 = vertexExtRef;
+	vertex = vertexPtr->topologyIndex;
 
-	// To be implemented...
+	// Get topology of mesh
+	if ((topologyPtr = e3mesh_Topology(meshPtr)) == nullptr)
+		goto failure;
+
+	// Get first edge to another vertex
+	for (edge = topologyPtr->VertexFirstEdge(vertex);
+		edge != E3MeshTopology::kNone && topologyPtr->OtherVertex(edge, vertex) == vertex;
+		edge = topologyPtr->NextEdgeAtVertex(edge, vertex))
+		{}
+	if (edge == E3MeshTopology::kNone)
+		goto failure;
+
+	// Save first vertex sharing an edge with vertex
+	neighborExtRef = (TE3MeshVertexExtRef) topologyPtr->VertexOwner(topologyPtr->OtherVertex(edge, vertex));
+	iteratorPtr->var1 = neighborExtRef;
+	e3meshIterator_SetIndex(iteratorPtr, edge);
+
+	// Return first vertex sharing an edge with vertex
+	return(neighborExtRef);
+	
+failure:
+
+	iteratorPtr->var2 = nullptr;
+	iteratorPtr->var1 = nullptr;
 	return(nullptr);
 }
 
@@ -6226,17 +7353,60 @@ E3Mesh_FirstVertexVertex(
 
 
 //=============================================================================
-//      E3Mesh_NextVertexVertex : One-line description of the method.
+//      E3Mesh_NextVertexVertex : Get next vertex sharing an edge with vertex.
 //-----------------------------------------------------------------------------
-//		Note : More detailed comments can be placed here if required.
+//		Note :	If iterator ended, vertex deleted, current vertex deleted or
+//				no next vertex, return nullptr.
 //-----------------------------------------------------------------------------
 TE3MeshVertexExtRef
 E3Mesh_NextVertexVertex(
 	TQ3MeshIterator* iteratorPtr)
 {
+	TE3MeshData* meshPtr = (TE3MeshData*) iteratorPtr->var4.field1;
+	TE3MeshVertexExtRef vertexExtRef;
+	TE3MeshVertexData* vertexPtr;
+	E3MeshTopology* topologyPtr;
+	TE3MeshVertexExtRef neighborExtRef;
+	TQ3Uns32 vertex;
+	TQ3Uns32 edge;
+
+	// Restore and check vertex
+	if ((vertexExtRef = (TE3MeshVertexExtRef) iteratorPtr->var2) == nullptr)
+		goto failure;
+	if ((vertexPtr = e3meshVertexExtRef_Vertex(vertexExtRef)) == nullptr)
+		goto failure;
+	if ((topologyPtr = meshPtr->topologyPtr) == nullptr)
+		goto failure;
+	vertex = vertexPtr->topologyIndex;
 
+	// Restore and check current vertex sharing an edge with vertex
+	if ((neighborExtRef = (TE3MeshVertexExtRef) iteratorPtr->var1) == nullptr)
+		goto failure;
+	edge = e3meshIterator_Index(iteratorPtr);
+	if (! topologyPtr->IsEdge(edge) ||
+		(topologyPtr->GetEdge(edge).vertex[0] != vertex && topologyPtr->GetEdge(edge).vertex[1] != vertex) ||
+		topologyPtr->VertexOwner(topologyPtr->OtherVertex(edge, vertex)) != neighborExtRef)
+		goto failure;
 
-	// To be implemented...
+	// Get next edge to another vertex
+	do
+		edge = topologyPtr->NextEdgeAtVertex(edge, vertex);
+	while (edge != E3MeshTopology::kNone && topologyPtr->OtherVertex(edge, vertex) == vertex);
+	if (edge == E3MeshTopology::kNone)
+		goto failure;
+
+	// Save next vertex sharing an edge with vertex
+	neighborExtRef = (TE3MeshVertexExtRef) topologyPtr->VertexOwner(topologyPtr->OtherVertex(edge, vertex));
+	iteratorPtr->var1 = neighborExtRef;
+	e3meshIterator_SetIndex(iteratorPtr, edge);
+
+	// Return next vertex sharing an edge with vertex
+	return(neighborExtRef);
+	
+failure:
+
+	iteratorPtr->var2 = nullptr;
+	iteratorPtr->var1 = nullptr;
 	return(nullptr);
 }
 
@@ -0,0 +1,663 @@
+/*  NAME:
+        E3GeometryMeshTopology.cpp
+
+    DESCRIPTION:
+        Half-edge connectivity of a Mesh.
+
+    COPYRIGHT:
+        Copyright (c) 2025, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "E3GeometryMeshTopology.h"
+
+#include <algorithm>
+
+
+
+
+
+//=============================================================================
+//      Public methods
+//-----------------------------------------------------------------------------
+//      E3MeshTopology::E3MeshTopology : Constructor.
+//-----------------------------------------------------------------------------
+E3MeshTopology::E3MeshTopology()
+	: mFreeVertex( kNone )
+	, mFreeFace( kNone )
+	, mFreeContour( kNone )
+	, mFreeHalfEdge( kNone )
+	, mFreeEdge( kNone )
+	, mNumEdges( 0 )
+{
+}
+
+
+
+
+
+//=============================================================================
+//      E3MeshTopology::~E3MeshTopology : Destructor.
+//-----------------------------------------------------------------------------
+//		Note :	Master pointers of edges are left alone, since they may
+//				already have been freed along with the rest of the mesh.
+//-----------------------------------------------------------------------------
+E3MeshTopology::~E3MeshTopology()
+{
+}
+
+
+
+
+
+//=============================================================================
+//      E3MeshTopology::AddVertex : Add a vertex with no faces.
+//-----------------------------------------------------------------------------
+TQ3Uns32
+E3MeshTopology::AddVertex( void* inOwner )
+{
+	Q3_ASSERT( inOwner != nullptr );
+	TQ3Uns32	theVertex = mFreeVertex;
+	
+	if (theVertex == kNone)
+	{
+		theVertex = static_cast<TQ3Uns32>( mVertices.size() );
+		mVertices.push_back( Vertex() );
+	}
+	else
+	{
+		mFreeVertex = mVertices[ theVertex ].firstOut;
+	}
+	
+	Vertex&	newVertex( mVertices[ theVertex ] );
+	newVertex.owner = inOwner;
+	newVertex.firstOut = kNone;
+	newVertex.firstEdge = kNone;
+	
+	return theVertex;
+}
+
+
+
+
+
+//=============================================================================
+//      E3MeshTopology::RemoveVertex : Remove an unused vertex.
+//-----------------------------------------------------------------------------
+void
+E3MeshTopology::RemoveVertex( TQ3Uns32 inVertex )
+{
+	Vertex&	theVertex( mVertices[ inVertex ] );
+	Q3_ASSERT( theVertex.firstOut == kNone );
+	Q3_ASSERT( theVertex.firstEdge == kNone );
+	
+	theVertex.owner = nullptr;
+	theVertex.firstOut = mFreeVertex;
+	mFreeVertex = inVertex;
+}
+
+
+
+
+
+//=============================================================================
+//      E3MeshTopology::AddFace : Add a face with no contours.
+//-----------------------------------------------------------------------------
+TQ3Uns32
+E3MeshTopology::AddFace( void* inOwner )
+{
+	Q3_ASSERT( inOwner != nullptr );
+	TQ3Uns32	theFace = mFreeFace;
+	
+	if (theFace == kNone)
+	{
+		theFace = static_cast<TQ3Uns32>( mFaces.size() );
+		mFaces.push_back( Face() );
+	}
+	else
+	{
+		mFreeFace = mFaces[ theFace ].firstContour;
+	}
+	
+	Face&	newFace( mFaces[ theFace ] );
+	newFace.owner = inOwner;
+	newFace.firstContour = kNone;
+	newFace.lastContour = kNone;
+	
+	return theFace;
+}
+
+
+
+
+
+//=============================================================================
+//      E3MeshTopology::AddContour : Add a contour to the end of a face.
+//-----------------------------------------------------------------------------
+TQ3Uns32
+E3MeshTopology::AddContour( TQ3Uns32 inFace,
+							TQ3Uns32 inNumVertices,
+							const TQ3Uns32* inVertices )
+{
+	TQ3Uns32	theContour = NewContour();
+	mContours[ theContour ].face = inFace;
+	mContours[ theContour ].firstHalfEdge = kNone;
+	mContours[ theContour ].nextInFace = kNone;
+	
+	Face&	theFace( mFaces[ inFace ] );
+	if (theFace.lastContour == kNone)
+	{
+		theFace.firstContour = theContour;
+	}
+	else
+	{
+		mContours[ theFace.lastContour ].nextInFace = theContour;
+	}
+	theFace.lastContour = theContour;
+	
+	TQ3Uns32	prevHalfEdge = kNone;
+	for (TQ3Uns32 i = 0; i < inNumVertices; ++i)
+	{
+		TQ3Uns32	origin = inVertices[i];
+		TQ3Uns32	theEdge = FindOrAddEdge( origin,
+			inVertices[ (i + 1) % inNumVertices ] );
+		TQ3Uns32	theHalfEdge = NewHalfEdge();
+		
+		// References into the arrays are only taken once they have grown
+		HalfEdge&	newHalfEdge( mHalfEdges[ theHalfEdge ] );
+		newHalfEdge.origin = origin;
+		newHalfEdge.edge = theEdge;
+		newHalfEdge.contour = theContour;
+		newHalfEdge.nextOut = mVertices[ origin ].firstOut;
+		newHalfEdge.nextOnEdge = kNone;
+		mVertices[ origin ].firstOut = theHalfEdge;
+		
+		// Keep the half-edges of an edge in the order they were added
+		TQ3Uns32*	link = &mEdges[ theEdge ].firstHalfEdge;
+		while (*link != kNone)
+		{
+			link = &mHalfEdges[ *link ].nextOnEdge;
+		}
+		*link = theHalfEdge;
+		
+		if (prevHalfEdge == kNone)
+		{
+			mContours[ theContour ].firstHalfEdge = theHalfEdge;
+		}
+		else
+		{
+			mHalfEdges[ prevHalfEdge ].next = theHalfEdge;
+		}
+		newHalfEdge.next = mContours[ theContour ].firstHalfEdge;
+		prevHalfEdge = theHalfEdge;
+	}
+	
+	return theContour;
+}
+
+
+
+
+
+//=============================================================================
+//      E3MeshTopology::RemoveFace : Remove a face and its contours.
+//-----------------------------------------------------------------------------
+void
+E3MeshTopology::RemoveFace( TQ3Uns32 inFace )
+{
+	TQ3Uns32	theContour = mFaces[ inFace ].firstContour;
+	
+	while (theContour != kNone)
+	{
+		TQ3Uns32	firstHalfEdge = mContours[ theContour ].firstHalfEdge;
+		if (firstHalfEdge != kNone)
+		{
+			TQ3Uns32	theHalfEdge = firstHalfEdge;
+			do
+			{
+				TQ3Uns32	nextHalfEdge = mHalfEdges[ theHalfEdge ].next;
+				RemoveHalfEdge( theHalfEdge );
+				theHalfEdge = nextHalfEdge;
+			} while (theHalfEdge != firstHalfEdge);
+		}
+		
+		TQ3Uns32	nextContour = mContours[ theContour ].nextInFace;
+		mContours[ theContour ].face = kNone;
+		mContours[ theContour ].firstHalfEdge = mFreeContour;
+		mFreeContour = theContour;
+		theContour = nextContour;
+	}
+	
+	mFaces[ inFace ].owner = nullptr;
+	mFaces[ inFace ].firstContour = mFreeFace;
+	mFreeFace = inFace;
+}
+
+
+
+
+
+//=============================================================================
+//      E3MeshTopology::ReleaseEdgeRefs : Clear master pointers of edges.
+//-----------------------------------------------------------------------------
+void
+E3MeshTopology::ReleaseEdgeRefs()
+{
+	for (Edge& theEdge : mEdges)
+	{
+		if (theEdge.masterPtr != nullptr)
+		{
+			*theEdge.masterPtr = nullptr;
+			theEdge.masterPtr = nullptr;
+		}
+	}
+}
+
+
+
+
+
+//=============================================================================
+//      E3MeshTopology::IsVertexOnBoundary : Is a vertex on a boundary edge?
+//-----------------------------------------------------------------------------
+bool
+E3MeshTopology::IsVertexOnBoundary( TQ3Uns32 inVertex ) const
+{
+	for (TQ3Uns32 theEdge = mVertices[ inVertex ].firstEdge; theEdge != kNone;
+		theEdge = NextEdgeAtVertex( theEdge, inVertex ))
+	{
+		if (IsEdgeOnBoundary( theEdge ))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+
+
+
+
+//=============================================================================
+//      E3MeshTopology::FaceFirstHalfEdge : First half-edge of a face.
+//-----------------------------------------------------------------------------
+//		Note : If the face has no vertices, return kNone.
+//-----------------------------------------------------------------------------
+TQ3Uns32
+E3MeshTopology::FaceFirstHalfEdge( TQ3Uns32 inFace ) const
+{
+	for (TQ3Uns32 theContour = mFaces[ inFace ].firstContour;
+		theContour != kNone; theContour = mContours[ theContour ].nextInFace)
+	{
+		if (mContours[ theContour ].firstHalfEdge != kNone)
+		{
+			return mContours[ theContour ].firstHalfEdge;
+		}
+	}
+	return kNone;
+}
+
+
+
+
+
+//=============================================================================
+//      E3MeshTopology::NextHalfEdgeInContour : Next half-edge of a contour.
+//-----------------------------------------------------------------------------
+//		Note : At the end of the contour, return kNone.
+//-----------------------------------------------------------------------------
+TQ3Uns32
+E3MeshTopology::NextHalfEdgeInContour( TQ3Uns32 inHalfEdge ) const
+{
+	const HalfEdge&	theHalfEdge( mHalfEdges[ inHalfEdge ] );
+	
+	return (theHalfEdge.next == mContours[ theHalfEdge.contour ].firstHalfEdge)?
+		kNone : theHalfEdge.next;
+}
+
+
+
+
+
+//=============================================================================
+//      E3MeshTopology::NextHalfEdgeInFace : Next half-edge of a face.
+//-----------------------------------------------------------------------------
+//		Note :	The contours of the face are followed in turn.  At the end of
+//				the last contour, return kNone.
+//-----------------------------------------------------------------------------
+TQ3Uns32
+E3MeshTopology::NextHalfEdgeInFace( TQ3Uns32 inHalfEdge ) const
+{
+	TQ3Uns32	theNext = NextHalfEdgeInContour( inHalfEdge );
+	
+	if (theNext == kNone)
+	{
+		for (TQ3Uns32 theContour = mContours[ mHalfEdges[ inHalfEdge ].contour ].nextInFace;
+			theContour != kNone; theContour = mContours[ theContour ].nextInFace)
+		{
+			if (mContours[ theContour ].firstHalfEdge != kNone)
+			{
+				theNext = mContours[ theContour ].firstHalfEdge;
+				break;
+			}
+		}
+	}
+	return theNext;
+}
+
+
+
+
+
+//=============================================================================
+//      E3MeshTopology::IsFirstHalfEdgeOfEdgeInContour : Is this the first
+//														 use of its edge by
+//														 its contour?
+//-----------------------------------------------------------------------------
+//		Note :	"First" is in the order of the edge's half-edges, so that a
+//				contour which uses an edge twice can visit it once.
+//-----------------------------------------------------------------------------
+bool
+E3MeshTopology::IsFirstHalfEdgeOfEdgeInContour( TQ3Uns32 inHalfEdge ) const
+{
+	TQ3Uns32	theContour = mHalfEdges[ inHalfEdge ].contour;
+	TQ3Uns32	theHalfEdge = mEdges[ mHalfEdges[ inHalfEdge ].edge ].firstHalfEdge;
+	
+	while (mHalfEdges[ theHalfEdge ].contour != theContour)
+	{
+		theHalfEdge = mHalfEdges[ theHalfEdge ].nextOnEdge;
+	}
+	return theHalfEdge == inHalfEdge;
+}
+
+
+
+
+
+//=============================================================================
+//      E3MeshTopology::IsFirstHalfEdgeOfEdgeInFace : Is this the first use of
+//													  its edge by its face?
+//-----------------------------------------------------------------------------
+bool
+E3MeshTopology::IsFirstHalfEdgeOfEdgeInFace( TQ3Uns32 inHalfEdge ) const
+{
+	TQ3Uns32	theFace = HalfEdgeFace( inHalfEdge );
+	TQ3Uns32	theHalfEdge = mEdges[ mHalfEdges[ inHalfEdge ].edge ].firstHalfEdge;
+	
+	while (HalfEdgeFace( theHalfEdge ) != theFace)
+	{
+		theHalfEdge = mHalfEdges[ theHalfEdge ].nextOnEdge;
+	}
+	return theHalfEdge == inHalfEdge;
+}
+
+
+
+
+
+//=============================================================================
+//      E3MeshTopology::GetEdgeFaces : Get the faces on either side of an edge.
+//-----------------------------------------------------------------------------
+//		Note :	If the edge is on a boundary, the second face is kNone.  If
+//				more than two faces share the edge, the first two are given.
+//-----------------------------------------------------------------------------
+void
+E3MeshTopology::GetEdgeFaces( TQ3Uns32 inEdge, TQ3Uns32* outFace1,
+								TQ3Uns32* outFace2 ) const
+{
+	TQ3Uns32	theHalfEdge = mEdges[ inEdge ].firstHalfEdge;
+	*outFace1 = HalfEdgeFace( theHalfEdge );
+	*outFace2 = kNone;
+	
+	for (theHalfEdge = mHalfEdges[ theHalfEdge ].nextOnEdge; theHalfEdge != kNone;
+		theHalfEdge = mHalfEdges[ theHalfEdge ].nextOnEdge)
+	{
+		if (HalfEdgeFace( theHalfEdge ) != *outFace1)
+		{
+			*outFace2 = HalfEdgeFace( theHalfEdge );
+			break;
+		}
+	}
+}
+
+
+
+
+
+//=============================================================================
+//      Private methods
+//-----------------------------------------------------------------------------
+//      E3MeshTopology::NewContour : Get a free contour.
+//-----------------------------------------------------------------------------
+TQ3Uns32
+E3MeshTopology::NewContour()
+{
+	TQ3Uns32	theContour = mFreeContour;
+	
+	if (theContour == kNone)
+	{
+		theContour = static_cast<TQ3Uns32>( mContours.size() );
+		mContours.push_back( Contour() );
+	}
+	else
+	{
+		mFreeContour = mContours[ theContour ].firstHalfEdge;
+	}
+	return theContour;
+}
+
+
+
+
+
+//=============================================================================
+//      E3MeshTopology::NewHalfEdge : Get a free half-edge.
+//-----------------------------------------------------------------------------
+TQ3Uns32
+E3MeshTopology::NewHalfEdge()
+{
+	TQ3Uns32	theHalfEdge = mFreeHalfEdge;
+	
+	if (theHalfEdge == kNone)
+	{
+		theHalfEdge = static_cast<TQ3Uns32>( mHalfEdges.size() );
+		mHalfEdges.push_back( HalfEdge() );
+	}
+	else
+	{
+		mFreeHalfEdge = mHalfEdges[ theHalfEdge ].next;
+	}
+	return theHalfEdge;
+}
+
+
+
+
+
+//=============================================================================
+//      E3MeshTopology::FindOrAddEdge : Find the edge between two vertices,
+//										or add one.
+//-----------------------------------------------------------------------------
+TQ3Uns32
+E3MeshTopology::FindOrAddEdge( TQ3Uns32 inFrom, TQ3Uns32 inTo )
+{
+	for (TQ3Uns32 theEdge = mVertices[ inFrom ].firstEdge; theEdge != kNone;
+		theEdge = NextEdgeAtVertex( theEdge, inFrom ))
+	{
+		if (OtherVertex( theEdge, inFrom ) == inTo)
+		{
+			return theEdge;
+		}
+	}
+	
+	TQ3Uns32	theEdge = mFreeEdge;
+	if (theEdge == kNone)
+	{
+		// Grow the array ourselves, so that master pointers can follow
+		if (mEdges.size() == mEdges.capacity())
+		{
+			mEdges.reserve( std::max< size_t >( 16, 2 * mEdges.size() ) );
+			
+			for (Edge& movedEdge : mEdges)
+			{
+				if (movedEdge.masterPtr != nullptr)
+				{
+					*movedEdge.masterPtr = &movedEdge;
+				}
+			}
+		}
+		theEdge = static_cast<TQ3Uns32>( mEdges.size() );
+		mEdges.push_back( Edge() );
+	}
+	else
+	{
+		mFreeEdge = mEdges[ theEdge ].firstHalfEdge;
+	}
+	
+	Edge&	newEdge( mEdges[ theEdge ] );
+	newEdge.masterPtr = nullptr;
+	newEdge.vertex[0] = inFrom;
+	newEdge.vertex[1] = inTo;
+	newEdge.firstHalfEdge = kNone;
+	newEdge.nextAtVertex[0] = mVertices[ inFrom ].firstEdge;
+	mVertices[ inFrom ].firstEdge = theEdge;
+	if (inTo != inFrom)
+	{
+		newEdge.nextAtVertex[1] = mVertices[ inTo ].firstEdge;
+		mVertices[ inTo ].firstEdge = theEdge;
+	}
+	else
+	{
+		newEdge.nextAtVertex[1] = kNone;
+	}
+	++mNumEdges;
+	
+	return theEdge;
+}
+
+
+
+
+
+//=============================================================================
+//      E3MeshTopology::RemoveHalfEdge : Remove a half-edge from its vertex
+//										 and edge, and free it.
+//-----------------------------------------------------------------------------
+//		Note :	The contour's loop of half-edges is left alone, since the
+//				whole contour is being removed.
+//-----------------------------------------------------------------------------
+void
+E3MeshTopology::RemoveHalfEdge( TQ3Uns32 inHalfEdge )
+{
+	HalfEdge&	theHalfEdge( mHalfEdges[ inHalfEdge ] );
+	
+	TQ3Uns32*	link = &mVertices[ theHalfEdge.origin ].firstOut;
+	while (*link != inHalfEdge)
+	{
+		link = &mHalfEdges[ *link ].nextOut;
+	}
+	*link = theHalfEdge.nextOut;
+	
+	link = &mEdges[ theHalfEdge.edge ].firstHalfEdge;
+	while (*link != inHalfEdge)
+	{
+		link = &mHalfEdges[ *link ].nextOnEdge;
+	}
+	*link = theHalfEdge.nextOnEdge;
+	
+	if (mEdges[ theHalfEdge.edge ].firstHalfEdge == kNone)
+	{
+		RemoveEdge( theHalfEdge.edge );
+	}
+	
+	theHalfEdge.origin = kNone;
+	theHalfEdge.next = mFreeHalfEdge;
+	mFreeHalfEdge = inHalfEdge;
+}
+
+
+
+
+
+//=============================================================================
+//      E3MeshTopology::RemoveEdge : Remove an edge with no half-edges.
+//-----------------------------------------------------------------------------
+void
+E3MeshTopology::RemoveEdge( TQ3Uns32 inEdge )
+{
+	Edge&	theEdge( mEdges[ inEdge ] );
+	
+	UnlinkEdgeAtVertex( inEdge, theEdge.vertex[0] );
+	if (theEdge.vertex[1] != theEdge.vertex[0])
+	{
+		UnlinkEdgeAtVertex( inEdge, theEdge.vertex[1] );
+	}
+	
+	if (theEdge.masterPtr != nullptr)
+	{
+		*theEdge.masterPtr = nullptr;
+		theEdge.masterPtr = nullptr;
+	}
+	
+	theEdge.vertex[0] = theEdge.vertex[1] = kNone;
+	theEdge.firstHalfEdge = mFreeEdge;
+	mFreeEdge = inEdge;
+	--mNumEdges;
+}
+
+
+
+
+
+//=============================================================================
+//      E3MeshTopology::UnlinkEdgeAtVertex : Remove an edge from the list of
+//											 edges of a vertex.
+//-----------------------------------------------------------------------------
+void
+E3MeshTopology::UnlinkEdgeAtVertex( TQ3Uns32 inEdge, TQ3Uns32 inVertex )
+{
+	TQ3Uns32*	link = &mVertices[ inVertex ].firstEdge;
+	
+	while (*link != inEdge)
+	{
+		Edge&	theEdge( mEdges[ *link ] );
+		link = &theEdge.nextAtVertex[ (theEdge.vertex[0] == inVertex)? 0 : 1 ];
+	}
+	
+	Edge&	theEdge( mEdges[ inEdge ] );
+	*link = theEdge.nextAtVertex[ (theEdge.vertex[0] == inVertex)? 0 : 1 ];
+}
@@ -0,0 +1,280 @@
+/*  NAME:
+        E3GeometryMeshTopology.h
+
+    DESCRIPTION:
+        Header file for E3GeometryMeshTopology.cpp.
+
+    COPYRIGHT:
+        Copyright (c) 2025, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+#ifndef E3GEOMETRYMESHTOPOLOGY_HDR
+#define E3GEOMETRYMESHTOPOLOGY_HDR
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "E3Prefix.h"
+
+#include <vector>
+
+
+
+
+
+//=============================================================================
+//      Class declaration
+//-----------------------------------------------------------------------------
+/*!
+	@class		E3MeshTopology
+
+	@abstract	Index-based half-edge connectivity of a Mesh.
+
+	@discussion	Vertices, faces, contours, half-edges and edges are kept in
+				contiguous arrays and referred to by index.  Removed items
+				go on a free list for each array and are reused, so indices
+				of the remaining items never change.
+
+				Each use of an edge by a contour is a half-edge, which knows
+				its origin vertex, its contour and the next half-edge around
+				the contour.  The half-edges of an edge are linked together,
+				so for a manifold edge the other half-edge is found in one
+				step, but an edge may also have one half-edge (a boundary) or
+				more than two.  Each vertex links its outgoing half-edges and
+				its edges.  So all the adjacency queries of a Mesh take time
+				proportional to the size of a face or the valence of a vertex,
+				not to the size of the Mesh.
+
+				The owners of vertices and faces are opaque pointers for the
+				caller.  An edge may have a master pointer, which is kept
+				pointing at the edge's record as the array of edges grows,
+				and is cleared when the edge goes away.  The first member of
+				an edge record points back at its master pointer.
+
+				Methods which add items throw std::bad_alloc if out of
+				memory.  After that, the topology may be inconsistent, and
+				should be discarded.
+*/
+class E3MeshTopology
+{
+public:
+	static constexpr TQ3Uns32	kNone = 0xFFFFFFFFUL;
+
+	struct Edge
+	{
+		void**			masterPtr;			// must be first
+		TQ3Uns32		vertex[2];
+		TQ3Uns32		nextAtVertex[2];	// only [0] is used by a loop
+		TQ3Uns32		firstHalfEdge;
+	};
+
+							E3MeshTopology();
+							~E3MeshTopology();
+
+	/*!
+		@function	AddVertex
+		@abstract	Add a vertex with no faces.
+		@param		inOwner			Caller's reference to the vertex.
+		@result		Index of the new vertex.
+	*/
+	TQ3Uns32				AddVertex( void* inOwner );
+
+	/*!
+		@function	RemoveVertex
+		@abstract	Remove a vertex, which must no longer be used by a face.
+	*/
+	void					RemoveVertex( TQ3Uns32 inVertex );
+
+	/*!
+		@function	AddFace
+		@abstract	Add a face with no contours.
+		@param		inOwner			Caller's reference to the face.
+		@result		Index of the new face.
+	*/
+	TQ3Uns32				AddFace( void* inOwner );
+
+	/*!
+		@function	AddContour
+		@abstract	Add a contour to the end of a face, finding or making
+					the edges between successive vertices.
+		@param		inFace			Index of a face.
+		@param		inNumVertices	Number of vertices of the contour.
+		@param		inVertices		Indices of the vertices, in order.
+		@result		Index of the new contour.
+	*/
+	TQ3Uns32				AddContour( TQ3Uns32 inFace,
+										TQ3Uns32 inNumVertices,
+										const TQ3Uns32* inVertices );
+
+	/*!
+		@function	RemoveFace
+		@abstract	Remove a face and its contours, and any edges which are
+					no longer used.
+	*/
+	void					RemoveFace( TQ3Uns32 inFace );
+
+	/*!
+		@function	ReleaseEdgeRefs
+		@abstract	Clear the master pointers of all edges, and forget them.
+		@discussion	Call this before discarding a topology whose edges may
+					still be referred to.
+	*/
+	void					ReleaseEdgeRefs();
+
+
+	// Vertices
+	bool					IsVertex( TQ3Uns32 inVertex ) const
+								{ return (inVertex < mVertices.size()) &&
+									(mVertices[ inVertex ].owner != nullptr); }
+	void*					VertexOwner( TQ3Uns32 inVertex ) const
+								{ return mVertices[ inVertex ].owner; }
+	TQ3Uns32				VertexFirstOut( TQ3Uns32 inVertex ) const
+								{ return mVertices[ inVertex ].firstOut; }
+	TQ3Uns32				VertexFirstEdge( TQ3Uns32 inVertex ) const
+								{ return mVertices[ inVertex ].firstEdge; }
+	bool					IsVertexOnBoundary( TQ3Uns32 inVertex ) const;
+
+	// Faces
+	bool					IsFace( TQ3Uns32 inFace ) const
+								{ return (inFace < mFaces.size()) &&
+									(mFaces[ inFace ].owner != nullptr); }
+	void*					FaceOwner( TQ3Uns32 inFace ) const
+								{ return mFaces[ inFace ].owner; }
+	TQ3Uns32				FaceFirstHalfEdge( TQ3Uns32 inFace ) const;
+
+	// Contours
+	bool					IsContour( TQ3Uns32 inContour ) const
+								{ return (inContour < mContours.size()) &&
+									(mContours[ inContour ].face != kNone); }
+	TQ3Uns32				ContourFace( TQ3Uns32 inContour ) const
+								{ return mContours[ inContour ].face; }
+	TQ3Uns32				ContourFirstHalfEdge( TQ3Uns32 inContour ) const
+								{ return mContours[ inContour ].firstHalfEdge; }
+
+	// Half-edges
+	bool					IsHalfEdge( TQ3Uns32 inHalfEdge ) const
+								{ return (inHalfEdge < mHalfEdges.size()) &&
+									(mHalfEdges[ inHalfEdge ].origin != kNone); }
+	TQ3Uns32				HalfEdgeOrigin( TQ3Uns32 inHalfEdge ) const
+								{ return mHalfEdges[ inHalfEdge ].origin; }
+	TQ3Uns32				HalfEdgeEdge( TQ3Uns32 inHalfEdge ) const
+								{ return mHalfEdges[ inHalfEdge ].edge; }
+	TQ3Uns32				HalfEdgeContour( TQ3Uns32 inHalfEdge ) const
+								{ return mHalfEdges[ inHalfEdge ].contour; }
+	TQ3Uns32				HalfEdgeFace( TQ3Uns32 inHalfEdge ) const
+								{ return mContours[ mHalfEdges[ inHalfEdge ].contour ].face; }
+	TQ3Uns32				HalfEdgeNextOut( TQ3Uns32 inHalfEdge ) const
+								{ return mHalfEdges[ inHalfEdge ].nextOut; }
+	TQ3Uns32				HalfEdgeNextOnEdge( TQ3Uns32 inHalfEdge ) const
+								{ return mHalfEdges[ inHalfEdge ].nextOnEdge; }
+	TQ3Uns32				NextHalfEdgeInContour( TQ3Uns32 inHalfEdge ) const;
+	TQ3Uns32				NextHalfEdgeInFace( TQ3Uns32 inHalfEdge ) const;
+	bool					IsFirstHalfEdgeOfEdgeInContour( TQ3Uns32 inHalfEdge ) const;
+	bool					IsFirstHalfEdgeOfEdgeInFace( TQ3Uns32 inHalfEdge ) const;
+
+	// Edges
+	TQ3Uns32				NumEdges() const { return mNumEdges; }
+	TQ3Uns32				EdgeSlots() const { return static_cast<TQ3Uns32>( mEdges.size() ); }
+	bool					IsEdge( TQ3Uns32 inEdge ) const
+								{ return (inEdge < mEdges.size()) &&
+									(mEdges[ inEdge ].vertex[0] != kNone); }
+	Edge&					GetEdge( TQ3Uns32 inEdge ) { return mEdges[ inEdge ]; }
+	const Edge&				GetEdge( TQ3Uns32 inEdge ) const { return mEdges[ inEdge ]; }
+	TQ3Uns32				EdgeIndex( const Edge* inEdge ) const
+								{ return static_cast<TQ3Uns32>( inEdge - mEdges.data() ); }
+	TQ3Uns32				NextEdgeAtVertex( TQ3Uns32 inEdge, TQ3Uns32 inVertex ) const
+								{ const Edge& e( mEdges[ inEdge ] );
+								return e.nextAtVertex[ (e.vertex[0] == inVertex)? 0 : 1 ]; }
+	TQ3Uns32				OtherVertex( TQ3Uns32 inEdge, TQ3Uns32 inVertex ) const
+								{ const Edge& e( mEdges[ inEdge ] );
+								return (e.vertex[0] == inVertex)? e.vertex[1] : e.vertex[0]; }
+	bool					IsEdgeOnBoundary( TQ3Uns32 inEdge ) const
+								{ return mHalfEdges[ mEdges[ inEdge ].firstHalfEdge ].nextOnEdge == kNone; }
+	void					GetEdgeFaces( TQ3Uns32 inEdge, TQ3Uns32* outFace1,
+											TQ3Uns32* outFace2 ) const;
+
+private:
+	struct Vertex
+	{
+		void*			owner;				// nullptr if free
+		TQ3Uns32		firstOut;			// or next free vertex
+		TQ3Uns32		firstEdge;
+	};
+
+	struct Face
+	{
+		void*			owner;				// nullptr if free
+		TQ3Uns32		firstContour;		// or next free face
+		TQ3Uns32		lastContour;
+	};
+
+	struct Contour
+	{
+		TQ3Uns32		face;				// kNone if free
+		TQ3Uns32		firstHalfEdge;		// or next free contour
+		TQ3Uns32		nextInFace;
+	};
+
+	struct HalfEdge
+	{
+		TQ3Uns32		origin;				// kNone if free
+		TQ3Uns32		edge;
+		TQ3Uns32		contour;
+		TQ3Uns32		next;				// or next free half-edge
+		TQ3Uns32		nextOut;
+		TQ3Uns32		nextOnEdge;
+	};
+
+	TQ3Uns32				NewContour();
+	TQ3Uns32				NewHalfEdge();
+	TQ3Uns32				FindOrAddEdge( TQ3Uns32 inFrom, TQ3Uns32 inTo );
+	void					RemoveHalfEdge( TQ3Uns32 inHalfEdge );
+	void					RemoveEdge( TQ3Uns32 inEdge );
+	void					UnlinkEdgeAtVertex( TQ3Uns32 inEdge, TQ3Uns32 inVertex );
+
+	std::vector< Vertex >	mVertices;
+	std::vector< Face >		mFaces;
+	std::vector< Contour >	mContours;
+	std::vector< HalfEdge >	mHalfEdges;
+	std::vector< Edge >		mEdges;
+
+	TQ3Uns32				mFreeVertex;
+	TQ3Uns32				mFreeFace;
+	TQ3Uns32				mFreeContour;
+	TQ3Uns32				mFreeHalfEdge;
+	TQ3Uns32				mFreeEdge;
+	TQ3Uns32				mNumEdges;
+};
+
+#endif
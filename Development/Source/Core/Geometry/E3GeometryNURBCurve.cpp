@@ -47,6 +47,7 @@
 #include "E3View.h"
 #include "E3Geometry.h"
 #include "E3GeometryNURBCurve.h"
+#include "E3GeometryNURBSBasis.h"
 
 
 
@@ -209,79 +210,25 @@ e3geom_nurbcurve_duplicate(TQ3Object fromObject, const void *fromPrivateData,
 
 
 
-//=============================================================================
-//      e3geom_nurbcurve_evaluate_N_i_k : Evaluate N_i_k.
-//-----------------------------------------------------------------------------
-//		Note :	As described in QD3D Programming book "NURB Curves and Patches"
-//				This is very slow and used as a reference implementation only.
-//-----------------------------------------------------------------------------
-static float
-e3geom_nurbcurve_evaluate_N_i_k(
-			float 			u,
-			TQ3Uns32		i,
-			TQ3Uns32		k,
-			TQ3Uns32		inOrder,
-			TQ3Uns32		inNumPoints,
-			float			inKnots[])
-{
-	if (k == 1)
-	{
-		if ((inKnots[i] <= u) && (u <= inKnots[i+1]))
-			return 1.0f;
-		else
-			return 0.0f;
-	}
-	
-	{
-		float div;
-		float sum = 0.0f;
-		
-		div = inKnots[i+k-1]-inKnots[i];
-		if (div != 0.0f)
-			sum += ((u-inKnots[i])*e3geom_nurbcurve_evaluate_N_i_k(u,i,k-1,inOrder,inNumPoints,inKnots))/div;
-
-		
-		div = inKnots[i+k]-inKnots[i+1];
-		if (div != 0.0f)
-			sum += ((inKnots[i+k]-u)*e3geom_nurbcurve_evaluate_N_i_k(u,i+1,k-1,inOrder,inNumPoints,inKnots))/div;
-			
-		return sum;
-	}
-}
-
-
-
-
-
 //=============================================================================
 //      e3geom_nurbcurve_evaluate_nurbs_curve : Evaluate the curve.
 //-----------------------------------------------------------------------------
-//		Note :	Brute force evaluation of the NURB curve as found in the QD3D
-//				programming book.
+//		Note :	Only the inOrder control points whose basis functions are
+//				nonzero at inU are combined.
 //-----------------------------------------------------------------------------
 static void 
 e3geom_nurbcurve_evaluate_nurbs_curve(
 			float				inU,
 			TQ3Uns32			inOrder,
 			TQ3Uns32			inNumPoints,
-			float				inKnots[],
-			TQ3RationalPoint4D	inControlPoints[],
+			const float			inKnots[],
+			const TQ3RationalPoint4D	inControlPoints[],
 			TQ3RationalPoint4D	*outPoint)
 {
-	TQ3Uns32 i;
-	outPoint->x = 0.0f;
-	outPoint->y = 0.0f;
-	outPoint->z = 0.0f;
-	outPoint->w = 0.0f;
-	
-	for (i = 0; i < inNumPoints; i++)
-	{
-		float coeff = e3geom_nurbcurve_evaluate_N_i_k(inU,i,inOrder,inOrder,inNumPoints,inKnots);
-		outPoint->x += coeff*inControlPoints[i].x;
-		outPoint->y += coeff*inControlPoints[i].y;
-		outPoint->z += coeff*inControlPoints[i].z;
-		outPoint->w += coeff*inControlPoints[i].w;
-	}
+	TE3NURBSBasis	theBasis;
+
+	E3NURBS_EvaluateBasis(inU, inOrder, inNumPoints, inKnots, kQ3False, &theBasis);
+	E3NURBS_CombinePoints(&theBasis, inControlPoints, 1, outPoint, nullptr);
 }
 
 
@@ -756,6 +703,12 @@ e3geom_nurbcurve_cache_new(TQ3ViewObject theView, TQ3GeometryObject theGeom,
 
 
 
+	// The basis evaluation has room for orders up to the maximum
+	if (geomData->order > kQ3NURBCurveMaxOrder)
+		return(nullptr);
+
+
+
 	// Get the subdivision style, and calculate our vertices
 	theStatus = Q3View_GetSubdivisionStyleState(theView, &subdivisionData) ;
 	if( theStatus == kQ3Success )
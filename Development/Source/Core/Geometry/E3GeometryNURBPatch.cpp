@@ -48,6 +48,13 @@
 #include "E3Geometry.h"
 #include "E3GeometryTriMesh.h"
 #include "E3GeometryNURBPatch.h"
+#include "E3GeometryNURBSBasis.h"
+#include "E3Parallel.h"
+
+#include <cstdint>
+#include <new>
+#include <unordered_map>
+#include <vector>
 
 
 
@@ -56,7 +63,16 @@
 //=============================================================================
 //      Internal constants
 //-----------------------------------------------------------------------------
-#define		kFiniteSubdivision		32
+// Adaptive subdivision splits each knot cell on a lattice of 2^kAdaptiveMaxLevel
+// steps per side, the same limit as constant subdivision has
+#define		kAdaptiveMaxLevel			8
+#define		kAdaptiveCellSteps			(1U << kAdaptiveMaxLevel)
+
+// Cosine of the largest turn of the normal across a quad that looks flat
+#define		kAdaptiveCosMaxTurn			0.866f
+
+// Knot cells worth a thread of their own
+#define		kAdaptiveMinCellsPerTask	4
 
 
 
@@ -77,6 +93,73 @@ public :
 	TQ3NURBPatchData			instanceData ;
 
 	} ;
+
+
+
+// A sample of the patch for adaptive subdivision.  The key packs its
+// lattice position, with u in the high 32 bits and v in the low 32 bits.
+struct TE3NURBPatchSample
+	{
+	std::uint64_t				key ;
+	TQ3Point3D					thePoint ;
+	TQ3Vector3D					theNormal ;
+	TQ3Param2D					theUV ;
+	TQ3Point3D					measurePoint ;	// world or window coordinates
+	bool						isVertex ;
+	} ;
+
+typedef std::unordered_map< std::uint64_t, TQ3Uns32 >	E3NURBPatchSampleMap ;
+
+
+// A leaf quad of adaptive subdivision, by its lower lattice corner and size.
+// The corner samples are in the order (u,v), (u+size,v), (u,v+size) and
+// (u+size,v+size), and the centre is kQ3ArrayIndexNULL if it was not sampled.
+struct TE3NURBPatchQuad
+	{
+	TQ3Uns32					u, v, size ;
+	TQ3Uns32					corners[4] ;
+	TQ3Uns32					centre ;
+	} ;
+
+
+// What adaptive subdivision produces for one knot cell.  Quads refer to
+// the cell's own samples until the cells are merged, and to the merged
+// samples after that.
+struct TE3NURBPatchCellResult
+	{
+	std::vector< TE3NURBPatchSample >		samples ;
+	std::vector< TE3NURBPatchQuad >			quads ;
+	std::vector< TQ3Uns32 >					toMerged ;
+	std::vector< TQ3TriMeshTriangleData >	triangles ;
+	std::vector< TQ3Uns32 >					centres ;
+	bool									didFail = false ;
+	} ;
+
+
+// The lattice of the knot cell being worked on, with the index of the
+// sample at each lattice point, or kQ3ArrayIndexNULL, and the bases of the
+// lattice lines that have been evaluated
+struct TE3NURBPatchCellGrid
+	{
+	TQ3Uns32						u0, v0 ;
+	std::vector< TQ3Uns32 >			index ;
+	std::vector< TE3NURBSBasis >	uBases, vBases ;
+	std::vector< bool >				haveUBasis, haveVBasis ;
+	} ;
+
+
+// What adaptive subdivision of a patch shares between its knot cells
+struct TE3NURBPatchAdaptive
+	{
+	const TQ3NURBPatchData*		patch ;
+	const float*				interestingU ;
+	const float*				interestingV ;
+	TQ3Uns32					numCellsU ;
+	TQ3Uns32					numCellsV ;
+	TQ3Matrix4x4				localToMeasure ;
+	TQ3Boolean					isScreenSpace ;
+	float						toleranceSquared ;
+	} ;
 	
 
 
@@ -282,149 +365,23 @@ e3geom_nurbpatch_duplicate(TQ3Object fromObject, const void *fromPrivateData,
 
 
 //=============================================================================
-//      e3geom_nurbpatch_evaluate_basis : Evaluate the basis.
-//-----------------------------------------------------------------------------
-//		Note :	This is the recursive definition, as in the Schneider article.
-//				fracR = 1 - fracL.  That's why non-recursive versions are so
-//				fast, they take one-minus over and over again.
-//-----------------------------------------------------------------------------
-static float
-e3geom_nurbpatch_evaluate_basis( float u, TQ3Uns32 i, TQ3Uns32 k, float *knots )
-{	float bottomL, bottomR, fracL, fracR, theResult;
-
-
-	if ( k == 1 ) {
-		if ( u >= knots[i] && u <= knots[i+1] )
-			theResult = 1.0f ;
-		else
-			theResult = 0.0f ;
-	}
-	
-	else {
-		bottomL = ( knots[i+k-1] - knots[i] ) ;
-		fracL =
-			( bottomL <= kQ3RealZero ) ? 0.0f : // floating point inaccuracies
-			( u - knots[i] ) / bottomL ;
-		bottomR = ( knots[i+k] - knots[i+1] ) ;
-		fracR =
-			( bottomR <= kQ3RealZero ) ? 0.0f : // fp inaccuracies
-			( knots[i+k] - u ) / bottomR ;
-			
-		// stops recursing if we already know the result will be 0
-		if ( fracL > kQ3RealZero ) // fp inaccuracies
-			fracL *= e3geom_nurbpatch_evaluate_basis(u,i,k-1,knots) ;
-		else fracL = 0.0f ;
-			
-		if ( fracR > kQ3RealZero ) // fp inaccuracies
-			fracR *= e3geom_nurbpatch_evaluate_basis(u,i+1,k-1,knots) ;
-		else fracR = 0.0f ;
-		
-		theResult = fracL + fracR ;
-	}
-	
-	return theResult;
-}
-
-
-
-
-
-//=============================================================================
-//      e3geom_nurbpatch_evaluate_basis_deriv : Evaluate the basis derivative.
-//-----------------------------------------------------------------------------
-//		Note : Also lifted from the B,B,&B book.
-//-----------------------------------------------------------------------------
-static float
-e3geom_nurbpatch_evaluate_basis_deriv( float u, TQ3Uns32 i, TQ3Uns32 k, float *knots )
-{
-	
-	//float theResult ;
-	float bottomL, bottomR, fracL, fracR ;
-	
-	bottomL = ( knots[i+k-1] - knots[i] ) ;
-	fracL =
-		( bottomL <= kQ3RealZero ) ? 0.0f : // floating point inaccuracies
-		1.0f / bottomL ;
-	bottomR = ( knots[i+k] - knots[i+1] ) ;
-	fracR =
-		( bottomR <= kQ3RealZero ) ? 0.0f : // fp inaccuracies
-		1.0f / bottomR ;
-		
-	// stops recursing if we already know the result will be 0
-	if ( fracL > kQ3RealZero )	// fp inaccuracies
-		fracL *= e3geom_nurbpatch_evaluate_basis(u,i,k-1,knots) ;
-	else fracL = 0.0f ;
-		
-	if ( fracR > kQ3RealZero ) // fp inaccuracies
-		fracR *= e3geom_nurbpatch_evaluate_basis(u,i+1,k-1,knots) ;
-	else fracR = 0.0f ;
-	
-	return (k-1)*(fracL - fracR) ;
-}
-
-
-
-
-
-//=============================================================================
-//      e3geom_nurbpatch_evaluate_uv : Evaluate the NURB patch data, computing
-//									   the normal.
+//      e3geom_nurbpatch_rational_point_normal : Divide out the weights of a
+//												 point and its derivatives.
 //-----------------------------------------------------------------------------
-//		Note :	Returns the coordinates into outPoint and the normal into
-//				outNormal.
+//		Note :	theSum is the weighted sum of the control points, and theDu
+//				and theDv its derivatives in u and v.  Returns the coordinates
+//				into outPoint and the unit normal into outNormal.
 //-----------------------------------------------------------------------------
 static void
-e3geom_nurbpatch_evaluate_uv( float u, float v, const TQ3NURBPatchData * patchData, TQ3Vector3D * outNormal, TQ3Point3D * outPoint,
-	float* uBasisValues, float* vBasisValues, float* uBasisDerivValues, float* vBasisDerivValues )
+e3geom_nurbpatch_rational_point_normal( const TQ3RationalPoint4D* theSum, const TQ3RationalPoint4D* theDu,
+										const TQ3RationalPoint4D* theDv,
+										TQ3Point3D * outPoint, TQ3Vector3D * outNormal )
 {
 	
-	TQ3Uns32		iU, jV ;
-	float			xTop, yTop, zTop, xTopDu, yTopDu, zTopDu, xTopDv, yTopDv, zTopDv ;
-	float			OneOverBottom, bottom, bottom_squared, bottomDu, bottomDv ;
+	float			OneOverBottom, bottom, bottom_squared ;
 	TQ3Vector3D		dU, dV ;
 	
-	// Let's...
-	xTop = yTop = zTop = bottom = xTopDu = xTopDv = yTopDu = yTopDv = zTopDu = zTopDv = bottomDu = bottomDv = 0.0f ;
-	// Go
-	for ( iU = 0; iU < patchData->numColumns; iU++ ) {
-		uBasisValues[iU] = e3geom_nurbpatch_evaluate_basis( u, iU, patchData->uOrder, patchData->uKnots) ;
-		uBasisDerivValues[iU] = e3geom_nurbpatch_evaluate_basis_deriv( u, iU, patchData->uOrder, patchData->uKnots) ;
-	}
-
-	// Again
-	for ( jV = 0; jV < patchData->numRows; jV++ ) {
-		vBasisValues[jV] = e3geom_nurbpatch_evaluate_basis( v, jV, patchData->vOrder, patchData->vKnots) ;
-		vBasisDerivValues[jV] = e3geom_nurbpatch_evaluate_basis_deriv( v, jV, patchData->vOrder, patchData->vKnots) ;
-	}
-
-	// Now some summation rotation recreation, like p. 46-47 in Bartels, Beatty, & Barsky
-	for ( jV = 0; jV < patchData->numRows; jV++ ) {
-		for ( iU = 0; iU < patchData->numColumns; iU++ ) {
-			// First the point
-			xTop += patchData->controlPoints[patchData->numColumns*jV + iU].x * uBasisValues[iU] * vBasisValues[jV] ;
-			yTop += patchData->controlPoints[patchData->numColumns*jV + iU].y * uBasisValues[iU] * vBasisValues[jV] ;
-			zTop += patchData->controlPoints[patchData->numColumns*jV + iU].z * uBasisValues[iU] * vBasisValues[jV] ;
-			bottom += patchData->controlPoints[patchData->numColumns*jV + iU].w * uBasisValues[iU] * vBasisValues[jV] ;
-			/* Now let's take care of the derivatives */
-			/*
-			 * To do the derivative, we must use the chain rule:
-			 * ((low * Dhigh) - (high * Dlow)) / low^2.
-			 *
-			 * So for this upcoming loop, we are building the Du of the individual Top's and the bottom, as well as the Dv of the Top's
-			 * and bottom.
-			 * Then later I will put it together with that chain rule to get my answer.
-			 */
-			// So first Du
-			xTopDu += patchData->controlPoints[patchData->numColumns*jV + iU].x * uBasisDerivValues[iU] * vBasisValues[jV] ;
-			yTopDu += patchData->controlPoints[patchData->numColumns*jV + iU].y * uBasisDerivValues[iU] * vBasisValues[jV] ;
-			zTopDu += patchData->controlPoints[patchData->numColumns*jV + iU].z * uBasisDerivValues[iU] * vBasisValues[jV] ;
-			bottomDu += patchData->controlPoints[patchData->numColumns*jV + iU].w * uBasisDerivValues[iU] * vBasisValues[jV] ;
-			// And next Dv
-			xTopDv += patchData->controlPoints[patchData->numColumns*jV + iU].x * uBasisValues[iU] * vBasisDerivValues[jV] ;
-			yTopDv += patchData->controlPoints[patchData->numColumns*jV + iU].y * uBasisValues[iU] * vBasisDerivValues[jV] ;
-			zTopDv += patchData->controlPoints[patchData->numColumns*jV + iU].z * uBasisValues[iU] * vBasisDerivValues[jV] ;
-			bottomDv += patchData->controlPoints[patchData->numColumns*jV + iU].w * uBasisValues[iU] * vBasisDerivValues[jV] ;
-	}	}
+	bottom = theSum->w ;
 	
 	
 	// Calculate bottom squared
@@ -434,27 +391,31 @@ e3geom_nurbpatch_evaluate_uv( float u, float v, const TQ3NURBPatchData * patchDa
 
 	// The point
 	OneOverBottom = 1.0f / bottom ;
-	outPoint->x = xTop * OneOverBottom ;
-	outPoint->y = yTop * OneOverBottom ;
-	outPoint->z = zTop * OneOverBottom ;
+	outPoint->x = theSum->x * OneOverBottom ;
+	outPoint->y = theSum->y * OneOverBottom ;
+	outPoint->z = theSum->z * OneOverBottom ;
 	
 	/* The Du vector */
+	/*
+	 * To do the derivative, we must use the quotient rule:
+	 * ((low * Dhigh) - (high * Dlow)) / low^2.
+	 */
 	// low^2 = bottom^2
 	OneOverBottom = 1.0f / bottom_squared ;
 	// ((low * Dhigh) - (high * Dlow)) / bottom^2
-	dU.x = ((bottom * xTopDu) - (xTop * bottomDu))*OneOverBottom ;
-	dU.y = ((bottom * yTopDu) - (yTop * bottomDu))*OneOverBottom ;
-	dU.z = ((bottom * zTopDu) - (zTop * bottomDu))*OneOverBottom ;
+	dU.x = ((bottom * theDu->x) - (theSum->x * theDu->w))*OneOverBottom ;
+	dU.y = ((bottom * theDu->y) - (theSum->y * theDu->w))*OneOverBottom ;
+	dU.z = ((bottom * theDu->z) - (theSum->z * theDu->w))*OneOverBottom ;
 	
 	/* The Dv vector */
 	// low^2 = bottom^2
 	// OneOverBottom = same as above
 	// ((low * Dhigh) - (high * Dlow)) / bottom^2
-	dV.x = ((bottom * xTopDv) - (xTop * bottomDv))*OneOverBottom ;
-	dV.y = ((bottom * yTopDv) - (yTop * bottomDv))*OneOverBottom ;
-	dV.z = ((bottom * zTopDv) - (zTop * bottomDv))*OneOverBottom ;
+	dV.x = ((bottom * theDv->x) - (theSum->x * theDv->w))*OneOverBottom ;
+	dV.y = ((bottom * theDv->y) - (theSum->y * theDv->w))*OneOverBottom ;
+	dV.z = ((bottom * theDv->z) - (theSum->z * theDv->w))*OneOverBottom ;
 	
-	Q3Vector3D_Cross(&dU, &dV, outNormal);
+	Q3FastVector3D_Cross(&dU, &dV, outNormal);
 	
 	// Normalize the normal vector
 	if (Q3FastVector3D_LengthSquared(outNormal) < kQ3RealZero)
@@ -477,45 +438,40 @@ e3geom_nurbpatch_evaluate_uv( float u, float v, const TQ3NURBPatchData * patchDa
 //      e3geom_nurbpatch_evaluate_uv_no_deriv : Evaluate the NURB patch data
 //												without computing the normal.
 //-----------------------------------------------------------------------------
-//		Note :	Returns the coordinates into outPoint
+//		Note :	Returns the coordinates into outPoint.  Only the order by order
+//				control points whose basis functions are nonzero at (u, v)
+//				are visited.
 //-----------------------------------------------------------------------------
 static void
-e3geom_nurbpatch_evaluate_uv_no_deriv( float u, float v, const TQ3NURBPatchData * patchData, TQ3Point3D * outPoint,
-	float* uBasisValues, float* vBasisValues )
+e3geom_nurbpatch_evaluate_uv_no_deriv( float u, float v, const TQ3NURBPatchData * patchData, TQ3Point3D * outPoint )
 {
 	
-	TQ3Uns32		iU, jV ;
-	float			xTop, yTop, zTop ;
-	float			OneOverBottom, bottom ;
-	
-	// Let's...
-	xTop = yTop = zTop = bottom = 0.0f ;
-	// Go
-	for ( iU = 0; iU < patchData->numColumns; iU++ ) {
-		uBasisValues[iU] = e3geom_nurbpatch_evaluate_basis( u, iU, patchData->uOrder, patchData->uKnots) ;
+	TE3NURBSBasis		uBasis, vBasis ;
+	TQ3RationalPoint4D	rowSum, theSum ;
+	TQ3Uns32			jV ;
+	float				OneOverBottom ;
+	
+	E3NURBS_EvaluateBasis( u, patchData->uOrder, patchData->numColumns, patchData->uKnots, kQ3False, &uBasis ) ;
+	E3NURBS_EvaluateBasis( v, patchData->vOrder, patchData->numRows, patchData->vKnots, kQ3False, &vBasis ) ;
+	
+	// Sum each row in u, then the rows in v
+	theSum.x = theSum.y = theSum.z = theSum.w = 0.0f ;
+	for ( jV = 0; jV < vBasis.count; jV++ ) {
+		E3NURBS_CombinePoints( &uBasis,
+							   &patchData->controlPoints[patchData->numColumns*(vBasis.first + jV)], 1,
+							   &rowSum, nullptr ) ;
+		theSum.x += rowSum.x * vBasis.values[jV] ;
+		theSum.y += rowSum.y * vBasis.values[jV] ;
+		theSum.z += rowSum.z * vBasis.values[jV] ;
+		theSum.w += rowSum.w * vBasis.values[jV] ;
 	}
-
-	// Again
-	for ( jV = 0; jV < patchData->numRows; jV++ ) {
-		vBasisValues[jV] = e3geom_nurbpatch_evaluate_basis( v, jV, patchData->vOrder, patchData->vKnots) ;
-	}
-
-	// Now some summation rotation recreation, like p. 46-47 in Bartels, Beatty, & Barsky
-	for ( jV = 0; jV < patchData->numRows; jV++ ) {
-		for ( iU = 0; iU < patchData->numColumns; iU++ ) {
-			// First the point
-			xTop += patchData->controlPoints[patchData->numColumns*jV + iU].x * uBasisValues[iU] * vBasisValues[jV] ;
-			yTop += patchData->controlPoints[patchData->numColumns*jV + iU].y * uBasisValues[iU] * vBasisValues[jV] ;
-			zTop += patchData->controlPoints[patchData->numColumns*jV + iU].z * uBasisValues[iU] * vBasisValues[jV] ;
-			bottom += patchData->controlPoints[patchData->numColumns*jV + iU].w * uBasisValues[iU] * vBasisValues[jV] ;
-	}	}
 	
 	
 	// The point
-	OneOverBottom = 1.0f / bottom ;
-	outPoint->x = xTop * OneOverBottom ;
-	outPoint->y = yTop * OneOverBottom ;
-	outPoint->z = zTop * OneOverBottom ;
+	OneOverBottom = 1.0f / theSum.w ;
+	outPoint->x = theSum.x * OneOverBottom ;
+	outPoint->y = theSum.y * OneOverBottom ;
+	outPoint->z = theSum.z * OneOverBottom ;
 }
 
 
@@ -555,113 +511,283 @@ e3geom_nurbpatch_interesting_knots( float * inKnots, TQ3Uns32 numPoints, TQ3Uns3
 
 
 //=============================================================================
-//      e3geom_nurbpatch_recursive_quad_world_subdivide : Recursively subdivide
-//														  a patch into 4
-//														  parametrically square
-//														  sections.
+//      e3geom_nurbpatch_measure_point : Transform a point to where the
+//										 subdivision tolerance is measured.
+//-----------------------------------------------------------------------------
+//		Note :	Like E3Point3D_Transform, but without posting an error for a
+//				point at infinity, since this runs on worker threads.  In
+//				screen space the depth is dropped, so that distances are
+//				measured in the plane of the window.
+//-----------------------------------------------------------------------------
+static void
+e3geom_nurbpatch_measure_point( const TE3NURBPatchAdaptive* info, const TQ3Point3D* inPoint, TQ3Point3D* outPoint )
+{
+	const float			x = inPoint->x, y = inPoint->y, z = inPoint->z ;
+	float				w ;
+	
+	#define M(x,y) info->localToMeasure.value[x][y]
+	outPoint->x = x*M(0,0) + y*M(1,0) + z*M(2,0) + M(3,0) ;
+	outPoint->y = x*M(0,1) + y*M(1,1) + z*M(2,1) + M(3,1) ;
+	outPoint->z = x*M(0,2) + y*M(1,2) + z*M(2,2) + M(3,2) ;
+	w           = x*M(0,3) + y*M(1,3) + z*M(2,3) + M(3,3) ;
+	#undef M
+	
+	if (w != 0.0f && w != 1.0f) {
+		w = 1.0f / w ;
+		outPoint->x *= w ;
+		outPoint->y *= w ;
+		outPoint->z *= w ;
+	}
+	
+	if (info->isScreenSpace)
+		outPoint->z = 0.0f ;
+}
+
+
+
+
+
+//=============================================================================
+//      e3geom_nurbpatch_lattice_param : Parameter value of a lattice line.
+//-----------------------------------------------------------------------------
+//		Note :	The lattice has kAdaptiveCellSteps lines per knot cell, so
+//				the knots themselves fall exactly on lattice lines.
+//-----------------------------------------------------------------------------
+static float
+e3geom_nurbpatch_lattice_param( TQ3Uns32 inLine, const float* interestingK )
+{
+	TQ3Uns32		theCell = inLine >> kAdaptiveMaxLevel ;
+	TQ3Uns32		theStep = inLine & (kAdaptiveCellSteps - 1) ;
+	
+	if (theStep == 0)
+		return interestingK[theCell] ;
+	
+	return interestingK[theCell] + (interestingK[theCell+1] - interestingK[theCell])
+								   * ((float) theStep / (float) kAdaptiveCellSteps) ;
+}
+
+
+
+
+
+//=============================================================================
+//      e3geom_nurbpatch_grid_slot : Entry of a cell's lattice.
+//-----------------------------------------------------------------------------
+static TQ3Uns32&
+e3geom_nurbpatch_grid_slot( TE3NURBPatchCellGrid& ioGrid, TQ3Uns32 u, TQ3Uns32 v )
+{
+	return ioGrid.index[ (v - ioGrid.v0) * (kAdaptiveCellSteps + 1) + (u - ioGrid.u0) ] ;
+}
+
+
+
+
+
+//=============================================================================
+//      e3geom_nurbpatch_on_cell_edge : Is a lattice point on the edge of a
+//										knot cell?
+//-----------------------------------------------------------------------------
+//		Note :	Only these points can be sampled by more than one cell.
+//-----------------------------------------------------------------------------
+static bool
+e3geom_nurbpatch_on_cell_edge( std::uint64_t inKey )
+{
+	return ((inKey >> 32) & (kAdaptiveCellSteps - 1)) == 0 || (inKey & (kAdaptiveCellSteps - 1)) == 0 ;
+}
+
+
+
+
+
+//=============================================================================
+//      e3geom_nurbpatch_adaptive_sample : Find or evaluate a lattice sample.
 //-----------------------------------------------------------------------------
-//		Note : Returns the maximum depth of recursion.
+//		Note :	Returns the index of the sample in ioSamples.  A sample is
+//				only ever evaluated from its lattice coordinates, so two
+//				knot cells that both evaluate a point on their shared edge
+//				get exactly the same result.
 //-----------------------------------------------------------------------------
 static TQ3Uns32
-e3geom_nurbpatch_recursive_quad_world_subdivide( TQ3Uns32 depth, float subdiv, float fu, float lu, float fv, float lv,
-												  const TQ3Point3D* Pfufv, const TQ3Point3D* Plufv, const TQ3Point3D* Pfulv, const TQ3Point3D* Plulv,
-								  				  const TQ3NURBPatchData *geomData, const TQ3Matrix4x4* localToWorld,
-								  				  float* uBasisValues, float* vBasisValues )
+e3geom_nurbpatch_adaptive_sample( const TE3NURBPatchAdaptive* info, TQ3Uns32 u, TQ3Uns32 v,
+								  TE3NURBPatchCellGrid& ioGrid, std::vector< TE3NURBPatchSample >& ioSamples )
+{
+	const TQ3NURBPatchData*	patchData = info->patch ;
+	TQ3Uns32&				theSlot = e3geom_nurbpatch_grid_slot( ioGrid, u, v ) ;
+	TQ3RationalPoint4D		rowSum, rowDu, theSum, theDu, theDv ;
+	TE3NURBPatchSample		theSample ;
+	TQ3Uns32				jV ;
+	
+	if (theSlot != kQ3ArrayIndexNULL)
+		return theSlot ;
+	
+	theSample.key     = (((std::uint64_t) u) << 32) | v ;
+	theSample.theUV.u = e3geom_nurbpatch_lattice_param( u, info->interestingU ) ;
+	theSample.theUV.v = e3geom_nurbpatch_lattice_param( v, info->interestingV ) ;
+	
+	// Samples of a cell share lattice lines, so keep their bases
+	if (!ioGrid.haveUBasis[u - ioGrid.u0]) {
+		E3NURBS_EvaluateBasis( theSample.theUV.u, patchData->uOrder, patchData->numColumns, patchData->uKnots,
+							   kQ3True, &ioGrid.uBases[u - ioGrid.u0] ) ;
+		ioGrid.haveUBasis[u - ioGrid.u0] = true ;
+	}
+	if (!ioGrid.haveVBasis[v - ioGrid.v0]) {
+		E3NURBS_EvaluateBasis( theSample.theUV.v, patchData->vOrder, patchData->numRows, patchData->vKnots,
+							   kQ3True, &ioGrid.vBases[v - ioGrid.v0] ) ;
+		ioGrid.haveVBasis[v - ioGrid.v0] = true ;
+	}
+	const TE3NURBSBasis&	uBasis = ioGrid.uBases[u - ioGrid.u0] ;
+	const TE3NURBSBasis&	vBasis = ioGrid.vBases[v - ioGrid.v0] ;
+	
+	// Sum each row in u, then the rows in v
+	theSum.x = theSum.y = theSum.z = theSum.w = 0.0f ;
+	theDu = theDv = theSum ;
+	for ( jV = 0; jV < vBasis.count; jV++ ) {
+		E3NURBS_CombinePoints( &uBasis,
+							   &patchData->controlPoints[patchData->numColumns*(vBasis.first + jV)], 1,
+							   &rowSum, &rowDu ) ;
+		theSum.x += rowSum.x * vBasis.values[jV] ;
+		theSum.y += rowSum.y * vBasis.values[jV] ;
+		theSum.z += rowSum.z * vBasis.values[jV] ;
+		theSum.w += rowSum.w * vBasis.values[jV] ;
+		theDu.x  += rowDu.x  * vBasis.values[jV] ;
+		theDu.y  += rowDu.y  * vBasis.values[jV] ;
+		theDu.z  += rowDu.z  * vBasis.values[jV] ;
+		theDu.w  += rowDu.w  * vBasis.values[jV] ;
+		theDv.x  += rowSum.x * vBasis.derivs[jV] ;
+		theDv.y  += rowSum.y * vBasis.derivs[jV] ;
+		theDv.z  += rowSum.z * vBasis.derivs[jV] ;
+		theDv.w  += rowSum.w * vBasis.derivs[jV] ;
+	}
+	
+	e3geom_nurbpatch_rational_point_normal( &theSum, &theDu, &theDv, &theSample.thePoint, &theSample.theNormal ) ;
+	e3geom_nurbpatch_measure_point( info, &theSample.thePoint, &theSample.measurePoint ) ;
+	theSample.isVertex = false ;
+	
+	ioSamples.push_back( theSample ) ;
+	theSlot = (TQ3Uns32) (ioSamples.size() - 1) ;
+	
+	return theSlot ;
+}
+
+
+
+
+
+//=============================================================================
+//      e3geom_nurbpatch_adaptive_deviation : Squared distance from a sample
+//											  to the chord between two others.
+//-----------------------------------------------------------------------------
+//		Note :	The distance is measured to the line through the chord, so
+//				that a flat patch with uneven parameter spacing counts as
+//				flat.
+//-----------------------------------------------------------------------------
+static float
+e3geom_nurbpatch_adaptive_deviation( const std::vector< TE3NURBPatchSample >& inSamples, TQ3Uns32 inSample,
+									 TQ3Uns32 inEndA, TQ3Uns32 inEndB )
 {
-	float hu, hv ;
-	TQ3Point3D Phufv, Pfuhv, Phuhv, Pluhv, Phulv ;
+	const TQ3Point3D*	thePoint = &inSamples[inSample].measurePoint ;
+	const TQ3Point3D*	endA     = &inSamples[inEndA].measurePoint ;
+	const TQ3Point3D*	endB     = &inSamples[inEndB].measurePoint ;
+	TQ3Vector3D			theChord, toPoint, theCross ;
+	float				chordSquared ;
+	
+	Q3FastPoint3D_Subtract( endB, endA, &theChord ) ;
+	Q3FastPoint3D_Subtract( thePoint, endA, &toPoint ) ;
 	
-	TQ3Uns32 recurseDepth, maxRecurseDepth ;
+	chordSquared = Q3FastVector3D_LengthSquared( &theChord ) ;
+	if (chordSquared < kQ3RealZero)
+		return Q3FastVector3D_LengthSquared( &toPoint ) ;
 	
-	depth++ ;
-	maxRecurseDepth = 0 ;
+	Q3FastVector3D_Cross( &theChord, &toPoint, &theCross ) ;
+	return Q3FastVector3D_LengthSquared( &theCross ) / chordSquared ;
+}
+
+
+
+
+
+//=============================================================================
+//      e3geom_nurbpatch_adaptive_refine : Split a quad of a knot cell until
+//										   it is flat enough.
+//-----------------------------------------------------------------------------
+//		Note :	The quad has its lower corner at lattice point (u, v), sides
+//				of inSize lattice steps, and the samples of its corners in
+//				the order (u,v), (u+size,v), (u,v+size), (u+size,v+size).
+//				The leaves are added to ioResult.
+//-----------------------------------------------------------------------------
+static void
+e3geom_nurbpatch_adaptive_refine( const TE3NURBPatchAdaptive* info, TQ3Uns32 u, TQ3Uns32 v, TQ3Uns32 inSize,
+								  const TQ3Uns32* inCorners,
+								  TE3NURBPatchCellGrid& ioGrid, TE3NURBPatchCellResult& ioResult )
+{
+	std::vector< TE3NURBPatchSample >&	theSamples = ioResult.samples ;
+	TE3NURBPatchQuad					theQuad = { u, v, inSize,
+													{ inCorners[0], inCorners[1], inCorners[2], inCorners[3] },
+													kQ3ArrayIndexNULL } ;
+	TQ3Uns32							h, mid[5], child[4], n ;
+	float								minTurn, maxSide ;
+	bool								isFlat ;
+	
+	if (inSize == 1) {
+		ioResult.quads.push_back( theQuad ) ;
+		return ;
+	}
 	
-	#define a Q3Point3D_DistanceSquared( Pfufv, Plufv )
-	#define b Q3Point3D_DistanceSquared( Plufv, Plulv )
-	#define c Q3Point3D_DistanceSquared( Pfulv, Plulv )
-	#define d Q3Point3D_DistanceSquared( Pfufv, Pfulv )
+	// Sample the midpoints of the edges and the centre
+	h = inSize / 2 ;
+	mid[0] = e3geom_nurbpatch_adaptive_sample( info, u + h,      v,          ioGrid, theSamples ) ;
+	mid[1] = e3geom_nurbpatch_adaptive_sample( info, u + inSize, v + h,      ioGrid, theSamples ) ;
+	mid[2] = e3geom_nurbpatch_adaptive_sample( info, u + h,      v + inSize, ioGrid, theSamples ) ;
+	mid[3] = e3geom_nurbpatch_adaptive_sample( info, u,          v + h,      ioGrid, theSamples ) ;
+	mid[4] = e3geom_nurbpatch_adaptive_sample( info, u + h,      v + h,      ioGrid, theSamples ) ;
+	
+	
+	// Measure the chordal deviation of the edges, and of the centre from the
+	// diagonal that would split the quad.  In screen space the centre is
+	// left out, since only the outline of a quad shows there.
+	isFlat = e3geom_nurbpatch_adaptive_deviation( theSamples, mid[0], inCorners[0], inCorners[1] ) <= info->toleranceSquared
+		  && e3geom_nurbpatch_adaptive_deviation( theSamples, mid[1], inCorners[1], inCorners[3] ) <= info->toleranceSquared
+		  && e3geom_nurbpatch_adaptive_deviation( theSamples, mid[2], inCorners[2], inCorners[3] ) <= info->toleranceSquared
+		  && e3geom_nurbpatch_adaptive_deviation( theSamples, mid[3], inCorners[0], inCorners[2] ) <= info->toleranceSquared ;
+	if (isFlat && !info->isScreenSpace)
+		isFlat = e3geom_nurbpatch_adaptive_deviation( theSamples, mid[4], inCorners[1], inCorners[2] ) <= info->toleranceSquared ;
+	
+	
+	// A wave can pass through all the midpoints, so a quad that is bigger
+	// than the tolerance must also be fairly flat in its normals
+	if (isFlat) {
+		minTurn = 1.0f ;
+		maxSide = 0.0f ;
+		for ( n = 0; n < 4; n++ ) {
+			minTurn = E3Num_Min( minTurn, Q3FastVector3D_Dot( &theSamples[mid[4]].theNormal,
+															  &theSamples[inCorners[n]].theNormal ) ) ;
+		}
+		maxSide = E3Num_Max( maxSide, Q3FastPoint3D_DistanceSquared( &theSamples[inCorners[0]].measurePoint,
+																	 &theSamples[inCorners[3]].measurePoint ) ) ;
+		maxSide = E3Num_Max( maxSide, Q3FastPoint3D_DistanceSquared( &theSamples[inCorners[1]].measurePoint,
+																	 &theSamples[inCorners[2]].measurePoint ) ) ;
+		isFlat = minTurn >= kAdaptiveCosMaxTurn || maxSide <= info->toleranceSquared ;
+	}
 	
-	if( a > subdiv || b > subdiv || c > subdiv || d > subdiv ) {
-		
-		hu = (fu + lu)*0.5f ;
-		hv = (fv + lv)*0.5f ;
-		
-		e3geom_nurbpatch_evaluate_uv_no_deriv( hu,
-											   fv,
-											   geomData,
-											   &Phufv,
-											   uBasisValues, vBasisValues );
-		Q3Point3D_Transform( &Phufv, localToWorld, &Phufv ) ;
-		
-		e3geom_nurbpatch_evaluate_uv_no_deriv( fu,
-											   hv,
-											   geomData,
-											   &Pfuhv,
-											   uBasisValues, vBasisValues );
-		Q3Point3D_Transform( &Pfuhv, localToWorld, &Pfuhv ) ;
-		
-		e3geom_nurbpatch_evaluate_uv_no_deriv( hu,
-											   hv,
-											   geomData,
-											   &Phuhv,
-											   uBasisValues, vBasisValues );
-		Q3Point3D_Transform( &Phuhv, localToWorld, &Phuhv ) ;
-		
-		e3geom_nurbpatch_evaluate_uv_no_deriv( lu,
-											   hv,
-											   geomData,
-											   &Pluhv,
-											   uBasisValues, vBasisValues );
-		Q3Point3D_Transform( &Pluhv, localToWorld, &Pluhv ) ;
-
-		e3geom_nurbpatch_evaluate_uv_no_deriv( hu,
-											   lv,
-											   geomData,
-											   &Phulv,
-											   uBasisValues, vBasisValues );
-		Q3Point3D_Transform( &Phulv, localToWorld, &Phulv ) ;
-		
-		// Top-left square
-		recurseDepth = e3geom_nurbpatch_recursive_quad_world_subdivide( depth,
-														subdiv, fu, hu, fv, hv,
-														Pfufv, &Phufv, &Pfuhv, &Phuhv,
-														geomData, localToWorld,
-														uBasisValues, vBasisValues ) ;
-		maxRecurseDepth = maxRecurseDepth > recurseDepth ? maxRecurseDepth : recurseDepth ;
-		
-		// Top-right square
-		recurseDepth = e3geom_nurbpatch_recursive_quad_world_subdivide( depth,
-														 subdiv, hu, lu, fv, hv,
-														 &Phufv, Plufv, &Phuhv, &Pluhv,
-														 geomData, localToWorld,
-														 uBasisValues, vBasisValues ) ;
-		maxRecurseDepth = maxRecurseDepth > recurseDepth ? maxRecurseDepth : recurseDepth ;
-
-		// Bottom-left square
-		recurseDepth = e3geom_nurbpatch_recursive_quad_world_subdivide( depth,
-														 subdiv, fu, hu, hv, lv,
-														 &Pfuhv, &Phuhv, Pfulv, &Phulv,
-														 geomData, localToWorld,
-														 uBasisValues, vBasisValues ) ;
-		maxRecurseDepth = maxRecurseDepth > recurseDepth ? maxRecurseDepth : recurseDepth ;
-
-		// Bottom-right square
-		recurseDepth = e3geom_nurbpatch_recursive_quad_world_subdivide( depth,
-														 subdiv, hu, lu, hv, lv,
-														 &Phuhv, &Pluhv, &Phulv, Plulv,
-														 geomData, localToWorld,
-														 uBasisValues, vBasisValues ) ;
-		maxRecurseDepth = maxRecurseDepth > recurseDepth ? maxRecurseDepth : recurseDepth ;
+	if (isFlat) {
+		theQuad.centre = mid[4] ;
+		ioResult.quads.push_back( theQuad ) ;
+		return ;
 	}
 	
-	depth = depth > maxRecurseDepth ? depth : maxRecurseDepth ;
 	
-	return depth ;
+	// Split into four
+	child[0] = inCorners[0] ; child[1] = mid[0] ; child[2] = mid[3] ; child[3] = mid[4] ;
+	e3geom_nurbpatch_adaptive_refine( info, u,     v,     h, child, ioGrid, ioResult ) ;
 	
-	#undef a
-	#undef b
-	#undef c
-	#undef d
+	child[0] = mid[0] ; child[1] = inCorners[1] ; child[2] = mid[4] ; child[3] = mid[1] ;
+	e3geom_nurbpatch_adaptive_refine( info, u + h, v,     h, child, ioGrid, ioResult ) ;
+	
+	child[0] = mid[3] ; child[1] = mid[4] ; child[2] = inCorners[2] ; child[3] = mid[2] ;
+	e3geom_nurbpatch_adaptive_refine( info, u,     v + h, h, child, ioGrid, ioResult ) ;
+	
+	child[0] = mid[4] ; child[1] = mid[1] ; child[2] = mid[2] ; child[3] = inCorners[3] ;
+	e3geom_nurbpatch_adaptive_refine( info, u + h, v + h, h, child, ioGrid, ioResult ) ;
 }
 
 
@@ -669,124 +795,325 @@ e3geom_nurbpatch_recursive_quad_world_subdivide( TQ3Uns32 depth, float subdiv, f
 
 
 //=============================================================================
-//      e3geom_nurbpatch_recursive_quad_screen_subdivide : Recursively subdivide
-//														   a patch into 4
-//														   parametrically square
-//														   sections.
+//      e3geom_nurbpatch_adaptive_find : Find the merged sample at a lattice
+//										 point of a cell, if there is one.
 //-----------------------------------------------------------------------------
-//		Note : If *points == nullptr, an error has occurred (memory).
+//		Note :	Points inside the cell are looked up in its grid, and points
+//				on its edges in the map of samples shared between cells.
 //-----------------------------------------------------------------------------
 static TQ3Uns32
-e3geom_nurbpatch_recursive_quad_screen_subdivide( TQ3Uns32 depth, float subdiv, float fu, float lu, float fv, float lv,
-												  const TQ3Point2D* Pfufv2, const TQ3Point2D* Plufv2, const TQ3Point2D* Pfulv2, const TQ3Point2D* Plulv2,
-								  				  const TQ3NURBPatchData *geomData, const TQ3Matrix4x4* localToWindow,
-								  				  float* uBasisValues, float* vBasisValues )
+e3geom_nurbpatch_adaptive_find( TQ3Uns32 u, TQ3Uns32 v, TE3NURBPatchCellGrid& inGrid,
+								const E3NURBPatchSampleMap& inEdgeSamples )
 {
-	float hu, hv ;
-	TQ3Point3D Phufv, Pfuhv, Phuhv, Pluhv, Phulv, transformPoint ;
-	TQ3Point2D Phufv2, Pfuhv2, Phuhv2, Pluhv2, Phulv2 ;
+	std::uint64_t	theKey = (((std::uint64_t) u) << 32) | v ;
 	
-	TQ3Uns32 recurseDepth, maxRecurseDepth ;
+	if (!e3geom_nurbpatch_on_cell_edge( theKey ))
+		return e3geom_nurbpatch_grid_slot( inGrid, u, v ) ;
 	
-	depth++ ;
-	maxRecurseDepth = 0 ;
+	E3NURBPatchSampleMap::const_iterator found = inEdgeSamples.find( theKey ) ;
+	return (found == inEdgeSamples.end()) ? kQ3ArrayIndexNULL : found->second ;
+}
+
+
+
+
+
+//=============================================================================
+//      e3geom_nurbpatch_adaptive_edge : Collect the vertices that lie inside
+//										 an edge of a leaf quad.
+//-----------------------------------------------------------------------------
+//		Note :	A neighbouring quad that was split further has corners on
+//				the edge, and they must be part of this quad's outline, or
+//				there would be a crack.  Quads are split at midpoints, so
+//				if the midpoint of the edge is not a vertex, nothing inside
+//				it is.  The vertices are appended to ioOutline in order from
+//				(uA, vA) to (uB, vB), not including the ends.
+//-----------------------------------------------------------------------------
+static void
+e3geom_nurbpatch_adaptive_edge( TQ3Uns32 uA, TQ3Uns32 vA, TQ3Uns32 uB, TQ3Uns32 vB,
+								TE3NURBPatchCellGrid& inGrid, const E3NURBPatchSampleMap& inEdgeSamples,
+								const std::vector< TE3NURBPatchSample >& inSamples,
+								std::vector< TQ3Uns32 >& ioOutline )
+{
+	TQ3Uns32		uM = (uA + uB) / 2, vM = (vA + vB) / 2, theMid ;
+	
+	if ((uM == uA && vM == vA) || (uM == uB && vM == vB))
+		return ;
+	
+	theMid = e3geom_nurbpatch_adaptive_find( uM, vM, inGrid, inEdgeSamples ) ;
+	if (theMid == kQ3ArrayIndexNULL || !inSamples[theMid].isVertex)
+		return ;
+	
+	e3geom_nurbpatch_adaptive_edge( uA, vA, uM, vM, inGrid, inEdgeSamples, inSamples, ioOutline ) ;
+	ioOutline.push_back( theMid ) ;
+	e3geom_nurbpatch_adaptive_edge( uM, vM, uB, vB, inGrid, inEdgeSamples, inSamples, ioOutline ) ;
+}
+
+
+
+
+
+//=============================================================================
+//      e3geom_nurbpatch_adaptive_triangulate : Triangulate the leaves of a
+//												knot cell.
+//-----------------------------------------------------------------------------
+//		Note :	A leaf with no finer neighbour is split like a quad of
+//				constant subdivision.  Any other leaf is fanned from its
+//				centre to its whole outline, which runs counterclockwise in
+//				(u, v).  The centres used are listed in ioResult, to be made
+//				vertices once every cell is done.
+//-----------------------------------------------------------------------------
+static void
+e3geom_nurbpatch_adaptive_triangulate( TE3NURBPatchCellGrid& inGrid, const E3NURBPatchSampleMap& inEdgeSamples,
+									   const std::vector< TE3NURBPatchSample >& inSamples,
+									   TE3NURBPatchCellResult& ioResult )
+{
+	std::vector< TQ3Uns32 >		theOutline ;
+	TQ3TriMeshTriangleData		theTriangle ;
+	TQ3Uns32					n, j ;
 	
-	#define a Q3Point2D_DistanceSquared( Pfufv2, Plufv2 )
-	#define b Q3Point2D_DistanceSquared( Plufv2, Plulv2 )
-	#define c Q3Point2D_DistanceSquared( Pfulv2, Plulv2 )
-	#define d Q3Point2D_DistanceSquared( Pfufv2, Pfulv2 )
+	for ( n = 0; n < ioResult.quads.size(); n++ ) {
+		const TE3NURBPatchQuad&	q = ioResult.quads[n] ;
+		const TQ3Uns32			u1 = q.u + q.size, v1 = q.v + q.size ;
+		
+		theOutline.clear() ;
+		theOutline.push_back( q.corners[0] ) ;
+		e3geom_nurbpatch_adaptive_edge( q.u, q.v, u1, q.v, inGrid, inEdgeSamples, inSamples, theOutline ) ;
+		theOutline.push_back( q.corners[1] ) ;
+		e3geom_nurbpatch_adaptive_edge( u1, q.v, u1, v1, inGrid, inEdgeSamples, inSamples, theOutline ) ;
+		theOutline.push_back( q.corners[3] ) ;
+		e3geom_nurbpatch_adaptive_edge( u1, v1, q.u, v1, inGrid, inEdgeSamples, inSamples, theOutline ) ;
+		theOutline.push_back( q.corners[2] ) ;
+		e3geom_nurbpatch_adaptive_edge( q.u, v1, q.u, q.v, inGrid, inEdgeSamples, inSamples, theOutline ) ;
+		
+		if (theOutline.size() == 4) {
+			theTriangle.pointIndices[0] = q.corners[0] ;
+			theTriangle.pointIndices[1] = q.corners[1] ;
+			theTriangle.pointIndices[2] = q.corners[2] ;
+			ioResult.triangles.push_back( theTriangle ) ;
+			theTriangle.pointIndices[0] = q.corners[1] ;
+			theTriangle.pointIndices[1] = q.corners[3] ;
+			theTriangle.pointIndices[2] = q.corners[2] ;
+			ioResult.triangles.push_back( theTriangle ) ;
+		}
+		else {
+			// Only a quad that was tested, and so had its centre sampled,
+			// can have a finer neighbour
+			Q3_ASSERT( q.centre != kQ3ArrayIndexNULL ) ;
+			ioResult.centres.push_back( q.centre ) ;
+			for ( j = 0; j < theOutline.size(); j++ ) {
+				theTriangle.pointIndices[0] = q.centre ;
+				theTriangle.pointIndices[1] = theOutline[j] ;
+				theTriangle.pointIndices[2] = theOutline[(j + 1) % theOutline.size()] ;
+				ioResult.triangles.push_back( theTriangle ) ;
+			}
+		}
+	}
+}
+
+
+
+
+
+//=============================================================================
+//      e3geom_nurbpatch_adaptive_mesh : Tessellate the knot cells and join
+//										 them into one mesh.
+//-----------------------------------------------------------------------------
+//		Note :	The knot cells are subdivided on several threads, each cell
+//				with its own samples.  The samples are then merged, those on
+//				the edges of cells by lattice position, so that neighbouring
+//				cells share their vertices.  Last the cells are triangulated,
+//				again on several threads.  Returns kQ3False if memory ran
+//				out.
+//-----------------------------------------------------------------------------
+static TQ3Boolean
+e3geom_nurbpatch_adaptive_mesh( const TE3NURBPatchAdaptive* info,
+								TQ3Point3D** thePoints, TQ3Uns32* numPoints,
+								TQ3Param2D** theUVs, TQ3Vector3D** theNormals,
+								TQ3TriMeshTriangleData** theTriangles, TQ3Uns32* numTriangles )
+{
+	const TQ3Uns32		numCells = info->numCellsU * info->numCellsV ;
+	const TQ3Uns32		gridSize = (kAdaptiveCellSteps + 1) * (kAdaptiveCellSteps + 1) ;
+	TQ3Uns32			n, k, c, numVertices, numTris ;
 	
-	if( a > subdiv || b > subdiv || c > subdiv || d > subdiv ) {
+	try
+	{
+		std::vector< TE3NURBPatchCellResult >	cellResults( numCells ) ;
+		std::vector< TE3NURBPatchSample >		theSamples ;
+		E3NURBPatchSampleMap					edgeSamples ;
+		
+		
+		// Subdivide each knot cell
+		E3Parallel_For( numCells, kAdaptiveMinCellsPerTask,
+			[&]( TQ3Uns32 inStart, TQ3Uns32 inEnd )
+			{
+				try
+				{
+					TE3NURBPatchCellGrid	theGrid ;
+					TQ3Uns32				corners[4], theCell, u, v, s ;
+					
+					theGrid.index.assign( gridSize, kQ3ArrayIndexNULL ) ;
+					theGrid.uBases.resize( kAdaptiveCellSteps + 1 ) ;
+					theGrid.vBases.resize( kAdaptiveCellSteps + 1 ) ;
+					for ( theCell = inStart; theCell < inEnd; theCell++ ) {
+						TE3NURBPatchCellResult&	theResult = cellResults[theCell] ;
+						
+						u = theGrid.u0 = (theCell % info->numCellsU) << kAdaptiveMaxLevel ;
+						v = theGrid.v0 = (theCell / info->numCellsU) << kAdaptiveMaxLevel ;
+						theGrid.haveUBasis.assign( kAdaptiveCellSteps + 1, false ) ;
+						theGrid.haveVBasis.assign( kAdaptiveCellSteps + 1, false ) ;
+						corners[0] = e3geom_nurbpatch_adaptive_sample( info, u, v, theGrid, theResult.samples ) ;
+						corners[1] = e3geom_nurbpatch_adaptive_sample( info, u + kAdaptiveCellSteps, v, theGrid, theResult.samples ) ;
+						corners[2] = e3geom_nurbpatch_adaptive_sample( info, u, v + kAdaptiveCellSteps, theGrid, theResult.samples ) ;
+						corners[3] = e3geom_nurbpatch_adaptive_sample( info, u + kAdaptiveCellSteps, v + kAdaptiveCellSteps,
+																	   theGrid, theResult.samples ) ;
+						e3geom_nurbpatch_adaptive_refine( info, u, v, kAdaptiveCellSteps, corners, theGrid, theResult ) ;
+						
+						for ( s = 0; s < theResult.samples.size(); s++ )
+							e3geom_nurbpatch_grid_slot( theGrid, (TQ3Uns32) (theResult.samples[s].key >> 32),
+														(TQ3Uns32) theResult.samples[s].key ) = kQ3ArrayIndexNULL ;
+					}
+				}
+				catch (...)
+				{
+					for ( TQ3Uns32 theCell = inStart; theCell < inEnd; theCell++ )
+						cellResults[theCell].didFail = true ;
+				}
+			} ) ;
+		
+		
+		// Merge the samples of the cells, and mark the corners of leaves
+		for ( c = 0; c < numCells; c++ ) {
+			TE3NURBPatchCellResult&	theResult = cellResults[c] ;
+			
+			if (theResult.didFail)
+				throw std::bad_alloc() ;
+			
+			theResult.toMerged.resize( theResult.samples.size() ) ;
+			for ( k = 0; k < theResult.samples.size(); k++ ) {
+				if (e3geom_nurbpatch_on_cell_edge( theResult.samples[k].key )) {
+					std::pair< E3NURBPatchSampleMap::iterator, bool > inserted =
+						edgeSamples.insert( E3NURBPatchSampleMap::value_type( theResult.samples[k].key,
+																			  (TQ3Uns32) theSamples.size() ) ) ;
+					if (inserted.second)
+						theSamples.push_back( theResult.samples[k] ) ;
+					theResult.toMerged[k] = inserted.first->second ;
+				}
+				else {
+					theResult.toMerged[k] = (TQ3Uns32) theSamples.size() ;
+					theSamples.push_back( theResult.samples[k] ) ;
+				}
+			}
+			
+			for ( n = 0; n < theResult.quads.size(); n++ ) {
+				TE3NURBPatchQuad&	theQuad = theResult.quads[n] ;
+				
+				for ( k = 0; k < 4; k++ ) {
+					theQuad.corners[k] = theResult.toMerged[ theQuad.corners[k] ] ;
+					theSamples[ theQuad.corners[k] ].isVertex = true ;
+				}
+				if (theQuad.centre != kQ3ArrayIndexNULL)
+					theQuad.centre = theResult.toMerged[ theQuad.centre ] ;
+			}
+		}
 		
-		hu = (fu + lu)*0.5f ;
-		hv = (fv + lv)*0.5f ;
 		
-		e3geom_nurbpatch_evaluate_uv_no_deriv( hu,
-											   fv,
-											   geomData,
-											   &Phufv,
-											   uBasisValues, vBasisValues );
-		Q3Point3D_Transform( &Phufv, localToWindow, &transformPoint ) ;
-		Phufv2.x = transformPoint.x ;
-		Phufv2.y = transformPoint.y ;
+		// Triangulate each cell
+		E3Parallel_For( numCells, kAdaptiveMinCellsPerTask,
+			[&]( TQ3Uns32 inStart, TQ3Uns32 inEnd )
+			{
+				try
+				{
+					TE3NURBPatchCellGrid	theGrid ;
+					TQ3Uns32				theCell, s ;
+					
+					theGrid.index.assign( gridSize, kQ3ArrayIndexNULL ) ;
+					for ( theCell = inStart; theCell < inEnd; theCell++ ) {
+						TE3NURBPatchCellResult&	theResult = cellResults[theCell] ;
+						
+						theGrid.u0 = (theCell % info->numCellsU) << kAdaptiveMaxLevel ;
+						theGrid.v0 = (theCell / info->numCellsU) << kAdaptiveMaxLevel ;
+						for ( s = 0; s < theResult.samples.size(); s++ )
+							e3geom_nurbpatch_grid_slot( theGrid, (TQ3Uns32) (theResult.samples[s].key >> 32),
+														(TQ3Uns32) theResult.samples[s].key ) = theResult.toMerged[s] ;
+						
+						e3geom_nurbpatch_adaptive_triangulate( theGrid, edgeSamples, theSamples, theResult ) ;
+						
+						for ( s = 0; s < theResult.samples.size(); s++ )
+							e3geom_nurbpatch_grid_slot( theGrid, (TQ3Uns32) (theResult.samples[s].key >> 32),
+														(TQ3Uns32) theResult.samples[s].key ) = kQ3ArrayIndexNULL ;
+					}
+				}
+				catch (...)
+				{
+					for ( TQ3Uns32 theCell = inStart; theCell < inEnd; theCell++ )
+						cellResults[theCell].didFail = true ;
+				}
+			} ) ;
+		
+		
+		// Centres are only marked now, since they lie on no edge
+		numTris = 0 ;
+		for ( c = 0; c < numCells; c++ ) {
+			if (cellResults[c].didFail)
+				throw std::bad_alloc() ;
+			
+			for ( n = 0; n < cellResults[c].centres.size(); n++ )
+				theSamples[ cellResults[c].centres[n] ].isVertex = true ;
+			numTris += (TQ3Uns32) cellResults[c].triangles.size() ;
+		}
 		
-		e3geom_nurbpatch_evaluate_uv_no_deriv( fu,
-											   hv,
-											   geomData,
-											   &Pfuhv,
-											   uBasisValues, vBasisValues );
-		Q3Point3D_Transform( &Pfuhv, localToWindow, &transformPoint ) ;
-		Pfuhv2.x = transformPoint.x ;
-		Pfuhv2.y = transformPoint.y ;
 		
-		e3geom_nurbpatch_evaluate_uv_no_deriv( hu,
-											   hv,
-											   geomData,
-											   &Phuhv,
-											   uBasisValues, vBasisValues );
-		Q3Point3D_Transform( &Phuhv, localToWindow, &transformPoint ) ;
-		Phuhv2.x = transformPoint.x ;
-		Phuhv2.y = transformPoint.y ;
+		// Number the vertices and fill in the TriMesh arrays
+		std::vector< TQ3Uns32 >		vertexOf( theSamples.size(), kQ3ArrayIndexNULL ) ;
 		
-		e3geom_nurbpatch_evaluate_uv_no_deriv( lu,
-											   hv,
-											   geomData,
-											   &Pluhv,
-											   uBasisValues, vBasisValues );
-		Q3Point3D_Transform( &Pluhv, localToWindow, &transformPoint ) ;
-		Pluhv2.x = transformPoint.x ;
-		Pluhv2.y = transformPoint.y ;
-
-		e3geom_nurbpatch_evaluate_uv_no_deriv( hu,
-											   lv,
-											   geomData,
-											   &Phulv,
-											   uBasisValues, vBasisValues );
-		Q3Point3D_Transform( &Phulv, localToWindow, &transformPoint ) ;
-		Phulv2.x = transformPoint.x ;
-		Phulv2.y = transformPoint.y ;
+		numVertices = 0 ;
+		for ( n = 0; n < theSamples.size(); n++ ) {
+			if (theSamples[n].isVertex)
+				vertexOf[n] = numVertices++ ;
+		}
+		
+		*thePoints    = (TQ3Point3D *)             Q3Memory_Allocate(static_cast<TQ3Uns32>(numVertices * sizeof(TQ3Point3D)));
+		*theNormals   = (TQ3Vector3D *)            Q3Memory_Allocate(static_cast<TQ3Uns32>(numVertices * sizeof(TQ3Vector3D)));
+		*theUVs       = (TQ3Param2D  *)            Q3Memory_Allocate(static_cast<TQ3Uns32>(numVertices * sizeof(TQ3Param2D)));
+		*theTriangles = (TQ3TriMeshTriangleData *) Q3Memory_Allocate(static_cast<TQ3Uns32>(numTris * sizeof(TQ3TriMeshTriangleData)));
+		
+		if (*thePoints == nullptr || *theNormals == nullptr || *theUVs == nullptr || *theTriangles == nullptr) {
+			Q3Memory_Free( thePoints ) ;
+			Q3Memory_Free( theNormals ) ;
+			Q3Memory_Free( theUVs ) ;
+			Q3Memory_Free( theTriangles ) ;
+			return kQ3False ;
+		}
+		
+		for ( n = 0; n < theSamples.size(); n++ ) {
+			if (vertexOf[n] != kQ3ArrayIndexNULL) {
+				(*thePoints) [vertexOf[n]] = theSamples[n].thePoint ;
+				(*theNormals)[vertexOf[n]] = theSamples[n].theNormal ;
+				(*theUVs)    [vertexOf[n]] = theSamples[n].theUV ;
+			}
+		}
 		
-		// Top-left square
-		recurseDepth = e3geom_nurbpatch_recursive_quad_screen_subdivide( depth,
-														subdiv, fu, hu, fv, hv,
-														Pfufv2, &Phufv2, &Pfuhv2, &Phuhv2,
-														geomData, localToWindow,
-														uBasisValues, vBasisValues ) ;
-		maxRecurseDepth = maxRecurseDepth > recurseDepth ? maxRecurseDepth : recurseDepth ;
+		numTris = 0 ;
+		for ( c = 0; c < numCells; c++ ) {
+			const std::vector< TQ3TriMeshTriangleData >&	cellTriangles = cellResults[c].triangles ;
+			
+			for ( n = 0; n < cellTriangles.size(); n++, numTris++ ) {
+				for ( k = 0; k < 3; k++ )
+					(*theTriangles)[numTris].pointIndices[k] = vertexOf[ cellTriangles[n].pointIndices[k] ] ;
+			}
+		}
 		
-		// Top-right square
-		recurseDepth = e3geom_nurbpatch_recursive_quad_screen_subdivide( depth,
-														 subdiv, hu, lu, fv, hv,
-														 &Phufv2, Plufv2, &Phuhv2, &Pluhv2,
-														 geomData, localToWindow,
-														 uBasisValues, vBasisValues ) ;
-		maxRecurseDepth = maxRecurseDepth > recurseDepth ? maxRecurseDepth : recurseDepth ;
-
-		// Bottom-left square
-		recurseDepth = e3geom_nurbpatch_recursive_quad_screen_subdivide( depth,
-														 subdiv, fu, hu, hv, lv,
-														 &Pfuhv2, &Phuhv2, Pfulv2, &Phulv2,
-														 geomData, localToWindow,
-														 uBasisValues, vBasisValues ) ;
-		maxRecurseDepth = maxRecurseDepth > recurseDepth ? maxRecurseDepth : recurseDepth ;
-
-		// Bottom-right square
-		recurseDepth = e3geom_nurbpatch_recursive_quad_screen_subdivide( depth,
-														 subdiv, hu, lu, hv, lv,
-														 &Phuhv2, &Pluhv2, &Phulv2, Plulv2,
-														 geomData, localToWindow,
-														 uBasisValues, vBasisValues ) ;
-		maxRecurseDepth = maxRecurseDepth > recurseDepth ? maxRecurseDepth : recurseDepth ;
+		*numPoints    = numVertices ;
+		*numTriangles = numTris ;
+	}
+	catch (...)
+	{
+		E3ErrorManager_PostError( kQ3ErrorOutOfMemory, kQ3False ) ;
+		return kQ3False ;
 	}
 	
-	depth = depth > maxRecurseDepth ? depth : maxRecurseDepth ;
-	
-	return depth ;
-	
-	#undef a
-	#undef b
-	#undef c
-	#undef d
+	return kQ3True ;
 }
 
 
@@ -794,40 +1121,31 @@ e3geom_nurbpatch_recursive_quad_screen_subdivide( TQ3Uns32 depth, float subdiv,
 
 
 //=============================================================================
-//      e3geom_nurbcurve_worldscreen_subdiv : Subdivide the given NURB curve
-//											  into triangles whose edges have
-//											  at most the given world or
-//											  screen-space length. Vertices are
-//											  guaranteed at knots.
+//      e3geom_nurbpatch_adaptive_subdiv : Subdivide the given NURB patch into
+//										   triangles that are within the given
+//										   world or screen-space distance of
+//										   the surface.  Vertices are
+//										   guaranteed at knots.
 //-----------------------------------------------------------------------------
-//		Note :	Calls through to e3geom_nurbcurve_constant_subdiv.
-//				If the points array is non-nullptr on return, be sure to free it
-//				with Q3Memory_Free(). If it is nullptr, then an error has occurred.
+//		Note :	Each knot cell is split as a quadtree until its edges and
+//				centre are within subdiv of the surface.  All quads lie on
+//				one lattice of parameter values, and evaluated samples are
+//				kept by lattice position, so neighbouring quads share their
+//				vertices and no point is evaluated twice within a cell.
+//
+//				If the points array is non-nullptr on return, be sure to free
+//				it with Q3Memory_Free(). If it is nullptr, then an error has
+//				occurred.
 //-----------------------------------------------------------------------------
-// I need the function declaration for constant subdivision since I call through to it
 static void
-e3geom_nurbpatch_constant_subdiv( TQ3Point3D** thePoints, TQ3Uns32* numPoints,
+e3geom_nurbpatch_adaptive_subdiv( TQ3Point3D** thePoints, TQ3Uns32* numPoints,
 								  TQ3Param2D** theUVs, TQ3Vector3D** theNormals,
 								  TQ3TriMeshTriangleData** theTriangles, TQ3Uns32* numTriangles,
-								  float subdivU, float subdivV,
-								  const TQ3NURBPatchData *geomData,
-								  float* uBasisValues, float* vBasisValues, float* uBasisDerivValues, float* vBasisDerivValues ) ;
-
-static void
-e3geom_nurbpatch_worldscreen_subdiv( TQ3Point3D** thePoints, TQ3Uns32* numPoints,
-									 TQ3Param2D** theUVs, TQ3Vector3D** theNormals,
-									 TQ3TriMeshTriangleData** theTriangles, TQ3Uns32* numTriangles,
-									 float subdiv,
-									 const TQ3NURBPatchData *geomData, TQ3ViewObject theView, TQ3Boolean isScreenSpaceSubdivision,
-									 float* uBasisValues, float* vBasisValues, float* uBasisDerivValues, float* vBasisDerivValues )
-{	float			*interestingU, *interestingV ;
-	TQ3Uns32		nu, nv,
-					maxdepth, somedepth,
-					numIntU, numIntV ;
-	TQ3Point3D		u0v0, u1v0, u0v1, u1v1 ;
-	TQ3Point2D		u0v02, u1v02, u0v12, u1v12 ;
-	// To cache the local -> world and local -> screen matrices
-	TQ3Matrix4x4	localToWorld, worldToFrustum, frustumToWindow, localToWindow ;
+								  float subdiv,
+								  const TQ3NURBPatchData *geomData, TQ3ViewObject theView, TQ3Boolean isScreenSpaceSubdivision )
+{	float					*interestingU, *interestingV ;
+	TE3NURBPatchAdaptive	info ;
+	TQ3Matrix4x4			worldToFrustum, frustumToWindow ;
 	
 #if Q3_DEBUG
 	Q3_ASSERT( thePoints != nullptr && numPoints != nullptr && theUVs != nullptr && theNormals != nullptr
@@ -836,6 +1154,7 @@ e3geom_nurbpatch_worldscreen_subdiv( TQ3Point3D** thePoints, TQ3Uns32* numPoints
 	
 	// For the error handler
 	interestingU = interestingV = nullptr ;
+	*thePoints = nullptr ;
 	
 	// First some sanity checking on subdivisionData
 	subdiv = E3Num_Max(subdiv, 0.001f) ;
@@ -843,126 +1162,83 @@ e3geom_nurbpatch_worldscreen_subdiv( TQ3Point3D** thePoints, TQ3Uns32* numPoints
 	// Find the interesting knots (ie skip the repeated knots)
 	interestingU = (float *) Q3Memory_Allocate(static_cast<TQ3Uns32>((geomData->numColumns - geomData->uOrder + 2) * sizeof(float)));
 	if (interestingU == nullptr) {
-		goto nurbpatch_world_subdiv_error_handler ;
+		goto nurbpatch_adaptive_subdiv_error_handler ;
 	}
-	numIntU = e3geom_nurbpatch_interesting_knots( geomData->uKnots, geomData->numColumns, geomData->uOrder, interestingU );
 	
 	interestingV = (float *) Q3Memory_Allocate(static_cast<TQ3Uns32>((geomData->numRows - geomData->vOrder + 2) * sizeof(float)));
 	if (interestingV == nullptr) {
-		goto nurbpatch_world_subdiv_error_handler ;
+		goto nurbpatch_adaptive_subdiv_error_handler ;
 	}
-	numIntV = e3geom_nurbpatch_interesting_knots( geomData->vKnots, geomData->numRows, geomData->vOrder, interestingV );
 	
-	// we need the localToWorld matrix for both world and screen subdivisions
-	Q3View_GetLocalToWorldMatrixState(theView, &localToWorld);
-	// if we are doing a screen subdivision,
-	// truncate subdiv into an integer and cache the worldToWindow matrix
+	info.patch            = geomData ;
+	info.interestingU     = interestingU ;
+	info.interestingV     = interestingV ;
+	info.numCellsU        = e3geom_nurbpatch_interesting_knots( geomData->uKnots, geomData->numColumns, geomData->uOrder, interestingU ) - 1 ;
+	info.numCellsV        = e3geom_nurbpatch_interesting_knots( geomData->vKnots, geomData->numRows, geomData->vOrder, interestingV ) - 1 ;
+	info.isScreenSpace    = isScreenSpaceSubdivision ;
+	info.toleranceSquared = subdiv * subdiv ;
+	
+	// Find where the tolerance is measured.  A view without a camera or draw
+	// context leaves the identity in place of the missing matrices.
+	Q3Matrix4x4_SetIdentity(&info.localToMeasure);
+	Q3Matrix4x4_SetIdentity(&worldToFrustum);
+	Q3Matrix4x4_SetIdentity(&frustumToWindow);
+	
+	Q3View_GetLocalToWorldMatrixState(theView, &info.localToMeasure);
 	if( isScreenSpaceSubdivision ) {
-		// truncate subdiv
-		subdiv = (float) floor( subdiv ) ;
-		// cache the localToWindow matrix for theView
 		Q3View_GetWorldToFrustumMatrixState(theView,  &worldToFrustum);
 		Q3View_GetFrustumToWindowMatrixState(theView, &frustumToWindow);
 		
-		Q3Matrix4x4_Multiply(&localToWorld, &worldToFrustum, &localToWindow);
-		Q3Matrix4x4_Multiply(&localToWindow, &frustumToWindow, &localToWindow);
+		Q3Matrix4x4_Multiply(&info.localToMeasure, &worldToFrustum, &info.localToMeasure);
+		Q3Matrix4x4_Multiply(&info.localToMeasure, &frustumToWindow, &info.localToMeasure);
 	}
 	
+	if (info.numCellsU == 0 || info.numCellsV == 0 ||
+		!e3geom_nurbpatch_adaptive_mesh( &info, thePoints, numPoints, theUVs, theNormals, theTriangles, numTriangles )) {
+		goto nurbpatch_adaptive_subdiv_error_handler ;
+	}
 	
-	// square subdiv now to save a whole lot of sqrt's later (in the distance comparison)
-	subdiv *= subdiv ;
-	
-	maxdepth = 0 ;
-	
-	// Iterate over every 'square' of the grid resulting from (u-knots) x (v-knots)
-	for( nv = 0 ; nv < numIntV -1 ; nv++ ) {
-		for( nu = 0 ; nu < numIntU -1 ; nu++ ) {
-			
-			e3geom_nurbpatch_evaluate_uv_no_deriv( interestingU[ nu ],
-												   interestingV[ nv ],
-												   geomData,
-												   &u0v0,
-												   uBasisValues, vBasisValues );
-			e3geom_nurbpatch_evaluate_uv_no_deriv( interestingU[ nu +1 ],
-												   interestingV[ nv ],
-												   geomData,
-												   &u1v0,
-												   uBasisValues, vBasisValues );
-			e3geom_nurbpatch_evaluate_uv_no_deriv( interestingU[ nu ],
-												   interestingV[ nv +1 ],
-												   geomData,
-												   &u0v1,
-												   uBasisValues, vBasisValues );
-			e3geom_nurbpatch_evaluate_uv_no_deriv( interestingU[ nu +1 ],
-												   interestingV[ nv +1 ],
-												   geomData,
-												   &u1v1,
-												   uBasisValues, vBasisValues );
-			
-			if( kQ3False == isScreenSpaceSubdivision ) {
-				Q3Point3D_Transform(&u0v0, &localToWorld, &u0v0) ;
-				Q3Point3D_Transform(&u1v0, &localToWorld, &u1v0) ;
-				Q3Point3D_Transform(&u0v1, &localToWorld, &u0v1) ;
-				Q3Point3D_Transform(&u1v1, &localToWorld, &u1v1) ;
-				somedepth = e3geom_nurbpatch_recursive_quad_world_subdivide( 0, subdiv,
-																 interestingU[ nu ], interestingU[ nu +1 ],
-																 interestingV[ nv ], interestingV[ nv +1 ],
-																 &u0v0, &u1v0, &u0v1, &u1v1,
-																 geomData, &localToWorld,
-																 uBasisValues, vBasisValues ) ;
-			} else {
-				Q3Point3D_Transform(&u0v0, &localToWorld, &u0v0) ;
-				u0v02.x = u0v0.x ;
-				u0v02.y = u0v0.y ;
-				Q3Point3D_Transform(&u1v0, &localToWorld, &u1v0) ;
-				u1v02.x = u1v0.x ;
-				u1v02.y = u1v0.y ;
-				Q3Point3D_Transform(&u0v1, &localToWorld, &u0v1) ;
-				u0v12.x = u0v1.x ;
-				u0v12.y = u0v1.y ;
-				Q3Point3D_Transform(&u1v1, &localToWorld, &u1v1) ;
-				u1v12.x = u1v1.x ;
-				u1v12.y = u1v1.y ;
-				somedepth = e3geom_nurbpatch_recursive_quad_screen_subdivide( 0, subdiv,
-																  interestingU[ nu ], interestingU[ nu +1 ],
-																  interestingV[ nv ], interestingV[ nv +1 ],
-																  &u0v02, &u1v02, &u0v12, &u1v12,
-																  geomData, &localToWindow,
-																  uBasisValues, vBasisValues ) ;
-			}
-			
-			maxdepth = maxdepth > somedepth ? maxdepth : somedepth ;
-			
-		} // ~for( nu )
-	} // ~for( nv )
 	Q3Memory_Free( &interestingU ) ;
 	Q3Memory_Free( &interestingV ) ;
-	
-	subdiv = (float)pow( 2.0, (int)maxdepth -1 ) ;
-	
-	
-	// I am not sure what causes subdiv to become infinite or what the value should really be,
-	// but I am sure that we do not want infinity here.
-	if (!isfinite( subdiv ))
-		subdiv = kFiniteSubdivision;
-	
-	
-	e3geom_nurbpatch_constant_subdiv( thePoints, numPoints, theUVs, theNormals,
-									  theTriangles, numTriangles,
-									  subdiv, subdiv,
-									  geomData,
-									  uBasisValues, vBasisValues, uBasisDerivValues, vBasisDerivValues ) ;
-	
 	return ;
 	
-   nurbpatch_world_subdiv_error_handler:
+   nurbpatch_adaptive_subdiv_error_handler:
 	Q3Memory_Free( &interestingU ) ;
 	Q3Memory_Free( &interestingV ) ;
 	
-	if (thePoints != nullptr)
-	{
-		*thePoints = nullptr ;
+	*thePoints = nullptr ;
+}
+
+
+
+
+
+//=============================================================================
+//      e3geom_nurbpatch_subdiv_params : Find the parameter values of a line of
+//										 constant subdivision.
+//-----------------------------------------------------------------------------
+//		Note :	Each interval between interesting knots gets subdiv steps,
+//				and the last knot ends the line.  Returns the number of
+//				parameter values, which is (numInteresting-1)*subdiv + 1.
+//-----------------------------------------------------------------------------
+static TQ3Uns32
+e3geom_nurbpatch_subdiv_params( const float * interestingK, TQ3Uns32 numInteresting, float subdiv, float * outParams )
+{	float		increment, curIncr ;
+	TQ3Uns32	curKnot, n ;
+	
+	n = 0 ;
+	for (curKnot = 0; curKnot < numInteresting - 1; curKnot++ ) {
+		increment = (interestingK[curKnot+1] - interestingK[curKnot]) / subdiv;
+		
+		for (curIncr = 0.0f; curIncr < subdiv; curIncr+=1.0f ) {
+			outParams[n++] = interestingK[curKnot] + curIncr*increment;
+		}
 	}
+	
+	// Cap
+	outParams[n++] = interestingK[numInteresting - 1] ;
+	
+	return n ;
 }
 
 
@@ -976,23 +1252,38 @@ e3geom_nurbpatch_worldscreen_subdiv( TQ3Point3D** thePoints, TQ3Uns32* numPoints
 //		Note :	If the points array is non-nullptr on return, be sure to free it
 //				with Q3Memory_Free(). If it is nullptr, then an error has occured.
 //-----------------------------------------------------------------------------
+//		Note :	The basis in u is evaluated once per column of the grid.  Each
+//				row first sums the control net down to one point per control
+//				column for its v, and then each grid point in the row only
+//				needs the uOrder points its u basis covers.
+//-----------------------------------------------------------------------------
 static void
 e3geom_nurbpatch_constant_subdiv( TQ3Point3D** thePoints, TQ3Uns32* numPoints,
 								  TQ3Param2D** theUVs, TQ3Vector3D** theNormals,
 								  TQ3TriMeshTriangleData** theTriangles, TQ3Uns32* numTriangles,
 								  float subdivU, float subdivV,
-								  const TQ3NURBPatchData *geomData,
-								  float* uBasisValues, float* vBasisValues, float* uBasisDerivValues, float* vBasisDerivValues )
-{	float		incrementU, incrementV, curIncrU, curIncrV, curU, curV ;
-	float		*interestingU, *interestingV;
-	TQ3Uns32	curKnotU, curKnotV, u, v, ptInd, trInd,
-				numIntU, numIntV, numrows, numcolumns, numpts, numtris ;
+								  const TQ3NURBPatchData *geomData )
+{	float				*interestingU, *interestingV, *uParams, *vParams ;
+	TE3NURBSBasis		*uBases, vBasis ;
+	TQ3RationalPoint4D	*rowPoints, *rowDerivs ;
+	TQ3RationalPoint4D	theSum, theDu, theDv ;
+	TQ3Uns32			u, v, ptInd, trInd,
+						numIntU, numIntV, numrows, numcolumns, numpts, numtris ;
 
 #if Q3_DEBUG
 	Q3_ASSERT( thePoints != nullptr && numPoints != nullptr && theUVs != nullptr && theNormals != nullptr
 			   && theTriangles != nullptr && numTriangles != nullptr ) ;
 #endif
 	
+	// For the error handler
+	interestingU = interestingV = uParams = vParams = nullptr ;
+	uBases = nullptr ;
+	rowPoints = rowDerivs = nullptr ;
+	*thePoints = nullptr ;
+	*theNormals = nullptr ;
+	*theUVs = nullptr ;
+	*theTriangles = nullptr ;
+	
 	// First some sanity checking on subdivisionData
 	subdivU = (float) ((TQ3Uns32) E3Num_Clamp(subdivU, 1.0f, 256.0f));
 	subdivV = (float) ((TQ3Uns32) E3Num_Clamp(subdivV, 1.0f, 256.0f));
@@ -1000,18 +1291,14 @@ e3geom_nurbpatch_constant_subdiv( TQ3Point3D** thePoints, TQ3Uns32* numPoints,
 	// Find the interesting knots (ie skip the repeated knots)
 	interestingU = (float *) Q3Memory_Allocate(static_cast<TQ3Uns32>((geomData->numColumns - geomData->uOrder + 2) * sizeof(float)));
 	if (interestingU == nullptr) {
-		*thePoints = nullptr ;
-		return ;
+		goto nurbpatch_constant_subdiv_error_handler ;
 	}
 	numIntU = e3geom_nurbpatch_interesting_knots( geomData->uKnots, geomData->numColumns, geomData->uOrder, interestingU );
 	numcolumns = (numIntU-1)*((TQ3Uns32)subdivU) + 1;
 	
 	interestingV = (float *) Q3Memory_Allocate(static_cast<TQ3Uns32>((geomData->numRows - geomData->vOrder + 2) * sizeof(float)));
 	if (interestingV == nullptr) {
-		Q3Memory_Free( &interestingU ) ;
-		
-		*thePoints = nullptr ;
-		return ;
+		goto nurbpatch_constant_subdiv_error_handler ;
 	}
 	numIntV = e3geom_nurbpatch_interesting_knots( geomData->vKnots, geomData->numRows, geomData->vOrder, interestingV );
 	numrows = (numIntV-1)*((TQ3Uns32)subdivV) + 1;
@@ -1026,93 +1313,42 @@ e3geom_nurbpatch_constant_subdiv( TQ3Point3D** thePoints, TQ3Uns32* numPoints,
 	*theUVs       = (TQ3Param2D  *)            Q3Memory_Allocate(static_cast<TQ3Uns32>(numpts    * sizeof(TQ3Param2D)));
 	*theTriangles = (TQ3TriMeshTriangleData *) Q3Memory_Allocate(static_cast<TQ3Uns32>(numtris * sizeof(TQ3TriMeshTriangleData)));
 
-	if (*thePoints == nullptr || *theNormals == nullptr || *theUVs == nullptr || *theTriangles == nullptr) {
-		Q3Memory_Free( &interestingU ) ;
-		Q3Memory_Free( &interestingV ) ;
-		
-		*thePoints = nullptr ;
-		return ;
-	}
-	// Outer V loop
-	for (curKnotV = 0; curKnotV < numIntV - 1; curKnotV++ ) {
-		incrementV = (interestingV[curKnotV+1] - interestingV[curKnotV]) / subdivV;
-		
-		for (curIncrV = 0.0f; curIncrV < subdivV; curIncrV+=1.0f ) {
-			curV = interestingV[curKnotV] + curIncrV*incrementV;
-			
-			// Inner U loop
-			for (curKnotU = 0; curKnotU < numIntU - 1; curKnotU++ ) {
-				incrementU = (interestingU[curKnotU+1] - interestingU[curKnotU]) / subdivU;
-				
-				for (curIncrU = 0.0f; curIncrU < subdivU; curIncrU+=1.0f ) {
-						curU = interestingU[curKnotU] + curIncrU*incrementU;
-						
-						ptInd =  ( curKnotV*(TQ3Uns32)subdivV+(TQ3Uns32)curIncrV )*numcolumns + 
-								curKnotU*(TQ3Uns32)subdivU+(TQ3Uns32)curIncrU ;
-						// Let's try this for our uv's
-						(*theUVs)[ptInd].u = curU ;
-						(*theUVs)[ptInd].v = curV ;
-						
-						e3geom_nurbpatch_evaluate_uv(
-												curU,
-												curV,
-												geomData,
-												&(*theNormals)[ptInd],
-												&(*thePoints)[ptInd],
-												uBasisValues, vBasisValues, uBasisDerivValues, vBasisDerivValues );
-				}
-			}
-			// Cap evaluation for u
-			ptInd = ( curKnotV*(TQ3Uns32)subdivV+(TQ3Uns32)curIncrV )*numcolumns +
-					numcolumns - 1;
-			// Let's try this for our uv's
-			(*theUVs)[ptInd].u = interestingU[numIntU - 1] ;
-			(*theUVs)[ptInd].v = curV ;
-			e3geom_nurbpatch_evaluate_uv(
-										interestingU[numIntU - 1],
-										curV,
-										geomData,
-										&(*theNormals)[ptInd],
-										&(*thePoints)[ptInd],
-										uBasisValues, vBasisValues, uBasisDerivValues, vBasisDerivValues );
+	// And for the parameters and bases of the grid, and one row of sums
+	uParams   = (float *)              Q3Memory_Allocate(static_cast<TQ3Uns32>(numcolumns * sizeof(float)));
+	vParams   = (float *)              Q3Memory_Allocate(static_cast<TQ3Uns32>(numrows    * sizeof(float)));
+	uBases    = (TE3NURBSBasis *)      Q3Memory_Allocate(static_cast<TQ3Uns32>(numcolumns * sizeof(TE3NURBSBasis)));
+	rowPoints = (TQ3RationalPoint4D *) Q3Memory_Allocate(static_cast<TQ3Uns32>(geomData->numColumns * sizeof(TQ3RationalPoint4D)));
+	rowDerivs = (TQ3RationalPoint4D *) Q3Memory_Allocate(static_cast<TQ3Uns32>(geomData->numColumns * sizeof(TQ3RationalPoint4D)));
 
-		}
+	if (*thePoints == nullptr || *theNormals == nullptr || *theUVs == nullptr || *theTriangles == nullptr
+		|| uParams == nullptr || vParams == nullptr || uBases == nullptr || rowPoints == nullptr || rowDerivs == nullptr) {
+		goto nurbpatch_constant_subdiv_error_handler ;
 	}
-	// Final evaluation loop (on the v-cap)
-	for (curKnotU = 0; curKnotU < numIntU - 1; curKnotU++ ) {
-		incrementU = (interestingU[curKnotU+1] - interestingU[curKnotU]) / subdivU;
+	
+	// The parameters of the grid lines, and the basis of each column
+	e3geom_nurbpatch_subdiv_params( interestingU, numIntU, subdivU, uParams ) ;
+	e3geom_nurbpatch_subdiv_params( interestingV, numIntV, subdivV, vParams ) ;
+	
+	for ( u = 0; u < numcolumns; u++ )
+		E3NURBS_EvaluateBasis( uParams[u], geomData->uOrder, geomData->numColumns, geomData->uKnots, kQ3True, &uBases[u] ) ;
+	
+	// Evaluate the grid a row at a time
+	for ( v = 0; v < numrows; v++ ) {
+		E3NURBS_EvaluateBasis( vParams[v], geomData->vOrder, geomData->numRows, geomData->vKnots, kQ3True, &vBasis ) ;
+		E3NURBS_CombineRows( &vBasis, geomData->numColumns, geomData->controlPoints, rowPoints, rowDerivs ) ;
 		
-		for (curIncrU = 0.0f; curIncrU < subdivU; curIncrU+=1.0f ) {
-				curU = interestingU[curKnotU] + curIncrU*incrementU;
-				
-				ptInd =  (numrows - 1)*numcolumns + 
-						curKnotU*(TQ3Uns32)subdivU+(TQ3Uns32)curIncrU ;
-				// Let's try this for our uv's
-				(*theUVs)[ptInd].u = curU ;
-				(*theUVs)[ptInd].v = interestingV[numIntV - 1] ;
-				
-				e3geom_nurbpatch_evaluate_uv(
-										curU,
-										interestingV[numIntV - 1],
-										geomData,
-										&(*theNormals)[ptInd],
-										&(*thePoints)[ptInd],
-										uBasisValues, vBasisValues, uBasisDerivValues, vBasisDerivValues );
+		for ( u = 0; u < numcolumns; u++ ) {
+			ptInd = v*numcolumns + u ;
+			// Let's try this for our uv's
+			(*theUVs)[ptInd].u = uParams[u] ;
+			(*theUVs)[ptInd].v = vParams[v] ;
+			
+			E3NURBS_CombinePoints( &uBases[u], rowPoints, 1, &theSum, &theDu ) ;
+			E3NURBS_CombinePoints( &uBases[u], rowDerivs, 1, &theDv, nullptr ) ;
+			e3geom_nurbpatch_rational_point_normal( &theSum, &theDu, &theDv,
+													&(*thePoints)[ptInd], &(*theNormals)[ptInd] ) ;
 		}
 	}
-	// The grande finale cap evaluation
-	ptInd = numpts - 1;
-	// Let's try this for our uv's
-	(*theUVs)[ptInd].u = interestingU[numIntU - 1] ;
-	(*theUVs)[ptInd].v = interestingV[numIntV - 1] ;
-
-	e3geom_nurbpatch_evaluate_uv(
-								interestingU[numIntU - 1],
-								interestingV[numIntV - 1],
-								geomData,
-								&(*theNormals)[ptInd],
-								&(*thePoints)[numpts - 1],
-								uBasisValues, vBasisValues, uBasisDerivValues, vBasisDerivValues );
 
 	// Make triangles from the points
 	for ( v = 0; v < numrows - 1; v++ )
@@ -1146,6 +1382,29 @@ e3geom_nurbpatch_constant_subdiv( TQ3Point3D** thePoints, TQ3Uns32* numPoints,
 	
 	*numPoints = numpts ;
 	*numTriangles = numtris ;
+	
+	Q3Memory_Free( &interestingU ) ;
+	Q3Memory_Free( &interestingV ) ;
+	Q3Memory_Free( &uParams ) ;
+	Q3Memory_Free( &vParams ) ;
+	Q3Memory_Free( &uBases ) ;
+	Q3Memory_Free( &rowPoints ) ;
+	Q3Memory_Free( &rowDerivs ) ;
+	return ;
+	
+   nurbpatch_constant_subdiv_error_handler:
+	Q3Memory_Free( &interestingU ) ;
+	Q3Memory_Free( &interestingV ) ;
+	Q3Memory_Free( &uParams ) ;
+	Q3Memory_Free( &vParams ) ;
+	Q3Memory_Free( &uBases ) ;
+	Q3Memory_Free( &rowPoints ) ;
+	Q3Memory_Free( &rowDerivs ) ;
+	
+	Q3Memory_Free( thePoints ) ;
+	Q3Memory_Free( theNormals ) ;
+	Q3Memory_Free( theUVs ) ;
+	Q3Memory_Free( theTriangles ) ;
 }
 
 
@@ -1171,31 +1430,19 @@ e3geom_nurbpatch_cache_new(TQ3ViewObject theView, TQ3GeometryObject theGeom,
 	TQ3TriMeshAttributeData	vertexAttributes[2];
 	float					subdivU = 10.0f, subdivV = 10.0f;
 	TQ3Uns32				numpoints = 0, numtriangles = 0;
-	float					*uBasisValues, *vBasisValues, *uBasisDerivValues, *vBasisDerivValues ;
 	
 	theGroup = nullptr;
 	points = nullptr ;
 	normals = nullptr ;
 	uvs = nullptr ;
 	triangles = nullptr ;
-	uBasisValues = vBasisValues = uBasisDerivValues = vBasisDerivValues = nullptr ;
 	
 	// Set nullptr initially so that return value is nullptr if we goto the error label
 	Q3Memory_Clear(&triMeshData, sizeof(triMeshData));
 	theTriMesh = nullptr;
 	
-	uBasisValues = (float*) Q3Memory_Allocate( static_cast<TQ3Uns32>(geomData->numColumns * sizeof(float)) ) ;
-	if( uBasisValues == nullptr )
-		goto surface_cache_new_error_cleanup ;
-	vBasisValues = (float*) Q3Memory_Allocate( static_cast<TQ3Uns32>(geomData->numRows * sizeof(float)) ) ;
-	if( vBasisValues == nullptr )
-		goto surface_cache_new_error_cleanup ;
-	
-	uBasisDerivValues = (float*) Q3Memory_Allocate( static_cast<TQ3Uns32>(geomData->numColumns * sizeof(float)) ) ;
-	if( uBasisDerivValues == nullptr )
-		goto surface_cache_new_error_cleanup ;
-	vBasisDerivValues = (float*) Q3Memory_Allocate( static_cast<TQ3Uns32>(geomData->numRows * sizeof(float)) ) ;
-	if( vBasisDerivValues == nullptr )
+	// The basis evaluation has room for orders up to the maximum
+	if (geomData->uOrder > kQ3NURBPatchMaxOrder || geomData->vOrder > kQ3NURBPatchMaxOrder)
 		goto surface_cache_new_error_cleanup ;
 	
 	// Get the subdivision style, figure out how to tessellate.
@@ -1205,11 +1452,10 @@ e3geom_nurbpatch_cache_new(TQ3ViewObject theView, TQ3GeometryObject theGeom,
 
 		switch (subdivisionData.method) {
 			case kQ3SubdivisionMethodScreenSpace:
-				e3geom_nurbpatch_worldscreen_subdiv( &points, &numpoints, &uvs, &normals,
-												  	 &triangles, &numtriangles,
-												  	 subdivU,
-												  	 geomData, theView, kQ3True,
-												  	 uBasisValues, vBasisValues, uBasisDerivValues, vBasisDerivValues ) ;
+				e3geom_nurbpatch_adaptive_subdiv( &points, &numpoints, &uvs, &normals,
+												  &triangles, &numtriangles,
+												  subdivU,
+												  geomData, theView, kQ3True ) ;
 
 				if( points == nullptr )
 					goto surface_cache_new_error_cleanup ;
@@ -1217,11 +1463,10 @@ e3geom_nurbpatch_cache_new(TQ3ViewObject theView, TQ3GeometryObject theGeom,
 				break;
 
 			case kQ3SubdivisionMethodWorldSpace:
-				e3geom_nurbpatch_worldscreen_subdiv( &points, &numpoints, &uvs, &normals,
-												  	 &triangles, &numtriangles,
-												  	 subdivU,
-												  	 geomData, theView, kQ3False,
-												  	 uBasisValues, vBasisValues, uBasisDerivValues, vBasisDerivValues ) ;
+				e3geom_nurbpatch_adaptive_subdiv( &points, &numpoints, &uvs, &normals,
+												  &triangles, &numtriangles,
+												  subdivU,
+												  geomData, theView, kQ3False ) ;
 
 				if( points == nullptr )
 					goto surface_cache_new_error_cleanup ;
@@ -1232,8 +1477,7 @@ e3geom_nurbpatch_cache_new(TQ3ViewObject theView, TQ3GeometryObject theGeom,
 				e3geom_nurbpatch_constant_subdiv( &points, &numpoints, &uvs, &normals,
 												  &triangles, &numtriangles,
 												  subdivU, subdivV,
-												  geomData,
-												  uBasisValues, vBasisValues, uBasisDerivValues, vBasisDerivValues ) ;
+												  geomData ) ;
 				
 				if( points == nullptr )
 					goto surface_cache_new_error_cleanup ;
@@ -1297,11 +1541,6 @@ surface_cache_new_error_cleanup:
 	Q3Memory_Free(&uvs);
 	Q3Memory_Free(&triangles);
 	
-	Q3Memory_Free(&uBasisValues);
-	Q3Memory_Free(&vBasisValues);
-	Q3Memory_Free(&uBasisDerivValues);
-	Q3Memory_Free(&vBasisDerivValues);
-	
 	return(theGroup);
 }
 
@@ -0,0 +1,320 @@
+/*  NAME:
+        E3GeometryNURBSBasis.cpp
+
+    DESCRIPTION:
+        Evaluating B-spline basis functions for NURB curves and patches.
+
+    COPYRIGHT:
+        Copyright (c) 2025, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "E3Prefix.h"
+#include "E3GeometryNURBSBasis.h"
+#include "E3SIMD.h"
+
+
+
+
+
+//=============================================================================
+//      Internal functions
+//-----------------------------------------------------------------------------
+//      e3nurbs_find_span : Find the knot span containing a parameter value.
+//-----------------------------------------------------------------------------
+//		Note :	Returns the span s with knots[s] <= u < knots[s+1], within the
+//				domain knots[order-1] .. knots[numPoints].  The end of the
+//				domain belongs to the last span that is not empty.
+//-----------------------------------------------------------------------------
+static TQ3Uns32
+e3nurbs_find_span( float u, TQ3Uns32 order, TQ3Uns32 numPoints, const float* knots )
+{	TQ3Uns32	lo = order - 1;
+	TQ3Uns32	hi = numPoints;
+	TQ3Uns32	mid;
+
+
+
+	// At or past the end, use the last span that is not empty
+	if (u >= knots[hi])
+		{
+		mid = hi - 1;
+		while (mid > lo && knots[mid] == knots[mid + 1])
+			mid--;
+		return mid;
+		}
+	
+	
+	
+	// At or before the start, use the first span that is not empty
+	if (u <= knots[lo])
+		{
+		mid = lo;
+		while (mid < hi - 1 && knots[mid] == knots[mid + 1])
+			mid++;
+		return mid;
+		}
+
+
+
+	// Otherwise binary search, keeping knots[lo] <= u < knots[hi]
+	while (hi - lo > 1)
+		{
+		mid = (lo + hi) / 2;
+		if (u < knots[mid])
+			hi = mid;
+		else
+			lo = mid;
+		}
+
+	return lo;
+}
+
+
+
+
+
+//=============================================================================
+//      e3nurbs_span_basis : Evaluate the basis functions of one span.
+//-----------------------------------------------------------------------------
+//		Note :	Fills in the order values, and derivatives if derivs is not
+//				nullptr, of the functions span-order+1 .. span.  Each pass of
+//				the triangular table raises the degree by one, reusing the
+//				lower-degree values in place (The NURBS Book, A2.2).
+//-----------------------------------------------------------------------------
+static void
+e3nurbs_span_basis( float u, TQ3Uns32 span, TQ3Uns32 order, const float* knots,
+					float* values, float* derivs )
+{	float		left[ kQ3NURBPatchMaxOrder ], right[ kQ3NURBPatchMaxOrder ];
+	float		saved, temp, fracL, fracR;
+	TQ3Uns32	degree = order - 1;
+	TQ3Uns32	j, r;
+
+
+
+	values[0] = 1.0f;
+	
+	if (derivs != nullptr && degree == 0)
+		derivs[0] = 0.0f;
+
+	for (j = 1; j <= degree; j++)
+		{
+		// Before the last pass, the values are one degree lower, which is
+		// what the derivatives of the final values are made from
+		if (derivs != nullptr && j == degree)
+			{
+			for (r = 0; r <= degree; r++)
+				{
+				fracL = (r == 0)      ? 0.0f : values[r - 1] /
+						(knots[span + r] - knots[span + r - degree]);
+				fracR = (r == degree) ? 0.0f : values[r] /
+						(knots[span + r + 1] - knots[span + r + 1 - degree]);
+				derivs[r] = (float) degree * (fracL - fracR);
+				}
+			}
+
+		left[j]  = u - knots[span + 1 - j];
+		right[j] = knots[span + j] - u;
+		saved    = 0.0f;
+
+		for (r = 0; r < j; r++)
+			{
+			temp      = values[r] / (right[r + 1] + left[j - r]);
+			values[r] = saved + right[r + 1] * temp;
+			saved     = left[j - r] * temp;
+			}
+
+		values[j] = saved;
+		}
+}
+
+
+
+
+
+//=============================================================================
+//      Public functions
+//-----------------------------------------------------------------------------
+//      E3NURBS_EvaluateBasis : Evaluate the nonzero basis functions.
+//-----------------------------------------------------------------------------
+void
+E3NURBS_EvaluateBasis( float inU, TQ3Uns32 inOrder, TQ3Uns32 inNumPoints,
+						const float* inKnots, TQ3Boolean inWantDerivs,
+						TE3NURBSBasis* outBasis )
+{	float		leftValues[ kQ3NURBPatchMaxOrder ], leftDerivs[ kQ3NURBPatchMaxOrder ];
+	TQ3Uns32	span, leftSpan, shift, n;
+
+
+
+	// Validate our parameters
+	Q3_ASSERT(inOrder >= 1 && inOrder <= kQ3NURBPatchMaxOrder);
+	Q3_ASSERT(inNumPoints >= inOrder);
+
+
+
+	// Keep to the domain, and find the span
+	inU  = E3Num_Clamp( inU, inKnots[ inOrder - 1 ], inKnots[ inNumPoints ] );
+	span = e3nurbs_find_span( inU, inOrder, inNumPoints, inKnots );
+
+	outBasis->first = span - (inOrder - 1);
+	outBasis->count = inOrder;
+	e3nurbs_span_basis( inU, span, inOrder, inKnots, outBasis->values,
+						inWantDerivs ? outBasis->derivs : nullptr );
+
+
+
+	// At a knot inside the domain, average with the span that ends there
+	if (inU != inKnots[ span ] || span == inOrder - 1)
+		return;
+	
+	leftSpan = span - 1;
+	while (leftSpan > inOrder - 1 && inKnots[ leftSpan ] == inKnots[ leftSpan + 1 ])
+		leftSpan--;
+	
+	shift = span - leftSpan;
+	if (inKnots[ leftSpan ] == inKnots[ leftSpan + 1 ] || shift > inOrder)
+		return;
+	
+	e3nurbs_span_basis( inU, leftSpan, inOrder, inKnots, leftValues,
+						inWantDerivs ? leftDerivs : nullptr );
+
+	for (n = inOrder; n-- > 0; )
+		outBasis->values[ n + shift ] = 0.5f * outBasis->values[ n ];
+	for (n = 0; n < shift; n++)
+		outBasis->values[ n ] = 0.0f;
+	for (n = 0; n < inOrder; n++)
+		outBasis->values[ n ] += 0.5f * leftValues[ n ];
+
+	if (inWantDerivs)
+		{
+		for (n = inOrder; n-- > 0; )
+			outBasis->derivs[ n + shift ] = 0.5f * outBasis->derivs[ n ];
+		for (n = 0; n < shift; n++)
+			outBasis->derivs[ n ] = 0.0f;
+		for (n = 0; n < inOrder; n++)
+			outBasis->derivs[ n ] += 0.5f * leftDerivs[ n ];
+		}
+
+	outBasis->first = leftSpan - (inOrder - 1);
+	outBasis->count = inOrder + shift;
+}
+
+
+
+
+
+//=============================================================================
+//      E3NURBS_CombinePoints : Sum control points weighted by a basis.
+//-----------------------------------------------------------------------------
+void
+E3NURBS_CombinePoints( const TE3NURBSBasis* inBasis,
+						const TQ3RationalPoint4D* inPoints, TQ3Uns32 inStride,
+						TQ3RationalPoint4D* outPoint, TQ3RationalPoint4D* outDeriv )
+{	E3Float4					theSum   = E3Float4_Splat( 0.0f );
+	E3Float4					theDeriv = E3Float4_Splat( 0.0f );
+	E3Float4					thePoint;
+	const TQ3RationalPoint4D	*pointPtr = inPoints + inBasis->first * inStride;
+	TQ3Uns32					n;
+
+
+
+	for (n = 0; n < inBasis->count; n++, pointPtr += inStride)
+		{
+		thePoint = E3Float4_Load( &pointPtr->x );
+		theSum   = E3Float4_Add( theSum,
+					E3Float4_Mul( E3Float4_Splat( inBasis->values[n] ), thePoint ) );
+		
+		if (outDeriv != nullptr)
+			theDeriv = E3Float4_Add( theDeriv,
+					E3Float4_Mul( E3Float4_Splat( inBasis->derivs[n] ), thePoint ) );
+		}
+
+	E3Float4_Store( &outPoint->x, theSum );
+	
+	if (outDeriv != nullptr)
+		E3Float4_Store( &outDeriv->x, theDeriv );
+}
+
+
+
+
+
+//=============================================================================
+//      E3NURBS_CombineRows : Sum rows of a control net weighted by a basis.
+//-----------------------------------------------------------------------------
+void
+E3NURBS_CombineRows( const TE3NURBSBasis* inBasis, TQ3Uns32 inNumColumns,
+						const TQ3RationalPoint4D* inPoints,
+						TQ3RationalPoint4D* outPoints, TQ3RationalPoint4D* outDerivs )
+{	E3Float4					theValues[ kE3NURBSBasisMaxCount ];
+	E3Float4					theDerivs[ kE3NURBSBasisMaxCount ];
+	E3Float4					theSum, theDeriv, thePoint;
+	const TQ3RationalPoint4D	*rowPtr = inPoints + inBasis->first * inNumColumns;
+	TQ3Uns32					n, col;
+
+
+
+	// Splat the weights once, rather than once per column
+	for (n = 0; n < inBasis->count; n++)
+		{
+		theValues[n] = E3Float4_Splat( inBasis->values[n] );
+		if (outDerivs != nullptr)
+			theDerivs[n] = E3Float4_Splat( inBasis->derivs[n] );
+		}
+
+
+
+	// Each column is a combination down the rows
+	for (col = 0; col < inNumColumns; col++)
+		{
+		theSum   = E3Float4_Splat( 0.0f );
+		theDeriv = E3Float4_Splat( 0.0f );
+
+		for (n = 0; n < inBasis->count; n++)
+			{
+			thePoint = E3Float4_Load( &rowPtr[ n * inNumColumns + col ].x );
+			theSum   = E3Float4_Add( theSum, E3Float4_Mul( theValues[n], thePoint ) );
+			
+			if (outDerivs != nullptr)
+				theDeriv = E3Float4_Add( theDeriv, E3Float4_Mul( theDerivs[n], thePoint ) );
+			}
+
+		E3Float4_Store( &outPoints[col].x, theSum );
+		
+		if (outDerivs != nullptr)
+			E3Float4_Store( &outDerivs[col].x, theDeriv );
+		}
+}
@@ -0,0 +1,171 @@
+/*  NAME:
+        E3GeometryNURBSBasis.h
+
+    DESCRIPTION:
+        Header file for E3GeometryNURBSBasis.cpp.
+
+    COPYRIGHT:
+        Copyright (c) 2025, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+#ifndef E3GEOMETRY_NURBSBASIS_HDR
+#define E3GEOMETRY_NURBSBASIS_HDR
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "E3Prefix.h"
+
+
+
+
+
+//=============================================================================
+//      Constants
+//-----------------------------------------------------------------------------
+// Most basis functions that can be nonzero at one parameter value. A knot
+// inside the domain belongs to the spans on both sides of it.
+const TQ3Uns32 kE3NURBSBasisMaxCount = 2 * kQ3NURBPatchMaxOrder;
+
+
+
+
+
+//=============================================================================
+//      Types
+//-----------------------------------------------------------------------------
+/*!
+	@struct		TE3NURBSBasis
+	
+	@abstract	The B-spline basis functions of one order that are nonzero
+				at one parameter value.
+	
+	@discussion	Value n belongs to control point first + n.  At a knot inside
+				the domain the basis is the average of the two spans that
+				meet there, as the recursive definition with closed intervals
+				gives; the values are then continuous across the knot and the
+				derivatives are the mean of the two one-sided derivatives.
+	
+	@field		first		Index of the first control point with a nonzero
+							value.
+	@field		count		Number of values.
+	@field		values		Basis function values.
+	@field		derivs		First derivatives of the basis functions, if
+							they were requested.
+*/
+typedef struct TE3NURBSBasis {
+	TQ3Uns32			first;
+	TQ3Uns32			count;
+	float				values[ kE3NURBSBasisMaxCount ];
+	float				derivs[ kE3NURBSBasisMaxCount ];
+} TE3NURBSBasis;
+
+
+
+
+
+//=============================================================================
+//      Function prototypes
+//-----------------------------------------------------------------------------
+/*!
+	@function	E3NURBS_EvaluateBasis
+	
+	@abstract	Evaluate the nonzero basis functions at a parameter value.
+	
+	@discussion	Only the order functions of the knot span containing inU are
+				computed, with the triangular table of de Boor and Cox,
+				rather than every function by recursion.  Parameter values
+				outside the domain are moved to its nearest end.
+	
+	@param		inU				Parameter value.
+	@param		inOrder			Order of the basis, at most
+								kQ3NURBPatchMaxOrder.
+	@param		inNumPoints		Number of control points.
+	@param		inKnots			inNumPoints + inOrder knots, nondecreasing.
+	@param		inWantDerivs	Whether to compute derivatives too.
+	@param		outBasis		Receives the basis.
+*/
+void	E3NURBS_EvaluateBasis( float inU,
+								TQ3Uns32 inOrder,
+								TQ3Uns32 inNumPoints,
+								const float* inKnots,
+								TQ3Boolean inWantDerivs,
+								TE3NURBSBasis* outBasis );
+
+
+/*!
+	@function	E3NURBS_CombinePoints
+	
+	@abstract	Sum control points weighted by a basis.
+	
+	@param		inBasis			A basis.
+	@param		inPoints		Control points, indexed as the basis is.
+	@param		inStride		Distance in points between one control point
+								and the next.
+	@param		outPoint		Receives the sum weighted by the values.
+	@param		outDeriv		Receives the sum weighted by the
+								derivatives, or nullptr.
+*/
+void	E3NURBS_CombinePoints( const TE3NURBSBasis* inBasis,
+								const TQ3RationalPoint4D* inPoints,
+								TQ3Uns32 inStride,
+								TQ3RationalPoint4D* outPoint,
+								TQ3RationalPoint4D* outDeriv );
+
+
+/*!
+	@function	E3NURBS_CombineRows
+	
+	@abstract	Sum rows of a control net weighted by a basis.
+	
+	@discussion	This reduces a patch to the curve along a line of constant
+				v, so each point on the line costs one more combination of
+				order control points rather than of the whole net.  The
+				rows are processed with SIMD where available.
+	
+	@param		inBasis			A basis in v.
+	@param		inNumColumns	Number of control points in each row.
+	@param		inPoints		Control points, row after row.
+	@param		outPoints		Receives inNumColumns sums weighted by the
+								values.
+	@param		outDerivs		Receives inNumColumns sums weighted by the
+								derivatives, or nullptr.
+*/
+void	E3NURBS_CombineRows( const TE3NURBSBasis* inBasis,
+								TQ3Uns32 inNumColumns,
+								const TQ3RationalPoint4D* inPoints,
+								TQ3RationalPoint4D* outPoints,
+								TQ3RationalPoint4D* outDerivs );
+
+#endif
@@ -700,6 +700,7 @@ e3geom_pixmapmarker_pick(TQ3ViewObject theView, TQ3ObjectType objectType, TQ3Obj
 			break;
 
 		case kQ3PickTypeWorldRay:
+		case kQ3PickTypeWorldRayBatch:
 			// Can't be picked, but don't stop picking
 			qd3dStatus = kQ3Success;
 			break;
@@ -296,6 +296,11 @@ e3geom_point_pick(TQ3ViewObject theView, TQ3ObjectType objectType, TQ3Object the
 			qd3dStatus = e3geom_point_pick_world_ray(theView, thePick, theObject, objectData);
 			break;
 
+		case kQ3PickTypeWorldRayBatch:
+			// Only surfaces are picked by a batch of rays
+			qd3dStatus = kQ3Success;
+			break;
+
 		default:
 			qd3dStatus = kQ3Failure;
 			break;
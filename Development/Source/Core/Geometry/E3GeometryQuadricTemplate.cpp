@@ -0,0 +1,218 @@
+/*  NAME:
+        E3GeometryQuadricTemplate.cpp
+
+    DESCRIPTION:
+        Unit-space tessellations shared by quadric primitives.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "E3Prefix.h"
+#include "E3GeometryQuadricTemplate.h"
+#include "E3Math.h"
+
+#include <map>
+#include <new>
+#include <tuple>
+
+
+
+
+
+//=============================================================================
+//      Internal constants
+//-----------------------------------------------------------------------------
+// Total points the cache may hold before it is emptied
+const TQ3Uns32 kQuadricTemplateMaxPoints = 256 * 1024;
+
+
+
+
+
+//=============================================================================
+//      Internal types
+//-----------------------------------------------------------------------------
+struct E3QuadricTemplateKeyLess
+{
+	bool	operator()( const TE3QuadricTemplateKey& a,
+						const TE3QuadricTemplateKey& b ) const
+			{
+				return std::tie( a.kind, a.uSegments, a.vSegments, a.uMin, a.uMax,
+								a.vMin, a.vMax, a.flags ) <
+					std::tie( b.kind, b.uSegments, b.vSegments, b.uMin, b.uMax,
+								b.vMin, b.vMax, b.flags );
+			}
+};
+
+typedef std::map< TE3QuadricTemplateKey, TE3QuadricTemplate,
+		E3QuadricTemplateKeyLess >	E3QuadricTemplateMap;
+
+
+
+
+
+//=============================================================================
+//      Internal globals
+//-----------------------------------------------------------------------------
+static E3QuadricTemplateMap	sTemplates;
+static TQ3Uns32				sTemplatePoints = 0;
+
+
+
+
+
+//=============================================================================
+//      Public functions
+//-----------------------------------------------------------------------------
+//      E3QuadricTemplate_Get : Find or build the template for a key.
+//-----------------------------------------------------------------------------
+const TE3QuadricTemplate*
+E3QuadricTemplate_Get( const TE3QuadricTemplateKey& inKey,
+						TE3QuadricTemplateBuilder inBuilder )
+{
+	E3QuadricTemplateMap::iterator	found = sTemplates.find( inKey );
+	if (found != sTemplates.end())
+		return &found->second;
+
+
+
+	// Build the template, and keep it unless it would overflow the cache
+	try
+	{
+		TE3QuadricTemplate	theTemplate;
+		inBuilder( inKey, theTemplate );
+		
+		TQ3Uns32 numPoints = static_cast<TQ3Uns32>( theTemplate.points.size() );
+		if (sTemplatePoints + numPoints > kQuadricTemplateMaxPoints)
+		{
+			sTemplates.clear();
+			sTemplatePoints = 0;
+		}
+		
+		found = sTemplates.insert( std::make_pair( inKey, TE3QuadricTemplate() ) ).first;
+		found->second.points.swap( theTemplate.points );
+		found->second.normals.swap( theTemplate.normals );
+		found->second.uvs.swap( theTemplate.uvs );
+		found->second.triangles.swap( theTemplate.triangles );
+		sTemplatePoints += numPoints;
+	}
+	catch (const std::bad_alloc&)
+	{
+		E3ErrorManager_PostError( kQ3ErrorOutOfMemory, kQ3False );
+		return nullptr;
+	}
+	
+	return &found->second;
+}
+
+
+
+
+
+//=============================================================================
+//      E3QuadricTemplate_Instantiate : Map a template into a primitive.
+//-----------------------------------------------------------------------------
+//		Note :	The inverse transpose of the axis matrix is its cofactor
+//				matrix divided by the determinant.  Normals are normalized
+//				afterwards, so the cofactors are enough, and they keep their
+//				sign only for a right-handed frame.
+//-----------------------------------------------------------------------------
+void
+E3QuadricTemplate_Instantiate( const TE3QuadricTemplate& inTemplate,
+								const TQ3Point3D& inOrigin,
+								const TQ3Vector3D& inXAxis,
+								const TQ3Vector3D& inYAxis,
+								const TQ3Vector3D& inZAxis,
+								TQ3Boolean inKeepOutward,
+								TQ3Point3D* outPoints,
+								TQ3Vector3D* outNormals )
+{	TQ3Matrix4x4	pointMatrix, normalMatrix;
+	TQ3Vector3D		yCrossZ, zCrossX, xCrossY;
+	TQ3Uns32		numPoints = static_cast<TQ3Uns32>( inTemplate.points.size() );
+	TQ3Uns32		n;
+	float			theSign;
+
+
+
+	// Points: x, y and z go to the axes, and the origin to inOrigin
+	E3Matrix4x4_SetIdentity( &pointMatrix );
+	pointMatrix.value[0][0] = inXAxis.x;
+	pointMatrix.value[0][1] = inXAxis.y;
+	pointMatrix.value[0][2] = inXAxis.z;
+	pointMatrix.value[1][0] = inYAxis.x;
+	pointMatrix.value[1][1] = inYAxis.y;
+	pointMatrix.value[1][2] = inYAxis.z;
+	pointMatrix.value[2][0] = inZAxis.x;
+	pointMatrix.value[2][1] = inZAxis.y;
+	pointMatrix.value[2][2] = inZAxis.z;
+	pointMatrix.value[3][0] = inOrigin.x;
+	pointMatrix.value[3][1] = inOrigin.y;
+	pointMatrix.value[3][2] = inOrigin.z;
+
+	E3Point3D_To3DTransformArray( inTemplate.points.data(), &pointMatrix, outPoints,
+		numPoints, sizeof(TQ3Point3D), sizeof(TQ3Point3D) );
+
+
+
+	// Normals: the cofactor matrix, negated for a left-handed frame if asked
+	Q3FastVector3D_Cross( &inYAxis, &inZAxis, &yCrossZ );
+	Q3FastVector3D_Cross( &inZAxis, &inXAxis, &zCrossX );
+	Q3FastVector3D_Cross( &inXAxis, &inYAxis, &xCrossY );
+	
+	theSign = 1.0f;
+	if (inKeepOutward == kQ3True && Q3FastVector3D_Dot( &xCrossY, &inZAxis ) < 0.0f)
+		theSign = -1.0f;
+
+	E3Matrix4x4_SetIdentity( &normalMatrix );
+	normalMatrix.value[0][0] = theSign * yCrossZ.x;
+	normalMatrix.value[0][1] = theSign * yCrossZ.y;
+	normalMatrix.value[0][2] = theSign * yCrossZ.z;
+	normalMatrix.value[1][0] = theSign * zCrossX.x;
+	normalMatrix.value[1][1] = theSign * zCrossX.y;
+	normalMatrix.value[1][2] = theSign * zCrossX.z;
+	normalMatrix.value[2][0] = theSign * xCrossY.x;
+	normalMatrix.value[2][1] = theSign * xCrossY.y;
+	normalMatrix.value[2][2] = theSign * xCrossY.z;
+
+	E3Vector3D_To3DTransformArray( inTemplate.normals.data(), &normalMatrix, outNormals,
+		numPoints, sizeof(TQ3Vector3D), sizeof(TQ3Vector3D) );
+
+	for (n = 0; n < numPoints; ++n)
+		Q3FastVector3D_Normalize( &outNormals[n], &outNormals[n] );
+}
@@ -0,0 +1,167 @@
+/*  NAME:
+        E3GeometryQuadricTemplate.h
+
+    DESCRIPTION:
+        Header file for E3GeometryQuadricTemplate.cpp.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+#ifndef E3GEOMETRY_QUADRICTEMPLATE_HDR
+#define E3GEOMETRY_QUADRICTEMPLATE_HDR
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "E3Prefix.h"
+
+#include <vector>
+
+
+
+
+
+//=============================================================================
+//      Types
+//-----------------------------------------------------------------------------
+// Primitives with templates
+typedef enum TE3QuadricKind {
+	kE3QuadricEllipsoid									= 0,
+	kE3QuadricCone										= 1,
+	kE3QuadricCylinder									= 2,
+	kE3QuadricDisk										= 3
+} TE3QuadricKind;
+
+
+/*!
+	@struct		TE3QuadricTemplateKey
+	
+	@abstract	Everything that decides the shape of a template.
+	
+	@discussion	The meaning of the segment counts and flags is up to the
+				primitive.  The parameter ranges are compared exactly, as
+				the primitive passes them to its builder.
+*/
+typedef struct TE3QuadricTemplateKey {
+	TE3QuadricKind			kind;
+	TQ3Uns32				uSegments;
+	TQ3Uns32				vSegments;
+	float					uMin;
+	float					uMax;
+	float					vMin;
+	float					vMax;
+	TQ3Uns32				flags;
+} TE3QuadricTemplateKey;
+
+
+/*!
+	@struct		TE3QuadricTemplate
+	
+	@abstract	A tessellation of a primitive in its unit frame.
+	
+	@discussion	The unit frame has the origin at (0, 0, 0) and the axes of
+				the primitive along x, y and z: majorRadius, minorRadius
+				and orientation for the quadrics.  Each instance is then an
+				affine image of the template, and shares its UVs and
+				triangles.  The normals need not have unit length.
+*/
+typedef struct TE3QuadricTemplate {
+	std::vector<TQ3Point3D>					points;
+	std::vector<TQ3Vector3D>				normals;
+	std::vector<TQ3Param2D>					uvs;
+	std::vector<TQ3TriMeshTriangleData>		triangles;
+} TE3QuadricTemplate;
+
+
+// Fills in a template for a key
+typedef void (*TE3QuadricTemplateBuilder)( const TE3QuadricTemplateKey& inKey,
+											TE3QuadricTemplate& outTemplate );
+
+
+
+
+
+//=============================================================================
+//      Function prototypes
+//-----------------------------------------------------------------------------
+/*!
+	@function	E3QuadricTemplate_Get
+	
+	@abstract	Find the template for a key, building it if need be.
+	
+	@discussion	The template remains valid until the next call.  Templates
+				are kept until the cache grows too large, so objects with
+				the same subdivision and parameter ranges pay for their
+				trigonometry once.
+	
+	@param		inKey			The key.
+	@param		inBuilder		Builds the template if it is not cached.
+	@result		The template, or nullptr if memory ran out.
+*/
+const TE3QuadricTemplate*	E3QuadricTemplate_Get( const TE3QuadricTemplateKey& inKey,
+											TE3QuadricTemplateBuilder inBuilder );
+
+
+/*!
+	@function	E3QuadricTemplate_Instantiate
+	
+	@abstract	Map the points and normals of a template into a primitive.
+	
+	@discussion	Points are transformed by the affine map with the given
+				origin and axes, and normals by its inverse transpose, and
+				then normalized.  With inKeepOutward, normals are negated
+				when the axes form a left-handed system, so that they still
+				point away from the surface the way the template's do.
+	
+	@param		inTemplate		A template.
+	@param		inOrigin		Image of (0, 0, 0).
+	@param		inXAxis			Image of the x axis.
+	@param		inYAxis			Image of the y axis.
+	@param		inZAxis			Image of the z axis.
+	@param		inKeepOutward	Whether to correct the normals of a
+								left-handed frame.
+	@param		outPoints		Receives the template's number of points.
+	@param		outNormals		Receives the template's number of normals.
+*/
+void	E3QuadricTemplate_Instantiate( const TE3QuadricTemplate& inTemplate,
+										const TQ3Point3D& inOrigin,
+										const TQ3Vector3D& inXAxis,
+										const TQ3Vector3D& inYAxis,
+										const TQ3Vector3D& inZAxis,
+										TQ3Boolean inKeepOutward,
+										TQ3Point3D* outPoints,
+										TQ3Vector3D* outNormals );
+
+#endif
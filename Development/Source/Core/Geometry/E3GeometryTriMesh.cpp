@@ -44,6 +44,7 @@
 //      Include files
 //-----------------------------------------------------------------------------
 #include "E3Prefix.h"
+#include "E3BoundingTree.h"
 #include "E3Camera.h"
 #include "E3FastArray.h"
 #include "E3View.h"
@@ -53,10 +54,13 @@
 #include "E3Math_Intersect.h"
 #include "E3Geometry.h"
 #include "E3GeometryTriMesh.h"
+#include "E3GeometryTriMeshNormals.h"
 #include "E3ErrorManager.h"
 #include "QuesaMathOperators.hpp"
 
+#include <chrono>
 #include <cstring>
+#include <memory>
 #include <utility>
 
 
@@ -69,6 +73,9 @@ const TQ3Uns32 kTriMeshNone											= 0;
 const TQ3Uns32 kTriMeshLocked										= (1 << 0);
 const TQ3Uns32 kTriMeshLockedReadOnly								= (1 << 1);
 
+// TriMeshes with fewer triangles are picked without a pick tree
+const TQ3Uns32 kTriMeshPickTreeMinTriangles							= 64;
+
 
 
 
@@ -76,11 +83,21 @@ const TQ3Uns32 kTriMeshLockedReadOnly								= (1 << 1);
 //=============================================================================
 //      Internal types
 //-----------------------------------------------------------------------------
+// TriMesh pick tree, over the triangles in local coordinates
+struct TQ3TriMeshPickTree
+{
+	E3BoundingTree		tree;
+	TQ3Uns32			editIndex;
+	float				buildTime;
+};
+
+
 // TriMesh instance data
 typedef struct {
 	TQ3Uns32			theFlags;
 	TQ3Uns32			lockCount;
 	TQ3TriMeshData		geomData;
+	TQ3TriMeshPickTree	*pickTree;
 } TQ3TriMeshInstanceData;
 
 
@@ -630,6 +647,90 @@ e3geom_trimesh_validate( TQ3TriMeshData *theTriMesh )
 }
 
 
+//=============================================================================
+//      e3geom_nakedtrimesh_dispose_pick_tree : Dispose of a pick tree.
+//-----------------------------------------------------------------------------
+static void
+e3geom_nakedtrimesh_dispose_pick_tree(TQ3TriMeshInstanceData *instanceData)
+{
+	delete instanceData->pickTree;
+	instanceData->pickTree = nullptr;
+}
+
+
+
+
+
+//=============================================================================
+//      e3geom_nakedtrimesh_get_pick_tree : Get an up to date pick tree.
+//-----------------------------------------------------------------------------
+//		Note :	The tree is rebuilt if the TriMesh has been edited since it
+//				was built.  While the TriMesh is locked for writing its data
+//				may be changing, so we return nullptr and it is picked
+//				without a tree.
+//-----------------------------------------------------------------------------
+static const TQ3TriMeshPickTree *
+e3geom_nakedtrimesh_get_pick_tree(E3NakedTriMesh *nakedTriMesh)
+{	TQ3TriMeshInstanceData		*instanceData = &nakedTriMesh->instanceData;
+	const TQ3TriMeshData		*geomData     = &instanceData->geomData;
+	TQ3Uns32					n;
+
+
+
+	// Use the tree we have if it is current
+	if ( (instanceData->lockCount != 0) &&
+		! E3Bit_IsSet( instanceData->theFlags, kTriMeshLockedReadOnly ) )
+		return(nullptr);
+
+	TQ3Uns32 editIndex = nakedTriMesh->GetEditIndex();
+	if (instanceData->pickTree != nullptr && instanceData->pickTree->editIndex == editIndex)
+		return(instanceData->pickTree);
+
+
+
+	// Build it from the bounds of the triangles
+	e3geom_nakedtrimesh_dispose_pick_tree( instanceData );
+	try
+	{
+		auto startTime = std::chrono::steady_clock::now();
+		std::unique_ptr<TQ3TriMeshPickTree> theTree( new TQ3TriMeshPickTree );
+		std::vector<TQ3BoundingBox> triBounds( geomData->numTriangles );
+
+		for (n = 0; n < geomData->numTriangles; ++n)
+		{
+			const TQ3Uns32* theIndices = geomData->triangles[n].pointIndices;
+			const TQ3Point3D& p0( geomData->points[ theIndices[0] ] );
+			const TQ3Point3D& p1( geomData->points[ theIndices[1] ] );
+			const TQ3Point3D& p2( geomData->points[ theIndices[2] ] );
+			
+			triBounds[n].min.x = std::min( p0.x, std::min( p1.x, p2.x ) );
+			triBounds[n].min.y = std::min( p0.y, std::min( p1.y, p2.y ) );
+			triBounds[n].min.z = std::min( p0.z, std::min( p1.z, p2.z ) );
+			triBounds[n].max.x = std::max( p0.x, std::max( p1.x, p2.x ) );
+			triBounds[n].max.y = std::max( p0.y, std::max( p1.y, p2.y ) );
+			triBounds[n].max.z = std::max( p0.z, std::max( p1.z, p2.z ) );
+			triBounds[n].isEmpty = kQ3False;
+		}
+
+		theTree->tree.Build( geomData->numTriangles, triBounds.data() );
+		theTree->editIndex = editIndex;
+		theTree->buildTime = std::chrono::duration<float>(
+			std::chrono::steady_clock::now() - startTime ).count();
+		
+		instanceData->pickTree = theTree.release();
+	}
+	catch (...)
+	{
+		E3ErrorManager_PostError( kQ3ErrorOutOfMemory, kQ3False );
+	}
+
+	return(instanceData->pickTree);
+}
+
+
+
+
+
 //=============================================================================
 //      e3geom_nakedtrimesh_new : TriMesh new method.
 //-----------------------------------------------------------------------------
@@ -644,6 +745,7 @@ e3geom_nakedtrimesh_new(TQ3Object theObject, void *privateData, const void *para
 
 	// Initialise the TriMesh, then optimise it
 	instanceData->theFlags = kTriMeshNone;
+	instanceData->pickTree = nullptr;
 	qd3dStatus = e3geom_nakedtrimesh_copydata( trimeshData, &instanceData->geomData );
 
 	if (qd3dStatus == kQ3Success)
@@ -698,6 +800,7 @@ e3geom_nakedtrimesh_new_nocopy(TQ3Object theObject, void *privateData, const voi
 
 	// Initialise the TriMesh, then optimise it
 	instanceData->theFlags = kTriMeshNone;
+	instanceData->pickTree = nullptr;
 
 	Q3Memory_Copy( trimeshData, &instanceData->geomData, sizeof(TQ3TriMeshData) );
 
@@ -750,6 +853,7 @@ e3geom_nakedtrimesh_delete(TQ3Object theObject, void *privateData)
 
 	// Dispose of our instance data
 	e3geom_trimesh_disposedata(&instanceData->geomData);
+	e3geom_nakedtrimesh_dispose_pick_tree(instanceData);
 }
 
 
@@ -776,8 +880,10 @@ e3geom_nakedtrimesh_duplicate(TQ3Object fromObject, const void *fromPrivateData,
 
 
 
-	// Initialise the instance data of the new object
+	// Initialise the instance data of the new object, which builds its own
+	// pick tree if it is picked
 	toData->theFlags = fromData->theFlags;
+	toData->pickTree = nullptr;
 	qd3dStatus       = e3geom_nakedtrimesh_copydata( &fromData->geomData, &toData->geomData );
 
 	return(qd3dStatus);
@@ -1053,24 +1159,203 @@ e3geom_trimesh_cache_new(TQ3ViewObject theView, TQ3GeometryObject theGeom,
 
 
 
+//=============================================================================
+//      e3geom_trimesh_record_hit : Record a hit on a TriMesh triangle.
+//-----------------------------------------------------------------------------
+//		Note :	For a world ray batch pick, inRayIndex is the ray which hit.
+//-----------------------------------------------------------------------------
+static TQ3Status
+e3geom_trimesh_record_hit( TQ3ViewObject			theView,
+							TQ3PickObject			thePick,
+							const TQ3TriMeshData	*geomData,
+							TQ3Uns32				inTriangle,
+							const TQ3Point3D		inWorldPoints[3],
+							TQ3Param3D				&ioHit,
+							TQ3Uns32				inRayIndex = kQ3ArrayIndexNULL )
+{	TQ3Boolean						haveUV;
+	TQ3Param2D						hitUV, *resultUV;
+	TQ3TriangleData					worldTriangle;
+	TQ3Status						qd3dStatus;
+	TQ3Vector3D						hitNormal;
+	TQ3Point3D						hitXYZ;
+
+
+
+	// Create the triangle, and update the vertices to world coordinates
+	e3geom_trimesh_triangle_new(theView, geomData, inTriangle, &worldTriangle);
+	worldTriangle.vertices[0].point = inWorldPoints[0];
+	worldTriangle.vertices[1].point = inWorldPoints[1];
+	worldTriangle.vertices[2].point = inWorldPoints[2];
+
+
+	// Obtain the XYZ, normal, and UV for the hit point. We always return an
+	// XYZ and normal for the hit, however we need to cope with missing UVs.
+	E3Triangle_InterpolateHit(theView,&worldTriangle, &ioHit,
+		&hitXYZ, &hitNormal, &hitUV, &haveUV);
+	resultUV = (haveUV ? &hitUV : nullptr);
+
+
+	// Record the hit
+	if (inRayIndex != kQ3ArrayIndexNULL)
+		qd3dStatus = E3WorldRayBatchPick_RecordHit(thePick, theView, inRayIndex,
+			&hitXYZ, &hitNormal, resultUV, &ioHit, inTriangle );
+	else
+		qd3dStatus = E3Pick_RecordHit(thePick, theView, &hitXYZ, &hitNormal,
+			resultUV, nullptr, &ioHit, inTriangle );
+
+
+	// Clean up
+	e3geom_trimesh_triangle_delete(&worldTriangle);
+
+	return(qd3dStatus);
+}
+
+
+
+
+
+//=============================================================================
+//      e3geom_trimesh_pick_with_tree : TriMesh ray picking with a pick tree.
+//-----------------------------------------------------------------------------
+//		Note :	The ray is transformed into local coordinates, so only the
+//				triangles that are hit need to be transformed to world
+//				coordinates.  The local ray direction is normalized so that
+//				the near-zero tests in E3Ray3D_IntersectTriangle see the same
+//				scale as for a world ray, and hit distances are converted back
+//				to world units when the hits are recorded.
+//
+//				Back-face culling is done in local coordinates, so unlike the
+//				world space test an orientation-reversing transform needs no
+//				compensation.  Hits are recorded in triangle order, as they
+//				would be by testing every triangle.
+//
+//				If nearestOnly is set, hits beyond maxParameter along the
+//				world ray are ignored, the search is cut short at the nearest
+//				hit so far, and only the nearest hit is recorded.
+//-----------------------------------------------------------------------------
+static TQ3Status
+e3geom_trimesh_pick_with_tree( TQ3ViewObject				theView,
+								TQ3PickObject			thePick,
+								const TQ3Ray3D			*theRay,
+								const TQ3TriMeshData	*geomData,
+								const E3BoundingTree	&pickTree,
+								TQ3Boolean				cullBackface,
+								bool					nearestOnly,
+								float					maxParameter )
+{	struct TriMeshHit
+	{
+		TQ3Uns32		triangle;
+		TQ3Param3D		param;
+	};
+	std::vector<TriMeshHit>			theHits;
+	TQ3Status						qd3dStatus = kQ3Success;
+	TQ3Matrix4x4					worldToLocal;
+	TQ3Point3D						worldPoints[3];
+	TQ3Ray3D						localRay;
+	TQ3Uns32						k;
+
+
+
+	// Transform the ray to local coordinates
+	const TQ3Matrix4x4* localToWorld = E3View_State_GetMatrixLocalToWorld(theView);
+	E3Matrix4x4_Invert( localToWorld, &worldToLocal );
+
+	localRay.origin    = theRay->origin * worldToLocal;
+	localRay.direction = theRay->direction * worldToLocal;
+
+	float directionLength = Q3Length3D( localRay.direction );
+	if (directionLength < kQ3RealZero)
+		return(kQ3Success);
+
+	localRay.direction *= 1.0f / directionLength;
+
+
+
+	// Find the hits.  Distances along the local ray are directionLength
+	// times the parameter of the world ray.
+	float maxDistance = kQ3MaxFloat;
+	if (maxParameter < kQ3MaxFloat / directionLength)
+		maxDistance = maxParameter * directionLength;
+	
+	auto testTriangle = [&]( TQ3Uns32 inTriangle, float& ioMaxDistance )
+	{
+		const TQ3Uns32* theIndices = geomData->triangles[ inTriangle ].pointIndices;
+		TriMeshHit theHit;
+		
+		if (E3Ray3D_IntersectTriangle( localRay, geomData->points[ theIndices[0] ],
+			geomData->points[ theIndices[1] ], geomData->points[ theIndices[2] ],
+			cullBackface, theHit.param ))
+		{
+			theHit.triangle = inTriangle;
+			
+			if (! nearestOnly)
+				theHits.push_back( theHit );
+			else if (theHit.param.w < ioMaxDistance)
+			{
+				theHits.assign( 1, theHit );
+				ioMaxDistance = theHit.param.w;
+			}
+		}
+	};
+
+	try
+	{
+		pickTree.VisitRay( localRay, maxDistance, testTriangle );
+	}
+	catch (...)
+	{
+		return(kQ3Failure);
+	}
+
+	std::sort( theHits.begin(), theHits.end(),
+		[]( const TriMeshHit& inA, const TriMeshHit& inB ) { return inA.triangle < inB.triangle; } );
+
+
+
+	// Record them
+	for (TriMeshHit& theHit : theHits)
+	{
+		if (qd3dStatus != kQ3Success)
+			break;
+		
+		for (k = 0; k < 3; ++k)
+			worldPoints[k] =
+				geomData->points[ geomData->triangles[ theHit.triangle ].pointIndices[k] ] *
+				*localToWorld;
+		
+		theHit.param.w /= directionLength;
+
+		qd3dStatus = e3geom_trimesh_record_hit( theView, thePick, geomData,
+			theHit.triangle, worldPoints, theHit.param );
+	}
+
+	return(qd3dStatus);
+}
+
+
+
+
+
 //=============================================================================
 //      e3geom_trimesh_pick_with_ray : TriMesh ray picking method.
 //-----------------------------------------------------------------------------
+//		Note :	If nakedTriMesh is not nullptr, a large TriMesh may be picked
+//				with its pick tree.
+//-----------------------------------------------------------------------------
 static TQ3Status
 e3geom_trimesh_pick_with_ray( TQ3ViewObject				theView,
 								TQ3PickObject			thePick,
 								const TQ3Ray3D			*theRay,
-								const TQ3TriMeshData	*geomData )
+								const TQ3TriMeshData	*geomData,
+								E3NakedTriMesh			*nakedTriMesh )
 {	TQ3Uns32						n, numPoints, v0, v1, v2;
-	TQ3Boolean						haveUV, cullBackface;
-	TQ3Param2D						hitUV, *resultUV;
+	TQ3Boolean						cullBackface;
 	TQ3BackfacingStyle				backfacingStyle;
-	TQ3TriangleData					worldTriangle;
 	TQ3Point3D						*worldPoints;
 	TQ3Status						qd3dStatus;
-	TQ3Vector3D						hitNormal;
-	TQ3Point3D						hitXYZ;
-	TQ3Param3D						theHit;
+	TQ3Param3D						theHit, nearestHit;
+	TQ3Point3D						nearestPoints[3];
+	TQ3Uns32						nearestTriangle = kQ3ArrayIndexNULL;
 	TQ3BoundingBox					worldBounds;
 
 
@@ -1083,6 +1368,14 @@ e3geom_trimesh_pick_with_ray( TQ3ViewObject				theView,
 	bool useTolerance = toleranceSquared > kQ3RealZero;
 
 
+	// If the pick only keeps its nearest hit, we need only find our nearest
+	// exact hit, and only if it is nearer than any hit the pick already has
+	bool nearestOnly = (! useTolerance) && (E3Pick_IsNearestHitOnly( thePick ) == kQ3True);
+	float maxParameter = kQ3MaxFloat;
+	if (nearestOnly)
+		E3Pick_GetNearestHitLimit( thePick, theView, theRay, &maxParameter );
+
+
 	// In case we are using face tolerance, find out whether we are doing a
 	// window point pick.
 	bool isWindowPointPick = (E3Pick_GetType( thePick ) == kQ3PickTypeWindowPoint);
@@ -1171,9 +1464,41 @@ e3geom_trimesh_pick_with_ray( TQ3ViewObject				theView,
 			// The ray misses the bounds, so it misses the mesh.
 			return kQ3Success;
 		}
+		
+		float boundsEntry;
+		if ( (maxParameter < kQ3MaxFloat) && ! E3BoundingTree::RayEntersBox( worldBounds.min,
+			worldBounds.max, theRay->origin, E3BoundingTree::GetInverseDirection( theRay->direction ),
+			maxParameter, boundsEntry ) )
+		{
+			// The bounds are beyond the nearest hit so far.
+			return kQ3Success;
+		}
 	}
 
 
+	// Determine if we should cull back-facing triangles or not
+	qd3dStatus   = E3View_GetBackfacingStyleState(theView, &backfacingStyle);
+	cullBackface = (TQ3Boolean)(qd3dStatus == kQ3Success && backfacingStyle == kQ3BackfacingStyleRemove);
+
+
+
+	// Use the pick tree for exact hits on a large TriMesh, if the local to
+	// world transform is affine and invertible
+	float localToWorldDeterminant = E3Matrix4x4_Determinant( localToWorld );
+	if ( (qd3dStatus == kQ3Success) && (! useTolerance) && (nakedTriMesh != nullptr) &&
+		(geomData->numTriangles >= kTriMeshPickTreeMinTriangles) &&
+		(localToWorld->value[0][3] == 0.0f) && (localToWorld->value[1][3] == 0.0f) &&
+		(localToWorld->value[2][3] == 0.0f) && (localToWorld->value[3][3] == 1.0f) &&
+		(localToWorldDeterminant != 0.0f) )
+	{
+		const TQ3TriMeshPickTree* pickTree = e3geom_nakedtrimesh_get_pick_tree( nakedTriMesh );
+		if (pickTree != nullptr)
+			return(e3geom_trimesh_pick_with_tree( theView, thePick, theRay, geomData,
+				pickTree->tree, cullBackface, nearestOnly, maxParameter ));
+	}
+
+
+
 	// Transform our points from local to world coordinates
 	numPoints   = geomData->numPoints;
 	worldPoints = (TQ3Point3D *) Q3Memory_Allocate(static_cast<TQ3Uns32>(numPoints * sizeof(TQ3Point3D)));
@@ -1189,17 +1514,11 @@ e3geom_trimesh_pick_with_ray( TQ3ViewObject				theView,
 
 
 
-	// Determine if we should cull back-facing triangles or not
-	qd3dStatus   = E3View_GetBackfacingStyleState(theView, &backfacingStyle);
-	cullBackface = (TQ3Boolean)(qd3dStatus == kQ3Success && backfacingStyle == kQ3BackfacingStyleRemove);
-
-
-
 	// See if we fall within the pick
 	//
 	// Note we do not use any vertex/edge tolerances supplied for the pick, since
 	// QD3D's blue book appears to suggest neither are used for triangles.
-	bool isOrientationReversing = E3Matrix4x4_Determinant( localToWorld ) < 0.0f;
+	bool isOrientationReversing = localToWorldDeterminant < 0.0f;
 	for (n = 0; n < geomData->numTriangles && qd3dStatus == kQ3Success; ++n)
 	{
 		// Grab the vertex indices
@@ -1256,31 +1575,30 @@ e3geom_trimesh_pick_with_ray( TQ3ViewObject				theView,
 
 		if (didHit)
 		{
-			// Create the triangle, and update the vertices to the transformed coordinates
-			e3geom_trimesh_triangle_new(theView, geomData, n, &worldTriangle);
-			worldTriangle.vertices[0].point = p0;
-			worldTriangle.vertices[1].point = p1;
-			worldTriangle.vertices[2].point = p2;
-
-
-			// Obtain the XYZ, normal, and UV for the hit point. We always return an
-			// XYZ and normal for the hit, however we need to cope with missing UVs.
-			E3Triangle_InterpolateHit(theView,&worldTriangle, &theHit,
-				&hitXYZ, &hitNormal, &hitUV, &haveUV);
-			resultUV = (haveUV ? &hitUV : nullptr);
+			const TQ3Point3D hitPoints[3] = { p0, p1, p2 };
 
+			// Record the hit, or just remember it if it is the nearest so far
+			if (! nearestOnly)
+				qd3dStatus = e3geom_trimesh_record_hit( theView, thePick, geomData,
+					n, hitPoints, theHit );
 
-			// Record the hit
-			qd3dStatus = E3Pick_RecordHit(thePick, theView, &hitXYZ, &hitNormal,
-				resultUV, nullptr, &theHit, n );
-
-
-			// Clean up
-			e3geom_trimesh_triangle_delete(&worldTriangle);
+			else if (theHit.w < maxParameter)
+			{
+				nearestTriangle = n;
+				nearestHit      = theHit;
+				maxParameter    = theHit.w;
+				std::copy( hitPoints, hitPoints + 3, nearestPoints );
+			}
 		}
 	}
 
 
+	// Record the nearest hit
+	if ( (nearestTriangle != kQ3ArrayIndexNULL) && (qd3dStatus == kQ3Success) )
+		qd3dStatus = e3geom_trimesh_record_hit( theView, thePick, geomData,
+			nearestTriangle, nearestPoints, nearestHit );
+
+
 	// Clean up
 	Q3Memory_Free(&worldPoints);
 
@@ -1374,15 +1692,23 @@ e3geom_trimesh_find_triangle_point_in_area( const TQ3Area& inRect,
 //=============================================================================
 //      e3geom_trimesh_pick_with_rect : TriMesh rect picking method.
 //-----------------------------------------------------------------------------
+//		Note :	If nakedTriMesh is not nullptr, a large TriMesh is searched
+//				with its pick tree.  Nodes whose window area misses the rect
+//				are skipped, and a node whose window area lies inside it
+//				holds triangles which are all hit, so only triangles near the
+//				edges of the rect need to be tested.
+//-----------------------------------------------------------------------------
 static TQ3Status
 e3geom_trimesh_pick_with_rect(TQ3ViewObject				theView,
 								TQ3PickObject			thePick,
 								const TQ3Area			*theRect,
-								const TQ3TriMeshData	*geomData)
+								const TQ3TriMeshData	*geomData,
+								E3NakedTriMesh			*nakedTriMesh)
 {
 	TQ3Uns32			n, numPoints, v0, v1, v2;
-	TQ3Point2D			triVertices[3];
-	TQ3Status			qd3dStatus;
+	TQ3Uns32			hitTriangle = kQ3ArrayIndexNULL;
+	TQ3Point2D			windowHitPt;
+	TQ3Status			qd3dStatus = kQ3Success;
 
 
 
@@ -1398,45 +1724,63 @@ e3geom_trimesh_pick_with_rect(TQ3ViewObject				theView,
 
 
 
-	// See if we fall within the pick
-	qd3dStatus = kQ3Success;
-
-	for (n = 0; n < geomData->numTriangles && qd3dStatus == kQ3Success; n++)
+	// See if a triangle falls within the pick
+	auto testTriangle = [&]( TQ3Uns32 inTriangle, bool /*isInside*/ ) -> bool
 	{
 		// Grab the vertex indices
-		v0 = geomData->triangles[n].pointIndices[0];
-		v1 = geomData->triangles[n].pointIndices[1];
-		v2 = geomData->triangles[n].pointIndices[2];
+		v0 = geomData->triangles[ inTriangle ].pointIndices[0];
+		v1 = geomData->triangles[ inTriangle ].pointIndices[1];
+		v2 = geomData->triangles[ inTriangle ].pointIndices[2];
 		Q3_ASSERT(v0 >= 0 && v0 < geomData->numPoints);
 		Q3_ASSERT(v1 >= 0 && v1 < geomData->numPoints);
 		Q3_ASSERT(v2 >= 0 && v2 < geomData->numPoints);
 
-
-		// Set up the 2D component of the triangle
-		triVertices[0].x = windowPoints[v0].x;
-		triVertices[0].y = windowPoints[v0].y;
-
-		triVertices[1].x = windowPoints[v1].x;
-		triVertices[1].y = windowPoints[v1].y;
-
-		triVertices[2].x = windowPoints[v2].x;
-		triVertices[2].y = windowPoints[v2].y;
-
-
-		// See if this triangle falls within the pick
-		TQ3Point2D	windowHitPt;
 		if (e3geom_trimesh_find_triangle_point_in_area( *theRect, windowPoints[v0],
 			windowPoints[v1], windowPoints[v2], windowHitPt ))
 		{
-			TQ3Point3D		worldHitPt;
-			E3View_TransformWindowToWorld( theView, &windowHitPt, &worldHitPt );
-			qd3dStatus = E3Pick_RecordHit(thePick, theView, &worldHitPt, nullptr,
-				nullptr, nullptr, nullptr, n);
-			break;
+			hitTriangle = inTriangle;
+			return true;
+		}
+		
+		return false;
+	};
+	
+	const TQ3TriMeshPickTree* pickTree = nullptr;
+	if ( (nakedTriMesh != nullptr) && (geomData->numTriangles >= kTriMeshPickTreeMinTriangles) )
+		pickTree = e3geom_nakedtrimesh_get_pick_tree( nakedTriMesh );
+
+	if (pickTree != nullptr)
+	{
+		auto classifyNode = [&]( const TQ3Point3D& inMin, const TQ3Point3D& inMax ) -> E3FrustumClass
+		{
+			TQ3BoundingBox	nodeBounds = { inMin, inMax, kQ3False };
+			
+			return E3BoundingBox_ClassifyWindowRect( theView, nodeBounds, *theRect );
+		};
+		
+		pickTree->tree.VisitBoxes( classifyNode, testTriangle );
+	}
+	else
+	{
+		for (n = 0; n < geomData->numTriangles; n++)
+		{
+			if (testTriangle( n, false ))
+				break;
 		}
 	}
 
 
+
+	// Record the hit
+	if (hitTriangle != kQ3ArrayIndexNULL)
+	{
+		TQ3Point3D		worldHitPt;
+		E3View_TransformWindowToWorld( theView, &windowHitPt, &worldHitPt );
+		qd3dStatus = E3Pick_RecordHit(thePick, theView, &worldHitPt, nullptr,
+			nullptr, nullptr, nullptr, hitTriangle);
+	}
+
+
 	return(qd3dStatus);
 }
 
@@ -1470,7 +1814,8 @@ e3geom_trimesh_pick_screen_bounds(TQ3ViewObject theView, const TQ3TriMeshData *g
 //      e3geom_trimesh_pick_window_point : TriMesh window-point picking method.
 //-----------------------------------------------------------------------------
 static TQ3Status
-e3geom_trimesh_pick_window_point(TQ3ViewObject theView, TQ3PickObject thePick, const TQ3TriMeshData *geomData)
+e3geom_trimesh_pick_window_point(TQ3ViewObject theView, TQ3PickObject thePick, const TQ3TriMeshData *geomData,
+									E3NakedTriMesh *nakedTriMesh)
 {
 	TQ3Status					qd3dStatus;
 	TQ3Ray3D					theRay;
@@ -1480,7 +1825,7 @@ e3geom_trimesh_pick_window_point(TQ3ViewObject theView, TQ3PickObject thePick, c
 	E3View_GetRayThroughPickPoint(theView, &theRay);
 
 	qd3dStatus = e3geom_trimesh_pick_with_ray( theView, thePick, &theRay,
-			geomData );
+			geomData, nakedTriMesh );
 
 	return(qd3dStatus);
 }
@@ -1512,7 +1857,8 @@ e3geom_trimesh_record_any_xyz( TQ3ViewObject theView, TQ3PickObject thePick,
 //      e3geom_trimesh_pick_window_rect : TriMesh window-rect picking method.
 //-----------------------------------------------------------------------------
 static TQ3Status
-e3geom_trimesh_pick_window_rect(TQ3ViewObject theView, TQ3PickObject thePick, const TQ3TriMeshData *geomData)
+e3geom_trimesh_pick_window_rect(TQ3ViewObject theView, TQ3PickObject thePick, const TQ3TriMeshData *geomData,
+								E3NakedTriMesh *nakedTriMesh)
 {	TQ3Area						windowBounds;
 	TQ3Status					qd3dStatus = kQ3Success;
 	TQ3WindowRectPickData		pickData;
@@ -1534,7 +1880,7 @@ e3geom_trimesh_pick_window_rect(TQ3ViewObject theView, TQ3PickObject thePick, co
 		e3geom_trimesh_record_any_xyz( theView, thePick, *geomData );
 
 	else if (E3Rect_IntersectRect(&windowBounds, &pickData.rect))
-		qd3dStatus = e3geom_trimesh_pick_with_rect(theView, thePick, &pickData.rect, geomData);
+		qd3dStatus = e3geom_trimesh_pick_with_rect(theView, thePick, &pickData.rect, geomData, nakedTriMesh);
 
 	return(qd3dStatus);
 }
@@ -1547,7 +1893,8 @@ e3geom_trimesh_pick_window_rect(TQ3ViewObject theView, TQ3PickObject thePick, co
 //      e3geom_trimesh_pick_world_ray : TriMesh world-ray picking method.
 //-----------------------------------------------------------------------------
 static TQ3Status
-e3geom_trimesh_pick_world_ray(TQ3ViewObject theView, TQ3PickObject thePick, const TQ3TriMeshData *geomData)
+e3geom_trimesh_pick_world_ray(TQ3ViewObject theView, TQ3PickObject thePick, const TQ3TriMeshData *geomData,
+								E3NakedTriMesh *nakedTriMesh)
 {
 	TQ3Status					qd3dStatus;
 	TQ3Ray3D					pickRay;
@@ -1560,8 +1907,228 @@ e3geom_trimesh_pick_world_ray(TQ3ViewObject theView, TQ3PickObject thePick, cons
 
 
 	qd3dStatus = e3geom_trimesh_pick_with_ray( theView, thePick,
-			&pickRay, geomData );
+			&pickRay, geomData, nakedTriMesh );
+
+
+	return(qd3dStatus);
+}
+
+
+
+
+
+//=============================================================================
+//      e3geom_trimesh_pick_world_ray_batch : TriMesh world-ray batch picking.
+//-----------------------------------------------------------------------------
+//		Note :	Only the nearest hit of each ray is kept, so the rays are
+//				tested four at a time against each triangle, and each lane
+//				stops looking beyond the nearest hit it has found.
+//
+//				If the local to world transform is affine and invertible the
+//				rays are transformed into local coordinates, as for a single
+//				ray picked with the pick tree, and a large TriMesh is walked
+//				with its pick tree.  Otherwise the points are transformed to
+//				world coordinates and every triangle is tested.
+//-----------------------------------------------------------------------------
+static TQ3Status
+e3geom_trimesh_pick_world_ray_batch(TQ3ViewObject theView, TQ3PickObject thePick,
+									const TQ3TriMeshData *geomData,
+									E3NakedTriMesh *nakedTriMesh)
+{	struct BatchRay
+	{
+		TQ3Uns32		rayIndex;
+		TQ3Ray3D		ray;
+		float			directionLength;
+		float			maxDistance;
+		TQ3Uns32		triangle;
+		TQ3Param3D		param;
+	};
+	std::vector<BatchRay>			theRays;
+	std::vector<TQ3Point3D>			worldPoints;
+	TQ3BackfacingStyle				backfacingStyle;
+	TQ3Status						qd3dStatus;
+	TQ3Matrix4x4					worldToLocal;
+	TQ3BoundingBox					testBounds;
+	TQ3Point3D						hitPoints[3];
+	TQ3Uns32						numRays, n, k;
+
+
+
+	// Get the pick data
+	E3WorldRayBatchPick_GetNumRays( thePick, &numRays );
+	const TQ3Ray3D* worldRays        = E3WorldRayBatchPick_AccessRays( thePick );
+	const float*    nearestDistances = E3WorldRayBatchPick_AccessNearestDistances( thePick );
+
+
+
+	// Determine if we should cull back-facing triangles or not
+	qd3dStatus = E3View_GetBackfacingStyleState(theView, &backfacingStyle);
+	if (qd3dStatus != kQ3Success)
+		return(qd3dStatus);
+	
+	TQ3Boolean cullBackface = (backfacingStyle == kQ3BackfacingStyleRemove) ? kQ3True : kQ3False;
+
+
+
+	// Decide where to test the rays
+	const TQ3Matrix4x4* localToWorld = E3View_State_GetMatrixLocalToWorld(theView);
+	float localToWorldDeterminant = E3Matrix4x4_Determinant( localToWorld );
+	bool inLocalSpace = (localToWorld->value[0][3] == 0.0f) && (localToWorld->value[1][3] == 0.0f) &&
+		(localToWorld->value[2][3] == 0.0f) && (localToWorld->value[3][3] == 1.0f) &&
+		(localToWorldDeterminant != 0.0f);
+	
+	if (inLocalSpace)
+	{
+		E3Matrix4x4_Invert( localToWorld, &worldToLocal );
+		testBounds = geomData->bBox;
+	}
+	else
+		E3BoundingBox_Transform( &geomData->bBox, localToWorld, &testBounds );
+
+	try
+	{
+		// Find the rays which reach the bounds before their nearest hit
+		for (n = 0; n < numRays; ++n)
+		{
+			if (nearestDistances[n] < 0.0f)
+				continue;
+			
+			BatchRay theRay;
+			theRay.rayIndex        = n;
+			theRay.ray             = worldRays[n];
+			theRay.directionLength = 1.0f;
+			theRay.triangle        = kQ3ArrayIndexNULL;
+			
+			if (inLocalSpace)
+			{
+				theRay.ray.origin    = worldRays[n].origin * worldToLocal;
+				theRay.ray.direction = worldRays[n].direction * worldToLocal;
+				
+				theRay.directionLength = Q3Length3D( theRay.ray.direction );
+				if (theRay.directionLength < kQ3RealZero)
+					continue;
+				
+				theRay.ray.direction *= 1.0f / theRay.directionLength;
+			}
+			
+			theRay.maxDistance = kQ3MaxFloat;
+			if (nearestDistances[n] < kQ3MaxFloat / theRay.directionLength)
+				theRay.maxDistance = nearestDistances[n] * theRay.directionLength;
+			
+			float boundsEntry;
+			if (E3BoundingTree::RayEntersBox( testBounds.min, testBounds.max, theRay.ray.origin,
+				E3BoundingTree::GetInverseDirection( theRay.ray.direction ),
+				theRay.maxDistance, boundsEntry ))
+				theRays.push_back( theRay );
+		}
+		
+		if (theRays.empty())
+			return(kQ3Success);
+
+
+
+		// Transform our points from local to world coordinates if need be
+		if (! inLocalSpace)
+		{
+			worldPoints.resize( geomData->numPoints );
+			Q3Point3D_To3DTransformArray( geomData->points, localToWorld, worldPoints.data(),
+				geomData->numPoints, sizeof(TQ3Point3D), sizeof(TQ3Point3D) );
+		}
+	}
+	catch (...)
+	{
+		E3ErrorManager_PostError( kQ3ErrorOutOfMemory, kQ3False );
+		return(kQ3Failure);
+	}
+
+	const TQ3Point3D* testPoints = inLocalSpace ? geomData->points : worldPoints.data();
+
+
 
+	// An orientation-reversing transformation can interfere with backface
+	// culling in world space, so maybe flip the triangle winding to compensate.
+	bool flipWinding = (! inLocalSpace) && cullBackface && (localToWorldDeterminant < 0.0f);
+
+
+
+	// Use the pick tree for a large TriMesh
+	const E3BoundingTree* pickTree = nullptr;
+	if ( inLocalSpace && (nakedTriMesh != nullptr) &&
+		(geomData->numTriangles >= kTriMeshPickTreeMinTriangles) )
+	{
+		const TQ3TriMeshPickTree* theTree = e3geom_nakedtrimesh_get_pick_tree( nakedTriMesh );
+		if (theTree != nullptr)
+			pickTree = &theTree->tree;
+	}
+
+
+
+	// Find the nearest hit of each ray, a packet at a time
+	for (TQ3Uns32 first = 0; first < theRays.size(); first += 4)
+	{
+		BatchRay* packetRays = &theRays[ first ];
+		TQ3Uns32 numLanes = std::min( 4U, static_cast<TQ3Uns32>(theRays.size() - first) );
+		TQ3Uns32 laneMask = (1U << numLanes) - 1;
+		
+		E3Ray3DPacket thePacket;
+		for (k = 0; k < 4; ++k)
+			E3Ray3DPacket_SetRay( thePacket, k, packetRays[ std::min( k, numLanes - 1 ) ].ray,
+				packetRays[ std::min( k, numLanes - 1 ) ].maxDistance );
+		
+		auto testTriangle = [&]( TQ3Uns32 inTriangle, TQ3Uns32 inLaneMask )
+		{
+			TQ3Uns32 v0 = geomData->triangles[ inTriangle ].pointIndices[0];
+			TQ3Uns32 v1 = geomData->triangles[ inTriangle ].pointIndices[1];
+			TQ3Uns32 v2 = geomData->triangles[ inTriangle ].pointIndices[2];
+			if (flipWinding)
+				std::swap( v1, v2 );
+			
+			TQ3Param3D theHits[4];
+			TQ3Uns32 hitMask = E3Ray3DPacket_IntersectTriangle( thePacket, inLaneMask,
+				testPoints[v0], testPoints[v1], testPoints[v2], cullBackface, theHits );
+			
+			for (TQ3Uns32 lane = 0; hitMask != 0; ++lane, hitMask >>= 1)
+			{
+				if ((hitMask & 1) != 0)
+				{
+					packetRays[ lane ].triangle = inTriangle;
+					packetRays[ lane ].param    = theHits[ lane ];
+					thePacket.maxDistance[ lane ] = theHits[ lane ].w;
+				}
+			}
+		};
+		
+		if (pickTree != nullptr)
+			pickTree->VisitRayPacket( thePacket, laneMask, testTriangle );
+		else
+		{
+			for (n = 0; n < geomData->numTriangles; ++n)
+				testTriangle( n, laneMask );
+		}
+	}
+
+
+
+	// Record the hits
+	for (BatchRay& theRay : theRays)
+	{
+		if (qd3dStatus != kQ3Success)
+			break;
+		
+		if (theRay.triangle == kQ3ArrayIndexNULL)
+			continue;
+		
+		for (k = 0; k < 3; ++k)
+		{
+			const TQ3Point3D& thePoint( testPoints[ geomData->triangles[ theRay.triangle ].pointIndices[k] ] );
+			hitPoints[k] = inLocalSpace ? thePoint * *localToWorld : thePoint;
+		}
+		
+		theRay.param.w /= theRay.directionLength;
+		
+		qd3dStatus = e3geom_trimesh_record_hit( theView, thePick, geomData,
+			theRay.triangle, hitPoints, theRay.param, theRay.rayIndex );
+	}
 
 	return(qd3dStatus);
 }
@@ -1579,13 +2146,18 @@ e3geom_trimesh_pick(TQ3ViewObject theView, TQ3ObjectType objectType, TQ3Object t
 #pragma unused( objectType )
 	TQ3Status				qd3dStatus;
 	const TQ3TriMeshData	*geomData;
+	E3NakedTriMesh			*nakedTriMesh = nullptr;
 	TQ3PickObject			thePick;
 
 
 
-	// Get the geometry data
+	// Get the geometry data, and for a retained TriMesh the naked TriMesh
+	// which keeps its pick tree
 	geomData = e3geom_trimesh_get_geom_data(theObject, objectData);
 	Q3_ASSERT(geomData->bBox.isEmpty == kQ3False);
+	
+	if (theObject != nullptr)
+		nakedTriMesh = ((const TQ3TriMeshOuterData *) objectData)->nakedTriMesh;
 
 
 
@@ -1593,15 +2165,19 @@ e3geom_trimesh_pick(TQ3ViewObject theView, TQ3ObjectType objectType, TQ3Object t
 	thePick = E3View_AccessPick(theView);
 	switch (Q3Pick_GetType(thePick)) {
 		case kQ3PickTypeWindowPoint:
-			qd3dStatus = e3geom_trimesh_pick_window_point(theView, thePick, geomData);
+			qd3dStatus = e3geom_trimesh_pick_window_point(theView, thePick, geomData, nakedTriMesh);
 			break;
 
 		case kQ3PickTypeWindowRect:
-			qd3dStatus = e3geom_trimesh_pick_window_rect(theView, thePick, geomData);
+			qd3dStatus = e3geom_trimesh_pick_window_rect(theView, thePick, geomData, nakedTriMesh);
 			break;
 
 		case kQ3PickTypeWorldRay:
-			qd3dStatus = e3geom_trimesh_pick_world_ray(theView, thePick, geomData);
+			qd3dStatus = e3geom_trimesh_pick_world_ray(theView, thePick, geomData, nakedTriMesh);
+			break;
+
+		case kQ3PickTypeWorldRayBatch:
+			qd3dStatus = e3geom_trimesh_pick_world_ray_batch(theView, thePick, geomData, nakedTriMesh);
 			break;
 
 		default:
@@ -1917,6 +2493,7 @@ E3TriMesh_SetData(TQ3GeometryObject theTriMesh, const TQ3TriMeshData *triMeshDat
 
 	// Dispose of the existing data
 	e3geom_trimesh_disposedata( & triMesh->instanceData.nakedTriMesh->instanceData.geomData );
+	e3geom_nakedtrimesh_dispose_pick_tree( & triMesh->instanceData.nakedTriMesh->instanceData );
 
 
 
@@ -2158,8 +2735,8 @@ E3TriMesh_AddTriangleNormals(TQ3GeometryObject theTriMesh, TQ3OrientationStyle t
 		TQ3Point3D* thePoints = nakedTriMesh->instanceData.geomData.points;
 		if (thePoints != nullptr)
 		{
-			Q3Triangle_CrossProductArray ( nakedTriMesh->instanceData.geomData.numTriangles, nullptr,
-										 nakedTriMesh->instanceData.geomData.triangles[0].pointIndices,
+			E3TriMesh_ComputeTriangleNormals( nakedTriMesh->instanceData.geomData.numTriangles,
+										 nakedTriMesh->instanceData.geomData.triangles,
 										 thePoints,
 										 theNormals ) ;
 		}
@@ -2196,3 +2773,58 @@ void	E3TriMesh_SetNakedGeometry( TQ3GeometryObject inTriMesh,
 	E3TriMesh* triMesh = (E3TriMesh*) inTriMesh;
 	E3Shared_Replace( (TQ3Object*) &triMesh->instanceData.nakedTriMesh, inNaked );
 }
+
+
+
+
+
+//=============================================================================
+//      E3TriMesh_BuildPickTree : Build the pick tree of a TriMesh.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3TriMesh_BuildPickTree(TQ3GeometryObject theTriMesh, TQ3TriMeshPickTreeInfo *outInfo)
+{
+	E3TriMesh* triMesh = (E3TriMesh*) theTriMesh;
+	E3NakedTriMesh* nakedTriMesh = triMesh->instanceData.nakedTriMesh;
+
+
+
+	// Build the tree, if it is not up to date
+	const TQ3TriMeshPickTree* pickTree = e3geom_nakedtrimesh_get_pick_tree( nakedTriMesh );
+	if (pickTree == nullptr)
+		return(kQ3Failure);
+
+
+
+	// Return some information about it
+	if (outInfo != nullptr)
+	{
+		outInfo->numTriangles = pickTree->tree.GetItemCount();
+		outInfo->numNodes     = pickTree->tree.GetNodeCount();
+		outInfo->memorySize   = static_cast<TQ3Uns32>( sizeof(TQ3TriMeshPickTree) -
+			sizeof(E3BoundingTree) + pickTree->tree.GetMemorySize() );
+		outInfo->buildTime    = pickTree->buildTime;
+	}
+
+	return(kQ3Success);
+}
+
+
+
+
+
+//=============================================================================
+//      E3TriMesh_DisposePickTree : Dispose of the pick tree of a TriMesh.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3TriMesh_DisposePickTree(TQ3GeometryObject theTriMesh)
+{
+	E3TriMesh* triMesh = (E3TriMesh*) theTriMesh;
+
+
+
+	// Dispose of the tree, which will be rebuilt if needed
+	e3geom_nakedtrimesh_dispose_pick_tree( &triMesh->instanceData.nakedTriMesh->instanceData );
+
+	return(kQ3Success);
+}
@@ -83,6 +83,9 @@ TQ3GeometryObject	E3TriMesh_GetNakedGeometry( TQ3GeometryObject inGeom );
 void				E3TriMesh_SetNakedGeometry( TQ3GeometryObject inTriMesh,
 												TQ3GeometryObject inNaked );
 
+TQ3Status			E3TriMesh_BuildPickTree(TQ3GeometryObject theTriMesh, TQ3TriMeshPickTreeInfo *outInfo);
+TQ3Status			E3TriMesh_DisposePickTree(TQ3GeometryObject theTriMesh);
+
 
 
 //=============================================================================
@@ -0,0 +1,807 @@
+/*  NAME:
+        E3GeometryTriMeshNormals.cpp
+
+    DESCRIPTION:
+        Computing vertex normals of TriMeshes.
+
+    COPYRIGHT:
+        Copyright (c) 2025, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+#include "E3GeometryTriMeshNormals.h"
+
+#include "E3Memory.h"
+#include "E3Set.h"
+#include "E3ClassTree.h"
+#include "E3Math.h"
+#include "E3GeometryTriMesh.h"
+#include "E3Parallel.h"
+#include "QuesaMath.h"
+#include "QuesaMathOperators.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#define	EQ3ThrowIfMemFail_( x )		do { if ( (x) == nullptr ) { \
+										throw std::bad_alloc();	\
+										} } while (false)
+
+#define	EQ3ThrowIf_( x )			do { if ( (x) ) { \
+										throw std::exception();	\
+										} } while (false)
+
+/*
+	DISCUSSION
+	
+	A "corner" is a triangle in its role at one of its points, numbered
+	3 * triangle + k.  A "location" is a set of points with identical
+	coordinates.  Smoothing is done over locations rather than points, since
+	modelers and importers often split points at texture seams, and those
+	should not show as creases.
+	
+	The work is arranged so that each pass either reads shared data and writes
+	to its own range of triangles, or reads shared data and writes to the
+	corners and points of its own range of locations.  That lets each pass be
+	split across threads without locks or atomic operations.  The steps are:
+	
+	1. Find a unit normal for each triangle, and the angle of each corner.
+	   These are split by ranges of triangles.
+	2. Number the locations by sorting the points, and list the corners at
+	   each location with a counting sort.  These are serial, but cheap.
+	3. For each corner, sum the normals of the triangles at its location
+	   within the crease angle of its own triangle, weighted by corner angle.
+	   Corners of the same point with nearly the same normal are then grouped
+	   as one vertex, and the extra groups of a point are counted.  This is
+	   split by ranges of locations.
+	4. After a running total of the extra vertex counts, number the vertices
+	   and store their normals, again split by ranges of locations.
+	
+	Each triangle normal is added to a corner normal in full, so a vertex
+	normal is not biased by how a surface happens to be split into triangles.
+	Weighting by corner angle, as suggested by Thurmer and Wuthrich, means
+	that a fan of thin triangles does not outweigh a single broad one.
+*/
+
+namespace
+{
+	typedef std::vector< TQ3Uns32 >		UnsVec;
+	typedef std::vector< TQ3Vector3D >	VecVec;
+	
+	// Ranges smaller than these are not worth a thread
+	const TQ3Uns32		kMinTrianglesPerTask	= 8192;
+	const TQ3Uns32		kMinLocationsPerTask	= 4096;
+	
+	// Corner normals at least this close are the same vertex normal
+	const float			kSameNormalCosine		= 0.9999f;
+	
+	const float			kDegenerateLengthSquared	= 1.0e-12f;
+	
+	const TQ3Vector3D	kDefaultNormal = { 1.0f, 0.0f, 0.0f };
+	
+	const TQ3Uns32		kExtraVertexFlag		= 0x80000000UL;
+	
+	struct PointKey
+	{
+		TQ3Uns32	bits[3];
+		TQ3Uns32	point;
+		
+		bool		SameBits( const PointKey& inOther ) const
+					{
+						return (bits[0] == inOther.bits[0]) &&
+							(bits[1] == inOther.bits[1]) &&
+							(bits[2] == inOther.bits[2]);
+					}
+		
+		bool		operator<( const PointKey& inOther ) const
+					{
+						if (bits[0] != inOther.bits[0])
+							return bits[0] < inOther.bits[0];
+						if (bits[1] != inOther.bits[1])
+							return bits[1] < inOther.bits[1];
+						if (bits[2] != inOther.bits[2])
+							return bits[2] < inOther.bits[2];
+						return point < inOther.point;
+					}
+	};
+}
+
+
+
+
+
+//=============================================================================
+//      Internal functions
+//-----------------------------------------------------------------------------
+
+/*!
+	@function	FindAttribute
+	@abstract	Find an attribute array of a given type, or nullptr.
+*/
+static TQ3TriMeshAttributeData* FindAttribute( TQ3Uns32 inNumTypes,
+										TQ3TriMeshAttributeData* inTypes,
+										TQ3AttributeType inType )
+{
+	for (TQ3Uns32 i = 0; i < inNumTypes; ++i)
+	{
+		if (inTypes[i].attributeType == inType)
+		{
+			return &inTypes[i];
+		}
+	}
+	return nullptr;
+}
+
+
+
+
+
+/*!
+	@function	GetAttributeSize
+	@abstract	Size in bytes of one value of an attribute type.
+*/
+static TQ3Uns32	GetAttributeSize( TQ3AttributeType inAttType )
+{
+	TQ3ObjectType	attType = E3Attribute_AttributeToClassType( inAttType );
+	E3ClassInfoPtr theClass = E3ClassTree::GetClass( attType );
+	EQ3ThrowIf_( theClass == nullptr );
+	return theClass->GetInstanceSize();
+}
+
+
+
+
+
+/*!
+	@function	UnitOrZero
+	@abstract	Normalize a vector, or make it zero if it has no direction.
+	@discussion	The scalar version of E3Triangle_CrossProductArray gives NaNs
+				for degenerate triangles, hence the test for finite values.
+*/
+static void UnitOrZero( TQ3Vector3D& ioVec )
+{
+	float lenSq = Q3FastVector3D_LengthSquared( &ioVec );
+	if ( (lenSq < kDegenerateLengthSquared) || ! std::isfinite( lenSq ) )
+	{
+		ioVec.x = ioVec.y = ioVec.z = 0.0f;
+	}
+	else
+	{
+		Q3FastVector3D_Scale( &ioVec, 1.0f / sqrtf( lenSq ), &ioVec );
+	}
+}
+
+
+
+
+
+/*!
+	@function	FindTriangleNormals
+	@abstract	Find a unit normal for each triangle, or a zero vector for a
+				degenerate triangle, and the angle of each corner.
+	@discussion	Normals given by the TriMesh take priority over computed ones.
+*/
+static void FindTriangleNormals( const TQ3TriMeshData& inData,
+								VecVec& outNormals,
+								std::vector<float>& outAngles )
+{
+	const TQ3TriMeshAttributeData* givenNormals = FindAttribute(
+		inData.numTriangleAttributeTypes, inData.triangleAttributeTypes,
+		kQ3AttributeTypeNormal );
+	
+	outNormals.resize( inData.numTriangles );
+	outAngles.resize( 3 * inData.numTriangles );
+	
+	E3Parallel_For( inData.numTriangles, kMinTrianglesPerTask,
+		[&]( TQ3Uns32 inStart, TQ3Uns32 inEnd )
+		{
+			E3Triangle_CrossProductArray( inEnd - inStart, nullptr,
+				inData.triangles[ inStart ].pointIndices, inData.points,
+				&outNormals[ inStart ] );
+			
+			for (TQ3Uns32 i = inStart; i < inEnd; ++i)
+			{
+				if ( (givenNormals != nullptr) && ( (givenNormals->attributeUseArray == nullptr) ||
+					(givenNormals->attributeUseArray[i] != 0) ) )
+				{
+					outNormals[i] = static_cast<const TQ3Vector3D*>( givenNormals->data )[i];
+				}
+				UnitOrZero( outNormals[i] );
+				
+				const TQ3Uns32* pts = inData.triangles[i].pointIndices;
+				for (TQ3Uns32 k = 0; k < 3; ++k)
+				{
+					const TQ3Point3D& thePt( inData.points[ pts[k] ] );
+					const TQ3Point3D& nextPt( inData.points[ pts[ (k + 1) % 3 ] ] );
+					const TQ3Point3D& prevPt( inData.points[ pts[ (k + 2) % 3 ] ] );
+					TQ3Vector3D toNext, toPrev, theCross;
+					Q3FastPoint3D_Subtract( &nextPt, &thePt, &toNext );
+					Q3FastPoint3D_Subtract( &prevPt, &thePt, &toPrev );
+					Q3FastVector3D_Cross( &toNext, &toPrev, &theCross );
+					outAngles[ 3 * i + k ] = atan2f( Q3FastVector3D_Length( &theCross ),
+						Q3FastVector3D_Dot( &toNext, &toPrev ) );
+				}
+			}
+		} );
+}
+
+
+
+
+
+/*!
+	@function	FindLocations
+	@abstract	Number the distinct point coordinates, and list the corners
+				at each location.
+	@discussion	The corners of a location are listed in increasing order, so
+				the results do not depend on how work is split.
+*/
+static void FindLocations( const TQ3TriMeshData& inData,
+							UnsVec& outPointToLocation,
+							UnsVec& outLocationStart,
+							UnsVec& outLocationCorners )
+{
+	// Compare coordinates by their bits, with negative zero changed to zero,
+	// so that the order is strict even if there are NaNs.
+	std::vector< PointKey > theKeys( inData.numPoints );
+	for (TQ3Uns32 i = 0; i < inData.numPoints; ++i)
+	{
+		const float coords[3] = { inData.points[i].x + 0.0f, inData.points[i].y + 0.0f,
+			inData.points[i].z + 0.0f };
+		E3Memory_Copy( coords, theKeys[i].bits, sizeof(coords) );
+		theKeys[i].point = i;
+	}
+	std::sort( theKeys.begin(), theKeys.end() );
+	
+	outPointToLocation.resize( inData.numPoints );
+	TQ3Uns32 numLocations = 0;
+	for (TQ3Uns32 i = 0; i < inData.numPoints; ++i)
+	{
+		if ( (i > 0) && ! theKeys[i].SameBits( theKeys[i - 1] ) )
+		{
+			++numLocations;
+		}
+		outPointToLocation[ theKeys[i].point ] = numLocations;
+	}
+	if (inData.numPoints > 0)
+	{
+		++numLocations;
+	}
+	
+	const TQ3Uns32 numCorners = 3 * inData.numTriangles;
+	const TQ3Uns32* cornerPoints = reinterpret_cast<const TQ3Uns32*>( inData.triangles );
+	outLocationStart.assign( numLocations + 1, 0 );
+	for (TQ3Uns32 i = 0; i < numCorners; ++i)
+	{
+		outLocationStart[ outPointToLocation[ cornerPoints[i] ] + 1 ] += 1;
+	}
+	for (TQ3Uns32 i = 0; i < numLocations; ++i)
+	{
+		outLocationStart[ i + 1 ] += outLocationStart[ i ];
+	}
+	
+	outLocationCorners.resize( numCorners );
+	UnsVec nextSlot( outLocationStart.begin(), outLocationStart.end() - 1 );
+	for (TQ3Uns32 i = 0; i < numCorners; ++i)
+	{
+		outLocationCorners[ nextSlot[ outPointToLocation[ cornerPoints[i] ] ]++ ] = i;
+	}
+}
+
+
+
+
+
+/*!
+	@function	FindCornerNormals
+	@abstract	Find the normal of each corner, and group the corners of each
+				point into vertices.
+	@discussion	On output, outCornerLeader gives the first corner of the
+				vertex that each corner belongs to.  For a leading corner,
+				outCornerVertex is the point index if the vertex keeps the
+				original point, or else kExtraVertexFlag plus the number of the
+				extra vertex within the location.  outNumExtra receives the
+				number of extra vertices at each location.
+*/
+static void FindCornerNormals( const TQ3TriMeshData& inData,
+								const VecVec& inTriNormals,
+								const std::vector<float>& inAngles,
+								const UnsVec& inLocationStart,
+								const UnsVec& inLocationCorners,
+								float inCreaseAngle,
+								VecVec& outCornerNormals,
+								UnsVec& outCornerLeader,
+								UnsVec& outCornerVertex,
+								UnsVec& outNumExtra )
+{
+	const TQ3Uns32 numLocations = static_cast<TQ3Uns32>( inLocationStart.size() - 1 );
+	const TQ3Uns32* cornerPoints = reinterpret_cast<const TQ3Uns32*>( inData.triangles );
+	const bool smoothAll = (inCreaseAngle >= kQ3Pi);
+	const float creaseCosine = (inCreaseAngle <= 0.0f)? 1.0f : cosf( inCreaseAngle );
+	
+	outCornerNormals.resize( inLocationCorners.size() );
+	outCornerLeader.resize( inLocationCorners.size() );
+	outCornerVertex.resize( inLocationCorners.size() );
+	outNumExtra.resize( numLocations );
+	
+	E3Parallel_For( numLocations, kMinLocationsPerTask,
+		[&]( TQ3Uns32 inStart, TQ3Uns32 inEnd )
+		{
+			for (TQ3Uns32 loc = inStart; loc < inEnd; ++loc)
+			{
+				const TQ3Uns32 firstCorner = inLocationStart[ loc ];
+				const TQ3Uns32 endCorner = inLocationStart[ loc + 1 ];
+				
+				// Sum triangle normals
+				TQ3Vector3D smoothNormal = { 0.0f, 0.0f, 0.0f };
+				if (smoothAll)
+				{
+					for (TQ3Uns32 j = firstCorner; j < endCorner; ++j)
+					{
+						const TQ3Uns32 other = inLocationCorners[ j ];
+						smoothNormal += inAngles[ other ] * inTriNormals[ other / 3 ];
+					}
+					UnitOrZero( smoothNormal );
+				}
+				
+				for (TQ3Uns32 i = firstCorner; i < endCorner; ++i)
+				{
+					const TQ3Uns32 corner = inLocationCorners[ i ];
+					const TQ3Vector3D& triNormal( inTriNormals[ corner / 3 ] );
+					TQ3Vector3D& theNormal( outCornerNormals[ corner ] );
+					
+					if (smoothAll)
+					{
+						theNormal = smoothNormal;
+					}
+					else
+					{
+						const bool isDegenerate = (triNormal.x == 0.0f) &&
+							(triNormal.y == 0.0f) && (triNormal.z == 0.0f);
+						theNormal.x = theNormal.y = theNormal.z = 0.0f;
+						for (TQ3Uns32 j = firstCorner; j < endCorner; ++j)
+						{
+							const TQ3Uns32 other = inLocationCorners[ j ];
+							const TQ3Vector3D& otherNormal( inTriNormals[ other / 3 ] );
+							if ( (j == i) || isDegenerate ||
+								(Q3FastVector3D_Dot( &triNormal, &otherNormal ) >= creaseCosine) )
+							{
+								theNormal += inAngles[ other ] * otherNormal;
+							}
+						}
+						UnitOrZero( theNormal );
+					}
+					
+					if ( (theNormal.x == 0.0f) && (theNormal.y == 0.0f) && (theNormal.z == 0.0f) )
+					{
+						theNormal = kDefaultNormal;
+					}
+				}
+				
+				// Group corners of each point into vertices
+				TQ3Uns32 numExtra = 0;
+				for (TQ3Uns32 i = firstCorner; i < endCorner; ++i)
+				{
+					const TQ3Uns32 corner = inLocationCorners[ i ];
+					const TQ3Uns32 thePoint = cornerPoints[ corner ];
+					TQ3Uns32 leader = corner;
+					bool isFirst = true;
+					
+					for (TQ3Uns32 j = firstCorner; j < i; ++j)
+					{
+						const TQ3Uns32 other = inLocationCorners[ j ];
+						if ( (outCornerLeader[ other ] == other) &&
+							(cornerPoints[ other ] == thePoint) )
+						{
+							isFirst = false;
+							if (Q3FastVector3D_Dot( &outCornerNormals[ other ],
+								&outCornerNormals[ corner ] ) >= kSameNormalCosine)
+							{
+								leader = other;
+								break;
+							}
+						}
+					}
+					
+					outCornerLeader[ corner ] = leader;
+					if (leader == corner)
+					{
+						outCornerVertex[ corner ] = isFirst? thePoint :
+							(kExtraVertexFlag | numExtra++);
+					}
+				}
+				outNumExtra[ loc ] = numExtra;
+			}
+		} );
+}
+
+
+
+
+
+/*!
+	@function	NumberVertices
+	@abstract	Give each corner its final point index, and find the normal of
+				each point.
+	@discussion	On input, ioExtraStart holds the first extra vertex of each
+				location, counted from 0.  On output, outExtraSource holds the
+				original point of each extra vertex.
+*/
+static void NumberVertices( const TQ3TriMeshData& inData,
+							const UnsVec& inLocationStart,
+							const UnsVec& inLocationCorners,
+							const UnsVec& inExtraStart,
+							const VecVec& inCornerNormals,
+							const UnsVec& inCornerLeader,
+							UnsVec& ioCornerVertex,
+							UnsVec& outExtraSource,
+							TQ3Vector3D* outPointNormals )
+{
+	const TQ3Uns32 numLocations = static_cast<TQ3Uns32>( inLocationStart.size() - 1 );
+	const TQ3Uns32* cornerPoints = reinterpret_cast<const TQ3Uns32*>( inData.triangles );
+	
+	E3Parallel_For( numLocations, kMinLocationsPerTask,
+		[&]( TQ3Uns32 inStart, TQ3Uns32 inEnd )
+		{
+			for (TQ3Uns32 loc = inStart; loc < inEnd; ++loc)
+			{
+				for (TQ3Uns32 i = inLocationStart[ loc ]; i < inLocationStart[ loc + 1 ]; ++i)
+				{
+					const TQ3Uns32 corner = inLocationCorners[ i ];
+					const TQ3Uns32 leader = inCornerLeader[ corner ];
+					
+					if (leader == corner)
+					{
+						TQ3Uns32 theVertex = ioCornerVertex[ corner ];
+						if ( (theVertex & kExtraVertexFlag) != 0 )
+						{
+							const TQ3Uns32 extraIndex = inExtraStart[ loc ] +
+								(theVertex & ~kExtraVertexFlag);
+							outExtraSource[ extraIndex ] = cornerPoints[ corner ];
+							theVertex = inData.numPoints + extraIndex;
+							ioCornerVertex[ corner ] = theVertex;
+						}
+						outPointNormals[ theVertex ] = inCornerNormals[ corner ];
+					}
+					else
+					{
+						ioCornerVertex[ corner ] = ioCornerVertex[ leader ];
+					}
+				}
+			}
+		} );
+}
+
+
+
+
+
+/*!
+	@function	AddVertexNormalsToData
+	@abstract	Add vertex normals to TriMesh data in place.
+	@discussion	All new memory is allocated before the data is changed, so if
+				this throws, the data is as it was.
+*/
+static void AddVertexNormalsToData( TQ3TriMeshData& ioData, float inCreaseAngle )
+{
+	const TQ3Uns32 numPoints = ioData.numPoints;
+	
+	VecVec triNormals;
+	std::vector<float> cornerAngles;
+	FindTriangleNormals( ioData, triNormals, cornerAngles );
+	
+	UnsVec pointToLocation, locationStart, locationCorners;
+	FindLocations( ioData, pointToLocation, locationStart, locationCorners );
+	
+	VecVec cornerNormals;
+	UnsVec cornerLeader, cornerVertex, extraStart;
+	FindCornerNormals( ioData, triNormals, cornerAngles, locationStart,
+		locationCorners, inCreaseAngle, cornerNormals, cornerLeader,
+		cornerVertex, extraStart );
+	
+	TQ3Uns32 numExtra = 0;
+	for (TQ3Uns32& locExtra : extraStart)
+	{
+		const TQ3Uns32 locCount = locExtra;
+		locExtra = numExtra;
+		numExtra += locCount;
+	}
+	const TQ3Uns32 newNumPoints = numPoints + numExtra;
+	
+	std::vector< TQ3Uns32 > attSizes( ioData.numVertexAttributeTypes );
+	for (TQ3Uns32 i = 0; i < ioData.numVertexAttributeTypes; ++i)
+	{
+		attSizes[i] = GetAttributeSize( ioData.vertexAttributeTypes[i].attributeType );
+	}
+	
+	// Allocate everything we need
+	std::vector< void* > newBlocks;
+	TQ3TriMeshAttributeData* newTypes = nullptr;
+	TQ3Vector3D* newNormals = nullptr;
+	TQ3Point3D* newPoints = nullptr;
+	UnsVec extraSource( numExtra );
+	try
+	{
+		newBlocks.reserve( 3 + 2 * ioData.numVertexAttributeTypes );
+		
+		newTypes = static_cast<TQ3TriMeshAttributeData*>( E3Memory_Allocate(
+			(ioData.numVertexAttributeTypes + 1) * sizeof(TQ3TriMeshAttributeData) ) );
+		EQ3ThrowIfMemFail_( newTypes );
+		newBlocks.push_back( newTypes );
+		
+		newNormals = static_cast<TQ3Vector3D*>( E3Memory_Allocate(
+			newNumPoints * sizeof(TQ3Vector3D) ) );
+		EQ3ThrowIfMemFail_( newNormals );
+		newBlocks.push_back( newNormals );
+		
+		if (numExtra > 0)
+		{
+			newPoints = static_cast<TQ3Point3D*>( E3Memory_Allocate(
+				newNumPoints * sizeof(TQ3Point3D) ) );
+			EQ3ThrowIfMemFail_( newPoints );
+			newBlocks.push_back( newPoints );
+			
+			for (TQ3Uns32 i = 0; i < ioData.numVertexAttributeTypes; ++i)
+			{
+				const TQ3TriMeshAttributeData& oldAtt( ioData.vertexAttributeTypes[i] );
+				TQ3TriMeshAttributeData& newAtt( newTypes[i] );
+				newAtt.attributeType = oldAtt.attributeType;
+				newAtt.data = nullptr;
+				newAtt.attributeUseArray = nullptr;
+				
+				if (oldAtt.data != nullptr)
+				{
+					newAtt.data = E3Memory_Allocate( newNumPoints * attSizes[i] );
+					EQ3ThrowIfMemFail_( newAtt.data );
+					newBlocks.push_back( newAtt.data );
+				}
+				
+				if (oldAtt.attributeUseArray != nullptr)
+				{
+					newAtt.attributeUseArray = static_cast<char*>(
+						E3Memory_Allocate( newNumPoints ) );
+					EQ3ThrowIfMemFail_( newAtt.attributeUseArray );
+					newBlocks.push_back( newAtt.attributeUseArray );
+				}
+			}
+		}
+		
+		for (TQ3Uns32 i = 0; i < numPoints; ++i)
+		{
+			newNormals[i] = kDefaultNormal;
+		}
+		NumberVertices( ioData, locationStart, locationCorners, extraStart,
+			cornerNormals, cornerLeader, cornerVertex, extraSource, newNormals );
+	}
+	catch (...)
+	{
+		for (void* aBlock : newBlocks)
+		{
+			Q3Memory_Free( &aBlock );
+		}
+		throw;
+	}
+	
+	// Duplicate split points and their attributes
+	if (numExtra > 0)
+	{
+		E3Memory_Copy( ioData.points, newPoints, numPoints * sizeof(TQ3Point3D) );
+		for (TQ3Uns32 i = 0; i < numExtra; ++i)
+		{
+			newPoints[ numPoints + i ] = ioData.points[ extraSource[i] ];
+		}
+		Q3Memory_Free( &ioData.points );
+		ioData.points = newPoints;
+		
+		for (TQ3Uns32 j = 0; j < ioData.numVertexAttributeTypes; ++j)
+		{
+			TQ3TriMeshAttributeData& oldAtt( ioData.vertexAttributeTypes[j] );
+			TQ3TriMeshAttributeData& newAtt( newTypes[j] );
+			const TQ3Uns32 attSize = attSizes[j];
+			
+			if (oldAtt.data != nullptr)
+			{
+				const char* oldData = static_cast<const char*>( oldAtt.data );
+				char* newData = static_cast<char*>( newAtt.data );
+				E3Memory_Copy( oldData, newData, numPoints * attSize );
+				for (TQ3Uns32 i = 0; i < numExtra; ++i)
+				{
+					E3Memory_Copy( oldData + extraSource[i] * attSize,
+						newData + (numPoints + i) * attSize, attSize );
+				}
+				
+				if (oldAtt.attributeType == kQ3AttributeTypeSurfaceShader)
+				{
+					TQ3Object* obArray = static_cast<TQ3Object*>( newAtt.data );
+					for (TQ3Uns32 i = numPoints; i < newNumPoints; ++i)
+					{
+						if (obArray[i] != nullptr)
+						{
+							Q3Shared_GetReference( obArray[i] );
+						}
+					}
+				}
+				Q3Memory_Free( &oldAtt.data );
+			}
+			
+			if (oldAtt.attributeUseArray != nullptr)
+			{
+				E3Memory_Copy( oldAtt.attributeUseArray, newAtt.attributeUseArray,
+					numPoints );
+				for (TQ3Uns32 i = 0; i < numExtra; ++i)
+				{
+					newAtt.attributeUseArray[ numPoints + i ] =
+						oldAtt.attributeUseArray[ extraSource[i] ];
+				}
+				Q3Memory_Free( &oldAtt.attributeUseArray );
+			}
+		}
+		
+		ioData.numPoints = newNumPoints;
+		TQ3Uns32* cornerPoints = reinterpret_cast<TQ3Uns32*>( ioData.triangles );
+		for (TQ3Uns32 i = 0; i < cornerVertex.size(); ++i)
+		{
+			cornerPoints[i] = cornerVertex[i];
+		}
+	}
+	else if (ioData.numVertexAttributeTypes > 0)
+	{
+		E3Memory_Copy( ioData.vertexAttributeTypes, newTypes,
+			ioData.numVertexAttributeTypes * sizeof(TQ3TriMeshAttributeData) );
+	}
+	
+	// Add the normal attribute
+	newTypes[ ioData.numVertexAttributeTypes ].attributeType = kQ3AttributeTypeNormal;
+	newTypes[ ioData.numVertexAttributeTypes ].data = newNormals;
+	newTypes[ ioData.numVertexAttributeTypes ].attributeUseArray = nullptr;
+	Q3Memory_Free( &ioData.vertexAttributeTypes );
+	ioData.vertexAttributeTypes = newTypes;
+	ioData.numVertexAttributeTypes += 1;
+}
+
+
+
+
+
+//=============================================================================
+//      Public functions
+//-----------------------------------------------------------------------------
+
+/*!
+	@function	E3TriMesh_ComputeTriangleNormals
+	
+	@abstract	Compute unit normals of triangles, assuming counterclockwise
+				orientation.
+	
+	@discussion	This is E3Triangle_CrossProductArray, split across threads
+				when there are enough triangles to make that worthwhile.
+	
+	@param		inNumTriangles	Number of triangles.
+	@param		inTriangles		Triangles.
+	@param		inPoints		Points referenced by the triangles.
+	@param		outNormals		Receives inNumTriangles normals.
+*/
+void E3TriMesh_ComputeTriangleNormals( TQ3Uns32 inNumTriangles,
+								const TQ3TriMeshTriangleData* inTriangles,
+								const TQ3Point3D* inPoints,
+								TQ3Vector3D* outNormals )
+{
+	E3Parallel_For( inNumTriangles, kMinTrianglesPerTask,
+		[=]( TQ3Uns32 inStart, TQ3Uns32 inEnd )
+		{
+			E3Triangle_CrossProductArray( inEnd - inStart, nullptr,
+				inTriangles[ inStart ].pointIndices, inPoints,
+				&outNormals[ inStart ] );
+		} );
+}
+
+
+
+
+
+/*!
+	@function	E3TriMesh_AddVertexNormals
+	
+	@abstract	Add vertex normals to a TriMesh that lacks them.
+	
+	@discussion	See the header for details.
+	
+	@param		inTriMesh		A TriMesh geometry.
+	@param		inCreaseAngle	Largest angle in radians between triangles
+								that are smoothed together.
+	@result		Success or failure of the operation.
+*/
+TQ3Status E3TriMesh_AddVertexNormals( TQ3GeometryObject inTriMesh,
+								float inCreaseAngle )
+{
+	TQ3TriMeshData* theData = nullptr;
+	
+	// Look before taking a write lock, which would copy shared data
+	if (kQ3Failure == E3TriMesh_LockData( inTriMesh, kQ3True, &theData ))
+	{
+		return kQ3Failure;
+	}
+	bool hasNormals = (nullptr != FindAttribute( theData->numVertexAttributeTypes,
+		theData->vertexAttributeTypes, kQ3AttributeTypeNormal ));
+	bool isValid = true;
+	for (TQ3Uns32 i = 0; isValid && (i < theData->numTriangles); ++i)
+	{
+		for (TQ3Uns32 k = 0; k < 3; ++k)
+		{
+			if (theData->triangles[i].pointIndices[k] >= theData->numPoints)
+			{
+				isValid = false;
+			}
+		}
+	}
+	E3TriMesh_UnlockData( inTriMesh );
+	
+	if (! isValid)
+	{
+		E3ErrorManager_PostError( kQ3ErrorTriMeshPointIndexOutOfRange, kQ3False );
+		return kQ3Failure;
+	}
+	if (hasNormals || (theData->numPoints == 0))
+	{
+		return kQ3Success;
+	}
+	
+	TQ3Status theStatus = kQ3Success;
+	if (kQ3Failure == E3TriMesh_LockData( inTriMesh, kQ3False, &theData ))
+	{
+		return kQ3Failure;
+	}
+	
+	try
+	{
+		AddVertexNormalsToData( *theData, inCreaseAngle );
+	}
+	catch (const std::bad_alloc&)
+	{
+		E3ErrorManager_PostError( kQ3ErrorOutOfMemory, kQ3False );
+		theStatus = kQ3Failure;
+	}
+	catch (...)
+	{
+		theStatus = kQ3Failure;
+	}
+	
+	if (kQ3Failure == E3TriMesh_UnlockData( inTriMesh ))
+	{
+		theStatus = kQ3Failure;
+	}
+	
+	return theStatus;
+}
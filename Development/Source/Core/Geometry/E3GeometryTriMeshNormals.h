@@ -0,0 +1,104 @@
+#pragma once
+/*  NAME:
+        E3GeometryTriMeshNormals.h
+
+    DESCRIPTION:
+        Header file for E3GeometryTriMeshNormals.cpp.
+
+    COPYRIGHT:
+        Copyright (c) 2025, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+
+
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "E3Prefix.h"
+
+
+
+//=============================================================================
+//      Function prototypes
+//-----------------------------------------------------------------------------
+
+
+/*!
+	@function	E3TriMesh_ComputeTriangleNormals
+	
+	@abstract	Compute unit normals of triangles, assuming counterclockwise
+				orientation.
+	
+	@discussion	This is E3Triangle_CrossProductArray, split across threads
+				when there are enough triangles to make that worthwhile.
+	
+	@param		inNumTriangles	Number of triangles.
+	@param		inTriangles		Triangles.
+	@param		inPoints		Points referenced by the triangles.
+	@param		outNormals		Receives inNumTriangles normals.
+*/
+void E3TriMesh_ComputeTriangleNormals( TQ3Uns32 inNumTriangles,
+								const TQ3TriMeshTriangleData* inTriangles,
+								const TQ3Point3D* inPoints,
+								TQ3Vector3D* outNormals );
+
+
+/*!
+	@function	E3TriMesh_AddVertexNormals
+	
+	@abstract	Add vertex normals to a TriMesh that lacks them.
+	
+	@discussion	Each corner of each triangle gets the average of the normals
+				of the triangles around its point which are within
+				inCreaseAngle of its own triangle, weighted by the angle of
+				each triangle at the point.  Points with the same location are
+				smoothed together, so texture seams do not show as creases.
+				A point whose corners get different normals is duplicated,
+				along with its vertex attributes.
+				
+				Triangle normals are used if the TriMesh has them, otherwise
+				they are computed assuming counterclockwise orientation.
+				The work is split across threads for large TriMeshes.
+				
+				If the TriMesh already has vertex normals, nothing is done.
+	
+	@param		inTriMesh		A TriMesh geometry.
+	@param		inCreaseAngle	Largest angle in radians between triangles
+								that are smoothed together.  An angle of
+								kQ3Pi or more smooths every point.
+	@result		Success or failure of the operation.
+*/
+TQ3Status E3TriMesh_AddVertexNormals( TQ3GeometryObject inTriMesh,
+								float inCreaseAngle );
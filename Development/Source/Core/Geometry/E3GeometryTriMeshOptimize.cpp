@@ -5,7 +5,7 @@
         Functions to optimize a TriMesh for use by the interactive renderer.
 
     COPYRIGHT:
-        Copyright (c) 2005-2014, Quesa Developers. All rights reserved.
+        Copyright (c) 2005-2025, Quesa Developers. All rights reserved.
 
         For the current release of Quesa, please see:
 
@@ -50,6 +50,9 @@
 
 #include <vector>
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
 
 #define	EQ3ThrowIfMemFail_( x )		do { if ( (x) == nullptr ) { \
 										throw std::bad_alloc();	\
@@ -88,6 +91,18 @@
 	necessary, and which could not be accelerated using triangle strips.  Thus,
 	when two instances refer to the same point, we must treat them as the same
 	vertex unless there is a specific reason not to, such as a color conflict.
+	
+	Each instance is matched with the most recent earlier instance of the same
+	point that is similar to it.  Usually a point has only a few instances, and
+	we just walk back through them.  That gets slow when a point has many
+	instances, such as the center of a fan of facets, so instances of such
+	points are filed in cells keyed by the point and by the attribute values
+	that decide similarity, rounded to a grid.  The grid is much coarser than the
+	similarity tolerances, so an instance only needs to look in its own cell,
+	plus the neighboring cell in any dimension where its value is within
+	tolerance of the edge of a cell.  Candidates found that way are still
+	checked with AreInstancesSimilar, so the results are the same as checking
+	every earlier instance.
 */
 
 namespace
@@ -116,6 +131,55 @@ namespace
 		OwnerType	mType;
 		TQ3Int32	mIndex;
 	};
+	
+	// Points with more instances than this are searched using cells
+	const TQ3Int32	kMaxInstancesToWalk		= 32;
+	
+	// Normal vector and 3 colors
+	const TQ3Uns32	kMaxKeyDimensions		= 12;
+	
+	// Normals closer than this in each coordinate may be similar, if their
+	// lengths are within kUnitLengthSquaredTolerance of 1.
+	const double	kNormalCellsPerUnit		= 16.0;
+	const double	kNormalTolerance		= 0.005;
+	const float		kUnitLengthSquaredTolerance	= 1.0e-5f;
+	
+	// Similar colors differ by less than FLT_EPSILON in each component.
+	// Clamping does not bring colors further apart, and keeps cell numbers
+	// exact.
+	const double	kColorCellsPerUnit		= 256.0;
+	const double	kColorTolerance			= 2.0 * FLT_EPSILON;
+	const double	kMaxColorValue			= 1048576.0;
+	
+	struct InstanceKey
+	{
+		TQ3Int32		mPoint;
+		std::int64_t	mCells[ kMaxKeyDimensions ];
+		
+		bool			operator==( const InstanceKey& inOther ) const
+						{
+							return (mPoint == inOther.mPoint) &&
+								std::equal( mCells, mCells + kMaxKeyDimensions,
+									inOther.mCells );
+						}
+	};
+	
+	struct InstanceKeyHash
+	{
+		std::size_t		operator()( const InstanceKey& inKey ) const
+						{
+							std::uint64_t h = static_cast<std::uint32_t>( inKey.mPoint );
+							for (std::int64_t aCell : inKey.mCells)
+							{
+								h = (h ^ static_cast<std::uint64_t>( aCell )) *
+									0x9E3779B97F4A7C15ULL;
+								h ^= h >> 29;
+							}
+							return static_cast<std::size_t>( h );
+						}
+	};
+	
+	typedef std::unordered_map< InstanceKey, TQ3Int32, InstanceKeyHash >	InstanceCellMap;
 
 	class TriMeshOptimizer
 	{
@@ -132,6 +196,10 @@ namespace
 		void					EnsureFaceNormals();
 		void					MakeInstanceToPoint();
 		void					FindBackLinks();
+		void					FindKeyDimensions();
+		TQ3Uns32				GetKeyValues( TQ3Int32 inInstance,
+									double* outValues ) const;
+		TQ3Int32				FindPrevSimilarInstanceInCells( TQ3Int32 inPtInstanceIndex );
 		bool					AreInstancesSimilar( TQ3Int32 inPt1, TQ3Int32 inPt2 );
 		TQ3Int32				FindPrevSimilarInstance( TQ3Int32 inPtInstanceIndex );
 		void					FindDistinctVertices();
@@ -171,6 +239,13 @@ namespace
 		const TQ3Vector3D*		mResultFaceNormals;
 		IntVec					mInstanceToPoint;
 		IntVec					mPrevPointInstance;
+		IntVec					mPointInstanceCount;
+		IntVec					mPrevCellInstance;
+		InstanceCellMap			mLastCellInstance;
+		bool					mKeyHasNormal;
+		bool					mKeyHasDiffColor;
+		bool					mKeyHasTransColor;
+		bool					mKeyHasSpecColor;
 		IntVec					mInstanceToVertex;
 		IntVec					mVertexToPoint;
 		std::vector<Owner>		mVertexToOwner;
@@ -199,6 +274,11 @@ TriMeshOptimizer::TriMeshOptimizer(
 	, mOrigVertexSpecularColor( nullptr )
 	
 	, mResultFaceNormals( nullptr )
+	
+	, mKeyHasNormal( false )
+	, mKeyHasDiffColor( false )
+	, mKeyHasTransColor( false )
+	, mKeyHasSpecColor( false )
 {
 }
 
@@ -213,6 +293,7 @@ TQ3Boolean		TriMeshOptimizer::Optimize()
 		EnsureFaceNormals();
 		MakeInstanceToPoint();
 		FindBackLinks();
+		FindKeyDimensions();
 		FindDistinctVertices();
 		BuildNewTriMesh();
 	}
@@ -419,13 +500,14 @@ TQ3ColorRGB	TriMeshOptimizer::GetTransColorFromOwner( const Owner& inOwner ) con
 	@abstract	For each point instance in mInstanceToPoint, find the previous instance
 				of the same point and record its index within mInstanceToPoint in an
 				array mPrevPointInstance.  When there is no previous instance,
-				record -1.
+				record -1.  Also count the instances of each point.
 */
 void	TriMeshOptimizer::FindBackLinks()
 {
 	const TQ3Int32 kNumCoordIndices = static_cast<TQ3Int32>(mInstanceToPoint.size());
 	mPrevPointInstance.resize( kNumCoordIndices, -1 );
 	IntVec	mostRecentPointInstance( mOrigData.numPoints, -1 );
+	mPointInstanceCount.resize( mOrigData.numPoints, 0 );
 	
 	for (TQ3Int32 i = 0; i < kNumCoordIndices; ++i)
 	{
@@ -439,7 +521,89 @@ void	TriMeshOptimizer::FindBackLinks()
 			mPrevPointInstance[i] = -1;
 		}
 		mostRecentPointInstance[ pointIndex ] = i;
+		mPointInstanceCount[ pointIndex ] += 1;
+	}
+}
+
+/*!
+	@function	FindKeyDimensions
+	
+	@abstract	Decide which attribute values are used to file instances in
+				cells, namely those that AreInstancesSimilar compares.
+	
+	@discussion	A bound on how far apart similar normals can be only exists
+				for unit vectors, so if any normal that would be filed is not
+				close to unit length, normals are left out of the key.
+*/
+void	TriMeshOptimizer::FindKeyDimensions()
+{
+	mKeyHasNormal = (mOrigVertexNormals == nullptr);
+	mKeyHasDiffColor = (mOrigFaceColor != nullptr) && (mOrigVertexColor == nullptr);
+	mKeyHasTransColor = (mOrigFaceTransparency != nullptr) && (mOrigVertexTransparency == nullptr);
+	mKeyHasSpecColor = (mOrigFaceSpecularColor != nullptr) && (mOrigVertexSpecularColor == nullptr);
+	
+	const TQ3Int32 kNumInstances = static_cast<TQ3Int32>(mInstanceToPoint.size());
+	for (TQ3Int32 i = 0; mKeyHasNormal && (i < kNumInstances); ++i)
+	{
+		if (mPointInstanceCount[ mInstanceToPoint[i] ] <= kMaxInstancesToWalk)
+		{
+			continue;
+		}
+		TQ3Vector3D	theNormal( GetNormalFromOwner( GetOwnerOfInstance( i ) ) );
+		float	lenSq = Q3FastVector3D_LengthSquared( &theNormal );
+		
+		if ( ! (fabsf( lenSq - 1.0f ) <= kUnitLengthSquaredTolerance) )
+		{
+			mKeyHasNormal = false;
+		}
+	}
+	
+	mPrevCellInstance.resize( kNumInstances, -1 );
+}
+
+/*!
+	@function	GetKeyValues
+	
+	@abstract	Get the attribute values used to file an instance in a cell.
+	
+	@result		Number of values.
+*/
+TQ3Uns32	TriMeshOptimizer::GetKeyValues( TQ3Int32 inInstance,
+											double* outValues ) const
+{
+	Owner	theOwner( GetOwnerOfInstance( inInstance ) );
+	TQ3Uns32	numValues = 0;
+	
+	if (mKeyHasNormal)
+	{
+		TQ3Vector3D	theNormal( GetNormalFromOwner( theOwner ) );
+		outValues[ numValues++ ] = theNormal.x;
+		outValues[ numValues++ ] = theNormal.y;
+		outValues[ numValues++ ] = theNormal.z;
+	}
+	
+	TQ3ColorRGB	theColors[3];
+	TQ3Uns32	numColors = 0;
+	if (mKeyHasDiffColor)
+	{
+		theColors[ numColors++ ] = GetDiffColorFromOwner( theOwner );
+	}
+	if (mKeyHasTransColor)
+	{
+		theColors[ numColors++ ] = GetTransColorFromOwner( theOwner );
+	}
+	if (mKeyHasSpecColor)
+	{
+		theColors[ numColors++ ] = GetSpecColorFromOwner( theOwner );
+	}
+	for (TQ3Uns32 i = 0; i < numColors; ++i)
+	{
+		outValues[ numValues++ ] = theColors[i].r;
+		outValues[ numValues++ ] = theColors[i].g;
+		outValues[ numValues++ ] = theColors[i].b;
 	}
+	
+	return numValues;
 }
 
 static bool IsSameColor( const TQ3ColorRGB& inOne, const TQ3ColorRGB& inTwo )
@@ -506,6 +670,110 @@ bool	TriMeshOptimizer::AreInstancesSimilar( TQ3Int32 inPt1, TQ3Int32 inPt2 )
 	return isSame;
 }
 
+/*!
+	@function	FindPrevSimilarInstanceInCells
+	
+	@abstract	Given an instance of a point with many instances, find the
+				most recent previous instance of the same point that can be
+				considered to be the same vertex, then file the instance in its
+				cell.
+	
+	@discussion	Instances must be passed in increasing order.  Cells are
+				centered on multiples of the cell size, so that values such as
+				0, 0.5 and 1 are not near the edges of cells.
+*/
+TQ3Int32	TriMeshOptimizer::FindPrevSimilarInstanceInCells( TQ3Int32 inPtInstanceIndex )
+{
+	double	values[ kMaxKeyDimensions ];
+	TQ3Uns32	numValues = GetKeyValues( inPtInstanceIndex, values );
+	const TQ3Uns32	kNumNormalValues = mKeyHasNormal? 3 : 0;
+	
+	InstanceKey	theKey;
+	theKey.mPoint = mInstanceToPoint[ inPtInstanceIndex ];
+	std::fill( theKey.mCells, theKey.mCells + kMaxKeyDimensions, 0 );
+	
+	TQ3Uns32		altDims[ kMaxKeyDimensions ];
+	std::int64_t	altCells[ kMaxKeyDimensions ];
+	TQ3Uns32		numAlts = 0;
+	
+	for (TQ3Uns32 i = 0; i < numValues; ++i)
+	{
+		double	cellsPerUnit, tolerance;
+		if (i < kNumNormalValues)
+		{
+			cellsPerUnit = kNormalCellsPerUnit;
+			tolerance = kNormalTolerance;
+		}
+		else if (std::isfinite( values[i] ))
+		{
+			cellsPerUnit = kColorCellsPerUnit;
+			tolerance = kColorTolerance;
+			values[i] = std::max( -kMaxColorValue, std::min( kMaxColorValue, values[i] ) );
+		}
+		else
+		{
+			// A color that is not finite is not similar to any other
+			theKey.mCells[i] = INT64_MIN;
+			continue;
+		}
+		
+		double	cellCoord = values[i] * cellsPerUnit + 0.5;
+		double	cellFloor = floor( cellCoord );
+		theKey.mCells[i] = static_cast<std::int64_t>( cellFloor );
+		
+		double	fromEdge = (cellCoord - cellFloor) / cellsPerUnit;
+		if (fromEdge <= tolerance)
+		{
+			altDims[ numAlts ] = i;
+			altCells[ numAlts++ ] = theKey.mCells[i] - 1;
+		}
+		else if (1.0 / cellsPerUnit - fromEdge <= tolerance)
+		{
+			altDims[ numAlts ] = i;
+			altCells[ numAlts++ ] = theKey.mCells[i] + 1;
+		}
+	}
+	
+	// Search the cell of the instance, and neighboring cells where the
+	// instance is close to the edge.
+	TQ3Int32	prevSimilarIndex = -1;
+	const TQ3Uns32	kNumCellsToSearch = 1U << numAlts;
+	for (TQ3Uns32 cellNum = 0; cellNum < kNumCellsToSearch; ++cellNum)
+	{
+		InstanceKey	searchKey( theKey );
+		for (TQ3Uns32 j = 0; j < numAlts; ++j)
+		{
+			if ( (cellNum & (1U << j)) != 0 )
+			{
+				searchKey.mCells[ altDims[j] ] = altCells[j];
+			}
+		}
+		
+		InstanceCellMap::const_iterator	found = mLastCellInstance.find( searchKey );
+		if (found != mLastCellInstance.end())
+		{
+			for (TQ3Int32 prevIndex = found->second;
+				prevIndex > prevSimilarIndex;
+				prevIndex = mPrevCellInstance[ prevIndex ])
+			{
+				if (AreInstancesSimilar( inPtInstanceIndex, prevIndex ))
+				{
+					prevSimilarIndex = prevIndex;
+					break;
+				}
+			}
+		}
+	}
+	
+	// File this instance in its own cell
+	TQ3Int32&	lastInCell( mLastCellInstance.insert(
+		InstanceCellMap::value_type( theKey, -1 ) ).first->second );
+	mPrevCellInstance[ inPtInstanceIndex ] = lastInCell;
+	lastInCell = inPtInstanceIndex;
+	
+	return prevSimilarIndex;
+}
+
 /*!
 	@function	FindPrevSimilarInstance
 	
@@ -515,6 +783,11 @@ bool	TriMeshOptimizer::AreInstancesSimilar( TQ3Int32 inPt1, TQ3Int32 inPt2 )
 */
 TQ3Int32	TriMeshOptimizer::FindPrevSimilarInstance( TQ3Int32 inPtInstanceIndex )
 {
+	if (mPointInstanceCount[ mInstanceToPoint[ inPtInstanceIndex ] ] > kMaxInstancesToWalk)
+	{
+		return FindPrevSimilarInstanceInCells( inPtInstanceIndex );
+	}
+	
 	TQ3Int32	prevSimilarIndex = -1;
 	TQ3Int32	prevIndex;
 	for (prevIndex = mPrevPointInstance[ inPtInstanceIndex ];
@@ -0,0 +1,967 @@
+/*  NAME:
+        E3GeometryTriMeshRenderOrder.cpp
+
+    DESCRIPTION:
+        Reorders TriMesh triangles and points for efficient drawing.
+
+    COPYRIGHT:
+        Copyright (c) 2025, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+#include "E3GeometryTriMeshRenderOrder.h"
+
+#include "E3Memory.h"
+#include "E3Set.h"
+#include "E3ClassTree.h"
+#include "QuesaMath.h"
+#include "QuesaMathOperators.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#define	EQ3ThrowIfMemFail_( x )		do { if ( (x) == nullptr ) { \
+										throw std::bad_alloc();	\
+										} } while (false)
+
+#define	EQ3ThrowIf_( x )			do { if ( (x) ) { \
+										throw std::exception();	\
+										} } while (false)
+
+/*
+	DISCUSSION
+	
+	A GPU keeps the last few vertices it has transformed in a post-transform
+	cache, and an indexed triangle which refers to a cached vertex does not
+	transform it again.  The number of vertices transformed per triangle, the
+	ACMR, is therefore the measure of a triangle order.  Triangle strips only
+	help by accident of their order, so we reorder the triangle list itself.
+	
+	The vertex cache step is the greedy method of Tom Forsyth's "Linear-Speed
+	Vertex Cache Optimisation".  Each vertex is scored by its position in a
+	simulated LRU cache and by how many triangles still need it, and we always
+	emit the best scoring triangle that uses a cached vertex.  Giving a boost
+	to vertices with few remaining triangles finishes off small regions rather
+	than leaving isolated triangles for later.
+	
+	The overdraw step follows Sander, Nehab and Barczak, "Fast Triangle
+	Reordering for Vertex Locality and Reduced Overdraw".  The cache order is
+	cut into clusters wherever the cache would be empty anyway, and further
+	wherever the ACMR of a cluster so far is close to that of the whole run.
+	Clusters can then be drawn in any order without losing much of the cache
+	benefit, and we draw those facing away from the center of the mesh first,
+	since they are more likely to hide the others.
+	
+	The vertex fetch step numbers points in the order that triangles first
+	use them, so that vertex data is read from memory in order.
+*/
+
+namespace
+{
+	typedef std::vector< TQ3Uns32 >		UnsVec;
+	
+	// Vertex cache step
+	const TQ3Uns32		kScoreCacheSize			= 32;
+	const float			kCacheDecayPower		= 1.5f;
+	const float			kLastTriangleScore		= 0.75f;
+	const float			kValenceBoostScale		= 2.0f;
+	const float			kValenceBoostPower		= 0.5f;
+	const TQ3Uns32		kMaxScoredValence		= 32;
+	
+	// Overdraw step
+	const TQ3Uns32		kClusterCacheSize		= 16;
+	const float			kClusterThreshold		= 1.05f;
+}
+
+
+
+
+
+//=============================================================================
+//      Internal functions
+//-----------------------------------------------------------------------------
+
+/*!
+	@function	CheckIndices
+	@abstract	Throw if a triangle or edge refers to a point that does not
+				exist.
+*/
+static void CheckIndices( const TQ3TriMeshData& inData )
+{
+	for (TQ3Uns32 i = 0; i < inData.numTriangles; ++i)
+	{
+		for (TQ3Uns32 k = 0; k < 3; ++k)
+		{
+			EQ3ThrowIf_( inData.triangles[i].pointIndices[k] >= inData.numPoints );
+		}
+	}
+	
+	for (TQ3Uns32 i = 0; i < inData.numEdges; ++i)
+	{
+		EQ3ThrowIf_( (inData.edges[i].pointIndices[0] >= inData.numPoints) ||
+			(inData.edges[i].pointIndices[1] >= inData.numPoints) );
+	}
+}
+
+
+
+
+
+/*!
+	@function	CountCacheMisses
+	@abstract	Feed triangles through a first-in first-out vertex cache,
+				and count the vertices each one transforms.
+	@discussion	The cache is simulated with a time stamp per point, which
+				records when the point last entered the cache.  The caller
+				empties the cache by advancing ioTime by more than the cache
+				size.
+*/
+static TQ3Uns32 CountCacheMisses( const TQ3TriMeshTriangleData& inTriangle,
+								TQ3Uns32 inCacheSize,
+								UnsVec& ioEntryTime,
+								TQ3Uns32& ioTime )
+{
+	TQ3Uns32 numMisses = 0;
+	
+	for (TQ3Uns32 k = 0; k < 3; ++k)
+	{
+		TQ3Uns32 thePoint = inTriangle.pointIndices[k];
+		
+		if (ioTime - ioEntryTime[ thePoint ] > inCacheSize)
+		{
+			ioEntryTime[ thePoint ] = ioTime++;
+			numMisses += 1;
+		}
+	}
+	
+	return numMisses;
+}
+
+
+
+
+
+/*!
+	@function	OrderForVertexCache
+	@abstract	Order triangles to make good use of a vertex cache.
+	@discussion	See Tom Forsyth, "Linear-Speed Vertex Cache Optimisation".
+*/
+static void OrderForVertexCache( const TQ3TriMeshData& inData, UnsVec& outOrder )
+{
+	const TQ3Uns32 kNumTriangles = inData.numTriangles;
+	const TQ3Uns32 kNumPoints    = inData.numPoints;
+	TQ3Uns32 i, k;
+	
+	
+	
+	// Tabulate the parts of the vertex score
+	float	cacheScores[ kScoreCacheSize ];
+	float	valenceScores[ kMaxScoredValence ];
+	
+	for (i = 0; i < kScoreCacheSize; ++i)
+	{
+		if (i < 3)
+			cacheScores[i] = kLastTriangleScore;
+		else
+			cacheScores[i] = powf( 1.0f - (i - 3) / (float) (kScoreCacheSize - 3),
+				kCacheDecayPower );
+	}
+	
+	valenceScores[0] = 0.0f;
+	for (i = 1; i < kMaxScoredValence; ++i)
+	{
+		valenceScores[i] = kValenceBoostScale * powf( (float) i, -kValenceBoostPower );
+	}
+	
+	
+	
+	// List the triangles which use each point.  The triangles that remain
+	// to be emitted are kept at the start of each point's range.
+	UnsVec	numRemaining( kNumPoints, 0 );
+	UnsVec	firstTriangle( kNumPoints + 1, 0 );
+	UnsVec	pointTriangles( 3 * kNumTriangles );
+	
+	for (i = 0; i < kNumTriangles; ++i)
+	{
+		for (k = 0; k < 3; ++k)
+			numRemaining[ inData.triangles[i].pointIndices[k] ] += 1;
+	}
+	
+	for (i = 0; i < kNumPoints; ++i)
+		firstTriangle[ i + 1 ] = firstTriangle[i] + numRemaining[i];
+	
+	UnsVec	fillPosition( firstTriangle.begin(), firstTriangle.end() - 1 );
+	for (i = 0; i < kNumTriangles; ++i)
+	{
+		for (k = 0; k < 3; ++k)
+			pointTriangles[ fillPosition[ inData.triangles[i].pointIndices[k] ]++ ] = i;
+	}
+	
+	
+	
+	// Score the points
+	std::vector<TQ3Int32>	cachePosition( kNumPoints, -1 );
+	std::vector<float>		pointScores( kNumPoints );
+	
+	auto scorePoint = [&]( TQ3Uns32 inPoint ) -> float
+	{
+		if (numRemaining[ inPoint ] == 0)
+			return -1.0f;
+		
+		float theScore = valenceScores[ std::min( numRemaining[ inPoint ], kMaxScoredValence - 1 ) ];
+		
+		if (cachePosition[ inPoint ] >= 0)
+			theScore += cacheScores[ cachePosition[ inPoint ] ];
+		
+		return theScore;
+	};
+	
+	auto scoreTriangle = [&]( TQ3Uns32 inTriangle ) -> float
+	{
+		const TQ3Uns32* indices = inData.triangles[ inTriangle ].pointIndices;
+		
+		return pointScores[ indices[0] ] + pointScores[ indices[1] ] + pointScores[ indices[2] ];
+	};
+	
+	for (i = 0; i < kNumPoints; ++i)
+		pointScores[i] = scorePoint( i );
+	
+	
+	
+	// Start with the best triangle of all
+	std::vector<bool>	isEmitted( kNumTriangles, false );
+	TQ3Uns32			bestTriangle = kQ3ArrayIndexNULL;
+	float				bestScore = -1.0f;
+	TQ3Uns32			nextUnemitted = 0;
+	
+	for (i = 0; i < kNumTriangles; ++i)
+	{
+		float theScore = scoreTriangle( i );
+		if (theScore > bestScore)
+		{
+			bestScore = theScore;
+			bestTriangle = i;
+		}
+	}
+	
+	TQ3Uns32	theCache[ kScoreCacheSize + 3 ];
+	TQ3Uns32	newCache[ kScoreCacheSize + 3 ];
+	TQ3Uns32	cacheSize = 0;
+	
+	outOrder.clear();
+	outOrder.reserve( kNumTriangles );
+	
+	
+	
+	// Emit triangles
+	while (outOrder.size() < kNumTriangles)
+	{
+		// If no triangle uses a cached point, take the next one not yet
+		// emitted
+		if (bestTriangle == kQ3ArrayIndexNULL)
+		{
+			while (isEmitted[ nextUnemitted ])
+				++nextUnemitted;
+			
+			bestTriangle = nextUnemitted;
+		}
+		
+		outOrder.push_back( bestTriangle );
+		isEmitted[ bestTriangle ] = true;
+		const TQ3Uns32* indices = inData.triangles[ bestTriangle ].pointIndices;
+		
+		
+		// Take the triangle off the lists of its points
+		for (k = 0; k < 3; ++k)
+		{
+			TQ3Uns32 thePoint = indices[k];
+			TQ3Uns32* theList = &pointTriangles[ firstTriangle[ thePoint ] ];
+			TQ3Uns32 listSize = numRemaining[ thePoint ];
+			
+			for (i = 0; i < listSize; ++i)
+			{
+				if (theList[i] == bestTriangle)
+				{
+					std::swap( theList[i], theList[ listSize - 1 ] );
+					numRemaining[ thePoint ] -= 1;
+					break;
+				}
+			}
+		}
+		
+		
+		// Move the points of the triangle to the front of the cache
+		TQ3Uns32 newSize = 0;
+		for (k = 0; k < 3; ++k)
+		{
+			if (std::find( newCache, newCache + newSize, indices[k] ) == newCache + newSize)
+				newCache[ newSize++ ] = indices[k];
+		}
+		
+		for (i = 0; i < cacheSize; ++i)
+		{
+			if ( (theCache[i] != indices[0]) && (theCache[i] != indices[1]) &&
+				(theCache[i] != indices[2]) )
+				newCache[ newSize++ ] = theCache[i];
+		}
+		
+		for (i = kScoreCacheSize; i < newSize; ++i)
+		{
+			cachePosition[ newCache[i] ] = -1;
+			pointScores[ newCache[i] ] = scorePoint( newCache[i] );
+		}
+		
+		cacheSize = std::min( newSize, kScoreCacheSize );
+		for (i = 0; i < cacheSize; ++i)
+		{
+			theCache[i] = newCache[i];
+			cachePosition[ theCache[i] ] = (TQ3Int32) i;
+			pointScores[ theCache[i] ] = scorePoint( theCache[i] );
+		}
+		
+		
+		// Find the best triangle which uses a cached point
+		bestTriangle = kQ3ArrayIndexNULL;
+		bestScore = -1.0f;
+		
+		for (i = 0; i < cacheSize; ++i)
+		{
+			TQ3Uns32 thePoint = theCache[i];
+			const TQ3Uns32* theList = &pointTriangles[ firstTriangle[ thePoint ] ];
+			
+			for (k = 0; k < numRemaining[ thePoint ]; ++k)
+			{
+				float theScore = scoreTriangle( theList[k] );
+				if (theScore > bestScore)
+				{
+					bestScore = theScore;
+					bestTriangle = theList[k];
+				}
+			}
+		}
+	}
+}
+
+
+
+
+
+/*!
+	@function	OrderForOverdraw
+	@abstract	Reorder clusters of triangles so that those facing away from
+				the center of the mesh come first.
+	@discussion	See Sander, Nehab and Barczak, "Fast Triangle Reordering for
+				Vertex Locality and Reduced Overdraw".
+*/
+static void OrderForOverdraw( const TQ3TriMeshData& inData, UnsVec& ioOrder )
+{
+	const TQ3Uns32 kNumTriangles = static_cast<TQ3Uns32>( ioOrder.size() );
+	UnsVec	entryTime( inData.numPoints, 0 );
+	UnsVec	hardStarts, clusterStarts;
+	TQ3Uns32 theTime = kClusterCacheSize + 1;
+	TQ3Uns32 i;
+	
+	
+	
+	// Cut the order where a triangle finds none of its points in the cache
+	for (i = 0; i < kNumTriangles; ++i)
+	{
+		if ( (CountCacheMisses( inData.triangles[ ioOrder[i] ], kClusterCacheSize,
+			entryTime, theTime ) == 3) || (i == 0) )
+			hardStarts.push_back( i );
+	}
+	hardStarts.push_back( kNumTriangles );
+	
+	
+	
+	// Cut each of those runs again where the ACMR of the cluster so far is
+	// close to that of the whole run.  Each cluster starts with an empty
+	// cache, as it may be drawn after any other.
+	for (TQ3Uns32 n = 0; n + 1 < hardStarts.size(); ++n)
+	{
+		TQ3Uns32 runStart = hardStarts[n];
+		TQ3Uns32 runEnd   = hardStarts[ n + 1 ];
+		TQ3Uns32 runMisses = 0;
+		
+		theTime += kClusterCacheSize + 1;
+		for (i = runStart; i < runEnd; ++i)
+		{
+			runMisses += CountCacheMisses( inData.triangles[ ioOrder[i] ],
+				kClusterCacheSize, entryTime, theTime );
+		}
+		
+		float threshold = kClusterThreshold * runMisses / (float) (runEnd - runStart);
+		TQ3Uns32 clusterMisses = 0;
+		TQ3Uns32 clusterSize = 0;
+		
+		clusterStarts.push_back( runStart );
+		theTime += kClusterCacheSize + 1;
+		for (i = runStart; i + 1 < runEnd; ++i)
+		{
+			clusterMisses += CountCacheMisses( inData.triangles[ ioOrder[i] ],
+				kClusterCacheSize, entryTime, theTime );
+			clusterSize += 1;
+			
+			if (clusterMisses <= threshold * clusterSize)
+			{
+				clusterStarts.push_back( i + 1 );
+				clusterMisses = 0;
+				clusterSize = 0;
+				theTime += kClusterCacheSize + 1;
+			}
+		}
+	}
+	clusterStarts.push_back( kNumTriangles );
+	
+	
+	
+	// Find the center of the mesh, and where each cluster lies and faces
+	// relative to it.  Centers are weighted by area.
+	const TQ3Uns32 kNumClusters = static_cast<TQ3Uns32>( clusterStarts.size() - 1 );
+	std::vector<TQ3Point3D>		clusterCenters( kNumClusters );
+	std::vector<TQ3Vector3D>	clusterNormals( kNumClusters );
+	TQ3Vector3D	meshCenterSum = { 0.0f, 0.0f, 0.0f };
+	float		meshArea = 0.0f;
+	
+	for (TQ3Uns32 n = 0; n < kNumClusters; ++n)
+	{
+		TQ3Vector3D centerSum = { 0.0f, 0.0f, 0.0f };
+		TQ3Vector3D normalSum = { 0.0f, 0.0f, 0.0f };
+		float		areaSum = 0.0f;
+		
+		for (i = clusterStarts[n]; i < clusterStarts[ n + 1 ]; ++i)
+		{
+			const TQ3Uns32* indices = inData.triangles[ ioOrder[i] ].pointIndices;
+			const TQ3Point3D& p0( inData.points[ indices[0] ] );
+			const TQ3Point3D& p1( inData.points[ indices[1] ] );
+			const TQ3Point3D& p2( inData.points[ indices[2] ] );
+			
+			TQ3Vector3D theNormal = Q3Cross3D( p1 - p0, p2 - p0 );
+			float theArea = Q3Length3D( theNormal );
+			TQ3Vector3D theCenter = {
+				(p0.x + p1.x + p2.x) / 3.0f,
+				(p0.y + p1.y + p2.y) / 3.0f,
+				(p0.z + p1.z + p2.z) / 3.0f };
+			
+			normalSum += theNormal;
+			centerSum += theArea * theCenter;
+			areaSum += theArea;
+		}
+		
+		meshCenterSum += centerSum;
+		meshArea += areaSum;
+		
+		if (areaSum > 0.0f)
+			centerSum = (1.0f / areaSum) * centerSum;
+		
+		clusterCenters[n] = { centerSum.x, centerSum.y, centerSum.z };
+		float normalLength = Q3Length3D( normalSum );
+		clusterNormals[n] = (normalLength > 0.0f) ? (1.0f / normalLength) * normalSum : normalSum;
+	}
+	
+	if (meshArea > 0.0f)
+		meshCenterSum = (1.0f / meshArea) * meshCenterSum;
+	
+	const TQ3Point3D meshCenter = { meshCenterSum.x, meshCenterSum.y, meshCenterSum.z };
+	
+	
+	
+	// Draw the clusters facing most outward first
+	std::vector<float>	clusterKeys( kNumClusters );
+	UnsVec				clusterOrder( kNumClusters );
+	
+	for (TQ3Uns32 n = 0; n < kNumClusters; ++n)
+	{
+		clusterKeys[n] = Q3Dot3D( clusterCenters[n] - meshCenter, clusterNormals[n] );
+		clusterOrder[n] = n;
+	}
+	
+	std::stable_sort( clusterOrder.begin(), clusterOrder.end(),
+		[&]( TQ3Uns32 inA, TQ3Uns32 inB ) { return clusterKeys[ inA ] > clusterKeys[ inB ]; } );
+	
+	UnsVec	newOrder;
+	newOrder.reserve( kNumTriangles );
+	
+	for (TQ3Uns32 theCluster : clusterOrder)
+	{
+		newOrder.insert( newOrder.end(), ioOrder.begin() + clusterStarts[ theCluster ],
+			ioOrder.begin() + clusterStarts[ theCluster + 1 ] );
+	}
+	
+	ioOrder.swap( newOrder );
+}
+
+
+
+
+
+/*!
+	@function	OrderForVertexFetch
+	@abstract	Order points as the triangles first use them.
+	@discussion	Points not used by any triangle keep their order at the end.
+*/
+static void OrderForVertexFetch( const TQ3TriMeshData& inData,
+								const UnsVec& inTriangleOrder,
+								UnsVec& outPointOrder )
+{
+	std::vector<bool>	isPlaced( inData.numPoints, false );
+	
+	outPointOrder.clear();
+	outPointOrder.reserve( inData.numPoints );
+	
+	for (TQ3Uns32 theTriangle : inTriangleOrder)
+	{
+		for (TQ3Uns32 k = 0; k < 3; ++k)
+		{
+			TQ3Uns32 thePoint = inData.triangles[ theTriangle ].pointIndices[k];
+			
+			if (! isPlaced[ thePoint ])
+			{
+				isPlaced[ thePoint ] = true;
+				outPointOrder.push_back( thePoint );
+			}
+		}
+	}
+	
+	for (TQ3Uns32 i = 0; i < inData.numPoints; ++i)
+	{
+		if (! isPlaced[i])
+			outPointOrder.push_back( i );
+	}
+}
+
+
+
+
+
+/*!
+	@function	GetAttributeSize
+	@abstract	Get the size of one value of an attribute type.
+*/
+static TQ3Uns32	GetAttributeSize( TQ3AttributeType inAttType )
+{
+	TQ3ObjectType	attType = E3Attribute_AttributeToClassType( inAttType );
+	E3ClassInfoPtr theClass = E3ClassTree::GetClass( attType );
+	EQ3ThrowIf_( theClass == nullptr );
+	TQ3Uns32 attrSize = theClass->GetInstanceSize();
+	return attrSize;
+}
+
+
+
+
+
+/*!
+	@function	CopyAttributes
+	@abstract	Copy an array of attribute data, with its values reordered.
+	@discussion	Value i of the result is value inOrder[i] of the source, or
+				value i if inOrder is nullptr.  The counts in the result are
+				only set once the memory they describe has been allocated, so
+				that it can be emptied after a failure.
+*/
+static void CopyAttributes( TQ3Uns32 inNumTypes,
+							const TQ3TriMeshAttributeData* inSrc,
+							TQ3Uns32 inNumElements,
+							const TQ3Uns32* inOrder,
+							TQ3Uns32& outNumTypes,
+							TQ3TriMeshAttributeData*& outDest )
+{
+	if (inNumTypes == 0)
+	{
+		return;
+	}
+	
+	outDest = static_cast<TQ3TriMeshAttributeData*>(
+		E3Memory_AllocateClear( inNumTypes * sizeof(TQ3TriMeshAttributeData) ) );
+	EQ3ThrowIfMemFail_( outDest );
+	outNumTypes = inNumTypes;
+	
+	for (TQ3Uns32 t = 0; t < inNumTypes; ++t)
+	{
+		const TQ3TriMeshAttributeData& theSrc( inSrc[t] );
+		TQ3TriMeshAttributeData& theDest( outDest[t] );
+		TQ3Uns32 attrSize = GetAttributeSize( theSrc.attributeType );
+		
+		if ( (inNumElements != 0) && (attrSize != 0) )
+		{
+			theDest.data = E3Memory_Allocate( inNumElements * attrSize );
+			EQ3ThrowIfMemFail_( theDest.data );
+			
+			const char* srcBytes = static_cast<const char*>( theSrc.data );
+			char* destBytes = static_cast<char*>( theDest.data );
+			
+			for (TQ3Uns32 i = 0; i < inNumElements; ++i)
+			{
+				TQ3Uns32 srcIndex = (inOrder == nullptr) ? i : inOrder[i];
+				E3Memory_Copy( srcBytes + srcIndex * attrSize, destBytes + i * attrSize,
+					attrSize );
+			}
+			
+			if (theSrc.attributeType == kQ3AttributeTypeSurfaceShader)
+			{
+				TQ3Object*	obArray = (TQ3Object*) theDest.data;
+				
+				for (TQ3Uns32 i = 0; i < inNumElements; ++i)
+				{
+					if (obArray[i] != nullptr)
+					{
+						Q3Shared_GetReference( obArray[i] );
+					}
+				}
+			}
+		}
+		
+		if ( (theSrc.attributeUseArray != nullptr) && (inNumElements != 0) )
+		{
+			theDest.attributeUseArray = static_cast<char*>( E3Memory_Allocate( inNumElements ) );
+			EQ3ThrowIfMemFail_( theDest.attributeUseArray );
+			
+			for (TQ3Uns32 i = 0; i < inNumElements; ++i)
+			{
+				TQ3Uns32 srcIndex = (inOrder == nullptr) ? i : inOrder[i];
+				theDest.attributeUseArray[i] = theSrc.attributeUseArray[ srcIndex ];
+			}
+		}
+		
+		// Set last, so that shaders are not released from a partial array
+		theDest.attributeType = theSrc.attributeType;
+	}
+}
+
+
+
+
+
+/*!
+	@function	BuildReorderedData
+	@abstract	Build TriMesh data with reordered triangles and points.
+	@param		inData				TriMesh data.
+	@param		inTriangleOrder		Old index of each new triangle.
+	@param		inPointOrder		Old index of each new point.
+	@param		outData				Receives new TriMesh data, which should be
+									cleared to zero beforehand.
+*/
+static void BuildReorderedData( const TQ3TriMeshData& inData,
+								const UnsVec& inTriangleOrder,
+								const UnsVec& inPointOrder,
+								TQ3TriMeshData& outData )
+{
+	UnsVec	newTriangleIndex( inData.numTriangles );
+	UnsVec	newPointIndex( inData.numPoints );
+	TQ3Uns32 i;
+	
+	for (i = 0; i < inData.numTriangles; ++i)
+		newTriangleIndex[ inTriangleOrder[i] ] = i;
+	
+	for (i = 0; i < inData.numPoints; ++i)
+		newPointIndex[ inPointOrder[i] ] = i;
+	
+	E3Shared_Acquire( &outData.triMeshAttributeSet, inData.triMeshAttributeSet );
+	outData.bBox = inData.bBox;
+	
+	
+	
+	// Triangles
+	if (inData.numTriangles != 0)
+	{
+		outData.triangles = static_cast<TQ3TriMeshTriangleData*>(
+			E3Memory_Allocate( inData.numTriangles * sizeof(TQ3TriMeshTriangleData) ) );
+		EQ3ThrowIfMemFail_( outData.triangles );
+		outData.numTriangles = inData.numTriangles;
+		
+		for (i = 0; i < inData.numTriangles; ++i)
+		{
+			const TQ3TriMeshTriangleData& oldTriangle( inData.triangles[ inTriangleOrder[i] ] );
+			
+			outData.triangles[i].pointIndices[0] = newPointIndex[ oldTriangle.pointIndices[0] ];
+			outData.triangles[i].pointIndices[1] = newPointIndex[ oldTriangle.pointIndices[1] ];
+			outData.triangles[i].pointIndices[2] = newPointIndex[ oldTriangle.pointIndices[2] ];
+		}
+	}
+	
+	CopyAttributes( inData.numTriangleAttributeTypes, inData.triangleAttributeTypes,
+		inData.numTriangles, inTriangleOrder.data(),
+		outData.numTriangleAttributeTypes, outData.triangleAttributeTypes );
+	
+	
+	
+	// Edges keep their order, but refer to the new points and triangles
+	if (inData.numEdges != 0)
+	{
+		outData.edges = static_cast<TQ3TriMeshEdgeData*>(
+			E3Memory_Allocate( inData.numEdges * sizeof(TQ3TriMeshEdgeData) ) );
+		EQ3ThrowIfMemFail_( outData.edges );
+		outData.numEdges = inData.numEdges;
+		
+		for (i = 0; i < inData.numEdges; ++i)
+		{
+			const TQ3TriMeshEdgeData& oldEdge( inData.edges[i] );
+			TQ3TriMeshEdgeData& newEdge( outData.edges[i] );
+			
+			for (TQ3Uns32 k = 0; k < 2; ++k)
+			{
+				newEdge.pointIndices[k] = newPointIndex[ oldEdge.pointIndices[k] ];
+				
+				if (oldEdge.triangleIndices[k] < inData.numTriangles)
+					newEdge.triangleIndices[k] = newTriangleIndex[ oldEdge.triangleIndices[k] ];
+				else
+					newEdge.triangleIndices[k] = oldEdge.triangleIndices[k];
+			}
+		}
+	}
+	
+	CopyAttributes( inData.numEdgeAttributeTypes, inData.edgeAttributeTypes,
+		inData.numEdges, nullptr,
+		outData.numEdgeAttributeTypes, outData.edgeAttributeTypes );
+	
+	
+	
+	// Points
+	if (inData.numPoints != 0)
+	{
+		outData.points = static_cast<TQ3Point3D*>(
+			E3Memory_Allocate( inData.numPoints * sizeof(TQ3Point3D) ) );
+		EQ3ThrowIfMemFail_( outData.points );
+		outData.numPoints = inData.numPoints;
+		
+		for (i = 0; i < inData.numPoints; ++i)
+			outData.points[i] = inData.points[ inPointOrder[i] ];
+	}
+	
+	CopyAttributes( inData.numVertexAttributeTypes, inData.vertexAttributeTypes,
+		inData.numPoints, inPointOrder.data(),
+		outData.numVertexAttributeTypes, outData.vertexAttributeTypes );
+}
+
+
+
+
+
+//=============================================================================
+//      Public functions
+//-----------------------------------------------------------------------------
+
+/*!
+	@function	E3TriMesh_OptimizeDataForRendering
+	
+	@abstract	Reorder TriMesh data for efficient drawing as an indexed
+				triangle list.
+	
+	@discussion	The steps to perform are chosen by inSteps:
+				<ol>
+					<li>The vertex cache step orders triangles so that each
+						reuses vertices which are likely to be in the
+						post-transform vertex cache of the GPU.</li>
+					<li>The overdraw step splits that order into clusters
+						which keep most of the cache benefit, and draws the
+						clusters facing away from the center of the mesh
+						first, so that hidden surfaces are more often
+						rejected by the depth test.</li>
+					<li>The vertex fetch step renumbers points in the order
+						that the triangles first use them.</li>
+				</ol>
+				
+				Attributes and edges are carried along with the triangles
+				and points they belong to, so the result renders the same as
+				the original.  You are responsible for calling
+				Q3TriMesh_EmptyData on the outData structure when you are
+				done with it.
+	
+	@param		inData			TriMesh data.
+	@param		inSteps			A combination of TQ3TriMeshRenderOrderMasks.
+	@param		outData			Receives new TriMesh data.
+	@result		Success or failure of the operation.
+*/
+TQ3Status E3TriMesh_OptimizeDataForRendering( const TQ3TriMeshData& inData,
+								TQ3TriMeshRenderOrderMask inSteps,
+								TQ3TriMeshData& outData )
+{
+	TQ3Status	theStatus = kQ3Success;
+	E3Memory_Clear( &outData, sizeof(TQ3TriMeshData) );
+	
+	try
+	{
+		CheckIndices( inData );
+		
+		UnsVec	triangleOrder, pointOrder;
+		
+		if ( (inSteps & kQ3TriMeshRenderOrderMaskVertexCache) != 0 )
+		{
+			OrderForVertexCache( inData, triangleOrder );
+		}
+		else
+		{
+			triangleOrder.resize( inData.numTriangles );
+			for (TQ3Uns32 i = 0; i < inData.numTriangles; ++i)
+				triangleOrder[i] = i;
+		}
+		
+		if ( ((inSteps & kQ3TriMeshRenderOrderMaskOverdraw) != 0) &&
+			(inData.numTriangles != 0) )
+		{
+			OrderForOverdraw( inData, triangleOrder );
+		}
+		
+		if ( (inSteps & kQ3TriMeshRenderOrderMaskVertexFetch) != 0 )
+		{
+			OrderForVertexFetch( inData, triangleOrder, pointOrder );
+		}
+		else
+		{
+			pointOrder.resize( inData.numPoints );
+			for (TQ3Uns32 i = 0; i < inData.numPoints; ++i)
+				pointOrder[i] = i;
+		}
+		
+		BuildReorderedData( inData, triangleOrder, pointOrder, outData );
+	}
+	catch (const std::bad_alloc&)
+	{
+		theStatus = kQ3Failure;
+		E3ErrorManager_PostError( kQ3ErrorOutOfMemory, kQ3False );
+		Q3TriMesh_EmptyData( &outData );
+	}
+	catch (...)
+	{
+		theStatus = kQ3Failure;
+		Q3TriMesh_EmptyData( &outData );
+	}
+	
+	return theStatus;
+}
+
+
+/*!
+	@function	E3TriMesh_OptimizeForRendering
+	
+	@abstract	Make a copy of a TriMesh reordered for efficient drawing.
+	
+	@discussion	See discussion of E3TriMesh_OptimizeDataForRendering for the
+				steps that are performed.
+	
+	@param		inTriMesh		A TriMesh geometry.
+	@param		inSteps			A combination of TQ3TriMeshRenderOrderMasks.
+	@result		A TriMesh or nullptr.
+*/
+TQ3GeometryObject E3TriMesh_OptimizeForRendering( TQ3GeometryObject inTriMesh,
+								TQ3TriMeshRenderOrderMask inSteps )
+{
+	TQ3GeometryObject	theResult = nullptr;
+	
+	TQ3TriMeshData*	origData = nullptr;
+	
+	if (kQ3Success == Q3TriMesh_LockData( inTriMesh, kQ3True, &origData ))
+	{
+		TQ3TriMeshData	orderedData;
+		
+		if (kQ3Success == E3TriMesh_OptimizeDataForRendering( *origData, inSteps, orderedData ))
+		{
+			theResult = Q3TriMesh_New( &orderedData );
+			
+			Q3TriMesh_EmptyData( &orderedData );
+		}
+		
+		Q3TriMesh_UnlockData( inTriMesh );
+	}
+	
+	return theResult;
+}
+
+
+/*!
+	@function	E3TriMesh_GetCacheStatistics
+	
+	@abstract	Measure how well TriMesh data uses a vertex cache.
+	
+	@discussion	The triangles are fed in order through a first-in first-out
+				cache of inCacheSize vertices, and each vertex which is not
+				found in the cache counts as a transformed vertex.
+	
+	@param		inData			TriMesh data.
+	@param		inCacheSize		Number of vertices the cache holds.
+	@param		outStats		Receives the statistics.
+	@result		Success or failure of the operation.
+*/
+TQ3Status E3TriMesh_GetCacheStatistics( const TQ3TriMeshData& inData,
+								TQ3Uns32 inCacheSize,
+								TQ3TriMeshCacheStatistics& outStats )
+{
+	TQ3Status	theStatus = kQ3Success;
+	E3Memory_Clear( &outStats, sizeof(TQ3TriMeshCacheStatistics) );
+	outStats.cacheSize = inCacheSize;
+	
+	try
+	{
+		CheckIndices( inData );
+		
+		UnsVec				entryTime( inData.numPoints, 0 );
+		std::vector<bool>	isUsed( inData.numPoints, false );
+		TQ3Uns32			theTime = inCacheSize + 1;
+		TQ3Uns32			numUsed = 0;
+		
+		for (TQ3Uns32 i = 0; i < inData.numTriangles; ++i)
+		{
+			outStats.numTransformedVertices += CountCacheMisses( inData.triangles[i],
+				inCacheSize, entryTime, theTime );
+			
+			for (TQ3Uns32 k = 0; k < 3; ++k)
+			{
+				TQ3Uns32 thePoint = inData.triangles[i].pointIndices[k];
+				if (! isUsed[ thePoint ])
+				{
+					isUsed[ thePoint ] = true;
+					numUsed += 1;
+				}
+			}
+		}
+		
+		if (inData.numTriangles != 0)
+		{
+			outStats.acmr = outStats.numTransformedVertices / (float) inData.numTriangles;
+			outStats.atvr = outStats.numTransformedVertices / (float) numUsed;
+		}
+	}
+	catch (const std::bad_alloc&)
+	{
+		theStatus = kQ3Failure;
+		E3ErrorManager_PostError( kQ3ErrorOutOfMemory, kQ3False );
+	}
+	catch (...)
+	{
+		theStatus = kQ3Failure;
+	}
+	
+	return theStatus;
+}
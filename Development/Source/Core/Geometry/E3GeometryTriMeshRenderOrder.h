@@ -0,0 +1,126 @@
+#pragma once
+/*  NAME:
+        E3GeometryTriMeshRenderOrder.h
+
+    DESCRIPTION:
+        Header file for E3GeometryTriMeshRenderOrder.cpp.
+
+    COPYRIGHT:
+        Copyright (c) 2025, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+
+
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "E3Prefix.h"
+
+
+
+//=============================================================================
+//      Function prototypes
+//-----------------------------------------------------------------------------
+
+
+/*!
+	@function	E3TriMesh_OptimizeDataForRendering
+	
+	@abstract	Reorder TriMesh data for efficient drawing as an indexed
+				triangle list.
+	
+	@discussion	The steps to perform are chosen by inSteps:
+				<ol>
+					<li>The vertex cache step orders triangles so that each
+						reuses vertices which are likely to be in the
+						post-transform vertex cache of the GPU.</li>
+					<li>The overdraw step splits that order into clusters
+						which keep most of the cache benefit, and draws the
+						clusters facing away from the center of the mesh
+						first, so that hidden surfaces are more often
+						rejected by the depth test.</li>
+					<li>The vertex fetch step renumbers points in the order
+						that the triangles first use them.</li>
+				</ol>
+				
+				Attributes and edges are carried along with the triangles
+				and points they belong to, so the result renders the same as
+				the original.  You are responsible for calling
+				Q3TriMesh_EmptyData on the outData structure when you are
+				done with it.
+	
+	@param		inData			TriMesh data.
+	@param		inSteps			A combination of TQ3TriMeshRenderOrderMasks.
+	@param		outData			Receives new TriMesh data.
+	@result		Success or failure of the operation.
+*/
+TQ3Status E3TriMesh_OptimizeDataForRendering( const TQ3TriMeshData& inData,
+								TQ3TriMeshRenderOrderMask inSteps,
+								TQ3TriMeshData& outData );
+
+
+/*!
+	@function	E3TriMesh_OptimizeForRendering
+	
+	@abstract	Make a copy of a TriMesh reordered for efficient drawing.
+	
+	@discussion	See discussion of E3TriMesh_OptimizeDataForRendering for the
+				steps that are performed.
+	
+	@param		inTriMesh		A TriMesh geometry.
+	@param		inSteps			A combination of TQ3TriMeshRenderOrderMasks.
+	@result		A TriMesh or nullptr.
+*/
+TQ3GeometryObject E3TriMesh_OptimizeForRendering( TQ3GeometryObject inTriMesh,
+								TQ3TriMeshRenderOrderMask inSteps );
+
+
+/*!
+	@function	E3TriMesh_GetCacheStatistics
+	
+	@abstract	Measure how well TriMesh data uses a vertex cache.
+	
+	@discussion	The triangles are fed in order through a first-in first-out
+				cache of inCacheSize vertices, and each vertex which is not
+				found in the cache counts as a transformed vertex.
+	
+	@param		inData			TriMesh data.
+	@param		inCacheSize		Number of vertices the cache holds.
+	@param		outStats		Receives the statistics.
+	@result		Success or failure of the operation.
+*/
+TQ3Status E3TriMesh_GetCacheStatistics( const TQ3TriMeshData& inData,
+								TQ3Uns32 inCacheSize,
+								TQ3TriMeshCacheStatistics& outStats );
@@ -361,6 +361,97 @@ e3geom_triangle_pick_world_ray(TQ3ViewObject theView, TQ3PickObject thePick, TQ3
 
 
 
+//=============================================================================
+//      e3geom_triangle_pick_world_ray_batch : Triangle world-ray batch picking.
+//-----------------------------------------------------------------------------
+//		Note :	The rays are tested four at a time, and a ray only hits if it
+//				hits nearer than its nearest hit so far.
+//-----------------------------------------------------------------------------
+static TQ3Status
+e3geom_triangle_pick_world_ray_batch(TQ3ViewObject theView, TQ3PickObject thePick, const void *objectData)
+{	const TQ3TriangleData		*instanceData = (const TQ3TriangleData *) objectData;
+	TQ3Boolean					haveUV, cullBackface;
+	TQ3Param2D					hitUV, *resultUV;
+	TQ3BackfacingStyle			backfacingStyle;
+	TQ3TriangleData				worldTriangle;
+	TQ3Status					qd3dStatus;
+	TQ3Vector3D					hitNormal;
+	TQ3Point3D					hitXYZ;
+	TQ3Param3D					theHits[4];
+	TQ3Uns32					numRays, n, k;
+
+
+
+	// Get the pick data
+	E3WorldRayBatchPick_GetNumRays( thePick, &numRays );
+	const TQ3Ray3D* worldRays        = E3WorldRayBatchPick_AccessRays( thePick );
+	const float*    nearestDistances = E3WorldRayBatchPick_AccessNearestDistances( thePick );
+
+
+
+	// Set up a temporary triangle that holds the world points
+	worldTriangle = *instanceData;
+	for (n = 0; n < 3; n++)
+		Q3View_TransformLocalToWorld(theView, &instanceData->vertices[n].point,
+			&worldTriangle.vertices[n].point);
+
+
+
+	// Determine if we should cull back-facing triangles or not
+	qd3dStatus   = E3View_GetBackfacingStyleState(theView, &backfacingStyle);
+	cullBackface = (TQ3Boolean)(qd3dStatus == kQ3Success && backfacingStyle == kQ3BackfacingStyleRemove);
+
+
+
+	// Test the rays a packet at a time, skipping rays which can hit nothing
+	n = 0;
+	while ( (n < numRays) && (qd3dStatus == kQ3Success) )
+	{
+		E3Ray3DPacket	thePacket;
+		TQ3Uns32		rayIndices[4];
+		TQ3Uns32		laneMask = 0;
+		
+		for (k = 0; (k < 4) && (n < numRays); ++n)
+		{
+			if (nearestDistances[n] >= 0.0f)
+			{
+				E3Ray3DPacket_SetRay( thePacket, k, worldRays[n], nearestDistances[n] );
+				rayIndices[k] = n;
+				laneMask |= (1U << k);
+				++k;
+			}
+		}
+		
+		for (; k < 4; ++k)
+			E3Ray3DPacket_SetRay( thePacket, k, worldRays[0], 0.0f );
+		
+		TQ3Uns32 hitMask = E3Ray3DPacket_IntersectTriangle( thePacket, laneMask,
+			worldTriangle.vertices[0].point, worldTriangle.vertices[1].point,
+			worldTriangle.vertices[2].point, cullBackface, theHits );
+
+
+
+		// Record the hits
+		for (k = 0; (k < 4) && (qd3dStatus == kQ3Success); ++k)
+		{
+			if ((hitMask & (1U << k)) == 0)
+				continue;
+			
+			E3Triangle_InterpolateHit(theView,&worldTriangle, &theHits[k], &hitXYZ, &hitNormal, &hitUV, &haveUV);
+			resultUV = (haveUV ? &hitUV : nullptr);
+
+			qd3dStatus = E3WorldRayBatchPick_RecordHit(thePick, theView, rayIndices[k],
+				&hitXYZ, &hitNormal, resultUV, &theHits[k]);
+		}
+	}
+
+	return(qd3dStatus);
+}
+
+
+
+
+
 //=============================================================================
 //      e3geom_triangle_pick : Triangle picking method.
 //-----------------------------------------------------------------------------
@@ -386,6 +477,10 @@ e3geom_triangle_pick(TQ3ViewObject theView, TQ3ObjectType objectType, TQ3Object
 			qd3dStatus = e3geom_triangle_pick_world_ray(theView, thePick, theObject, objectData);
 			break;
 
+		case kQ3PickTypeWorldRayBatch:
+			qd3dStatus = e3geom_triangle_pick_world_ray_batch(theView, thePick, objectData);
+			break;
+
 		default:
 			qd3dStatus = kQ3Failure;
 			break;
@@ -53,6 +53,7 @@
 #include "E3GeometryEllipse.h"
 #include "E3GeometryEllipsoid.h"
 #include "E3GeometryGeneralPolygon.h"
+#include "E3GeometryInstanceArray.h"
 #include "E3GeometryLine.h"
 #include "E3GeometryMarker.h"
 #include "E3GeometryMesh.h"
@@ -67,7 +68,9 @@
 #include "E3GeometryTriangle.h"
 #include "E3GeometryTriGrid.h"
 #include "E3GeometryTriMesh.h"
+#include "E3GeometryTriMeshNormals.h"
 #include "E3GeometryTriMeshOptimize.h"
+#include "E3GeometryTriMeshRenderOrder.h"
 #include "E3View.h"
 #include "MakeStrip.h"
 
@@ -3549,6 +3552,227 @@ Q3GeneralPolygon_GetShapeHint(TQ3GeometryObject generalPolygon, TQ3GeneralPolygo
 
 
 
+//=============================================================================
+//      Q3InstanceArray_New : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3GeometryObject
+Q3InstanceArray_New(const TQ3InstanceArrayData *instanceArrayData)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(instanceArrayData), nullptr);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(instanceArrayData->instancedObject), nullptr);
+	Q3_REQUIRE_OR_RESULT(instanceArrayData->numInstances == 0 || Q3_VALID_PTR(instanceArrayData->transforms), nullptr);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3InstanceArray_New(instanceArrayData));
+}
+
+
+
+
+
+//=============================================================================
+//      Q3InstanceArray_Submit : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3InstanceArray_Submit(const TQ3InstanceArrayData *instanceArrayData, TQ3ViewObject view)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(instanceArrayData), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(instanceArrayData->instancedObject), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(instanceArrayData->numInstances == 0 || Q3_VALID_PTR(instanceArrayData->transforms), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(E3View_IsOfMyClass ( view ), kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3InstanceArray_Submit(instanceArrayData, view));
+}
+
+
+
+
+
+//=============================================================================
+//      Q3InstanceArray_SetData : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3InstanceArray_SetData(TQ3GeometryObject instanceArray, const TQ3InstanceArrayData *instanceArrayData)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3Object_IsType(instanceArray, kQ3GeometryTypeInstanceArray), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(instanceArrayData), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(instanceArrayData->instancedObject), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(instanceArrayData->numInstances == 0 || Q3_VALID_PTR(instanceArrayData->transforms), kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3InstanceArray_SetData(instanceArray, instanceArrayData));
+}
+
+
+
+
+
+//=============================================================================
+//      Q3InstanceArray_GetData : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3InstanceArray_GetData(TQ3GeometryObject instanceArray, TQ3InstanceArrayData *instanceArrayData)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3Object_IsType(instanceArray, kQ3GeometryTypeInstanceArray), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(instanceArrayData), kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3InstanceArray_GetData(instanceArray, instanceArrayData));
+}
+
+
+
+
+
+//=============================================================================
+//      Q3InstanceArray_EmptyData : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3InstanceArray_EmptyData(TQ3InstanceArrayData *instanceArrayData)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(instanceArrayData), kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3InstanceArray_EmptyData(instanceArrayData));
+}
+
+
+
+
+
+//=============================================================================
+//      Q3InstanceArray_GetTransform : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3InstanceArray_GetTransform(TQ3GeometryObject instanceArray, TQ3Uns32 index, TQ3Matrix4x4 *transform)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3Object_IsType(instanceArray, kQ3GeometryTypeInstanceArray), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(transform), kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3InstanceArray_GetTransform(instanceArray, index, transform));
+}
+
+
+
+
+
+//=============================================================================
+//      Q3InstanceArray_SetTransform : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3InstanceArray_SetTransform(TQ3GeometryObject instanceArray, TQ3Uns32 index, const TQ3Matrix4x4 *transform)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3Object_IsType(instanceArray, kQ3GeometryTypeInstanceArray), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(transform), kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3InstanceArray_SetTransform(instanceArray, index, transform));
+}
+
+
+
+
+
 //=============================================================================
 //      Q3Line_New : Quesa API entry point.
 //-----------------------------------------------------------------------------
@@ -10385,6 +10609,115 @@ TQ3GeometryObject Q3TriMesh_Optimize( TQ3GeometryObject inTriMesh )
 
 
 
+//=============================================================================
+//      Q3TriMesh_OptimizeDataForRendering : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status Q3TriMesh_OptimizeDataForRendering( const TQ3TriMeshData* inData,
+								TQ3TriMeshRenderOrderMask inSteps,
+								TQ3TriMeshData* outData )
+{
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(inData), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(outData), kQ3Failure);
+	
+	
+	
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	TQ3Status	theStatus = E3TriMesh_OptimizeDataForRendering( *inData, inSteps, *outData );
+	
+	return theStatus;
+}
+
+
+
+
+
+//=============================================================================
+//      Q3TriMesh_OptimizeForRendering : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3GeometryObject Q3TriMesh_OptimizeForRendering( TQ3GeometryObject inTriMesh,
+								TQ3TriMeshRenderOrderMask inSteps )
+{
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3Object_IsType(inTriMesh, kQ3GeometryTypeTriMesh), nullptr);
+	
+	
+	
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	TQ3GeometryObject	theGeom = E3TriMesh_OptimizeForRendering( inTriMesh, inSteps );
+	
+	return theGeom;
+}
+
+
+
+
+
+//=============================================================================
+//      Q3TriMesh_GetCacheStatistics : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status Q3TriMesh_GetCacheStatistics( const TQ3TriMeshData* inData,
+								TQ3Uns32 inCacheSize,
+								TQ3TriMeshCacheStatistics* outStats )
+{
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(inData), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(inCacheSize > 0, kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(outStats), kQ3Failure);
+	
+	
+	
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	TQ3Status	theStatus = E3TriMesh_GetCacheStatistics( *inData, inCacheSize, *outStats );
+	
+	return theStatus;
+}
+
+
+
+
+
+//=============================================================================
+//      Q3TriMesh_AddVertexNormals : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status Q3TriMesh_AddVertexNormals( TQ3GeometryObject inTriMesh,
+								float inCreaseAngle )
+{
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3Object_IsType(inTriMesh, kQ3GeometryTypeTriMesh), kQ3Failure);
+	
+	
+	
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	TQ3Status	theStatus = E3TriMesh_AddVertexNormals( inTriMesh, inCreaseAngle );
+	
+	return theStatus;
+}
+
+
+
+
+
 //=============================================================================
 //      Q3TriMesh_MakeTriangleStrip : Quesa API entry point.
 //-----------------------------------------------------------------------------
@@ -10504,3 +10837,63 @@ Q3TriMesh_SetNakedGeometry( TQ3GeometryObject inTriMesh,
 	
 	E3TriMesh_SetNakedGeometry( inTriMesh, inNaked );
 }
+
+
+
+
+
+//=============================================================================
+//      Q3TriMesh_BuildPickTree : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3TriMesh_BuildPickTree(TQ3GeometryObject triMesh, TQ3TriMeshPickTreeInfo *outInfo)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3Object_IsType(triMesh, kQ3GeometryTypeTriMesh), kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3TriMesh_BuildPickTree(triMesh, outInfo));
+}
+
+
+
+
+
+//=============================================================================
+//      Q3TriMesh_DisposePickTree : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3TriMesh_DisposePickTree(TQ3GeometryObject triMesh)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3Object_IsType(triMesh, kQ3GeometryTypeTriMesh), kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3TriMesh_DisposePickTree(triMesh));
+}
@@ -847,6 +847,66 @@ Q3Group_GetPreviousObjectPosition(TQ3GroupObject group, TQ3Object object, TQ3Gro
 
 
 
+
+
+//=============================================================================
+//      Q3Group_BuildPickTree : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3Group_BuildPickTree(TQ3GroupObject group, TQ3GroupPickTreeInfo *outInfo)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT( E3Group::IsOfMyClass ( group ), kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3Group_BuildPickTree(group, outInfo));
+}
+
+
+
+
+
+//=============================================================================
+//      Q3Group_DisposePickTree : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3Group_DisposePickTree(TQ3GroupObject group)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT( E3Group::IsOfMyClass ( group ), kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3Group_DisposePickTree(group));
+}
+
+
+
 #pragma mark -
 
 //=============================================================================
@@ -1199,6 +1259,242 @@ Q3IOProxyDisplayGroup_New(void)
 
 
 
+//=============================================================================
+//      Q3LODDisplayGroup_New : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3GroupObject
+Q3LODDisplayGroup_New(void)
+{
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3LODDisplayGroup_New());
+}
+
+
+
+
+
+//=============================================================================
+//      Q3LODDisplayGroup_SetThresholds : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3LODDisplayGroup_SetThresholds(TQ3GroupObject group, TQ3Uns32 numThresholds, const float *thresholds)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3Object_IsType( group, kQ3DisplayGroupTypeLOD ), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT((numThresholds == 0) || Q3_VALID_PTR(thresholds), kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3LODDisplayGroup_SetThresholds(group, numThresholds, thresholds));
+}
+
+
+
+
+
+//=============================================================================
+//      Q3LODDisplayGroup_GetThresholds : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3LODDisplayGroup_GetThresholds(TQ3GroupObject group, TQ3Uns32 bufferCount, float *outThresholds, TQ3Uns32 *outNumThresholds)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3Object_IsType( group, kQ3DisplayGroupTypeLOD ), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(outNumThresholds), kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3LODDisplayGroup_GetThresholds(group, bufferCount, outThresholds, outNumThresholds));
+}
+
+
+
+
+
+//=============================================================================
+//      Q3LODDisplayGroup_SetHysteresis : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3LODDisplayGroup_SetHysteresis(TQ3GroupObject group, float hysteresis)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3Object_IsType( group, kQ3DisplayGroupTypeLOD ), kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3LODDisplayGroup_SetHysteresis(group, hysteresis));
+}
+
+
+
+
+
+//=============================================================================
+//      Q3LODDisplayGroup_GetHysteresis : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3LODDisplayGroup_GetHysteresis(TQ3GroupObject group, float *hysteresis)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3Object_IsType( group, kQ3DisplayGroupTypeLOD ), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(hysteresis), kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3LODDisplayGroup_GetHysteresis(group, hysteresis));
+}
+
+
+
+
+
+//=============================================================================
+//      Q3LODDisplayGroup_SetPickFinest : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3LODDisplayGroup_SetPickFinest(TQ3GroupObject group, TQ3Boolean pickFinest)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3Object_IsType( group, kQ3DisplayGroupTypeLOD ), kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3LODDisplayGroup_SetPickFinest(group, pickFinest));
+}
+
+
+
+
+
+//=============================================================================
+//      Q3LODDisplayGroup_GetPickFinest : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3LODDisplayGroup_GetPickFinest(TQ3GroupObject group, TQ3Boolean *pickFinest)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3Object_IsType( group, kQ3DisplayGroupTypeLOD ), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(pickFinest), kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3LODDisplayGroup_GetPickFinest(group, pickFinest));
+}
+
+
+
+
+
+//=============================================================================
+//      Q3LODDisplayGroup_GetCurrentIndex : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3LODDisplayGroup_GetCurrentIndex(TQ3GroupObject group, TQ3Uns32 *currentIndex)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3Object_IsType( group, kQ3DisplayGroupTypeLOD ), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(currentIndex), kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3LODDisplayGroup_GetCurrentIndex(group, currentIndex));
+}
+
+
+
+
+
 //=============================================================================
 //      Q3XGroup_GetPositionPrivate : Quesa API entry point.
 //-----------------------------------------------------------------------------
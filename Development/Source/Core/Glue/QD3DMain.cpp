@@ -1289,6 +1289,36 @@ Q3Shared_GetEditIndex(TQ3SharedObject sharedObject)
 
 
 
+
+//=============================================================================
+//      Q3Shared_GetSubtreeEditStamp : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Uns32
+Q3Shared_GetSubtreeEditStamp(TQ3SharedObject sharedObject)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT( E3Shared_IsOfMyClass ( sharedObject ), 0);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return E3Shared_GetSubtreeEditStamp ( sharedObject ) ;
+}
+
+
+
+
 /*!
 	@function
 		Q3Shared_SetEditIndex
@@ -47,6 +47,8 @@
 #include "E3Prefix.h"
 #include "E3Math.h"
 #include "E3Math_Intersect.h"
+#include "E3MathSIMD.h"
+#include "E3MathSoA.h"
 
 
 
@@ -3505,6 +3507,37 @@ Q3Matrix4x4_SetQuaternion(TQ3Matrix4x4 *matrix4x4, const TQ3Quaternion *quaterni
 
 
 
+//=============================================================================
+//      Q3Matrix4x4_SetQuaternionArray : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3Matrix4x4_SetQuaternionArray(TQ3Matrix4x4 *outMatrices, const TQ3Quaternion *quaternions, const TQ3Vector3D *scales, const TQ3Vector3D *translations, TQ3Uns32 numMatrices)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(outMatrices) || (numMatrices == 0), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(quaternions) || (numMatrices == 0), kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3Matrix4x4_SetQuaternionArray(outMatrices, quaternions, scales, translations, numMatrices));
+}
+
+
+
+
+
 //=============================================================================
 //      Q3Matrix3x3_Copy : Quesa API entry point.
 //-----------------------------------------------------------------------------
@@ -3846,6 +3879,73 @@ Q3Matrix4x4_Multiply(const TQ3Matrix4x4 *m1, const TQ3Matrix4x4 *m2, TQ3Matrix4x
 
 
 
+//=============================================================================
+//      Q3Matrix4x4_MultiplyArray : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3Matrix4x4_MultiplyArray(const TQ3Matrix4x4 *inMatrices1, const TQ3Matrix4x4 *inMatrices2, TQ3Matrix4x4 *outMatrices, TQ3Uns32 numMatrices, TQ3Uns32 inStructSize1, TQ3Uns32 inStructSize2, TQ3Uns32 outStructSize)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(inMatrices1) || (numMatrices == 0), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(inMatrices2) || (numMatrices == 0), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(outMatrices) || (numMatrices == 0), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT((inStructSize1 == 0) || (inStructSize1 >= sizeof(TQ3Matrix4x4)), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT((inStructSize2 == 0) || (inStructSize2 >= sizeof(TQ3Matrix4x4)), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(outStructSize >= sizeof(TQ3Matrix4x4), kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3Matrix4x4_MultiplyArray(inMatrices1, inMatrices2, outMatrices, numMatrices, inStructSize1, inStructSize2, outStructSize));
+}
+
+
+
+
+
+//=============================================================================
+//      Q3Matrix4x4_ComposeHierarchy : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3Matrix4x4_ComposeHierarchy(const TQ3Matrix4x4 *localMatrices, const TQ3Uns32 *parentIndices, TQ3Uns32 numMatrices, TQ3Matrix4x4 *outMatrices)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(localMatrices) || (numMatrices == 0), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(parentIndices) || (numMatrices == 0), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(outMatrices) || (numMatrices == 0), kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3Matrix4x4_ComposeHierarchy(localMatrices, parentIndices, numMatrices, outMatrices));
+}
+
+
+
+
+
 //=============================================================================
 //      Q3Quaternion_Set : Quesa API entry point.
 //-----------------------------------------------------------------------------
@@ -4435,6 +4535,72 @@ Q3Quaternion_InterpolateLinear(const TQ3Quaternion *q1, const TQ3Quaternion *q2,
 
 
 
+//=============================================================================
+//      Q3Quaternion_InterpolateFastArray : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3Quaternion_InterpolateFastArray(const TQ3Quaternion *q1, const TQ3Quaternion *q2, const float *t, TQ3Uns32 numQuaternions, TQ3Quaternion *results)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(q1) || (numQuaternions == 0), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(q2) || (numQuaternions == 0), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(t) || (numQuaternions == 0), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(results) || (numQuaternions == 0), kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3Quaternion_InterpolateFastArray(q1, q2, t, numQuaternions, results));
+}
+
+
+
+
+
+//=============================================================================
+//      Q3Quaternion_InterpolateLinearArray : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3Quaternion_InterpolateLinearArray(const TQ3Quaternion *q1, const TQ3Quaternion *q2, const float *t, TQ3Uns32 numQuaternions, TQ3Quaternion *results)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(q1) || (numQuaternions == 0), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(q2) || (numQuaternions == 0), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(t) || (numQuaternions == 0), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(results) || (numQuaternions == 0), kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3Quaternion_InterpolateLinearArray(q1, q2, t, numQuaternions, results));
+}
+
+
+
+
+
 //=============================================================================
 //      Q3Quaternion_GetAxisAndAngle : Quesa API entry point.
 //-----------------------------------------------------------------------------
@@ -5171,6 +5337,408 @@ Q3Ray3D_IntersectTriangle(const TQ3Ray3D *theRay,
 
 
 
+//=============================================================================
+//      Q3Point3DArraySoA_Allocate : Quesa API entry point.
+//-----------------------------------------------------------------------------
+#pragma mark -
+TQ3Status
+Q3Point3DArraySoA_Allocate(TQ3Uns32 numPoints, TQ3Point3DArraySoA *outArray)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(outArray), kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3Point3DArraySoA_Allocate(numPoints, outArray));
+}
+
+
+
+
+
+//=============================================================================
+//      Q3Point3DArraySoA_Free : Quesa API entry point.
+//-----------------------------------------------------------------------------
+void
+Q3Point3DArraySoA_Free(TQ3Point3DArraySoA *ioArray)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE(Q3_VALID_PTR(ioArray));
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	E3Point3DArraySoA_Free(ioArray);
+}
+
+
+
+
+
+//=============================================================================
+//      Q3Point3DArraySoA_SetFromPoints3D : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3Point3DArraySoA_SetFromPoints3D(const TQ3Point3D *inPoints, TQ3Uns32 inStructSize, const TQ3Point3DArraySoA *ioArray)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(ioArray), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT((ioArray->count == 0) || (Q3_VALID_PTR(ioArray->x) && Q3_VALID_PTR(ioArray->y) && Q3_VALID_PTR(ioArray->z)), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT((ioArray->count == 0) || Q3_VALID_PTR(inPoints), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(inStructSize >= sizeof(TQ3Point3D), kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3Point3DArraySoA_SetFromPoints3D(inPoints, inStructSize, ioArray));
+}
+
+
+
+
+
+//=============================================================================
+//      Q3Point3DArraySoA_GetPoints3D : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3Point3DArraySoA_GetPoints3D(const TQ3Point3DArraySoA *inArray, TQ3Point3D *outPoints, TQ3Uns32 outStructSize)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(inArray), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT((inArray->count == 0) || (Q3_VALID_PTR(inArray->x) && Q3_VALID_PTR(inArray->y) && Q3_VALID_PTR(inArray->z)), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT((inArray->count == 0) || Q3_VALID_PTR(outPoints), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(outStructSize >= sizeof(TQ3Point3D), kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3Point3DArraySoA_GetPoints3D(inArray, outPoints, outStructSize));
+}
+
+
+
+
+
+//=============================================================================
+//      Q3Point3DArraySoA_TransformPoints : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3Point3DArraySoA_TransformPoints(const TQ3Point3DArraySoA *inArray, const TQ3Matrix4x4 *matrix4x4, const TQ3Point3DArraySoA *outArray)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(inArray), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT((inArray->count == 0) || (Q3_VALID_PTR(inArray->x) && Q3_VALID_PTR(inArray->y) && Q3_VALID_PTR(inArray->z)), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(matrix4x4), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(outArray), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT((outArray->count == 0) || (Q3_VALID_PTR(outArray->x) && Q3_VALID_PTR(outArray->y) && Q3_VALID_PTR(outArray->z)), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(outArray->count == inArray->count, kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3Point3DArraySoA_TransformPoints(inArray, matrix4x4, outArray));
+}
+
+
+
+
+
+//=============================================================================
+//      Q3Point3DArraySoA_TransformVectors : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3Point3DArraySoA_TransformVectors(const TQ3Point3DArraySoA *inArray, const TQ3Matrix4x4 *matrix4x4, const TQ3Point3DArraySoA *outArray)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(inArray), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT((inArray->count == 0) || (Q3_VALID_PTR(inArray->x) && Q3_VALID_PTR(inArray->y) && Q3_VALID_PTR(inArray->z)), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(matrix4x4), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(outArray), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT((outArray->count == 0) || (Q3_VALID_PTR(outArray->x) && Q3_VALID_PTR(outArray->y) && Q3_VALID_PTR(outArray->z)), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(outArray->count == inArray->count, kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3Point3DArraySoA_TransformVectors(inArray, matrix4x4, outArray));
+}
+
+
+
+
+
+//=============================================================================
+//      Q3Point3DArraySoA_ProjectTo2D : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3Point3DArraySoA_ProjectTo2D(const TQ3Point3DArraySoA *inArray, const TQ3Matrix4x4 *matrix4x4, TQ3Point2D *outPoints, TQ3Uns32 outStructSize)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(inArray), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT((inArray->count == 0) || (Q3_VALID_PTR(inArray->x) && Q3_VALID_PTR(inArray->y) && Q3_VALID_PTR(inArray->z)), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(matrix4x4), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT((inArray->count == 0) || Q3_VALID_PTR(outPoints), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(outStructSize >= sizeof(TQ3Point2D), kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3Point3DArraySoA_ProjectTo2D(inArray, matrix4x4, outPoints, outStructSize));
+}
+
+
+
+
+
+//=============================================================================
+//      Q3Point3DArraySoA_Normalize : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3Point3DArraySoA_Normalize(const TQ3Point3DArraySoA *inArray, const TQ3Point3DArraySoA *outArray)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(inArray), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT((inArray->count == 0) || (Q3_VALID_PTR(inArray->x) && Q3_VALID_PTR(inArray->y) && Q3_VALID_PTR(inArray->z)), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(outArray), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT((outArray->count == 0) || (Q3_VALID_PTR(outArray->x) && Q3_VALID_PTR(outArray->y) && Q3_VALID_PTR(outArray->z)), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(outArray->count == inArray->count, kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3Point3DArraySoA_Normalize(inArray, outArray));
+}
+
+
+
+
+
+//=============================================================================
+//      Q3Point3DArraySoA_Dot : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3Point3DArraySoA_Dot(const TQ3Point3DArraySoA *inArray1, const TQ3Point3DArraySoA *inArray2, float *outDotProducts)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(inArray1), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT((inArray1->count == 0) || (Q3_VALID_PTR(inArray1->x) && Q3_VALID_PTR(inArray1->y) && Q3_VALID_PTR(inArray1->z)), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(inArray2), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT((inArray2->count == 0) || (Q3_VALID_PTR(inArray2->x) && Q3_VALID_PTR(inArray2->y) && Q3_VALID_PTR(inArray2->z)), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(inArray2->count == inArray1->count, kQ3Failure);
+	Q3_REQUIRE_OR_RESULT((inArray1->count == 0) || Q3_VALID_PTR(outDotProducts), kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3Point3DArraySoA_Dot(inArray1, inArray2, outDotProducts));
+}
+
+
+
+
+
+//=============================================================================
+//      Q3Point3DArraySoA_Cross : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3Point3DArraySoA_Cross(const TQ3Point3DArraySoA *inArray1, const TQ3Point3DArraySoA *inArray2, const TQ3Point3DArraySoA *outArray)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(inArray1), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT((inArray1->count == 0) || (Q3_VALID_PTR(inArray1->x) && Q3_VALID_PTR(inArray1->y) && Q3_VALID_PTR(inArray1->z)), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(inArray2), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT((inArray2->count == 0) || (Q3_VALID_PTR(inArray2->x) && Q3_VALID_PTR(inArray2->y) && Q3_VALID_PTR(inArray2->z)), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(outArray), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT((outArray->count == 0) || (Q3_VALID_PTR(outArray->x) && Q3_VALID_PTR(outArray->y) && Q3_VALID_PTR(outArray->z)), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(inArray2->count == inArray1->count, kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(outArray->count == inArray1->count, kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3Point3DArraySoA_Cross(inArray1, inArray2, outArray));
+}
+
+
+
+
+
+//=============================================================================
+//      Q3Point3DArraySoA_DistanceToPlane : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3Point3DArraySoA_DistanceToPlane(const TQ3Point3DArraySoA *inArray, const TQ3PlaneEquation *plane, float *outDistances)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(inArray), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT((inArray->count == 0) || (Q3_VALID_PTR(inArray->x) && Q3_VALID_PTR(inArray->y) && Q3_VALID_PTR(inArray->z)), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(plane), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT((inArray->count == 0) || Q3_VALID_PTR(outDistances), kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3Point3DArraySoA_DistanceToPlane(inArray, plane, outDistances));
+}
+
+
+
+
+
+//=============================================================================
+//      Q3Point3DArraySoA_GetBoundingBox : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3Point3DArraySoA_GetBoundingBox(const TQ3Point3DArraySoA *inArray, TQ3BoundingBox *outBounds)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(inArray), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT((inArray->count == 0) || (Q3_VALID_PTR(inArray->x) && Q3_VALID_PTR(inArray->y) && Q3_VALID_PTR(inArray->z)), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(outBounds), kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3Point3DArraySoA_GetBoundingBox(inArray, outBounds));
+}
+
+
+
+
+
 //=============================================================================
 //      Q3Math_SquareRoot : Quesa API entry point.
 //-----------------------------------------------------------------------------
@@ -5228,3 +5796,61 @@ Q3Math_InvSquareRoot(float x)
 }
 
 
+
+
+
+//=============================================================================
+//      Q3Math_SetKernelSet : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3Math_SetKernelSet(TQ3MathKernelSet kernelSet)
+{
+
+
+	// Release build checks
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3MathKernels_Select(kernelSet));
+}
+
+
+
+
+
+//=============================================================================
+//      Q3Math_GetKernelSet : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3MathKernelSet
+Q3Math_GetKernelSet(void)
+{
+
+
+	// Release build checks
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3MathKernels_Get().kernelSet);
+}
+
+
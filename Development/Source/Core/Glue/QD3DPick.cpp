@@ -969,6 +969,100 @@ Q3WorldRayPick_SetData(TQ3PickObject pick, const TQ3WorldRayPickData *data)
 
 
 
+
+
+//=============================================================================
+//      Q3WorldRayBatchPick_New : Quesa API entry point.
+//-----------------------------------------------------------------------------
+#pragma mark -
+TQ3PickObject
+Q3WorldRayBatchPick_New(const TQ3WorldRayBatchPickData *data)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(data), nullptr);
+	Q3_REQUIRE_OR_RESULT((data->numRays == 0) || Q3_VALID_PTR(data->rays), nullptr);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3WorldRayBatchPick_New(data));
+}
+
+
+
+
+
+//=============================================================================
+//      Q3WorldRayBatchPick_GetNumRays : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3WorldRayBatchPick_GetNumRays(TQ3PickObject pick, TQ3Uns32 *numRays)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3Object_IsType(pick, kQ3PickTypeWorldRayBatch), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(numRays), kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3WorldRayBatchPick_GetNumRays(pick, numRays));
+}
+
+
+
+
+
+//=============================================================================
+//      Q3WorldRayBatchPick_GetRay : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3WorldRayBatchPick_GetRay(TQ3PickObject pick, TQ3Uns32 index, TQ3Ray3D *ray)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3Object_IsType(pick, kQ3PickTypeWorldRayBatch), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(ray), kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3WorldRayBatchPick_GetRay(pick, index, ray));
+}
+
+
+
 #pragma mark -
 
 //=============================================================================
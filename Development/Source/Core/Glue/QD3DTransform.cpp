@@ -296,6 +296,37 @@ Q3MatrixTransform_Get(TQ3TransformObject transform, TQ3Matrix4x4 *matrix)
 
 
 
+//=============================================================================
+//      Q3MatrixTransform_SetArray : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3MatrixTransform_SetArray(TQ3Uns32 numTransforms, const TQ3TransformObject *transforms, const TQ3Matrix4x4 *matrices)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(transforms) || (numTransforms == 0), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(matrices) || (numTransforms == 0), kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3MatrixTransform_SetArray(numTransforms, transforms, matrices));
+}
+
+
+
+
+
 //=============================================================================
 //      Q3RotateTransform_New : Quesa API entry point.
 //-----------------------------------------------------------------------------
@@ -1525,6 +1556,37 @@ Q3QuaternionTransform_Get(TQ3TransformObject transform, TQ3Quaternion *quaternio
 
 
 
+//=============================================================================
+//      Q3QuaternionTransform_SetArray : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3QuaternionTransform_SetArray(TQ3Uns32 numTransforms, const TQ3TransformObject *transforms, const TQ3Quaternion *quaternions)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(transforms) || (numTransforms == 0), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(quaternions) || (numTransforms == 0), kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3QuaternionTransform_SetArray(numTransforms, transforms, quaternions));
+}
+
+
+
+
+
 //=============================================================================
 //      Q3ResetTransform_New : Quesa API entry point.
 //-----------------------------------------------------------------------------
@@ -1012,6 +1012,192 @@ Q3View_AllowAllGroupCulling(TQ3ViewObject view, TQ3Boolean allowCulling)
 
 
 
+//=============================================================================
+//      Q3View_SetLODBias : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3View_SetLODBias(TQ3ViewObject view, float bias)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(E3View_IsOfMyClass ( view ), kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3View_SetLODBias(view, bias));
+}
+
+
+
+
+
+//=============================================================================
+//      Q3View_GetLODBias : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3View_GetLODBias(TQ3ViewObject view, float *bias)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(E3View_IsOfMyClass ( view ), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(bias), kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	*bias = E3View_GetLODBias(view);
+	return(kQ3Success);
+}
+
+
+
+
+
+//=============================================================================
+//      Q3View_AddMultiViewMember : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3View_AddMultiViewMember(TQ3ViewObject view, TQ3ViewObject member)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(E3View_IsOfMyClass ( view ), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(E3View_IsOfMyClass ( member ), kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3View_AddMultiViewMember(view, member));
+}
+
+
+
+
+
+//=============================================================================
+//      Q3View_RemoveAllMultiViewMembers : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3View_RemoveAllMultiViewMembers(TQ3ViewObject view)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(E3View_IsOfMyClass ( view ), kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3View_RemoveAllMultiViewMembers(view));
+}
+
+
+
+
+
+//=============================================================================
+//      Q3View_CountMultiViewMembers : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3View_CountMultiViewMembers(TQ3ViewObject view, TQ3Uns32 *count)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(E3View_IsOfMyClass ( view ), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(count), kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	*count = E3View_CountMultiViewMembers(view);
+	return(kQ3Success);
+}
+
+
+
+
+
+//=============================================================================
+//      Q3View_GetMultiViewMember : Quesa API entry point.
+//-----------------------------------------------------------------------------
+TQ3Status
+Q3View_GetMultiViewMember(TQ3ViewObject view, TQ3Uns32 index, TQ3ViewObject *member)
+{
+
+
+	// Release build checks
+	Q3_REQUIRE_OR_RESULT(E3View_IsOfMyClass ( view ), kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(member), kQ3Failure);
+
+
+
+	// Debug build checks
+
+
+
+	// Call the bottleneck
+	E3System_Bottleneck();
+
+
+
+	// Call our implementation
+	return(E3View_GetMultiViewMember(view, index, member));
+}
+
+
+
+
+
 //=============================================================================
 //      Q3View_TransformLocalToWorld : Quesa API entry point.
 //-----------------------------------------------------------------------------
@@ -0,0 +1,518 @@
+/*  NAME:
+        E3BoundingTree.cpp
+
+    DESCRIPTION:
+        Bounding volume hierarchy used to accelerate picking.
+        
+        The tree is built with a binned surface area heuristic: at each node
+        the item centroids are sorted into a fixed number of bins along the
+        longest axis of their bounds, and the node is split at the bin
+        boundary that minimizes the expected cost of a ray query.
+
+    COPYRIGHT:
+        Copyright (c) 2025, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "E3Prefix.h"
+#include "E3BoundingTree.h"
+
+
+
+
+
+//=============================================================================
+//      Internal constants
+//-----------------------------------------------------------------------------
+// Number of centroid bins tried at each split
+const TQ3Uns32 kBoundingTreeNumBins								= 16;
+
+// Nodes with more items than this are always split if possible
+const TQ3Uns32 kBoundingTreeMaxLeafItems						= 4;
+
+// Deepest node, which must leave room on the VisitRay stack
+const TQ3Uns32 kBoundingTreeMaxDepth							= 60;
+
+// Cost of visiting a node, relative to the cost of testing an item
+const float kBoundingTreeNodeCost								= 1.0f;
+
+
+
+
+
+//=============================================================================
+//      Internal types
+//-----------------------------------------------------------------------------
+// A centroid bin
+struct TE3BoundingTreeBin
+{
+	TQ3Point3D		min;
+	TQ3Point3D		max;
+	TQ3Uns32		count;
+};
+
+
+// An item being sorted into the tree, kept together for locality
+struct TE3BoundingTreeRef
+{
+	TQ3Point3D		min;
+	TQ3Point3D		max;
+	TQ3Point3D		centroid;
+	TQ3Uns32		item;
+};
+
+
+// A node waiting to be built, with the bounds of its items and centroids
+struct TE3BoundingTreeTask
+{
+	TQ3Uns32		node;
+	TQ3Uns32		begin;
+	TQ3Uns32		end;
+	TQ3Uns32		depth;
+	TQ3Point3D		boxMin;
+	TQ3Point3D		boxMax;
+	TQ3Point3D		centroidMin;
+	TQ3Point3D		centroidMax;
+};
+
+
+
+
+
+//=============================================================================
+//      Internal functions
+//-----------------------------------------------------------------------------
+//      e3boundingtree_set_empty : Make a box that grows to fit anything.
+//-----------------------------------------------------------------------------
+static inline void
+e3boundingtree_set_empty(TQ3Point3D &outMin, TQ3Point3D &outMax)
+{
+	outMin.x = outMin.y = outMin.z =  kQ3MaxFloat;
+	outMax.x = outMax.y = outMax.z = -kQ3MaxFloat;
+}
+
+
+
+
+
+//=============================================================================
+//      e3boundingtree_grow : Grow a box to contain another box.
+//-----------------------------------------------------------------------------
+static inline void
+e3boundingtree_grow(TQ3Point3D &ioMin, TQ3Point3D &ioMax,
+					const TQ3Point3D &inMin, const TQ3Point3D &inMax)
+{
+	ioMin.x = std::min( ioMin.x, inMin.x );
+	ioMin.y = std::min( ioMin.y, inMin.y );
+	ioMin.z = std::min( ioMin.z, inMin.z );
+	ioMax.x = std::max( ioMax.x, inMax.x );
+	ioMax.y = std::max( ioMax.y, inMax.y );
+	ioMax.z = std::max( ioMax.z, inMax.z );
+}
+
+
+
+
+
+//=============================================================================
+//      e3boundingtree_measure : Find the bounds of a range of items.
+//-----------------------------------------------------------------------------
+static void
+e3boundingtree_measure(const TE3BoundingTreeRef *inRefs, TQ3Uns32 inBegin, TQ3Uns32 inEnd,
+						TE3BoundingTreeTask &ioTask)
+{	TQ3Uns32	n;
+
+
+
+	e3boundingtree_set_empty( ioTask.boxMin, ioTask.boxMax );
+	e3boundingtree_set_empty( ioTask.centroidMin, ioTask.centroidMax );
+
+	for (n = inBegin; n < inEnd; ++n)
+	{
+		e3boundingtree_grow( ioTask.boxMin, ioTask.boxMax, inRefs[n].min, inRefs[n].max );
+		e3boundingtree_grow( ioTask.centroidMin, ioTask.centroidMax, inRefs[n].centroid,
+			inRefs[n].centroid );
+	}
+}
+
+
+
+
+
+//=============================================================================
+//      e3boundingtree_half_area : Half the surface area of a box.
+//-----------------------------------------------------------------------------
+static inline float
+e3boundingtree_half_area(const TQ3Point3D &inMin, const TQ3Point3D &inMax)
+{
+	if (inMin.x > inMax.x)
+		return 0.0f;
+
+	float dx = inMax.x - inMin.x;
+	float dy = inMax.y - inMin.y;
+	float dz = inMax.z - inMin.z;
+	
+	return dx * dy + dy * dz + dz * dx;
+}
+
+
+
+
+
+//=============================================================================
+//      e3boundingtree_coordinate : Get a coordinate of a point by axis.
+//-----------------------------------------------------------------------------
+static inline float
+e3boundingtree_coordinate(const TQ3Point3D &inPoint, TQ3Uns32 inAxis)
+{
+	return (inAxis == 0) ? inPoint.x : ((inAxis == 1) ? inPoint.y : inPoint.z);
+}
+
+
+
+
+
+//=============================================================================
+//      Public methods
+//-----------------------------------------------------------------------------
+//      E3BoundingTree::Build : Build the tree.
+//-----------------------------------------------------------------------------
+#pragma mark -
+void
+E3BoundingTree::Build( TQ3Uns32 inNumItems, const TQ3BoundingBox* inItemBounds )
+{
+	std::vector<TE3BoundingTreeRef>		theRefs;
+	std::vector<TE3BoundingTreeTask>	theTasks;
+	TE3BoundingTreeBin					theBins[ kBoundingTreeNumBins ];
+	float								rightCosts[ kBoundingTreeNumBins ];
+	TE3BoundingTreeTask					leftTask, rightTask;
+	TQ3Point3D							sideMin, sideMax;
+	TQ3Uns32							n, b;
+
+
+
+	// Start again
+	Clear();
+	if (inNumItems == 0)
+		return;
+
+
+
+	// Find the item centroids, which decide which side of a split an item goes
+	theRefs.resize( inNumItems );
+	for (n = 0; n < inNumItems; ++n)
+	{
+		theRefs[n].min        = inItemBounds[n].min;
+		theRefs[n].max        = inItemBounds[n].max;
+		theRefs[n].centroid.x = 0.5f * (inItemBounds[n].min.x + inItemBounds[n].max.x);
+		theRefs[n].centroid.y = 0.5f * (inItemBounds[n].min.y + inItemBounds[n].max.y);
+		theRefs[n].centroid.z = 0.5f * (inItemBounds[n].min.z + inItemBounds[n].max.z);
+		theRefs[n].item       = n;
+	}
+
+
+
+	// Build the nodes top down. The bounds of each child are gathered while
+	// partitioning its parent, so only the root needs a separate pass.
+	leftTask.node  = 0;
+	leftTask.begin = 0;
+	leftTask.end   = inNumItems;
+	leftTask.depth = 0;
+	e3boundingtree_measure( theRefs.data(), 0, inNumItems, leftTask );
+
+	mNodes.push_back( TE3BoundingTreeNode() );
+	theTasks.push_back( leftTask );
+	
+	while (! theTasks.empty())
+	{
+		TE3BoundingTreeTask theTask = theTasks.back();
+		theTasks.pop_back();
+		TQ3Uns32 numItems = theTask.end - theTask.begin;
+
+
+
+		const TQ3Point3D& centroidMin( theTask.centroidMin );
+		const TQ3Point3D& centroidMax( theTask.centroidMax );
+		
+		mNodes[ theTask.node ].min = theTask.boxMin;
+		mNodes[ theTask.node ].max = theTask.boxMax;
+
+
+
+		// Split along the longest axis of the centroids, at the bin boundary
+		// with the lowest surface area cost
+		TQ3Uns32 theMiddle = theTask.begin;
+		bool makeLeaf = (numItems <= 1) || (theTask.depth >= kBoundingTreeMaxDepth);
+		
+		if (! makeLeaf)
+		{
+			TQ3Uns32 theAxis = 0;
+			float theExtent = centroidMax.x - centroidMin.x;
+			if (centroidMax.y - centroidMin.y > theExtent)
+			{
+				theAxis   = 1;
+				theExtent = centroidMax.y - centroidMin.y;
+			}
+			if (centroidMax.z - centroidMin.z > theExtent)
+			{
+				theAxis   = 2;
+				theExtent = centroidMax.z - centroidMin.z;
+			}
+			
+			if (theExtent > 0.0f)
+			{
+				// Small nodes need fewer bins
+				TQ3Uns32 numBins = std::min( kBoundingTreeNumBins, std::max( 2U, numItems ) );
+				float axisMin  = e3boundingtree_coordinate( centroidMin, theAxis );
+				float binScale = numBins / theExtent;
+				auto binOf = [&]( const TE3BoundingTreeRef& inRef ) -> TQ3Uns32
+				{
+					float theOffset = e3boundingtree_coordinate( inRef.centroid, theAxis ) - axisMin;
+					return std::min( numBins - 1, (TQ3Uns32) (theOffset * binScale) );
+				};
+				
+				
+				// Sort the items into bins
+				for (b = 0; b < numBins; ++b)
+				{
+					e3boundingtree_set_empty( theBins[b].min, theBins[b].max );
+					theBins[b].count = 0;
+				}
+				
+				for (n = theTask.begin; n < theTask.end; ++n)
+				{
+					TE3BoundingTreeBin& theBin( theBins[ binOf( theRefs[n] ) ] );
+					e3boundingtree_grow( theBin.min, theBin.max, theRefs[n].min, theRefs[n].max );
+					theBin.count += 1;
+				}
+				
+				
+				// Sweep from the right, then from the left, to cost each
+				// split between bin b - 1 and bin b
+				TQ3Uns32 sideCount = 0;
+				e3boundingtree_set_empty( sideMin, sideMax );
+				for (b = numBins - 1; b > 0; --b)
+				{
+					e3boundingtree_grow( sideMin, sideMax, theBins[b].min, theBins[b].max );
+					sideCount += theBins[b].count;
+					rightCosts[b] = sideCount * e3boundingtree_half_area( sideMin, sideMax );
+				}
+				
+				TQ3Uns32 bestSplit = 0;
+				float bestCost = kQ3MaxFloat;
+				sideCount = 0;
+				e3boundingtree_set_empty( sideMin, sideMax );
+				for (b = 1; b < numBins; ++b)
+				{
+					e3boundingtree_grow( sideMin, sideMax, theBins[b - 1].min, theBins[b - 1].max );
+					sideCount += theBins[b - 1].count;
+					
+					float theCost = sideCount * e3boundingtree_half_area( sideMin, sideMax ) +
+						rightCosts[b];
+					if (sideCount != 0 && sideCount != numItems && theCost < bestCost)
+					{
+						bestCost  = theCost;
+						bestSplit = b;
+					}
+				}
+				
+				
+				// Small nodes become leaves unless splitting is cheaper
+				float nodeArea = e3boundingtree_half_area( theTask.boxMin, theTask.boxMax );
+				if ( (numItems <= kBoundingTreeMaxLeafItems) &&
+					(kBoundingTreeNodeCost * nodeArea + bestCost >= numItems * nodeArea) )
+				{
+					makeLeaf = true;
+				}
+				else if (bestSplit != 0)
+				{
+					e3boundingtree_set_empty( leftTask.boxMin, leftTask.boxMax );
+					e3boundingtree_set_empty( leftTask.centroidMin, leftTask.centroidMax );
+					e3boundingtree_set_empty( rightTask.boxMin, rightTask.boxMax );
+					e3boundingtree_set_empty( rightTask.centroidMin, rightTask.centroidMax );
+					
+					TQ3Uns32 theEnd = theTask.end;
+					theMiddle = theTask.begin;
+					while (theMiddle < theEnd)
+					{
+						if (binOf( theRefs[ theMiddle ] ) < bestSplit)
+						{
+							const TE3BoundingTreeRef& theRef( theRefs[ theMiddle ] );
+							e3boundingtree_grow( leftTask.boxMin, leftTask.boxMax,
+								theRef.min, theRef.max );
+							e3boundingtree_grow( leftTask.centroidMin, leftTask.centroidMax,
+								theRef.centroid, theRef.centroid );
+							++theMiddle;
+						}
+						else
+						{
+							--theEnd;
+							std::swap( theRefs[ theMiddle ], theRefs[ theEnd ] );
+							const TE3BoundingTreeRef& theRef( theRefs[ theEnd ] );
+							e3boundingtree_grow( rightTask.boxMin, rightTask.boxMax,
+								theRef.min, theRef.max );
+							e3boundingtree_grow( rightTask.centroidMin, rightTask.centroidMax,
+								theRef.centroid, theRef.centroid );
+						}
+					}
+				}
+			}
+			
+			
+			// If the centroids could not be separated, split large nodes
+			// in half anyway to keep the leaves small
+			if (! makeLeaf && (theMiddle == theTask.begin || theMiddle == theTask.end))
+			{
+				if (numItems <= kBoundingTreeMaxLeafItems)
+					makeLeaf = true;
+				else
+				{
+					theMiddle = theTask.begin + numItems / 2;
+					e3boundingtree_measure( theRefs.data(), theTask.begin, theMiddle, leftTask );
+					e3boundingtree_measure( theRefs.data(), theMiddle, theTask.end, rightTask );
+				}
+			}
+		}
+
+
+
+		// Record the leaf, or add the children
+		if (makeLeaf)
+		{
+			mNodes[ theTask.node ].first = theTask.begin;
+			mNodes[ theTask.node ].count = numItems;
+		}
+		else
+		{
+			TQ3Uns32 firstChild = static_cast<TQ3Uns32>( mNodes.size() );
+			mNodes[ theTask.node ].first = firstChild;
+			mNodes[ theTask.node ].count = 0;
+			mNodes.push_back( TE3BoundingTreeNode() );
+			mNodes.push_back( TE3BoundingTreeNode() );
+			
+			rightTask.node  = firstChild + 1;
+			rightTask.begin = theMiddle;
+			rightTask.end   = theTask.end;
+			rightTask.depth = theTask.depth + 1;
+			theTasks.push_back( rightTask );
+			
+			leftTask.node  = firstChild;
+			leftTask.begin = theTask.begin;
+			leftTask.end   = theMiddle;
+			leftTask.depth = theTask.depth + 1;
+			theTasks.push_back( leftTask );
+		}
+	}
+	
+	mNodes.shrink_to_fit();
+
+
+
+	// Keep the item order the leaves refer to
+	mItems.resize( inNumItems );
+	for (n = 0; n < inNumItems; ++n)
+		mItems[n] = theRefs[n].item;
+}
+
+
+
+
+
+//=============================================================================
+//      E3BoundingTree::Refit : Recompute the node boxes.
+//-----------------------------------------------------------------------------
+//		Note :	Children are always stored after their parent, so walking the
+//				nodes backwards reaches both children before the parent.
+//-----------------------------------------------------------------------------
+void
+E3BoundingTree::Refit( const TQ3BoundingBox* inItemBounds )
+{
+	for (TQ3Uns32 n = static_cast<TQ3Uns32>( mNodes.size() ); n-- != 0; )
+	{
+		TE3BoundingTreeNode& theNode( mNodes[n] );
+		
+		if (theNode.count != 0)
+		{
+			const TQ3BoundingBox& firstBounds( inItemBounds[ mItems[ theNode.first ] ] );
+			theNode.min = firstBounds.min;
+			theNode.max = firstBounds.max;
+			
+			for (TQ3Uns32 i = 1; i < theNode.count; ++i)
+			{
+				const TQ3BoundingBox& itemBounds( inItemBounds[ mItems[ theNode.first + i ] ] );
+				e3boundingtree_grow( theNode.min, theNode.max, itemBounds.min, itemBounds.max );
+			}
+		}
+		else
+		{
+			const TE3BoundingTreeNode& leftNode( mNodes[ theNode.first ] );
+			const TE3BoundingTreeNode& rightNode( mNodes[ theNode.first + 1 ] );
+			theNode.min = leftNode.min;
+			theNode.max = leftNode.max;
+			e3boundingtree_grow( theNode.min, theNode.max, rightNode.min, rightNode.max );
+		}
+	}
+}
+
+
+
+
+
+//=============================================================================
+//      E3BoundingTree::Clear : Remove all nodes.
+//-----------------------------------------------------------------------------
+void
+E3BoundingTree::Clear()
+{
+	std::vector<TE3BoundingTreeNode>().swap( mNodes );
+	std::vector<TQ3Uns32>().swap( mItems );
+}
+
+
+
+
+
+//=============================================================================
+//      E3BoundingTree::GetMemorySize : Get the memory used by the tree.
+//-----------------------------------------------------------------------------
+TQ3Uns32
+E3BoundingTree::GetMemorySize() const
+{
+	return static_cast<TQ3Uns32>( sizeof(E3BoundingTree) +
+		mNodes.capacity() * sizeof(TE3BoundingTreeNode) +
+		mItems.capacity() * sizeof(TQ3Uns32) );
+}
@@ -0,0 +1,549 @@
+/*  NAME:
+        E3BoundingTree.h
+
+    DESCRIPTION:
+        Header file for E3BoundingTree.cpp.
+
+    COPYRIGHT:
+        Copyright (c) 2025, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+#ifndef E3BOUNDINGTREE_HDR
+#define E3BOUNDINGTREE_HDR
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "E3Prefix.h"
+#include "E3Math_Intersect.h"
+#include "E3SIMD.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+
+
+
+
+//=============================================================================
+//      Types
+//-----------------------------------------------------------------------------
+/*!
+	@struct		TE3BoundingTreeNode
+	@abstract	A node of an E3BoundingTree.
+	@discussion	The two children of an inner node are stored next to each
+				other, so an inner node only records the index of the first.
+	@field		min			Minimum corner of the node's bounding box.
+	@field		first		Index of the first child for an inner node, or of
+							the first item slot for a leaf.
+	@field		max			Maximum corner of the node's bounding box.
+	@field		count		Number of items in a leaf, or 0 for an inner node.
+*/
+struct TE3BoundingTreeNode
+{
+	TQ3Point3D		min;
+	TQ3Uns32		first;
+	TQ3Point3D		max;
+	TQ3Uns32		count;
+};
+
+
+
+
+
+//=============================================================================
+//      Class declaration
+//-----------------------------------------------------------------------------
+/*!
+	@class		E3BoundingTree
+	
+	@abstract	Bounding volume hierarchy over a set of items with bounding
+				boxes, such as the triangles of a TriMesh.
+	
+	@discussion	The tree is built top down by binning item centroids and
+				choosing the split with the lowest surface area cost.  It
+				only records item indices, so the caller keeps the items
+				themselves and tests them when a query reaches them.
+*/
+class E3BoundingTree
+{
+public:
+	/*!
+		@function	Build
+		@abstract	Build the tree, replacing any previous contents.
+		@param		inNumItems		Number of items.
+		@param		inItemBounds	Bounding box of each item.
+	*/
+	void					Build( TQ3Uns32 inNumItems,
+									const TQ3BoundingBox* inItemBounds );
+
+	/*!
+		@function	Refit
+		@abstract	Recompute the node boxes after items have moved.
+		@discussion	The shape of the tree is kept, which is much faster than
+					building it again but makes it less efficient as items
+					move further from where they were.
+		@param		inItemBounds	Bounding box of each item, in the same
+									order as was given to Build.
+	*/
+	void					Refit( const TQ3BoundingBox* inItemBounds );
+
+	/*!
+		@function	Clear
+		@abstract	Remove all nodes and release their memory.
+	*/
+	void					Clear();
+	
+	bool					IsEmpty() const { return mNodes.empty(); }
+	TQ3Uns32				GetNodeCount() const { return static_cast<TQ3Uns32>( mNodes.size() ); }
+	TQ3Uns32				GetItemCount() const { return static_cast<TQ3Uns32>( mItems.size() ); }
+
+	/*!
+		@function	GetMemorySize
+		@abstract	Number of bytes used by the nodes and item indices.
+	*/
+	TQ3Uns32				GetMemorySize() const;
+
+	/*!
+		@function	VisitRay
+		@abstract	Visit the items whose leaves a ray passes through.
+		@discussion	Leaves are visited roughly in near to far order.  The
+					visitor is called as <code>ioVisitor( itemIndex,
+					ioMaxDistance )</code>, and may reduce ioMaxDistance so
+					that nodes entered beyond it are skipped.
+					
+					Distances are measured in units of the ray direction,
+					which need not be normalized.
+		@param		inRay			A ray.
+		@param		ioMaxDistance	Distance along the ray beyond which
+									nodes are skipped.
+		@param		ioVisitor		Function object called for each item.
+	*/
+	template <typename Visitor>
+	void					VisitRay( const TQ3Ray3D& inRay,
+										float& ioMaxDistance,
+										Visitor& ioVisitor ) const;
+
+	/*!
+		@function	VisitRayPacket
+		@abstract	Visit the items whose leaves any of four rays pass
+					through.
+		@discussion	The rays descend the tree together, so each node box is
+					tested against all of them at once.  The visitor is
+					called as <code>ioVisitor( itemIndex, laneMask )</code>,
+					where bit n of laneMask is set if the ray in lane n
+					reached the leaf, and may reduce the maximum distances
+					of the packet so that nodes entered beyond them are
+					skipped.
+		@param		ioPacket		The rays, with their maximum distances.
+		@param		inLaneMask		Bit n set if lane n is in use.
+		@param		ioVisitor		Function object called for each item.
+	*/
+	template <typename Visitor>
+	void					VisitRayPacket( E3Ray3DPacket& ioPacket,
+											TQ3Uns32 inLaneMask,
+											Visitor& ioVisitor ) const;
+
+	/*!
+		@function	VisitBoxes
+		@abstract	Visit the items whose leaves pass a test of the node
+					boxes.
+		@discussion	The classifier is called as <code>inClassifier( min,
+					max )</code> for each node reached, and returns an
+					E3FrustumClass.  Nodes which are outside are skipped,
+					and nodes which are inside have all their items visited
+					without testing the nodes below them.
+					
+					The visitor is called as <code>ioVisitor( itemIndex,
+					isInside )</code>, where isInside is true if the item
+					was reached through an inside node, and returns true to
+					end the walk.
+		@param		inClassifier	Function object which classifies a box.
+		@param		ioVisitor		Function object called for each item.
+	*/
+	template <typename Classifier, typename Visitor>
+	void					VisitBoxes( Classifier& inClassifier,
+										Visitor& ioVisitor ) const;
+
+	/*!
+		@function	GetInverseDirection
+		@abstract	Get the reciprocals of a ray direction for RayEntersBox.
+	*/
+	static TQ3Vector3D		GetInverseDirection( const TQ3Vector3D& inDirection );
+
+	/*!
+		@function	RayEntersBox
+		@abstract	Test whether a ray enters a box before a given distance.
+		@discussion	This is the test VisitRay applies to each node, which
+					callers can also apply to the boxes of their own items.
+		@param		inMin			Minimum corner of the box.
+		@param		inMax			Maximum corner of the box.
+		@param		inOrigin		Origin of the ray.
+		@param		inInvDirection	Result of GetInverseDirection.
+		@param		inMaxDistance	Distance along the ray beyond which the
+									box is ignored.
+		@param		outEntry		Receives the distance at which the ray
+									enters the box, or 0 if it starts inside.
+		@result		True if the ray enters the box.
+	*/
+	static bool				RayEntersBox( const TQ3Point3D& inMin,
+											const TQ3Point3D& inMax,
+											const TQ3Point3D& inOrigin,
+											const TQ3Vector3D& inInvDirection,
+											float inMaxDistance,
+											float& outEntry );
+
+private:
+	std::vector<TE3BoundingTreeNode>	mNodes;
+	std::vector<TQ3Uns32>				mItems;
+};
+
+
+
+
+
+//=============================================================================
+//      Inline and template methods
+//-----------------------------------------------------------------------------
+//      E3BoundingTree::GetInverseDirection : Reciprocal of a ray direction.
+//-----------------------------------------------------------------------------
+//		Note :	Near-zero direction components are given a huge reciprocal
+//				rather than an infinite one, so that an origin lying exactly
+//				on a slab plane gives 0 rather than NaN.
+//-----------------------------------------------------------------------------
+inline TQ3Vector3D
+E3BoundingTree::GetInverseDirection( const TQ3Vector3D& inDirection )
+{
+	TQ3Vector3D		invDirection;
+	
+	invDirection.x = (fabsf( inDirection.x ) > 1.0e-30f) ? 1.0f / inDirection.x :
+		((inDirection.x < 0.0f) ? -1.0e30f : 1.0e30f);
+	invDirection.y = (fabsf( inDirection.y ) > 1.0e-30f) ? 1.0f / inDirection.y :
+		((inDirection.y < 0.0f) ? -1.0e30f : 1.0e30f);
+	invDirection.z = (fabsf( inDirection.z ) > 1.0e-30f) ? 1.0f / inDirection.z :
+		((inDirection.z < 0.0f) ? -1.0e30f : 1.0e30f);
+	
+	return invDirection;
+}
+
+
+
+
+
+//=============================================================================
+//      E3BoundingTree::RayEntersBox : Slab test of a ray against a box.
+//-----------------------------------------------------------------------------
+//		Note :	The exit distance is padded by a few ulps so that rounding
+//				cannot reject a hit on the boundary of a leaf.
+//-----------------------------------------------------------------------------
+inline bool
+E3BoundingTree::RayEntersBox( const TQ3Point3D& inMin,
+								const TQ3Point3D& inMax,
+								const TQ3Point3D& inOrigin,
+								const TQ3Vector3D& inInvDirection,
+								float inMaxDistance,
+								float& outEntry )
+{
+	float t1 = (inMin.x - inOrigin.x) * inInvDirection.x;
+	float t2 = (inMax.x - inOrigin.x) * inInvDirection.x;
+	float tNear = std::min( t1, t2 );
+	float tFar  = std::max( t1, t2 );
+	
+	t1 = (inMin.y - inOrigin.y) * inInvDirection.y;
+	t2 = (inMax.y - inOrigin.y) * inInvDirection.y;
+	tNear = std::max( tNear, std::min( t1, t2 ) );
+	tFar  = std::min( tFar,  std::max( t1, t2 ) );
+	
+	t1 = (inMin.z - inOrigin.z) * inInvDirection.z;
+	t2 = (inMax.z - inOrigin.z) * inInvDirection.z;
+	tNear = std::max( tNear, std::min( t1, t2 ) );
+	tFar  = std::min( tFar,  std::max( t1, t2 ) );
+	
+	tNear = std::max( tNear, 0.0f );
+	tFar  = std::min( tFar * 1.0000005f, inMaxDistance );
+	
+	outEntry = tNear;
+	return tNear <= tFar;
+}
+
+
+
+
+
+//=============================================================================
+//      E3BoundingTree::VisitRay : Visit the items a ray may hit.
+//-----------------------------------------------------------------------------
+template <typename Visitor>
+void
+E3BoundingTree::VisitRay( const TQ3Ray3D& inRay,
+							float& ioMaxDistance,
+							Visitor& ioVisitor ) const
+{
+	struct StackEntry
+	{
+		TQ3Uns32	node;
+		float		entry;
+	};
+	StackEntry		theStack[ 64 ];
+	TQ3Uns32		stackSize = 0;
+	float			theEntry, leftEntry, rightEntry;
+
+
+
+	if (mNodes.empty())
+		return;
+	
+	
+	
+	// Precompute the reciprocal direction for the slab tests
+	const TQ3Vector3D invDirection( GetInverseDirection( inRay.direction ) );
+
+	if (! RayEntersBox( mNodes[0].min, mNodes[0].max, inRay.origin, invDirection,
+		ioMaxDistance, theEntry ))
+		return;
+	
+	theStack[ stackSize++ ] = { 0, theEntry };
+
+
+
+	// Walk the tree, descending into the nearer child first
+	while (stackSize != 0)
+	{
+		StackEntry theTop = theStack[ --stackSize ];
+		if (theTop.entry > ioMaxDistance)
+			continue;
+		
+		const TE3BoundingTreeNode& theNode( mNodes[ theTop.node ] );
+		
+		if (theNode.count != 0)
+		{
+			for (TQ3Uns32 n = 0; n < theNode.count; ++n)
+				ioVisitor( mItems[ theNode.first + n ], ioMaxDistance );
+		}
+		else
+		{
+			TQ3Uns32 leftIndex  = theNode.first;
+			TQ3Uns32 rightIndex = theNode.first + 1;
+			const TE3BoundingTreeNode& leftNode( mNodes[ leftIndex ] );
+			const TE3BoundingTreeNode& rightNode( mNodes[ rightIndex ] );
+			bool hitLeft  = RayEntersBox( leftNode.min, leftNode.max, inRay.origin,
+				invDirection, ioMaxDistance, leftEntry );
+			bool hitRight = RayEntersBox( rightNode.min, rightNode.max, inRay.origin,
+				invDirection, ioMaxDistance, rightEntry );
+			
+			if (hitLeft && hitRight)
+			{
+				if (leftEntry <= rightEntry)
+				{
+					theStack[ stackSize++ ] = { rightIndex, rightEntry };
+					theStack[ stackSize++ ] = { leftIndex,  leftEntry  };
+				}
+				else
+				{
+					theStack[ stackSize++ ] = { leftIndex,  leftEntry  };
+					theStack[ stackSize++ ] = { rightIndex, rightEntry };
+				}
+			}
+			else if (hitLeft)
+				theStack[ stackSize++ ] = { leftIndex, leftEntry };
+			else if (hitRight)
+				theStack[ stackSize++ ] = { rightIndex, rightEntry };
+		}
+	}
+}
+
+
+
+
+
+
+//=============================================================================
+//      E3BoundingTree::VisitRayPacket : Visit the items four rays may hit.
+//-----------------------------------------------------------------------------
+//		Note :	The nearer child is the one with the smaller entry distance
+//				over the rays that reach it.  A node is dropped for the rays
+//				whose maximum distance has moved in front of it since it was
+//				pushed.
+//-----------------------------------------------------------------------------
+template <typename Visitor>
+void
+E3BoundingTree::VisitRayPacket( E3Ray3DPacket& ioPacket,
+								TQ3Uns32 inLaneMask,
+								Visitor& ioVisitor ) const
+{
+	struct StackEntry
+	{
+		TQ3Uns32	node;
+		TQ3Uns32	mask;
+		float		entry[4];
+	};
+	StackEntry		theStack[ 64 ];
+	TQ3Uns32		stackSize = 0;
+
+
+
+	if (mNodes.empty() || (inLaneMask == 0))
+		return;
+	
+	
+	
+	// Test the root
+	StackEntry& theRoot( theStack[ stackSize ] );
+	theRoot.node = 0;
+	theRoot.mask = inLaneMask & E3Ray3DPacket_IntersectBoundingBox( ioPacket,
+		mNodes[0].min, mNodes[0].max, theRoot.entry );
+	if (theRoot.mask == 0)
+		return;
+	
+	++stackSize;
+
+
+
+	// Walk the tree, descending into the nearer child first
+	while (stackSize != 0)
+	{
+		StackEntry theTop = theStack[ --stackSize ];
+		TQ3Uns32 theMask = theTop.mask & E3Float4_LessEqualMask(
+			E3Float4_Load( theTop.entry ), E3Float4_Load( ioPacket.maxDistance ) );
+		if (theMask == 0)
+			continue;
+		
+		const TE3BoundingTreeNode& theNode( mNodes[ theTop.node ] );
+		
+		if (theNode.count != 0)
+		{
+			for (TQ3Uns32 n = 0; n < theNode.count; ++n)
+				ioVisitor( mItems[ theNode.first + n ], theMask );
+		}
+		else
+		{
+			StackEntry leftEntry, rightEntry;
+			leftEntry.node  = theNode.first;
+			rightEntry.node = theNode.first + 1;
+			leftEntry.mask  = theMask & E3Ray3DPacket_IntersectBoundingBox( ioPacket,
+				mNodes[ leftEntry.node ].min, mNodes[ leftEntry.node ].max, leftEntry.entry );
+			rightEntry.mask = theMask & E3Ray3DPacket_IntersectBoundingBox( ioPacket,
+				mNodes[ rightEntry.node ].min, mNodes[ rightEntry.node ].max, rightEntry.entry );
+			
+			float leftNearest  = kQ3MaxFloat;
+			float rightNearest = kQ3MaxFloat;
+			for (TQ3Uns32 n = 0; n < 4; ++n)
+			{
+				if ((leftEntry.mask & (1U << n)) != 0)
+					leftNearest = std::min( leftNearest, leftEntry.entry[n] );
+				if ((rightEntry.mask & (1U << n)) != 0)
+					rightNearest = std::min( rightNearest, rightEntry.entry[n] );
+			}
+			
+			if (leftNearest <= rightNearest)
+			{
+				if (rightEntry.mask != 0)
+					theStack[ stackSize++ ] = rightEntry;
+				if (leftEntry.mask != 0)
+					theStack[ stackSize++ ] = leftEntry;
+			}
+			else
+			{
+				if (leftEntry.mask != 0)
+					theStack[ stackSize++ ] = leftEntry;
+				if (rightEntry.mask != 0)
+					theStack[ stackSize++ ] = rightEntry;
+			}
+		}
+	}
+}
+
+
+
+
+
+
+//=============================================================================
+//      E3BoundingTree::VisitBoxes : Visit the items in classified nodes.
+//-----------------------------------------------------------------------------
+template <typename Classifier, typename Visitor>
+void
+E3BoundingTree::VisitBoxes( Classifier& inClassifier,
+							Visitor& ioVisitor ) const
+{
+	struct StackEntry
+	{
+		TQ3Uns32	node;
+		bool		isInside;
+	};
+	StackEntry		theStack[ 64 ];
+	TQ3Uns32		stackSize = 0;
+
+
+
+	if (mNodes.empty())
+		return;
+	
+	theStack[ stackSize++ ] = { 0, false };
+
+
+
+	// Walk the tree, classifying nodes until one is found to be inside
+	while (stackSize != 0)
+	{
+		StackEntry theTop = theStack[ --stackSize ];
+		const TE3BoundingTreeNode& theNode( mNodes[ theTop.node ] );
+		
+		if (! theTop.isInside)
+		{
+			E3FrustumClass theClass = inClassifier( theNode.min, theNode.max );
+			if (theClass == kE3FrustumClass_Outside)
+				continue;
+			
+			theTop.isInside = (theClass == kE3FrustumClass_Inside);
+		}
+		
+		if (theNode.count != 0)
+		{
+			for (TQ3Uns32 n = 0; n < theNode.count; ++n)
+			{
+				if (ioVisitor( mItems[ theNode.first + n ], theTop.isInside ))
+					return;
+			}
+		}
+		else
+		{
+			theStack[ stackSize++ ] = { theNode.first + 1, theTop.isInside };
+			theStack[ stackSize++ ] = { theNode.first, theTop.isInside };
+		}
+	}
+}
+
+#endif
@@ -136,6 +136,7 @@ extern "C" {
 #define kQ3ClassNameGeometryEllipse					"Ellipse"
 #define kQ3ClassNameGeometryEllipsoid				"Ellipsoid"
 #define kQ3ClassNameGeometryGeneralPolygon			"GeneralPolygon"
+#define kQ3ClassNameGeometryInstanceArray			"InstanceArray"
 #define kQ3ClassNameGeometryLine					"Line"
 #define kQ3ClassNameGeometryMarker					"Marker"
 #define kQ3ClassNameGeometryMesh					"Mesh"
@@ -154,6 +155,7 @@ extern "C" {
 #define kQ3ClassNameGroup							"Group"
 #define kQ3ClassNameGroupDisplay					"DisplayGroup"
 #define kQ3ClassNameGroupDisplayIOProxy				"IOProxyDisplayGroup"
+#define kQ3ClassNameGroupDisplayLOD					"LODDisplayGroup"
 #define kQ3ClassNameGroupDisplayOrdered				"OrderedDisplayGroup"
 #define kQ3ClassNameGroupInfo						"InfoGroup"
 #define kQ3ClassNameGroupLight						"LightGroup"
@@ -180,6 +182,7 @@ extern "C" {
 #define kQ3ClassNamePickWindowPoint					"WindowPointPick"
 #define kQ3ClassNamePickWindowRect					"WindowRectPick"
 #define kQ3ClassNamePickWorldRay					"WorldRayPick"
+#define kQ3ClassNamePickWorldRayBatch				"WorldRayBatchPick"
 #define kQ3ClassNameRenderer						"Renderer"
 #define kQ3ClassNameRendererGeneric					"GenericRenderer"
 #define kQ3ClassNameRendererInteractive				"InteractiveRenderer"
@@ -0,0 +1,186 @@
+/*  NAME:
+        E3Parallel.cpp
+
+    DESCRIPTION:
+        Splitting loops across threads.
+
+    COPYRIGHT:
+        Copyright (c) 2025, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "E3Parallel.h"
+
+#include <cstdint>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+
+
+
+
+//=============================================================================
+//      Internal constants
+//-----------------------------------------------------------------------------
+namespace
+{
+	// Upper limit on threads, in case hardware_concurrency reports something
+	// unreasonable.
+	const TQ3Uns32		kMaxThreads		= 64;
+}
+
+
+
+
+
+//=============================================================================
+//      Internal functions
+//-----------------------------------------------------------------------------
+//      e3parallel_task_start : Index of the first item of a piece.
+//-----------------------------------------------------------------------------
+static TQ3Uns32
+e3parallel_task_start( TQ3Uns32 inCount, TQ3Uns32 inNumTasks, TQ3Uns32 inTask )
+{
+	return static_cast<TQ3Uns32>( (static_cast<std::uint64_t>(inCount) * inTask) / inNumTasks );
+}
+
+
+
+
+
+//=============================================================================
+//      Public functions
+//-----------------------------------------------------------------------------
+//      E3Parallel_GetNumTasks : Number of pieces to split a range into.
+//-----------------------------------------------------------------------------
+TQ3Uns32
+E3Parallel_GetNumTasks( TQ3Uns32 inCount, TQ3Uns32 inMinPerTask )
+{
+	TQ3Uns32 numThreads = std::thread::hardware_concurrency();
+	if (numThreads == 0)
+	{
+		numThreads = 1;
+	}
+	else if (numThreads > kMaxThreads)
+	{
+		numThreads = kMaxThreads;
+	}
+	
+	if (inMinPerTask == 0)
+	{
+		inMinPerTask = 1;
+	}
+	TQ3Uns32 numTasks = inCount / inMinPerTask;
+	
+	if (numTasks > numThreads)
+	{
+		numTasks = numThreads;
+	}
+	else if (numTasks == 0)
+	{
+		numTasks = 1;
+	}
+	
+	return numTasks;
+}
+
+
+
+
+
+//=============================================================================
+//      E3Parallel_For : Run a loop body over pieces of a range.
+//-----------------------------------------------------------------------------
+//		Note :	The calling thread does the last piece itself.  If a thread
+//				cannot be started, its piece is done on the calling thread
+//				too, so the work always gets done.
+//-----------------------------------------------------------------------------
+void
+E3Parallel_For( TQ3Uns32 inCount, TQ3Uns32 inMinPerTask,
+				const std::function< void( TQ3Uns32 inStart, TQ3Uns32 inEnd ) >& inBody )
+{
+	if (inCount == 0)
+		return;
+	
+	const TQ3Uns32 numTasks = E3Parallel_GetNumTasks( inCount, inMinPerTask );
+	if (numTasks == 1)
+	{
+		inBody( 0, inCount );
+		return;
+	}
+	
+	std::vector< std::thread >	workers;
+	std::vector< TQ3Uns32 >		leftovers;
+	try
+	{
+		workers.reserve( numTasks - 1 );
+		leftovers.reserve( numTasks - 1 );
+	}
+	catch (...)
+	{
+		inBody( 0, inCount );
+		return;
+	}
+	
+	for (TQ3Uns32 i = 0; i < numTasks - 1; ++i)
+	{
+		try
+		{
+			workers.emplace_back( std::cref( inBody ),
+				e3parallel_task_start( inCount, numTasks, i ),
+				e3parallel_task_start( inCount, numTasks, i + 1 ) );
+		}
+		catch (const std::system_error&)
+		{
+			leftovers.push_back( i );
+		}
+	}
+	
+	inBody( e3parallel_task_start( inCount, numTasks, numTasks - 1 ), inCount );
+	
+	for (TQ3Uns32 i : leftovers)
+	{
+		inBody( e3parallel_task_start( inCount, numTasks, i ),
+			e3parallel_task_start( inCount, numTasks, i + 1 ) );
+	}
+	
+	for (std::thread& aThread : workers)
+	{
+		aThread.join();
+	}
+}
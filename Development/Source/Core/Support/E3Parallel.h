@@ -0,0 +1,102 @@
+#pragma once
+/*  NAME:
+        E3Parallel.h
+
+    DESCRIPTION:
+        Header file for E3Parallel.cpp.
+
+    COPYRIGHT:
+        Copyright (c) 2025, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+
+
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "E3Prefix.h"
+
+#include <functional>
+
+
+
+//=============================================================================
+//      Function prototypes
+//-----------------------------------------------------------------------------
+
+
+/*!
+	@function	E3Parallel_For
+	
+	@abstract	Run a loop body over the range [0, inCount), split into
+				contiguous pieces which may run on several threads at once.
+	
+	@discussion	The range is divided into at most one piece per hardware
+				thread, and no piece is smaller than inMinPerTask, so a small
+				range runs on the calling thread without any threads being
+				started.  The function returns when every piece is done.
+				
+				The loop body must not call Quesa API functions or allocate
+				with Quesa's memory manager, since those are not thread-safe.
+				It should only read shared input and write to the part of
+				the output that belongs to its own range.  The body must not
+				throw.
+	
+	@param		inCount			Number of items.
+	@param		inMinPerTask	Smallest number of items worth giving a
+								thread of its own.
+	@param		inBody			Function called with the start and end
+								(exclusive) of a piece of the range.
+*/
+void E3Parallel_For( TQ3Uns32 inCount, TQ3Uns32 inMinPerTask,
+					const std::function< void( TQ3Uns32 inStart, TQ3Uns32 inEnd ) >& inBody );
+
+
+/*!
+	@function	E3Parallel_GetNumTasks
+	
+	@abstract	Return the number of pieces E3Parallel_For would split a range
+				into.
+	
+	@discussion	This is useful when each piece needs a scratch area of its own.
+				Piece number i covers the items from
+				(inCount * i) / numTasks up to (inCount * (i+1)) / numTasks.
+	
+	@param		inCount			Number of items.
+	@param		inMinPerTask	Smallest number of items worth giving a
+								thread of its own.
+	@result		Number of pieces, at least 1.
+*/
+TQ3Uns32 E3Parallel_GetNumTasks( TQ3Uns32 inCount, TQ3Uns32 inMinPerTask );
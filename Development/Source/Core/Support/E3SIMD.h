@@ -0,0 +1,322 @@
+/*  NAME:
+        E3SIMD.h
+
+    DESCRIPTION:
+        Selection of the vector instruction set used by math kernels.
+
+    COPYRIGHT:
+        Copyright (c) 2025, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+#ifndef E3SIMD_HDR
+#define E3SIMD_HDR
+//=============================================================================
+//      Build constants
+//-----------------------------------------------------------------------------
+//		Note :	Kernels with vector implementations test these flags, and
+//				fall back to plain loops when neither is set. Define
+//				QUESA_USE_SIMD as 0 to force the plain loops, for example when
+//				checking results against them.
+//-----------------------------------------------------------------------------
+#ifndef QUESA_USE_SIMD
+	#define QUESA_USE_SIMD										1
+#endif
+
+
+// SSE2 is part of every x86-64 processor
+#if QUESA_USE_SIMD && ( defined(__SSE2__) || defined(_M_X64) || \
+	(defined(_M_IX86_FP) && (_M_IX86_FP >= 2)) )
+	#define QUESA_SIMD_SSE2										1
+	#include <emmintrin.h>
+#else
+	#define QUESA_SIMD_SSE2										0
+#endif
+
+
+// NEON is part of every 64-bit ARM processor
+#if QUESA_USE_SIMD && ! QUESA_SIMD_SSE2 && \
+	( defined(__aarch64__) || defined(_M_ARM64) )
+	#define QUESA_SIMD_NEON										1
+	#include <arm_neon.h>
+#else
+	#define QUESA_SIMD_NEON										0
+#endif
+
+
+// AVX2 is optional, so its kernels are compiled for it one function at a
+// time and only called when the processor reports support at run time
+#if QUESA_SIMD_SSE2 && ( defined(__GNUC__) || defined(_MSC_VER) )
+	#define QUESA_SIMD_AVX2										1
+	#include <immintrin.h>
+	#if defined(__GNUC__)
+		#define Q3_TARGET_AVX2		__attribute__((target("avx2")))
+	#else
+		#define Q3_TARGET_AVX2
+		#include <intrin.h>
+	#endif
+#else
+	#define QUESA_SIMD_AVX2										0
+#endif
+
+
+
+
+
+//=============================================================================
+//      Types
+//-----------------------------------------------------------------------------
+// Four floats processed together, for kernels that work the same way with
+// any instruction set. Without SSE2 or NEON the operations are plain loops.
+typedef struct E3Float4 {
+#if QUESA_SIMD_SSE2
+	__m128				v;
+#elif QUESA_SIMD_NEON
+	float32x4_t			v;
+#else
+	float				v[4];
+#endif
+} E3Float4;
+
+
+
+
+
+//=============================================================================
+//      Inline functions
+//-----------------------------------------------------------------------------
+//      E3Float4_Load : Load four floats from any address.
+//-----------------------------------------------------------------------------
+inline E3Float4
+E3Float4_Load(const float *inFloats)
+{	E3Float4	theResult;
+
+#if QUESA_SIMD_SSE2
+	theResult.v = _mm_loadu_ps( inFloats );
+#elif QUESA_SIMD_NEON
+	theResult.v = vld1q_f32( inFloats );
+#else
+	for (int n = 0; n < 4; ++n)
+		theResult.v[n] = inFloats[n];
+#endif
+
+	return theResult;
+}
+
+
+
+
+
+//=============================================================================
+//      E3Float4_Store : Store four floats to any address.
+//-----------------------------------------------------------------------------
+inline void
+E3Float4_Store(float *outFloats, E3Float4 inValue)
+{
+#if QUESA_SIMD_SSE2
+	_mm_storeu_ps( outFloats, inValue.v );
+#elif QUESA_SIMD_NEON
+	vst1q_f32( outFloats, inValue.v );
+#else
+	for (int n = 0; n < 4; ++n)
+		outFloats[n] = inValue.v[n];
+#endif
+}
+
+
+
+
+
+//=============================================================================
+//      E3Float4_Splat : Return four copies of a float.
+//-----------------------------------------------------------------------------
+inline E3Float4
+E3Float4_Splat(float inValue)
+{	E3Float4	theResult;
+
+#if QUESA_SIMD_SSE2
+	theResult.v = _mm_set1_ps( inValue );
+#elif QUESA_SIMD_NEON
+	theResult.v = vdupq_n_f32( inValue );
+#else
+	for (int n = 0; n < 4; ++n)
+		theResult.v[n] = inValue;
+#endif
+
+	return theResult;
+}
+
+
+
+
+
+//=============================================================================
+//      E3Float4 arithmetic : Lane by lane operations.
+//-----------------------------------------------------------------------------
+//		Note :	Multiplies and adds are never fused, so results match plain
+//				float arithmetic done in the same order.
+//-----------------------------------------------------------------------------
+#if QUESA_SIMD_SSE2
+	#define E3FLOAT4_BINARY(_name, _sse, _neon, _op)						\
+		inline E3Float4 _name(E3Float4 a, E3Float4 b)						\
+		{	E3Float4 r; r.v = _sse( a.v, b.v ); return r; }
+#elif QUESA_SIMD_NEON
+	#define E3FLOAT4_BINARY(_name, _sse, _neon, _op)						\
+		inline E3Float4 _name(E3Float4 a, E3Float4 b)						\
+		{	E3Float4 r; r.v = _neon( a.v, b.v ); return r; }
+#else
+	#define E3FLOAT4_BINARY(_name, _sse, _neon, _op)						\
+		inline E3Float4 _name(E3Float4 a, E3Float4 b)						\
+		{	E3Float4 r; for (int n = 0; n < 4; ++n) r.v[n] = _op( a.v[n], b.v[n] ); return r; }
+#endif
+
+#define E3FLOAT4_ADD(a, b)		((a) + (b))
+#define E3FLOAT4_SUB(a, b)		((a) - (b))
+#define E3FLOAT4_MUL(a, b)		((a) * (b))
+#define E3FLOAT4_DIV(a, b)		((a) / (b))
+#define E3FLOAT4_MIN(a, b)		((b) < (a) ? (b) : (a))
+#define E3FLOAT4_MAX(a, b)		((b) > (a) ? (b) : (a))
+
+E3FLOAT4_BINARY( E3Float4_Add, _mm_add_ps, vaddq_f32, E3FLOAT4_ADD )
+E3FLOAT4_BINARY( E3Float4_Sub, _mm_sub_ps, vsubq_f32, E3FLOAT4_SUB )
+E3FLOAT4_BINARY( E3Float4_Mul, _mm_mul_ps, vmulq_f32, E3FLOAT4_MUL )
+E3FLOAT4_BINARY( E3Float4_Div, _mm_div_ps, vdivq_f32, E3FLOAT4_DIV )
+E3FLOAT4_BINARY( E3Float4_Min, _mm_min_ps, vminq_f32, E3FLOAT4_MIN )
+E3FLOAT4_BINARY( E3Float4_Max, _mm_max_ps, vmaxq_f32, E3FLOAT4_MAX )
+
+#undef E3FLOAT4_BINARY
+#undef E3FLOAT4_ADD
+#undef E3FLOAT4_SUB
+#undef E3FLOAT4_MUL
+#undef E3FLOAT4_DIV
+#undef E3FLOAT4_MIN
+#undef E3FLOAT4_MAX
+
+
+
+
+
+//=============================================================================
+//      E3Float4_Sqrt : Return the square roots of four floats.
+//-----------------------------------------------------------------------------
+inline E3Float4
+E3Float4_Sqrt(E3Float4 inValue)
+{	E3Float4	theResult;
+
+#if QUESA_SIMD_SSE2
+	theResult.v = _mm_sqrt_ps( inValue.v );
+#elif QUESA_SIMD_NEON
+	theResult.v = vsqrtq_f32( inValue.v );
+#else
+	for (int n = 0; n < 4; ++n)
+		theResult.v[n] = sqrtf( inValue.v[n] );
+#endif
+
+	return theResult;
+}
+
+
+
+
+
+//=============================================================================
+//      E3Float4_EqualMask : Return bit n set where lane n of a equals b.
+//-----------------------------------------------------------------------------
+inline TQ3Uns32
+E3Float4_EqualMask(E3Float4 a, E3Float4 b)
+{
+#if QUESA_SIMD_SSE2
+	return (TQ3Uns32) _mm_movemask_ps( _mm_cmpeq_ps( a.v, b.v ) );
+#elif QUESA_SIMD_NEON
+	static const uint32_t kLaneBits[4] = { 1, 2, 4, 8 };
+	return vaddvq_u32( vandq_u32( vceqq_f32( a.v, b.v ), vld1q_u32( kLaneBits ) ) );
+#else
+	TQ3Uns32	theMask = 0;
+	for (int n = 0; n < 4; ++n)
+		if (a.v[n] == b.v[n])
+			theMask |= 1U << n;
+	return theMask;
+#endif
+}
+
+
+
+
+
+//=============================================================================
+//      E3Float4_LessMask : Return bit n set where lane n of a is less than b.
+//-----------------------------------------------------------------------------
+inline TQ3Uns32
+E3Float4_LessMask(E3Float4 a, E3Float4 b)
+{
+#if QUESA_SIMD_SSE2
+	return (TQ3Uns32) _mm_movemask_ps( _mm_cmplt_ps( a.v, b.v ) );
+#elif QUESA_SIMD_NEON
+	static const uint32_t kLaneBits[4] = { 1, 2, 4, 8 };
+	return vaddvq_u32( vandq_u32( vcltq_f32( a.v, b.v ), vld1q_u32( kLaneBits ) ) );
+#else
+	TQ3Uns32	theMask = 0;
+	for (int n = 0; n < 4; ++n)
+		if (a.v[n] < b.v[n])
+			theMask |= 1U << n;
+	return theMask;
+#endif
+}
+
+
+
+
+
+//=============================================================================
+//      E3Float4_LessEqualMask : Return bit n set where lane n of a is less
+//								 than or equal to b.
+//-----------------------------------------------------------------------------
+inline TQ3Uns32
+E3Float4_LessEqualMask(E3Float4 a, E3Float4 b)
+{
+#if QUESA_SIMD_SSE2
+	return (TQ3Uns32) _mm_movemask_ps( _mm_cmple_ps( a.v, b.v ) );
+#elif QUESA_SIMD_NEON
+	static const uint32_t kLaneBits[4] = { 1, 2, 4, 8 };
+	return vaddvq_u32( vandq_u32( vcleq_f32( a.v, b.v ), vld1q_u32( kLaneBits ) ) );
+#else
+	TQ3Uns32	theMask = 0;
+	for (int n = 0; n < 4; ++n)
+		if (a.v[n] <= b.v[n])
+			theMask |= 1U << n;
+	return theMask;
+#endif
+}
+
+#endif
@@ -53,6 +53,12 @@
 
 #include "glu-mesa.h"
 
+#include <algorithm>
+#include <cmath>
+#include <new>
+#include <set>
+#include <vector>
+
 
 //=============================================================================
 //      Internal types
@@ -101,6 +107,43 @@ typedef struct E3CombinedAttribute {
 } E3CombinedAttribute;
 
 
+// Contour point, projected onto the plane of the contour
+typedef struct E3TessellatePoint2D {
+	double				x;
+	double				y;
+} E3TessellatePoint2D;
+
+
+// Uniform grid of items over the bounding rectangle of a contour
+typedef struct E3TessellateGrid {
+	double					minX;
+	double					minY;
+	double					scaleX;
+	double					scaleY;
+	TQ3Uns32				numCellsX;
+	TQ3Uns32				numCellsY;
+	std::vector<TQ3Uns32>	cellStart;
+	std::vector<TQ3Uns32>	cellItems;
+} E3TessellateGrid;
+
+
+// Sweep line state for the simplicity test
+typedef struct E3TessellateSweep {
+	const E3TessellatePoint2D	*thePoints;
+	std::vector<TQ3Uns32>		leftPoint;
+	std::vector<TQ3Uns32>		rightPoint;
+	E3TessellatePoint2D			sweepPoint;
+} E3TessellateSweep;
+
+
+// Orders the edges crossing the sweep line from bottom to top
+struct E3TessellateSweepOrder {
+	const E3TessellateSweep		*theSweep;
+
+	bool operator()(TQ3Uns32 edgeA, TQ3Uns32 edgeB) const;
+};
+
+
 
 
 
@@ -870,6 +913,775 @@ e3tessellate_dispose_state(E3TessellateState *theState)
 
 
 
+//=============================================================================
+//      e3tessellate_fast_orient : Twice the signed area of a triangle.
+//-----------------------------------------------------------------------------
+//		Note :	Positive if a, b, c turn to the left.
+//-----------------------------------------------------------------------------
+static inline double
+e3tessellate_fast_orient(const E3TessellatePoint2D &a, const E3TessellatePoint2D &b, const E3TessellatePoint2D &c)
+{
+	return((b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x));
+}
+
+
+
+
+
+//=============================================================================
+//      e3tessellate_fast_on_segment : Is a point collinear with a segment on it?
+//-----------------------------------------------------------------------------
+static inline bool
+e3tessellate_fast_on_segment(const E3TessellatePoint2D &a, const E3TessellatePoint2D &b, const E3TessellatePoint2D &p)
+{
+	return(p.x >= std::min(a.x, b.x) && p.x <= std::max(a.x, b.x) &&
+		   p.y >= std::min(a.y, b.y) && p.y <= std::max(a.y, b.y));
+}
+
+
+
+
+
+//=============================================================================
+//      e3tessellate_fast_segments_touch : Do two closed segments touch?
+//-----------------------------------------------------------------------------
+static bool
+e3tessellate_fast_segments_touch(const E3TessellatePoint2D &a, const E3TessellatePoint2D &b,
+								 const E3TessellatePoint2D &c, const E3TessellatePoint2D &d)
+{
+	double d1 = e3tessellate_fast_orient(c, d, a);
+	double d2 = e3tessellate_fast_orient(c, d, b);
+	double d3 = e3tessellate_fast_orient(a, b, c);
+	double d4 = e3tessellate_fast_orient(a, b, d);
+
+
+
+	// Proper crossing
+	if (((d1 > 0.0 && d2 < 0.0) || (d1 < 0.0 && d2 > 0.0)) &&
+		((d3 > 0.0 && d4 < 0.0) || (d3 < 0.0 && d4 > 0.0)))
+		return(true);
+
+
+
+	// An end point on the other segment
+	return((d1 == 0.0 && e3tessellate_fast_on_segment(c, d, a)) ||
+		   (d2 == 0.0 && e3tessellate_fast_on_segment(c, d, b)) ||
+		   (d3 == 0.0 && e3tessellate_fast_on_segment(a, b, c)) ||
+		   (d4 == 0.0 && e3tessellate_fast_on_segment(a, b, d)));
+}
+
+
+
+
+
+//=============================================================================
+//      e3tessellate_fast_grid_init : Set up a grid over a set of points.
+//-----------------------------------------------------------------------------
+//		Note :	The grid has roughly one cell per item, with cells as close to
+//				square as possible, and starts out with no items.
+//-----------------------------------------------------------------------------
+static void
+e3tessellate_fast_grid_init(E3TessellateGrid &theGrid, const std::vector<E3TessellatePoint2D> &thePoints,
+							TQ3Uns32 numItems)
+{	double		maxX, maxY, theWidth, theHeight;
+
+
+
+	// Find the bounds
+	theGrid.minX = maxX = thePoints[0].x;
+	theGrid.minY = maxY = thePoints[0].y;
+
+	for (const E3TessellatePoint2D &thePoint : thePoints)
+		{
+		theGrid.minX = std::min(theGrid.minX, thePoint.x);
+		theGrid.minY = std::min(theGrid.minY, thePoint.y);
+		maxX         = std::max(maxX,         thePoint.x);
+		maxY         = std::max(maxY,         thePoint.y);
+		}
+
+
+
+	// Size the cells
+	theWidth  = maxX - theGrid.minX;
+	theHeight = maxY - theGrid.minY;
+	numItems  = std::max(1U, numItems);
+
+	double theAspect  = (theWidth > 0.0 && theHeight > 0.0) ? (theWidth / theHeight) : 1.0;
+	double numCellsX  = std::sqrt(numItems * theAspect);
+
+	theGrid.numCellsX = static_cast<TQ3Uns32>(std::min(static_cast<double>(numItems), std::max(1.0, numCellsX)));
+	theGrid.numCellsY = std::max(1U, numItems / theGrid.numCellsX);
+	theGrid.scaleX    = (theWidth  > 0.0) ? (theGrid.numCellsX / theWidth)  : 0.0;
+	theGrid.scaleY    = (theHeight > 0.0) ? (theGrid.numCellsY / theHeight) : 0.0;
+
+	theGrid.cellStart.assign(theGrid.numCellsX * theGrid.numCellsY + 1, 0);
+	theGrid.cellItems.clear();
+}
+
+
+
+
+
+//=============================================================================
+//      e3tessellate_fast_grid_range : Find the cells under a rectangle.
+//-----------------------------------------------------------------------------
+static void
+e3tessellate_fast_grid_range(const E3TessellateGrid &theGrid,
+							 const E3TessellatePoint2D &a, const E3TessellatePoint2D &b,
+							 TQ3Uns32 &minX, TQ3Uns32 &minY, TQ3Uns32 &maxX, TQ3Uns32 &maxY)
+{	double		lastCellX = theGrid.numCellsX - 1;
+	double		lastCellY = theGrid.numCellsY - 1;
+
+
+
+	minX = static_cast<TQ3Uns32>(std::min(lastCellX, (std::min(a.x, b.x) - theGrid.minX) * theGrid.scaleX));
+	maxX = static_cast<TQ3Uns32>(std::min(lastCellX, (std::max(a.x, b.x) - theGrid.minX) * theGrid.scaleX));
+	minY = static_cast<TQ3Uns32>(std::min(lastCellY, (std::min(a.y, b.y) - theGrid.minY) * theGrid.scaleY));
+	maxY = static_cast<TQ3Uns32>(std::min(lastCellY, (std::max(a.y, b.y) - theGrid.minY) * theGrid.scaleY));
+}
+
+
+
+
+
+//=============================================================================
+//      e3tessellate_fast_project : Project a contour onto its plane.
+//-----------------------------------------------------------------------------
+//		Note :	The contour is projected onto the coordinate plane most nearly
+//				parallel to it, and flipped if needed so that it turns to the
+//				left. Returns false if the contour has no area.
+//-----------------------------------------------------------------------------
+static bool
+e3tessellate_fast_project(const TQ3GeneralPolygonContourData &theContour,
+						  std::vector<E3TessellatePoint2D> &thePoints)
+{	double		normalX = 0.0, normalY = 0.0, normalZ = 0.0;
+	TQ3Uns32	n, m, numVertices = theContour.numVertices;
+
+
+
+	// Find the Newell normal
+	for (n = 0, m = numVertices - 1; n < numVertices; m = n++)
+		{
+		const TQ3Point3D &p = theContour.vertices[m].point;
+		const TQ3Point3D &q = theContour.vertices[n].point;
+
+		normalX += (static_cast<double>(p.y) - q.y) * (static_cast<double>(p.z) + q.z);
+		normalY += (static_cast<double>(p.z) - q.z) * (static_cast<double>(p.x) + q.x);
+		normalZ += (static_cast<double>(p.x) - q.x) * (static_cast<double>(p.y) + q.y);
+		}
+
+
+
+	// Drop the largest component
+	double absX = std::fabs(normalX), absY = std::fabs(normalY), absZ = std::fabs(normalZ);
+	double flipV;
+	int    axisU, axisV;
+
+	if (absZ >= absX && absZ >= absY)
+		{
+		axisU = 0;
+		axisV = 1;
+		flipV = (normalZ < 0.0) ? -1.0 : 1.0;
+		}
+	else if (absX >= absY)
+		{
+		axisU = 1;
+		axisV = 2;
+		flipV = (normalX < 0.0) ? -1.0 : 1.0;
+		}
+	else
+		{
+		axisU = 2;
+		axisV = 0;
+		flipV = (normalY < 0.0) ? -1.0 : 1.0;
+		}
+
+	if (!(std::max(absZ, std::max(absX, absY)) > 0.0))
+		return(false);
+
+
+
+	// Project the points
+	thePoints.resize(numVertices);
+
+	for (n = 0; n < numVertices; n++)
+		{
+		const float *theCoords = &theContour.vertices[n].point.x;
+
+		thePoints[n].x = theCoords[axisU];
+		thePoints[n].y = theCoords[axisV] * flipV;
+		}
+
+	return(true);
+}
+
+
+
+
+
+//=============================================================================
+//      e3tessellate_fast_is_convex : Is a projected contour strictly convex?
+//-----------------------------------------------------------------------------
+//		Note :	Every corner must turn to the left, and the contour must only
+//				go round once - which means the x direction of its edges can
+//				only change sign twice.
+//-----------------------------------------------------------------------------
+static bool
+e3tessellate_fast_is_convex(const std::vector<E3TessellatePoint2D> &thePoints)
+{	TQ3Uns32	n, numPoints = static_cast<TQ3Uns32>(thePoints.size());
+	TQ3Uns32	numFlips  = 0;
+	int			firstSign = 0, lastSign = 0;
+
+
+
+	for (n = 0; n < numPoints; n++)
+		{
+		const E3TessellatePoint2D &a = thePoints[(n + numPoints - 1) % numPoints];
+		const E3TessellatePoint2D &b = thePoints[n];
+		const E3TessellatePoint2D &c = thePoints[(n + 1) % numPoints];
+
+		if (e3tessellate_fast_orient(a, b, c) <= 0.0)
+			return(false);
+
+		int theSign = (c.x > b.x) ? 1 : ((c.x < b.x) ? -1 : 0);
+		if (theSign != 0)
+			{
+			if (firstSign == 0)
+				firstSign = theSign;
+			else if (theSign != lastSign)
+				numFlips++;
+
+			lastSign = theSign;
+			}
+		}
+
+	if (lastSign != firstSign)
+		numFlips++;
+
+	return(numFlips <= 2);
+}
+
+
+
+
+
+//=============================================================================
+//      e3tessellate_fast_sweep_y : Find where an edge crosses the sweep line.
+//-----------------------------------------------------------------------------
+static double
+e3tessellate_fast_sweep_y(const E3TessellateSweep &theSweep, TQ3Uns32 theEdge)
+{	const E3TessellatePoint2D	&a = theSweep.thePoints[theSweep.leftPoint[theEdge]];
+	const E3TessellatePoint2D	&b = theSweep.thePoints[theSweep.rightPoint[theEdge]];
+	const E3TessellatePoint2D	&p = theSweep.sweepPoint;
+
+
+
+	// Vertical edges are taken to cross at the sweep point, if they reach it
+	if (a.x == b.x)
+		return(std::min(b.y, std::max(a.y, p.y)));
+
+	if (p.x <= a.x)
+		return(a.y);
+
+	if (p.x >= b.x)
+		return(b.y);
+
+	return(a.y + (b.y - a.y) * ((p.x - a.x) / (b.x - a.x)));
+}
+
+
+
+
+
+//=============================================================================
+//      E3TessellateSweepOrder::operator() : Is one edge below another?
+//-----------------------------------------------------------------------------
+//		Note :	Edges that cross the sweep line at the same place are ordered
+//				by the way they head to the right.
+//-----------------------------------------------------------------------------
+bool
+E3TessellateSweepOrder::operator()(TQ3Uns32 edgeA, TQ3Uns32 edgeB) const
+{	const E3TessellatePoint2D	*thePoints = theSweep->thePoints;
+
+
+
+	if (edgeA == edgeB)
+		return(false);
+
+	double yA = e3tessellate_fast_sweep_y(*theSweep, edgeA);
+	double yB = e3tessellate_fast_sweep_y(*theSweep, edgeB);
+	if (yA != yB)
+		return(yA < yB);
+
+	const E3TessellatePoint2D &leftA  = thePoints[theSweep->leftPoint[edgeA]];
+	const E3TessellatePoint2D &rightA = thePoints[theSweep->rightPoint[edgeA]];
+	const E3TessellatePoint2D &leftB  = thePoints[theSweep->leftPoint[edgeB]];
+	const E3TessellatePoint2D &rightB = thePoints[theSweep->rightPoint[edgeB]];
+
+	double theCross = (rightA.x - leftA.x) * (rightB.y - leftB.y) -
+					  (rightA.y - leftA.y) * (rightB.x - leftB.x);
+	if (theCross != 0.0)
+		return(theCross > 0.0);
+
+	return(edgeA < edgeB);
+}
+
+
+
+
+
+//=============================================================================
+//      e3tessellate_fast_edges_touch : Do two edges touch other than at a corner?
+//-----------------------------------------------------------------------------
+static bool
+e3tessellate_fast_edges_touch(const E3TessellateSweep &theSweep, TQ3Uns32 edgeA, TQ3Uns32 edgeB)
+{	TQ3Uns32	numPoints = static_cast<TQ3Uns32>(theSweep.leftPoint.size());
+	TQ3Uns32	theGap    = (edgeA > edgeB) ? (edgeA - edgeB) : (edgeB - edgeA);
+
+
+
+	// Neighbouring edges share a corner, and can only overlap if the contour
+	// doubles back on itself - which has already been checked for
+	if (theGap == 1 || theGap == numPoints - 1)
+		return(false);
+
+	return(e3tessellate_fast_segments_touch(
+				theSweep.thePoints[theSweep.leftPoint[edgeA]], theSweep.thePoints[theSweep.rightPoint[edgeA]],
+				theSweep.thePoints[theSweep.leftPoint[edgeB]], theSweep.thePoints[theSweep.rightPoint[edgeB]]));
+}
+
+
+
+
+
+//=============================================================================
+//      e3tessellate_fast_is_simple : Is a projected contour simple?
+//-----------------------------------------------------------------------------
+//		Note :	Fails for contours whose edges cross, overlap or touch other
+//				than at the corners they share, including contours that have
+//				zero length edges or that pass through the same point twice.
+//
+//				A line is swept across the contour from left to right, with
+//				the edges that cross it kept in order from bottom to top. Two
+//				edges can only touch once they are next to each other on the
+//				line, so only those need to be tested (Shamos and Hoey).
+//-----------------------------------------------------------------------------
+static bool
+e3tessellate_fast_is_simple(const std::vector<E3TessellatePoint2D> &thePoints)
+{	TQ3Uns32			n, m, numPoints = static_cast<TQ3Uns32>(thePoints.size());
+	E3TessellateSweep	theSweep;
+
+
+
+	// Check the corners - neighbouring edges only touch at their shared
+	// point, unless the contour doubles back on itself
+	for (n = 0; n < numPoints; n++)
+		{
+		const E3TessellatePoint2D &a = thePoints[(n + numPoints - 1) % numPoints];
+		const E3TessellatePoint2D &b = thePoints[n];
+		const E3TessellatePoint2D &c = thePoints[(n + 1) % numPoints];
+
+		if (e3tessellate_fast_orient(a, b, c) == 0.0 &&
+			(b.x - a.x) * (c.x - b.x) + (b.y - a.y) * (c.y - b.y) <= 0.0)
+			return(false);
+		}
+
+
+
+	// Sort the points from left to right, checking for repeats
+	auto isLeftOf = [&](TQ3Uns32 pointA, TQ3Uns32 pointB)
+		{
+		return(thePoints[pointA].x < thePoints[pointB].x ||
+			   (thePoints[pointA].x == thePoints[pointB].x && thePoints[pointA].y < thePoints[pointB].y));
+		};
+
+	std::vector<TQ3Uns32> sortedPoints(numPoints);
+	for (n = 0; n < numPoints; n++)
+		sortedPoints[n] = n;
+
+	std::sort(sortedPoints.begin(), sortedPoints.end(), isLeftOf);
+
+	for (n = 1; n < numPoints; n++)
+		{
+		if (!isLeftOf(sortedPoints[n - 1], sortedPoints[n]))
+			return(false);
+		}
+
+
+
+	// Find the ends of each edge
+	theSweep.thePoints = thePoints.data();
+	theSweep.leftPoint.resize(numPoints);
+	theSweep.rightPoint.resize(numPoints);
+
+	for (n = 0; n < numPoints; n++)
+		{
+		m = (n + 1) % numPoints;
+
+		theSweep.leftPoint[n]  = isLeftOf(n, m) ? n : m;
+		theSweep.rightPoint[n] = isLeftOf(n, m) ? m : n;
+		}
+
+
+
+	// Sweep across the points - edges ending at each point leave the line,
+	// and edges starting there join it
+	typedef std::set<TQ3Uns32, E3TessellateSweepOrder>	E3TessellateSweepLine;
+
+	E3TessellateSweepLine								sweepLine(E3TessellateSweepOrder{ &theSweep });
+	std::vector<E3TessellateSweepLine::iterator>		edgePositions(numPoints);
+
+	for (TQ3Uns32 thePoint : sortedPoints)
+		{
+		TQ3Uns32 theEdges[2] = { (thePoint + numPoints - 1) % numPoints, thePoint };
+
+		theSweep.sweepPoint = thePoints[thePoint];
+
+		for (TQ3Uns32 theEdge : theEdges)
+			{
+			if (theSweep.rightPoint[theEdge] != thePoint)
+				continue;
+
+			auto thePosition = edgePositions[theEdge];
+			auto theAbove    = std::next(thePosition);
+
+			if (thePosition != sweepLine.begin() && theAbove != sweepLine.end() &&
+				e3tessellate_fast_edges_touch(theSweep, *std::prev(thePosition), *theAbove))
+				return(false);
+
+			sweepLine.erase(thePosition);
+			}
+
+		for (TQ3Uns32 theEdge : theEdges)
+			{
+			if (theSweep.leftPoint[theEdge] != thePoint)
+				continue;
+
+			auto thePosition = sweepLine.insert(theEdge).first;
+			auto theAbove    = std::next(thePosition);
+
+			edgePositions[theEdge] = thePosition;
+
+			if (thePosition != sweepLine.begin() &&
+				e3tessellate_fast_edges_touch(theSweep, *std::prev(thePosition), theEdge))
+				return(false);
+
+			if (theAbove != sweepLine.end() &&
+				e3tessellate_fast_edges_touch(theSweep, theEdge, *theAbove))
+				return(false);
+			}
+		}
+
+	return(true);
+}
+
+
+
+
+
+//=============================================================================
+//      e3tessellate_fast_fan : Triangulate a convex contour.
+//-----------------------------------------------------------------------------
+//		Note :	Fills in the triangles, and the triangle that uses each edge
+//				of the contour.
+//-----------------------------------------------------------------------------
+static void
+e3tessellate_fast_fan(TQ3Uns32 numPoints, TQ3TriMeshTriangleData *theTriangles, TQ3TriMeshEdgeData *theEdges)
+{	TQ3Uns32	n;
+
+
+
+	for (n = 0; n < numPoints - 2; n++)
+		{
+		theTriangles[n].pointIndices[0] = 0;
+		theTriangles[n].pointIndices[1] = n + 1;
+		theTriangles[n].pointIndices[2] = n + 2;
+
+		theEdges[n + 1].triangleIndices[0] = n;
+		}
+
+	theEdges[0].triangleIndices[0]             = 0;
+	theEdges[numPoints - 1].triangleIndices[0] = numPoints - 3;
+}
+
+
+
+
+
+//=============================================================================
+//      e3tessellate_fast_clip_ears : Triangulate a simple contour.
+//-----------------------------------------------------------------------------
+//		Note :	Cuts ears off the contour until one triangle is left. A corner
+//				is an ear if it turns to the left and no other corner lies in
+//				its triangle. Only corners that don't turn to the left can be
+//				in an ear, and once a corner turns to the left it stays that
+//				way, so they are binned into a grid and the rest ignored.
+//
+//				Fills in the triangles, and the triangle that uses each edge
+//				of the contour. Returns false if it runs out of ears, which
+//				can happen if rounding leaves too little room around a corner.
+//-----------------------------------------------------------------------------
+static bool
+e3tessellate_fast_clip_ears(const std::vector<E3TessellatePoint2D> &thePoints,
+							TQ3TriMeshTriangleData *theTriangles, TQ3TriMeshEdgeData *theEdges)
+{	TQ3Uns32				n, x, y, minX, minY, maxX, maxY;
+	TQ3Uns32				numPoints = static_cast<TQ3Uns32>(thePoints.size());
+	std::vector<TQ3Uns32>	prevPoint(numPoints), nextPoint(numPoints);
+	std::vector<TQ3Uns8>	isReflex(numPoints);
+	E3TessellateGrid		theGrid;
+	TQ3Uns32				numReflex = 0;
+
+
+
+	// Link up the contour and find the corners that don't turn to the left
+	for (n = 0; n < numPoints; n++)
+		{
+		prevPoint[n] = (n + numPoints - 1) % numPoints;
+		nextPoint[n] = (n + 1) % numPoints;
+		isReflex[n]  = (e3tessellate_fast_orient(thePoints[prevPoint[n]], thePoints[n], thePoints[nextPoint[n]]) <= 0.0);
+
+		if (isReflex[n])
+			numReflex++;
+		}
+
+
+
+	// Bin them by cell
+	std::vector<TQ3Uns32> pointCells(numPoints);
+
+	e3tessellate_fast_grid_init(theGrid, thePoints, numReflex);
+
+	for (n = 0; n < numPoints; n++)
+		{
+		if (isReflex[n])
+			{
+			e3tessellate_fast_grid_range(theGrid, thePoints[n], thePoints[n], minX, minY, maxX, maxY);
+
+			pointCells[n] = minY * theGrid.numCellsX + minX;
+			theGrid.cellStart[pointCells[n] + 1]++;
+			}
+		}
+
+	for (n = 1; n < theGrid.cellStart.size(); n++)
+		theGrid.cellStart[n] += theGrid.cellStart[n - 1];
+
+	std::vector<TQ3Uns32> cellEnd(theGrid.cellStart.begin(), theGrid.cellStart.end() - 1);
+	theGrid.cellItems.resize(numReflex);
+
+	for (n = 0; n < numPoints; n++)
+		{
+		if (isReflex[n])
+			theGrid.cellItems[cellEnd[pointCells[n]]++] = n;
+		}
+
+
+
+	// Cut off ears
+	TQ3Uns32 numRemaining = numPoints;
+	TQ3Uns32 numTriangles = 0;
+	TQ3Uns32 numTried     = 0;
+	TQ3Uns32 thePoint     = 0;
+
+	while (numRemaining > 3)
+		{
+		TQ3Uns32 a = prevPoint[thePoint];
+		TQ3Uns32 c = nextPoint[thePoint];
+		bool     isEar = !isReflex[thePoint];
+
+		// Once every corner turns to the left, every corner is an ear
+		if (isEar && numReflex != 0)
+			{
+			E3TessellatePoint2D boundsMin = { std::min(thePoints[a].x, std::min(thePoints[thePoint].x, thePoints[c].x)),
+											  std::min(thePoints[a].y, std::min(thePoints[thePoint].y, thePoints[c].y)) };
+			E3TessellatePoint2D boundsMax = { std::max(thePoints[a].x, std::max(thePoints[thePoint].x, thePoints[c].x)),
+											  std::max(thePoints[a].y, std::max(thePoints[thePoint].y, thePoints[c].y)) };
+
+			e3tessellate_fast_grid_range(theGrid, boundsMin, boundsMax, minX, minY, maxX, maxY);
+
+			for (y = minY; y <= maxY && isEar; y++)
+				{
+				for (x = minX; x <= maxX && isEar; x++)
+					{
+					TQ3Uns32 theCell = y * theGrid.numCellsX + x;
+
+					for (n = theGrid.cellStart[theCell]; n < theGrid.cellStart[theCell + 1]; n++)
+						{
+						TQ3Uns32 other = theGrid.cellItems[n];
+						if (!isReflex[other] || other == a || other == c)
+							continue;
+
+						const E3TessellatePoint2D &p = thePoints[other];
+						if (e3tessellate_fast_orient(thePoints[a],        thePoints[thePoint], p) >= 0.0 &&
+							e3tessellate_fast_orient(thePoints[thePoint], thePoints[c],        p) >= 0.0 &&
+							e3tessellate_fast_orient(thePoints[c],        thePoints[a],        p) >= 0.0)
+							{
+							isEar = false;
+							break;
+							}
+						}
+					}
+				}
+			}
+
+		if (!isEar)
+			{
+			if (++numTried > numRemaining)
+				return(false);
+
+			thePoint = c;
+			continue;
+			}
+
+
+
+		// Cut it off
+		theTriangles[numTriangles].pointIndices[0] = a;
+		theTriangles[numTriangles].pointIndices[1] = thePoint;
+		theTriangles[numTriangles].pointIndices[2] = c;
+
+		if (thePoint == (a + 1) % numPoints)
+			theEdges[a].triangleIndices[0] = numTriangles;
+
+		if (c == (thePoint + 1) % numPoints)
+			theEdges[thePoint].triangleIndices[0] = numTriangles;
+
+		numTriangles++;
+
+		nextPoint[a] = c;
+		prevPoint[c] = a;
+		numRemaining--;
+		numTried = 0;
+
+		if (isReflex[a] && e3tessellate_fast_orient(thePoints[prevPoint[a]], thePoints[a], thePoints[c]) > 0.0)
+			{
+			isReflex[a] = 0;
+			numReflex--;
+			}
+
+		if (isReflex[c] && e3tessellate_fast_orient(thePoints[a], thePoints[c], thePoints[nextPoint[c]]) > 0.0)
+			{
+			isReflex[c] = 0;
+			numReflex--;
+			}
+
+		thePoint = c;
+		}
+
+
+
+	// Add the last triangle, which holds whatever edges are left
+	TQ3Uns32 theCorners[3] = { prevPoint[thePoint], thePoint, nextPoint[thePoint] };
+
+	for (n = 0; n < 3; n++)
+		{
+		theTriangles[numTriangles].pointIndices[n] = theCorners[n];
+
+		if (theCorners[(n + 1) % 3] == (theCorners[n] + 1) % numPoints)
+			theEdges[theCorners[n]].triangleIndices[0] = numTriangles;
+		}
+
+	return(true);
+}
+
+
+
+
+
+//=============================================================================
+//      e3tessellate_fast_contour : Triangulate a single contour directly.
+//-----------------------------------------------------------------------------
+//		Note :	Convex contours are fanned, and other simple contours have
+//				their ears cut off. Either way each triangle turns the same
+//				way as the contour, and every vertex of the contour is used
+//				as is, so the TriMesh is built the same way as for the GLU
+//				tessellator.
+//
+//				Returns false, leaving the TriMesh alone, if the contour is
+//				not simple - the GLU tessellator then has to work out which
+//				parts of it are inside.
+//-----------------------------------------------------------------------------
+static bool
+e3tessellate_fast_contour(const TQ3GeneralPolygonContourData &theContour, TQ3AttributeSet theAttributes,
+						  TQ3GeometryObject *theTriMesh)
+{	TQ3Uns32			n, numPoints = theContour.numVertices;
+	E3TessellateState	theState;
+	bool				wasTriangulated;
+
+
+
+	// Validate our parameters
+	if (numPoints < 3)
+		return(false);
+
+
+
+	// Set up our state
+	Q3Memory_Clear(&theState, sizeof(theState));
+
+	theState.triMeshVertexList       = (TQ3Vertex3D **)            Q3Memory_Allocate(static_cast<TQ3Uns32>(numPoints       * sizeof(TQ3Vertex3D *)));
+	theState.triMeshData.triangles   = (TQ3TriMeshTriangleData *)  Q3Memory_Allocate(static_cast<TQ3Uns32>((numPoints - 2) * sizeof(TQ3TriMeshTriangleData)));
+	theState.triMeshData.edges       = (TQ3TriMeshEdgeData *)      Q3Memory_Allocate(static_cast<TQ3Uns32>(numPoints       * sizeof(TQ3TriMeshEdgeData)));
+
+	if (theState.triMeshVertexList == nullptr || theState.triMeshData.triangles == nullptr || theState.triMeshData.edges == nullptr)
+		{
+		e3tessellate_dispose_state(&theState);
+		return(false);
+		}
+
+	theState.numTriMeshVertices       = numPoints;
+	theState.triMeshData.numTriangles = numPoints - 2;
+	theState.triMeshData.numEdges     = numPoints;
+
+	for (n = 0; n < numPoints; n++)
+		{
+		theState.triMeshVertexList[n] = const_cast<TQ3Vertex3D *>(&theContour.vertices[n]);
+
+		theState.triMeshData.edges[n].pointIndices[0]    = n;
+		theState.triMeshData.edges[n].pointIndices[1]    = (n + 1) % numPoints;
+		theState.triMeshData.edges[n].triangleIndices[0] = kQ3ArrayIndexNULL;
+		theState.triMeshData.edges[n].triangleIndices[1] = kQ3ArrayIndexNULL;
+		}
+
+
+
+	// Triangulate the contour
+	try
+		{
+		std::vector<E3TessellatePoint2D> thePoints;
+
+		wasTriangulated = e3tessellate_fast_project(theContour, thePoints);
+		if (wasTriangulated)
+			{
+			if (e3tessellate_fast_is_convex(thePoints))
+				e3tessellate_fast_fan(numPoints, theState.triMeshData.triangles, theState.triMeshData.edges);
+
+			else if (e3tessellate_fast_is_simple(thePoints))
+				wasTriangulated = e3tessellate_fast_clip_ears(thePoints, theState.triMeshData.triangles, theState.triMeshData.edges);
+
+			else
+				wasTriangulated = false;
+			}
+		}
+	catch (const std::bad_alloc&)
+		{
+		wasTriangulated = false;
+		}
+
+
+
+	// Create the TriMesh
+	if (wasTriangulated)
+		*theTriMesh = e3tessellate_create_trimesh(&theState, theAttributes);
+
+	e3tessellate_dispose_state(&theState);
+
+	return(wasTriangulated);
+}
+
+
+
+
+
 //=============================================================================
 //      Public functions
 //-----------------------------------------------------------------------------
@@ -881,6 +1693,10 @@ e3tessellate_dispose_state(E3TessellateState *theState)
 //
 //				Overlapping contours form holes, with the even-odd rule used to
 //				determine which portion of the polygon is to be removed.
+//
+//				A single contour which doesn't cross or touch itself is
+//				triangulated directly. Anything else goes through the GLU
+//				tessellator.
 //-----------------------------------------------------------------------------
 TQ3Object
 E3Tessellate_Contours(TQ3Uns32 numContours,
@@ -900,6 +1716,11 @@ E3Tessellate_Contours(TQ3Uns32 numContours,
 
 
 
+	// Try the fast path
+	theTriMesh = nullptr;
+
+	if (numContours == 1 && e3tessellate_fast_contour(theContours[0], theAttributes, &theTriMesh))
+		return(theTriMesh);
 
 
 
@@ -51,6 +51,9 @@
 #include "E3Renderer.h"
 #include "E3Style.h"
 #include "E3Main.h"
+#include "E3Math.h"
+#include "E3GroupPickTree.h"
+#include "QuesaMathOperators.hpp"
 
 
 
@@ -104,6 +107,31 @@ public :
 	
 
 
+struct E3LODDisplayGroupData
+{
+	TQ3Uns32				numThresholds;
+	float*					thresholds;
+	float					hysteresis;
+	TQ3Boolean				pickFinest;
+	TQ3Uns32				currentIndex;
+};
+
+
+
+class E3LODDisplayGroup : public E3DisplayGroup // This is a leaf class so no other classes use this,
+								// so it can be here in the .c file rather than in
+								// the .h file, hence all the fields can be public
+								// as nobody should be including this file
+	{
+Q3_CLASS_ENUMS ( kQ3DisplayGroupTypeLOD, E3LODDisplayGroup, E3DisplayGroup )
+
+public :
+
+	E3LODDisplayGroupData		lodDisplayGroupData;
+	} ;
+	
+
+
 //=============================================================================
 //      Internal functions
 //-----------------------------------------------------------------------------
@@ -197,6 +225,9 @@ e3group_new(TQ3Object theObject, void *privateData, const void *paramData)
 	instanceData->groupData.listHead.prev        = &instanceData->groupData.listHead;
 	instanceData->groupData.listHead.object      = theObject; // points to itself but never used
 	instanceData->groupData.groupPositionSize    = sizeof( TQ3GroupPosition );
+	instanceData->groupData.subtreeEditStamp     = 0;
+	instanceData->groupData.subtreeValidStamp    = 0;
+	instanceData->groupData.pickTree             = nullptr;
 
 	return kQ3Success ;
 	}
@@ -212,6 +243,13 @@ static void
 e3group_delete(TQ3Object theObject, void *privateData)
 {
 #pragma unused(privateData)
+	E3Group				*instanceData = (E3Group*) theObject ;
+
+
+
+	// Dispose of the pick tree
+	delete instanceData->groupData.pickTree;
+	instanceData->groupData.pickTree = nullptr;
 
 
 
@@ -668,6 +706,54 @@ E3Group::countobjects ( TQ3ObjectType isType, TQ3Uns32 *number )
 
 
 
+//=============================================================================
+//      E3Group::GetSubtreeEditStamp : Get the latest edit stamp of a group.
+//-----------------------------------------------------------------------------
+//		Note :	The result is memoized, and stays valid until the next edit to
+//				any shared object. Checking an unchanged scene is then O(1),
+//				and after an edit each group is walked at most once.
+//-----------------------------------------------------------------------------
+TQ3Uns32
+E3Group::GetSubtreeEditStamp ( void )
+{
+	TQ3Uns32 latestStamp = E3Shared_GetLatestEditStamp() ;
+
+	if (groupData.subtreeValidStamp != latestStamp)
+	{
+		// Optimization: all members of a group are shared
+		TQ3Uns32 theStamp = GetEditStamp() ;
+		for ( TQ3XGroupPosition* pos = groupData.listHead.next; pos != &groupData.listHead;
+			pos = pos->next )
+		{
+			theStamp = E3Num_Max( theStamp, E3Shared_GetSubtreeEditStamp( pos->object ) ) ;
+		}
+
+
+		// Ordered display groups keep their members on a list for each type
+		if ( Q3_OBJECT_IS_CLASS( this, E3OrderedDisplayGroup ) )
+		{
+			E3OrderedDisplayGroupData& orderedData( ( (E3OrderedDisplayGroup*) this )->orderedDisplayGroupData ) ;
+			for ( TQ3Uns32 i = 0; i < kQ3XOrderIndex_Count; ++i )
+			{
+				TQ3XGroupPosition* listHead = &orderedData.listHeads[ i ] ;
+				for ( TQ3XGroupPosition* pos = listHead->next; pos != listHead; pos = pos->next )
+				{
+					theStamp = E3Num_Max( theStamp, E3Shared_GetSubtreeEditStamp( pos->object ) ) ;
+				}
+			}
+		}
+
+		groupData.subtreeEditStamp  = theStamp ;
+		groupData.subtreeValidStamp = latestStamp ;
+	}
+
+	return groupData.subtreeEditStamp ;
+}
+
+
+
+
+
 //=============================================================================
 //      e3group_emptyobjectsoftype : Group empty objects of type method.
 //-----------------------------------------------------------------------------
@@ -1092,10 +1178,21 @@ e3group_submit_pick(TQ3ViewObject theView, TQ3ObjectType objectType,
 
 
 
+	// If the group has a pick tree, let it submit just the objects near the ray
+	TQ3Status qd3dStatus ;
+	if ( theObject->groupData.pickTree != nullptr &&
+		theObject->groupData.pickTree->SubmitPick( theView, qd3dStatus ) )
+	{
+		E3View_PickStack_PopGroup(theView);
+		return qd3dStatus;
+	}
+
+
+
 	// Submit the contents of the group
 	TQ3GroupPosition thePosition ;
 	TQ3Object subObject ;
-	TQ3Status qd3dStatus = groupClass->startIterateMethod ( theObject, &thePosition, &subObject, theView ) ;
+	qd3dStatus = groupClass->startIterateMethod ( theObject, &thePosition, &subObject, theView ) ;
 	if ( qd3dStatus != kQ3Failure )
 	{
 		while ( subObject != nullptr ) // If that was the last object, stop
@@ -2612,6 +2709,275 @@ e3group_display_ioproxy_metahandler(TQ3XMethodType methodType)
 
 
 
+//-----------------------------------------------------------------------------
+/*
+ *
+ *	LOD Display Group
+ *
+ *	LOD display groups hold several representations of the same object,
+ *	with the FIRST object being the MOST detailed and the LAST object the
+ *	least detailed.
+ *
+ *	When drawn, one representation is chosen by comparing the window area
+ *	covered by the group's bounding box with a list of thresholds, and the
+ *	other objects are ignored. The choice is remembered so that hysteresis
+ *	can prevent the group flickering between two representations when its
+ *	area is close to a threshold.
+ *
+ *	When bounded the first object is used, and when picked either the
+ *	first object or the object that would be drawn is used. When written,
+ *	all of the objects are written.
+ *
+ */
+//-----------------------------------------------------------------------------
+
+//=============================================================================
+//      e3group_display_lod_new : LOD display group new method.
+//-----------------------------------------------------------------------------
+#pragma mark -
+static TQ3Status
+e3group_display_lod_new(TQ3Object theObject, void *privateData, const void *paramData)
+{	E3LODDisplayGroupData	*instanceData = (E3LODDisplayGroupData *) privateData;
+#pragma unused (theObject)
+#pragma unused (paramData)
+
+
+
+	// Initialise our instance data
+	instanceData->numThresholds = 0;
+	instanceData->thresholds    = nullptr;
+	instanceData->hysteresis    = 0.1f;
+	instanceData->pickFinest    = kQ3False;
+	instanceData->currentIndex  = 0;
+
+	return kQ3Success ;
+}
+
+
+
+
+
+//=============================================================================
+//      e3group_display_lod_delete : LOD display group delete method.
+//-----------------------------------------------------------------------------
+static void
+e3group_display_lod_delete(TQ3Object theObject, void *privateData)
+{	E3LODDisplayGroupData	*instanceData = (E3LODDisplayGroupData *) privateData;
+#pragma unused (theObject)
+
+
+
+	// Dispose of our instance data
+	Q3Memory_Free( &instanceData->thresholds );
+}
+
+
+
+
+
+//=============================================================================
+//      e3group_display_lod_duplicate : LOD display group duplicate method.
+//-----------------------------------------------------------------------------
+static TQ3Status
+e3group_display_lod_duplicate(	TQ3Object fromObject, const void *fromPrivateData,
+								TQ3Object toObject,   void  * toPrivateData)
+{	const E3LODDisplayGroupData	*fromInstanceData = (const E3LODDisplayGroupData *) fromPrivateData;
+	E3LODDisplayGroupData		*toInstanceData   = (E3LODDisplayGroupData *)       toPrivateData;
+#pragma unused (fromObject)
+#pragma unused (toObject)
+
+
+
+	// Copy the settings, then the thresholds
+	*toInstanceData = *fromInstanceData;
+	toInstanceData->thresholds = nullptr;
+
+	if (fromInstanceData->numThresholds != 0)
+	{
+		TQ3Uns32 theSize = static_cast<TQ3Uns32>(fromInstanceData->numThresholds * sizeof(float));
+		toInstanceData->thresholds = (float *) Q3Memory_Allocate( theSize );
+		if (toInstanceData->thresholds == nullptr)
+		{
+			toInstanceData->numThresholds = 0;
+			return kQ3Failure;
+		}
+		
+		Q3Memory_Copy( fromInstanceData->thresholds, toInstanceData->thresholds, theSize );
+	}
+
+	return kQ3Success;
+}
+
+
+
+
+
+//=============================================================================
+//      e3group_display_lod_chooseindex : Choose the representation to draw.
+//-----------------------------------------------------------------------------
+//		Note :	Returns kQ3ArrayIndexNULL if nothing should be drawn.
+//
+//				Representation i is used if the window area of the bounds is
+//				at least threshold i. If the area is below every threshold, the
+//				representation after the last threshold is used, or nothing if
+//				there is no such representation.
+//
+//				Hysteresis makes it a little harder to move away from the
+//				current choice: a finer representation needs an area slightly
+//				above its threshold, while the current or coarser ones are kept
+//				until the area falls slightly below theirs.
+//-----------------------------------------------------------------------------
+static TQ3Uns32
+e3group_display_lod_chooseindex( E3LODDisplayGroup* lodGroup, TQ3ViewObject theView,
+								TQ3Uns32 numObjects, TQ3Uns32 currentIndex )
+{	const E3LODDisplayGroupData&	lodData( lodGroup->lodDisplayGroupData );
+	TQ3BoundingBox					theBounds;
+	TQ3Area							windowArea;
+
+
+
+	// Without thresholds or bounds there is no basis for a choice, and if part
+	// of the bounds is behind the camera we are close enough to need detail.
+	if ( (lodData.numThresholds == 0) ||
+		(kQ3Success != lodGroup->GetBoundingBox( &theBounds )) ||
+		theBounds.isEmpty ||
+		(! E3View_GetWindowAreaOfBounds( theView, theBounds, windowArea )) )
+	{
+		return 0;
+	}
+
+	TQ3Vector2D windowSize = windowArea.max - windowArea.min;
+	float screenArea = windowSize.x * windowSize.y * E3View_GetLODBias( theView );
+
+
+
+	// Find the first threshold that we reach
+	TQ3Uns32 numChoices = E3Num_Min( lodData.numThresholds, numObjects );
+	
+	for (TQ3Uns32 i = 0; i < numChoices; ++i)
+	{
+		float theThreshold = lodData.thresholds[i];
+		
+		if (i < currentIndex)
+			theThreshold *= (1.0f + lodData.hysteresis);
+		else
+			theThreshold *= (1.0f - lodData.hysteresis);
+		
+		if (screenArea >= theThreshold)
+			return i;
+	}
+	
+	return (numChoices < numObjects) ? numChoices : kQ3ArrayIndexNULL;
+}
+
+
+
+
+
+//=============================================================================
+//      e3group_display_lod_startiterate : LOD start iterate method.
+//-----------------------------------------------------------------------------
+//		Note : Submits only the selected representation
+//-----------------------------------------------------------------------------
+static TQ3Status
+e3group_display_lod_startiterate(TQ3GroupObject group, TQ3GroupPosition *iterator, TQ3Object *object, TQ3ViewObject view)
+{	E3LODDisplayGroup*		lodGroup = (E3LODDisplayGroup*) group;
+	TQ3Status				err = kQ3Success;
+	TQ3Object				theObject = nullptr;
+	TQ3GroupPosition		thePosition = nullptr;
+	TQ3Uns32				numObjects = 0;
+	TQ3Uns32				theIndex = 0;
+
+
+
+	// Choose a representation
+	lodGroup->CountObjects( &numObjects );
+	
+	switch (E3View_GetViewMode( view ))
+	{
+		case kQ3ViewModeDrawing:
+			theIndex = e3group_display_lod_chooseindex( lodGroup, view, numObjects,
+				lodGroup->lodDisplayGroupData.currentIndex );
+			lodGroup->lodDisplayGroupData.currentIndex = theIndex;
+			break;
+		
+		case kQ3ViewModePicking:
+			if (! lodGroup->lodDisplayGroupData.pickFinest)
+				theIndex = e3group_display_lod_chooseindex( lodGroup, view, numObjects,
+					lodGroup->lodDisplayGroupData.currentIndex );
+			break;
+		
+		default:
+			break;
+	}
+
+
+
+	// Find it
+	if (theIndex < numObjects)
+	{
+		err = lodGroup->GetFirstPosition( &thePosition );
+		
+		for (TQ3Uns32 i = 0; (err == kQ3Success) && (i < theIndex); ++i)
+			err = lodGroup->GetNextPosition( &thePosition );
+		
+		if ( (err == kQ3Success) && (thePosition != nullptr) )
+			err = lodGroup->GetPositionObject( thePosition, &theObject );
+		else
+			thePosition = nullptr;
+	}
+
+	if (object)
+		*object = theObject;
+	if (iterator)
+		*iterator = thePosition;
+	return(err);
+}
+
+
+
+
+
+//=============================================================================
+//      e3group_display_lod_metahandler : LOD display group metahandler.
+//-----------------------------------------------------------------------------
+static TQ3XFunctionPointer
+e3group_display_lod_metahandler(TQ3XMethodType methodType)
+{	TQ3XFunctionPointer		theMethod = nullptr;
+
+
+
+	// Return our methods
+	switch (methodType) {
+		case kQ3XMethodTypeObjectNew:
+			theMethod = (TQ3XFunctionPointer) e3group_display_lod_new;
+			break;
+
+		case kQ3XMethodTypeObjectDelete:
+			theMethod = (TQ3XFunctionPointer) e3group_display_lod_delete;
+			break;
+
+		case kQ3XMethodTypeObjectDuplicate:
+			theMethod = (TQ3XFunctionPointer) e3group_display_lod_duplicate;
+			break;
+
+		case kQ3XMethodType_GroupStartIterate:
+			theMethod = (TQ3XFunctionPointer) e3group_display_lod_startiterate;
+			break;
+
+		case kQ3XMethodType_GroupEndIterate:
+			// Like IO proxy groups, we only ever submit one object
+			theMethod = (TQ3XFunctionPointer) e3group_display_ioproxy_enditerate;
+			break;
+		}
+	
+	return(theMethod);
+}
+
+
+
+
+
 //=============================================================================
 //      e3group_light_acceptobject : Group accept object method.
 //-----------------------------------------------------------------------------
@@ -2742,6 +3108,12 @@ E3Group_RegisterClass(void)
 											e3group_display_ioproxy_metahandler,
 											E3IOProxyDisplayGroup ) ;
 
+	if (qd3dStatus == kQ3Success)
+		qd3dStatus = Q3_REGISTER_CLASS_WITH_MEMBER (	kQ3ClassNameGroupDisplayLOD,
+											e3group_display_lod_metahandler,
+											E3LODDisplayGroup,
+											lodDisplayGroupData ) ;
+
 	if (qd3dStatus == kQ3Success)
 		qd3dStatus = Q3_REGISTER_CLASS_NO_DATA (	kQ3ClassNameGroupLight,
 											e3group_light_metahandler,
@@ -2773,6 +3145,9 @@ E3Group_UnregisterClass(void)
 	if (oneStatus == kQ3Failure)
 		qd3dStatus = kQ3Failure;
 	oneStatus = E3ClassTree::UnregisterClass(kQ3GroupTypeLight,				kQ3True);
+	if (oneStatus == kQ3Failure)
+		qd3dStatus = kQ3Failure;
+	oneStatus = E3ClassTree::UnregisterClass(kQ3DisplayGroupTypeLOD,		kQ3True);
 	if (oneStatus == kQ3Failure)
 		qd3dStatus = kQ3Failure;
 	oneStatus = E3ClassTree::UnregisterClass(kQ3DisplayGroupTypeIOProxy,	kQ3True);
@@ -2858,7 +3233,12 @@ TQ3GroupPosition
 E3Group::AddObject ( TQ3Object object )
 	{
 	// Call the method
-	return GetClass ()->addObjectMethod ( this, object ) ;
+	TQ3GroupPosition thePosition = GetClass ()->addObjectMethod ( this, object ) ;
+
+	if ( thePosition != nullptr )
+		Edited () ;
+
+	return thePosition ;
 	}
 
 
@@ -2892,9 +3272,13 @@ E3Group::AddObjectAndDispose ( TQ3Object* theObject )
 TQ3GroupPosition
 E3Group::AddObjectBefore ( TQ3GroupPosition position, TQ3Object object )
 	{
-	
 	// Call the method
-	return GetClass ()->addObjectBeforeMethod ( this, position, object ) ;
+	TQ3GroupPosition thePosition = GetClass ()->addObjectBeforeMethod ( this, position, object ) ;
+
+	if ( thePosition != nullptr )
+		Edited () ;
+
+	return thePosition ;
 	}
 
 
@@ -2908,7 +3292,12 @@ TQ3GroupPosition
 E3Group::AddObjectAfter ( TQ3GroupPosition position, TQ3Object object )
 	{
 	// Call the method
-	return GetClass ()->addObjectAfterMethod ( this, position, object ) ;
+	TQ3GroupPosition thePosition = GetClass ()->addObjectAfterMethod ( this, position, object ) ;
+
+	if ( thePosition != nullptr )
+		Edited () ;
+
+	return thePosition ;
 	}
 
 
@@ -2966,7 +3355,12 @@ TQ3Object
 E3Group::RemovePosition ( TQ3GroupPosition position )
 	{
 	// Call the method
-	return GetClass ()->removePositionMethod ( this, position ) ;
+	TQ3Object theObject = GetClass ()->removePositionMethod ( this, position ) ;
+
+	if ( theObject != nullptr )
+		Edited () ;
+
+	return theObject ;
 	}
 
 
@@ -3050,7 +3444,11 @@ TQ3Status
 E3Group::EmptyObjects ( void )
 	{
 	// Call the method
-	return GetClass ()->emptyObjectsOfTypeMethod ( this, kQ3ObjectTypeShared ) ;
+	TQ3Status qd3dStatus = GetClass ()->emptyObjectsOfTypeMethod ( this, kQ3ObjectTypeShared ) ;
+
+	Edited () ;
+
+	return qd3dStatus ;
 	}
 
 
@@ -3134,7 +3532,11 @@ TQ3Status
 E3Group::EmptyObjectsOfType ( TQ3ObjectType isType )
 	{
 	// Call the method
-	return GetClass ()->emptyObjectsOfTypeMethod ( this, isType ) ;
+	TQ3Status qd3dStatus = GetClass ()->emptyObjectsOfTypeMethod ( this, isType ) ;
+
+	Edited () ;
+
+	return qd3dStatus ;
 	}
 
 
@@ -3197,6 +3599,70 @@ E3Group::GetPreviousObjectPosition ( TQ3Object object, TQ3GroupPosition* positio
 
 
 
+//=============================================================================
+//      E3Group_BuildPickTree : Build the pick tree of a group.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3Group_BuildPickTree(TQ3GroupObject group, TQ3GroupPickTreeInfo *outInfo)
+{
+	E3Group* theGroup = (E3Group*) group;
+
+
+
+	// Create the tree if we don't have one
+	if (theGroup->groupData.pickTree == nullptr)
+	{
+		theGroup->groupData.pickTree = new ( std::nothrow ) E3GroupPickTree( theGroup );
+		if (theGroup->groupData.pickTree == nullptr)
+		{
+			E3ErrorManager_PostError( kQ3ErrorOutOfMemory, kQ3False );
+			return(kQ3Failure);
+		}
+	}
+
+
+
+	// Build it, and throw it away if the group cannot use one
+	if (! theGroup->groupData.pickTree->Build())
+	{
+		E3Group_DisposePickTree( group );
+		return(kQ3Failure);
+	}
+
+
+
+	// Return some information about it
+	if (outInfo != nullptr)
+		theGroup->groupData.pickTree->GetInfo( *outInfo );
+
+	return(kQ3Success);
+}
+
+
+
+
+
+//=============================================================================
+//      E3Group_DisposePickTree : Dispose of the pick tree of a group.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3Group_DisposePickTree(TQ3GroupObject group)
+{
+	E3Group* theGroup = (E3Group*) group;
+
+
+
+	// Dispose of the tree
+	delete theGroup->groupData.pickTree;
+	theGroup->groupData.pickTree = nullptr;
+
+	return(kQ3Success);
+}
+
+
+
+
+
 //=============================================================================
 //      E3DisplayGroup_New : Creates a new display group.
 //-----------------------------------------------------------------------------
@@ -3459,6 +3925,169 @@ E3IOProxyDisplayGroup_New(void)
 
 
 
+//=============================================================================
+//      E3LODDisplayGroup_New : Creates a new level of detail group.
+//-----------------------------------------------------------------------------
+TQ3GroupObject
+E3LODDisplayGroup_New(void)
+{	TQ3GroupObject		theObject;
+
+
+
+	// Create the object
+	theObject = E3ClassTree::CreateInstance ( kQ3DisplayGroupTypeLOD, kQ3False, nullptr);
+	return(theObject);
+}
+
+
+
+
+
+//=============================================================================
+//      E3LODDisplayGroup_SetThresholds : Set the screen area thresholds.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3LODDisplayGroup_SetThresholds(TQ3GroupObject theGroup, TQ3Uns32 numThresholds, const float *thresholds)
+{	E3LODDisplayGroupData&	lodData( ( (E3LODDisplayGroup*) theGroup )->lodDisplayGroupData );
+	float*					newThresholds = nullptr;
+
+
+
+	// Copy the new thresholds
+	if (numThresholds != 0)
+	{
+		TQ3Uns32 theSize = static_cast<TQ3Uns32>(numThresholds * sizeof(float));
+		newThresholds = (float *) Q3Memory_Allocate( theSize );
+		if (newThresholds == nullptr)
+			return kQ3Failure;
+		
+		Q3Memory_Copy( thresholds, newThresholds, theSize );
+	}
+
+
+
+	// Replace the old ones
+	Q3Memory_Free( &lodData.thresholds );
+	lodData.thresholds    = newThresholds;
+	lodData.numThresholds = numThresholds;
+	lodData.currentIndex  = 0;
+
+	Q3Shared_Edited( theGroup );
+
+	return kQ3Success;
+}
+
+
+
+
+
+//=============================================================================
+//      E3LODDisplayGroup_GetThresholds : Get the screen area thresholds.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3LODDisplayGroup_GetThresholds(TQ3GroupObject theGroup, TQ3Uns32 bufferCount,
+								float *outThresholds, TQ3Uns32 *outNumThresholds)
+{	const E3LODDisplayGroupData&	lodData( ( (E3LODDisplayGroup*) theGroup )->lodDisplayGroupData );
+
+
+
+	// Return as many thresholds as will fit, and how many there are
+	*outNumThresholds = lodData.numThresholds;
+	
+	if (outThresholds != nullptr)
+	{
+		TQ3Uns32 numToCopy = E3Num_Min( bufferCount, lodData.numThresholds );
+		
+		for (TQ3Uns32 i = 0; i < numToCopy; ++i)
+			outThresholds[i] = lodData.thresholds[i];
+	}
+
+	return kQ3Success;
+}
+
+
+
+
+
+//=============================================================================
+//      E3LODDisplayGroup_SetHysteresis : Set the hysteresis fraction.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3LODDisplayGroup_SetHysteresis(TQ3GroupObject theGroup, float hysteresis)
+{
+	( (E3LODDisplayGroup*) theGroup )->lodDisplayGroupData.hysteresis = E3Num_Clamp( hysteresis, 0.0f, 1.0f );
+
+	Q3Shared_Edited( theGroup );
+
+	return kQ3Success;
+}
+
+
+
+
+
+//=============================================================================
+//      E3LODDisplayGroup_GetHysteresis : Get the hysteresis fraction.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3LODDisplayGroup_GetHysteresis(TQ3GroupObject theGroup, float *hysteresis)
+{
+	*hysteresis = ( (E3LODDisplayGroup*) theGroup )->lodDisplayGroupData.hysteresis;
+
+	return kQ3Success;
+}
+
+
+
+
+
+//=============================================================================
+//      E3LODDisplayGroup_SetPickFinest : Set whether picking uses the finest LOD.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3LODDisplayGroup_SetPickFinest(TQ3GroupObject theGroup, TQ3Boolean pickFinest)
+{
+	( (E3LODDisplayGroup*) theGroup )->lodDisplayGroupData.pickFinest = pickFinest;
+
+	Q3Shared_Edited( theGroup );
+
+	return kQ3Success;
+}
+
+
+
+
+
+//=============================================================================
+//      E3LODDisplayGroup_GetPickFinest : Get whether picking uses the finest LOD.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3LODDisplayGroup_GetPickFinest(TQ3GroupObject theGroup, TQ3Boolean *pickFinest)
+{
+	*pickFinest = ( (E3LODDisplayGroup*) theGroup )->lodDisplayGroupData.pickFinest;
+
+	return kQ3Success;
+}
+
+
+
+
+
+//=============================================================================
+//      E3LODDisplayGroup_GetCurrentIndex : Get the last drawn representation.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3LODDisplayGroup_GetCurrentIndex(TQ3GroupObject theGroup, TQ3Uns32 *currentIndex)
+{
+	*currentIndex = ( (E3LODDisplayGroup*) theGroup )->lodDisplayGroupData.currentIndex;
+
+	return kQ3Success;
+}
+
+
+
+
+
 //=============================================================================
 //      E3XGroup_GetPositionPrivate : Gets the private data for this position.
 //-----------------------------------------------------------------------------
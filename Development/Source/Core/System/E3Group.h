@@ -175,10 +175,15 @@ public :
 
 
 
+class E3GroupPickTree ;
+
 struct E3GroupData
 {
 	TQ3XGroupPosition						listHead ;
 	TQ3Uns32								groupPositionSize ;
+	TQ3Uns32								subtreeEditStamp ;
+	TQ3Uns32								subtreeValidStamp ;
+	E3GroupPickTree*						pickTree ;
 };
 
 
@@ -208,6 +213,7 @@ public :
 	TQ3Status								getnextposition ( TQ3ObjectType isType, TQ3GroupPosition *position ) ;
 	TQ3Status								getprevposition ( TQ3ObjectType isType, TQ3GroupPosition *position ) ;
 	TQ3Status								countobjects ( TQ3ObjectType isType, TQ3Uns32 *number ) ;	
+	TQ3Uns32								GetSubtreeEditStamp ( void ) ;
 	TQ3Status								emptyobjects ( TQ3ObjectType isType ) ;
 	
 	TQ3Status								getfirstobjectposition ( TQ3Object object, TQ3GroupPosition *position )	;	
@@ -341,6 +347,8 @@ TQ3Status			E3Group_UnregisterClass(void);
 
 TQ3GroupObject		E3Group_New(void);
 TQ3ObjectType		E3Group_GetType(TQ3GroupObject group);
+TQ3Status			E3Group_BuildPickTree(TQ3GroupObject group, TQ3GroupPickTreeInfo *outInfo);
+TQ3Status			E3Group_DisposePickTree(TQ3GroupObject group);
 
 TQ3GroupObject		E3DisplayGroup_New(void);
 TQ3ObjectType		E3DisplayGroup_GetType(TQ3GroupObject theGroup);
@@ -350,6 +358,14 @@ TQ3GroupObject		E3LightGroup_New(void);
 TQ3GroupObject		E3InfoGroup_New(void);
 TQ3GroupObject		E3OrderedDisplayGroup_New(void);
 TQ3GroupObject		E3IOProxyDisplayGroup_New(void);
+TQ3GroupObject		E3LODDisplayGroup_New(void);
+TQ3Status			E3LODDisplayGroup_SetThresholds(TQ3GroupObject theGroup, TQ3Uns32 numThresholds, const float *thresholds);
+TQ3Status			E3LODDisplayGroup_GetThresholds(TQ3GroupObject theGroup, TQ3Uns32 bufferCount, float *outThresholds, TQ3Uns32 *outNumThresholds);
+TQ3Status			E3LODDisplayGroup_SetHysteresis(TQ3GroupObject theGroup, float hysteresis);
+TQ3Status			E3LODDisplayGroup_GetHysteresis(TQ3GroupObject theGroup, float *hysteresis);
+TQ3Status			E3LODDisplayGroup_SetPickFinest(TQ3GroupObject theGroup, TQ3Boolean pickFinest);
+TQ3Status			E3LODDisplayGroup_GetPickFinest(TQ3GroupObject theGroup, TQ3Boolean *pickFinest);
+TQ3Status			E3LODDisplayGroup_GetCurrentIndex(TQ3GroupObject theGroup, TQ3Uns32 *currentIndex);
 
 void				*E3XGroup_GetPositionPrivate(TQ3GroupObject group, TQ3GroupPosition position);
 
@@ -0,0 +1,1332 @@
+/*  NAME:
+        E3GroupPickTree.cpp
+
+    DESCRIPTION:
+        Bounding volume hierarchy for picking the contents of a group.
+
+    COPYRIGHT:
+        Copyright (c) 2025, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "E3Prefix.h"
+#include "E3GroupPickTree.h"
+#include "E3Group.h"
+#include "E3Geometry.h"
+#include "E3Pick.h"
+#include "E3Style.h"
+#include "E3View.h"
+#include "E3Math.h"
+#include "E3ErrorManager.h"
+#include "QuesaMathOperators.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+
+
+
+
+//=============================================================================
+//      Internal constants
+//-----------------------------------------------------------------------------
+// Fraction of its diagonal by which the box of an item is padded, to allow
+// for curved surfaces being subdivided differently when picked
+const float kGroupPickTreeBoundsPadding							= 0.01f;
+
+// The tree is rebuilt rather than refitted if more than 1/N of its items move,
+// and the group is flattened again if more than 1/N of its items are edited
+const TQ3Uns32 kGroupPickTreeRebuildFraction					= 4;
+
+// Subdivision used to measure curved surfaces, as in CalcAndUseBoundingBox
+const TQ3SubdivisionStyleData kGroupPickTreeSubdivision			= {
+	kQ3SubdivisionMethodConstant, 20.0f, 20.0f
+};
+
+
+
+
+
+//=============================================================================
+//      Internal types
+//-----------------------------------------------------------------------------
+// How a member of a group is treated when the group is flattened
+enum TE3GroupPickMember
+{
+	kE3GroupPickMemberIgnored,				// Cannot affect a pick
+	kE3GroupPickMemberState,				// Changes the view state
+	kE3GroupPickMemberTransform,			// Changes only the local to world matrix
+	kE3GroupPickMemberHidden,				// Display group which is not picked
+	kE3GroupPickMemberBounded,				// See TE3GroupPickItemKind
+	kE3GroupPickMemberTolerance,
+	kE3GroupPickMemberUnbounded,
+	kE3GroupPickMemberInlineGroup,			// Group to flatten, sharing our state
+	kE3GroupPickMemberPushingGroup,			// Group to flatten, with its own state
+	kE3GroupPickMemberOpaqueGroup,			// Group to submit as a whole
+	kE3GroupPickMemberUnsupported			// Prevents flattening
+};
+
+
+
+
+
+//=============================================================================
+//      Internal functions
+//-----------------------------------------------------------------------------
+//      e3grouppicktree_classify_geometry : Classify a geometry.
+//-----------------------------------------------------------------------------
+static TE3GroupPickMember
+e3grouppicktree_classify_geometry( TQ3GeometryObject inGeometry )
+{
+	switch (E3Geometry_GetType( inGeometry ))
+	{
+		case kQ3GeometryTypeBox:
+		case kQ3GeometryTypeCone:
+		case kQ3GeometryTypeCylinder:
+		case kQ3GeometryTypeDisk:
+		case kQ3GeometryTypeEllipsoid:
+		case kQ3GeometryTypeGeneralPolygon:
+		case kQ3GeometryTypeMesh:
+		case kQ3GeometryTypeNURBPatch:
+		case kQ3GeometryTypePolygon:
+		case kQ3GeometryTypePolyhedron:
+		case kQ3GeometryTypeTorus:
+		case kQ3GeometryTypeTriangle:
+		case kQ3GeometryTypeTriGrid:
+		case kQ3GeometryTypeTriMesh:
+			return kE3GroupPickMemberBounded;
+		
+		case kQ3GeometryTypeEllipse:
+		case kQ3GeometryTypeInstanceArray:
+		case kQ3GeometryTypeLine:
+		case kQ3GeometryTypeNURBCurve:
+		case kQ3GeometryTypePoint:
+		case kQ3GeometryTypePolyLine:
+			return kE3GroupPickMemberTolerance;
+		
+		default:
+			// Markers are picked in window coordinates, and we don't know
+			// how plug-in geometries are picked
+			return kE3GroupPickMemberUnbounded;
+	}
+}
+
+
+
+
+
+//=============================================================================
+//      e3grouppicktree_classify_transform : Classify a transform.
+//-----------------------------------------------------------------------------
+//		Note :	Items are picked with the product of the transforms before
+//				them, so we only accept transforms which multiply the local
+//				to world matrix.
+//-----------------------------------------------------------------------------
+static TE3GroupPickMember
+e3grouppicktree_classify_transform( TQ3TransformObject inTransform )
+{
+	switch (inTransform->GetLeafType())
+	{
+		case kQ3TransformTypeMatrix:
+		case kQ3TransformTypeScale:
+		case kQ3TransformTypeTranslate:
+		case kQ3TransformTypeRotate:
+		case kQ3TransformTypeRotateAboutPoint:
+		case kQ3TransformTypeRotateAboutAxis:
+		case kQ3TransformTypeQuaternion:
+			return kE3GroupPickMemberTransform;
+		
+		default:
+			// Reset and camera transforms replace the matrix
+			return kE3GroupPickMemberUnsupported;
+	}
+}
+
+
+
+
+
+//=============================================================================
+//      e3grouppicktree_classify_group : Classify a group.
+//-----------------------------------------------------------------------------
+static TE3GroupPickMember
+e3grouppicktree_classify_group( TQ3GroupObject inGroup )
+{
+	TQ3ObjectType theType = inGroup->GetLeafType();
+	
+	
+	
+	// Plain groups are always traversed, without pushing the view state
+	if (theType == kQ3ShapeTypeGroup)
+		return kE3GroupPickMemberInlineGroup;
+	
+	
+	
+	// Light groups and info groups only accept lights and strings
+	if ( (theType == kQ3GroupTypeLight) || (theType == kQ3GroupTypeInfo) )
+		return kE3GroupPickMemberIgnored;
+	
+	if (! Q3_OBJECT_IS_CLASS( inGroup, E3DisplayGroup ))
+		return kE3GroupPickMemberUnsupported;
+	
+	
+	
+	// Display groups are skipped unless they are picked, and push the view
+	// state unless they are inline
+	TQ3DisplayGroupState theState = ( (E3DisplayGroup*) inGroup )->displayGroupData.state;
+	if (! E3Bit_AnySet( theState, kQ3DisplayGroupStateMaskIsPicked ))
+		return kE3GroupPickMemberHidden;
+	
+	bool isInline = E3Bit_AnySet( theState, kQ3DisplayGroupStateMaskIsInline );
+	if ( (theType == kQ3GroupTypeDisplay) || (theType == kQ3DisplayGroupTypeOrdered) )
+		return isInline ? kE3GroupPickMemberInlineGroup : kE3GroupPickMemberPushingGroup;
+
+
+
+	// LOD and I/O proxy groups choose what to submit for themselves
+	return isInline ? kE3GroupPickMemberUnsupported : kE3GroupPickMemberOpaqueGroup;
+}
+
+
+
+
+
+//=============================================================================
+//      e3grouppicktree_classify : Classify a member of a group.
+//-----------------------------------------------------------------------------
+static TE3GroupPickMember
+e3grouppicktree_classify( TQ3Object inObject )
+{
+	TQ3ObjectType theType = E3Shared_GetType( inObject );
+	
+	if (theType == kQ3SharedTypeSet)
+		return kE3GroupPickMemberState;
+	
+	if (theType != kQ3SharedTypeShape)
+		return kE3GroupPickMemberIgnored;
+	
+	switch (E3Shape_GetType( inObject ))
+	{
+		case kQ3ShapeTypeGeometry:
+			return e3grouppicktree_classify_geometry( inObject );
+		
+		case kQ3ShapeTypeGroup:
+			return e3grouppicktree_classify_group( inObject );
+		
+		case kQ3ShapeTypeShader:
+		case kQ3ShapeTypeStyle:
+			return kE3GroupPickMemberState;
+		
+		case kQ3ShapeTypeTransform:
+			return e3grouppicktree_classify_transform( inObject );
+		
+		case kQ3ShapeTypeCamera:
+		case kQ3ShapeTypeLight:
+		case kQ3ShapeTypeUnknown:
+			return kE3GroupPickMemberIgnored;
+		
+		default:
+			// State operators and references
+			return kE3GroupPickMemberUnsupported;
+	}
+}
+
+
+
+
+
+//=============================================================================
+//      e3grouppicktree_measure : Measure an object within a bounds loop.
+//-----------------------------------------------------------------------------
+//		Note :	The bounds are measured in the coordinates in which the view
+//				was started, and padded.
+//-----------------------------------------------------------------------------
+static void
+e3grouppicktree_measure( TQ3ViewObject inView, TQ3Object inObject, TQ3BoundingBox& outBounds )
+{
+	// Measure the object alone
+	Q3Memory_Clear( &outBounds, sizeof(outBounds) );
+	outBounds.isEmpty = kQ3True;
+	
+	E3View_SwapBoundingBox( inView, &outBounds );
+	E3View_SubmitRetained( inView, inObject );
+	E3View_SwapBoundingBox( inView, &outBounds );
+
+
+
+	// Pad the bounds
+	if (! outBounds.isEmpty)
+	{
+		float thePadding = kGroupPickTreeBoundsPadding *
+			Q3FastPoint3D_Distance( &outBounds.min, &outBounds.max );
+		
+		outBounds.min.x -= thePadding;
+		outBounds.min.y -= thePadding;
+		outBounds.min.z -= thePadding;
+		outBounds.max.x += thePadding;
+		outBounds.max.y += thePadding;
+		outBounds.max.z += thePadding;
+	}
+}
+
+
+
+
+
+//=============================================================================
+//      Public methods
+//-----------------------------------------------------------------------------
+//      E3GroupPickTree::E3GroupPickTree : Constructor.
+//-----------------------------------------------------------------------------
+#pragma mark -
+E3GroupPickTree::E3GroupPickTree( E3Group* inGroup )
+	: mGroup( inGroup )
+	, mIsUsable( false )
+	, mRootPushes( false )
+	, mSubtreeStamp( 0 )
+	, mBuildTime( 0.0f )
+{
+}
+
+
+
+
+
+//=============================================================================
+//      E3GroupPickTree::Build : Flatten the group and build the tree.
+//-----------------------------------------------------------------------------
+//		Note :	The stamp is recorded even if the group cannot be flattened,
+//				so that we do not try again until the group is edited.
+//-----------------------------------------------------------------------------
+bool
+E3GroupPickTree::Build()
+{
+	auto startTime = std::chrono::steady_clock::now();
+	
+	ClearRecords();
+	mIsUsable     = false;
+	mSubtreeStamp = mGroup->GetSubtreeEditStamp();
+
+
+
+	// The root must be a group we can look into
+	TQ3ObjectType theType = mGroup->GetLeafType();
+	if ( (theType != kQ3ShapeTypeGroup) && (theType != kQ3GroupTypeDisplay) &&
+		(theType != kQ3DisplayGroupTypeOrdered) )
+		return false;
+	
+	mRootPushes = Q3_OBJECT_IS_CLASS( mGroup, E3DisplayGroup ) &&
+		! E3Bit_AnySet( ( (E3DisplayGroup*) mGroup )->displayGroupData.state,
+			kQ3DisplayGroupStateMaskIsInline );
+
+
+
+	try
+	{
+		// Flatten the group, measuring items in the coordinates of the root
+		if (mBoundsView.get() == nullptr)
+		{
+			mBoundsView = CQ3ObjectRef( E3View_New() );
+			if (mBoundsView.get() == nullptr)
+				return false;
+		}
+		
+		TQ3ViewObject	theView = mBoundsView.get();
+		TQ3BoundingBox	theBounds;
+		TQ3ViewStatus	viewStatus;
+		bool			isFlat;
+		
+		if (E3View_StartBoundingBox( theView, kQ3ComputeBoundsApproximate ) == kQ3Failure)
+			return false;
+		
+		do
+		{
+			ClearRecords();
+			E3SubdivisionStyle_Submit( &kGroupPickTreeSubdivision, theView );
+			isFlat = FlattenScope( mGroup, nullptr, kQ3ArrayIndexNULL, 0 );
+			viewStatus = E3View_EndBoundingBox( theView, &theBounds );
+		}
+		while (viewStatus == kQ3ViewStatusRetraverse);
+		
+		if ( (! isFlat) || (viewStatus != kQ3ViewStatusDone) )
+		{
+			ClearRecords();
+			return false;
+		}
+
+
+
+		// Sort the items, and build the tree over those with bounds
+		for (TQ3Uns32 n = 0; n < mItems.size(); ++n)
+		{
+			if (mItems[n].kind == kE3GroupPickItemUnbounded)
+				mAlwaysItems.push_back( n );
+			else if (mItems[n].kind == kE3GroupPickItemTolerance)
+				mToleranceItems.push_back( n );
+		}
+		
+		BuildTree();
+		mCandidates.reserve( mItems.size() );
+	}
+	catch (...)
+	{
+		E3ErrorManager_PostError( kQ3ErrorOutOfMemory, kQ3False );
+		ClearRecords();
+		mBoundsView = CQ3ObjectRef();
+		return false;
+	}
+	
+	mBuildTime = std::chrono::duration<float>(
+		std::chrono::steady_clock::now() - startTime ).count();
+	mIsUsable  = true;
+	
+	return true;
+}
+
+
+
+
+
+//=============================================================================
+//      E3GroupPickTree::GetInfo : Get information about the tree.
+//-----------------------------------------------------------------------------
+void
+E3GroupPickTree::GetInfo( TQ3GroupPickTreeInfo& outInfo ) const
+{
+	outInfo.numObjects          = static_cast<TQ3Uns32>( mItems.size() );
+	outInfo.numUnboundedObjects = static_cast<TQ3Uns32>( mAlwaysItems.size() );
+	outInfo.numNodes            = mTree.GetNodeCount();
+	outInfo.memorySize          = static_cast<TQ3Uns32>( sizeof(E3GroupPickTree) - sizeof(E3BoundingTree) +
+		mTree.GetMemorySize() +
+		mScopes.capacity() * sizeof(TE3GroupPickScope) +
+		mStates.capacity() * sizeof(TE3GroupPickState) +
+		mItems.capacity() * sizeof(TE3GroupPickItem) +
+		mTreeBounds.capacity() * sizeof(TQ3BoundingBox) +
+		(mAlwaysItems.capacity() + mToleranceItems.capacity() + mTreeItems.capacity() +
+			mCandidates.capacity()) * sizeof(TQ3Uns32) );
+	outInfo.buildTime           = mBuildTime;
+}
+
+
+
+
+
+//=============================================================================
+//      E3GroupPickTree::SubmitPick : Submit the group to a pick.
+//-----------------------------------------------------------------------------
+//		Note :	Hit distances are measured from the camera for window-point
+//				picks, not from the origin of the pick ray, so the pick turns
+//				its nearest hit into a limit along our ray for us.
+//
+//				Window-rect picks and batch picks are handled separately.
+//-----------------------------------------------------------------------------
+bool
+E3GroupPickTree::SubmitPick( TQ3ViewObject inView, TQ3Status& outStatus )
+{
+	TQ3PickObject	thePick  = E3View_AccessPick( inView );
+	TQ3ObjectType	pickType = E3Pick_GetType( thePick );
+	TQ3Ray3D		worldRay;
+	float			vertexTolerance, edgeTolerance, faceTolerance;
+
+
+
+	// Only ray picks without a face tolerance can use the tree
+	if (pickType == kQ3PickTypeWorldRayBatch)
+		return SubmitBatchPick( inView, outStatus );
+	
+	if (pickType == kQ3PickTypeWindowRect)
+		return SubmitRectPick( inView, outStatus );
+	
+	if ( (pickType != kQ3PickTypeWindowPoint) && (pickType != kQ3PickTypeWorldRay) )
+		return false;
+	
+	E3Pick_GetFaceTolerance( thePick, &faceTolerance );
+	if (faceTolerance > 0.0f)
+		return false;
+
+
+
+	// Find the pick ray in world coordinates, with a unit direction so that
+	// distances along it are the distances recorded for hits
+	if (pickType == kQ3PickTypeWorldRay)
+	{
+		E3WorldRayPick_GetRay( thePick, &worldRay );
+		
+		float theLength = Q3FastVector3D_Length( &worldRay.direction );
+		if (theLength <= kQ3RealZero)
+			return false;
+		
+		worldRay.direction = (1.0f / theLength) * worldRay.direction;
+	}
+	else
+	{
+		if (E3View_AccessCamera( inView ) == nullptr)
+			return false;
+		
+		E3View_GetRayThroughPickPoint( inView, &worldRay );
+	}
+
+
+
+	// Take the ray into the coordinates of the group.  An affine transform
+	// keeps distances along the ray in world units, as long as we do not
+	// normalize the direction again.
+	const TQ3Matrix4x4& localToWorld( *E3View_State_GetMatrixLocalToWorld( inView ) );
+	if ( (localToWorld.value[0][3] != 0.0f) || (localToWorld.value[1][3] != 0.0f) ||
+		(localToWorld.value[2][3] != 0.0f) || (localToWorld.value[3][3] != 1.0f) ||
+		(fabsf( E3Matrix4x4_Determinant( &localToWorld ) ) < kQ3MinFloat) )
+		return false;
+	
+	TQ3Matrix4x4 worldToLocal;
+	E3Matrix4x4_Invert( &localToWorld, &worldToLocal );
+	
+	TQ3Ray3D localRay;
+	localRay.origin    = worldRay.origin * worldToLocal;
+	localRay.direction = worldRay.direction * worldToLocal;
+
+
+
+	// Bring the tree up to date
+	if (! Update())
+		return false;
+	
+	E3Pick_GetVertexTolerance( thePick, &vertexTolerance );
+	E3Pick_GetEdgeTolerance( thePick, &edgeTolerance );
+	bool useTolerance = (vertexTolerance > 0.0f) || (edgeTolerance > 0.0f);
+	
+	const TQ3Vector3D invDirection( E3BoundingTree::GetInverseDirection( localRay.direction ) );
+	float maxDistance = kQ3MaxFloat;
+
+
+
+	// If only the nearest hit is wanted, submit the objects that the tree
+	// cannot place first, then the rest near to far, skipping those which
+	// cannot be nearer than the best hit so far
+	if (E3Pick_IsNearestHitOnly( thePick ))
+	{
+		float nearestLimit;
+		
+		for (TQ3Uns32 theItem : mAlwaysItems)
+			PickItem( inView, theItem );
+		
+		if (useTolerance)
+		{
+			for (TQ3Uns32 theItem : mToleranceItems)
+				PickItem( inView, theItem );
+		}
+		
+		if (E3Pick_GetNearestHitLimit( thePick, inView, &worldRay, &nearestLimit ))
+			maxDistance = nearestLimit;
+		
+		auto pickNearest = [&]( TQ3Uns32 inTreeIndex, float& ioMaxDistance )
+		{
+			const TQ3BoundingBox& theBounds( mTreeBounds[ inTreeIndex ] );
+			const TQ3Uns32 theItem = mTreeItems[ inTreeIndex ];
+			float theEntry;
+			
+			if ( (useTolerance && (mItems[ theItem ].kind == kE3GroupPickItemTolerance)) ||
+				! E3BoundingTree::RayEntersBox( theBounds.min, theBounds.max,
+					localRay.origin, invDirection, ioMaxDistance, theEntry ) )
+				return;
+			
+			PickItem( inView, theItem );
+			
+			if (E3Pick_GetNearestHitLimit( thePick, inView, &worldRay, &nearestLimit ))
+				ioMaxDistance = std::min( ioMaxDistance, nearestLimit );
+		};
+		
+		mTree.VisitRay( localRay, maxDistance, pickNearest );
+	}
+
+
+
+	// Otherwise gather the objects the ray may hit, and submit them in the
+	// order of a full traversal so that unsorted hits come out the same
+	else
+	{
+		mCandidates.assign( mAlwaysItems.begin(), mAlwaysItems.end() );
+		
+		if (useTolerance)
+			mCandidates.insert( mCandidates.end(), mToleranceItems.begin(), mToleranceItems.end() );
+		
+		auto gatherItem = [&]( TQ3Uns32 inTreeIndex, float& ioMaxDistance )
+		{
+			const TQ3BoundingBox& theBounds( mTreeBounds[ inTreeIndex ] );
+			const TQ3Uns32 theItem = mTreeItems[ inTreeIndex ];
+			float theEntry;
+			
+			if ( (! useTolerance || (mItems[ theItem ].kind != kE3GroupPickItemTolerance)) &&
+				E3BoundingTree::RayEntersBox( theBounds.min, theBounds.max,
+					localRay.origin, invDirection, ioMaxDistance, theEntry ) )
+				mCandidates.push_back( theItem );
+		};
+		
+		mTree.VisitRay( localRay, maxDistance, gatherItem );
+		std::sort( mCandidates.begin(), mCandidates.end() );
+		
+		for (TQ3Uns32 theItem : mCandidates)
+			PickItem( inView, theItem );
+	}
+
+
+
+	// A group which does not push the view state leaves its states in effect
+	if (! mRootPushes)
+	{
+		const TE3GroupPickScope& rootScope( mScopes[0] );
+		ReplayScope( inView, 0, rootScope.numStates, false );
+	}
+	
+	outStatus = kQ3Success;
+	return true;
+}
+
+
+
+
+
+//=============================================================================
+//      Private methods
+//-----------------------------------------------------------------------------
+//      E3GroupPickTree::SubmitBatchPick : Submit the group to a batch pick.
+//-----------------------------------------------------------------------------
+//		Note :	The objects which any ray of the batch may hit before its
+//				nearest hit so far are submitted in the order of a full
+//				traversal.  The rays of a batch have unit directions, so an
+//				affine transform keeps distances along them in world units.
+//-----------------------------------------------------------------------------
+#pragma mark -
+bool
+E3GroupPickTree::SubmitBatchPick( TQ3ViewObject inView, TQ3Status& outStatus )
+{
+	TQ3PickObject	thePick = E3View_AccessPick( inView );
+	TQ3Uns32		numRays;
+
+
+
+	// Find the transform into the coordinates of the group
+	const TQ3Matrix4x4& localToWorld( *E3View_State_GetMatrixLocalToWorld( inView ) );
+	if ( (localToWorld.value[0][3] != 0.0f) || (localToWorld.value[1][3] != 0.0f) ||
+		(localToWorld.value[2][3] != 0.0f) || (localToWorld.value[3][3] != 1.0f) ||
+		(fabsf( E3Matrix4x4_Determinant( &localToWorld ) ) < kQ3MinFloat) )
+		return false;
+	
+	TQ3Matrix4x4 worldToLocal;
+	E3Matrix4x4_Invert( &localToWorld, &worldToLocal );
+
+
+
+	// Bring the tree up to date
+	if (! Update())
+		return false;
+
+
+
+	// Gather the objects each ray may hit.  Points and lines are not picked
+	// by a batch, so objects that need a tolerance are only tested by bounds.
+	E3WorldRayBatchPick_GetNumRays( thePick, &numRays );
+	const TQ3Ray3D* worldRays        = E3WorldRayBatchPick_AccessRays( thePick );
+	const float*    nearestDistances = E3WorldRayBatchPick_AccessNearestDistances( thePick );
+	
+	mCandidates.assign( mAlwaysItems.begin(), mAlwaysItems.end() );
+	
+	for (TQ3Uns32 n = 0; n < numRays; ++n)
+	{
+		if (nearestDistances[n] < 0.0f)
+			continue;
+		
+		TQ3Ray3D localRay;
+		localRay.origin    = worldRays[n].origin * worldToLocal;
+		localRay.direction = worldRays[n].direction * worldToLocal;
+		
+		const TQ3Vector3D invDirection( E3BoundingTree::GetInverseDirection( localRay.direction ) );
+		float maxDistance = nearestDistances[n];
+		
+		auto gatherItem = [&]( TQ3Uns32 inTreeIndex, float& ioMaxDistance )
+		{
+			const TQ3BoundingBox& theBounds( mTreeBounds[ inTreeIndex ] );
+			float theEntry;
+			
+			if (E3BoundingTree::RayEntersBox( theBounds.min, theBounds.max,
+					localRay.origin, invDirection, ioMaxDistance, theEntry ))
+				mCandidates.push_back( mTreeItems[ inTreeIndex ] );
+		};
+		
+		mTree.VisitRay( localRay, maxDistance, gatherItem );
+	}
+	
+	std::sort( mCandidates.begin(), mCandidates.end() );
+	mCandidates.erase( std::unique( mCandidates.begin(), mCandidates.end() ), mCandidates.end() );
+
+
+
+	// Submit them
+	for (TQ3Uns32 theItem : mCandidates)
+		PickItem( inView, theItem );
+
+
+
+	// A group which does not push the view state leaves its states in effect
+	if (! mRootPushes)
+	{
+		const TE3GroupPickScope& rootScope( mScopes[0] );
+		ReplayScope( inView, 0, rootScope.numStates, false );
+	}
+	
+	outStatus = kQ3Success;
+	return true;
+}
+
+
+
+
+
+//=============================================================================
+//      E3GroupPickTree::SubmitRectPick : Submit the group to a rect pick.
+//-----------------------------------------------------------------------------
+//		Note :	Each node of the tree is projected into the window.  Whole
+//				subtrees whose window area misses the rect are skipped, and
+//				those whose window area lies inside it are gathered without
+//				testing their objects one by one.  The objects are then
+//				submitted in the order of a full traversal.
+//
+//				A rect pick does not use tolerances, and the objects which
+//				need one are still drawn within their bounds.
+//-----------------------------------------------------------------------------
+bool
+E3GroupPickTree::SubmitRectPick( TQ3ViewObject inView, TQ3Status& outStatus )
+{
+	TQ3PickObject	thePick = E3View_AccessPick( inView );
+	TQ3Area			theRect;
+
+
+
+	// We need a camera to project the tree, and an affine transform so that
+	// boxes in the coordinates of the group stay boxes
+	if (E3View_AccessCamera( inView ) == nullptr)
+		return false;
+	
+	const TQ3Matrix4x4& localToWorld( *E3View_State_GetMatrixLocalToWorld( inView ) );
+	if ( (localToWorld.value[0][3] != 0.0f) || (localToWorld.value[1][3] != 0.0f) ||
+		(localToWorld.value[2][3] != 0.0f) || (localToWorld.value[3][3] != 1.0f) ||
+		(fabsf( E3Matrix4x4_Determinant( &localToWorld ) ) < kQ3MinFloat) )
+		return false;
+
+
+
+	// Bring the tree up to date
+	if (! Update())
+		return false;
+
+
+
+	// Gather the objects whose window area meets the rect
+	E3WindowRectPick_GetRect( thePick, &theRect );
+	
+	mCandidates.assign( mAlwaysItems.begin(), mAlwaysItems.end() );
+	
+	auto classifyNode = [&]( const TQ3Point3D& inMin, const TQ3Point3D& inMax ) -> E3FrustumClass
+	{
+		TQ3BoundingBox	nodeBounds = { inMin, inMax, kQ3False };
+		
+		return E3BoundingBox_ClassifyWindowRect( inView, nodeBounds, theRect );
+	};
+	
+	auto gatherItem = [&]( TQ3Uns32 inTreeIndex, bool isInside ) -> bool
+	{
+		if ( isInside ||
+			(E3BoundingBox_ClassifyWindowRect( inView, mTreeBounds[ inTreeIndex ], theRect ) !=
+				kE3FrustumClass_Outside) )
+			mCandidates.push_back( mTreeItems[ inTreeIndex ] );
+		
+		return false;
+	};
+	
+	mTree.VisitBoxes( classifyNode, gatherItem );
+	std::sort( mCandidates.begin(), mCandidates.end() );
+
+
+
+	// Submit them
+	for (TQ3Uns32 theItem : mCandidates)
+		PickItem( inView, theItem );
+
+
+
+	// A group which does not push the view state leaves its states in effect
+	if (! mRootPushes)
+	{
+		const TE3GroupPickScope& rootScope( mScopes[0] );
+		ReplayScope( inView, 0, rootScope.numStates, false );
+	}
+	
+	outStatus = kQ3Success;
+	return true;
+}
+
+
+
+
+
+//=============================================================================
+//      E3GroupPickTree::Update : Bring the tree up to date with edits.
+//-----------------------------------------------------------------------------
+bool
+E3GroupPickTree::Update()
+{
+	// Nothing to do if nothing in the group has been edited
+	TQ3Uns32 theStamp = mGroup->GetSubtreeEditStamp();
+	if (theStamp == mSubtreeStamp)
+		return mIsUsable;
+	
+	
+	
+	// Measure the edited objects again, or start over if groups changed
+	bool isCurrent = false;
+	if (mIsUsable)
+	{
+		try
+		{
+			isCurrent = Refresh();
+		}
+		catch (...)
+		{
+			isCurrent = false;
+		}
+	}
+	
+	if (isCurrent)
+		mSubtreeStamp = theStamp;
+	else
+		Build();
+	
+	return mIsUsable;
+}
+
+
+
+
+
+//=============================================================================
+//      E3GroupPickTree::Refresh : Measure edited items again.
+//-----------------------------------------------------------------------------
+//		Note :	Returns false if the tree must be built again, because a group
+//				in it has gained or lost members or changed its state.
+//
+//				The scopes are checked in traversal order, and the scopes
+//				nested inside one whose subtree is unchanged are skipped.
+//				A group is only looked into once its parent is known to be
+//				unchanged, so every object we look at is still alive.
+//-----------------------------------------------------------------------------
+bool
+E3GroupPickTree::Refresh()
+{
+	std::vector<TQ3Uns32>	dirtyItems;
+	TQ3Uns32				s = 0;
+
+
+
+	// Find the items which may have moved
+	while (s < mScopes.size())
+	{
+		TE3GroupPickScope& theScope( mScopes[ s ] );
+		E3Group* theGroup = (E3Group*) theScope.group;
+		
+		TQ3Uns32 subtreeStamp = theGroup->GetSubtreeEditStamp();
+		if (subtreeStamp == theScope.subtreeStamp)
+		{
+			s = theScope.endScope;
+			continue;
+		}
+		
+		if (theGroup->GetEditStamp() != theScope.editStamp)
+			return false;
+		
+		theScope.subtreeStamp = subtreeStamp;
+		
+		
+		// An edited state may move every item after it in the group
+		bool statesChanged = false;
+		for (TQ3Uns32 n = 0; n < theScope.numStates; ++n)
+		{
+			TE3GroupPickState& theState( mStates[ theScope.firstState + n ] );
+			if (theState.isHidden)
+			{
+				if ( ( (E3Shared*) theState.object )->GetEditStamp() != theState.stamp )
+					return false;
+			}
+			else
+			{
+				TQ3Uns32 theStamp = E3Shared_GetSubtreeEditStamp( theState.object );
+				if (theStamp != theState.stamp)
+				{
+					theState.stamp = theStamp;
+					statesChanged  = true;
+				}
+			}
+		}
+		
+		for (TQ3Uns32 n = theScope.firstItem; n < theScope.endItem; ++n)
+		{
+			TE3GroupPickItem& theItem( mItems[ n ] );
+			bool isDirty = statesChanged;
+			
+			if (theItem.scope == s)
+			{
+				TQ3Uns32 theStamp = E3Shared_GetSubtreeEditStamp( theItem.object );
+				if (theStamp != theItem.stamp)
+				{
+					theItem.stamp = theStamp;
+					isDirty       = true;
+				}
+			}
+			
+			if (isDirty)
+				dirtyItems.push_back( n );
+		}
+		
+		++s;
+	}
+	
+	if (dirtyItems.empty())
+		return true;
+	
+	std::sort( dirtyItems.begin(), dirtyItems.end() );
+	dirtyItems.erase( std::unique( dirtyItems.begin(), dirtyItems.end() ), dirtyItems.end() );
+	
+	if (dirtyItems.size() * kGroupPickTreeRebuildFraction > mItems.size())
+		return false;
+
+
+
+	// Measure them again.  An item which is now empty cannot be hit, so it
+	// may keep its old box, as do unbounded items.
+	std::vector<TQ3BoundingBox> newBounds;
+	if (! MeasureItems( dirtyItems, newBounds ))
+		return false;
+	
+	TQ3Uns32	numMoved   = 0;
+	bool		needsBuild = false;
+	
+	for (TQ3Uns32 n = 0; n < dirtyItems.size(); ++n)
+	{
+		TE3GroupPickItem& theItem( mItems[ dirtyItems[n] ] );
+		if (newBounds[n].isEmpty)
+			continue;
+		
+		theItem.bounds = newBounds[n];
+		if (theItem.treeIndex == kQ3ArrayIndexNULL)
+			needsBuild = true;
+		else
+		{
+			mTreeBounds[ theItem.treeIndex ] = newBounds[n];
+			++numMoved;
+		}
+	}
+
+
+
+	// Refit the tree if only a few items moved
+	if (needsBuild || (numMoved * kGroupPickTreeRebuildFraction > mTreeItems.size()))
+		BuildTree();
+	else if (numMoved != 0)
+		mTree.Refit( mTreeBounds.data() );
+	
+	return true;
+}
+
+
+
+
+
+//=============================================================================
+//      E3GroupPickTree::BuildTree : Build the tree over the items.
+//-----------------------------------------------------------------------------
+void
+E3GroupPickTree::BuildTree()
+{
+	mTreeItems.clear();
+	mTreeBounds.clear();
+	
+	for (TQ3Uns32 n = 0; n < mItems.size(); ++n)
+	{
+		TE3GroupPickItem& theItem( mItems[ n ] );
+		theItem.treeIndex = kQ3ArrayIndexNULL;
+		
+		if ( (theItem.kind != kE3GroupPickItemUnbounded) && ! theItem.bounds.isEmpty )
+		{
+			theItem.treeIndex = static_cast<TQ3Uns32>( mTreeItems.size() );
+			mTreeItems.push_back( n );
+			mTreeBounds.push_back( theItem.bounds );
+		}
+	}
+	
+	if (mTreeItems.empty())
+		mTree.Clear();
+	else
+		mTree.Build( static_cast<TQ3Uns32>( mTreeItems.size() ), mTreeBounds.data() );
+}
+
+
+
+
+
+//=============================================================================
+//      E3GroupPickTree::ClearRecords : Forget the contents of the group.
+//-----------------------------------------------------------------------------
+void
+E3GroupPickTree::ClearRecords()
+{
+	mScopes.clear();
+	mStates.clear();
+	mItems.clear();
+	mAlwaysItems.clear();
+	mToleranceItems.clear();
+	mTreeItems.clear();
+	mTreeBounds.clear();
+	mCandidates.clear();
+	mTree.Clear();
+}
+
+
+
+
+
+//=============================================================================
+//      E3GroupPickTree::FlattenScope : Record the contents of a group.
+//-----------------------------------------------------------------------------
+//		Note :	Called within a bounds loop of our bounds view, with the state
+//				that the contents of the group see.  Items are measured as
+//				they are found, and states are submitted.
+//
+//				A nested group which does not push the view state, but
+//				changes it, affects the objects after it in our group.  We
+//				cannot replay that, so we fail, and the nearest group that
+//				pushes the view state is submitted as a whole instead.
+//-----------------------------------------------------------------------------
+bool
+E3GroupPickTree::FlattenScope( TQ3GroupObject inGroup,
+								TQ3GroupPosition inPosition,
+								TQ3Uns32 inParent,
+								TQ3Uns32 inNumParentStates )
+{
+	E3Group*						theGroup = (E3Group*) inGroup;
+	TQ3ViewObject					theView  = mBoundsView.get();
+	std::vector<TE3GroupPickState>	theStates;
+	TQ3GroupPosition				thePosition = nullptr;
+
+
+
+	// Record the scope on the way in, so that nested scopes follow it
+	const TQ3Uns32 scopeIndex = static_cast<TQ3Uns32>( mScopes.size() );
+	TE3GroupPickScope theScope;
+	
+	theScope.group           = inGroup;
+	theScope.position        = inPosition;
+	theScope.parent          = inParent;
+	theScope.numParentStates = inNumParentStates;
+	theScope.firstState      = 0;
+	theScope.numStates       = 0;
+	theScope.firstItem       = static_cast<TQ3Uns32>( mItems.size() );
+	theScope.endItem         = theScope.firstItem;
+	theScope.endScope        = scopeIndex + 1;
+	theScope.editStamp       = theGroup->GetEditStamp();
+	theScope.subtreeStamp    = theGroup->GetSubtreeEditStamp();
+	mScopes.push_back( theScope );
+
+
+
+	// Record the members of the group
+	for (theGroup->GetFirstPosition( &thePosition ); thePosition != nullptr;
+		theGroup->GetNextPosition( &thePosition ))
+	{
+		TQ3Object theObject = ( (TQ3XGroupPosition*) thePosition )->object;
+		TQ3Uns32 numStates  = static_cast<TQ3Uns32>( theStates.size() );
+		
+		TE3GroupPickMember theMember = e3grouppicktree_classify( theObject );
+		switch (theMember)
+		{
+			case kE3GroupPickMemberIgnored:
+				break;
+			
+			case kE3GroupPickMemberState:
+			case kE3GroupPickMemberTransform:
+				theStates.push_back( { theObject, E3Shared_GetSubtreeEditStamp( theObject ), false,
+					theMember == kE3GroupPickMemberTransform } );
+				E3View_SubmitRetained( theView, theObject );
+				break;
+			
+			case kE3GroupPickMemberHidden:
+				theStates.push_back( { theObject, ( (E3Shared*) theObject )->GetEditStamp(), true, false } );
+				break;
+			
+			case kE3GroupPickMemberBounded:
+				AddItem( theObject, thePosition, scopeIndex, numStates, kE3GroupPickItemBounded );
+				break;
+			
+			case kE3GroupPickMemberTolerance:
+				AddItem( theObject, thePosition, scopeIndex, numStates, kE3GroupPickItemTolerance );
+				break;
+			
+			case kE3GroupPickMemberUnbounded:
+			case kE3GroupPickMemberOpaqueGroup:
+				AddItem( theObject, thePosition, scopeIndex, numStates, kE3GroupPickItemUnbounded );
+				break;
+			
+			case kE3GroupPickMemberInlineGroup:
+			case kE3GroupPickMemberPushingGroup:
+			{
+				const TQ3Uns32	childScope = static_cast<TQ3Uns32>( mScopes.size() );
+				const size_t	numItems   = mItems.size();
+				const size_t	numRecordedStates = mStates.size();
+				
+				E3Push_Submit( theView );
+				bool isFlat = FlattenScope( theObject, thePosition, scopeIndex, numStates );
+				E3Pop_Submit( theView );
+				
+				if (isFlat && (theMember == kE3GroupPickMemberInlineGroup))
+				{
+					const TE3GroupPickScope& nestedScope( mScopes[ childScope ] );
+					for (TQ3Uns32 n = 0; n < nestedScope.numStates; ++n)
+					{
+						if (! mStates[ nestedScope.firstState + n ].isHidden)
+							isFlat = false;
+					}
+				}
+				
+				if (! isFlat)
+				{
+					if (theMember == kE3GroupPickMemberInlineGroup)
+						return false;
+					
+					mScopes.resize( childScope );
+					mItems.resize( numItems );
+					mStates.resize( numRecordedStates );
+					AddItem( theObject, thePosition, scopeIndex, numStates, kE3GroupPickItemUnbounded );
+				}
+				break;
+			}
+			
+			case kE3GroupPickMemberUnsupported:
+			default:
+				return false;
+		}
+	}
+
+
+
+	// Finish the scope, with its states together after those of nested scopes
+	TE3GroupPickScope& finalScope( mScopes[ scopeIndex ] );
+	finalScope.firstState = static_cast<TQ3Uns32>( mStates.size() );
+	finalScope.numStates  = static_cast<TQ3Uns32>( theStates.size() );
+	finalScope.endItem    = static_cast<TQ3Uns32>( mItems.size() );
+	finalScope.endScope   = static_cast<TQ3Uns32>( mScopes.size() );
+	mStates.insert( mStates.end(), theStates.begin(), theStates.end() );
+	
+	return true;
+}
+
+
+
+
+
+//=============================================================================
+//      E3GroupPickTree::AddItem : Record an item, measuring it if bounded.
+//-----------------------------------------------------------------------------
+void
+E3GroupPickTree::AddItem( TQ3Object inObject,
+							TQ3GroupPosition inPosition,
+							TQ3Uns32 inScope,
+							TQ3Uns32 inNumStates,
+							TQ3Uns32 inKind )
+{
+	TE3GroupPickItem theItem;
+	
+	theItem.object    = inObject;
+	theItem.position  = inPosition;
+	theItem.scope     = inScope;
+	theItem.numStates = inNumStates;
+	theItem.stamp     = E3Shared_GetSubtreeEditStamp( inObject );
+	theItem.kind      = inKind;
+	theItem.treeIndex = kQ3ArrayIndexNULL;
+	theItem.localToRoot = *E3View_State_GetMatrixLocalToWorld( mBoundsView.get() );
+	
+	if (inKind == kE3GroupPickItemUnbounded)
+	{
+		Q3Memory_Clear( &theItem.bounds, sizeof(theItem.bounds) );
+		theItem.bounds.isEmpty = kQ3True;
+	}
+	else
+		e3grouppicktree_measure( mBoundsView.get(), inObject, theItem.bounds );
+	
+	mItems.push_back( theItem );
+}
+
+
+
+
+
+//=============================================================================
+//      E3GroupPickTree::MeasureItems : Measure some items again.
+//-----------------------------------------------------------------------------
+//		Note :	Each item is measured on its own, by replaying the states
+//				that lead to it, and its localToRoot matrix is updated.
+//				Unbounded items are given empty bounds.
+//-----------------------------------------------------------------------------
+bool
+E3GroupPickTree::MeasureItems( const std::vector<TQ3Uns32>& inItems,
+								std::vector<TQ3BoundingBox>& outBounds )
+{
+	TQ3ViewObject	theView = mBoundsView.get();
+	TQ3BoundingBox	theBounds;
+	TQ3ViewStatus	viewStatus;
+
+
+
+	outBounds.resize( inItems.size() );
+	
+	if (E3View_StartBoundingBox( theView, kQ3ComputeBoundsApproximate ) == kQ3Failure)
+		return false;
+	
+	do
+	{
+		E3SubdivisionStyle_Submit( &kGroupPickTreeSubdivision, theView );
+		
+		for (TQ3Uns32 n = 0; n < inItems.size(); ++n)
+		{
+			TE3GroupPickItem& theItem( mItems[ inItems[n] ] );
+			
+			E3Push_Submit( theView );
+			ReplayScope( theView, theItem.scope, theItem.numStates, false );
+			theItem.localToRoot = *E3View_State_GetMatrixLocalToWorld( theView );
+			
+			if (theItem.kind == kE3GroupPickItemUnbounded)
+			{
+				Q3Memory_Clear( &outBounds[n], sizeof(outBounds[n]) );
+				outBounds[n].isEmpty = kQ3True;
+			}
+			else
+				e3grouppicktree_measure( theView, theItem.object, outBounds[n] );
+			
+			E3Pop_Submit( theView );
+		}
+		
+		viewStatus = E3View_EndBoundingBox( theView, &theBounds );
+	}
+	while (viewStatus == kQ3ViewStatusRetraverse);
+	
+	return (viewStatus == kQ3ViewStatusDone);
+}
+
+
+
+
+
+//=============================================================================
+//      E3GroupPickTree::ReplayScope : Submit the states leading to an item.
+//-----------------------------------------------------------------------------
+//		Note :	Submits the first inNumStates states of a scope, after those of
+//				its parents.  When picking, the groups are also pushed onto
+//				the pick path, and the number pushed is returned.  Transforms
+//				are then left out, as PickItem applies their product.
+//-----------------------------------------------------------------------------
+TQ3Uns32
+E3GroupPickTree::ReplayScope( TQ3ViewObject inView,
+								TQ3Uns32 inScope,
+								TQ3Uns32 inNumStates,
+								bool inIsPicking ) const
+{
+	const TE3GroupPickScope& theScope( mScopes[ inScope ] );
+	TQ3Uns32 theDepth = 0;
+
+
+
+	// Replay our parents, and enter our group
+	if (theScope.parent != kQ3ArrayIndexNULL)
+	{
+		theDepth = ReplayScope( inView, theScope.parent, theScope.numParentStates, inIsPicking );
+		
+		if (inIsPicking)
+		{
+			E3View_PickStack_SavePosition( inView, theScope.position );
+			E3View_PickStack_PushGroup( inView, theScope.group );
+			theDepth++;
+		}
+	}
+
+
+
+	// Submit our states
+	for (TQ3Uns32 n = 0; n < inNumStates; ++n)
+	{
+		const TE3GroupPickState& theState( mStates[ theScope.firstState + n ] );
+		if ( (! theState.isHidden) && ! (inIsPicking && theState.isTransform) )
+			E3View_SubmitRetained( inView, theState.object );
+	}
+	
+	return theDepth;
+}
+
+
+
+
+
+//=============================================================================
+//      E3GroupPickTree::PickItem : Submit one item to a pick.
+//-----------------------------------------------------------------------------
+//		Note :	The root group is already on the pick path.
+//-----------------------------------------------------------------------------
+void
+E3GroupPickTree::PickItem( TQ3ViewObject inView, TQ3Uns32 inItem ) const
+{
+	const TE3GroupPickItem& theItem( mItems[ inItem ] );
+
+
+
+	// Submit the item with the states and pick path that lead to it
+	E3Push_Submit( inView );
+	E3View_State_AddMatrixLocalToWorld( inView, &theItem.localToRoot );
+	TQ3Uns32 theDepth = ReplayScope( inView, theItem.scope, theItem.numStates, true );
+	
+	E3View_PickStack_SavePosition( inView, theItem.position );
+	E3View_SubmitRetained( inView, theItem.object );
+	
+	while (theDepth-- != 0)
+		E3View_PickStack_PopGroup( inView );
+	
+	E3Pop_Submit( inView );
+}
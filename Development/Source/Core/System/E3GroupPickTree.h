@@ -0,0 +1,269 @@
+/*  NAME:
+        E3GroupPickTree.h
+
+    DESCRIPTION:
+        Header file for E3GroupPickTree.cpp.
+
+    COPYRIGHT:
+        Copyright (c) 2025, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+#ifndef E3GROUPPICKTREE_HDR
+#define E3GROUPPICKTREE_HDR
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "E3Prefix.h"
+#include "E3BoundingTree.h"
+#include "CQ3ObjectRef.h"
+
+#include <vector>
+
+
+
+
+
+//=============================================================================
+//      Types
+//-----------------------------------------------------------------------------
+class E3Group;
+
+/*!
+	@struct		TE3GroupPickScope
+	@abstract	A group whose contents are part of a flattened pick tree.
+	@discussion	Scopes are numbered in traversal order, so the scopes nested
+				inside a scope are those between it and its endScope.  The
+				same holds for items and endItem.
+	@field		group			The group.
+	@field		position		Position of the group in its parent, or
+								nullptr for the root.
+	@field		parent			Index of the parent scope.
+	@field		numParentStates	Number of states of the parent which are
+								submitted before this group.
+	@field		firstState		Index of the first state of this group.
+	@field		numStates		Number of states of this group.
+	@field		firstItem		Index of the first item in this group.
+	@field		endItem			Index after the last item in this group,
+								including those in nested groups.
+	@field		endScope		Index after the last nested scope.
+	@field		editStamp		Edit stamp of the group itself.
+	@field		subtreeStamp	Subtree edit stamp of the group.
+*/
+struct TE3GroupPickScope
+{
+	TQ3GroupObject			group;
+	TQ3GroupPosition		position;
+	TQ3Uns32				parent;
+	TQ3Uns32				numParentStates;
+	TQ3Uns32				firstState;
+	TQ3Uns32				numStates;
+	TQ3Uns32				firstItem;
+	TQ3Uns32				endItem;
+	TQ3Uns32				endScope;
+	TQ3Uns32				editStamp;
+	TQ3Uns32				subtreeStamp;
+};
+
+/*!
+	@struct		TE3GroupPickState
+	@abstract	A transform, style, shader or attribute set in a scope.
+	@discussion	Display groups which are not picked are also recorded here,
+				so that the tree is rebuilt if they become pickable.
+	@field		object			The object.
+	@field		stamp			Subtree edit stamp of the object, or its own
+								edit stamp if it is hidden.
+	@field		isHidden		Whether this is a group which is not picked.
+	@field		isTransform		Whether this is a transform, whose effect is
+								kept in the localToRoot matrix of the items
+								after it.
+*/
+struct TE3GroupPickState
+{
+	TQ3Object				object;
+	TQ3Uns32				stamp;
+	bool					isHidden;
+	bool					isTransform;
+};
+
+/*!
+	@enum		TE3GroupPickItemKind
+	@abstract	How an item is found by a pick.
+	@constant	kE3GroupPickItemBounded		Surfaces, which can only be hit
+											inside their bounding box.
+	@constant	kE3GroupPickItemTolerance	Geometry which a pick with a vertex
+											or edge tolerance can hit outside
+											its bounding box.
+	@constant	kE3GroupPickItemUnbounded	Objects which are submitted to
+											every pick, such as markers and
+											groups we cannot look into.
+*/
+enum TE3GroupPickItemKind
+{
+	kE3GroupPickItemBounded,
+	kE3GroupPickItemTolerance,
+	kE3GroupPickItemUnbounded
+};
+
+/*!
+	@struct		TE3GroupPickItem
+	@abstract	An object which is submitted to picks through the tree.
+	@field		object			The object.
+	@field		position		Position of the object in its group.
+	@field		scope			Index of the scope holding the object.
+	@field		numStates		Number of states of the scope which are
+								submitted before the object.
+	@field		stamp			Subtree edit stamp of the object.
+	@field		kind			A TE3GroupPickItemKind.
+	@field		treeIndex		Index of the object in the bounding tree, or
+								kQ3ArrayIndexNULL if it is not in the tree.
+	@field		bounds			Bounds of the object in the local coordinates
+								of the root group.
+	@field		localToRoot		Product of the transforms leading to the
+								object, from its coordinates to those of
+								the root group.
+*/
+struct TE3GroupPickItem
+{
+	TQ3Object				object;
+	TQ3GroupPosition		position;
+	TQ3Uns32				scope;
+	TQ3Uns32				numStates;
+	TQ3Uns32				stamp;
+	TQ3Uns32				kind;
+	TQ3Uns32				treeIndex;
+	TQ3BoundingBox			bounds;
+	TQ3Matrix4x4			localToRoot;
+};
+
+
+
+
+
+//=============================================================================
+//      Class declaration
+//-----------------------------------------------------------------------------
+/*!
+	@class		E3GroupPickTree
+	
+	@abstract	Bounding volume hierarchy over the contents of a group, used
+				to submit to a ray pick only the objects the ray may hit.
+	
+	@discussion	The group is flattened into a list of items, each with the
+				chain of groups and states leading to it, so that an item can
+				be submitted on its own and record the same hit path and hit
+				data as a full traversal of the group.  Edit stamps are kept
+				for every group, state and item, so after an edit only the
+				items it affects are measured again.
+				
+				The tree belongs to its group and does not hold a reference
+				to it, nor to any of the objects it records.
+*/
+class E3GroupPickTree
+{
+public:
+							E3GroupPickTree( E3Group* inGroup );
+
+	/*!
+		@function	Build
+		@abstract	Flatten the group and build the tree, replacing any
+					previous contents.
+		@result		False if the group cannot be flattened.
+	*/
+	bool					Build();
+	
+	/*!
+		@function	GetInfo
+		@abstract	Get information about the tree for Q3Group_BuildPickTree.
+	*/
+	void					GetInfo( TQ3GroupPickTreeInfo& outInfo ) const;
+
+	/*!
+		@function	SubmitPick
+		@abstract	Submit the contents of the group to a pick.
+		@discussion	This is called by the group's pick method after it has
+					pushed the group onto the pick path.  Picks which the
+					tree cannot answer exactly are left to the normal
+					traversal.
+		@param		inView			A view in a picking loop.
+		@param		outStatus		Receives the status of the submit.
+		@result		False if the caller should traverse the group itself.
+	*/
+	bool					SubmitPick( TQ3ViewObject inView, TQ3Status& outStatus );
+
+private:
+	bool					SubmitBatchPick( TQ3ViewObject inView, TQ3Status& outStatus );
+	bool					SubmitRectPick( TQ3ViewObject inView, TQ3Status& outStatus );
+	bool					Update();
+	bool					Refresh();
+	void					BuildTree();
+	void					ClearRecords();
+	bool					FlattenScope( TQ3GroupObject inGroup,
+											TQ3GroupPosition inPosition,
+											TQ3Uns32 inParent,
+											TQ3Uns32 inNumParentStates );
+	void					AddItem( TQ3Object inObject,
+										TQ3GroupPosition inPosition,
+										TQ3Uns32 inScope,
+										TQ3Uns32 inNumStates,
+										TQ3Uns32 inKind );
+	bool					MeasureItems( const std::vector<TQ3Uns32>& inItems,
+											std::vector<TQ3BoundingBox>& outBounds );
+	TQ3Uns32				ReplayScope( TQ3ViewObject inView,
+											TQ3Uns32 inScope,
+											TQ3Uns32 inNumStates,
+											bool inIsPicking ) const;
+	void					PickItem( TQ3ViewObject inView, TQ3Uns32 inItem ) const;
+
+	E3Group*							mGroup;
+	CQ3ObjectRef						mBoundsView;
+	bool								mIsUsable;
+	bool								mRootPushes;
+	TQ3Uns32							mSubtreeStamp;
+	float								mBuildTime;
+	
+	std::vector<TE3GroupPickScope>		mScopes;
+	std::vector<TE3GroupPickState>		mStates;
+	std::vector<TE3GroupPickItem>		mItems;
+	std::vector<TQ3Uns32>				mAlwaysItems;
+	std::vector<TQ3Uns32>				mToleranceItems;
+	
+	E3BoundingTree						mTree;
+	std::vector<TQ3Uns32>				mTreeItems;
+	std::vector<TQ3BoundingBox>			mTreeBounds;
+	
+	std::vector<TQ3Uns32>				mCandidates;
+};
+
+#endif
@@ -137,6 +137,9 @@ typedef std::map< TQ3Object, WeakRefSet > ObToWeakRefs;
 
 static ObToWeakRefs* sObToWeakRefs = nullptr;
 
+// Stamp of the most recent edit to any shared object
+static TQ3Uns32 sLatestEditStamp = 0;
+
 
 //=============================================================================
 //      Internal functions
@@ -245,6 +248,7 @@ e3shared_new ( TQ3Object inObject, void *privateData, const void *paramData )
 	// Initialise our instance data
 	theObject->sharedData.refCount  = 1 ;
 	theObject->sharedData.editIndex = 1 ;
+	theObject->sharedData.editStamp = ++sLatestEditStamp ;
 
 #if Q3_DEBUG
 	theObject->sharedData.logRefs = kQ3False;
@@ -347,6 +351,7 @@ e3shared_duplicate(TQ3Object fromObject,     const void *fromPrivateData,
 	// Initialise the instance data of the new object
 	instanceData->sharedData.refCount  = 1;
 	instanceData->sharedData.editIndex = E3Integer_Abs( fromInstanceData->sharedData.editIndex );
+	instanceData->sharedData.editStamp = ++sLatestEditStamp;
 
 #if Q3_DEBUG
 	instanceData->sharedData.logRefs = kQ3False;
@@ -2080,8 +2085,9 @@ E3Shared::Edited ( void )
 {
 	if (sharedData.editIndex >= 0)
 	{
-		// Increment the edit index
+		// Increment the edit index, and note the edit for subtree stamps
 		++sharedData.editIndex ;
+		sharedData.editStamp = ++sLatestEditStamp ;
 	}
 
 	return kQ3Success ;
@@ -2124,6 +2130,56 @@ E3Shared::IsEditIndexLocked() const
 
 
 
+
+//=============================================================================
+//      E3Shared_GetLatestEditStamp : Get the stamp of the most recent edit.
+//-----------------------------------------------------------------------------
+TQ3Uns32
+E3Shared_GetLatestEditStamp( void )
+{
+	return sLatestEditStamp;
+}
+
+
+
+
+
+//=============================================================================
+//      E3Shared_GetSubtreeEditStamp : Get the latest edit stamp of a subtree.
+//-----------------------------------------------------------------------------
+//		Note :	Edit stamps come from a single global counter, so the latest
+//				stamp in a subtree grows whenever anything within it is edited,
+//				including adding or removing objects from a group. Groups
+//				memoize their result until the next edit anywhere.
+//-----------------------------------------------------------------------------
+TQ3Uns32
+E3Shared_GetSubtreeEditStamp( TQ3SharedObject sharedObject )
+{
+	// Groups look at their members
+	if ( Q3_OBJECT_IS_CLASS( sharedObject, E3Group ) )
+		return ( (E3Group*) sharedObject )->GetSubtreeEditStamp();
+
+
+
+	// Geometries include their attribute set, which is edited separately
+	TQ3Uns32 theStamp = ( (E3Shared*) sharedObject )->GetEditStamp();
+
+	if ( Q3_OBJECT_IS_CLASS( sharedObject, E3Geometry ) )
+	{
+		TQ3XGeomGetAttributeMethod getAttribute = ( (E3Geometry*) sharedObject )->GetClass()->getAttribute;
+		TQ3AttributeSet* attributeSet = (getAttribute != nullptr) ? getAttribute( sharedObject ) : nullptr;
+
+		if ( attributeSet != nullptr && *attributeSet != nullptr )
+			theStamp = E3Num_Max( theStamp, ( (E3Shared*) *attributeSet )->GetEditStamp() );
+	}
+
+	return theStamp;
+}
+
+
+
+
+
 //=============================================================================
 //      E3Shape_IsOfMyClass : Check if object pointer is valid and of type shape
 //-----------------------------------------------------------------------------
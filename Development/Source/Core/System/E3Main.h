@@ -308,6 +308,7 @@ struct E3SharedData
 {
 	TQ3Uns32		refCount;
 	TQ3Int32		editIndex;	// normally positive, negative means "locked"
+	TQ3Uns32		editStamp;	// global edit stamp of the latest edit
 #if Q3_DEBUG
 	TQ3Boolean		logRefs;
 #endif
@@ -337,6 +338,7 @@ public :
 	TQ3Boolean			IsReferenced ( void ) ;
 	TQ3Uns32			GetReferenceCount ( void ) ;	
 	TQ3Uns32			GetEditIndex ( void ) ;
+	TQ3Uns32			GetEditStamp ( void ) const { return sharedData.editStamp ; }
 	void				SetEditIndex( TQ3Uns32 inIndex );
 	TQ3Status			Edited ( void ) ;
 	void				SetEditIndexLocked( TQ3Boolean inIsLocked );
@@ -413,6 +415,8 @@ inline TQ3Status	E3Shared_Edited ( TQ3SharedObject sharedObject )
 	{ return ( (E3Shared*) sharedObject )->Edited () ; }
 void				E3Shared_Dispose( TQ3Object sharedObject );
 void				E3Shared_AddReference( E3Shared* theObject );
+TQ3Uns32			E3Shared_GetLatestEditStamp( void );
+TQ3Uns32			E3Shared_GetSubtreeEditStamp( TQ3SharedObject sharedObject );
 
 TQ3Boolean			E3Shape_IsOfMyClass ( TQ3Object object ) ;
 TQ3ObjectType		E3Shape_GetType(TQ3ShapeObject theShape);
@@ -48,9 +48,11 @@
 //-----------------------------------------------------------------------------
 #include "E3Prefix.h"
 #include "E3Math.h"
+#include "E3MathSIMD.h"
 #include "E3Utils.h"
 #include <limits>
 #include <cstring>
+#include <cmath>
 
 
 
@@ -154,6 +156,61 @@ static void e3matrix4x4_extract3x3( const TQ3Matrix4x4& in4x4, TQ3Matrix3x3& out
 	}
 }
 
+//=============================================================================
+//		e3matrix4x4_invert_affine : Invert a 4x4 matrix with last column
+//									(0, 0, 0, 1).
+//-----------------------------------------------------------------------------
+//		Note :	The inverse of the upper left 3x3 is formed from cross
+//				products of its rows, which is much cheaper than elimination.
+//				Returns false, leaving outInverse untouched, if the matrix is
+//				singular or too nearly so to divide by its determinant.
+//
+//				'outInverse' may be the same as 'inMatrix'.
+//-----------------------------------------------------------------------------
+static bool e3matrix4x4_invert_affine( const TQ3Matrix4x4& inMatrix, TQ3Matrix4x4& outInverse )
+{
+	#define A(x,y) inMatrix.value[x][y]
+	
+	// Columns of the adjoint are cross products of pairs of rows
+	const float c00 = A(1,1)*A(2,2) - A(1,2)*A(2,1);
+	const float c01 = A(1,2)*A(2,0) - A(1,0)*A(2,2);
+	const float c02 = A(1,0)*A(2,1) - A(1,1)*A(2,0);
+	
+	const float c10 = A(2,1)*A(0,2) - A(2,2)*A(0,1);
+	const float c11 = A(2,2)*A(0,0) - A(2,0)*A(0,2);
+	const float c12 = A(2,0)*A(0,1) - A(2,1)*A(0,0);
+	
+	const float c20 = A(0,1)*A(1,2) - A(0,2)*A(1,1);
+	const float c21 = A(0,2)*A(1,0) - A(0,0)*A(1,2);
+	const float c22 = A(0,0)*A(1,1) - A(0,1)*A(1,0);
+	
+	const float det = A(0,0)*c00 + A(0,1)*c01 + A(0,2)*c02;
+	const float invDet = 1.0f / det;
+	
+	if ( (det == 0.0f) || (! std::isfinite( invDet )) )
+	{
+		return false;
+	}
+	
+	const float tx = A(3,0), ty = A(3,1), tz = A(3,2);
+	
+	#undef A
+	#define B(x,y) outInverse.value[x][y]
+	
+	B(0,0) = c00 * invDet;	B(0,1) = c10 * invDet;	B(0,2) = c20 * invDet;	B(0,3) = 0.0f;
+	B(1,0) = c01 * invDet;	B(1,1) = c11 * invDet;	B(1,2) = c21 * invDet;	B(1,3) = 0.0f;
+	B(2,0) = c02 * invDet;	B(2,1) = c12 * invDet;	B(2,2) = c22 * invDet;	B(2,3) = 0.0f;
+	
+	B(3,0) = -(tx*B(0,0) + ty*B(1,0) + tz*B(2,0));
+	B(3,1) = -(tx*B(0,1) + ty*B(1,1) + tz*B(2,1));
+	B(3,2) = -(tx*B(0,2) + ty*B(1,2) + tz*B(2,2));
+	B(3,3) = 1.0f;
+	
+	#undef B
+	
+	return true;
+}
+
 //=============================================================================
 //		e3matrix3x3_determinant : Returns the determinant of the given 3x3 matrix.
 //-----------------------------------------------------------------------------
@@ -1105,6 +1162,16 @@ E3Vector3D_DotArray(
 	float dotProduct;
 	TQ3Uns32 i;
 
+	// Use the vector kernel if we have one
+	const E3MathKernels& theKernels( E3MathKernels_Get() );
+	if (theKernels.vector3DDot != nullptr)
+	{
+		theKernels.vector3DDot( inFirstVectors3D, inSecondVectors3D, outDotProducts,
+			outDotLessThanZeros, numVectors, inStructSize, outDotProductStructSize,
+			outDotLessThanZeroStructSize );
+		return(kQ3Success);
+	}
+
 	// Calculate the dot products
 	if (outDotProducts != nullptr && outDotLessThanZeros != nullptr)
 	{
@@ -1229,6 +1296,16 @@ E3Triangle_CrossProductArray(TQ3Uns32			numTriangles,
 
 
 
+	// Use the vector kernel if we have one
+	const E3MathKernels& theKernels( E3MathKernels_Get() );
+	if (theKernels.triangleNormals != nullptr)
+		{
+		theKernels.triangleNormals( numTriangles, usageFlags, theIndices, thePoints, theNormals );
+		return(kQ3Success);
+		}
+
+
+
 	// Calculate the normals
 	if (usageFlags == nullptr)
 		{
@@ -2353,6 +2430,15 @@ E3Vector3D_To3DTransformArray(const TQ3Vector3D		*inVectors3D,
 {
 	TQ3Uns32 i;
 	
+	// Use the vector kernel if we have one
+	const E3MathKernels& theKernels( E3MathKernels_Get() );
+	if (theKernels.vector3DTo3D != nullptr)
+	{
+		theKernels.vector3DTo3D( inVectors3D, matrix4x4, outVectors3D, numVectors,
+			inStructSize, outStructSize );
+		return(kQ3Success);
+	}
+	
 	for (i = 0; i < numVectors; ++i)
 	{
 		E3Vector3D_Transform(inVectors3D, matrix4x4, outVectors3D);
@@ -2476,6 +2562,7 @@ E3Point3D_To3DTransformArray(const TQ3Point3D		*inPoints3D,
 							 TQ3Uns32				outStructSize)
 {
 	TQ3Uns32 i;
+	const E3MathKernels& theKernels( E3MathKernels_Get() );
 	
 	// In the common case of the last column of the matrix being (0, 0, 0, 1),
 	// we can avoid some divisions and conditionals inside the loop.
@@ -2484,7 +2571,10 @@ E3Point3D_To3DTransformArray(const TQ3Point3D		*inPoints3D,
 		(matrix4x4->value[1][3] == 0.0f) &&
 		(matrix4x4->value[2][3] == 0.0f) )
 	{
-		for (i = 0; i < numPoints; ++i)
+		if (theKernels.point3DTo3DAffine != nullptr)
+			theKernels.point3DTo3DAffine( inPoints3D, matrix4x4, outPoints3D, numPoints,
+				inStructSize, outStructSize );
+		else for (i = 0; i < numPoints; ++i)
 		{
 			E3Point3D_TransformAffine( inPoints3D, matrix4x4, outPoints3D );
 
@@ -2492,6 +2582,11 @@ E3Point3D_To3DTransformArray(const TQ3Point3D		*inPoints3D,
 			AdvancePointer( outPoints3D, outStructSize );
 		}
 	}
+	else if (theKernels.point3DTo3D != nullptr)
+	{
+		theKernels.point3DTo3D( inPoints3D, matrix4x4, outPoints3D, numPoints,
+			inStructSize, outStructSize );
+	}
 	else
 	{
 		// Transform the points - will be in-lined in release builds
@@ -2525,6 +2620,15 @@ E3Point3D_To4DTransformArray(const TQ3Point3D		*inPoints3D,
 {
 	TQ3Uns32 i;
 	
+	// Use the vector kernel if we have one
+	const E3MathKernels& theKernels( E3MathKernels_Get() );
+	if (theKernels.point3DTo4D != nullptr)
+	{
+		theKernels.point3DTo4D( inPoints3D, matrix4x4, outRationalPoints4D, numPoints,
+			inStructSize, outStructSize );
+		return(kQ3Success);
+	}
+	
 	for (i = 0; i < numPoints; ++i)
 	{
 		#define M(x,y) matrix4x4->value[x][y]
@@ -2561,6 +2665,15 @@ E3RationalPoint4D_To4DTransformArray(const TQ3RationalPoint4D	*inRationalPoints4
 {
 	TQ3Uns32 i;
 	
+	// Use the vector kernel if we have one
+	const E3MathKernels& theKernels( E3MathKernels_Get() );
+	if (theKernels.rationalPoint4DTo4D != nullptr)
+	{
+		theKernels.rationalPoint4DTo4D( inRationalPoints4D, matrix4x4, outRationalPoints4D,
+			numPoints, inStructSize, outStructSize );
+		return(kQ3Success);
+	}
+	
 	for (i = 0; i < numPoints; ++i)
 	{
 		E3RationalPoint4D_Transform(inRationalPoints4D, matrix4x4, outRationalPoints4D);
@@ -3267,6 +3380,62 @@ E3Matrix4x4_SetQuaternion(TQ3Matrix4x4 *matrix4x4, const TQ3Quaternion *quaterni
 
 
 
+//=============================================================================
+//      E3Matrix4x4_SetQuaternionArray : Set 4x4 matrices from rotations,
+//				scales and translations.
+//-----------------------------------------------------------------------------
+//		Note :	Each matrix scales, then rotates, then translates. Scaling
+//				the first three rows of the rotation gives the same result
+//				as multiplying by a scale matrix, without the multiply.
+//
+//				'scales' and 'translations' may be nullptr.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3Matrix4x4_SetQuaternionArray(TQ3Matrix4x4			*outMatrices,
+							   const TQ3Quaternion	*quaternions,
+							   const TQ3Vector3D	*scales,
+							   const TQ3Vector3D	*translations,
+							   TQ3Uns32				numMatrices)
+{
+	TQ3Uns32 i = 0, c;
+	
+	// Use the vector kernel for whole groups of four
+	const E3MathKernels& theKernels( E3MathKernels_Get() );
+	if (theKernels.quaternionToMatrix != nullptr)
+	{
+		i = numMatrices & ~3U;
+		theKernels.quaternionToMatrix( quaternions, scales, translations, outMatrices, i );
+	}
+	
+	for (; i < numMatrices; ++i)
+	{
+		E3Matrix4x4_SetQuaternion( &outMatrices[i], &quaternions[i] );
+		
+		if (scales != nullptr)
+		{
+			for (c = 0; c < 3; ++c)
+			{
+				outMatrices[i].value[0][c] *= scales[i].x;
+				outMatrices[i].value[1][c] *= scales[i].y;
+				outMatrices[i].value[2][c] *= scales[i].z;
+			}
+		}
+		
+		if (translations != nullptr)
+		{
+			outMatrices[i].value[3][0] = translations[i].x;
+			outMatrices[i].value[3][1] = translations[i].y;
+			outMatrices[i].value[3][2] = translations[i].z;
+		}
+	}
+
+	return(kQ3Success);
+}
+
+
+
+
+
 //=============================================================================
 //      E3Matrix3x3_Copy : Copy 3x3 matrix.
 //-----------------------------------------------------------------------------
@@ -3500,31 +3669,36 @@ E3Matrix4x4_Invert(const TQ3Matrix4x4 *matrix4x4, TQ3Matrix4x4 *result)
 	// (where A is 3x3 and v is 1x3) is
 	//		inv(A)			0
 	//		-v * inv(A)		1	.
+	// We first try inv(A) in closed form, and only use elimination with
+	// pivoting when A is singular or nearly so.
 	if ( (result->value[3][3] == 1.0f) && (result->value[0][3] == 0.0f) &&
 		(result->value[1][3] == 0.0f) && (result->value[2][3] == 0.0f) )
 	{
-		TQ3Matrix3x3	upperLeft;
-		e3matrix4x4_extract3x3( *result, upperLeft );
-		int	i, j;
+		if (! e3matrix4x4_invert_affine( *result, *result ))
+		{
+			TQ3Matrix3x3	upperLeft;
+			e3matrix4x4_extract3x3( *result, upperLeft );
+			int	i, j;
 		
-		e3matrix3x3_invert( &upperLeft );
+			e3matrix3x3_invert( &upperLeft );
 		
-		for (i = 0; i < 3; ++i)
-		{
-			for (j = 0; j < 3; ++j)
+			for (i = 0; i < 3; ++i)
 			{
-				result->value[i][j] = upperLeft.value[i][j];
+				for (j = 0; j < 3; ++j)
+				{
+					result->value[i][j] = upperLeft.value[i][j];
+				}
 			}
-		}
 		
-		TQ3RationalPoint3D	v = {
-			result->value[3][0], result->value[3][1], result->value[3][2]
-		};
-		E3RationalPoint3D_Transform( &v, &upperLeft, &v );
+			TQ3RationalPoint3D	v = {
+				result->value[3][0], result->value[3][1], result->value[3][2]
+			};
+			E3RationalPoint3D_Transform( &v, &upperLeft, &v );
 		
-		result->value[3][0] = -v.x;
-		result->value[3][1] = -v.y;
-		result->value[3][2] = -v.w;
+			result->value[3][0] = -v.x;
+			result->value[3][1] = -v.y;
+			result->value[3][2] = -v.w;
+		}
 	}
 	else
 	{
@@ -3588,6 +3762,14 @@ E3Matrix3x3_Multiply(const TQ3Matrix3x3 *m1, const TQ3Matrix3x3 *m2, TQ3Matrix3x
 TQ3Matrix4x4 *
 E3Matrix4x4_Multiply(const TQ3Matrix4x4 *m1, const TQ3Matrix4x4 *m2, TQ3Matrix4x4 *result)
 {
+	// Use the vector kernel if we have one
+	const E3MathKernels& theKernels( E3MathKernels_Get() );
+	if (theKernels.matrix4x4Multiply != nullptr)
+	{
+		theKernels.matrix4x4Multiply( m1, m2, result, 1, 0, 0, 0 );
+		return(result);
+	}
+	
 	// If result is alias of input, output to temporary
 	TQ3Matrix4x4 temp;
 	TQ3Matrix4x4* output = (result == m1 || result == m2 ? &temp : result);
@@ -3630,6 +3812,107 @@ E3Matrix4x4_Multiply(const TQ3Matrix4x4 *m1, const TQ3Matrix4x4 *m2, TQ3Matrix4x
 
 
 
+//=============================================================================
+//      E3Matrix4x4_MultiplyArray : Multiply pairs of 4x4 matrices.
+//-----------------------------------------------------------------------------
+//		Note :	A stride of 0 uses the same matrix for every pair, which
+//				covers multiplying many matrices by one parent matrix.
+//
+//				Each output may be the same as either of its inputs.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3Matrix4x4_MultiplyArray(const TQ3Matrix4x4	*inMatrices1,
+						  const TQ3Matrix4x4	*inMatrices2,
+						  TQ3Matrix4x4			*outMatrices,
+						  TQ3Uns32				numMatrices,
+						  TQ3Uns32				inStructSize1,
+						  TQ3Uns32				inStructSize2,
+						  TQ3Uns32				outStructSize)
+{
+	TQ3Uns32 i;
+	
+	// Use the vector kernel if we have one
+	const E3MathKernels& theKernels( E3MathKernels_Get() );
+	if (theKernels.matrix4x4Multiply != nullptr)
+	{
+		theKernels.matrix4x4Multiply( inMatrices1, inMatrices2, outMatrices, numMatrices,
+			inStructSize1, inStructSize2, outStructSize );
+		return(kQ3Success);
+	}
+	
+	for (i = 0; i < numMatrices; ++i)
+	{
+		E3Matrix4x4_Multiply( inMatrices1, inMatrices2, outMatrices );
+		
+		AdvanceConstPointer( inMatrices1, inStructSize1 );
+		AdvanceConstPointer( inMatrices2, inStructSize2 );
+		AdvancePointer( outMatrices, outStructSize );
+	}
+
+	return(kQ3Success);
+}
+
+
+
+
+
+//=============================================================================
+//      E3Matrix4x4_ComposeHierarchy : Concatenate the matrices of a hierarchy.
+//-----------------------------------------------------------------------------
+//		Note :	Parents come before their children, so each parent's result
+//				is final by the time its children need it. That also lets
+//				the output array be the same as the input array.
+//
+//				Siblings are usually stored next to each other, so each run
+//				of nodes with the same parent is multiplied in one call.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3Matrix4x4_ComposeHierarchy(const TQ3Matrix4x4	*localMatrices,
+							 const TQ3Uns32		*parentIndices,
+							 TQ3Uns32			numMatrices,
+							 TQ3Matrix4x4		*outMatrices)
+{
+	TQ3Uns32 i, runEnd, theParent;
+	
+	// Check the order before changing anything
+	for (i = 0; i < numMatrices; ++i)
+	{
+		if ( (parentIndices[i] != kQ3ArrayIndexNULL) && (parentIndices[i] >= i) )
+		{
+			E3ErrorManager_PostError( kQ3ErrorInvalidParameter, kQ3False );
+			return(kQ3Failure);
+		}
+	}
+	
+	for (i = 0; i < numMatrices; i = runEnd)
+	{
+		theParent = parentIndices[i];
+		
+		for (runEnd = i + 1; runEnd < numMatrices; ++runEnd)
+		{
+			if (parentIndices[runEnd] != theParent)
+				break;
+		}
+		
+		if (theParent == kQ3ArrayIndexNULL)
+		{
+			if (outMatrices != localMatrices)
+				Q3Memory_Copy( &localMatrices[i], &outMatrices[i], (runEnd - i) * sizeof(TQ3Matrix4x4) );
+		}
+		else
+		{
+			E3Matrix4x4_MultiplyArray( &localMatrices[i], &outMatrices[theParent], &outMatrices[i],
+				runEnd - i, sizeof(TQ3Matrix4x4), 0, sizeof(TQ3Matrix4x4) );
+		}
+	}
+
+	return(kQ3Success);
+}
+
+
+
+
+
 //=============================================================================
 //      E3Quaternion_Set : Set quaternion.
 //-----------------------------------------------------------------------------
@@ -4218,6 +4501,64 @@ E3Quaternion_InterpolateLinear(const TQ3Quaternion *q1, const TQ3Quaternion *q2,
 
 
 
+//=============================================================================
+//      E3Quaternion_InterpolateFastArray : Straight linear interpolation of
+//				pairs of quaternions.
+//-----------------------------------------------------------------------------
+//		Note :	Each result may be the same as either of its inputs.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3Quaternion_InterpolateFastArray(const TQ3Quaternion	*q1,
+								  const TQ3Quaternion	*q2,
+								  const float			*t,
+								  TQ3Uns32				numQuaternions,
+								  TQ3Quaternion			*results)
+{
+	TQ3Uns32 i = 0;
+	
+	// Use the vector kernel for whole groups of four
+	const E3MathKernels& theKernels( E3MathKernels_Get() );
+	if (theKernels.quaternionInterpolateFast != nullptr)
+	{
+		i = numQuaternions & ~3U;
+		theKernels.quaternionInterpolateFast( q1, q2, t, results, i );
+	}
+	
+	for (; i < numQuaternions; ++i)
+		E3Quaternion_InterpolateFast( &q1[i], &q2[i], t[i], &results[i] );
+
+	return(kQ3Success);
+}
+
+
+
+
+
+//=============================================================================
+//      E3Quaternion_InterpolateLinearArray : Spherical linear interpolation
+//				of pairs of quaternions.
+//-----------------------------------------------------------------------------
+//		Note :	Each result may be the same as either of its inputs.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3Quaternion_InterpolateLinearArray(const TQ3Quaternion	*q1,
+									const TQ3Quaternion	*q2,
+									const float			*t,
+									TQ3Uns32			numQuaternions,
+									TQ3Quaternion		*results)
+{
+	TQ3Uns32 i;
+	
+	for (i = 0; i < numQuaternions; ++i)
+		E3Quaternion_InterpolateLinear( &q1[i], &q2[i], t[i], &results[i] );
+
+	return(kQ3Success);
+}
+
+
+
+
+
 //=============================================================================
 //      E3Quaternion_GetAxisAndAngle : Get the rotation axis and angle
 //				represented by a quaternion.
@@ -305,6 +305,7 @@ TQ3Matrix4x4 *			E3Matrix4x4_SetRotateAboutPoint(TQ3Matrix4x4 *matrix4x4, const
 TQ3Matrix4x4 *			E3Matrix4x4_SetRotateAboutAxis(TQ3Matrix4x4 *matrix4x4, const TQ3Point3D *origin, const TQ3Vector3D *axis, float angle);
 TQ3Matrix4x4 *			E3Matrix4x4_SetRotateVectorToVector(TQ3Matrix4x4 *matrix4x4, const TQ3Vector3D *v1, const TQ3Vector3D *v2);
 TQ3Matrix4x4 *			E3Matrix4x4_SetQuaternion(TQ3Matrix4x4 *matrix4x4, const TQ3Quaternion *quaternion);
+TQ3Status				E3Matrix4x4_SetQuaternionArray(TQ3Matrix4x4 *outMatrices, const TQ3Quaternion *quaternions, const TQ3Vector3D *scales, const TQ3Vector3D *translations, TQ3Uns32 numMatrices);
 TQ3Matrix3x3 *			E3Matrix3x3_Copy(const TQ3Matrix3x3 *matrix3x3, TQ3Matrix3x3 *result);
 TQ3Matrix4x4 *			E3Matrix4x4_Copy(const TQ3Matrix4x4 *matrix4x4, TQ3Matrix4x4 *result);
 TQ3Matrix3x3 *			E3Matrix3x3_Transpose(const TQ3Matrix3x3 *matrix3x3, TQ3Matrix3x3 *result);
@@ -316,6 +317,8 @@ TQ3Matrix3x3 *			E3Matrix3x3_Invert(const TQ3Matrix3x3 *matrix3x3, TQ3Matrix3x3
 TQ3Matrix4x4 *			E3Matrix4x4_Invert(const TQ3Matrix4x4 *matrix4x4, TQ3Matrix4x4 *result);
 TQ3Matrix3x3 *			E3Matrix3x3_Multiply(const TQ3Matrix3x3 *m1, const TQ3Matrix3x3 *m2, TQ3Matrix3x3 *result);
 TQ3Matrix4x4 *			E3Matrix4x4_Multiply(const TQ3Matrix4x4 *m1, const TQ3Matrix4x4 *m2, TQ3Matrix4x4 *result);
+TQ3Status				E3Matrix4x4_MultiplyArray(const TQ3Matrix4x4 *inMatrices1, const TQ3Matrix4x4 *inMatrices2, TQ3Matrix4x4 *outMatrices, TQ3Uns32 numMatrices, TQ3Uns32 inStructSize1, TQ3Uns32 inStructSize2, TQ3Uns32 outStructSize);
+TQ3Status				E3Matrix4x4_ComposeHierarchy(const TQ3Matrix4x4 *localMatrices, const TQ3Uns32 *parentIndices, TQ3Uns32 numMatrices, TQ3Matrix4x4 *outMatrices);
 
 
 
@@ -342,6 +345,8 @@ TQ3Quaternion *			E3Quaternion_Multiply(const TQ3Quaternion *q1, const TQ3Quater
 TQ3Quaternion *			E3Quaternion_MatchReflection(const TQ3Quaternion *q1, const TQ3Quaternion *q2, TQ3Quaternion *result);
 TQ3Quaternion *			E3Quaternion_InterpolateFast(const TQ3Quaternion *q1, const TQ3Quaternion *q2, float t, TQ3Quaternion *result);
 TQ3Quaternion *			E3Quaternion_InterpolateLinear(const TQ3Quaternion *q1, const TQ3Quaternion *q2, float t, TQ3Quaternion *result);
+TQ3Status				E3Quaternion_InterpolateFastArray(const TQ3Quaternion *q1, const TQ3Quaternion *q2, const float *t, TQ3Uns32 numQuaternions, TQ3Quaternion *results);
+TQ3Status				E3Quaternion_InterpolateLinearArray(const TQ3Quaternion *q1, const TQ3Quaternion *q2, const float *t, TQ3Uns32 numQuaternions, TQ3Quaternion *results);
 TQ3Vector3D *			E3Quaternion_GetAxisAndAngle(const TQ3Quaternion *q, TQ3Vector3D *outAxis, float *outAngle);
 TQ3Vector3D *			E3Vector3D_TransformQuaternion(const TQ3Vector3D *vector3D, const TQ3Quaternion *quaternion, TQ3Vector3D *result);
 TQ3Point3D *			E3Point3D_TransformQuaternion(const TQ3Point3D *point3D, const TQ3Quaternion *quaternion, TQ3Point3D *result);
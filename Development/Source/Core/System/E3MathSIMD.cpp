@@ -0,0 +1,1762 @@
+/*  NAME:
+        E3MathSIMD.cpp
+
+    DESCRIPTION:
+        Vector implementations of the math array functions.
+        
+        Each kernel does the same arithmetic in the same order as the plain
+        loop it replaces, with separate multiplies and adds, so the results
+        are identical whichever kernel set is chosen.
+
+    COPYRIGHT:
+        Copyright (c) 2025, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "E3Prefix.h"
+#include "E3MathSIMD.h"
+#include "E3SIMD.h"
+
+#include <atomic>
+#include <cmath>
+
+
+
+
+
+//=============================================================================
+//      Internal constants
+//-----------------------------------------------------------------------------
+// Largest stride the AVX2 gathers accept, since offsets are 32-bit
+const TQ3Uns32 kMaxGatherStride									= 0x0FFFFFFF;
+
+
+
+
+
+//=============================================================================
+//      Internal functions
+//-----------------------------------------------------------------------------
+//      AdvancePointer, AdvanceConstPointer : Advance a pointer by a stride.
+//-----------------------------------------------------------------------------
+//		Note :	As in E3Math.cpp, pointers are advanced with these templates
+//				rather than by casting to char*& to avoid bad code from some
+//				versions of gcc.
+//-----------------------------------------------------------------------------
+template< typename T>
+inline void AdvancePointer( T*& ioPtr, TQ3Uns32 inCount )
+{
+	char*	ptr = reinterpret_cast<char*>( ioPtr );
+	ptr += inCount;
+	ioPtr = reinterpret_cast<T*>( ptr );
+}
+
+template< typename T>
+inline void AdvanceConstPointer( const T*& ioPtr, TQ3Uns32 inCount )
+{
+	const char*	ptr = reinterpret_cast<const char*>( ioPtr );
+	ptr += inCount;
+	ioPtr = reinterpret_cast<const T*>( ptr );
+}
+
+
+
+
+
+#if QUESA_SIMD_SSE2 || QUESA_SIMD_NEON
+//=============================================================================
+//      e3math_post_infinite_point : Post the error for a point at infinity.
+//-----------------------------------------------------------------------------
+//		Note :	Kept out of line so the kernels stay small, matching the
+//				error E3Point3D_Transform posts.
+//-----------------------------------------------------------------------------
+static void
+e3math_post_infinite_point(void)
+{
+	E3ErrorManager_PostError( kQ3ErrorInfiniteRationalPoint, kQ3False );
+}
+
+
+
+
+
+//=============================================================================
+//      e3math_store_triangle_normals : Store normals computed 4 or 8 at a time.
+//-----------------------------------------------------------------------------
+//		Note :	Triangles whose usage flag is set keep their old normal.
+//-----------------------------------------------------------------------------
+static void
+e3math_store_triangle_normals(TQ3Uns32			firstTriangle,
+							  TQ3Uns32			numTriangles,
+							  const TQ3Uns8		*usageFlags,
+							  const float		*x,
+							  const float		*y,
+							  const float		*z,
+							  TQ3Vector3D		*theNormals)
+{	TQ3Uns32	n;
+
+
+
+	for (n = 0; n < numTriangles; ++n)
+		{
+		if (usageFlags == nullptr || !usageFlags[firstTriangle + n])
+			{
+			theNormals[firstTriangle + n].x = x[n];
+			theNormals[firstTriangle + n].y = y[n];
+			theNormals[firstTriangle + n].z = z[n];
+			}
+		}
+}
+
+
+
+
+
+//=============================================================================
+//      e3math_triangle_normals_tail : Plain loop for the last few triangles.
+//-----------------------------------------------------------------------------
+static void
+e3math_triangle_normals_tail(TQ3Uns32			firstTriangle,
+							 TQ3Uns32			numTriangles,
+							 const TQ3Uns8		*usageFlags,
+							 const TQ3Uns32		*theIndices,
+							 const TQ3Point3D	*thePoints,
+							 TQ3Vector3D		*theNormals)
+{	TQ3Uns32	n;
+
+
+
+	for (n = firstTriangle; n < numTriangles; ++n)
+		{
+		if (usageFlags == nullptr || !usageFlags[n])
+			{
+			Q3FastPoint3D_CrossProductTri(&thePoints[theIndices[n * 3 + 0]],
+										  &thePoints[theIndices[n * 3 + 1]],
+										  &thePoints[theIndices[n * 3 + 2]],
+										  &theNormals[n]);
+			Q3FastVector3D_Normalize(&theNormals[n], &theNormals[n]);
+			}
+		}
+}
+
+
+
+
+
+//=============================================================================
+//      e3math_dot_tail : Plain loop for the last few dot products.
+//-----------------------------------------------------------------------------
+static void
+e3math_dot_tail(const TQ3Vector3D	*inFirstVectors,
+				const TQ3Vector3D	*inSecondVectors,
+				float				*outDotProducts,
+				TQ3Boolean			*outDotLessThanZeros,
+				TQ3Uns32			numVectors,
+				TQ3Uns32			inStride,
+				TQ3Uns32			outDotProductStride,
+				TQ3Uns32			outDotLessThanZeroStride)
+{	float		dotProduct;
+	TQ3Uns32	i;
+
+
+
+	for (i = 0; i < numVectors; ++i)
+		{
+		dotProduct = Q3FastVector3D_Dot(inFirstVectors, inSecondVectors);
+
+		if (outDotProducts != nullptr)
+			{
+			*outDotProducts = dotProduct;
+			AdvancePointer( outDotProducts, outDotProductStride );
+			}
+
+		if (outDotLessThanZeros != nullptr)
+			{
+			*outDotLessThanZeros = (TQ3Boolean) (dotProduct < 0.0f);
+			AdvancePointer( outDotLessThanZeros, outDotLessThanZeroStride );
+			}
+
+		AdvanceConstPointer( inFirstVectors, inStride );
+		AdvanceConstPointer( inSecondVectors, inStride );
+		}
+}
+
+
+
+
+
+//=============================================================================
+//      e3math_store_dots : Store dot products computed 4 or 8 at a time.
+//-----------------------------------------------------------------------------
+static void
+e3math_store_dots(const float		*theDots,
+				  TQ3Uns32			numDots,
+				  float				*&outDotProducts,
+				  TQ3Boolean		*&outDotLessThanZeros,
+				  TQ3Uns32			outDotProductStride,
+				  TQ3Uns32			outDotLessThanZeroStride)
+{	TQ3Uns32	n;
+
+
+
+	for (n = 0; n < numDots; ++n)
+		{
+		if (outDotProducts != nullptr)
+			{
+			*outDotProducts = theDots[n];
+			AdvancePointer( outDotProducts, outDotProductStride );
+			}
+
+		if (outDotLessThanZeros != nullptr)
+			{
+			*outDotLessThanZeros = (TQ3Boolean) (theDots[n] < 0.0f);
+			AdvancePointer( outDotLessThanZeros, outDotLessThanZeroStride );
+			}
+		}
+}
+
+
+
+
+
+#endif // QUESA_SIMD_SSE2 || QUESA_SIMD_NEON
+
+
+
+
+
+#pragma mark -
+#if QUESA_SIMD_SSE2
+//=============================================================================
+//      SSE2 kernels
+//-----------------------------------------------------------------------------
+//		Note :	Points are transformed one at a time, with the four columns
+//				of the result computed together from the rows of the matrix.
+//-----------------------------------------------------------------------------
+//      e3math_sse2_store3 : Store the first three lanes of a vector.
+//-----------------------------------------------------------------------------
+static inline void
+e3math_sse2_store3(float *outXYZ, __m128 theValue)
+{
+	_mm_storel_pi( (__m64 *) outXYZ, theValue );
+	_mm_store_ss( outXYZ + 2, _mm_movehl_ps( theValue, theValue ) );
+}
+
+
+
+
+
+//=============================================================================
+//      e3math_sse2_point3D_to3DAffine : Transform 3D points, affine matrix.
+//-----------------------------------------------------------------------------
+static void
+e3math_sse2_point3D_to3DAffine(const TQ3Point3D *inPoints, const TQ3Matrix4x4 *matrix,
+								TQ3Point3D *outPoints, TQ3Uns32 numPoints,
+								TQ3Uns32 inStride, TQ3Uns32 outStride)
+{	const __m128	row0 = _mm_loadu_ps( matrix->value[0] );
+	const __m128	row1 = _mm_loadu_ps( matrix->value[1] );
+	const __m128	row2 = _mm_loadu_ps( matrix->value[2] );
+	const __m128	row3 = _mm_loadu_ps( matrix->value[3] );
+	__m128			theResult;
+	TQ3Uns32		i;
+
+
+
+	for (i = 0; i < numPoints; ++i)
+		{
+		theResult = _mm_add_ps( _mm_mul_ps( _mm_set1_ps( inPoints->x ), row0 ),
+								_mm_mul_ps( _mm_set1_ps( inPoints->y ), row1 ) );
+		theResult = _mm_add_ps( theResult, _mm_mul_ps( _mm_set1_ps( inPoints->z ), row2 ) );
+		theResult = _mm_add_ps( theResult, row3 );
+		e3math_sse2_store3( &outPoints->x, theResult );
+
+		AdvanceConstPointer( inPoints, inStride );
+		AdvancePointer( outPoints, outStride );
+		}
+}
+
+
+
+
+
+//=============================================================================
+//      e3math_sse2_point3D_to3D : Transform 3D points, projective matrix.
+//-----------------------------------------------------------------------------
+static void
+e3math_sse2_point3D_to3D(const TQ3Point3D *inPoints, const TQ3Matrix4x4 *matrix,
+							TQ3Point3D *outPoints, TQ3Uns32 numPoints,
+							TQ3Uns32 inStride, TQ3Uns32 outStride)
+{	const __m128	row0 = _mm_loadu_ps( matrix->value[0] );
+	const __m128	row1 = _mm_loadu_ps( matrix->value[1] );
+	const __m128	row2 = _mm_loadu_ps( matrix->value[2] );
+	const __m128	row3 = _mm_loadu_ps( matrix->value[3] );
+	__m128			theResult;
+	float			neww;
+	TQ3Uns32		i;
+
+
+
+	for (i = 0; i < numPoints; ++i)
+		{
+		theResult = _mm_add_ps( _mm_mul_ps( _mm_set1_ps( inPoints->x ), row0 ),
+								_mm_mul_ps( _mm_set1_ps( inPoints->y ), row1 ) );
+		theResult = _mm_add_ps( theResult, _mm_mul_ps( _mm_set1_ps( inPoints->z ), row2 ) );
+		theResult = _mm_add_ps( theResult, row3 );
+		neww      = _mm_cvtss_f32( _mm_shuffle_ps( theResult, theResult, _MM_SHUFFLE(3, 3, 3, 3) ) );
+
+		if (neww == 0.0f)
+			{
+			e3math_post_infinite_point();
+			neww = 1.0f;
+			}
+
+		if (neww != 1.0f)
+			theResult = _mm_mul_ps( theResult, _mm_set1_ps( 1.0f / neww ) );
+
+		e3math_sse2_store3( &outPoints->x, theResult );
+
+		AdvanceConstPointer( inPoints, inStride );
+		AdvancePointer( outPoints, outStride );
+		}
+}
+
+
+
+
+
+//=============================================================================
+//      e3math_sse2_point3D_to4D : Transform 3D points to rational 4D points.
+//-----------------------------------------------------------------------------
+static void
+e3math_sse2_point3D_to4D(const TQ3Point3D *inPoints, const TQ3Matrix4x4 *matrix,
+							TQ3RationalPoint4D *outPoints, TQ3Uns32 numPoints,
+							TQ3Uns32 inStride, TQ3Uns32 outStride)
+{	const __m128	row0 = _mm_loadu_ps( matrix->value[0] );
+	const __m128	row1 = _mm_loadu_ps( matrix->value[1] );
+	const __m128	row2 = _mm_loadu_ps( matrix->value[2] );
+	const __m128	row3 = _mm_loadu_ps( matrix->value[3] );
+	__m128			theResult;
+	TQ3Uns32		i;
+
+
+
+	for (i = 0; i < numPoints; ++i)
+		{
+		theResult = _mm_add_ps( _mm_mul_ps( _mm_set1_ps( inPoints->x ), row0 ),
+								_mm_mul_ps( _mm_set1_ps( inPoints->y ), row1 ) );
+		theResult = _mm_add_ps( theResult, _mm_mul_ps( _mm_set1_ps( inPoints->z ), row2 ) );
+		theResult = _mm_add_ps( theResult, row3 );
+		_mm_storeu_ps( &outPoints->x, theResult );
+
+		AdvanceConstPointer( inPoints, inStride );
+		AdvancePointer( outPoints, outStride );
+		}
+}
+
+
+
+
+
+//=============================================================================
+//      e3math_sse2_vector3D_to3D : Transform 3D vectors.
+//-----------------------------------------------------------------------------
+static void
+e3math_sse2_vector3D_to3D(const TQ3Vector3D *inVectors, const TQ3Matrix4x4 *matrix,
+							TQ3Vector3D *outVectors, TQ3Uns32 numVectors,
+							TQ3Uns32 inStride, TQ3Uns32 outStride)
+{	const __m128	row0 = _mm_loadu_ps( matrix->value[0] );
+	const __m128	row1 = _mm_loadu_ps( matrix->value[1] );
+	const __m128	row2 = _mm_loadu_ps( matrix->value[2] );
+	__m128			theResult;
+	TQ3Uns32		i;
+
+
+
+	for (i = 0; i < numVectors; ++i)
+		{
+		theResult = _mm_add_ps( _mm_mul_ps( _mm_set1_ps( inVectors->x ), row0 ),
+								_mm_mul_ps( _mm_set1_ps( inVectors->y ), row1 ) );
+		theResult = _mm_add_ps( theResult, _mm_mul_ps( _mm_set1_ps( inVectors->z ), row2 ) );
+		e3math_sse2_store3( &outVectors->x, theResult );
+
+		AdvanceConstPointer( inVectors, inStride );
+		AdvancePointer( outVectors, outStride );
+		}
+}
+
+
+
+
+
+//=============================================================================
+//      e3math_sse2_rationalPoint4D_to4D : Transform rational 4D points.
+//-----------------------------------------------------------------------------
+static void
+e3math_sse2_rationalPoint4D_to4D(const TQ3RationalPoint4D *inPoints, const TQ3Matrix4x4 *matrix,
+									TQ3RationalPoint4D *outPoints, TQ3Uns32 numPoints,
+									TQ3Uns32 inStride, TQ3Uns32 outStride)
+{	const __m128	row0 = _mm_loadu_ps( matrix->value[0] );
+	const __m128	row1 = _mm_loadu_ps( matrix->value[1] );
+	const __m128	row2 = _mm_loadu_ps( matrix->value[2] );
+	const __m128	row3 = _mm_loadu_ps( matrix->value[3] );
+	__m128			theResult;
+	TQ3Uns32		i;
+
+
+
+	for (i = 0; i < numPoints; ++i)
+		{
+		theResult = _mm_add_ps( _mm_mul_ps( _mm_set1_ps( inPoints->x ), row0 ),
+								_mm_mul_ps( _mm_set1_ps( inPoints->y ), row1 ) );
+		theResult = _mm_add_ps( theResult, _mm_mul_ps( _mm_set1_ps( inPoints->z ), row2 ) );
+		theResult = _mm_add_ps( theResult, _mm_mul_ps( _mm_set1_ps( inPoints->w ), row3 ) );
+		_mm_storeu_ps( &outPoints->x, theResult );
+
+		AdvanceConstPointer( inPoints, inStride );
+		AdvancePointer( outPoints, outStride );
+		}
+}
+
+
+
+
+
+//=============================================================================
+//      e3math_sse2_vector3DDot : Dot pairs of 3D vectors, 4 at a time.
+//-----------------------------------------------------------------------------
+static void
+e3math_sse2_vector3DDot(const TQ3Vector3D *inFirstVectors, const TQ3Vector3D *inSecondVectors,
+						float *outDotProducts, TQ3Boolean *outDotLessThanZeros,
+						TQ3Uns32 numVectors, TQ3Uns32 inStride,
+						TQ3Uns32 outDotProductStride, TQ3Uns32 outDotLessThanZeroStride)
+{	const TQ3Vector3D	*a[4], *b[4];
+	float				theDots[4];
+	__m128				theDot;
+	TQ3Uns32			i, n;
+
+
+
+	for (i = 0; i + 4 <= numVectors; i += 4)
+		{
+		for (n = 0; n < 4; ++n)
+			{
+			a[n] = inFirstVectors;
+			b[n] = inSecondVectors;
+			AdvanceConstPointer( inFirstVectors, inStride );
+			AdvanceConstPointer( inSecondVectors, inStride );
+			}
+
+		theDot = _mm_add_ps( _mm_mul_ps( _mm_setr_ps( a[0]->x, a[1]->x, a[2]->x, a[3]->x ),
+										 _mm_setr_ps( b[0]->x, b[1]->x, b[2]->x, b[3]->x ) ),
+							 _mm_mul_ps( _mm_setr_ps( a[0]->y, a[1]->y, a[2]->y, a[3]->y ),
+										 _mm_setr_ps( b[0]->y, b[1]->y, b[2]->y, b[3]->y ) ) );
+		theDot = _mm_add_ps( theDot,
+							 _mm_mul_ps( _mm_setr_ps( a[0]->z, a[1]->z, a[2]->z, a[3]->z ),
+										 _mm_setr_ps( b[0]->z, b[1]->z, b[2]->z, b[3]->z ) ) );
+		_mm_storeu_ps( theDots, theDot );
+
+		e3math_store_dots( theDots, 4, outDotProducts, outDotLessThanZeros,
+							outDotProductStride, outDotLessThanZeroStride );
+		}
+
+	e3math_dot_tail( inFirstVectors, inSecondVectors, outDotProducts, outDotLessThanZeros,
+					numVectors - i, inStride, outDotProductStride, outDotLessThanZeroStride );
+}
+
+
+
+
+
+//=============================================================================
+//      e3math_sse2_triangleNormals : Calculate triangle normals, 4 at a time.
+//-----------------------------------------------------------------------------
+static void
+e3math_sse2_triangleNormals(TQ3Uns32 numTriangles, const TQ3Uns8 *usageFlags,
+							const TQ3Uns32 *theIndices, const TQ3Point3D *thePoints,
+							TQ3Vector3D *theNormals)
+{	const TQ3Point3D	*p1[4], *p2[4], *p3[4];
+	__m128				v1x, v1y, v1z, v2x, v2y, v2z;
+	__m128				nx, ny, nz, theLength;
+	float				outX[4], outY[4], outZ[4];
+	TQ3Uns32			i, n;
+
+
+
+	for (i = 0; i + 4 <= numTriangles; i += 4)
+		{
+		for (n = 0; n < 4; ++n)
+			{
+			p1[n] = &thePoints[theIndices[(i + n) * 3 + 0]];
+			p2[n] = &thePoints[theIndices[(i + n) * 3 + 1]];
+			p3[n] = &thePoints[theIndices[(i + n) * 3 + 2]];
+			}
+
+		#define LOAD4(_p, _c)	_mm_setr_ps( _p[0]->_c, _p[1]->_c, _p[2]->_c, _p[3]->_c )
+		v1x = _mm_sub_ps( LOAD4(p2, x), LOAD4(p1, x) );
+		v1y = _mm_sub_ps( LOAD4(p2, y), LOAD4(p1, y) );
+		v1z = _mm_sub_ps( LOAD4(p2, z), LOAD4(p1, z) );
+		v2x = _mm_sub_ps( LOAD4(p3, x), LOAD4(p2, x) );
+		v2y = _mm_sub_ps( LOAD4(p3, y), LOAD4(p2, y) );
+		v2z = _mm_sub_ps( LOAD4(p3, z), LOAD4(p2, z) );
+		#undef LOAD4
+
+		nx = _mm_sub_ps( _mm_mul_ps( v1y, v2z ), _mm_mul_ps( v1z, v2y ) );
+		ny = _mm_sub_ps( _mm_mul_ps( v1z, v2x ), _mm_mul_ps( v1x, v2z ) );
+		nz = _mm_sub_ps( _mm_mul_ps( v1x, v2y ), _mm_mul_ps( v1y, v2x ) );
+
+		theLength = _mm_add_ps( _mm_add_ps( _mm_mul_ps( nx, nx ), _mm_mul_ps( ny, ny ) ),
+								_mm_mul_ps( nz, nz ) );
+		theLength = _mm_add_ps( _mm_sqrt_ps( theLength ), _mm_set1_ps( kQ3MinFloat ) );
+		theLength = _mm_div_ps( _mm_set1_ps( 1.0f ), theLength );
+
+		_mm_storeu_ps( outX, _mm_mul_ps( nx, theLength ) );
+		_mm_storeu_ps( outY, _mm_mul_ps( ny, theLength ) );
+		_mm_storeu_ps( outZ, _mm_mul_ps( nz, theLength ) );
+		e3math_store_triangle_normals( i, 4, usageFlags, outX, outY, outZ, theNormals );
+		}
+
+	e3math_triangle_normals_tail( i, numTriangles, usageFlags, theIndices, thePoints, theNormals );
+}
+
+
+
+
+
+//=============================================================================
+//      e3math_sse2_matrix4x4Multiply : Multiply pairs of 4x4 matrices.
+//-----------------------------------------------------------------------------
+//		Note :	Both matrices are loaded before the result is stored, so the
+//				result may be the same as either input.
+//-----------------------------------------------------------------------------
+static void
+e3math_sse2_matrix4x4Multiply(const TQ3Matrix4x4 *inMatrices1, const TQ3Matrix4x4 *inMatrices2,
+								TQ3Matrix4x4 *outMatrices, TQ3Uns32 numMatrices,
+								TQ3Uns32 inStride1, TQ3Uns32 inStride2, TQ3Uns32 outStride)
+{	__m128		a[4], b[4], theRow;
+	TQ3Uns32	i, r;
+
+
+
+	for (i = 0; i < numMatrices; ++i)
+		{
+		for (r = 0; r < 4; ++r)
+			{
+			a[r] = _mm_loadu_ps( inMatrices1->value[r] );
+			b[r] = _mm_loadu_ps( inMatrices2->value[r] );
+			}
+
+		for (r = 0; r < 4; ++r)
+			{
+			theRow = _mm_add_ps( _mm_mul_ps( _mm_shuffle_ps( a[r], a[r], _MM_SHUFFLE(0, 0, 0, 0) ), b[0] ),
+								 _mm_mul_ps( _mm_shuffle_ps( a[r], a[r], _MM_SHUFFLE(1, 1, 1, 1) ), b[1] ) );
+			theRow = _mm_add_ps( theRow,
+								 _mm_mul_ps( _mm_shuffle_ps( a[r], a[r], _MM_SHUFFLE(2, 2, 2, 2) ), b[2] ) );
+			theRow = _mm_add_ps( theRow,
+								 _mm_mul_ps( _mm_shuffle_ps( a[r], a[r], _MM_SHUFFLE(3, 3, 3, 3) ), b[3] ) );
+			_mm_storeu_ps( outMatrices->value[r], theRow );
+			}
+
+		AdvanceConstPointer( inMatrices1, inStride1 );
+		AdvanceConstPointer( inMatrices2, inStride2 );
+		AdvancePointer( outMatrices, outStride );
+		}
+}
+
+
+
+
+
+//=============================================================================
+//      e3math_sse2_quaternionInterpolateFast : Interpolate quaternions, 4 at
+//				a time.
+//-----------------------------------------------------------------------------
+//		Note :	Four quaternions are transposed into w, x, y and z vectors,
+//				so the normalization needs no horizontal adds.
+//-----------------------------------------------------------------------------
+static void
+e3math_sse2_quaternionInterpolateFast(const TQ3Quaternion *q1, const TQ3Quaternion *q2,
+										const float *t, TQ3Quaternion *results,
+										TQ3Uns32 numQuaternions)
+{	const __m128	theOne = _mm_set1_ps( 1.0f );
+	__m128			a[4], b[4], theT, theT1, theDot, theFactor;
+	TQ3Uns32		i, n;
+
+
+
+	for (i = 0; i + 4 <= numQuaternions; i += 4)
+		{
+		for (n = 0; n < 4; ++n)
+			{
+			a[n] = _mm_loadu_ps( &q1[i + n].w );
+			b[n] = _mm_loadu_ps( &q2[i + n].w );
+			}
+
+		_MM_TRANSPOSE4_PS( a[0], a[1], a[2], a[3] );
+		_MM_TRANSPOSE4_PS( b[0], b[1], b[2], b[3] );
+
+		theT  = _mm_loadu_ps( t + i );
+		theT1 = _mm_sub_ps( theOne, theT );
+		for (n = 0; n < 4; ++n)
+			a[n] = _mm_add_ps( _mm_mul_ps( a[n], theT1 ), _mm_mul_ps( b[n], theT ) );
+
+		theDot = _mm_add_ps( _mm_mul_ps( a[0], a[0] ), _mm_mul_ps( a[1], a[1] ) );
+		theDot = _mm_add_ps( theDot, _mm_mul_ps( a[2], a[2] ) );
+		theDot = _mm_add_ps( theDot, _mm_mul_ps( a[3], a[3] ) );
+		theFactor = _mm_div_ps( theOne, _mm_sqrt_ps( theDot ) );
+		for (n = 0; n < 4; ++n)
+			a[n] = _mm_mul_ps( a[n], theFactor );
+
+		_MM_TRANSPOSE4_PS( a[0], a[1], a[2], a[3] );
+		for (n = 0; n < 4; ++n)
+			_mm_storeu_ps( &results[i + n].w, a[n] );
+		}
+}
+
+
+
+
+
+//=============================================================================
+//      e3math_sse2_quaternionToMatrix : Build matrices from quaternions,
+//				4 at a time.
+//-----------------------------------------------------------------------------
+static void
+e3math_sse2_quaternionToMatrix(const TQ3Quaternion *quaternions, const TQ3Vector3D *scales,
+								const TQ3Vector3D *translations, TQ3Matrix4x4 *outMatrices,
+								TQ3Uns32 numMatrices)
+{	const __m128	theOne = _mm_set1_ps( 1.0f );
+	__m128			w, x, y, z, x2, y2, z2;
+	__m128			xx, xy, xz, yy, yz, zz, wx, wy, wz;
+	__m128			theRows[3][4], theScales[3];
+	TQ3Uns32		i, n, r, c;
+
+
+
+	for (i = 0; i + 4 <= numMatrices; i += 4)
+		{
+		w = _mm_loadu_ps( &quaternions[i + 0].w );
+		x = _mm_loadu_ps( &quaternions[i + 1].w );
+		y = _mm_loadu_ps( &quaternions[i + 2].w );
+		z = _mm_loadu_ps( &quaternions[i + 3].w );
+		_MM_TRANSPOSE4_PS( w, x, y, z );
+
+		x2 = _mm_add_ps( x, x );
+		y2 = _mm_add_ps( y, y );
+		z2 = _mm_add_ps( z, z );
+		xx = _mm_mul_ps( x, x2 );
+		xy = _mm_mul_ps( x, y2 );
+		xz = _mm_mul_ps( x, z2 );
+		yy = _mm_mul_ps( y, y2 );
+		yz = _mm_mul_ps( y, z2 );
+		zz = _mm_mul_ps( z, z2 );
+		wx = _mm_mul_ps( w, x2 );
+		wy = _mm_mul_ps( w, y2 );
+		wz = _mm_mul_ps( w, z2 );
+
+		theRows[0][0] = _mm_sub_ps( theOne, _mm_add_ps( yy, zz ) );
+		theRows[0][1] = _mm_add_ps( xy, wz );
+		theRows[0][2] = _mm_sub_ps( xz, wy );
+		theRows[1][0] = _mm_sub_ps( xy, wz );
+		theRows[1][1] = _mm_sub_ps( theOne, _mm_add_ps( xx, zz ) );
+		theRows[1][2] = _mm_add_ps( yz, wx );
+		theRows[2][0] = _mm_add_ps( xz, wy );
+		theRows[2][1] = _mm_sub_ps( yz, wx );
+		theRows[2][2] = _mm_sub_ps( theOne, _mm_add_ps( xx, yy ) );
+
+		if (scales != nullptr)
+			{
+			theScales[0] = _mm_setr_ps( scales[i].x, scales[i + 1].x, scales[i + 2].x, scales[i + 3].x );
+			theScales[1] = _mm_setr_ps( scales[i].y, scales[i + 1].y, scales[i + 2].y, scales[i + 3].y );
+			theScales[2] = _mm_setr_ps( scales[i].z, scales[i + 1].z, scales[i + 2].z, scales[i + 3].z );
+			for (r = 0; r < 3; ++r)
+				for (c = 0; c < 3; ++c)
+					theRows[r][c] = _mm_mul_ps( theRows[r][c], theScales[r] );
+			}
+
+		for (r = 0; r < 3; ++r)
+			{
+			theRows[r][3] = _mm_setzero_ps();
+			_MM_TRANSPOSE4_PS( theRows[r][0], theRows[r][1], theRows[r][2], theRows[r][3] );
+			for (n = 0; n < 4; ++n)
+				_mm_storeu_ps( outMatrices[i + n].value[r], theRows[r][n] );
+			}
+
+		for (n = 0; n < 4; ++n)
+			{
+			if (translations != nullptr)
+				_mm_storeu_ps( outMatrices[i + n].value[3],
+							   _mm_setr_ps( translations[i + n].x, translations[i + n].y,
+											translations[i + n].z, 1.0f ) );
+			else
+				_mm_storeu_ps( outMatrices[i + n].value[3], _mm_setr_ps( 0.0f, 0.0f, 0.0f, 1.0f ) );
+			}
+		}
+}
+#endif // QUESA_SIMD_SSE2
+
+
+
+
+
+#pragma mark -
+#if QUESA_SIMD_AVX2
+//=============================================================================
+//      AVX2 kernels
+//-----------------------------------------------------------------------------
+//		Note :	Eight points are gathered into separate x, y and z vectors,
+//				so each multiply works on eight points at once. Whatever is
+//				left over goes to the SSE2 kernels.
+//
+//				Every function here is compiled for AVX2, and is only called
+//				once the processor has reported support for it.
+//-----------------------------------------------------------------------------
+//      e3math_avx2_offsets : Byte offsets of eight consecutive elements.
+//-----------------------------------------------------------------------------
+static inline Q3_TARGET_AVX2 __m256i
+e3math_avx2_offsets(TQ3Uns32 theStride)
+{
+	return _mm256_mullo_epi32( _mm256_setr_epi32( 0, 1, 2, 3, 4, 5, 6, 7 ),
+							   _mm256_set1_epi32( (int) theStride ) );
+}
+
+
+
+
+
+//=============================================================================
+//      e3math_avx2_transform3 : Transform eight gathered points.
+//-----------------------------------------------------------------------------
+//		Note :	If includeW is false, outW is not written. The constant term
+//				is included only for points.
+//-----------------------------------------------------------------------------
+static inline Q3_TARGET_AVX2 void
+e3math_avx2_transform3(const float *inXYZ, __m256i theOffsets,
+						const TQ3Matrix4x4 *matrix, bool isPoint, bool includeW,
+						__m256 &outX, __m256 &outY, __m256 &outZ, __m256 &outW)
+{	const __m256	x = _mm256_i32gather_ps( inXYZ + 0, theOffsets, 1 );
+	const __m256	y = _mm256_i32gather_ps( inXYZ + 1, theOffsets, 1 );
+	const __m256	z = _mm256_i32gather_ps( inXYZ + 2, theOffsets, 1 );
+	__m256			*theResults[4] = { &outX, &outY, &outZ, &outW };
+	TQ3Uns32		col;
+
+
+
+	for (col = 0; col < (includeW ? 4U : 3U); ++col)
+		{
+		#define M(_r)	_mm256_set1_ps( matrix->value[_r][col] )
+		__m256 r = _mm256_add_ps( _mm256_mul_ps( x, M(0) ), _mm256_mul_ps( y, M(1) ) );
+		r = _mm256_add_ps( r, _mm256_mul_ps( z, M(2) ) );
+		if (isPoint)
+			r = _mm256_add_ps( r, M(3) );
+		#undef M
+		*theResults[col] = r;
+		}
+}
+
+
+
+
+
+//=============================================================================
+//      e3math_avx2_can_gather : Check whether a stride suits the gathers.
+//-----------------------------------------------------------------------------
+static inline bool
+e3math_avx2_can_gather(TQ3Uns32 theStride)
+{
+	return (theStride % sizeof(float)) == 0 && theStride <= kMaxGatherStride / 8;
+}
+
+
+
+
+
+//=============================================================================
+//      e3math_avx2_point3D_transform : Transform 3D points, 8 at a time.
+//-----------------------------------------------------------------------------
+static Q3_TARGET_AVX2 void
+e3math_avx2_point3D_transform(const TQ3Point3D *inPoints, const TQ3Matrix4x4 *matrix,
+								TQ3Point3D *outPoints, TQ3Uns32 numPoints,
+								TQ3Uns32 inStride, TQ3Uns32 outStride, bool isAffine)
+{	const __m256i	theOffsets = e3math_avx2_offsets( inStride );
+	const __m256	theZero    = _mm256_setzero_ps();
+	const __m256	theOne     = _mm256_set1_ps( 1.0f );
+	float			outXYZ[3][8];
+	__m256			x, y, z, w, isZero;
+	TQ3Uns32		i, n, numZero;
+
+
+
+	for (i = 0; i + 8 <= numPoints; i += 8)
+		{
+		e3math_avx2_transform3( &inPoints->x, theOffsets, matrix, true, !isAffine, x, y, z, w );
+
+		if (!isAffine)
+			{
+			// Points at infinity post an error each and are left undivided,
+			// and dividing the rest by 1 changes nothing.
+			isZero  = _mm256_cmp_ps( w, theZero, _CMP_EQ_OQ );
+			numZero = (TQ3Uns32) _mm_popcnt_u32( (unsigned) _mm256_movemask_ps( isZero ) );
+			for (n = 0; n < numZero; ++n)
+				e3math_post_infinite_point();
+
+			w = _mm256_div_ps( theOne, _mm256_blendv_ps( w, theOne, isZero ) );
+			x = _mm256_mul_ps( x, w );
+			y = _mm256_mul_ps( y, w );
+			z = _mm256_mul_ps( z, w );
+			}
+
+		_mm256_storeu_ps( outXYZ[0], x );
+		_mm256_storeu_ps( outXYZ[1], y );
+		_mm256_storeu_ps( outXYZ[2], z );
+
+		for (n = 0; n < 8; ++n)
+			{
+			outPoints->x = outXYZ[0][n];
+			outPoints->y = outXYZ[1][n];
+			outPoints->z = outXYZ[2][n];
+			AdvancePointer( outPoints, outStride );
+			}
+
+		AdvanceConstPointer( inPoints, 8 * inStride );
+		}
+
+	if (isAffine)
+		e3math_sse2_point3D_to3DAffine( inPoints, matrix, outPoints, numPoints - i, inStride, outStride );
+	else
+		e3math_sse2_point3D_to3D( inPoints, matrix, outPoints, numPoints - i, inStride, outStride );
+}
+
+
+
+
+
+//=============================================================================
+//      e3math_avx2_point3D_to3DAffine : Transform 3D points, affine matrix.
+//-----------------------------------------------------------------------------
+static void
+e3math_avx2_point3D_to3DAffine(const TQ3Point3D *inPoints, const TQ3Matrix4x4 *matrix,
+								TQ3Point3D *outPoints, TQ3Uns32 numPoints,
+								TQ3Uns32 inStride, TQ3Uns32 outStride)
+{
+	if (e3math_avx2_can_gather( inStride ))
+		e3math_avx2_point3D_transform( inPoints, matrix, outPoints, numPoints, inStride, outStride, true );
+	else
+		e3math_sse2_point3D_to3DAffine( inPoints, matrix, outPoints, numPoints, inStride, outStride );
+}
+
+
+
+
+
+//=============================================================================
+//      e3math_avx2_point3D_to3D : Transform 3D points, projective matrix.
+//-----------------------------------------------------------------------------
+static void
+e3math_avx2_point3D_to3D(const TQ3Point3D *inPoints, const TQ3Matrix4x4 *matrix,
+							TQ3Point3D *outPoints, TQ3Uns32 numPoints,
+							TQ3Uns32 inStride, TQ3Uns32 outStride)
+{
+	if (e3math_avx2_can_gather( inStride ))
+		e3math_avx2_point3D_transform( inPoints, matrix, outPoints, numPoints, inStride, outStride, false );
+	else
+		e3math_sse2_point3D_to3D( inPoints, matrix, outPoints, numPoints, inStride, outStride );
+}
+
+
+
+
+
+//=============================================================================
+//      e3math_avx2_point3D_to4D : Transform 3D points to rational 4D points.
+//-----------------------------------------------------------------------------
+static Q3_TARGET_AVX2 void
+e3math_avx2_point3D_to4D(const TQ3Point3D *inPoints, const TQ3Matrix4x4 *matrix,
+							TQ3RationalPoint4D *outPoints, TQ3Uns32 numPoints,
+							TQ3Uns32 inStride, TQ3Uns32 outStride)
+{	float			outXYZW[4][8];
+	__m256			x, y, z, w;
+	TQ3Uns32		i = 0, n;
+
+
+
+	if (e3math_avx2_can_gather( inStride ))
+		{
+		const __m256i theOffsets = e3math_avx2_offsets( inStride );
+
+		for (; i + 8 <= numPoints; i += 8)
+			{
+			e3math_avx2_transform3( &inPoints->x, theOffsets, matrix, true, true, x, y, z, w );
+			_mm256_storeu_ps( outXYZW[0], x );
+			_mm256_storeu_ps( outXYZW[1], y );
+			_mm256_storeu_ps( outXYZW[2], z );
+			_mm256_storeu_ps( outXYZW[3], w );
+
+			for (n = 0; n < 8; ++n)
+				{
+				outPoints->x = outXYZW[0][n];
+				outPoints->y = outXYZW[1][n];
+				outPoints->z = outXYZW[2][n];
+				outPoints->w = outXYZW[3][n];
+				AdvancePointer( outPoints, outStride );
+				}
+
+			AdvanceConstPointer( inPoints, 8 * inStride );
+			}
+		}
+
+	e3math_sse2_point3D_to4D( inPoints, matrix, outPoints, numPoints - i, inStride, outStride );
+}
+
+
+
+
+
+//=============================================================================
+//      e3math_avx2_vector3D_to3D : Transform 3D vectors.
+//-----------------------------------------------------------------------------
+static Q3_TARGET_AVX2 void
+e3math_avx2_vector3D_to3D(const TQ3Vector3D *inVectors, const TQ3Matrix4x4 *matrix,
+							TQ3Vector3D *outVectors, TQ3Uns32 numVectors,
+							TQ3Uns32 inStride, TQ3Uns32 outStride)
+{	float			outXYZ[3][8];
+	__m256			x, y, z, w;
+	TQ3Uns32		i = 0, n;
+
+
+
+	if (e3math_avx2_can_gather( inStride ))
+		{
+		const __m256i theOffsets = e3math_avx2_offsets( inStride );
+
+		for (; i + 8 <= numVectors; i += 8)
+			{
+			e3math_avx2_transform3( &inVectors->x, theOffsets, matrix, false, false, x, y, z, w );
+			_mm256_storeu_ps( outXYZ[0], x );
+			_mm256_storeu_ps( outXYZ[1], y );
+			_mm256_storeu_ps( outXYZ[2], z );
+
+			for (n = 0; n < 8; ++n)
+				{
+				outVectors->x = outXYZ[0][n];
+				outVectors->y = outXYZ[1][n];
+				outVectors->z = outXYZ[2][n];
+				AdvancePointer( outVectors, outStride );
+				}
+
+			AdvanceConstPointer( inVectors, 8 * inStride );
+			}
+		}
+
+	e3math_sse2_vector3D_to3D( inVectors, matrix, outVectors, numVectors - i, inStride, outStride );
+}
+
+
+
+
+
+//=============================================================================
+//      e3math_avx2_vector3DDot : Dot pairs of 3D vectors, 8 at a time.
+//-----------------------------------------------------------------------------
+static Q3_TARGET_AVX2 void
+e3math_avx2_vector3DDot(const TQ3Vector3D *inFirstVectors, const TQ3Vector3D *inSecondVectors,
+						float *outDotProducts, TQ3Boolean *outDotLessThanZeros,
+						TQ3Uns32 numVectors, TQ3Uns32 inStride,
+						TQ3Uns32 outDotProductStride, TQ3Uns32 outDotLessThanZeroStride)
+{	float			theDots[8];
+	__m256			theDot;
+	TQ3Uns32		i = 0;
+
+
+
+	if (e3math_avx2_can_gather( inStride ))
+		{
+		const __m256i theOffsets = e3math_avx2_offsets( inStride );
+
+		for (; i + 8 <= numVectors; i += 8)
+			{
+			#define GATHER(_v, _c)	_mm256_i32gather_ps( &(_v)->_c, theOffsets, 1 )
+			theDot = _mm256_add_ps( _mm256_mul_ps( GATHER(inFirstVectors, x), GATHER(inSecondVectors, x) ),
+									_mm256_mul_ps( GATHER(inFirstVectors, y), GATHER(inSecondVectors, y) ) );
+			theDot = _mm256_add_ps( theDot,
+									_mm256_mul_ps( GATHER(inFirstVectors, z), GATHER(inSecondVectors, z) ) );
+			#undef GATHER
+			_mm256_storeu_ps( theDots, theDot );
+
+			e3math_store_dots( theDots, 8, outDotProducts, outDotLessThanZeros,
+								outDotProductStride, outDotLessThanZeroStride );
+
+			AdvanceConstPointer( inFirstVectors, 8 * inStride );
+			AdvanceConstPointer( inSecondVectors, 8 * inStride );
+			}
+		}
+
+	e3math_sse2_vector3DDot( inFirstVectors, inSecondVectors, outDotProducts, outDotLessThanZeros,
+							numVectors - i, inStride, outDotProductStride, outDotLessThanZeroStride );
+}
+
+
+
+
+
+//=============================================================================
+//      e3math_avx2_triangleNormals : Calculate triangle normals, 8 at a time.
+//-----------------------------------------------------------------------------
+static Q3_TARGET_AVX2 void
+e3math_avx2_triangleNormals(TQ3Uns32 numTriangles, const TQ3Uns8 *usageFlags,
+							const TQ3Uns32 *theIndices, const TQ3Point3D *thePoints,
+							TQ3Vector3D *theNormals)
+{	const __m256i	theCorners = _mm256_setr_epi32( 0, 3, 6, 9, 12, 15, 18, 21 );
+	const __m256i	theThree   = _mm256_set1_epi32( 3 );
+	const float		*theFloats = &thePoints->x;
+	__m256i			i1, i2, i3;
+	__m256			v1x, v1y, v1z, v2x, v2y, v2z;
+	__m256			nx, ny, nz, theLength;
+	float			outX[8], outY[8], outZ[8];
+	TQ3Uns32		i;
+
+
+
+	for (i = 0; i + 8 <= numTriangles; i += 8)
+		{
+		// Float offsets of the corners of eight triangles
+		const int *firstIndex = (const int *) &theIndices[i * 3];
+		i1 = _mm256_mullo_epi32( _mm256_i32gather_epi32( firstIndex + 0, theCorners, 4 ), theThree );
+		i2 = _mm256_mullo_epi32( _mm256_i32gather_epi32( firstIndex + 1, theCorners, 4 ), theThree );
+		i3 = _mm256_mullo_epi32( _mm256_i32gather_epi32( firstIndex + 2, theCorners, 4 ), theThree );
+
+		#define GATHER(_i, _c)	_mm256_i32gather_ps( theFloats + _c, _i, 4 )
+		v1x = _mm256_sub_ps( GATHER(i2, 0), GATHER(i1, 0) );
+		v1y = _mm256_sub_ps( GATHER(i2, 1), GATHER(i1, 1) );
+		v1z = _mm256_sub_ps( GATHER(i2, 2), GATHER(i1, 2) );
+		v2x = _mm256_sub_ps( GATHER(i3, 0), GATHER(i2, 0) );
+		v2y = _mm256_sub_ps( GATHER(i3, 1), GATHER(i2, 1) );
+		v2z = _mm256_sub_ps( GATHER(i3, 2), GATHER(i2, 2) );
+		#undef GATHER
+
+		nx = _mm256_sub_ps( _mm256_mul_ps( v1y, v2z ), _mm256_mul_ps( v1z, v2y ) );
+		ny = _mm256_sub_ps( _mm256_mul_ps( v1z, v2x ), _mm256_mul_ps( v1x, v2z ) );
+		nz = _mm256_sub_ps( _mm256_mul_ps( v1x, v2y ), _mm256_mul_ps( v1y, v2x ) );
+
+		theLength = _mm256_add_ps( _mm256_add_ps( _mm256_mul_ps( nx, nx ), _mm256_mul_ps( ny, ny ) ),
+								   _mm256_mul_ps( nz, nz ) );
+		theLength = _mm256_add_ps( _mm256_sqrt_ps( theLength ), _mm256_set1_ps( kQ3MinFloat ) );
+		theLength = _mm256_div_ps( _mm256_set1_ps( 1.0f ), theLength );
+
+		_mm256_storeu_ps( outX, _mm256_mul_ps( nx, theLength ) );
+		_mm256_storeu_ps( outY, _mm256_mul_ps( ny, theLength ) );
+		_mm256_storeu_ps( outZ, _mm256_mul_ps( nz, theLength ) );
+		e3math_store_triangle_normals( i, 8, usageFlags, outX, outY, outZ, theNormals );
+		}
+
+	e3math_triangle_normals_tail( i, numTriangles, usageFlags, theIndices, thePoints, theNormals );
+}
+
+
+
+
+
+//=============================================================================
+//      e3math_avx2_supported : Does the processor and OS support AVX2?
+//-----------------------------------------------------------------------------
+static bool
+e3math_avx2_supported(void)
+{
+#if defined(__GNUC__)
+	__builtin_cpu_init();
+	return __builtin_cpu_supports( "avx2" ) != 0;
+#else
+	int		cpuInfo[4];
+	
+	
+	
+	// AVX needs the OS to save the upper halves of the registers
+	__cpuid( cpuInfo, 1 );
+	if ((cpuInfo[2] & (1 << 27)) == 0 || (cpuInfo[2] & (1 << 28)) == 0)
+		return false;
+
+	if ((_xgetbv( 0 ) & 6) != 6)
+		return false;
+
+	__cpuidex( cpuInfo, 7, 0 );
+	return (cpuInfo[1] & (1 << 5)) != 0;
+#endif
+}
+#endif // QUESA_SIMD_AVX2
+
+
+
+
+
+#pragma mark -
+#if QUESA_SIMD_NEON
+//=============================================================================
+//      NEON kernels
+//-----------------------------------------------------------------------------
+//		Note :	vmlaq_f32 is avoided since it may be fused, and fused results
+//				would differ from the plain loops.
+//-----------------------------------------------------------------------------
+//      e3math_neon_store3 : Store the first three lanes of a vector.
+//-----------------------------------------------------------------------------
+static inline void
+e3math_neon_store3(float *outXYZ, float32x4_t theValue)
+{
+	vst1_f32( outXYZ, vget_low_f32( theValue ) );
+	vst1q_lane_f32( outXYZ + 2, theValue, 2 );
+}
+
+
+
+
+
+//=============================================================================
+//      e3math_neon_transform : Transform one point by the rows of a matrix.
+//-----------------------------------------------------------------------------
+static inline float32x4_t
+e3math_neon_transform(float x, float y, float z, const float32x4_t *theRows)
+{	float32x4_t		theResult;
+
+
+
+	theResult = vaddq_f32( vmulq_n_f32( theRows[0], x ), vmulq_n_f32( theRows[1], y ) );
+	return vaddq_f32( theResult, vmulq_n_f32( theRows[2], z ) );
+}
+
+
+
+
+
+//=============================================================================
+//      e3math_neon_point3D_to3DAffine : Transform 3D points, affine matrix.
+//-----------------------------------------------------------------------------
+static void
+e3math_neon_point3D_to3DAffine(const TQ3Point3D *inPoints, const TQ3Matrix4x4 *matrix,
+								TQ3Point3D *outPoints, TQ3Uns32 numPoints,
+								TQ3Uns32 inStride, TQ3Uns32 outStride)
+{	const float32x4_t	theRows[4] = { vld1q_f32( matrix->value[0] ), vld1q_f32( matrix->value[1] ),
+									   vld1q_f32( matrix->value[2] ), vld1q_f32( matrix->value[3] ) };
+	TQ3Uns32			i;
+
+
+
+	for (i = 0; i < numPoints; ++i)
+		{
+		e3math_neon_store3( &outPoints->x,
+							vaddq_f32( e3math_neon_transform( inPoints->x, inPoints->y, inPoints->z, theRows ),
+									   theRows[3] ) );
+
+		AdvanceConstPointer( inPoints, inStride );
+		AdvancePointer( outPoints, outStride );
+		}
+}
+
+
+
+
+
+//=============================================================================
+//      e3math_neon_point3D_to3D : Transform 3D points, projective matrix.
+//-----------------------------------------------------------------------------
+static void
+e3math_neon_point3D_to3D(const TQ3Point3D *inPoints, const TQ3Matrix4x4 *matrix,
+							TQ3Point3D *outPoints, TQ3Uns32 numPoints,
+							TQ3Uns32 inStride, TQ3Uns32 outStride)
+{	const float32x4_t	theRows[4] = { vld1q_f32( matrix->value[0] ), vld1q_f32( matrix->value[1] ),
+									   vld1q_f32( matrix->value[2] ), vld1q_f32( matrix->value[3] ) };
+	float32x4_t			theResult;
+	float				neww;
+	TQ3Uns32			i;
+
+
+
+	for (i = 0; i < numPoints; ++i)
+		{
+		theResult = vaddq_f32( e3math_neon_transform( inPoints->x, inPoints->y, inPoints->z, theRows ),
+							   theRows[3] );
+		neww      = vgetq_lane_f32( theResult, 3 );
+
+		if (neww == 0.0f)
+			{
+			e3math_post_infinite_point();
+			neww = 1.0f;
+			}
+
+		if (neww != 1.0f)
+			theResult = vmulq_n_f32( theResult, 1.0f / neww );
+
+		e3math_neon_store3( &outPoints->x, theResult );
+
+		AdvanceConstPointer( inPoints, inStride );
+		AdvancePointer( outPoints, outStride );
+		}
+}
+
+
+
+
+
+//=============================================================================
+//      e3math_neon_point3D_to4D : Transform 3D points to rational 4D points.
+//-----------------------------------------------------------------------------
+static void
+e3math_neon_point3D_to4D(const TQ3Point3D *inPoints, const TQ3Matrix4x4 *matrix,
+							TQ3RationalPoint4D *outPoints, TQ3Uns32 numPoints,
+							TQ3Uns32 inStride, TQ3Uns32 outStride)
+{	const float32x4_t	theRows[4] = { vld1q_f32( matrix->value[0] ), vld1q_f32( matrix->value[1] ),
+									   vld1q_f32( matrix->value[2] ), vld1q_f32( matrix->value[3] ) };
+	TQ3Uns32			i;
+
+
+
+	for (i = 0; i < numPoints; ++i)
+		{
+		vst1q_f32( &outPoints->x,
+				   vaddq_f32( e3math_neon_transform( inPoints->x, inPoints->y, inPoints->z, theRows ),
+							  theRows[3] ) );
+
+		AdvanceConstPointer( inPoints, inStride );
+		AdvancePointer( outPoints, outStride );
+		}
+}
+
+
+
+
+
+//=============================================================================
+//      e3math_neon_vector3D_to3D : Transform 3D vectors.
+//-----------------------------------------------------------------------------
+static void
+e3math_neon_vector3D_to3D(const TQ3Vector3D *inVectors, const TQ3Matrix4x4 *matrix,
+							TQ3Vector3D *outVectors, TQ3Uns32 numVectors,
+							TQ3Uns32 inStride, TQ3Uns32 outStride)
+{	const float32x4_t	theRows[3] = { vld1q_f32( matrix->value[0] ), vld1q_f32( matrix->value[1] ),
+									   vld1q_f32( matrix->value[2] ) };
+	TQ3Uns32			i;
+
+
+
+	for (i = 0; i < numVectors; ++i)
+		{
+		e3math_neon_store3( &outVectors->x,
+							e3math_neon_transform( inVectors->x, inVectors->y, inVectors->z, theRows ) );
+
+		AdvanceConstPointer( inVectors, inStride );
+		AdvancePointer( outVectors, outStride );
+		}
+}
+
+
+
+
+
+//=============================================================================
+//      e3math_neon_rationalPoint4D_to4D : Transform rational 4D points.
+//-----------------------------------------------------------------------------
+static void
+e3math_neon_rationalPoint4D_to4D(const TQ3RationalPoint4D *inPoints, const TQ3Matrix4x4 *matrix,
+									TQ3RationalPoint4D *outPoints, TQ3Uns32 numPoints,
+									TQ3Uns32 inStride, TQ3Uns32 outStride)
+{	const float32x4_t	theRows[4] = { vld1q_f32( matrix->value[0] ), vld1q_f32( matrix->value[1] ),
+									   vld1q_f32( matrix->value[2] ), vld1q_f32( matrix->value[3] ) };
+	TQ3Uns32			i;
+
+
+
+	for (i = 0; i < numPoints; ++i)
+		{
+		vst1q_f32( &outPoints->x,
+				   vaddq_f32( e3math_neon_transform( inPoints->x, inPoints->y, inPoints->z, theRows ),
+							  vmulq_n_f32( theRows[3], inPoints->w ) ) );
+
+		AdvanceConstPointer( inPoints, inStride );
+		AdvancePointer( outPoints, outStride );
+		}
+}
+
+
+
+
+
+//=============================================================================
+//      e3math_neon_load4 : Load one coordinate of four 3D points.
+//-----------------------------------------------------------------------------
+static inline float32x4_t
+e3math_neon_load4(const float *c0, const float *c1, const float *c2, const float *c3)
+{	float32x4_t		theResult = vdupq_n_f32( *c0 );
+
+
+
+	theResult = vsetq_lane_f32( *c1, theResult, 1 );
+	theResult = vsetq_lane_f32( *c2, theResult, 2 );
+	return vsetq_lane_f32( *c3, theResult, 3 );
+}
+
+
+
+
+
+//=============================================================================
+//      e3math_neon_vector3DDot : Dot pairs of 3D vectors, 4 at a time.
+//-----------------------------------------------------------------------------
+static void
+e3math_neon_vector3DDot(const TQ3Vector3D *inFirstVectors, const TQ3Vector3D *inSecondVectors,
+						float *outDotProducts, TQ3Boolean *outDotLessThanZeros,
+						TQ3Uns32 numVectors, TQ3Uns32 inStride,
+						TQ3Uns32 outDotProductStride, TQ3Uns32 outDotLessThanZeroStride)
+{	const TQ3Vector3D	*a[4], *b[4];
+	float				theDots[4];
+	float32x4_t			theDot;
+	TQ3Uns32			i, n;
+
+
+
+	for (i = 0; i + 4 <= numVectors; i += 4)
+		{
+		for (n = 0; n < 4; ++n)
+			{
+			a[n] = inFirstVectors;
+			b[n] = inSecondVectors;
+			AdvanceConstPointer( inFirstVectors, inStride );
+			AdvanceConstPointer( inSecondVectors, inStride );
+			}
+
+		#define LOAD4(_v, _c)	e3math_neon_load4( &_v[0]->_c, &_v[1]->_c, &_v[2]->_c, &_v[3]->_c )
+		theDot = vaddq_f32( vmulq_f32( LOAD4(a, x), LOAD4(b, x) ), vmulq_f32( LOAD4(a, y), LOAD4(b, y) ) );
+		theDot = vaddq_f32( theDot, vmulq_f32( LOAD4(a, z), LOAD4(b, z) ) );
+		#undef LOAD4
+		vst1q_f32( theDots, theDot );
+
+		e3math_store_dots( theDots, 4, outDotProducts, outDotLessThanZeros,
+							outDotProductStride, outDotLessThanZeroStride );
+		}
+
+	e3math_dot_tail( inFirstVectors, inSecondVectors, outDotProducts, outDotLessThanZeros,
+					numVectors - i, inStride, outDotProductStride, outDotLessThanZeroStride );
+}
+
+
+
+
+
+//=============================================================================
+//      e3math_neon_triangleNormals : Calculate triangle normals, 4 at a time.
+//-----------------------------------------------------------------------------
+static void
+e3math_neon_triangleNormals(TQ3Uns32 numTriangles, const TQ3Uns8 *usageFlags,
+							const TQ3Uns32 *theIndices, const TQ3Point3D *thePoints,
+							TQ3Vector3D *theNormals)
+{	const TQ3Point3D	*p1[4], *p2[4], *p3[4];
+	float32x4_t			v1x, v1y, v1z, v2x, v2y, v2z;
+	float32x4_t			nx, ny, nz, theLength;
+	float				outX[4], outY[4], outZ[4];
+	TQ3Uns32			i, n;
+
+
+
+	for (i = 0; i + 4 <= numTriangles; i += 4)
+		{
+		for (n = 0; n < 4; ++n)
+			{
+			p1[n] = &thePoints[theIndices[(i + n) * 3 + 0]];
+			p2[n] = &thePoints[theIndices[(i + n) * 3 + 1]];
+			p3[n] = &thePoints[theIndices[(i + n) * 3 + 2]];
+			}
+
+		#define LOAD4(_p, _c)	e3math_neon_load4( &_p[0]->_c, &_p[1]->_c, &_p[2]->_c, &_p[3]->_c )
+		v1x = vsubq_f32( LOAD4(p2, x), LOAD4(p1, x) );
+		v1y = vsubq_f32( LOAD4(p2, y), LOAD4(p1, y) );
+		v1z = vsubq_f32( LOAD4(p2, z), LOAD4(p1, z) );
+		v2x = vsubq_f32( LOAD4(p3, x), LOAD4(p2, x) );
+		v2y = vsubq_f32( LOAD4(p3, y), LOAD4(p2, y) );
+		v2z = vsubq_f32( LOAD4(p3, z), LOAD4(p2, z) );
+		#undef LOAD4
+
+		nx = vsubq_f32( vmulq_f32( v1y, v2z ), vmulq_f32( v1z, v2y ) );
+		ny = vsubq_f32( vmulq_f32( v1z, v2x ), vmulq_f32( v1x, v2z ) );
+		nz = vsubq_f32( vmulq_f32( v1x, v2y ), vmulq_f32( v1y, v2x ) );
+
+		theLength = vaddq_f32( vaddq_f32( vmulq_f32( nx, nx ), vmulq_f32( ny, ny ) ), vmulq_f32( nz, nz ) );
+		theLength = vaddq_f32( vsqrtq_f32( theLength ), vdupq_n_f32( kQ3MinFloat ) );
+		theLength = vdivq_f32( vdupq_n_f32( 1.0f ), theLength );
+
+		vst1q_f32( outX, vmulq_f32( nx, theLength ) );
+		vst1q_f32( outY, vmulq_f32( ny, theLength ) );
+		vst1q_f32( outZ, vmulq_f32( nz, theLength ) );
+		e3math_store_triangle_normals( i, 4, usageFlags, outX, outY, outZ, theNormals );
+		}
+
+	e3math_triangle_normals_tail( i, numTriangles, usageFlags, theIndices, thePoints, theNormals );
+}
+
+
+//=============================================================================
+//      e3math_neon_matrix4x4Multiply : Multiply pairs of 4x4 matrices.
+//-----------------------------------------------------------------------------
+//		Note :	Both matrices are loaded before the result is stored, so the
+//				result may be the same as either input.
+//-----------------------------------------------------------------------------
+static void
+e3math_neon_matrix4x4Multiply(const TQ3Matrix4x4 *inMatrices1, const TQ3Matrix4x4 *inMatrices2,
+								TQ3Matrix4x4 *outMatrices, TQ3Uns32 numMatrices,
+								TQ3Uns32 inStride1, TQ3Uns32 inStride2, TQ3Uns32 outStride)
+{	float32x4_t		a[4], b[4], theRow;
+	TQ3Uns32		i, r;
+
+
+
+	for (i = 0; i < numMatrices; ++i)
+		{
+		for (r = 0; r < 4; ++r)
+			{
+			a[r] = vld1q_f32( inMatrices1->value[r] );
+			b[r] = vld1q_f32( inMatrices2->value[r] );
+			}
+
+		for (r = 0; r < 4; ++r)
+			{
+			theRow = vaddq_f32( vmulq_laneq_f32( b[0], a[r], 0 ), vmulq_laneq_f32( b[1], a[r], 1 ) );
+			theRow = vaddq_f32( theRow, vmulq_laneq_f32( b[2], a[r], 2 ) );
+			theRow = vaddq_f32( theRow, vmulq_laneq_f32( b[3], a[r], 3 ) );
+			vst1q_f32( outMatrices->value[r], theRow );
+			}
+
+		AdvanceConstPointer( inMatrices1, inStride1 );
+		AdvanceConstPointer( inMatrices2, inStride2 );
+		AdvancePointer( outMatrices, outStride );
+		}
+}
+
+
+
+
+
+//=============================================================================
+//      e3math_neon_transpose4 : Transpose four vectors.
+//-----------------------------------------------------------------------------
+static inline void
+e3math_neon_transpose4(float32x4_t &a, float32x4_t &b, float32x4_t &c, float32x4_t &d)
+{	const float32x4x2_t	ab = vtrnq_f32( a, b );
+	const float32x4x2_t	cd = vtrnq_f32( c, d );
+
+
+
+	a = vcombine_f32( vget_low_f32(  ab.val[0] ), vget_low_f32(  cd.val[0] ) );
+	b = vcombine_f32( vget_low_f32(  ab.val[1] ), vget_low_f32(  cd.val[1] ) );
+	c = vcombine_f32( vget_high_f32( ab.val[0] ), vget_high_f32( cd.val[0] ) );
+	d = vcombine_f32( vget_high_f32( ab.val[1] ), vget_high_f32( cd.val[1] ) );
+}
+
+
+
+
+
+//=============================================================================
+//      e3math_neon_quaternionInterpolateFast : Interpolate quaternions, 4 at
+//				a time.
+//-----------------------------------------------------------------------------
+//		Note :	The de-interleaving loads give us w, x, y and z vectors
+//				directly, so the normalization needs no horizontal adds.
+//-----------------------------------------------------------------------------
+static void
+e3math_neon_quaternionInterpolateFast(const TQ3Quaternion *q1, const TQ3Quaternion *q2,
+										const float *t, TQ3Quaternion *results,
+										TQ3Uns32 numQuaternions)
+{	const float32x4_t	theOne = vdupq_n_f32( 1.0f );
+	float32x4x4_t		a, b;
+	float32x4_t			theT, theT1, theDot, theFactor;
+	TQ3Uns32			i, n;
+
+
+
+	for (i = 0; i + 4 <= numQuaternions; i += 4)
+		{
+		a = vld4q_f32( &q1[i].w );
+		b = vld4q_f32( &q2[i].w );
+
+		theT  = vld1q_f32( t + i );
+		theT1 = vsubq_f32( theOne, theT );
+		for (n = 0; n < 4; ++n)
+			a.val[n] = vaddq_f32( vmulq_f32( a.val[n], theT1 ), vmulq_f32( b.val[n], theT ) );
+
+		theDot = vaddq_f32( vmulq_f32( a.val[0], a.val[0] ), vmulq_f32( a.val[1], a.val[1] ) );
+		theDot = vaddq_f32( theDot, vmulq_f32( a.val[2], a.val[2] ) );
+		theDot = vaddq_f32( theDot, vmulq_f32( a.val[3], a.val[3] ) );
+		theFactor = vdivq_f32( theOne, vsqrtq_f32( theDot ) );
+		for (n = 0; n < 4; ++n)
+			a.val[n] = vmulq_f32( a.val[n], theFactor );
+
+		vst4q_f32( &results[i].w, a );
+		}
+}
+
+
+
+
+
+//=============================================================================
+//      e3math_neon_quaternionToMatrix : Build matrices from quaternions,
+//				4 at a time.
+//-----------------------------------------------------------------------------
+static void
+e3math_neon_quaternionToMatrix(const TQ3Quaternion *quaternions, const TQ3Vector3D *scales,
+								const TQ3Vector3D *translations, TQ3Matrix4x4 *outMatrices,
+								TQ3Uns32 numMatrices)
+{	const float32x4_t	theOne = vdupq_n_f32( 1.0f );
+	float32x4x4_t		q;
+	float32x4x3_t		theScales;
+	float32x4_t			x2, y2, z2;
+	float32x4_t			xx, xy, xz, yy, yz, zz, wx, wy, wz;
+	float32x4_t			theRows[3][4];
+	TQ3Uns32			i, n, r, c;
+
+
+
+	for (i = 0; i + 4 <= numMatrices; i += 4)
+		{
+		q = vld4q_f32( &quaternions[i].w );
+
+		x2 = vaddq_f32( q.val[1], q.val[1] );
+		y2 = vaddq_f32( q.val[2], q.val[2] );
+		z2 = vaddq_f32( q.val[3], q.val[3] );
+		xx = vmulq_f32( q.val[1], x2 );
+		xy = vmulq_f32( q.val[1], y2 );
+		xz = vmulq_f32( q.val[1], z2 );
+		yy = vmulq_f32( q.val[2], y2 );
+		yz = vmulq_f32( q.val[2], z2 );
+		zz = vmulq_f32( q.val[3], z2 );
+		wx = vmulq_f32( q.val[0], x2 );
+		wy = vmulq_f32( q.val[0], y2 );
+		wz = vmulq_f32( q.val[0], z2 );
+
+		theRows[0][0] = vsubq_f32( theOne, vaddq_f32( yy, zz ) );
+		theRows[0][1] = vaddq_f32( xy, wz );
+		theRows[0][2] = vsubq_f32( xz, wy );
+		theRows[1][0] = vsubq_f32( xy, wz );
+		theRows[1][1] = vsubq_f32( theOne, vaddq_f32( xx, zz ) );
+		theRows[1][2] = vaddq_f32( yz, wx );
+		theRows[2][0] = vaddq_f32( xz, wy );
+		theRows[2][1] = vsubq_f32( yz, wx );
+		theRows[2][2] = vsubq_f32( theOne, vaddq_f32( xx, yy ) );
+
+		if (scales != nullptr)
+			{
+			theScales = vld3q_f32( &scales[i].x );
+			for (r = 0; r < 3; ++r)
+				for (c = 0; c < 3; ++c)
+					theRows[r][c] = vmulq_f32( theRows[r][c], theScales.val[r] );
+			}
+
+		for (r = 0; r < 3; ++r)
+			{
+			theRows[r][3] = vdupq_n_f32( 0.0f );
+			e3math_neon_transpose4( theRows[r][0], theRows[r][1], theRows[r][2], theRows[r][3] );
+			for (n = 0; n < 4; ++n)
+				vst1q_f32( outMatrices[i + n].value[r], theRows[r][n] );
+			}
+
+		for (n = 0; n < 4; ++n)
+			{
+			outMatrices[i + n].value[3][0] = (translations != nullptr) ? translations[i + n].x : 0.0f;
+			outMatrices[i + n].value[3][1] = (translations != nullptr) ? translations[i + n].y : 0.0f;
+			outMatrices[i + n].value[3][2] = (translations != nullptr) ? translations[i + n].z : 0.0f;
+			outMatrices[i + n].value[3][3] = 1.0f;
+			}
+		}
+}
+#endif // QUESA_SIMD_NEON
+
+
+
+
+
+//=============================================================================
+//      Internal variables
+//-----------------------------------------------------------------------------
+#pragma mark -
+static const E3MathKernels sScalarKernels = {
+	kQ3MathKernelSetScalar,
+	nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+	nullptr, nullptr
+};
+
+#if QUESA_SIMD_SSE2
+static const E3MathKernels sSSE2Kernels = {
+	kQ3MathKernelSetSSE2,
+	e3math_sse2_point3D_to3DAffine,
+	e3math_sse2_point3D_to3D,
+	e3math_sse2_point3D_to4D,
+	e3math_sse2_vector3D_to3D,
+	e3math_sse2_rationalPoint4D_to4D,
+	e3math_sse2_vector3DDot,
+	e3math_sse2_triangleNormals,
+	e3math_sse2_matrix4x4Multiply,
+	e3math_sse2_quaternionInterpolateFast,
+	e3math_sse2_quaternionToMatrix
+};
+#endif
+
+#if QUESA_SIMD_AVX2
+// Rational 4D points, matrices and quaternions need no gathers, so they use the
+// SSE2 kernels
+static const E3MathKernels sAVX2Kernels = {
+	kQ3MathKernelSetAVX2,
+	e3math_avx2_point3D_to3DAffine,
+	e3math_avx2_point3D_to3D,
+	e3math_avx2_point3D_to4D,
+	e3math_avx2_vector3D_to3D,
+	e3math_sse2_rationalPoint4D_to4D,
+	e3math_avx2_vector3DDot,
+	e3math_avx2_triangleNormals,
+	e3math_sse2_matrix4x4Multiply,
+	e3math_sse2_quaternionInterpolateFast,
+	e3math_sse2_quaternionToMatrix
+};
+#endif
+
+#if QUESA_SIMD_NEON
+static const E3MathKernels sNEONKernels = {
+	kQ3MathKernelSetNEON,
+	e3math_neon_point3D_to3DAffine,
+	e3math_neon_point3D_to3D,
+	e3math_neon_point3D_to4D,
+	e3math_neon_vector3D_to3D,
+	e3math_neon_rationalPoint4D_to4D,
+	e3math_neon_vector3DDot,
+	e3math_neon_triangleNormals,
+	e3math_neon_matrix4x4Multiply,
+	e3math_neon_quaternionInterpolateFast,
+	e3math_neon_quaternionToMatrix
+};
+#endif
+
+static std::atomic<const E3MathKernels*> sSelectedKernels( nullptr );
+
+
+
+
+
+//=============================================================================
+//      e3math_find_kernels : Find the kernels for a kernel set.
+//-----------------------------------------------------------------------------
+//		Note :	Returns nullptr if the build or the processor lacks them.
+//-----------------------------------------------------------------------------
+static const E3MathKernels *
+e3math_find_kernels(TQ3MathKernelSet kernelSet)
+{
+	switch (kernelSet)
+		{
+		case kQ3MathKernelSetAutomatic:
+#if QUESA_SIMD_AVX2
+			if (e3math_avx2_supported())
+				return &sAVX2Kernels;
+#endif
+#if QUESA_SIMD_SSE2
+			return &sSSE2Kernels;
+#elif QUESA_SIMD_NEON
+			return &sNEONKernels;
+#else
+			return &sScalarKernels;
+#endif
+
+		case kQ3MathKernelSetScalar:
+			return &sScalarKernels;
+
+#if QUESA_SIMD_SSE2
+		case kQ3MathKernelSetSSE2:
+			return &sSSE2Kernels;
+#endif
+
+#if QUESA_SIMD_AVX2
+		case kQ3MathKernelSetAVX2:
+			return e3math_avx2_supported() ? &sAVX2Kernels : nullptr;
+#endif
+
+#if QUESA_SIMD_NEON
+		case kQ3MathKernelSetNEON:
+			return &sNEONKernels;
+#endif
+
+		default:
+			return nullptr;
+		}
+}
+
+
+
+
+
+//=============================================================================
+//      Public functions
+//-----------------------------------------------------------------------------
+//      E3MathKernels_Get : Get the kernels used by the array functions.
+//-----------------------------------------------------------------------------
+#pragma mark -
+const E3MathKernels&
+E3MathKernels_Get(void)
+{	const E3MathKernels		*theKernels = sSelectedKernels.load( std::memory_order_acquire );
+
+
+
+	// Choose the automatic set the first time through
+	if (theKernels == nullptr)
+		{
+		theKernels = e3math_find_kernels( kQ3MathKernelSetAutomatic );
+		sSelectedKernels.store( theKernels, std::memory_order_release );
+		}
+
+	return *theKernels;
+}
+
+
+
+
+
+//=============================================================================
+//      E3MathKernels_Select : Choose the kernels used by the array functions.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3MathKernels_Select(TQ3MathKernelSet kernelSet)
+{	const E3MathKernels		*theKernels = e3math_find_kernels( kernelSet );
+
+
+
+	if (theKernels == nullptr)
+		return kQ3Failure;
+
+	sSelectedKernels.store( theKernels, std::memory_order_release );
+	return kQ3Success;
+}
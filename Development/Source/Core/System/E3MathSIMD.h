@@ -0,0 +1,107 @@
+/*  NAME:
+        E3MathSIMD.h
+
+    DESCRIPTION:
+        Header file for E3MathSIMD.cpp.
+
+    COPYRIGHT:
+        Copyright (c) 2025, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+#ifndef E3MATHSIMD_HDR
+#define E3MATHSIMD_HDR
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "QuesaMath.h"
+
+
+
+
+
+//=============================================================================
+//      Types
+//-----------------------------------------------------------------------------
+// Vector implementations of the array functions in E3Math.cpp. Strides are
+// in bytes, as for the public functions. A nullptr entry means the plain loop
+// in E3Math.cpp is used. The quaternion kernels take contiguous arrays and only
+// handle whole groups of four, leaving the rest to the plain loop.
+typedef struct E3MathKernels {
+	TQ3MathKernelSet	kernelSet;
+
+	void				(*point3DTo3DAffine)(const TQ3Point3D *inPoints, const TQ3Matrix4x4 *matrix,
+											TQ3Point3D *outPoints, TQ3Uns32 numPoints,
+											TQ3Uns32 inStride, TQ3Uns32 outStride);
+	void				(*point3DTo3D)(const TQ3Point3D *inPoints, const TQ3Matrix4x4 *matrix,
+											TQ3Point3D *outPoints, TQ3Uns32 numPoints,
+											TQ3Uns32 inStride, TQ3Uns32 outStride);
+	void				(*point3DTo4D)(const TQ3Point3D *inPoints, const TQ3Matrix4x4 *matrix,
+											TQ3RationalPoint4D *outPoints, TQ3Uns32 numPoints,
+											TQ3Uns32 inStride, TQ3Uns32 outStride);
+	void				(*vector3DTo3D)(const TQ3Vector3D *inVectors, const TQ3Matrix4x4 *matrix,
+											TQ3Vector3D *outVectors, TQ3Uns32 numVectors,
+											TQ3Uns32 inStride, TQ3Uns32 outStride);
+	void				(*rationalPoint4DTo4D)(const TQ3RationalPoint4D *inPoints, const TQ3Matrix4x4 *matrix,
+											TQ3RationalPoint4D *outPoints, TQ3Uns32 numPoints,
+											TQ3Uns32 inStride, TQ3Uns32 outStride);
+	void				(*vector3DDot)(const TQ3Vector3D *inFirstVectors, const TQ3Vector3D *inSecondVectors,
+											float *outDotProducts, TQ3Boolean *outDotLessThanZeros,
+											TQ3Uns32 numVectors, TQ3Uns32 inStride,
+											TQ3Uns32 outDotProductStride, TQ3Uns32 outDotLessThanZeroStride);
+	void				(*triangleNormals)(TQ3Uns32 numTriangles, const TQ3Uns8 *usageFlags,
+											const TQ3Uns32 *theIndices, const TQ3Point3D *thePoints,
+											TQ3Vector3D *theNormals);
+	void				(*matrix4x4Multiply)(const TQ3Matrix4x4 *inMatrices1, const TQ3Matrix4x4 *inMatrices2,
+											TQ3Matrix4x4 *outMatrices, TQ3Uns32 numMatrices,
+											TQ3Uns32 inStride1, TQ3Uns32 inStride2, TQ3Uns32 outStride);
+	void				(*quaternionInterpolateFast)(const TQ3Quaternion *q1, const TQ3Quaternion *q2,
+											const float *t, TQ3Quaternion *results,
+											TQ3Uns32 numQuaternions);
+	void				(*quaternionToMatrix)(const TQ3Quaternion *quaternions, const TQ3Vector3D *scales,
+											const TQ3Vector3D *translations, TQ3Matrix4x4 *outMatrices,
+											TQ3Uns32 numMatrices);
+} E3MathKernels;
+
+
+
+
+
+//=============================================================================
+//      Function prototypes
+//-----------------------------------------------------------------------------
+const E3MathKernels&	E3MathKernels_Get(void);
+TQ3Status				E3MathKernels_Select(TQ3MathKernelSet kernelSet);
+
+#endif
@@ -0,0 +1,592 @@
+/*  NAME:
+        E3MathSoA.cpp
+
+    DESCRIPTION:
+        Operations on points stored as separate coordinate arrays.
+        
+        Points are processed four at a time. The arithmetic is done in the
+        same order as the corresponding functions on TQ3Point3D, so the
+        results are the same.
+
+    COPYRIGHT:
+        Copyright (c) 2025, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "E3Prefix.h"
+#include "E3MathSoA.h"
+#include "E3SIMD.h"
+
+#include <algorithm>
+#include <cstdint>
+
+
+
+
+
+//=============================================================================
+//      Internal constants
+//-----------------------------------------------------------------------------
+// Alignment of the coordinate arrays, enough for 8-wide vectors
+const TQ3Uns32 kSoAAlignment									= 32;
+const TQ3Uns32 kSoAFloatsPerBlock								= kSoAAlignment / sizeof(float);
+
+
+
+
+
+//=============================================================================
+//      Internal functions
+//-----------------------------------------------------------------------------
+//      e3soa_load : Load up to four floats, padding with zeros.
+//-----------------------------------------------------------------------------
+static inline E3Float4
+e3soa_load(const float *inFloats, TQ3Uns32 numFloats)
+{	float		thePadded[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+
+
+	if (numFloats == 4)
+		return E3Float4_Load( inFloats );
+
+	std::copy( inFloats, inFloats + numFloats, thePadded );
+	return E3Float4_Load( thePadded );
+}
+
+
+
+
+
+//=============================================================================
+//      e3soa_store : Store up to four floats.
+//-----------------------------------------------------------------------------
+static inline void
+e3soa_store(float *outFloats, E3Float4 theValue, TQ3Uns32 numFloats)
+{	float		thePadded[4];
+
+
+
+	if (numFloats == 4)
+		E3Float4_Store( outFloats, theValue );
+	else
+		{
+		E3Float4_Store( thePadded, theValue );
+		std::copy( thePadded, thePadded + numFloats, outFloats );
+		}
+}
+
+
+
+
+
+//=============================================================================
+//      e3soa_is_affine : Is the last column of a matrix (0, 0, 0, 1)?
+//-----------------------------------------------------------------------------
+static inline bool
+e3soa_is_affine(const TQ3Matrix4x4 &theMatrix)
+{
+	return (theMatrix.value[3][3] == 1.0f) && (theMatrix.value[0][3] == 0.0f) &&
+		   (theMatrix.value[1][3] == 0.0f) && (theMatrix.value[2][3] == 0.0f);
+}
+
+
+
+
+
+//=============================================================================
+//      e3soa_transform_block : Transform up to four points.
+//-----------------------------------------------------------------------------
+//		Note :	As in E3Point3D_Transform, a point mapped to w = 0 posts an
+//				error and is left undivided. Dividing by w = 1 is skipped
+//				there, but multiplying by 1 gives the same result here.
+//-----------------------------------------------------------------------------
+static inline void
+e3soa_transform_block(const TQ3Matrix4x4 &theMatrix, bool isAffine, bool isPoint,
+						E3Float4 &ioX, E3Float4 &ioY, E3Float4 &ioZ, TQ3Uns32 numValid)
+{	E3Float4		theResults[4];
+	TQ3Uns32		theCol, n, zeroMask;
+
+
+
+	for (theCol = 0; theCol < (isAffine ? 3U : 4U); ++theCol)
+		{
+		#define M(_r)	E3Float4_Splat( theMatrix.value[_r][theCol] )
+		theResults[theCol] = E3Float4_Add( E3Float4_Mul( ioX, M(0) ), E3Float4_Mul( ioY, M(1) ) );
+		theResults[theCol] = E3Float4_Add( theResults[theCol], E3Float4_Mul( ioZ, M(2) ) );
+		if (isPoint)
+			theResults[theCol] = E3Float4_Add( theResults[theCol], M(3) );
+		#undef M
+		}
+
+	if (! isAffine)
+		{
+		zeroMask = E3Float4_EqualMask( theResults[3], E3Float4_Splat( 0.0f ) ) &
+				   ((1U << numValid) - 1U);
+		
+		if (zeroMask != 0)
+			{
+			float	theW[4];
+			
+			E3Float4_Store( theW, theResults[3] );
+			for (n = 0; n < numValid; ++n)
+				{
+				if ((zeroMask & (1U << n)) != 0)
+					{
+					E3ErrorManager_PostError( kQ3ErrorInfiniteRationalPoint, kQ3False );
+					theW[n] = 1.0f;
+					}
+				}
+			theResults[3] = E3Float4_Load( theW );
+			}
+
+		theResults[3] = E3Float4_Div( E3Float4_Splat( 1.0f ), theResults[3] );
+		theResults[0] = E3Float4_Mul( theResults[0], theResults[3] );
+		theResults[1] = E3Float4_Mul( theResults[1], theResults[3] );
+		theResults[2] = E3Float4_Mul( theResults[2], theResults[3] );
+		}
+
+	ioX = theResults[0];
+	ioY = theResults[1];
+	ioZ = theResults[2];
+}
+
+
+
+
+
+//=============================================================================
+//      e3soa_transform : Transform points or vectors.
+//-----------------------------------------------------------------------------
+static void
+e3soa_transform(const TQ3Point3DArraySoA &inArray, const TQ3Matrix4x4 &theMatrix,
+				const TQ3Point3DArraySoA &outArray, bool isPoint)
+{	const bool		isAffine = (! isPoint) || e3soa_is_affine( theMatrix );
+	E3Float4		x, y, z;
+	TQ3Uns32		i, n;
+
+
+
+	for (i = 0; i < inArray.count; i += 4)
+		{
+		n = std::min( 4U, inArray.count - i );
+		x = e3soa_load( inArray.x + i, n );
+		y = e3soa_load( inArray.y + i, n );
+		z = e3soa_load( inArray.z + i, n );
+
+		e3soa_transform_block( theMatrix, isAffine, isPoint, x, y, z, n );
+
+		e3soa_store( outArray.x + i, x, n );
+		e3soa_store( outArray.y + i, y, n );
+		e3soa_store( outArray.z + i, z, n );
+		}
+}
+
+
+
+
+
+//=============================================================================
+//      Public functions
+//-----------------------------------------------------------------------------
+//      E3Point3DArraySoA_Allocate : Allocate coordinate arrays.
+//-----------------------------------------------------------------------------
+#pragma mark -
+TQ3Status
+E3Point3DArraySoA_Allocate(TQ3Uns32 numPoints, TQ3Point3DArraySoA *outArray)
+{	TQ3Uns32	thePadded = (numPoints + kSoAFloatsPerBlock - 1) & ~(kSoAFloatsPerBlock - 1);
+	uintptr_t	theAddress;
+
+
+
+	// Allocate one block for all three arrays, with room to align it
+	Q3Memory_Clear( outArray, sizeof(TQ3Point3DArraySoA) );
+	if (numPoints == 0)
+		return(kQ3Success);
+
+	outArray->storage = Q3Memory_Allocate( 3 * thePadded * sizeof(float) + kSoAAlignment );
+	if (outArray->storage == nullptr)
+		return(kQ3Failure);
+
+	theAddress = ((uintptr_t) outArray->storage + kSoAAlignment - 1) & ~((uintptr_t) kSoAAlignment - 1);
+	outArray->x     = (float *) theAddress;
+	outArray->y     = outArray->x + thePadded;
+	outArray->z     = outArray->y + thePadded;
+	outArray->count = numPoints;
+
+	return(kQ3Success);
+}
+
+
+
+
+
+//=============================================================================
+//      E3Point3DArraySoA_Free : Release coordinate arrays.
+//-----------------------------------------------------------------------------
+void
+E3Point3DArraySoA_Free(TQ3Point3DArraySoA *ioArray)
+{
+	Q3Memory_Free( &ioArray->storage );
+	Q3Memory_Clear( ioArray, sizeof(TQ3Point3DArraySoA) );
+}
+
+
+
+
+
+//=============================================================================
+//      E3Point3DArraySoA_SetFromPoints3D : Copy points into coordinate arrays.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3Point3DArraySoA_SetFromPoints3D(const TQ3Point3D *inPoints, TQ3Uns32 inStructSize,
+									const TQ3Point3DArraySoA *ioArray)
+{	const char		*in = (const char *) inPoints;
+	TQ3Uns32		i;
+
+
+
+	for (i = 0; i < ioArray->count; ++i)
+		{
+		const TQ3Point3D *thePoint = (const TQ3Point3D *) (const void *) in;
+		ioArray->x[i] = thePoint->x;
+		ioArray->y[i] = thePoint->y;
+		ioArray->z[i] = thePoint->z;
+		in += inStructSize;
+		}
+
+	return(kQ3Success);
+}
+
+
+
+
+
+//=============================================================================
+//      E3Point3DArraySoA_GetPoints3D : Copy coordinate arrays into points.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3Point3DArraySoA_GetPoints3D(const TQ3Point3DArraySoA *inArray, TQ3Point3D *outPoints,
+								TQ3Uns32 outStructSize)
+{	char			*out = (char *) outPoints;
+	TQ3Uns32		i;
+
+
+
+	for (i = 0; i < inArray->count; ++i)
+		{
+		TQ3Point3D *thePoint = (TQ3Point3D *) (void *) out;
+		thePoint->x = inArray->x[i];
+		thePoint->y = inArray->y[i];
+		thePoint->z = inArray->z[i];
+		out += outStructSize;
+		}
+
+	return(kQ3Success);
+}
+
+
+
+
+
+//=============================================================================
+//      E3Point3DArraySoA_TransformPoints : Transform points.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3Point3DArraySoA_TransformPoints(const TQ3Point3DArraySoA *inArray, const TQ3Matrix4x4 *matrix4x4,
+									const TQ3Point3DArraySoA *outArray)
+{
+	e3soa_transform( *inArray, *matrix4x4, *outArray, true );
+	return(kQ3Success);
+}
+
+
+
+
+
+//=============================================================================
+//      E3Point3DArraySoA_TransformVectors : Transform vectors.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3Point3DArraySoA_TransformVectors(const TQ3Point3DArraySoA *inArray, const TQ3Matrix4x4 *matrix4x4,
+									const TQ3Point3DArraySoA *outArray)
+{
+	e3soa_transform( *inArray, *matrix4x4, *outArray, false );
+	return(kQ3Success);
+}
+
+
+
+
+
+//=============================================================================
+//      E3Point3DArraySoA_ProjectTo2D : Transform points and keep x and y.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3Point3DArraySoA_ProjectTo2D(const TQ3Point3DArraySoA *inArray, const TQ3Matrix4x4 *matrix4x4,
+								TQ3Point2D *outPoints, TQ3Uns32 outStructSize)
+{	const bool		isAffine = e3soa_is_affine( *matrix4x4 );
+	char			*out = (char *) outPoints;
+	float			outX[4], outY[4];
+	E3Float4		x, y, z;
+	TQ3Uns32		i, j, n;
+
+
+
+	for (i = 0; i < inArray->count; i += 4)
+		{
+		n = std::min( 4U, inArray->count - i );
+		x = e3soa_load( inArray->x + i, n );
+		y = e3soa_load( inArray->y + i, n );
+		z = e3soa_load( inArray->z + i, n );
+
+		e3soa_transform_block( *matrix4x4, isAffine, true, x, y, z, n );
+
+		E3Float4_Store( outX, x );
+		E3Float4_Store( outY, y );
+		for (j = 0; j < n; ++j)
+			{
+			TQ3Point2D *thePoint = (TQ3Point2D *) (void *) out;
+			thePoint->x = outX[j];
+			thePoint->y = outY[j];
+			out += outStructSize;
+			}
+		}
+
+	return(kQ3Success);
+}
+
+
+
+
+
+//=============================================================================
+//      E3Point3DArraySoA_Normalize : Normalize vectors.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3Point3DArraySoA_Normalize(const TQ3Point3DArraySoA *inArray, const TQ3Point3DArraySoA *outArray)
+{	const E3Float4	theMinFloat = E3Float4_Splat( kQ3MinFloat );
+	const E3Float4	theOne      = E3Float4_Splat( 1.0f );
+	E3Float4		x, y, z, theScale;
+	TQ3Uns32		i, n;
+
+
+
+	for (i = 0; i < inArray->count; i += 4)
+		{
+		n = std::min( 4U, inArray->count - i );
+		x = e3soa_load( inArray->x + i, n );
+		y = e3soa_load( inArray->y + i, n );
+		z = e3soa_load( inArray->z + i, n );
+
+		theScale = E3Float4_Add( E3Float4_Add( E3Float4_Mul( x, x ), E3Float4_Mul( y, y ) ),
+								 E3Float4_Mul( z, z ) );
+		theScale = E3Float4_Add( E3Float4_Sqrt( theScale ), theMinFloat );
+		theScale = E3Float4_Div( theOne, theScale );
+
+		e3soa_store( outArray->x + i, E3Float4_Mul( x, theScale ), n );
+		e3soa_store( outArray->y + i, E3Float4_Mul( y, theScale ), n );
+		e3soa_store( outArray->z + i, E3Float4_Mul( z, theScale ), n );
+		}
+
+	return(kQ3Success);
+}
+
+
+
+
+
+//=============================================================================
+//      E3Point3DArraySoA_Dot : Dot products of pairs of vectors.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3Point3DArraySoA_Dot(const TQ3Point3DArraySoA *inArray1, const TQ3Point3DArraySoA *inArray2,
+						float *outDotProducts)
+{	E3Float4		theDot;
+	TQ3Uns32		i, n;
+
+
+
+	for (i = 0; i < inArray1->count; i += 4)
+		{
+		n = std::min( 4U, inArray1->count - i );
+		theDot = E3Float4_Add( E3Float4_Mul( e3soa_load( inArray1->x + i, n ), e3soa_load( inArray2->x + i, n ) ),
+							   E3Float4_Mul( e3soa_load( inArray1->y + i, n ), e3soa_load( inArray2->y + i, n ) ) );
+		theDot = E3Float4_Add( theDot,
+							   E3Float4_Mul( e3soa_load( inArray1->z + i, n ), e3soa_load( inArray2->z + i, n ) ) );
+		e3soa_store( outDotProducts + i, theDot, n );
+		}
+
+	return(kQ3Success);
+}
+
+
+
+
+
+//=============================================================================
+//      E3Point3DArraySoA_Cross : Cross products of pairs of vectors.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3Point3DArraySoA_Cross(const TQ3Point3DArraySoA *inArray1, const TQ3Point3DArraySoA *inArray2,
+						const TQ3Point3DArraySoA *outArray)
+{	E3Float4		x1, y1, z1, x2, y2, z2;
+	TQ3Uns32		i, n;
+
+
+
+	for (i = 0; i < inArray1->count; i += 4)
+		{
+		n  = std::min( 4U, inArray1->count - i );
+		x1 = e3soa_load( inArray1->x + i, n );
+		y1 = e3soa_load( inArray1->y + i, n );
+		z1 = e3soa_load( inArray1->z + i, n );
+		x2 = e3soa_load( inArray2->x + i, n );
+		y2 = e3soa_load( inArray2->y + i, n );
+		z2 = e3soa_load( inArray2->z + i, n );
+
+		e3soa_store( outArray->x + i, E3Float4_Sub( E3Float4_Mul( y1, z2 ), E3Float4_Mul( z1, y2 ) ), n );
+		e3soa_store( outArray->y + i, E3Float4_Sub( E3Float4_Mul( z1, x2 ), E3Float4_Mul( x1, z2 ) ), n );
+		e3soa_store( outArray->z + i, E3Float4_Sub( E3Float4_Mul( x1, y2 ), E3Float4_Mul( y1, x2 ) ), n );
+		}
+
+	return(kQ3Success);
+}
+
+
+
+
+
+//=============================================================================
+//      E3Point3DArraySoA_DistanceToPlane : Evaluate a plane at each point.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3Point3DArraySoA_DistanceToPlane(const TQ3Point3DArraySoA *inArray, const TQ3PlaneEquation *plane,
+									float *outDistances)
+{	const E3Float4	a = E3Float4_Splat( plane->normal.x );
+	const E3Float4	b = E3Float4_Splat( plane->normal.y );
+	const E3Float4	c = E3Float4_Splat( plane->normal.z );
+	const E3Float4	d = E3Float4_Splat( plane->constant );
+	E3Float4		theDistance;
+	TQ3Uns32		i, n;
+
+
+
+	for (i = 0; i < inArray->count; i += 4)
+		{
+		n = std::min( 4U, inArray->count - i );
+		theDistance = E3Float4_Add( E3Float4_Mul( a, e3soa_load( inArray->x + i, n ) ),
+									E3Float4_Mul( b, e3soa_load( inArray->y + i, n ) ) );
+		theDistance = E3Float4_Add( theDistance, E3Float4_Mul( c, e3soa_load( inArray->z + i, n ) ) );
+		theDistance = E3Float4_Add( theDistance, d );
+		e3soa_store( outDistances + i, theDistance, n );
+		}
+
+	return(kQ3Success);
+}
+
+
+
+
+
+//=============================================================================
+//      E3Point3DArraySoA_GetBoundingBox : Find the bounds of the points.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3Point3DArraySoA_GetBoundingBox(const TQ3Point3DArraySoA *inArray, TQ3BoundingBox *outBounds)
+{	E3Float4		minX, minY, minZ, maxX, maxY, maxZ, theValue;
+	float			theLanes[4];
+	TQ3Uns32		i, n;
+
+
+
+	if (inArray->count == 0)
+		{
+		Q3FastBoundingBox_Reset( outBounds );
+		return(kQ3Success);
+		}
+
+
+
+	// Every lane starts with the first point, then takes whole blocks of four
+	minX = maxX = E3Float4_Splat( inArray->x[0] );
+	minY = maxY = E3Float4_Splat( inArray->y[0] );
+	minZ = maxZ = E3Float4_Splat( inArray->z[0] );
+
+	for (i = 0; i + 4 <= inArray->count; i += 4)
+		{
+		theValue = E3Float4_Load( inArray->x + i );
+		minX = E3Float4_Min( minX, theValue );
+		maxX = E3Float4_Max( maxX, theValue );
+		
+		theValue = E3Float4_Load( inArray->y + i );
+		minY = E3Float4_Min( minY, theValue );
+		maxY = E3Float4_Max( maxY, theValue );
+		
+		theValue = E3Float4_Load( inArray->z + i );
+		minZ = E3Float4_Min( minZ, theValue );
+		maxZ = E3Float4_Max( maxZ, theValue );
+		}
+
+
+
+	// Combine the lanes, then add the last few points
+	#define REDUCE(_vec, _out, _op)											\
+		E3Float4_Store( theLanes, _vec );									\
+		_out = _op( _op( theLanes[0], theLanes[1] ), _op( theLanes[2], theLanes[3] ) )
+
+	REDUCE( minX, outBounds->min.x, std::min );
+	REDUCE( minY, outBounds->min.y, std::min );
+	REDUCE( minZ, outBounds->min.z, std::min );
+	REDUCE( maxX, outBounds->max.x, std::max );
+	REDUCE( maxY, outBounds->max.y, std::max );
+	REDUCE( maxZ, outBounds->max.z, std::max );
+	#undef REDUCE
+
+	for (n = i; n < inArray->count; ++n)
+		{
+		outBounds->min.x = std::min( outBounds->min.x, inArray->x[n] );
+		outBounds->min.y = std::min( outBounds->min.y, inArray->y[n] );
+		outBounds->min.z = std::min( outBounds->min.z, inArray->z[n] );
+		outBounds->max.x = std::max( outBounds->max.x, inArray->x[n] );
+		outBounds->max.y = std::max( outBounds->max.y, inArray->y[n] );
+		outBounds->max.z = std::max( outBounds->max.z, inArray->z[n] );
+		}
+
+	outBounds->isEmpty = kQ3False;
+
+	return(kQ3Success);
+}
@@ -0,0 +1,92 @@
+/*  NAME:
+        E3MathSoA.h
+
+    DESCRIPTION:
+        Header file for E3MathSoA.cpp.
+
+    COPYRIGHT:
+        Copyright (c) 2025, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+#ifndef E3MATHSOA_HDR
+#define E3MATHSOA_HDR
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "QuesaMath.h"
+
+
+
+
+
+//=============================================================================
+//		C++ preamble
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+
+
+//=============================================================================
+//      Function prototypes
+//-----------------------------------------------------------------------------
+TQ3Status				E3Point3DArraySoA_Allocate(TQ3Uns32 numPoints, TQ3Point3DArraySoA *outArray);
+void					E3Point3DArraySoA_Free(TQ3Point3DArraySoA *ioArray);
+TQ3Status				E3Point3DArraySoA_SetFromPoints3D(const TQ3Point3D *inPoints, TQ3Uns32 inStructSize, const TQ3Point3DArraySoA *ioArray);
+TQ3Status				E3Point3DArraySoA_GetPoints3D(const TQ3Point3DArraySoA *inArray, TQ3Point3D *outPoints, TQ3Uns32 outStructSize);
+TQ3Status				E3Point3DArraySoA_TransformPoints(const TQ3Point3DArraySoA *inArray, const TQ3Matrix4x4 *matrix4x4, const TQ3Point3DArraySoA *outArray);
+TQ3Status				E3Point3DArraySoA_TransformVectors(const TQ3Point3DArraySoA *inArray, const TQ3Matrix4x4 *matrix4x4, const TQ3Point3DArraySoA *outArray);
+TQ3Status				E3Point3DArraySoA_ProjectTo2D(const TQ3Point3DArraySoA *inArray, const TQ3Matrix4x4 *matrix4x4, TQ3Point2D *outPoints, TQ3Uns32 outStructSize);
+TQ3Status				E3Point3DArraySoA_Normalize(const TQ3Point3DArraySoA *inArray, const TQ3Point3DArraySoA *outArray);
+TQ3Status				E3Point3DArraySoA_Dot(const TQ3Point3DArraySoA *inArray1, const TQ3Point3DArraySoA *inArray2, float *outDotProducts);
+TQ3Status				E3Point3DArraySoA_Cross(const TQ3Point3DArraySoA *inArray1, const TQ3Point3DArraySoA *inArray2, const TQ3Point3DArraySoA *outArray);
+TQ3Status				E3Point3DArraySoA_DistanceToPlane(const TQ3Point3DArraySoA *inArray, const TQ3PlaneEquation *plane, float *outDistances);
+TQ3Status				E3Point3DArraySoA_GetBoundingBox(const TQ3Point3DArraySoA *inArray, TQ3BoundingBox *outBounds);
+
+
+
+
+
+//=============================================================================
+//		C++ postamble
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -53,6 +53,8 @@
 #include "E3View.h"
 #include "QuesaMathOperators.hpp"
 #include "CQ3ObjectRef_Gets.h"
+#include "E3SIMD.h"
+#include "E3BoundingTree.h"
 
 // Remove any macro definitions of min, max, so that the C++ library versions will work.
 #undef min
@@ -61,6 +63,7 @@
 #include <limits>
 #include <algorithm>
 #include <cmath>
+#include <vector>
 
 
 
@@ -3312,3 +3315,575 @@ bool	E3BoundingBox_Intersect( const TQ3BoundingBox& inBox1,
 	
 	return outSect.isEmpty == kQ3False;
 }
+
+
+
+/*!
+	@function	StoreBoxClasses
+	@abstract	Record the classification of up to 32 consecutive boxes.
+	@param		inFirst			Index of the first box.
+	@param		inNum			Number of boxes.
+	@param		inOutsideBits	Bit n set if box inFirst + n is outside.
+	@param		inPartialBits	Bit n set if box inFirst + n is partly outside
+								some half-plane.
+	@param		outClasses		Classification array, or nullptr.
+	@param		outVisibleMask	Visibility bit array, or nullptr.
+*/
+static void StoreBoxClasses(
+							TQ3Uns32 inFirst,
+							TQ3Uns32 inNum,
+							TQ3Uns32 inOutsideBits,
+							TQ3Uns32 inPartialBits,
+							E3FrustumClass* outClasses,
+							TQ3Uns32* outVisibleMask )
+{
+	for (TQ3Uns32 n = 0; n < inNum; ++n)
+	{
+		TQ3Uns32 theBit = 1U << n;
+		TQ3Uns32 boxIndex = inFirst + n;
+		
+		if (outClasses != nullptr)
+		{
+			if ((inOutsideBits & theBit) != 0)
+				outClasses[ boxIndex ] = kE3FrustumClass_Outside;
+			else if ((inPartialBits & theBit) != 0)
+				outClasses[ boxIndex ] = kE3FrustumClass_Intersecting;
+			else
+				outClasses[ boxIndex ] = kE3FrustumClass_Inside;
+		}
+		
+		if ( (outVisibleMask != nullptr) && ((inOutsideBits & theBit) == 0) )
+		{
+			outVisibleMask[ boxIndex / 32 ] |= 1U << (boxIndex % 32);
+		}
+	}
+}
+
+
+/*!
+	@function	E3BoundingBox_ClassifyAgainstPlanes
+	@abstract	Classify many bounding boxes against half-planes at once.
+	@discussion	Each box is compared with each half-plane using the corners
+				nearest to and farthest from the plane.  A box wholly outside
+				one half-plane is outside, a box wholly inside all of them is
+				inside, anything else is intersecting.  For view frustum
+				planes, an intersecting box may still miss the frustum near
+				its corners.
+				
+				Half-planes use the convention of E3Math_CalcLocalFrustumPlanes.
+	@param		inPlanes		Array of half-planes.
+	@param		inNumPlanes		Number of half-planes.
+	@param		inBoxes			The boxes to classify.
+	@param		outClasses		Receives a classification for each box, or
+								nullptr.
+	@param		outVisibleMask	Receives a bit for each box that is not
+								outside, packed 32 boxes to a word, or nullptr.
+								Must have room for (count + 31) / 32 words.
+*/
+void	E3BoundingBox_ClassifyAgainstPlanes(
+									const TQ3RationalPoint4D* inPlanes,
+									TQ3Uns32 inNumPlanes,
+									const E3BoundingBoxArraySoA& inBoxes,
+									E3FrustumClass* outClasses,
+									TQ3Uns32* outVisibleMask )
+{
+	const TQ3Uns32 numBoxes = inBoxes.count;
+	TQ3Uns32 i = 0;
+	TQ3Uns32 p;
+	
+	if (outVisibleMask != nullptr)
+	{
+		std::fill( outVisibleMask, outVisibleMask + (numBoxes + 31) / 32, 0U );
+	}
+	
+	// For each plane, the corner of a box with the lowest plane value takes
+	// the min coordinate where the plane coefficient is positive and the max
+	// coordinate otherwise, and the highest value corner the opposite.  Since
+	// that choice depends only on the plane, boxes can be processed in
+	// parallel with no per-box branches.
+#if QUESA_SIMD_SSE2
+	const __m128 zero = _mm_setzero_ps();
+	
+	for (; i + 4 <= numBoxes; i += 4)
+	{
+		const __m128 minX = _mm_loadu_ps( inBoxes.minX + i );
+		const __m128 minY = _mm_loadu_ps( inBoxes.minY + i );
+		const __m128 minZ = _mm_loadu_ps( inBoxes.minZ + i );
+		const __m128 maxX = _mm_loadu_ps( inBoxes.maxX + i );
+		const __m128 maxY = _mm_loadu_ps( inBoxes.maxY + i );
+		const __m128 maxZ = _mm_loadu_ps( inBoxes.maxZ + i );
+		__m128 anyOutside = zero;
+		__m128 anyPartial = zero;
+		
+		for (p = 0; p < inNumPlanes; ++p)
+		{
+			const TQ3RationalPoint4D& thePlane( inPlanes[p] );
+			const __m128 a = _mm_set1_ps( thePlane.x );
+			const __m128 b = _mm_set1_ps( thePlane.y );
+			const __m128 c = _mm_set1_ps( thePlane.z );
+			const __m128 d = _mm_set1_ps( thePlane.w );
+			
+			__m128 lowValue = _mm_add_ps( d, _mm_mul_ps( a, (thePlane.x > 0.0f)? minX : maxX ) );
+			lowValue = _mm_add_ps( lowValue, _mm_mul_ps( b, (thePlane.y > 0.0f)? minY : maxY ) );
+			lowValue = _mm_add_ps( lowValue, _mm_mul_ps( c, (thePlane.z > 0.0f)? minZ : maxZ ) );
+			
+			__m128 highValue = _mm_add_ps( d, _mm_mul_ps( a, (thePlane.x > 0.0f)? maxX : minX ) );
+			highValue = _mm_add_ps( highValue, _mm_mul_ps( b, (thePlane.y > 0.0f)? maxY : minY ) );
+			highValue = _mm_add_ps( highValue, _mm_mul_ps( c, (thePlane.z > 0.0f)? maxZ : minZ ) );
+			
+			anyOutside = _mm_or_ps( anyOutside, _mm_cmpgt_ps( lowValue, zero ) );
+			anyPartial = _mm_or_ps( anyPartial, _mm_cmpgt_ps( highValue, zero ) );
+		}
+		
+		StoreBoxClasses( i, 4, (TQ3Uns32) _mm_movemask_ps( anyOutside ),
+			(TQ3Uns32) _mm_movemask_ps( anyPartial ), outClasses, outVisibleMask );
+	}
+#elif QUESA_SIMD_NEON
+	const float32x4_t zero = vdupq_n_f32( 0.0f );
+	static const uint32_t kLaneBits[4] = { 1, 2, 4, 8 };
+	const uint32x4_t laneBits = vld1q_u32( kLaneBits );
+	
+	for (; i + 4 <= numBoxes; i += 4)
+	{
+		const float32x4_t minX = vld1q_f32( inBoxes.minX + i );
+		const float32x4_t minY = vld1q_f32( inBoxes.minY + i );
+		const float32x4_t minZ = vld1q_f32( inBoxes.minZ + i );
+		const float32x4_t maxX = vld1q_f32( inBoxes.maxX + i );
+		const float32x4_t maxY = vld1q_f32( inBoxes.maxY + i );
+		const float32x4_t maxZ = vld1q_f32( inBoxes.maxZ + i );
+		uint32x4_t anyOutside = vdupq_n_u32( 0 );
+		uint32x4_t anyPartial = vdupq_n_u32( 0 );
+		
+		for (p = 0; p < inNumPlanes; ++p)
+		{
+			const TQ3RationalPoint4D& thePlane( inPlanes[p] );
+			const float32x4_t d = vdupq_n_f32( thePlane.w );
+			
+			float32x4_t lowValue = vaddq_f32( d, vmulq_n_f32( (thePlane.x > 0.0f)? minX : maxX, thePlane.x ) );
+			lowValue = vaddq_f32( lowValue, vmulq_n_f32( (thePlane.y > 0.0f)? minY : maxY, thePlane.y ) );
+			lowValue = vaddq_f32( lowValue, vmulq_n_f32( (thePlane.z > 0.0f)? minZ : maxZ, thePlane.z ) );
+			
+			float32x4_t highValue = vaddq_f32( d, vmulq_n_f32( (thePlane.x > 0.0f)? maxX : minX, thePlane.x ) );
+			highValue = vaddq_f32( highValue, vmulq_n_f32( (thePlane.y > 0.0f)? maxY : minY, thePlane.y ) );
+			highValue = vaddq_f32( highValue, vmulq_n_f32( (thePlane.z > 0.0f)? maxZ : minZ, thePlane.z ) );
+			
+			anyOutside = vorrq_u32( anyOutside, vcgtq_f32( lowValue, zero ) );
+			anyPartial = vorrq_u32( anyPartial, vcgtq_f32( highValue, zero ) );
+		}
+		
+		const uint32x4_t outsideBits = vandq_u32( anyOutside, laneBits );
+		const uint32x4_t partialBits = vandq_u32( anyPartial, laneBits );
+		StoreBoxClasses( i, 4,
+			vgetq_lane_u32( outsideBits, 0 ) | vgetq_lane_u32( outsideBits, 1 ) |
+				vgetq_lane_u32( outsideBits, 2 ) | vgetq_lane_u32( outsideBits, 3 ),
+			vgetq_lane_u32( partialBits, 0 ) | vgetq_lane_u32( partialBits, 1 ) |
+				vgetq_lane_u32( partialBits, 2 ) | vgetq_lane_u32( partialBits, 3 ),
+			outClasses, outVisibleMask );
+	}
+#endif
+
+	// Handle the remaining boxes one at a time
+	for (; i < numBoxes; ++i)
+	{
+		TQ3Uns32 isOutside = 0;
+		TQ3Uns32 isPartial = 0;
+		
+		for (p = 0; p < inNumPlanes; ++p)
+		{
+			const TQ3RationalPoint4D& thePlane( inPlanes[p] );
+			
+			float lowValue = thePlane.w +
+				thePlane.x * ((thePlane.x > 0.0f)? inBoxes.minX[i] : inBoxes.maxX[i]) +
+				thePlane.y * ((thePlane.y > 0.0f)? inBoxes.minY[i] : inBoxes.maxY[i]) +
+				thePlane.z * ((thePlane.z > 0.0f)? inBoxes.minZ[i] : inBoxes.maxZ[i]);
+			float highValue = thePlane.w +
+				thePlane.x * ((thePlane.x > 0.0f)? inBoxes.maxX[i] : inBoxes.minX[i]) +
+				thePlane.y * ((thePlane.y > 0.0f)? inBoxes.maxY[i] : inBoxes.minY[i]) +
+				thePlane.z * ((thePlane.z > 0.0f)? inBoxes.maxZ[i] : inBoxes.minZ[i]);
+			
+			if (lowValue > 0.0f)
+			{
+				isOutside = 1;
+				break;
+			}
+			if (highValue > 0.0f)
+			{
+				isPartial = 1;
+			}
+		}
+		
+		StoreBoxClasses( i, 1, isOutside, isPartial, outClasses, outVisibleMask );
+	}
+}
+
+
+/*!
+	@function	E3BoundingBox_ClassifyViewFrustum
+	@abstract	Classify many bounding boxes in local coordinates against the
+				view frustum.
+	@discussion	The boxes are classified against the local frustum planes of
+				the view in one batch, and boxes found to be intersecting are
+				then checked with E3BoundingBox_IntersectViewFrustum, so the
+				visible boxes are exactly those that function would accept.
+				With a camera that has no frustum, every box is inside.
+	@param		inView			The view object.
+	@param		inBoxes			The boxes to classify.
+	@param		outClasses		Receives a classification for each box, or
+								nullptr.
+	@param		outVisibleMask	Receives a bit for each visible box, packed 32
+								boxes to a word, or nullptr.  Must have room
+								for (count + 31) / 32 words.
+*/
+void	E3BoundingBox_ClassifyViewFrustum(
+									TQ3ViewObject inView,
+									const E3BoundingBoxArraySoA& inBoxes,
+									E3FrustumClass* outClasses,
+									TQ3Uns32* outVisibleMask )
+{
+	const TQ3Uns32 numBoxes = inBoxes.count;
+	TQ3Uns32 i;
+	
+	// With some special kinds of camera, there may be no view frustum.
+	CQ3ObjectRef theCamera( CQ3View_GetCamera( inView ) );
+	if ( Q3Object_IsType( (TQ3Object _Nonnull) theCamera.get(), kQ3CameraTypeAllSeeing ) ||
+		Q3Object_IsType( (TQ3Object _Nonnull) theCamera.get(), kQ3CameraTypeFisheye ) )
+	{
+		for (i = 0; i < numBoxes; ++i)
+		{
+			StoreBoxClasses( i, 1, 0, 0, outClasses, nullptr );
+		}
+		if (outVisibleMask != nullptr)
+		{
+			std::fill( outVisibleMask, outVisibleMask + (numBoxes + 31) / 32, 0U );
+			for (i = 0; i < numBoxes; ++i)
+			{
+				outVisibleMask[ i / 32 ] |= 1U << (i % 32);
+			}
+		}
+		return;
+	}
+	
+	// Phase 1 of E3BoundingBox_IntersectViewFrustum, for all boxes at once.
+	std::vector<E3FrustumClass> theClasses;
+	if (outClasses == nullptr)
+	{
+		theClasses.resize( numBoxes );
+		outClasses = theClasses.data();
+	}
+	E3BoundingBox_ClassifyAgainstPlanes(
+		E3View_State_GetFrustumPlanesInLocalSpace( inView ), 6, inBoxes,
+		outClasses, outVisibleMask );
+	
+	// Boxes straddling a plane get the exact test.
+	for (i = 0; i < numBoxes; ++i)
+	{
+		if (outClasses[i] == kE3FrustumClass_Intersecting)
+		{
+			TQ3BoundingBox theBox;
+			theBox.min.x = inBoxes.minX[i];
+			theBox.min.y = inBoxes.minY[i];
+			theBox.min.z = inBoxes.minZ[i];
+			theBox.max.x = inBoxes.maxX[i];
+			theBox.max.y = inBoxes.maxY[i];
+			theBox.max.z = inBoxes.maxZ[i];
+			theBox.isEmpty = kQ3False;
+			
+			if (! E3BoundingBox_IntersectViewFrustum( inView, theBox ))
+			{
+				outClasses[i] = kE3FrustumClass_Outside;
+				if (outVisibleMask != nullptr)
+				{
+					outVisibleMask[ i / 32 ] &= ~(1U << (i % 32));
+				}
+			}
+		}
+	}
+}
+
+
+/*!
+	@function	E3BoundingBox_ClassifyWindowRect
+	@abstract	Classify a bounding box in local coordinates against a
+				rectangle in window coordinates.
+	@discussion	The box is inside if the window area of its corners lies
+				within the rectangle, and outside if it misses the
+				rectangle.  If part of the box is behind the camera, or the
+				camera does not project straight lines to straight lines,
+				the corners do not bound the projection and the box is
+				classed as intersecting.
+	@param		inView			The view object.
+	@param		inLocalBox		A bounding box in local coordinates.
+	@param		inRect			A rectangle in window coordinates.
+	@result		The classification of the box.
+*/
+E3FrustumClass	E3BoundingBox_ClassifyWindowRect(
+									TQ3ViewObject inView,
+									const TQ3BoundingBox& inLocalBox,
+									const TQ3Area& inRect )
+{
+	TQ3CameraObject theCamera = E3View_AccessCamera( inView );
+	if ( (theCamera == nullptr) ||
+		Q3Object_IsType( theCamera, kQ3CameraTypeAllSeeing ) ||
+		Q3Object_IsType( theCamera, kQ3CameraTypeFisheye ) )
+	{
+		return kE3FrustumClass_Intersecting;
+	}
+	
+	TQ3Area theArea;
+	if (! E3View_GetWindowAreaOfBounds( inView, inLocalBox, theArea ))
+	{
+		return kE3FrustumClass_Intersecting;
+	}
+	
+	// The points inside the box are projected separately from its corners,
+	// so allow for their rounding with a small margin.
+	float theMargin = 1.0e-5f * (1.0f + std::max(
+		std::max( fabsf( theArea.min.x ), fabsf( theArea.max.x ) ),
+		std::max( fabsf( theArea.min.y ), fabsf( theArea.max.y ) ) ) );
+	
+	if ( (theArea.max.x + theMargin < inRect.min.x) || (theArea.min.x - theMargin > inRect.max.x) ||
+		(theArea.max.y + theMargin < inRect.min.y) || (theArea.min.y - theMargin > inRect.max.y) )
+	{
+		return kE3FrustumClass_Outside;
+	}
+	
+	if ( (theArea.min.x - theMargin >= inRect.min.x) && (theArea.max.x + theMargin <= inRect.max.x) &&
+		(theArea.min.y - theMargin >= inRect.min.y) && (theArea.max.y + theMargin <= inRect.max.y) )
+	{
+		return kE3FrustumClass_Inside;
+	}
+	
+	return kE3FrustumClass_Intersecting;
+}
+
+
+/*!
+	@function	E3Ray3DPacket_SetRay
+	@abstract	Set one lane of a ray packet.
+	@param		ioPacket		A ray packet.
+	@param		inLane			Lane index, 0 to 3.
+	@param		inRay			A ray.
+	@param		inMaxDistance	Distance along the ray beyond which hits are
+								ignored.
+*/
+void	E3Ray3DPacket_SetRay( E3Ray3DPacket& ioPacket,
+							TQ3Uns32 inLane,
+							const TQ3Ray3D& inRay,
+							float inMaxDistance )
+{
+	const TQ3Vector3D invDirection( E3BoundingTree::GetInverseDirection( inRay.direction ) );
+	
+	ioPacket.originX[ inLane ] = inRay.origin.x;
+	ioPacket.originY[ inLane ] = inRay.origin.y;
+	ioPacket.originZ[ inLane ] = inRay.origin.z;
+	ioPacket.directionX[ inLane ] = inRay.direction.x;
+	ioPacket.directionY[ inLane ] = inRay.direction.y;
+	ioPacket.directionZ[ inLane ] = inRay.direction.z;
+	ioPacket.invDirectionX[ inLane ] = invDirection.x;
+	ioPacket.invDirectionY[ inLane ] = invDirection.y;
+	ioPacket.invDirectionZ[ inLane ] = invDirection.z;
+	ioPacket.maxDistance[ inLane ] = inMaxDistance;
+}
+
+
+/*!
+	@function	E3Ray3DPacket_IntersectBoundingBox
+	@abstract	Test four rays against a box at once.
+	@discussion	This is the test of E3BoundingTree::RayEntersBox applied to
+				each lane, so a lane accepted by one is accepted by the other.
+	@param		inPacket		A ray packet.
+	@param		inMin			Minimum corner of the box.
+	@param		inMax			Maximum corner of the box.
+	@param		outEntry		Receives, for each lane, the distance at which
+								the ray enters the box, or 0 if it starts
+								inside.
+	@result		Bit n set if the ray in lane n enters the box before its
+				maximum distance.
+*/
+TQ3Uns32	E3Ray3DPacket_IntersectBoundingBox( const E3Ray3DPacket& inPacket,
+												const TQ3Point3D& inMin,
+												const TQ3Point3D& inMax,
+												float outEntry[4] )
+{
+	// Slab test along x
+	E3Float4 originCoord = E3Float4_Load( inPacket.originX );
+	E3Float4 invDirCoord = E3Float4_Load( inPacket.invDirectionX );
+	E3Float4 t1 = E3Float4_Mul( E3Float4_Sub( E3Float4_Splat( inMin.x ), originCoord ), invDirCoord );
+	E3Float4 t2 = E3Float4_Mul( E3Float4_Sub( E3Float4_Splat( inMax.x ), originCoord ), invDirCoord );
+	E3Float4 tNear = E3Float4_Min( t1, t2 );
+	E3Float4 tFar  = E3Float4_Max( t1, t2 );
+	
+	// Slab test along y
+	originCoord = E3Float4_Load( inPacket.originY );
+	invDirCoord = E3Float4_Load( inPacket.invDirectionY );
+	t1 = E3Float4_Mul( E3Float4_Sub( E3Float4_Splat( inMin.y ), originCoord ), invDirCoord );
+	t2 = E3Float4_Mul( E3Float4_Sub( E3Float4_Splat( inMax.y ), originCoord ), invDirCoord );
+	tNear = E3Float4_Max( tNear, E3Float4_Min( t1, t2 ) );
+	tFar  = E3Float4_Min( tFar,  E3Float4_Max( t1, t2 ) );
+	
+	// Slab test along z
+	originCoord = E3Float4_Load( inPacket.originZ );
+	invDirCoord = E3Float4_Load( inPacket.invDirectionZ );
+	t1 = E3Float4_Mul( E3Float4_Sub( E3Float4_Splat( inMin.z ), originCoord ), invDirCoord );
+	t2 = E3Float4_Mul( E3Float4_Sub( E3Float4_Splat( inMax.z ), originCoord ), invDirCoord );
+	tNear = E3Float4_Max( tNear, E3Float4_Min( t1, t2 ) );
+	tFar  = E3Float4_Min( tFar,  E3Float4_Max( t1, t2 ) );
+	
+	// Clip to the part of each ray we are interested in, padding the exit
+	// distance as RayEntersBox does
+	tNear = E3Float4_Max( tNear, E3Float4_Splat( 0.0f ) );
+	tFar  = E3Float4_Min( E3Float4_Mul( tFar, E3Float4_Splat( 1.0000005f ) ),
+		E3Float4_Load( inPacket.maxDistance ) );
+	
+	E3Float4_Store( outEntry, tNear );
+	return E3Float4_LessEqualMask( tNear, tFar );
+}
+
+
+/*!
+	@function	E3Ray3DPacket_IntersectTriangle
+	@abstract	Test four rays against a triangle at once.
+	@discussion	The lanes are tested as E3Ray3D_IntersectTriangle would test
+				them, and only hits nearer than the maximum distance of their
+				lane are reported.  Lanes for which the ray is nearly in the
+				plane of the triangle are passed to E3Ray3D_IntersectTriangle
+				itself.
+	@param		inPacket		A ray packet.
+	@param		inMask			Bit n set if lane n should be tested.
+	@param		point1			A point (a vertex of a triangle).
+	@param		point2			A point (a vertex of a triangle).
+	@param		point3			A point (a vertex of a triangle).
+	@param		cullBackfacing	Whether to omit a hit on the back face.
+	@param		outHits			Receives intersection data for each lane that
+								hits, as for E3Ray3D_IntersectTriangle.
+	@result		Bit n set if the ray in lane n hits the triangle.
+*/
+TQ3Uns32	E3Ray3DPacket_IntersectTriangle( const E3Ray3DPacket& inPacket,
+											TQ3Uns32 inMask,
+											const TQ3Point3D& point1,
+											const TQ3Point3D& point2,
+											const TQ3Point3D& point3,
+											TQ3Boolean cullBackfacing,
+											TQ3Param3D outHits[4] )
+{
+	TQ3Uns32	hitMask = 0;
+	float		hitU[4], hitV[4], hitW[4];
+	TQ3Uns32	n;
+
+
+
+	if (inMask == 0)
+		return 0;
+
+
+
+	// Calculate the two edges which share vertex 1
+	const TQ3Vector3D edge1( point2 - point1 );
+	const TQ3Vector3D edge2( point3 - point1 );
+	const E3Float4 edge1X = E3Float4_Splat( edge1.x );
+	const E3Float4 edge1Y = E3Float4_Splat( edge1.y );
+	const E3Float4 edge1Z = E3Float4_Splat( edge1.z );
+	const E3Float4 edge2X = E3Float4_Splat( edge2.x );
+	const E3Float4 edge2Y = E3Float4_Splat( edge2.y );
+	const E3Float4 edge2Z = E3Float4_Splat( edge2.z );
+	const E3Float4 dirX = E3Float4_Load( inPacket.directionX );
+	const E3Float4 dirY = E3Float4_Load( inPacket.directionY );
+	const E3Float4 dirZ = E3Float4_Load( inPacket.directionZ );
+
+
+
+	// Calculate the determinant, with the operations in the same order as
+	// E3Ray3D_IntersectTriangle so that the lanes get the same results
+	const E3Float4 pvecX = E3Float4_Sub( E3Float4_Mul( dirY, edge2Z ), E3Float4_Mul( dirZ, edge2Y ) );
+	const E3Float4 pvecY = E3Float4_Sub( E3Float4_Mul( dirZ, edge2X ), E3Float4_Mul( dirX, edge2Z ) );
+	const E3Float4 pvecZ = E3Float4_Sub( E3Float4_Mul( dirX, edge2Y ), E3Float4_Mul( dirY, edge2X ) );
+	const E3Float4 det = E3Float4_Add( E3Float4_Add( E3Float4_Mul( edge1X, pvecX ),
+		E3Float4_Mul( edge1Y, pvecY ) ), E3Float4_Mul( edge1Z, pvecZ ) );
+
+
+
+	// Lanes with a near-zero determinant need the more careful test of
+	// E3Ray3D_IntersectTriangle, and with culling, back faces are misses
+	const E3Float4 zero = E3Float4_Splat( 0.0f );
+	const E3Float4 one  = E3Float4_Splat( 1.0f );
+	const E3Float4 realZero = E3Float4_Splat( kQ3RealZero );
+	const E3Float4 absDet = E3Float4_Max( det, E3Float4_Sub( zero, det ) );
+	
+	TQ3Uns32 nearPlaneMask = inMask & E3Float4_LessMask( absDet, realZero );
+	TQ3Uns32 testMask = inMask & ~nearPlaneMask;
+	
+	if (cullBackfacing)
+		testMask &= E3Float4_LessEqualMask( realZero, det );
+
+
+
+	// Calculate the hit parameters and test them
+	if (testMask != 0)
+	{
+		const E3Float4 invDet = E3Float4_Div( one, det );
+		const E3Float4 tvecX = E3Float4_Sub( E3Float4_Load( inPacket.originX ), E3Float4_Splat( point1.x ) );
+		const E3Float4 tvecY = E3Float4_Sub( E3Float4_Load( inPacket.originY ), E3Float4_Splat( point1.y ) );
+		const E3Float4 tvecZ = E3Float4_Sub( E3Float4_Load( inPacket.originZ ), E3Float4_Splat( point1.z ) );
+		
+		const E3Float4 u = E3Float4_Mul( E3Float4_Add( E3Float4_Add( E3Float4_Mul( tvecX, pvecX ),
+			E3Float4_Mul( tvecY, pvecY ) ), E3Float4_Mul( tvecZ, pvecZ ) ), invDet );
+		
+		const E3Float4 qvecX = E3Float4_Sub( E3Float4_Mul( tvecY, edge1Z ), E3Float4_Mul( tvecZ, edge1Y ) );
+		const E3Float4 qvecY = E3Float4_Sub( E3Float4_Mul( tvecZ, edge1X ), E3Float4_Mul( tvecX, edge1Z ) );
+		const E3Float4 qvecZ = E3Float4_Sub( E3Float4_Mul( tvecX, edge1Y ), E3Float4_Mul( tvecY, edge1X ) );
+		
+		const E3Float4 v = E3Float4_Mul( E3Float4_Add( E3Float4_Add( E3Float4_Mul( dirX, qvecX ),
+			E3Float4_Mul( dirY, qvecY ) ), E3Float4_Mul( dirZ, qvecZ ) ), invDet );
+		const E3Float4 w = E3Float4_Mul( E3Float4_Add( E3Float4_Add( E3Float4_Mul( edge2X, qvecX ),
+			E3Float4_Mul( edge2Y, qvecY ) ), E3Float4_Mul( edge2Z, qvecZ ) ), invDet );
+		
+		hitMask = testMask &
+			E3Float4_LessEqualMask( zero, u ) & E3Float4_LessEqualMask( u, one ) &
+			E3Float4_LessEqualMask( zero, v ) & E3Float4_LessEqualMask( E3Float4_Add( u, v ), one ) &
+			E3Float4_LessEqualMask( zero, w ) & E3Float4_LessMask( w, E3Float4_Load( inPacket.maxDistance ) );
+		
+		if (hitMask != 0)
+		{
+			E3Float4_Store( hitU, u );
+			E3Float4_Store( hitV, v );
+			E3Float4_Store( hitW, w );
+			
+			for (n = 0; n < 4; ++n)
+			{
+				if ((hitMask & (1U << n)) != 0)
+				{
+					outHits[n].u = hitU[n];
+					outHits[n].v = hitV[n];
+					outHits[n].w = hitW[n];
+				}
+			}
+		}
+	}
+
+
+
+	// Test the remaining lanes one at a time
+	for (n = 0; (nearPlaneMask >> n) != 0; ++n)
+	{
+		if ((nearPlaneMask & (1U << n)) != 0)
+		{
+			TQ3Ray3D theRay;
+			theRay.origin.x = inPacket.originX[n];
+			theRay.origin.y = inPacket.originY[n];
+			theRay.origin.z = inPacket.originZ[n];
+			theRay.direction.x = inPacket.directionX[n];
+			theRay.direction.y = inPacket.directionY[n];
+			theRay.direction.z = inPacket.directionZ[n];
+			
+			TQ3Param3D theHit;
+			if ( E3Ray3D_IntersectTriangle( theRay, point1, point2, point3, cullBackfacing, theHit ) &&
+				(theHit.w < inPacket.maxDistance[n]) )
+			{
+				outHits[n] = theHit;
+				hitMask |= 1U << n;
+			}
+		}
+	}
+	
+	return hitMask;
+}
@@ -368,4 +368,195 @@ bool	E3BoundingBox_Intersect( const TQ3BoundingBox& inBox1,
 								const TQ3BoundingBox& inBox2,
 								TQ3BoundingBox& outSect );
 
+/*!
+	@enum		E3FrustumClass
+	@abstract	Classification of a bounding box against a set of half-planes.
+	@discussion	A box that is inside need not have its contents tested, which
+				allows hierarchical culling.
+*/
+enum E3FrustumClass : TQ3Uns8
+{
+	kE3FrustumClass_Outside = 0,
+	kE3FrustumClass_Intersecting,
+	kE3FrustumClass_Inside
+};
+
+
+/*!
+	@struct		E3BoundingBoxArraySoA
+	@abstract	Non-empty bounding boxes stored as separate coordinate arrays,
+				for the batch classification functions.
+	@discussion	The structure does not own the arrays.
+*/
+struct E3BoundingBoxArraySoA
+{
+	const float*	minX;
+	const float*	minY;
+	const float*	minZ;
+	const float*	maxX;
+	const float*	maxY;
+	const float*	maxZ;
+	TQ3Uns32		count;
+};
+
+
+/*!
+	@function	E3BoundingBox_ClassifyAgainstPlanes
+	@abstract	Classify many bounding boxes against half-planes at once.
+	@discussion	Each box is compared with each half-plane using the corners
+				nearest to and farthest from the plane.  A box wholly outside
+				one half-plane is outside, a box wholly inside all of them is
+				inside, anything else is intersecting.  For view frustum
+				planes, an intersecting box may still miss the frustum near
+				its corners.
+				
+				Half-planes use the convention of E3Math_CalcLocalFrustumPlanes.
+	@param		inPlanes		Array of half-planes.
+	@param		inNumPlanes		Number of half-planes.
+	@param		inBoxes			The boxes to classify.
+	@param		outClasses		Receives a classification for each box, or
+								nullptr.
+	@param		outVisibleMask	Receives a bit for each box that is not
+								outside, packed 32 boxes to a word, or nullptr.
+								Must have room for (count + 31) / 32 words.
+*/
+void	E3BoundingBox_ClassifyAgainstPlanes(
+									const TQ3RationalPoint4D* inPlanes,
+									TQ3Uns32 inNumPlanes,
+									const E3BoundingBoxArraySoA& inBoxes,
+									E3FrustumClass* outClasses,
+									TQ3Uns32* outVisibleMask );
+
+
+/*!
+	@function	E3BoundingBox_ClassifyViewFrustum
+	@abstract	Classify many bounding boxes in local coordinates against the
+				view frustum.
+	@discussion	The boxes are classified against the local frustum planes of
+				the view in one batch, and boxes found to be intersecting are
+				then checked with E3BoundingBox_IntersectViewFrustum, so the
+				visible boxes are exactly those that function would accept.
+				With a camera that has no frustum, every box is inside.
+	@param		inView			The view object.
+	@param		inBoxes			The boxes to classify.
+	@param		outClasses		Receives a classification for each box, or
+								nullptr.
+	@param		outVisibleMask	Receives a bit for each visible box, packed 32
+								boxes to a word, or nullptr.  Must have room
+								for (count + 31) / 32 words.
+*/
+void	E3BoundingBox_ClassifyViewFrustum(
+									TQ3ViewObject inView,
+									const E3BoundingBoxArraySoA& inBoxes,
+									E3FrustumClass* outClasses,
+									TQ3Uns32* outVisibleMask );
+
+
+/*!
+	@function	E3BoundingBox_ClassifyWindowRect
+	@abstract	Classify a bounding box in local coordinates against a
+				rectangle in window coordinates.
+	@discussion	The box is inside if the window area of its corners lies
+				within the rectangle, and outside if it misses the
+				rectangle.  If part of the box is behind the camera, or the
+				camera does not project straight lines to straight lines,
+				the corners do not bound the projection and the box is
+				classed as intersecting.
+	@param		inView			The view object.
+	@param		inLocalBox		A bounding box in local coordinates.
+	@param		inRect			A rectangle in window coordinates.
+	@result		The classification of the box.
+*/
+E3FrustumClass	E3BoundingBox_ClassifyWindowRect(
+									TQ3ViewObject inView,
+									const TQ3BoundingBox& inLocalBox,
+									const TQ3Area& inRect );
+
+
+/*!
+	@struct		E3Ray3DPacket
+	@abstract	Four rays stored as separate coordinate arrays, for the packet
+				intersection functions.
+	@discussion	Each lane also has a distance along its ray beyond which
+				boxes and triangles are ignored, in units of the ray
+				direction.  Lanes are filled by E3Ray3DPacket_SetRay, and
+				lanes that are not in use should be left out of the masks
+				passed to the intersection functions.
+*/
+struct E3Ray3DPacket
+{
+	float			originX[4];
+	float			originY[4];
+	float			originZ[4];
+	float			directionX[4];
+	float			directionY[4];
+	float			directionZ[4];
+	float			invDirectionX[4];
+	float			invDirectionY[4];
+	float			invDirectionZ[4];
+	float			maxDistance[4];
+};
+
+
+/*!
+	@function	E3Ray3DPacket_SetRay
+	@abstract	Set one lane of a ray packet.
+	@param		ioPacket		A ray packet.
+	@param		inLane			Lane index, 0 to 3.
+	@param		inRay			A ray.
+	@param		inMaxDistance	Distance along the ray beyond which hits are
+								ignored.
+*/
+void	E3Ray3DPacket_SetRay( E3Ray3DPacket& ioPacket,
+							TQ3Uns32 inLane,
+							const TQ3Ray3D& inRay,
+							float inMaxDistance );
+
+
+/*!
+	@function	E3Ray3DPacket_IntersectBoundingBox
+	@abstract	Test four rays against a box at once.
+	@discussion	This is the test of E3BoundingTree::RayEntersBox applied to
+				each lane, so a lane accepted by one is accepted by the other.
+	@param		inPacket		A ray packet.
+	@param		inMin			Minimum corner of the box.
+	@param		inMax			Maximum corner of the box.
+	@param		outEntry		Receives, for each lane, the distance at which
+								the ray enters the box, or 0 if it starts
+								inside.
+	@result		Bit n set if the ray in lane n enters the box before its
+				maximum distance.
+*/
+TQ3Uns32	E3Ray3DPacket_IntersectBoundingBox( const E3Ray3DPacket& inPacket,
+												const TQ3Point3D& inMin,
+												const TQ3Point3D& inMax,
+												float outEntry[4] );
+
+
+/*!
+	@function	E3Ray3DPacket_IntersectTriangle
+	@abstract	Test four rays against a triangle at once.
+	@discussion	The lanes are tested as E3Ray3D_IntersectTriangle would test
+				them, and only hits nearer than the maximum distance of their
+				lane are reported.  Lanes for which the ray is nearly in the
+				plane of the triangle are passed to E3Ray3D_IntersectTriangle
+				itself.
+	@param		inPacket		A ray packet.
+	@param		inMask			Bit n set if lane n should be tested.
+	@param		point1			A point (a vertex of a triangle).
+	@param		point2			A point (a vertex of a triangle).
+	@param		point3			A point (a vertex of a triangle).
+	@param		cullBackfacing	Whether to omit a hit on the back face.
+	@param		outHits			Receives intersection data for each lane that
+								hits, as for E3Ray3D_IntersectTriangle.
+	@result		Bit n set if the ray in lane n hits the triangle.
+*/
+TQ3Uns32	E3Ray3DPacket_IntersectTriangle( const E3Ray3DPacket& inPacket,
+											TQ3Uns32 inMask,
+											const TQ3Point3D& point1,
+											const TQ3Point3D& point2,
+											const TQ3Point3D& point3,
+											TQ3Boolean cullBackfacing,
+											TQ3Param3D outHits[4] );
+
 #endif
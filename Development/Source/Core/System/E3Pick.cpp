@@ -104,6 +104,12 @@ struct TQ3WindowRectPickSpecificData
 	TQ3Area		rect;
 };
 
+struct TQ3WorldRayBatchPickSpecificData
+{
+	std::vector<TQ3Ray3D>*		rays;
+	std::vector<float>*			nearestDistances;
+};
+
 
 struct TQ3PickBaseData
 {
@@ -180,6 +186,19 @@ public :
 	
 
 
+class E3WorldRayBatchPick : public E3Pick  // This is a leaf class so no other classes use this,
+								// so it can be here in the .c file rather than in
+								// the .h file, hence all the fields can be public
+								// as nobody should be including this file
+{
+Q3_CLASS_ENUMS ( kQ3PickTypeWorldRayBatch, E3WorldRayBatchPick, E3Pick )
+public :
+
+	TQ3WorldRayBatchPickSpecificData	instanceData ;
+} ;
+	
+
+
 class E3ShapePart : public E3Shared // This is not a leaf class, but only classes in this,
 								// file inherit from it, so it can be declared here in
 								// the .c file rather than in the .h file, hence all
@@ -279,6 +298,73 @@ bool CompPickFarToNear::operator()( TQ3PickHit* inOne, TQ3PickHit* inTwo ) const
 	return e3pick_hit_distance( inOne ) < e3pick_hit_distance( inTwo );
 }
 
+
+
+
+
+//=============================================================================
+//      e3pick_is_nearest_only : Does a pick only want its nearest hit?
+//-----------------------------------------------------------------------------
+//		Note :	A near to far pick which returns one hit can only ever return
+//				its nearest hit, so it need not keep any other.
+//-----------------------------------------------------------------------------
+static bool
+e3pick_is_nearest_only( const TQ3PickBaseData* inData )
+{
+	return (inData->commonData.sort == kQ3PickSortNearToFar) &&
+		(inData->commonData.numHitsToReturn == 1);
+}
+
+
+
+
+
+//=============================================================================
+//      e3pick_get_eye : Get the point from which hit distances are measured.
+//-----------------------------------------------------------------------------
+//		Note :	This is the origin of a world ray pick, and the camera
+//				location for a window pick.
+//-----------------------------------------------------------------------------
+static bool
+e3pick_get_eye( TQ3PickObject thePick, TQ3ViewObject theView, TQ3Point3D& outEye )
+{
+	if (E3Pick_GetType( thePick ) == kQ3PickTypeWorldRay)
+	{
+		TQ3Ray3D	pickRay;
+		E3WorldRayPick_GetRay( thePick, &pickRay );
+		outEye = pickRay.origin;
+		return true;
+	}
+	
+	TQ3CameraObject theCamera = E3View_AccessCamera( theView );
+	if (theCamera == nullptr)
+		return false;
+	
+	TQ3CameraPlacement	cameraPlacement;
+	( (E3Camera*) theCamera )->GetPlacement( &cameraPlacement );
+	outEye = cameraPlacement.cameraLocation;
+	return true;
+}
+
+
+
+
+
+//=============================================================================
+//      e3pick_hit_eye_distance : Get the distance of a hit point.
+//-----------------------------------------------------------------------------
+static float
+e3pick_hit_eye_distance( TQ3PickObject thePick, TQ3ViewObject theView,
+						const TQ3Point3D& hitXYZ )
+{
+	TQ3Point3D	theEye;
+	
+	if (! e3pick_get_eye( thePick, theView, theEye ))
+		return 0.0f;
+	
+	return Q3FastPoint3D_Distance( &hitXYZ, &theEye );
+}
+
 //-----------------------------------------------------------------------------
 //      e3pick_hit_duplicate_path : Duplicate a TQ3HitPath.
 //-----------------------------------------------------------------------------
@@ -340,15 +426,12 @@ e3pick_hit_initialise(TQ3PickHit				*theHit,
 						const TQ3Param2D		*hitUV,
 						TQ3ShapePartObject		hitShape,
 						const TQ3Param3D*		hitBarycentric,
-						TQ3Uns32				hitFaceIndex )
-{	TQ3CameraPlacement		cameraPlacement;
-	TQ3HitPath				*currentPath;
+						TQ3Uns32				hitFaceIndex,
+						const float				*hitDistance )
+{	TQ3HitPath				*currentPath;
 	TQ3Status				qd3dStatus;
-	TQ3CameraObject			theCamera;
-	TQ3Vector3D				eyeVector = { 0.0f, 0.0f, 0.0f };
 	TQ3PickData				pickData;
 	TQ3ObjectType			theType;
-	TQ3Ray3D				pickRay;
 
 
 
@@ -419,23 +502,8 @@ e3pick_hit_initialise(TQ3PickHit				*theHit,
 	// Save the distance to the viewer
 	if (E3Bit_IsSet(pickData.mask, kQ3PickDetailMaskDistance) && hitXYZ != nullptr)
 		{
-		if (Q3Pick_GetType( thePick ) == kQ3PickTypeWorldRay)
-			{
-			Q3WorldRayPick_GetRay( thePick, &pickRay );
-			Q3Point3D_Subtract(hitXYZ, &pickRay.origin, &eyeVector);
-			}
-		else
-			{
-			qd3dStatus = Q3View_GetCamera(theView, &theCamera);
-			if (qd3dStatus == kQ3Success)
-				{
-				Q3Camera_GetPlacement(theCamera, &cameraPlacement);
-				Q3Point3D_Subtract(hitXYZ, &cameraPlacement.cameraLocation, &eyeVector);
-				Q3Object_Dispose(theCamera);
-
-				}
-			}
-		theHit->hitDistance = Q3Vector3D_Length(&eyeVector);
+		theHit->hitDistance = (hitDistance != nullptr) ? *hitDistance :
+			e3pick_hit_eye_distance( thePick, theView, *hitXYZ );
 		theHit->validMask  |= kQ3PickDetailMaskDistance;
 		}
 
@@ -871,6 +939,132 @@ e3pick_worldray_metahandler(TQ3XMethodType methodType)
 
 
 
+#pragma mark -
+//=============================================================================
+//      e3pick_worldraybatch_reset : Reset the nearest hit of each ray.
+//-----------------------------------------------------------------------------
+//		Note :	A ray with no direction can never hit anything, so it is
+//				given a negative limit to mark it as inactive.
+//-----------------------------------------------------------------------------
+static void
+e3pick_worldraybatch_reset( TQ3WorldRayBatchPickSpecificData* instanceData )
+{
+	const std::vector<TQ3Ray3D>& theRays( *instanceData->rays );
+	std::vector<float>& theDistances( *instanceData->nearestDistances );
+	
+	for (TQ3Uns32 n = 0; n < theRays.size(); ++n)
+	{
+		if (Q3FastVector3D_LengthSquared( &theRays[n].direction ) > 0.0f)
+			theDistances[n] = kQ3MaxFloat;
+		else
+			theDistances[n] = -1.0f;
+	}
+}
+
+
+
+
+
+//=============================================================================
+//      e3pick_worldraybatch_new : World ray batch pick new method.
+//-----------------------------------------------------------------------------
+static TQ3Status
+e3pick_worldraybatch_new(TQ3Object theObject, void *privateData, const void *paramData)
+{
+	TQ3WorldRayBatchPickSpecificData* instanceData = (TQ3WorldRayBatchPickSpecificData *) privateData;
+	const TQ3WorldRayBatchPickData	*pickData     = (const TQ3WorldRayBatchPickData *) paramData;
+	E3Pick* parentOb = (E3Pick*) theObject;
+
+
+
+	// Initialise our instance data
+	try
+	{
+		instanceData->rays = new std::vector<TQ3Ray3D>( pickData->rays,
+			pickData->rays + pickData->numRays );
+		instanceData->nearestDistances = new std::vector<float>( pickData->numRays );
+		parentOb->baseInstanceData.pickHits->assign( pickData->numRays, nullptr );
+	}
+	catch (...)
+	{
+		delete instanceData->rays;
+		instanceData->rays = nullptr;
+		E3ErrorManager_PostError( kQ3ErrorOutOfMemory, kQ3False );
+		return(kQ3Failure);
+	}
+	
+	for (TQ3Ray3D& theRay : *instanceData->rays)
+	{
+		if (Q3FastVector3D_LengthSquared( &theRay.direction ) > 0.0f)
+			Q3FastVector3D_Normalize( &theRay.direction, &theRay.direction );
+	}
+	
+	e3pick_worldraybatch_reset( instanceData );
+
+
+
+	// The hit list holds one slot per ray, in ray order, so it is never
+	// sorted and has no limit on its length
+	parentOb->baseInstanceData.commonData.sort = kQ3PickSortNone;
+	parentOb->baseInstanceData.commonData.numHitsToReturn = kQ3ReturnAllHits;
+	parentOb->baseInstanceData.isSorted = true;
+	
+	return(kQ3Success);
+}
+
+
+
+
+
+//=============================================================================
+//      e3pick_worldraybatch_delete : World ray batch pick delete method.
+//-----------------------------------------------------------------------------
+static void
+e3pick_worldraybatch_delete(TQ3Object theObject, void *privateData)
+{
+	TQ3WorldRayBatchPickSpecificData* instanceData = (TQ3WorldRayBatchPickSpecificData *) privateData;
+
+
+
+	// Dispose of our instance data
+	delete instanceData->rays;
+	instanceData->rays = nullptr;
+	
+	delete instanceData->nearestDistances;
+	instanceData->nearestDistances = nullptr;
+}
+
+
+
+
+
+//=============================================================================
+//      e3pick_worldraybatch_metahandler : World ray batch pick metahandler.
+//-----------------------------------------------------------------------------
+static TQ3XFunctionPointer
+e3pick_worldraybatch_metahandler(TQ3XMethodType methodType)
+{	TQ3XFunctionPointer		theMethod = nullptr;
+
+
+
+	// Return our methods
+	switch (methodType) {
+		case kQ3XMethodTypeObjectNew:
+			theMethod = (TQ3XFunctionPointer) e3pick_worldraybatch_new;
+			break;
+
+		case kQ3XMethodTypeObjectDelete:
+			theMethod = (TQ3XFunctionPointer) e3pick_worldraybatch_delete;
+			break;
+		}
+	
+	return(theMethod);
+}
+
+
+
+
+
 //=============================================================================
 //      e3shapepart_new : Shape part new method.
 //-----------------------------------------------------------------------------
@@ -1146,6 +1340,11 @@ E3Pick_RegisterClass(void)
 		qd3dStatus = Q3_REGISTER_CLASS (	kQ3ClassNamePickWorldRay,
 											e3pick_worldray_metahandler,
 											E3WorldRayPick ) ;
+
+	if (qd3dStatus == kQ3Success)
+		qd3dStatus = Q3_REGISTER_CLASS (	kQ3ClassNamePickWorldRayBatch,
+											e3pick_worldraybatch_metahandler,
+											E3WorldRayBatchPick ) ;
 	
 	//----------------------------------------------------------------------------------
 	
@@ -1203,6 +1402,7 @@ E3Pick_UnregisterClass(void)
 	succeeded = (kQ3Success == E3ClassTree::UnregisterClass(kQ3ShapePartTypeMeshPart,		kQ3True)) && succeeded;
 	succeeded = (kQ3Success == E3ClassTree::UnregisterClass(kQ3SharedTypeShapePart,		kQ3True)) && succeeded;
 
+	succeeded = (kQ3Success == E3ClassTree::UnregisterClass(kQ3PickTypeWorldRayBatch,	kQ3True)) && succeeded;
 	succeeded = (kQ3Success == E3ClassTree::UnregisterClass(kQ3PickTypeWorldRay,			kQ3True)) && succeeded;
 	succeeded = (kQ3Success == E3ClassTree::UnregisterClass(kQ3PickTypeWindowRect,		kQ3True)) && succeeded;
 	succeeded = (kQ3Success == E3ClassTree::UnregisterClass(kQ3PickTypeWindowPoint,		kQ3True)) && succeeded;
@@ -1287,6 +1487,15 @@ E3Pick_SetData(TQ3PickObject thePick, const TQ3PickData *data)
 	// Set the field
 	baseData->commonData = *data;
 
+
+
+	// A batch pick keeps its hits in ray order
+	if (E3Pick_GetType( thePick ) == kQ3PickTypeWorldRayBatch)
+	{
+		baseData->commonData.sort = kQ3PickSortNone;
+		baseData->commonData.numHitsToReturn = kQ3ReturnAllHits;
+	}
+
 	e3pick_set_sort_mask(&baseData->commonData);
 
 	return(kQ3Success);
@@ -1428,6 +1637,74 @@ E3Pick_GetNumHits(TQ3PickObject inPick, TQ3Uns32 *numHits)
 
 
 
+//=============================================================================
+//      E3Pick_IsNearestHitOnly : Does the pick only keep its nearest hit?
+//-----------------------------------------------------------------------------
+//		Note :	Used internally by Quesa.  A near to far pick which returns
+//				one hit keeps only the nearest hit recorded so far, so
+//				geometry may skip any work which cannot find a nearer one.
+//-----------------------------------------------------------------------------
+TQ3Boolean
+E3Pick_IsNearestHitOnly(TQ3PickObject inPick)
+{
+	E3Pick* thePick = (E3Pick*) inPick;
+	
+	TQ3PickBaseData	*instanceData = (TQ3PickBaseData *) &thePick->baseInstanceData;
+
+
+
+	return(e3pick_is_nearest_only( instanceData ) ? kQ3True : kQ3False);
+}
+
+
+
+
+
+//=============================================================================
+//      E3Pick_GetNearestHitLimit : Limit a ray to the nearest hit so far.
+//-----------------------------------------------------------------------------
+//		Note :	Used internally by Quesa when picking with a world space ray,
+//				which need not start at the point hit distances are measured
+//				from.  If the pick only keeps its nearest hit and has one,
+//				returns the ray parameter, in units of the ray direction,
+//				beyond which no point can be as near as that hit.
+//-----------------------------------------------------------------------------
+TQ3Boolean
+E3Pick_GetNearestHitLimit(TQ3PickObject inPick, TQ3ViewObject theView,
+							const TQ3Ray3D *theRay, float *outLimit)
+{
+	E3Pick* thePick = (E3Pick*) inPick;
+	
+	TQ3PickBaseData	*instanceData = (TQ3PickBaseData *) &thePick->baseInstanceData;
+	TQ3Point3D		theEye;
+
+
+
+	// Check we have a hit to beat
+	if ( (! e3pick_is_nearest_only( instanceData )) || instanceData->pickHits->empty() )
+		return(kQ3False);
+	
+	float rayLength = Q3FastVector3D_Length( &theRay->direction );
+	if (rayLength <= kQ3RealZero)
+		return(kQ3False);
+
+
+
+	// A point at distance t along the ray is at least t minus the distance
+	// from the ray origin to the eye away from the eye
+	float theOffset = 0.0f;
+	if (e3pick_get_eye( thePick, theView, theEye ))
+		theOffset = Q3FastPoint3D_Distance( &theRay->origin, &theEye );
+	
+	*outLimit = (e3pick_hit_distance( (*instanceData->pickHits)[0] ) + theOffset) / rayLength;
+	
+	return(kQ3True);
+}
+
+
+
+
+
 //=============================================================================
 //      E3Pick_EmptyHitList : Empties the hit list.
 //-----------------------------------------------------------------------------
@@ -1450,6 +1727,20 @@ E3Pick_EmptyHitList(TQ3PickObject inPick)
 	
 	instanceData->pickHits->clear();
 
+
+
+	// A batch pick keeps one slot per ray, and forgets the nearest hits
+	if (E3Pick_GetType( thePick ) == kQ3PickTypeWorldRayBatch)
+	{
+		E3WorldRayBatchPick* batchPick = (E3WorldRayBatchPick*) thePick;
+		
+		if (batchPick->instanceData.rays != nullptr)
+		{
+			instanceData->pickHits->assign( batchPick->instanceData.rays->size(), nullptr );
+			e3pick_worldraybatch_reset( &batchPick->instanceData );
+		}
+	}
+
 	return(kQ3Success);
 }
 
@@ -1471,12 +1762,13 @@ E3Pick_GetPickDetailValidMask( TQ3PickObject inPick, TQ3Uns32 index,
 
 
 
-	// Find the item
+	// Find the item.  A batch pick holds an empty slot for a ray which hit
+	// nothing, which is still a valid index.
 	theHit = e3pick_hit_find(instanceData, index);
 	if (theHit == nullptr)
 		{
 		*pickDetailValidMask = kQ3PickDetailNone;
-		return(kQ3Failure);
+		return(index < instanceData->pickHits->size() ? kQ3Success : kQ3Failure);
 		}
 
 
@@ -1600,8 +1892,14 @@ E3Pick_RecordHit(TQ3PickObject				inPick,
 	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(theView),   kQ3Failure);
 
 	
+	// A batch pick only takes hits for a particular ray
+	if (E3Pick_GetType(thePick) == kQ3PickTypeWorldRayBatch)
+		return theStatus;
+
+	
 	// picks are not sorted until e3pick_hit_find is called.
 	instanceData->isSorted = false;
+	bool nearestOnly = e3pick_is_nearest_only( instanceData );
 	
 	
 	// If it is a window-point pick and we have an XYZ, then reject it if it is
@@ -1623,6 +1921,20 @@ E3Pick_RecordHit(TQ3PickObject				inPick,
 	}
 	
 	
+	// If only the nearest hit is kept, a hit which is no nearer than the one
+	// we have is dropped before we copy its path and details.  A hit without
+	// a point sorts as if it were at distance 0.
+	if ( nearestOnly && ! instanceData->pickHits->empty() )
+	{
+		float theDistance = 0.0f;
+		if (hitXYZ != nullptr)
+			theDistance = e3pick_hit_eye_distance( thePick, theView, *hitXYZ );
+		
+		if (e3pick_hit_distance( (*instanceData->pickHits)[0] ) <= theDistance)
+			return theStatus;
+	}
+	
+	
 	try
 	{
 		// Allocate another hit record
@@ -1632,12 +1944,18 @@ E3Pick_RecordHit(TQ3PickObject				inPick,
 
 		// Fill out the data for the hit
 		e3pick_hit_initialise( theHit.get(), thePick, theView, hitXYZ,
-			hitNormal, hitUV, hitShape, hitBarycentric, hitTriMeshFaceIndex);
+			hitNormal, hitUV, hitShape, hitBarycentric, hitTriMeshFaceIndex, nullptr );
 
 
 
-		// Save the hit at the end of the list
-		instanceData->pickHits->push_back( theHit.get() );
+		// Save the hit at the end of the list, or in place of the hit it beat
+		if ( nearestOnly && ! instanceData->pickHits->empty() )
+		{
+			delete (*instanceData->pickHits)[0];
+			(*instanceData->pickHits)[0] = theHit.get();
+		}
+		else
+			instanceData->pickHits->push_back( theHit.get() );
 		
 		
 		
@@ -1921,6 +2239,161 @@ E3WorldRayPick_SetData(TQ3PickObject thePick, const TQ3WorldRayPickData *data)
 
 
 
+//=============================================================================
+//      E3WorldRayBatchPick_New : Creates a new world ray batch pick.
+//-----------------------------------------------------------------------------
+#pragma mark -
+TQ3PickObject
+E3WorldRayBatchPick_New(const TQ3WorldRayBatchPickData *data)
+{
+	// Create the object
+	return E3ClassTree::CreateInstance( kQ3PickTypeWorldRayBatch, kQ3True, data );
+}
+
+
+
+
+
+//=============================================================================
+//      E3WorldRayBatchPick_GetNumRays : Gets the number of rays in a batch.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3WorldRayBatchPick_GetNumRays(TQ3PickObject thePick, TQ3Uns32 *numRays)
+{
+	// Get the field
+	*numRays = static_cast<TQ3Uns32>( ( (E3WorldRayBatchPick*) thePick )->instanceData.rays->size() );
+	return kQ3Success ;
+}
+
+
+
+
+
+//=============================================================================
+//      E3WorldRayBatchPick_GetRay : Gets one ray of a batch.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3WorldRayBatchPick_GetRay(TQ3PickObject thePick, TQ3Uns32 index, TQ3Ray3D *ray)
+{
+	const std::vector<TQ3Ray3D>& theRays( *( (E3WorldRayBatchPick*) thePick )->instanceData.rays );
+
+
+
+	// Get the field
+	if (index >= theRays.size())
+		return kQ3Failure ;
+	
+	*ray = theRays[ index ];
+	return kQ3Success ;
+}
+
+
+
+
+
+//=============================================================================
+//      E3WorldRayBatchPick_AccessRays : Access the rays of a batch.
+//-----------------------------------------------------------------------------
+//		Note :	Used internally by Quesa.  The ray directions are normalized.
+//-----------------------------------------------------------------------------
+const TQ3Ray3D*
+E3WorldRayBatchPick_AccessRays(TQ3PickObject thePick)
+{
+	return ( (E3WorldRayBatchPick*) thePick )->instanceData.rays->data();
+}
+
+
+
+
+
+//=============================================================================
+//      E3WorldRayBatchPick_AccessNearestDistances : Access the ray limits.
+//-----------------------------------------------------------------------------
+//		Note :	Used internally by Quesa.  Each ray has the distance of its
+//				nearest hit so far, or kQ3MaxFloat if it has none.  A ray
+//				which can hit nothing has a negative distance.
+//-----------------------------------------------------------------------------
+const float*
+E3WorldRayBatchPick_AccessNearestDistances(TQ3PickObject thePick)
+{
+	return ( (E3WorldRayBatchPick*) thePick )->instanceData.nearestDistances->data();
+}
+
+
+
+
+
+//=============================================================================
+//      E3WorldRayBatchPick_RecordHit : Record a hit for one ray of a batch.
+//-----------------------------------------------------------------------------
+//		Note :	The hit replaces the ray's current hit if it is nearer to the
+//				ray origin, and is otherwise dropped.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3WorldRayBatchPick_RecordHit(TQ3PickObject				inPick,
+								TQ3ViewObject			theView,
+								TQ3Uns32				rayIndex,
+								const TQ3Point3D		*hitXYZ,
+								const TQ3Vector3D		*hitNormal,
+								const TQ3Param2D		*hitUV,
+								const TQ3Param3D		*hitBarycentric,
+								TQ3Uns32				hitTriMeshFaceIndex )
+{
+	E3WorldRayBatchPick* thePick = (E3WorldRayBatchPick*) inPick;
+
+	TQ3PickBaseData	*instanceData = (TQ3PickBaseData *) &thePick->baseInstanceData;
+	std::vector<float>& theDistances( *thePick->instanceData.nearestDistances );
+	TQ3Status	theStatus = kQ3Success;
+
+
+
+	// Validate our parameters
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(thePick),   kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(theView),   kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(Q3_VALID_PTR(hitXYZ),    kQ3Failure);
+	Q3_REQUIRE_OR_RESULT(rayIndex < theDistances.size(), kQ3Failure);
+
+
+
+	// Drop the hit unless it beats the nearest hit so far
+	float theDistance = Q3FastPoint3D_Distance( hitXYZ,
+		&(*thePick->instanceData.rays)[ rayIndex ].origin );
+	
+	if (theDistance >= theDistances[ rayIndex ])
+		return theStatus;
+	
+	
+	try
+	{
+		// Allocate another hit record
+		std::unique_ptr<TQ3PickHit>	theHit( new TQ3PickHit );
+
+
+
+		// Fill out the data for the hit
+		e3pick_hit_initialise( theHit.get(), thePick, theView, hitXYZ,
+			hitNormal, hitUV, nullptr, hitBarycentric, hitTriMeshFaceIndex, &theDistance );
+
+
+
+		// Save the hit in the ray's slot
+		delete (*instanceData->pickHits)[ rayIndex ];
+		(*instanceData->pickHits)[ rayIndex ] = theHit.release();
+		theDistances[ rayIndex ] = theDistance;
+	}
+	catch (...)
+	{
+		theStatus = kQ3Failure;
+	}
+
+
+	return theStatus;
+}
+
+
+
+
+
 //=============================================================================
 //      E3ShapePart_New : Creates a new shape part.
 //		(Semi-private, no access to the 3rd party programmer)
@@ -80,6 +80,8 @@ TQ3Status				E3Pick_SetEdgeTolerance(TQ3PickObject thePick, float edgeTolerance)
 TQ3Status				E3Pick_GetFaceTolerance(TQ3PickObject thePick, float *faceTolerance);
 TQ3Status				E3Pick_SetFaceTolerance(TQ3PickObject thePick, float faceTolerance);
 TQ3Status				E3Pick_GetNumHits(TQ3PickObject thePick, TQ3Uns32 *numHits);
+TQ3Boolean				E3Pick_IsNearestHitOnly(TQ3PickObject thePick);
+TQ3Boolean				E3Pick_GetNearestHitLimit(TQ3PickObject thePick, TQ3ViewObject theView, const TQ3Ray3D *theRay, float *outLimit);
 TQ3Status				E3Pick_EmptyHitList(TQ3PickObject thePick);
 TQ3Status				E3Pick_GetPickDetailValidMask(TQ3PickObject thePick, TQ3Uns32 index, TQ3PickDetail *pickDetailValidMask);
 TQ3Status				E3Pick_GetPickDetailData(TQ3PickObject thePick, TQ3Uns32 index, TQ3PickDetail pickDetailValue, void *detailData);
@@ -111,6 +113,20 @@ TQ3Status				E3WorldRayPick_SetRay(TQ3PickObject thePick, const TQ3Ray3D *ray);
 TQ3Status				E3WorldRayPick_GetData(TQ3PickObject thePick, TQ3WorldRayPickData *data);
 TQ3Status				E3WorldRayPick_SetData(TQ3PickObject thePick, const TQ3WorldRayPickData *data);
 
+TQ3PickObject			E3WorldRayBatchPick_New(const TQ3WorldRayBatchPickData *data);
+TQ3Status				E3WorldRayBatchPick_GetNumRays(TQ3PickObject thePick, TQ3Uns32 *numRays);
+TQ3Status				E3WorldRayBatchPick_GetRay(TQ3PickObject thePick, TQ3Uns32 index, TQ3Ray3D *ray);
+const TQ3Ray3D*			E3WorldRayBatchPick_AccessRays(TQ3PickObject thePick);
+const float*			E3WorldRayBatchPick_AccessNearestDistances(TQ3PickObject thePick);
+TQ3Status				E3WorldRayBatchPick_RecordHit(TQ3PickObject			thePick,
+											TQ3ViewObject			theView,
+											TQ3Uns32				rayIndex,
+											const TQ3Point3D		*hitXYZ,
+											const TQ3Vector3D		*hitNormal,
+											const TQ3Param2D		*hitUV,
+											const TQ3Param3D		*hitBarycentric,
+											TQ3Uns32				hitTriMeshFaceIndex = kQ3ArrayIndexNULL );
+
 TQ3MeshPartObject		E3MeshPart_New(const TQ3MeshComponent data);
 TQ3ObjectType			E3MeshPart_GetType(TQ3MeshPartObject meshPartObject);
 TQ3Status				E3MeshPart_GetComponent(TQ3MeshPartObject meshPartObject, TQ3MeshComponent *component);
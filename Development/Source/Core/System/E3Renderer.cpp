@@ -137,6 +137,7 @@ e3renderer_add_methods(TQ3RendererObject theRenderer)
 														kQ3GeometryTypeEllipse,
 														kQ3GeometryTypeEllipsoid,
 														kQ3GeometryTypeGeneralPolygon,
+														kQ3GeometryTypeInstanceArray,
 														kQ3GeometryTypeLine,
 														kQ3GeometryTypeMarker,
 														kQ3GeometryTypeMesh,
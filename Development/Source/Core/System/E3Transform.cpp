@@ -1338,6 +1338,42 @@ E3MatrixTransform::Get ( TQ3Matrix4x4* theMatrix )
 
 
 
+//=============================================================================
+//      E3MatrixTransform_SetArray : Set the matrices of many transforms.
+//-----------------------------------------------------------------------------
+//		Note :	Every transform is checked before any is changed. We then
+//				write straight into each transform and bump its edit index,
+//				without going back through the API for each one.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3MatrixTransform_SetArray(TQ3Uns32 numTransforms, const TQ3TransformObject *transforms,
+							const TQ3Matrix4x4 *matrices)
+	{
+	TQ3Uns32 i ;
+	
+	for ( i = 0 ; i < numTransforms ; ++i )
+		{
+		if ( ! E3MatrixTransform::IsOfMyClass ( transforms [ i ] ) )
+			{
+			E3ErrorManager_PostError ( kQ3ErrorInvalidObjectType, kQ3False ) ;
+			return kQ3Failure ;
+			}
+		}
+	
+	for ( i = 0 ; i < numTransforms ; ++i )
+		{
+		E3MatrixTransform* theTransform = (E3MatrixTransform*) transforms [ i ] ;
+		theTransform->matrix = matrices [ i ] ;
+		theTransform->Edited () ;
+		}
+
+	return kQ3Success ;
+	}
+
+
+
+
+
 //=============================================================================
 //      E3RotateTransform_New : Create a new rotate transform.
 //-----------------------------------------------------------------------------
@@ -2030,6 +2066,44 @@ E3QuaternionTransform_Get(TQ3TransformObject theTransform, TQ3Quaternion *quater
 
 
 
+//=============================================================================
+//      E3QuaternionTransform_SetArray : Set the data for many transforms.
+//-----------------------------------------------------------------------------
+//		Note :	Every transform is checked before any is changed. We then
+//				write straight into each transform and bump its edit index,
+//				without going back through the API for each one.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3QuaternionTransform_SetArray(TQ3Uns32 numTransforms, const TQ3TransformObject *transforms,
+								const TQ3Quaternion *quaternions)
+	{
+	TQ3Uns32 i ;
+	
+	for ( i = 0 ; i < numTransforms ; ++i )
+		{
+		TQ3Object theObject = transforms [ i ] ;
+		if ( ( theObject == nullptr ) || ! theObject->IsObjectValid ()
+			|| ! Q3_OBJECT_IS_CLASS ( theObject, E3QuaternionTransform ) )
+			{
+			E3ErrorManager_PostError ( kQ3ErrorInvalidObjectType, kQ3False ) ;
+			return kQ3Failure ;
+			}
+		}
+	
+	for ( i = 0 ; i < numTransforms ; ++i )
+		{
+		E3QuaternionTransform* theTransform = (E3QuaternionTransform*) transforms [ i ] ;
+		theTransform->instanceData = quaternions [ i ] ;
+		theTransform->Edited () ;
+		}
+
+	return kQ3Success ;
+	}
+
+
+
+
+
 //=============================================================================
 //      E3ResetTransform_New : Create a reset transform.
 //-----------------------------------------------------------------------------
@@ -126,6 +126,7 @@ TQ3Status			E3Transform_UnregisterClass(void);
 
 TQ3TransformObject	E3MatrixTransform_New(const TQ3Matrix4x4 *theMatrix);
 TQ3Status			E3MatrixTransform_Submit(const TQ3Matrix4x4 *theMatrix, TQ3ViewObject theView);
+TQ3Status			E3MatrixTransform_SetArray(TQ3Uns32 numTransforms, const TQ3TransformObject *transforms, const TQ3Matrix4x4 *matrices);
 
 TQ3TransformObject	E3RotateTransform_New(const TQ3RotateTransformData *data);
 TQ3Status			E3RotateTransform_Submit(const TQ3RotateTransformData *data, TQ3ViewObject theView);
@@ -172,6 +173,7 @@ TQ3TransformObject	E3QuaternionTransform_New(const TQ3Quaternion *quaternion);
 TQ3Status			E3QuaternionTransform_Submit(const TQ3Quaternion *quaternion, TQ3ViewObject theView);
 TQ3Status			E3QuaternionTransform_Set(TQ3TransformObject theTransform, const TQ3Quaternion *quaternion);
 TQ3Status			E3QuaternionTransform_Get(TQ3TransformObject theTransform, TQ3Quaternion *quaternion);
+TQ3Status			E3QuaternionTransform_SetArray(TQ3Uns32 numTransforms, const TQ3TransformObject *transforms, const TQ3Quaternion *quaternions);
 
 TQ3TransformObject	E3ResetTransform_New(void);
 TQ3Status			E3ResetTransform_Submit(TQ3ViewObject theView);
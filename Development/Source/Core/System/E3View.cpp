@@ -52,15 +52,18 @@
 #include "E3Transform.h"
 #include "E3IOFileFormat.h"
 #include "E3Pick.h"
+#include "E3Group.h"
 #include "E3View.h"
 #include "E3Math_Intersect.h"
 #include "E3FastArray.h"
 #include "E3Math.h"
+#include "E3MathSoA.h"
 #include "QuesaMathOperators.hpp"
 
 #include "GLUtils.h"
 
 #include <stdint.h>
+#include <utility>
 
 
 
@@ -69,6 +72,7 @@
 //-----------------------------------------------------------------------------
 // Misc
 #define kApproxBoundsThreshold								12
+#define kMaxMultiViewMembers								32
 
 
 // View stack
@@ -184,6 +188,14 @@ typedef struct TQ3ViewData {
 	TQ3AttributeSet				viewAttributes;
 	TQ3AttributeSet				stateAttributes;	// needed for E3View_GetAttributeState
 	TQ3Boolean					allowGroupCulling;
+	float						lodBias;
+
+
+	// Multi-view state
+	TQ3ViewObject				*multiViewMembers;
+	TQ3Uns32					multiViewMemberCount;
+	TQ3Uns32					multiViewActiveMask;
+	TQ3Uns32					multiViewSubmitMask;
 
 
 	// View stack
@@ -200,7 +212,8 @@ typedef struct TQ3ViewData {
 	TQ3BoundingBox				boundingBox;
 	TQ3SlabObject				boundingPointsSlab;
 	TQ3BoundingSphere			boundingSphere;
-	E3FastArray<TQ3Point3D>*	boundingPointsArray;
+	TQ3Point3DArraySoA			boundingPoints;
+	TQ3Uns32					boundingPointsCapacity;
 
 
 	// Derived cached matrices
@@ -813,7 +826,9 @@ e3view_init_matrix_state( TQ3ViewObject theView )
 //      e3view_bounds_box_exact : Update our bounds.
 //-----------------------------------------------------------------------------
 //		Note :	We transform the vertices to world coordinates, then union them
-//				with the view bounding box.
+//				with the view bounding box. The points are copied to separate
+//				coordinate arrays first, so both the transform and the bounds
+//				work on four points at a time.
 //-----------------------------------------------------------------------------
 static void
 e3view_bounds_box_exact ( E3View* view, TQ3Uns32 numPoints, TQ3Uns32 pointStride, const TQ3Point3D *thePoints )
@@ -830,22 +845,26 @@ e3view_bounds_box_exact ( E3View* view, TQ3Uns32 numPoints, TQ3Uns32 pointStride
 
 
 	// Make a buffer to hold transformed points.
-	if (view->instanceData.boundingPointsArray == nullptr)
+	TQ3Point3DArraySoA& workArray( view->instanceData.boundingPoints );
+	if (view->instanceData.boundingPointsCapacity < numPoints)
 	{
-		view->instanceData.boundingPointsArray = new E3FastArray<TQ3Point3D>;
+		E3Point3DArraySoA_Free( &workArray );
+		view->instanceData.boundingPointsCapacity = 0;
+		if (E3Point3DArraySoA_Allocate( numPoints, &workArray ) != kQ3Success)
+			return;
+		view->instanceData.boundingPointsCapacity = numPoints;
 	}
-	E3FastArray<TQ3Point3D>& workArray( *(view->instanceData.boundingPointsArray) );
-	workArray.resizeNotPreserving( numPoints );
+	workArray.count = numPoints;
 
 
 	// Transform the points to world space.
-	E3Point3D_To3DTransformArray( thePoints, localToWorld, &workArray[0],
-		numPoints, pointStride, sizeof(TQ3Point3D) );
+	E3Point3DArraySoA_SetFromPoints3D( thePoints, pointStride, &workArray );
+	E3Point3DArraySoA_TransformPoints( &workArray, localToWorld, &workArray );
 
 
 	// Find the bounds of the points in the buffer, and union with the accumulating bounds.
 	TQ3BoundingBox thisBox;
-	E3BoundingBox_SetFromPoints3D( &thisBox, &workArray[0], numPoints, sizeof(TQ3Point3D) );
+	E3Point3DArraySoA_GetBoundingBox( &workArray, &thisBox );
 	E3BoundingBox_Union( &thisBox, &view->instanceData.boundingBox, &view->instanceData.boundingBox );
 }
 
@@ -1372,6 +1391,169 @@ e3view_submit_immediate_bad_mode ( TQ3ViewObject theView , TQ3ObjectType objectT
 
 
 
+//=============================================================================
+//      e3view_multiview_submit_group : Traverse a display group once.
+//-----------------------------------------------------------------------------
+//		Note :	The group is culled against the frustum of each member view in
+//				the current submit mask, and its contents are then traversed
+//				once on behalf of all members which can see it.
+//-----------------------------------------------------------------------------
+static TQ3Status
+e3view_multiview_submit_group ( E3View* view, E3DisplayGroup* theGroup )
+{
+	TQ3ViewData& instanceData( view->instanceData );
+	TQ3Status qd3dStatus = kQ3Success;
+
+
+
+	// Find out if we need to submit ourselves
+	TQ3DisplayGroupState theState;
+	theGroup->GetState( &theState );
+	if ( ! E3Bit_AnySet( theState, kQ3DisplayGroupStateMaskIsDrawn ) )
+		return kQ3Success;
+
+
+
+	// Cull the group against each member view
+	TQ3Uns32 groupMask = instanceData.multiViewSubmitMask;
+	TQ3BoundingBox theBBox;
+	if ( E3Bit_IsSet( theState, kQ3DisplayGroupStateMaskUseBoundingBox ) &&
+		(kQ3Success == theGroup->GetBoundingBox( &theBBox )) )
+	{
+		for (TQ3Uns32 n = 0; n < instanceData.multiViewMemberCount; ++n)
+		{
+			TQ3ViewObject theMember = instanceData.multiViewMembers[ n ];
+			
+			if ( E3Bit_IsSet( groupMask, 1U << n ) &&
+				E3View_IsGroupCullingAllowed( theMember ) &&
+				! E3Renderer_Method_IsBBoxVisible( theMember, &theBBox ) )
+			{
+				groupMask &= ~(1U << n);
+			}
+		}
+	}
+
+	if ( groupMask == 0 )
+		return kQ3Success;
+
+
+
+	// If the group isn't inline, push the state of the members that see it
+	TQ3Boolean isInline = E3Bit_AnySet( theState, kQ3DisplayGroupStateMaskIsInline );
+	TQ3Uns32 savedMask = instanceData.multiViewSubmitMask;
+	instanceData.multiViewSubmitMask = groupMask;
+
+	if ( ! isInline )
+		qd3dStatus = E3View_SubmitImmediate( view, kQ3StateOperatorTypePush, nullptr );
+
+
+
+	// Submit the contents of the group
+	if ( qd3dStatus != kQ3Failure )
+	{
+		E3GroupInfo* groupClass = theGroup->GetClass();
+		TQ3GroupPosition thePosition;
+		TQ3Object subObject;
+		qd3dStatus = groupClass->startIterateMethod( theGroup, &thePosition, &subObject, view );
+		while ( qd3dStatus != kQ3Failure && subObject != nullptr )
+		{
+			// Submit the object, ignore errors
+			E3View_SubmitRetained( view, subObject );
+
+			qd3dStatus = groupClass->endIterateMethod( theGroup, &thePosition, &subObject, view );
+		}
+
+
+
+		// If the group isn't inline, pop the member state
+		if ( ! isInline )
+			E3View_SubmitImmediate( view, kQ3StateOperatorTypePop, nullptr );
+	}
+
+	instanceData.multiViewSubmitMask = savedMask;
+
+	return qd3dStatus;
+}
+
+
+
+
+
+//=============================================================================
+//      e3view_submit_retained_multiview : Retained submit to a multi-view.
+//-----------------------------------------------------------------------------
+//		Note :	Display groups which use the standard render traversal are
+//				walked once here. Anything else, including LOD groups whose
+//				choice depends on the camera, is forwarded to each member.
+//-----------------------------------------------------------------------------
+static TQ3Status
+e3view_submit_retained_multiview ( TQ3ViewObject inView, TQ3Object theObject )
+{
+	E3View* view = (E3View*) inView;
+	TQ3ViewData& instanceData( view->instanceData );
+	E3Root* theClass = (E3Root*) theObject->GetClass();
+	E3Root* displayGroupClass = (E3Root*) E3ClassTree::GetClass( kQ3GroupTypeDisplay );
+
+
+
+	// Traverse display groups once for all members
+	if ( displayGroupClass != nullptr &&
+		theClass->submitRenderMethod == displayGroupClass->submitRenderMethod &&
+		Q3_OBJECT_IS_CLASS( theObject, E3DisplayGroup ) &&
+		! Q3Object_IsType( theObject, kQ3DisplayGroupTypeLOD ) )
+	{
+		return e3view_multiview_submit_group( view, (E3DisplayGroup*) theObject );
+	}
+
+
+
+	// Forward anything else to the members that can see it
+	TQ3Status qd3dStatus = kQ3Success;
+	for (TQ3Uns32 n = 0; n < instanceData.multiViewMemberCount; ++n)
+	{
+		if ( E3Bit_IsSet( instanceData.multiViewSubmitMask, 1U << n ) )
+		{
+			if ( E3View_SubmitRetained( instanceData.multiViewMembers[ n ], theObject ) == kQ3Failure )
+				qd3dStatus = kQ3Failure;
+		}
+	}
+
+	return qd3dStatus;
+}
+
+
+
+
+
+//=============================================================================
+//      e3view_submit_immediate_multiview : Immediate submit to a multi-view.
+//-----------------------------------------------------------------------------
+static TQ3Status
+e3view_submit_immediate_multiview ( TQ3ViewObject inView, TQ3ObjectType objectType, const void* objectData )
+{
+	E3View* view = (E3View*) inView;
+	TQ3ViewData& instanceData( view->instanceData );
+
+
+
+	// Forward the object to the members that can see it
+	TQ3Status qd3dStatus = kQ3Success;
+	for (TQ3Uns32 n = 0; n < instanceData.multiViewMemberCount; ++n)
+	{
+		if ( E3Bit_IsSet( instanceData.multiViewSubmitMask, 1U << n ) )
+		{
+			if ( E3View_SubmitImmediate( instanceData.multiViewMembers[ n ], objectType, objectData ) == kQ3Failure )
+				qd3dStatus = kQ3Failure;
+		}
+	}
+
+	return qd3dStatus;
+}
+
+
+
+
+
 //=============================================================================
 //      e3view_submit_begin : Begin a submitting loop.
 //-----------------------------------------------------------------------------
@@ -1800,6 +1982,7 @@ e3view_new(TQ3Object theObject, void *privateData, const void *paramData)
 	instanceData->submitRetainedMethod  = (TQ3XViewSubmitRetainedMethod) e3view_submit_retained_error;
 	instanceData->submitImmediateMethod = (TQ3XViewSubmitImmediateMethod) e3view_submit_immediate_error;
 	instanceData->allowGroupCulling = kQ3True;
+	instanceData->lodBias = 1.0f;
 
 	instanceData->viewAttributes = Q3AttributeSet_New();
 	if (instanceData->viewAttributes != nullptr)
@@ -1859,7 +2042,8 @@ e3view_delete ( TQ3ViewObject view, void *privateData )
 	Q3Object_CleanDispose(&instanceData->theDrawContext);
 	Q3Object_CleanDispose(&instanceData->defaultAttributeSet);
 	Q3Object_CleanDispose(&instanceData->boundingPointsSlab);
-	delete instanceData->boundingPointsArray;
+	E3Point3DArraySoA_Free(&instanceData->boundingPoints);
+	Q3Memory_Free(&instanceData->multiViewMembers);
 
 	e3view_stack_pop_clean ( (E3View*) view ) ;
 
@@ -3985,6 +4169,170 @@ E3View_GetRenderer(TQ3ViewObject theView, TQ3RendererObject *theRenderer)
 
 
 
+//=============================================================================
+//      e3view_multiview_start_rendering : Start a multi-view rendering loop.
+//-----------------------------------------------------------------------------
+//		Note :	Each member view starts its own frame, with its own camera,
+//				draw context and renderer. The multi-view only holds a stack
+//				so that state queries made during submission remain safe.
+//-----------------------------------------------------------------------------
+static TQ3Status
+e3view_multiview_start_rendering ( E3View* view )
+{
+	TQ3ViewData& instanceData( view->instanceData );
+
+
+
+	// Make sure we're not already rendering
+	if ( instanceData.viewState != kQ3ViewStateInactive )
+		return kQ3Failure;
+
+
+
+	// Start each member
+	instanceData.multiViewActiveMask = 0;
+	for (TQ3Uns32 n = 0; n < instanceData.multiViewMemberCount; ++n)
+	{
+		TQ3ViewObject theMember = instanceData.multiViewMembers[ n ];
+
+		if ( E3View_StartRendering( theMember ) == kQ3Failure )
+		{
+			// Abandon the members we've already started
+			for (TQ3Uns32 m = 0; m < n; ++m)
+			{
+				E3View_Cancel( instanceData.multiViewMembers[ m ] );
+				(void) E3View_EndRendering( instanceData.multiViewMembers[ m ] );
+			}
+
+			instanceData.multiViewActiveMask = 0;
+			return kQ3Failure;
+		}
+
+		instanceData.multiViewActiveMask |= (1U << n);
+	}
+
+
+
+	// Start our own submit loop
+	if ( e3view_stack_push( view ) == kQ3Failure )
+	{
+		for (TQ3Uns32 n = 0; n < instanceData.multiViewMemberCount; ++n)
+		{
+			E3View_Cancel( instanceData.multiViewMembers[ n ] );
+			(void) E3View_EndRendering( instanceData.multiViewMembers[ n ] );
+		}
+
+		instanceData.multiViewActiveMask = 0;
+		return kQ3Failure;
+	}
+
+	instanceData.viewMode              = kQ3ViewModeDrawing;
+	instanceData.viewState             = kQ3ViewStateSubmitting;
+	instanceData.viewPass              = 1;
+	instanceData.multiViewSubmitMask   = instanceData.multiViewActiveMask;
+	instanceData.submitRetainedMethod  = (TQ3XViewSubmitRetainedMethod) e3view_submit_retained_multiview;
+	instanceData.submitImmediateMethod = (TQ3XViewSubmitImmediateMethod) e3view_submit_immediate_multiview;
+
+	return kQ3Success;
+}
+
+
+
+
+
+//=============================================================================
+//      e3view_multiview_end_rendering : End a multi-view rendering loop.
+//-----------------------------------------------------------------------------
+//		Note :	Members which need another pass stay active, the others drop
+//				out of subsequent passes. The combined status is the most
+//				severe of the member results.
+//-----------------------------------------------------------------------------
+static TQ3ViewStatus
+e3view_multiview_end_rendering ( E3View* view )
+{
+	TQ3ViewData& instanceData( view->instanceData );
+	TQ3ViewStatus viewStatus = kQ3ViewStatusDone;
+
+
+
+	// Check our state
+	if ( instanceData.viewState == kQ3ViewStateInactive )
+		return kQ3ViewStatusDone;
+
+	bool wasCancelled = (instanceData.viewState == kQ3ViewStateCancelled);
+
+
+
+	// End each active member
+	for (TQ3Uns32 n = 0; n < instanceData.multiViewMemberCount; ++n)
+	{
+		if ( E3Bit_IsNotSet( instanceData.multiViewActiveMask, 1U << n ) )
+			continue;
+		
+		TQ3ViewObject theMember = instanceData.multiViewMembers[ n ];
+		if ( wasCancelled )
+			E3View_Cancel( theMember );
+
+		TQ3ViewStatus memberStatus = E3View_EndRendering( theMember );
+		if ( memberStatus != kQ3ViewStatusRetraverse )
+			instanceData.multiViewActiveMask &= ~(1U << n);
+
+		if ( memberStatus == kQ3ViewStatusError ||
+			(memberStatus == kQ3ViewStatusCancelled && viewStatus != kQ3ViewStatusError) ||
+			(memberStatus == kQ3ViewStatusRetraverse && viewStatus == kQ3ViewStatusDone) )
+		{
+			viewStatus = memberStatus;
+		}
+	}
+
+
+
+	// A failed or cancelled member ends the frame for everyone
+	if ( viewStatus == kQ3ViewStatusError || viewStatus == kQ3ViewStatusCancelled )
+	{
+		for (TQ3Uns32 n = 0; n < instanceData.multiViewMemberCount; ++n)
+		{
+			if ( E3Bit_IsSet( instanceData.multiViewActiveMask, 1U << n ) )
+			{
+				E3View_Cancel( instanceData.multiViewMembers[ n ] );
+				(void) E3View_EndRendering( instanceData.multiViewMembers[ n ] );
+			}
+		}
+
+		instanceData.multiViewActiveMask = 0;
+	}
+
+
+
+	// Prepare for the next pass, or finish
+	e3view_stack_pop_clean( view );
+
+	if ( viewStatus == kQ3ViewStatusRetraverse && e3view_stack_push( view ) != kQ3Failure )
+	{
+		instanceData.viewPass++;
+		instanceData.multiViewSubmitMask = instanceData.multiViewActiveMask;
+	}
+	else
+	{
+		if ( viewStatus == kQ3ViewStatusRetraverse )
+			viewStatus = kQ3ViewStatusError;
+
+		instanceData.viewMode              = kQ3ViewModeInactive;
+		instanceData.viewState             = kQ3ViewStateInactive;
+		instanceData.viewPass              = 0;
+		instanceData.multiViewActiveMask   = 0;
+		instanceData.multiViewSubmitMask   = 0;
+		instanceData.submitRetainedMethod  = (TQ3XViewSubmitRetainedMethod) e3view_submit_retained_error;
+		instanceData.submitImmediateMethod = (TQ3XViewSubmitImmediateMethod) e3view_submit_immediate_error;
+	}
+
+	return viewStatus;
+}
+
+
+
+
+
 //=============================================================================
 //      E3View_StartRendering : Start a rendering loop.
 //-----------------------------------------------------------------------------
@@ -3999,6 +4347,12 @@ E3View_StartRendering(TQ3ViewObject theView)
 
 
 
+	// A multi-view starts its members rather than a renderer of its own
+	if ( ( (E3View*) theView )->instanceData.multiViewMemberCount != 0 )
+		return e3view_multiview_start_rendering ( (E3View*) theView ) ;
+
+
+
 	// Make sure we have the objects we need
 	if ( ( (E3View*) theView )->instanceData.theDrawContext == nullptr
 	||	 ( (E3View*) theView )->instanceData.viewRenderer    == nullptr
@@ -4122,6 +4476,12 @@ E3View_EndRendering(TQ3ViewObject theView)
 
 
 
+	// A multi-view ends the passes of its members
+	if ( ( (E3View*) theView )->instanceData.multiViewActiveMask != 0 )
+		return e3view_multiview_end_rendering ( (E3View*) theView ) ;
+
+
+
 	// If we're still in the submit loop, end the pass
 	if ( ( (E3View*) theView )->instanceData.viewState == kQ3ViewStateSubmitting )
 		viewStatus = E3Renderer_Method_EndPass ( theView ) ;
@@ -4274,6 +4634,33 @@ E3View_EndBoundingBox(TQ3ViewObject theView, TQ3BoundingBox *result)
 
 
 
+//=============================================================================
+//      E3View_SwapBoundingBox : Exchange the running bounding box.
+//-----------------------------------------------------------------------------
+//		Note :	Used internally by Quesa to measure parts of a submit loop
+//				separately: swapping in an empty box before submitting an
+//				object, and swapping it out afterwards, leaves the bounds of
+//				that object alone in the box which was passed in.
+//
+//				May only be called from within a bounding box loop.
+//-----------------------------------------------------------------------------
+void
+E3View_SwapBoundingBox(TQ3ViewObject theView, TQ3BoundingBox *ioBounds)
+	{
+	// Validate our state
+	Q3_ASSERT( ( (E3View*) theView )->instanceData.viewMode  == kQ3ViewModeCalcBounds ) ;
+	Q3_ASSERT( ( (E3View*) theView )->instanceData.viewState == kQ3ViewStateSubmitting ) ;
+
+
+
+	// Swap the boxes
+	std::swap( *ioBounds, ( (E3View*) theView )->instanceData.boundingBox ) ;
+	}
+
+
+
+
+
 //=============================================================================
 //      E3View_StartBoundingSphere : Start a bounding sphere loop.
 //-----------------------------------------------------------------------------
@@ -4753,6 +5140,139 @@ E3View_IsGroupCullingAllowed( TQ3ViewObject theView )
 
 
 
+//=============================================================================
+//      E3View_SetLODBias : Set the level of detail bias.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3View_SetLODBias( TQ3ViewObject theView, float inBias )
+{
+	( (E3View*) theView )->instanceData.lodBias = inBias;
+
+	return kQ3Success;
+}
+
+
+
+
+
+//=============================================================================
+//      E3View_GetLODBias : Get the level of detail bias.
+//-----------------------------------------------------------------------------
+float
+E3View_GetLODBias( TQ3ViewObject theView )
+{
+	return ( (E3View*) theView )->instanceData.lodBias;
+}
+
+
+
+
+
+//=============================================================================
+//      E3View_AddMultiViewMember : Add a member view to a multi-view.
+//-----------------------------------------------------------------------------
+//		Note :	Views are not reference counted, so the member is not retained
+//				and must outlive its membership.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3View_AddMultiViewMember( TQ3ViewObject theView, TQ3ViewObject theMember )
+{
+	TQ3ViewData& instanceData( ( (E3View*) theView )->instanceData );
+
+
+
+	// Validate the request
+	if ( theMember == theView ||
+		instanceData.viewState != kQ3ViewStateInactive ||
+		( (E3View*) theMember )->instanceData.multiViewMemberCount != 0 ||
+		instanceData.multiViewMemberCount >= kMaxMultiViewMembers )
+	{
+		E3ErrorManager_PostError( kQ3ErrorInvalidParameter, kQ3False );
+		return kQ3Failure;
+	}
+
+
+
+	// Grow the member list
+	TQ3Status qd3dStatus = Q3Memory_Reallocate( &instanceData.multiViewMembers,
+		(instanceData.multiViewMemberCount + 1) * sizeof(TQ3ViewObject) );
+	if ( qd3dStatus == kQ3Failure )
+		return kQ3Failure;
+
+	instanceData.multiViewMembers[ instanceData.multiViewMemberCount ] = theMember;
+	instanceData.multiViewMemberCount++;
+
+	return kQ3Success;
+}
+
+
+
+
+
+//=============================================================================
+//      E3View_RemoveAllMultiViewMembers : Remove the members of a multi-view.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3View_RemoveAllMultiViewMembers( TQ3ViewObject theView )
+{
+	TQ3ViewData& instanceData( ( (E3View*) theView )->instanceData );
+
+
+
+	// Can't change the members while rendering
+	if ( instanceData.viewState != kQ3ViewStateInactive )
+		return kQ3Failure;
+
+	Q3Memory_Free( &instanceData.multiViewMembers );
+	instanceData.multiViewMemberCount = 0;
+
+	return kQ3Success;
+}
+
+
+
+
+
+//=============================================================================
+//      E3View_GetMultiViewMember : Get a member of a multi-view.
+//-----------------------------------------------------------------------------
+TQ3Status
+E3View_GetMultiViewMember( TQ3ViewObject theView, TQ3Uns32 index, TQ3ViewObject* outMember )
+{
+	TQ3ViewData& instanceData( ( (E3View*) theView )->instanceData );
+
+
+
+	// Get the member
+	if ( index >= instanceData.multiViewMemberCount )
+	{
+		E3ErrorManager_PostError( kQ3ErrorParameterOutOfRange, kQ3False );
+		*outMember = nullptr;
+		return kQ3Failure;
+	}
+
+	*outMember = instanceData.multiViewMembers[ index ];
+
+	return kQ3Success;
+}
+
+
+
+
+
+//=============================================================================
+//      E3View_CountMultiViewMembers : Count the members of a multi-view.
+//-----------------------------------------------------------------------------
+TQ3Uns32
+E3View_CountMultiViewMembers( TQ3ViewObject theView )
+{
+	return ( (E3View*) theView )->instanceData.multiViewMemberCount;
+}
+
+
+
+
+
 //=============================================================================
 //      E3View_TransformLocalToWorld : Transform a point from local->world.
 //-----------------------------------------------------------------------------
@@ -4865,12 +5385,12 @@ E3View_TransformArrayLocalToWindow(TQ3ViewObject theView, TQ3Uns32 inCount,
 	TQ3Matrix4x4 localToView = localToWorld * worldToView;
 	E3View_GetFrustumToWindowMatrixState( theView, &frustumToWindow );
 
-	E3FastArray< TQ3Point3D > windowPts3D( inCount );
-
 	// In the case of a camera with a nonlinear projection, we can't do the whole
 	// thing as a matrix computation.
 	if ( E3FisheyeCamera::IsOfMyClass( camera ) || E3AllSeeingCamera::IsOfMyClass( camera ) )
 	{
+		E3FastArray< TQ3Point3D > windowPts3D( inCount );
+
 		// Transform to view space
 		E3FastArray< TQ3Point3D > viewPts( inCount );
 		E3Point3D_To3DTransformArray( localPoints, &localToView, &viewPts[0], inCount,
@@ -4886,21 +5406,29 @@ E3View_TransformArrayLocalToWindow(TQ3ViewObject theView, TQ3Uns32 inCount,
 		// Transform to window space.
 		E3Point3D_To3DTransformArray( &frustumPts[0], &frustumToWindow, &windowPts3D[0], inCount,
 			sizeof(TQ3Point3D), sizeof(TQ3Point3D) );
+
+		// Convert window points from 3D to 2D
+		for (i = 0; i < inCount; ++i)
+		{
+			windowPoints[i].x = windowPts3D[i].x;
+			windowPoints[i].y = windowPts3D[i].y;
+		}
 	}
 	else // usual linear camera
 	{
 		TQ3Matrix4x4 viewToFrustum;
 		( (E3Camera*) camera )->GetViewToFrustum( &viewToFrustum );
 		TQ3Matrix4x4 localToWindow = localToView * viewToFrustum * frustumToWindow;
-		E3Point3D_To3DTransformArray( localPoints, &localToWindow, &windowPts3D[0], inCount,
-			sizeof(TQ3Point3D), sizeof(TQ3Point3D) );
-	}
 
-	// Convert window points from 3D to 2D
-	for (i = 0; i < inCount; ++i)
-	{
-		windowPoints[i].x = windowPts3D[i].x;
-		windowPoints[i].y = windowPts3D[i].y;
+		// Project straight to 2D from separate coordinate arrays, rather than
+		// going through a temporary array of 3D window points.
+		TQ3Point3DArraySoA localPts;
+		if (E3Point3DArraySoA_Allocate( inCount, &localPts ) != kQ3Success)
+			return kQ3Failure;
+
+		E3Point3DArraySoA_SetFromPoints3D( localPoints, sizeof(TQ3Point3D), &localPts );
+		E3Point3DArraySoA_ProjectTo2D( &localPts, &localToWindow, windowPoints, sizeof(TQ3Point2D) );
+		E3Point3DArraySoA_Free( &localPts );
 	}
 
 	return kQ3Success;
@@ -4909,6 +5437,64 @@ E3View_TransformArrayLocalToWindow(TQ3ViewObject theView, TQ3Uns32 inCount,
 
 
 
+//=============================================================================
+//      E3View_GetWindowAreaOfBounds : Find the window area covered by a box.
+//-----------------------------------------------------------------------------
+//		Note :	Computes the window-space rectangle enclosing the projection of
+//				a box given in local coordinates.
+//
+//				Returns false if part of the box lies behind the camera, in
+//				which case the projection does not tell us anything useful and
+//				the caller should assume that the box covers the window.
+//-----------------------------------------------------------------------------
+bool
+E3View_GetWindowAreaOfBounds( TQ3ViewObject theView, const TQ3BoundingBox& inLocalBounds,
+								TQ3Area& outArea )
+{
+	// Get the corners of the bounds.
+	TQ3Point3D	localCorners[8];
+	E3BoundingBox_GetCorners( &inLocalBounds, localCorners );
+
+
+
+	// With a linear projection, check that all the corners are in front of
+	// the camera, which looks down the negative z axis in view coordinates.
+	TQ3CameraObject camera = E3View_AccessCamera( theView );
+	if ( (! E3FisheyeCamera::IsOfMyClass( camera )) && (! E3AllSeeingCamera::IsOfMyClass( camera )) )
+	{
+		TQ3Matrix4x4 worldToView;
+		( (E3Camera*) camera )->GetWorldToView( &worldToView );
+		TQ3Matrix4x4 localToView = *E3View_State_GetMatrixLocalToWorld( theView ) * worldToView;
+		
+		TQ3Point3D	viewCorners[8];
+		E3Point3D_To3DTransformArray( localCorners, &localToView, viewCorners, 8,
+			sizeof(TQ3Point3D), sizeof(TQ3Point3D) );
+		
+		for (int i = 0; i < 8; ++i)
+		{
+			if (viewCorners[i].z >= 0.0f)
+				return false;
+		}
+	}
+
+
+
+	// Transform corners to screen space.
+	TQ3Point2D screenCorners[8];
+	if (kQ3Success != E3View_TransformArrayLocalToWindow( theView, 8, localCorners, screenCorners ))
+		return false;
+
+
+
+	// Get area
+	outArea = E3Area_SetFromPoints2D( 8, screenCorners );
+	return true;
+}
+
+
+
+
+
 //=============================================================================
 //      E3View_TransformWorldToWindow : Transform a point from world->window.
 //-----------------------------------------------------------------------------
@@ -193,6 +193,7 @@ TQ3Status				E3View_Flush(TQ3ViewObject theView);
 TQ3Status				E3View_Sync(TQ3ViewObject theView);
 TQ3Status				E3View_StartBoundingBox(TQ3ViewObject theView, TQ3ComputeBounds computeBounds);
 TQ3ViewStatus			E3View_EndBoundingBox(TQ3ViewObject theView, TQ3BoundingBox *result);
+void					E3View_SwapBoundingBox(TQ3ViewObject theView, TQ3BoundingBox *ioBounds);
 TQ3Status				E3View_StartBoundingSphere(TQ3ViewObject theView, TQ3ComputeBounds computeBounds);
 TQ3ViewStatus			E3View_EndBoundingSphere(TQ3ViewObject theView, TQ3BoundingSphere *result);
 TQ3Status				E3View_StartPicking(TQ3ViewObject theView, TQ3PickObject pick);
@@ -210,12 +211,20 @@ TQ3Status				E3View_SetEndFrameMethod(TQ3ViewObject theView, TQ3ViewEndFrameMeth
 TQ3Boolean				E3View_IsBoundingBoxVisible(TQ3ViewObject theView, const TQ3BoundingBox *theBBox);
 TQ3Status				E3View_AllowAllGroupCulling(TQ3ViewObject theView, TQ3Boolean allowCulling);
 TQ3Boolean				E3View_IsGroupCullingAllowed( TQ3ViewObject theView );
+TQ3Status				E3View_SetLODBias( TQ3ViewObject theView, float inBias );
+float					E3View_GetLODBias( TQ3ViewObject theView );
+TQ3Status				E3View_AddMultiViewMember( TQ3ViewObject theView, TQ3ViewObject theMember );
+TQ3Status				E3View_RemoveAllMultiViewMembers( TQ3ViewObject theView );
+TQ3Status				E3View_GetMultiViewMember( TQ3ViewObject theView, TQ3Uns32 index, TQ3ViewObject* outMember );
+TQ3Uns32				E3View_CountMultiViewMembers( TQ3ViewObject theView );
 TQ3Status				E3View_TransformLocalToWorld(TQ3ViewObject theView, const TQ3Point3D *localPoint, TQ3Point3D *worldPoint);
 TQ3Status				E3View_TransformLocalToWindow(TQ3ViewObject theView, const TQ3Point3D *localPoint, TQ3Point2D *windowPoint);
 TQ3Status				E3View_TransformLocalToFrustum(TQ3ViewObject theView, const TQ3Point3D *localPoint, TQ3Point3D *frustumPoint);
 TQ3Status				E3View_TransformFrustumToWorld(TQ3ViewObject theView, const TQ3Point3D *frustumPoint, TQ3Point3D *worldPoint);
 TQ3Status				E3View_TransformArrayLocalToWindow(TQ3ViewObject theView, TQ3Uns32 inCount,
 															const TQ3Point3D *localPoints, TQ3Point2D *windowPoints);
+bool					E3View_GetWindowAreaOfBounds( TQ3ViewObject theView, const TQ3BoundingBox& inLocalBounds,
+															TQ3Area& outArea );
 TQ3Status				E3View_TransformWorldToWindow(TQ3ViewObject theView, const TQ3Point3D *worldPoint, TQ3Point2D *windowPoint);
 TQ3Status				E3View_TransformWindowToWorld(TQ3ViewObject theView, const TQ3Point2D *windowPoint, TQ3Point3D *worldPoint);
 TQ3Status				E3View_SetDrawContext(TQ3ViewObject theView, TQ3DrawContextObject drawContext);
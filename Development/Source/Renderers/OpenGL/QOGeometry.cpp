@@ -845,6 +845,32 @@ static void GetCachedTriangleStrip(
 }
 
 
+/*!
+	@function	IsAutomaticRenderOrderWanted
+	@abstract	Decide whether a TriMesh should be reordered for the vertex
+				cache when it is first drawn.
+	@discussion	This is the default, unless the renderer property
+				kQ3RendererPropertyAutomaticRenderOrder is false or the
+				TriMesh already has a triangle strip.
+*/
+static bool IsAutomaticRenderOrderWanted(
+								TQ3RendererObject inRenderer,
+								TQ3GeometryObject inTriMesh )
+{
+	TQ3Boolean	isAutoOrderPreferred = kQ3True;
+	Q3Object_GetProperty( inRenderer,
+		kQ3RendererPropertyAutomaticRenderOrder, sizeof(TQ3Boolean),
+		nullptr, &isAutoOrderPreferred );
+
+	TQ3Uns32	arraySize = 0;
+	const TQ3Uns32*	theArray = nullptr;
+	bool	hasStrip = (kQ3Success == CETriangleStripElement_GetData( inTriMesh,
+		&arraySize, &theArray )) && (arraySize > 0);
+
+	return (isAutoOrderPreferred == kQ3True) && (! hasStrip);
+}
+
+
 /*!
 	@function	CalcTriMeshVertState
 	@abstract	Fill in attribute data for a vertex of a decomposed TriMesh.
@@ -1008,22 +1034,6 @@ static bool IsSimplyTransparent(
 }
 
 
-static TQ3Area ScreenAreaOfBounds( TQ3ViewObject inView, const TQ3BoundingBox& inLocalBounds )
-{
-	// Get the corners of the bounds.
-	TQ3Point3D	localCorners[8];
-	E3BoundingBox_GetCorners( &inLocalBounds, localCorners );
-
-	// Transform corners to screen space.
-	TQ3Point2D screenCorners[8];
-	E3View_TransformArrayLocalToWindow( inView, 8, localCorners, screenCorners );
-
-	// Get area
-	TQ3Area theArea = E3Area_SetFromPoints2D( 8, screenCorners );
-	return theArea;
-}
-
-
 /*!
 	@function	RenderSlowPathTriMesh
 	@abstract	When a TriMesh cannot be rendered on the fast path, break it up
@@ -1055,9 +1065,13 @@ void	QORenderer::Renderer::RenderSlowPathTriMesh(
 			Q3_MESSAGE_FMT("Transparent geometry '%s'", theName);
 		}
 	#endif
-		TQ3Area screenBounds = ScreenAreaOfBounds( inView, inGeomData.bBox );
-		TQ3Vector2D screenDimensions = screenBounds.max - screenBounds.min;
-		float screenArea = screenDimensions.x * screenDimensions.y;
+		TQ3Area screenBounds;
+		float screenArea = kQ3MaxFloat;
+		if (E3View_GetWindowAreaOfBounds( inView, inGeomData.bBox, screenBounds ))
+		{
+			TQ3Vector2D screenDimensions = screenBounds.max - screenBounds.min;
+			screenArea = screenDimensions.x * screenDimensions.y;
+		}
 		//Q3_MESSAGE_FMT("Screen area %f (%f x %f)", screenArea, screenWidth, screenHeight );
 		if (screenArea > 10.0f)
 		{
@@ -1553,6 +1567,7 @@ bool	QORenderer::Renderer::SubmitTriMesh(
 
 
 	// Look for a cached optimized geometry.
+	TQ3GeometryObject	origTriMesh = inTriMesh;
 	bool	wasValid;
 	CQ3ObjectRef	cachedGeom( GetCachedOptimizedTriMesh( inTriMesh,
 		wasValid ) );
@@ -1593,6 +1608,32 @@ bool	QORenderer::Renderer::SubmitTriMesh(
 		}
 	}
 
+	// A large TriMesh on the fast path is drawn from a copy reordered for
+	// the vertex cache, unless the application gave it a triangle strip.
+	// The copy records an empty strip so that its triangle list is drawn
+	// as it is.
+	CQ3ObjectRef		orderedGeom;
+	CLockTriMeshData	orderedLocker;
+	if ( (whyNotFastPath == kSlowPathMask_FastPath) &&
+		(! wasValid) &&
+		(inTriMesh != nullptr) &&
+		(inGeomData->numTriangles >= kMinTrianglesToCache) &&
+		IsAutomaticRenderOrderWanted( mRendererObject, origTriMesh ) )
+	{
+		orderedGeom = CQ3ObjectRef( Q3TriMesh_OptimizeForRendering( inTriMesh,
+			kQ3TriMeshRenderOrderMaskAll ) );
+
+		if (orderedGeom.isvalid())
+		{
+			CETriangleStripElement_SetData( orderedGeom.get(), 0, nullptr );
+			SetCachedOptimizedTriMesh( origTriMesh, orderedGeom.get() );
+			inGeomData = orderedLocker.Lock( orderedGeom.get() );
+			inTriMesh = orderedGeom.get();
+
+			whyNotFastPath = FindTriMeshData( *inGeomData, dataArrays );
+		}
+	}
+
 	// Special handling when shadow marking
 	if (mLights.IsShadowMarkingPass())
 	{
@@ -0,0 +1,809 @@
+/*  NAME:
+        Math Benchmark.cpp
+        
+    DESCRIPTION:
+        Times the math functions declared in QuesaMath.h, over several data
+        sizes and with each kernel set, and checks that every kernel set
+        gives the same results as the plain loops.
+
+        Results are printed as a table, or with --csv as comma-separated
+        values in nanoseconds per operation, so that they can be collected
+        and compared across Quesa versions. The exit status is 1 if any
+        kernel set gives different results from the plain loops.
+
+    COPYRIGHT:
+        Copyright (c) 2025, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "Quesa.h"
+#include "QuesaCamera.h"
+#include "QuesaMath.h"
+#include "QuesaView.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+
+
+
+
+//=============================================================================
+//      Constants
+//-----------------------------------------------------------------------------
+// Element counts: a small object, a typical mesh, and a large scene
+const TQ3Uns32 kSizes[]								= { 64, 4096, 262144 };
+const TQ3Uns32 kMaxElements							= 262144;
+
+// Each timed sample repeats an operation until it covers at least this many
+// elements, and the best of the samples is reported
+const TQ3Uns32 kElementsPerSample					= 262144;
+const TQ3Uns32 kNumSamples							= 7;
+
+const TQ3MathKernelSet kKernelSets[] = {
+	kQ3MathKernelSetScalar,
+	kQ3MathKernelSetSSE2,
+	kQ3MathKernelSetAVX2,
+	kQ3MathKernelSetNEON
+};
+
+const char* kKernelSetNames[] = {
+	"Automatic",
+	"Scalar",
+	"SSE2",
+	"AVX2",
+	"NEON"
+};
+
+
+
+
+
+//=============================================================================
+//      Types
+//-----------------------------------------------------------------------------
+// The data the functions work on
+struct BenchmarkData {
+	std::vector<TQ3Point3D>				points;
+	std::vector<TQ3Vector3D>			vectors;
+	std::vector<TQ3RationalPoint4D>		rationalPoints;
+	std::vector<TQ3Uns32>				triangleIndices;
+	std::vector<TQ3Matrix4x4>			affineMatrices;
+	std::vector<TQ3Matrix4x4>			projectiveMatrices;
+	std::vector<TQ3Uns32>				parentIndices;
+	std::vector<TQ3Quaternion>			quaternions1;
+	std::vector<TQ3Quaternion>			quaternions2;
+	std::vector<float>					weights;
+	std::vector<TQ3Vector3D>			scales;
+	std::vector<TQ3Ray3D>				rays;
+	std::vector<TQ3BoundingBox>			boxes;
+	std::vector<TQ3Sphere>				spheres;
+	TQ3Matrix4x4						affineMatrix;
+	TQ3Matrix4x4						projectiveMatrix;
+	TQ3ViewObject						view;
+};
+
+
+// The results of the functions, kept to compare kernel sets
+struct BenchmarkResults {
+	std::vector<TQ3Point3D>				points;
+	std::vector<TQ3RationalPoint4D>		rationalPoints;
+	std::vector<TQ3Vector3D>			vectors;
+	std::vector<float>					dots;
+	std::vector<TQ3Boolean>				dotSigns;
+	std::vector<TQ3Matrix4x4>			matrices;
+	std::vector<TQ3Quaternion>			quaternions;
+	std::vector<TQ3Boolean>				hits;
+	std::vector<TQ3Param3D>				params;
+	TQ3BoundingBox						bounds;
+	TQ3BoundingSphere					sphere;
+};
+
+
+// One timed operation, applied to the first inCount elements of the data
+typedef void (*BenchmarkProc)(const BenchmarkData& inData, TQ3Uns32 inCount,
+								BenchmarkResults& ioResults);
+
+struct Benchmark {
+	const char*							name;
+	BenchmarkProc						proc;
+	bool								usesKernels;
+};
+
+
+
+
+
+//=============================================================================
+//      Internal functions
+//-----------------------------------------------------------------------------
+//      Initialize : Initialize ourselves.
+//-----------------------------------------------------------------------------
+static void
+Initialize(void)
+{
+
+
+	// Initialize Quesa
+	TQ3Status qd3dStatus = Q3Initialize();
+	if (qd3dStatus != kQ3Success)
+		exit(-1);
+}
+
+
+
+
+
+//=============================================================================
+//      Terminate : Terminate ourselves.
+//-----------------------------------------------------------------------------
+static void
+Terminate(void)
+{
+	// Terminate Quesa
+	Q3Exit();
+}
+
+
+
+
+
+//=============================================================================
+//      RandomFloat : Return a random number between -100 and 100.
+//-----------------------------------------------------------------------------
+static float
+RandomFloat(void)
+{
+	return (rand() / (float) RAND_MAX) * 200.0f - 100.0f;
+}
+
+
+
+
+
+//=============================================================================
+//      RandomQuaternion : Return a random unit quaternion.
+//-----------------------------------------------------------------------------
+static TQ3Quaternion
+RandomQuaternion(void)
+{	TQ3Quaternion	theQuaternion;
+
+
+
+	Q3Quaternion_Set( &theQuaternion, RandomFloat(), RandomFloat(), RandomFloat(), RandomFloat() );
+	Q3Quaternion_Normalize( &theQuaternion, &theQuaternion );
+	
+	return theQuaternion;
+}
+
+
+
+
+
+//=============================================================================
+//      MakeView : Make a view with a camera, for the frustum tests.
+//-----------------------------------------------------------------------------
+static TQ3ViewObject
+MakeView(void)
+{	TQ3ViewAngleAspectCameraData	cameraData;
+	TQ3CameraObject					theCamera;
+	TQ3ViewObject					theView;
+
+
+
+	Q3Point3D_Set(  &cameraData.cameraData.placement.cameraLocation,  0.0f, 0.0f, 300.0f );
+	Q3Point3D_Set(  &cameraData.cameraData.placement.pointOfInterest, 0.0f, 0.0f, 0.0f );
+	Q3Vector3D_Set( &cameraData.cameraData.placement.upVector,        0.0f, 1.0f, 0.0f );
+
+	cameraData.cameraData.range.hither = 1.0f;
+	cameraData.cameraData.range.yon    = 1000.0f;
+
+	cameraData.cameraData.viewPort.origin.x = -1.0f;
+	cameraData.cameraData.viewPort.origin.y =  1.0f;
+	cameraData.cameraData.viewPort.width    =  2.0f;
+	cameraData.cameraData.viewPort.height   =  2.0f;
+
+	cameraData.fov             = 1.0f;
+	cameraData.aspectRatioXToY = 1.0f;
+
+	theView   = Q3View_New();
+	theCamera = Q3ViewAngleAspectCamera_New( &cameraData );
+	if (theView == nullptr || theCamera == nullptr)
+		exit(-1);
+
+	Q3View_SetCamera( theView, theCamera );
+	Q3Object_Dispose( theCamera );
+	
+	return theView;
+}
+
+
+
+
+
+//=============================================================================
+//      MakeData : Fill in the benchmark data.
+//-----------------------------------------------------------------------------
+static void
+MakeData(BenchmarkData& outData)
+{	TQ3Matrix4x4	theRotation, theTranslation, thePerspective;
+	TQ3Vector3D		theAxis = { 1.0f, 2.0f, 3.0f };
+	TQ3Point3D		theOrigin = { 0.0f, 0.0f, 0.0f };
+	TQ3Point3D		theTarget;
+	TQ3Vector3D		theSize;
+	TQ3Uns32		n;
+
+
+
+	srand( 1 );
+	
+	outData.points.resize( kMaxElements );
+	outData.vectors.resize( kMaxElements );
+	outData.rationalPoints.resize( kMaxElements );
+	outData.triangleIndices.resize( kMaxElements * 3 );
+	
+	for (n = 0; n < kMaxElements; ++n)
+		{
+		Q3Point3D_Set( &outData.points[n], RandomFloat(), RandomFloat(), RandomFloat() );
+		Q3Vector3D_Set( &outData.vectors[n], RandomFloat(), RandomFloat(), RandomFloat() );
+		Q3RationalPoint4D_Set( &outData.rationalPoints[n], RandomFloat(), RandomFloat(),
+								RandomFloat(), 1.0f );
+		}
+	
+	for (n = 0; n < kMaxElements * 3; ++n)
+		outData.triangleIndices[n] = (TQ3Uns32) rand() % kMaxElements;
+
+
+
+	// An affine matrix, and a projective one with a nonzero last column
+	Q3Vector3D_Normalize( &theAxis, &theAxis );
+	Q3Matrix4x4_SetRotateAboutAxis( &theRotation, &theOrigin, &theAxis, 0.7f );
+	Q3Matrix4x4_SetTranslate( &theTranslation, 10.0f, -20.0f, 30.0f );
+	Q3Matrix4x4_Multiply( &theRotation, &theTranslation, &outData.affineMatrix );
+	
+	Q3Matrix4x4_SetIdentity( &thePerspective );
+	thePerspective.value[2][3] = 0.01f;
+	thePerspective.value[3][3] = 2.0f;
+	Q3Matrix4x4_Multiply( &outData.affineMatrix, &thePerspective, &outData.projectiveMatrix );
+
+
+
+	// Animation data: a skeleton where each bone has four children, and
+	// keyframes to blend between
+	outData.quaternions1.resize( kMaxElements );
+	outData.quaternions2.resize( kMaxElements );
+	outData.weights.resize( kMaxElements );
+	outData.scales.resize( kMaxElements );
+	outData.affineMatrices.resize( kMaxElements );
+	outData.projectiveMatrices.resize( kMaxElements );
+	outData.parentIndices.resize( kMaxElements );
+
+	for (n = 0; n < kMaxElements; ++n)
+		{
+		outData.quaternions1[n] = RandomQuaternion();
+		outData.quaternions2[n] = RandomQuaternion();
+		outData.weights[n]      = rand() / (float) RAND_MAX;
+		Q3Vector3D_Set( &outData.scales[n], 1.0f + RandomFloat() * 0.001f,
+			1.0f + RandomFloat() * 0.001f, 1.0f + RandomFloat() * 0.001f );
+		outData.parentIndices[n] = (n == 0) ? kQ3ArrayIndexNULL : (n - 1) / 4;
+		}
+
+	Q3Matrix4x4_SetQuaternionArray( outData.affineMatrices.data(), outData.quaternions1.data(),
+		outData.scales.data(), outData.vectors.data(), kMaxElements );
+	Q3Matrix4x4_MultiplyArray( outData.affineMatrices.data(), &thePerspective,
+		outData.projectiveMatrices.data(), kMaxElements, sizeof(TQ3Matrix4x4), 0,
+		sizeof(TQ3Matrix4x4) );
+
+
+
+	// Rays from outside the points towards them, and boxes and spheres
+	// spread out enough that some fall outside the camera's view
+	outData.rays.resize( kMaxElements );
+	outData.boxes.resize( kMaxElements );
+	outData.spheres.resize( kMaxElements );
+
+	for (n = 0; n < kMaxElements; ++n)
+		{
+		Q3Point3D_Set( &outData.rays[n].origin, RandomFloat() * 3.0f, RandomFloat() * 3.0f, 300.0f );
+		Q3Point3D_Set( &theTarget, RandomFloat(), RandomFloat(), RandomFloat() );
+		Q3Point3D_Subtract( &theTarget, &outData.rays[n].origin, &outData.rays[n].direction );
+		Q3Vector3D_Normalize( &outData.rays[n].direction, &outData.rays[n].direction );
+
+		Q3Point3D_Set( &outData.spheres[n].origin, RandomFloat() * 3.0f, RandomFloat() * 3.0f,
+			RandomFloat() );
+		outData.spheres[n].radius = 1.0f + fabsf( RandomFloat() ) * 0.2f;
+
+		Q3Vector3D_Set( &theSize, outData.spheres[n].radius, outData.spheres[n].radius,
+			outData.spheres[n].radius );
+		Q3Point3D_Vector3D_Subtract( &outData.spheres[n].origin, &theSize, &outData.boxes[n].min );
+		Q3Point3D_Vector3D_Add( &outData.spheres[n].origin, &theSize, &outData.boxes[n].max );
+		outData.boxes[n].isEmpty = kQ3False;
+		}
+	
+	outData.view = MakeView();
+}
+
+
+
+
+
+//=============================================================================
+//      Benchmark procs : The operations to time.
+//-----------------------------------------------------------------------------
+//		Note :	Operations without an array form are called once per element.
+//-----------------------------------------------------------------------------
+#pragma mark -
+static void
+Point3DAffine(const BenchmarkData& inData, TQ3Uns32 inCount, BenchmarkResults& ioResults)
+{
+	ioResults.points.resize( inCount );
+	Q3Point3D_To3DTransformArray( inData.points.data(), &inData.affineMatrix,
+		ioResults.points.data(), inCount, sizeof(TQ3Point3D), sizeof(TQ3Point3D) );
+}
+
+static void
+Point3DProjective(const BenchmarkData& inData, TQ3Uns32 inCount, BenchmarkResults& ioResults)
+{
+	ioResults.points.resize( inCount );
+	Q3Point3D_To3DTransformArray( inData.points.data(), &inData.projectiveMatrix,
+		ioResults.points.data(), inCount, sizeof(TQ3Point3D), sizeof(TQ3Point3D) );
+}
+
+static void
+Point3DTo4D(const BenchmarkData& inData, TQ3Uns32 inCount, BenchmarkResults& ioResults)
+{
+	ioResults.rationalPoints.resize( inCount );
+	Q3Point3D_To4DTransformArray( inData.points.data(), &inData.projectiveMatrix,
+		ioResults.rationalPoints.data(), inCount, sizeof(TQ3Point3D),
+		sizeof(TQ3RationalPoint4D) );
+}
+
+static void
+Vector3DTo3D(const BenchmarkData& inData, TQ3Uns32 inCount, BenchmarkResults& ioResults)
+{
+	ioResults.vectors.resize( inCount );
+	Q3Vector3D_To3DTransformArray( inData.vectors.data(), &inData.affineMatrix,
+		ioResults.vectors.data(), inCount, sizeof(TQ3Vector3D), sizeof(TQ3Vector3D) );
+}
+
+static void
+RationalPoint4DTo4D(const BenchmarkData& inData, TQ3Uns32 inCount, BenchmarkResults& ioResults)
+{
+	ioResults.rationalPoints.resize( inCount );
+	Q3RationalPoint4D_To4DTransformArray( inData.rationalPoints.data(),
+		&inData.projectiveMatrix, ioResults.rationalPoints.data(), inCount,
+		sizeof(TQ3RationalPoint4D), sizeof(TQ3RationalPoint4D) );
+}
+
+static void
+Vector3DDot(const BenchmarkData& inData, TQ3Uns32 inCount, BenchmarkResults& ioResults)
+{
+	ioResults.dots.resize( inCount );
+	ioResults.dotSigns.resize( inCount );
+	Q3Vector3D_DotArray( inData.vectors.data(), (const TQ3Vector3D*) inData.points.data(),
+		ioResults.dots.data(), ioResults.dotSigns.data(), inCount,
+		sizeof(TQ3Vector3D), sizeof(float), sizeof(TQ3Boolean) );
+}
+
+static void
+TriangleNormals(const BenchmarkData& inData, TQ3Uns32 inCount, BenchmarkResults& ioResults)
+{
+	ioResults.vectors.resize( inCount );
+	Q3Triangle_CrossProductArray( inCount, nullptr, inData.triangleIndices.data(),
+		inData.points.data(), ioResults.vectors.data() );
+}
+
+static void
+MatrixMultiply(const BenchmarkData& inData, TQ3Uns32 inCount, BenchmarkResults& ioResults)
+{	TQ3Uns32	n;
+
+
+
+	ioResults.matrices.resize( inCount );
+	for (n = 0; n < inCount; ++n)
+		Q3Matrix4x4_Multiply( &inData.affineMatrices[n], &inData.projectiveMatrix,
+			&ioResults.matrices[n] );
+}
+
+static void
+MatrixMultiplyArray(const BenchmarkData& inData, TQ3Uns32 inCount, BenchmarkResults& ioResults)
+{
+	ioResults.matrices.resize( inCount );
+	Q3Matrix4x4_MultiplyArray( inData.affineMatrices.data(), &inData.projectiveMatrix,
+		ioResults.matrices.data(), inCount, sizeof(TQ3Matrix4x4), 0, sizeof(TQ3Matrix4x4) );
+}
+
+static void
+MatrixInvertAffine(const BenchmarkData& inData, TQ3Uns32 inCount, BenchmarkResults& ioResults)
+{	TQ3Uns32	n;
+
+
+
+	ioResults.matrices.resize( inCount );
+	for (n = 0; n < inCount; ++n)
+		Q3Matrix4x4_Invert( &inData.affineMatrices[n], &ioResults.matrices[n] );
+}
+
+static void
+MatrixInvertProjective(const BenchmarkData& inData, TQ3Uns32 inCount, BenchmarkResults& ioResults)
+{	TQ3Uns32	n;
+
+
+
+	ioResults.matrices.resize( inCount );
+	for (n = 0; n < inCount; ++n)
+		Q3Matrix4x4_Invert( &inData.projectiveMatrices[n], &ioResults.matrices[n] );
+}
+
+static void
+ComposeHierarchy(const BenchmarkData& inData, TQ3Uns32 inCount, BenchmarkResults& ioResults)
+{
+	ioResults.matrices.resize( inCount );
+	Q3Matrix4x4_ComposeHierarchy( inData.affineMatrices.data(), inData.parentIndices.data(),
+		inCount, ioResults.matrices.data() );
+}
+
+static void
+BoundingBoxFromPoints(const BenchmarkData& inData, TQ3Uns32 inCount, BenchmarkResults& ioResults)
+{
+	Q3BoundingBox_SetFromPoints3D( &ioResults.bounds, inData.points.data(), inCount,
+		sizeof(TQ3Point3D) );
+}
+
+static void
+BoundingSphereFromPoints(const BenchmarkData& inData, TQ3Uns32 inCount, BenchmarkResults& ioResults)
+{
+	Q3BoundingSphere_SetFromPoints3D( &ioResults.sphere, inData.points.data(), inCount,
+		sizeof(TQ3Point3D) );
+}
+
+static void
+RayTriangle(const BenchmarkData& inData, TQ3Uns32 inCount, BenchmarkResults& ioResults)
+{	const TQ3Uns32	*theIndices = inData.triangleIndices.data();
+	TQ3Uns32		n;
+
+
+
+	ioResults.hits.resize( inCount );
+	ioResults.params.resize( inCount );
+	for (n = 0; n < inCount; ++n)
+		ioResults.hits[n] = Q3Ray3D_IntersectTriangle( &inData.rays[n],
+			&inData.points[ theIndices[n * 3 + 0] ], &inData.points[ theIndices[n * 3 + 1] ],
+			&inData.points[ theIndices[n * 3 + 2] ], kQ3False, &ioResults.params[n] );
+}
+
+static void
+RayBoundingBox(const BenchmarkData& inData, TQ3Uns32 inCount, BenchmarkResults& ioResults)
+{	TQ3Uns32	n;
+
+
+
+	ioResults.hits.resize( inCount );
+	ioResults.points.resize( inCount );
+	for (n = 0; n < inCount; ++n)
+		ioResults.hits[n] = Q3Ray3D_IntersectBoundingBox( &inData.rays[n], &inData.boxes[n],
+			&ioResults.points[n] );
+}
+
+static void
+RaySphere(const BenchmarkData& inData, TQ3Uns32 inCount, BenchmarkResults& ioResults)
+{	TQ3Uns32	n;
+
+
+
+	ioResults.hits.resize( inCount );
+	ioResults.points.resize( inCount );
+	for (n = 0; n < inCount; ++n)
+		ioResults.hits[n] = Q3Ray3D_IntersectSphere( &inData.rays[n], &inData.spheres[n],
+			&ioResults.points[n] );
+}
+
+static void
+BoundingBoxFrustum(const BenchmarkData& inData, TQ3Uns32 inCount, BenchmarkResults& ioResults)
+{	TQ3BoundingBox	theBounds;
+	TQ3Uns32		n;
+
+
+
+	// The view only has frustum planes while it is submitting
+	ioResults.hits.resize( inCount );
+	if (Q3View_StartBoundingBox( inData.view, kQ3ComputeBoundsApproximate ) != kQ3Success)
+		return;
+	
+	do
+		{
+		for (n = 0; n < inCount; ++n)
+			ioResults.hits[n] = Q3View_IsBoundingBoxVisible( inData.view, &inData.boxes[n] );
+		}
+	while (Q3View_EndBoundingBox( inData.view, &theBounds ) == kQ3ViewStatusRetraverse);
+}
+
+static void
+QuaternionMultiply(const BenchmarkData& inData, TQ3Uns32 inCount, BenchmarkResults& ioResults)
+{	TQ3Uns32	n;
+
+
+
+	ioResults.quaternions.resize( inCount );
+	for (n = 0; n < inCount; ++n)
+		Q3Quaternion_Multiply( &inData.quaternions1[n], &inData.quaternions2[n],
+			&ioResults.quaternions[n] );
+}
+
+static void
+QuaternionInterpolateFast(const BenchmarkData& inData, TQ3Uns32 inCount, BenchmarkResults& ioResults)
+{	TQ3Uns32	n;
+
+
+
+	ioResults.quaternions.resize( inCount );
+	for (n = 0; n < inCount; ++n)
+		Q3Quaternion_InterpolateFast( &inData.quaternions1[n], &inData.quaternions2[n],
+			inData.weights[n], &ioResults.quaternions[n] );
+}
+
+static void
+QuaternionInterpolateLinear(const BenchmarkData& inData, TQ3Uns32 inCount, BenchmarkResults& ioResults)
+{	TQ3Uns32	n;
+
+
+
+	ioResults.quaternions.resize( inCount );
+	for (n = 0; n < inCount; ++n)
+		Q3Quaternion_InterpolateLinear( &inData.quaternions1[n], &inData.quaternions2[n],
+			inData.weights[n], &ioResults.quaternions[n] );
+}
+
+static void
+QuaternionInterpolateFastArray(const BenchmarkData& inData, TQ3Uns32 inCount, BenchmarkResults& ioResults)
+{
+	ioResults.quaternions.resize( inCount );
+	Q3Quaternion_InterpolateFastArray( inData.quaternions1.data(), inData.quaternions2.data(),
+		inData.weights.data(), inCount, ioResults.quaternions.data() );
+}
+
+static void
+QuaternionToMatrixArray(const BenchmarkData& inData, TQ3Uns32 inCount, BenchmarkResults& ioResults)
+{
+	ioResults.matrices.resize( inCount );
+	Q3Matrix4x4_SetQuaternionArray( ioResults.matrices.data(), inData.quaternions1.data(),
+		inData.scales.data(), inData.vectors.data(), inCount );
+}
+
+static void
+VectorTransformQuaternion(const BenchmarkData& inData, TQ3Uns32 inCount, BenchmarkResults& ioResults)
+{	TQ3Uns32	n;
+
+
+
+	ioResults.vectors.resize( inCount );
+	for (n = 0; n < inCount; ++n)
+		Q3Vector3D_TransformQuaternion( &inData.vectors[n], &inData.quaternions1[n],
+			&ioResults.vectors[n] );
+}
+
+const Benchmark kBenchmarks[] = {
+	{ "Q3Point3D_To3DTransformArray (affine)",		Point3DAffine,					true  },
+	{ "Q3Point3D_To3DTransformArray (projective)",	Point3DProjective,				true  },
+	{ "Q3Point3D_To4DTransformArray",				Point3DTo4D,					true  },
+	{ "Q3Vector3D_To3DTransformArray",				Vector3DTo3D,					true  },
+	{ "Q3RationalPoint4D_To4DTransformArray",		RationalPoint4DTo4D,			true  },
+	{ "Q3Vector3D_DotArray",						Vector3DDot,					true  },
+	{ "Q3Triangle_CrossProductArray",				TriangleNormals,				true  },
+	{ "Q3Matrix4x4_Multiply",						MatrixMultiply,					true  },
+	{ "Q3Matrix4x4_MultiplyArray",					MatrixMultiplyArray,			true  },
+	{ "Q3Matrix4x4_Invert (affine)",				MatrixInvertAffine,				false },
+	{ "Q3Matrix4x4_Invert (projective)",			MatrixInvertProjective,			false },
+	{ "Q3Matrix4x4_ComposeHierarchy",				ComposeHierarchy,				true  },
+	{ "Q3BoundingBox_SetFromPoints3D",				BoundingBoxFromPoints,			false },
+	{ "Q3BoundingSphere_SetFromPoints3D",			BoundingSphereFromPoints,		false },
+	{ "Q3Ray3D_IntersectTriangle",					RayTriangle,					false },
+	{ "Q3Ray3D_IntersectBoundingBox",				RayBoundingBox,					false },
+	{ "Q3Ray3D_IntersectSphere",					RaySphere,						false },
+	{ "Q3View_IsBoundingBoxVisible",				BoundingBoxFrustum,				false },
+	{ "Q3Quaternion_Multiply",						QuaternionMultiply,				false },
+	{ "Q3Quaternion_InterpolateFast",				QuaternionInterpolateFast,		false },
+	{ "Q3Quaternion_InterpolateLinear",				QuaternionInterpolateLinear,	false },
+	{ "Q3Quaternion_InterpolateFastArray",			QuaternionInterpolateFastArray,	true  },
+	{ "Q3Matrix4x4_SetQuaternionArray",				QuaternionToMatrixArray,		true  },
+	{ "Q3Vector3D_TransformQuaternion",				VectorTransformQuaternion,		false }
+};
+
+
+
+
+
+//=============================================================================
+//      SameResults : Are two sets of results bit for bit the same?
+//-----------------------------------------------------------------------------
+template <typename T>
+static bool
+SameBits(const std::vector<T>& inA, const std::vector<T>& inB)
+{
+	return inA.size() == inB.size() &&
+		(inA.empty() || memcmp( inA.data(), inB.data(), inA.size() * sizeof(T) ) == 0);
+}
+
+static bool
+SameResults(const BenchmarkResults& inA, const BenchmarkResults& inB)
+{
+	return SameBits( inA.points, inB.points ) &&
+		SameBits( inA.rationalPoints, inB.rationalPoints ) &&
+		SameBits( inA.vectors, inB.vectors ) &&
+		SameBits( inA.dots, inB.dots ) &&
+		SameBits( inA.dotSigns, inB.dotSigns ) &&
+		SameBits( inA.matrices, inB.matrices ) &&
+		SameBits( inA.quaternions, inB.quaternions ) &&
+		SameBits( inA.hits, inB.hits ) &&
+		SameBits( inA.params, inB.params );
+}
+
+
+
+
+
+//=============================================================================
+//      TimeBenchmark : Time one operation, return the best ns per element.
+//-----------------------------------------------------------------------------
+static double
+TimeBenchmark(const Benchmark& inBenchmark, const BenchmarkData& inData,
+				TQ3Uns32 inCount, BenchmarkResults& outResults)
+{	TQ3Uns32	numRepeats = std::max( 1U, kElementsPerSample / inCount );
+	double		bestTime = 0.0;
+	TQ3Uns32	n, r;
+
+
+
+	for (n = 0; n < kNumSamples; ++n)
+		{
+		auto startTime = std::chrono::steady_clock::now();
+		for (r = 0; r < numRepeats; ++r)
+			inBenchmark.proc( inData, inCount, outResults );
+		std::chrono::duration<double, std::nano> theTime =
+			std::chrono::steady_clock::now() - startTime;
+		
+		double nsPerElement = theTime.count() / ((double) numRepeats * inCount);
+		if (n == 0 || nsPerElement < bestTime)
+			bestTime = nsPerElement;
+		}
+	
+	return bestTime;
+}
+
+
+
+
+
+//=============================================================================
+//      Public functions
+//-----------------------------------------------------------------------------
+//      main : Entry point.
+//-----------------------------------------------------------------------------
+#pragma mark -
+int
+main(int argc, char *argv[])
+{	BenchmarkData		theData;
+	bool				wantCSV = (argc > 1 && strcmp( argv[1], "--csv" ) == 0);
+	bool				allSame = true;
+	TQ3Uns32			majorVersion = 0, minorVersion = 0;
+
+
+
+	// Initialise ourselves
+	Initialize();
+	MakeData( theData );
+	
+	Q3GetVersion( &majorVersion, &minorVersion );
+	Q3Math_SetKernelSet( kQ3MathKernelSetAutomatic );
+	TQ3MathKernelSet automaticSet = Q3Math_GetKernelSet();
+	
+	if (wantCSV)
+		{
+		printf( "# Quesa %u.%u, automatic kernel set %s\n", majorVersion, minorVersion,
+			kKernelSetNames[ automaticSet ] );
+		printf( "benchmark,count,kernels,ns_per_op,mops_per_s,matches_scalar\n" );
+		}
+	else
+		{
+		printf( "Quesa %u.%u, automatic kernel set %s\n", majorVersion, minorVersion,
+			kKernelSetNames[ automaticSet ] );
+		printf( "Best of %u samples of at least %u elements\n\n", kNumSamples, kElementsPerSample );
+		}
+
+
+
+	// Time each operation at each size, with each kernel set the processor
+	// supports if the operation has kernels
+	for (const Benchmark& theBenchmark : kBenchmarks)
+		{
+		if (! wantCSV)
+			printf( "%s\n", theBenchmark.name );
+		
+		for (TQ3Uns32 theCount : kSizes)
+			{
+			BenchmarkResults	scalarResults;
+			double				scalarTime = 0.0;
+			
+			for (TQ3MathKernelSet theSet : kKernelSets)
+				{
+				if (! theBenchmark.usesKernels)
+					theSet = automaticSet;
+				else if (Q3Math_SetKernelSet( theSet ) != kQ3Success)
+					continue;
+				
+				BenchmarkResults	theResults;
+				double				theTime = TimeBenchmark( theBenchmark, theData, theCount, theResults );
+				bool				isSame = true;
+				
+				if (theSet == kQ3MathKernelSetScalar || ! theBenchmark.usesKernels)
+					{
+					scalarTime    = theTime;
+					scalarResults = theResults;
+					}
+				else
+					isSame = SameResults( scalarResults, theResults );
+				
+				allSame = allSame && isSame;
+				
+				if (wantCSV)
+					printf( "%s,%u,%s,%.3f,%.3f,%d\n", theBenchmark.name, theCount,
+						kKernelSetNames[ theSet ], theTime, 1000.0 / theTime, isSame ? 1 : 0 );
+				else
+					printf( "    %7u  %-9s %9.3f ns/op  %9.1f Mops/s  x%.2f%s\n",
+						theCount, kKernelSetNames[ theSet ], theTime, 1000.0 / theTime,
+						scalarTime / theTime, isSame ? "" : "  RESULTS DIFFER" );
+				
+				if (! theBenchmark.usesKernels)
+					break;
+				}
+			}
+		}
+
+
+
+	// Clean up
+	Q3Math_SetKernelSet( kQ3MathKernelSetAutomatic );
+	Q3Object_Dispose( theData.view );
+	Terminate();
+	
+	return allSame ? 0 : 1;
+}
@@ -0,0 +1,449 @@
+/*  NAME:
+        Pick Benchmark.cpp
+
+    DESCRIPTION:
+        Times window-rect picks of a large scene, with and without a pick
+        tree built by Q3Group_BuildPickTree, and checks that both find the
+        same objects.
+
+        The scene is a grid of display groups, most holding a dense TriMesh
+        and some a box. Rects of several sizes are picked at random places
+        in the window. The exit status is 1 if the picks with the tree hit
+        different objects from the picks without it.
+
+    COPYRIGHT:
+        Copyright (c) 2025, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "Quesa.h"
+#include "QuesaCamera.h"
+#include "QuesaDrawContext.h"
+#include "QuesaGeometry.h"
+#include "QuesaGroup.h"
+#include "QuesaMath.h"
+#include "QuesaPick.h"
+#include "QuesaTransform.h"
+#include "QuesaView.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+
+
+
+
+//=============================================================================
+//      Constants
+//-----------------------------------------------------------------------------
+// The window, in pixels
+const TQ3Uns32 kWindowSize							= 512;
+
+// The scene is a grid of kGridSize by kGridSize objects, each TriMesh a grid
+// of kMeshSize by kMeshSize quads
+const TQ3Uns32 kGridSize							= 40;
+const TQ3Uns32 kMeshSize							= 12;
+
+// Rect sizes in pixels, and how many rects of each size are picked
+const float kRectSizes[]							= { 4.0f, 32.0f, 128.0f, 384.0f };
+const TQ3Uns32 kNumRects							= 40;
+
+
+
+
+
+//=============================================================================
+//      Types
+//-----------------------------------------------------------------------------
+// The results of a set of picks, kept to compare the two ways of picking
+struct PickResults {
+	std::vector<TQ3Object>				objects;
+	TQ3Uns32							numHits;
+};
+
+
+
+
+
+//=============================================================================
+//      Internal functions
+//-----------------------------------------------------------------------------
+//      Initialize : Initialize ourselves.
+//-----------------------------------------------------------------------------
+static void
+Initialize(void)
+{
+
+
+	// Initialize Quesa
+	TQ3Status qd3dStatus = Q3Initialize();
+	if (qd3dStatus != kQ3Success)
+		exit(-1);
+}
+
+
+
+
+
+//=============================================================================
+//      Terminate : Terminate ourselves.
+//-----------------------------------------------------------------------------
+static void
+Terminate(void)
+{
+	// Terminate Quesa
+	Q3Exit();
+}
+
+
+
+
+
+//=============================================================================
+//      RandomFloat : Return a random number between 0 and 1.
+//-----------------------------------------------------------------------------
+static float
+RandomFloat(void)
+{
+	return rand() / (float) RAND_MAX;
+}
+
+
+
+
+
+//=============================================================================
+//      MakeView : Make a view with a camera and a pixmap draw context.
+//-----------------------------------------------------------------------------
+static TQ3ViewObject
+MakeView(std::vector<TQ3Uns32>& ioPixels)
+{	TQ3ViewAngleAspectCameraData	cameraData;
+	TQ3PixmapDrawContextData		drawContextData = {};
+	TQ3CameraObject					theCamera;
+	TQ3DrawContextObject			theDrawContext;
+	TQ3ViewObject					theView;
+
+
+
+	Q3Point3D_Set(  &cameraData.cameraData.placement.cameraLocation,  6.0f, -8.0f, 55.0f );
+	Q3Point3D_Set(  &cameraData.cameraData.placement.pointOfInterest, 0.0f, 0.0f, 0.0f );
+	Q3Vector3D_Set( &cameraData.cameraData.placement.upVector,        0.0f, 1.0f, 0.0f );
+
+	cameraData.cameraData.range.hither = 1.0f;
+	cameraData.cameraData.range.yon    = 1000.0f;
+
+	cameraData.cameraData.viewPort.origin.x = -1.0f;
+	cameraData.cameraData.viewPort.origin.y =  1.0f;
+	cameraData.cameraData.viewPort.width    =  2.0f;
+	cameraData.cameraData.viewPort.height   =  2.0f;
+
+	cameraData.fov             = 1.0f;
+	cameraData.aspectRatioXToY = 1.0f;
+
+	ioPixels.resize( kWindowSize * kWindowSize );
+
+	drawContextData.drawContextData.clearImageMethod  = kQ3ClearMethodWithColor;
+	drawContextData.drawContextData.paneState         = kQ3False;
+	drawContextData.drawContextData.maskState         = kQ3False;
+	drawContextData.drawContextData.doubleBufferState = kQ3False;
+	drawContextData.pixmap.image     = ioPixels.data();
+	drawContextData.pixmap.width     = kWindowSize;
+	drawContextData.pixmap.height    = kWindowSize;
+	drawContextData.pixmap.rowBytes  = kWindowSize * 4;
+	drawContextData.pixmap.pixelSize = 32;
+	drawContextData.pixmap.pixelType = kQ3PixelTypeARGB32;
+	drawContextData.pixmap.bitOrder  = kQ3EndianBig;
+	drawContextData.pixmap.byteOrder = kQ3EndianBig;
+
+	theView        = Q3View_New();
+	theCamera      = Q3ViewAngleAspectCamera_New( &cameraData );
+	theDrawContext = Q3PixmapDrawContext_New( &drawContextData );
+	if (theView == nullptr || theCamera == nullptr || theDrawContext == nullptr)
+		exit(-1);
+
+	Q3View_SetCamera( theView, theCamera );
+	Q3View_SetDrawContext( theView, theDrawContext );
+	Q3Object_Dispose( theCamera );
+	Q3Object_Dispose( theDrawContext );
+
+	return theView;
+}
+
+
+
+
+
+//=============================================================================
+//      MakeTriMesh : Make a bumpy square TriMesh.
+//-----------------------------------------------------------------------------
+static TQ3GeometryObject
+MakeTriMesh(void)
+{	std::vector<TQ3Point3D>			thePoints;
+	std::vector<TQ3TriMeshTriangleData>	theTriangles;
+	TQ3TriMeshData					triMeshData = {};
+	TQ3Uns32						x, y;
+
+
+
+	for (y = 0; y <= kMeshSize; ++y)
+		{
+		for (x = 0; x <= kMeshSize; ++x)
+			{
+			float u = x / (float) kMeshSize;
+			float v = y / (float) kMeshSize;
+			TQ3Point3D thePoint = { u, v, 0.1f * sinf( 6.0f * u ) * cosf( 5.0f * v ) };
+			thePoints.push_back( thePoint );
+			}
+		}
+
+	for (y = 0; y < kMeshSize; ++y)
+		{
+		for (x = 0; x < kMeshSize; ++x)
+			{
+			TQ3Uns32 n = y * (kMeshSize + 1) + x;
+			TQ3TriMeshTriangleData lowerTriangle = { { n, n + 1, n + kMeshSize + 2 } };
+			TQ3TriMeshTriangleData upperTriangle = { { n, n + kMeshSize + 2, n + kMeshSize + 1 } };
+			theTriangles.push_back( lowerTriangle );
+			theTriangles.push_back( upperTriangle );
+			}
+		}
+
+	triMeshData.numPoints    = (TQ3Uns32) thePoints.size();
+	triMeshData.points       = thePoints.data();
+	triMeshData.numTriangles = (TQ3Uns32) theTriangles.size();
+	triMeshData.triangles    = theTriangles.data();
+	Q3BoundingBox_SetFromPoints3D( &triMeshData.bBox, triMeshData.points,
+		triMeshData.numPoints, sizeof(TQ3Point3D) );
+
+	return Q3TriMesh_New( &triMeshData );
+}
+
+
+
+
+
+//=============================================================================
+//      MakeScene : Make the scene to pick.
+//-----------------------------------------------------------------------------
+static TQ3GroupObject
+MakeScene(void)
+{	TQ3BoxData			boxData = {
+							{ 0.0f, 0.0f, 0.0f },
+							{ 0.8f, 0.0f, 0.0f },
+							{ 0.0f, 0.8f, 0.0f },
+							{ 0.0f, 0.0f, 0.4f },
+							nullptr, nullptr };
+	TQ3GroupObject		theScene;
+	TQ3GeometryObject	theTriMesh, theBox;
+	TQ3Uns32			x, y;
+
+
+
+	theScene   = Q3DisplayGroup_New();
+	theTriMesh = MakeTriMesh();
+	theBox     = Q3Box_New( &boxData );
+	if (theScene == nullptr || theTriMesh == nullptr || theBox == nullptr)
+		exit(-1);
+
+	for (y = 0; y < kGridSize; ++y)
+		{
+		for (x = 0; x < kGridSize; ++x)
+			{
+			TQ3Vector3D thePosition = {
+				1.25f * x - 0.625f * kGridSize,
+				1.25f * y - 0.625f * kGridSize,
+				4.0f * RandomFloat() - 2.0f };
+
+			TQ3GroupObject     theGroup     = Q3DisplayGroup_New();
+			TQ3TransformObject theTransform = Q3TranslateTransform_New( &thePosition );
+
+			Q3Group_AddObject( theGroup, theTransform );
+			Q3Group_AddObject( theGroup, ((x + y) % 5 == 0) ? theBox : theTriMesh );
+			Q3Group_AddObject( theScene, theGroup );
+
+			Q3Object_Dispose( theTransform );
+			Q3Object_Dispose( theGroup );
+			}
+		}
+
+	Q3Object_Dispose( theTriMesh );
+	Q3Object_Dispose( theBox );
+
+	return theScene;
+}
+
+
+
+
+
+//=============================================================================
+//      PickRects : Pick each rect, and time the picks.
+//-----------------------------------------------------------------------------
+static double
+PickRects(TQ3ViewObject inView, TQ3GroupObject inScene,
+			const std::vector<TQ3Area>& inRects, PickResults& outResults)
+{	TQ3WindowRectPickData	pickData;
+	TQ3PickObject			thePick;
+	TQ3Uns32				numHits, n;
+	TQ3Object				theObject;
+
+
+
+	outResults.objects.clear();
+	outResults.numHits = 0;
+
+	auto startTime = std::chrono::steady_clock::now();
+
+	for (const TQ3Area& theRect : inRects)
+		{
+		pickData.data.sort            = kQ3PickSortNone;
+		pickData.data.mask            = kQ3PickDetailMaskObject;
+		pickData.data.numHitsToReturn = kQ3ReturnAllHits;
+		pickData.rect                 = theRect;
+
+		thePick = Q3WindowRectPick_New( &pickData );
+		if (thePick == nullptr)
+			exit(-1);
+
+		if (Q3View_StartPicking( inView, thePick ) == kQ3Success)
+			{
+			do
+				{
+				Q3Object_Submit( inScene, inView );
+				}
+			while (Q3View_EndPicking( inView ) == kQ3ViewStatusRetraverse);
+			}
+
+		numHits = 0;
+		Q3Pick_GetNumHits( thePick, &numHits );
+		outResults.numHits += numHits;
+
+		for (n = 0; n < numHits; ++n)
+			{
+			theObject = nullptr;
+			Q3Pick_GetPickDetailData( thePick, n, kQ3PickDetailMaskObject, &theObject );
+			outResults.objects.push_back( theObject );
+			if (theObject != nullptr)
+				Q3Object_Dispose( theObject );
+			}
+
+		Q3Object_Dispose( thePick );
+		}
+
+	std::chrono::duration<double, std::milli> theTime =
+		std::chrono::steady_clock::now() - startTime;
+
+	return theTime.count();
+}
+
+
+
+
+
+//=============================================================================
+//      Public functions
+//-----------------------------------------------------------------------------
+//      main : Entry point.
+//-----------------------------------------------------------------------------
+#pragma mark -
+int
+main(void)
+{	std::vector<TQ3Uns32>	thePixels;
+	TQ3GroupPickTreeInfo	treeInfo;
+	PickResults				plainResults, treeResults;
+	TQ3Uns32				majorVersion = 0, minorVersion = 0;
+	bool					allSame = true;
+
+
+
+	// Initialise ourselves
+	Initialize();
+	srand( 1 );
+
+	TQ3ViewObject  theView  = MakeView( thePixels );
+	TQ3GroupObject theScene = MakeScene();
+
+	Q3GetVersion( &majorVersion, &minorVersion );
+	printf( "Quesa %u.%u, %u objects, %u triangles per TriMesh, %u x %u window\n\n",
+		majorVersion, minorVersion, kGridSize * kGridSize, 2 * kMeshSize * kMeshSize,
+		kWindowSize, kWindowSize );
+	printf( "%-10s %10s %14s %14s %10s\n", "rect", "hits", "no tree (ms)", "tree (ms)", "speedup" );
+
+
+
+	// Pick rects of each size, first by traversing the scene and then
+	// with a pick tree
+	for (float theSize : kRectSizes)
+		{
+		std::vector<TQ3Area> theRects;
+		for (TQ3Uns32 n = 0; n < kNumRects; ++n)
+			{
+			TQ3Area theRect;
+			theRect.min.x = RandomFloat() * (kWindowSize - theSize);
+			theRect.min.y = RandomFloat() * (kWindowSize - theSize);
+			theRect.max.x = theRect.min.x + theSize;
+			theRect.max.y = theRect.min.y + theSize;
+			theRects.push_back( theRect );
+			}
+
+		Q3Group_DisposePickTree( theScene );
+		double plainTime = PickRects( theView, theScene, theRects, plainResults );
+
+		if (Q3Group_BuildPickTree( theScene, &treeInfo ) != kQ3Success)
+			exit(-1);
+		double treeTime = PickRects( theView, theScene, theRects, treeResults );
+
+		bool isSame = (plainResults.objects == treeResults.objects);
+		allSame = allSame && isSame;
+
+		printf( "%4.0f x %-4.0f %10u %14.2f %14.2f %9.1fx%s\n", theSize, theSize,
+			treeResults.numHits, plainTime, treeTime, plainTime / treeTime,
+			isSame ? "" : "  MISMATCH" );
+		}
+
+
+
+	// Clean up
+	Q3Object_Dispose( theScene );
+	Q3Object_Dispose( theView );
+	Terminate();
+
+	return allSame ? 0 : 1;
+}
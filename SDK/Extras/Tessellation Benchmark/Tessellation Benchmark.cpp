@@ -0,0 +1,509 @@
+/*  NAME:
+        Tessellation Benchmark.cpp
+
+    DESCRIPTION:
+        Times the decomposition of GeneralPolygons and Polygons into
+        TriMeshes, and checks that each TriMesh covers the polygon.
+
+        The shapes cover each way a GeneralPolygon can be tessellated:
+        convex contours, which are fanned, concave contours, which have
+        their ears cut off, and contours with holes or self-intersections,
+        which go through the GLU tessellator. Convex shapes are also timed
+        as Polygons. The exit status is 1 if the triangles of any TriMesh
+        don't add up to the area of its polygon.
+
+    COPYRIGHT:
+        Copyright (c) 2026, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "Quesa.h"
+#include "QuesaGeometry.h"
+#include "QuesaMath.h"
+#include "QuesaView.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+
+
+
+
+//=============================================================================
+//      Constants
+//-----------------------------------------------------------------------------
+// Each shape is decomposed until about this many vertices have been processed
+const TQ3Uns32 kVerticesPerRun						= 200000;
+
+// How far the area of a TriMesh may be from the area of its polygon
+const double kAreaTolerance							= 1.0e-3;
+
+const double kPi									= 3.14159265358979323846;
+
+
+
+
+
+//=============================================================================
+//      Types
+//-----------------------------------------------------------------------------
+typedef std::vector<TQ3Point3D>		Contour;
+
+// A shape to decompose
+struct Shape {
+	const char*							name;
+	std::vector<Contour>				contours;
+	bool								isConvex;
+	bool								checkArea;
+};
+
+
+
+
+
+//=============================================================================
+//      Internal functions
+//-----------------------------------------------------------------------------
+//      Initialize : Initialize ourselves.
+//-----------------------------------------------------------------------------
+static void
+Initialize(void)
+{
+
+
+	// Initialize Quesa
+	TQ3Status qd3dStatus = Q3Initialize();
+	if (qd3dStatus != kQ3Success)
+		exit(-1);
+}
+
+
+
+
+
+//=============================================================================
+//      Terminate : Terminate ourselves.
+//-----------------------------------------------------------------------------
+static void
+Terminate(void)
+{
+	// Terminate Quesa
+	Q3Exit();
+}
+
+
+
+
+
+//=============================================================================
+//      MakeContour : Make a contour round the origin.
+//-----------------------------------------------------------------------------
+//		Note :	Even and odd vertices have their own radius, so the contour
+//				is a star unless the radii are the same. The contour turns
+//				to the left unless it is reversed.
+//-----------------------------------------------------------------------------
+static Contour
+MakeContour(TQ3Uns32 numVertices, float evenRadius, float oddRadius, bool isReversed = false)
+{	Contour		theContour;
+	TQ3Uns32	n;
+
+
+
+	for (n = 0; n < numVertices; ++n)
+		{
+		double theAngle  = 2.0 * kPi * n / numVertices;
+		float  theRadius = (n % 2 == 0) ? evenRadius : oddRadius;
+		TQ3Point3D thePoint = { theRadius * (float) cos( theAngle ), theRadius * (float) sin( theAngle ), 0.0f };
+		theContour.push_back( thePoint );
+		}
+
+	if (isReversed)
+		theContour.assign( theContour.rbegin(), theContour.rend() );
+
+	return theContour;
+}
+
+
+
+
+
+//=============================================================================
+//      MakeComb : Make a comb with thin teeth.
+//-----------------------------------------------------------------------------
+static Contour
+MakeComb(TQ3Uns32 numTeeth)
+{	Contour		theContour;
+	TQ3Uns32	n;
+
+
+
+	theContour.push_back( { 0.0f, 0.0f, 0.0f } );
+	theContour.push_back( { 2.0f * numTeeth, 0.0f, 0.0f } );
+
+	for (n = numTeeth; n > 0; --n)
+		{
+		float theLeft = 2.0f * (n - 1);
+		theContour.push_back( { theLeft + 1.5f, 8.0f, 0.0f } );
+		theContour.push_back( { theLeft + 1.0f, 1.0f, 0.0f } );
+		theContour.push_back( { theLeft + 0.5f, 8.0f, 0.0f } );
+		}
+
+	return theContour;
+}
+
+
+
+
+
+//=============================================================================
+//      MakeSpiral : Make a spiral strip.
+//-----------------------------------------------------------------------------
+static Contour
+MakeSpiral(TQ3Uns32 numVertices)
+{	Contour		theContour;
+	TQ3Uns32	n, numSide = numVertices / 2;
+
+
+
+	for (n = 0; n < numSide; ++n)
+		{
+		double theAngle = 0.05 * n;
+		double theRadius = 1.0 + 0.2 * theAngle;
+		theContour.push_back( { (float) (theRadius * cos( theAngle )), (float) (theRadius * sin( theAngle )), 0.0f } );
+		}
+
+	for (n = numSide; n > 0; --n)
+		{
+		double theAngle = 0.05 * (n - 1);
+		double theRadius = 1.5 + 0.2 * theAngle;
+		theContour.push_back( { (float) (theRadius * cos( theAngle )), (float) (theRadius * sin( theAngle )), 0.0f } );
+		}
+
+	return theContour;
+}
+
+
+
+
+
+//=============================================================================
+//      TiltShape : Move a shape off the coordinate planes.
+//-----------------------------------------------------------------------------
+static void
+TiltShape(Shape& ioShape)
+{	TQ3Matrix4x4	theMatrix;
+
+
+
+	Q3Matrix4x4_SetRotate_XYZ( &theMatrix, 0.4f, 0.9f, 0.2f );
+
+	for (Contour& theContour : ioShape.contours)
+		Q3Point3D_To3DTransformArray( theContour.data(), &theMatrix, theContour.data(),
+			(TQ3Uns32) theContour.size(), sizeof(TQ3Point3D), sizeof(TQ3Point3D) );
+}
+
+
+
+
+
+//=============================================================================
+//      MakeShapes : Make the shapes to decompose.
+//-----------------------------------------------------------------------------
+static std::vector<Shape>
+MakeShapes(void)
+{	std::vector<Shape>		theShapes;
+
+
+
+	theShapes.push_back( { "convex 8",       { MakeContour(    8, 1.0f, 1.0f ) }, true,  true } );
+	theShapes.push_back( { "convex 64",      { MakeContour(   64, 1.0f, 1.0f ) }, true,  true } );
+	theShapes.push_back( { "convex 1024",    { MakeContour( 1024, 1.0f, 1.0f ) }, true,  true } );
+	theShapes.push_back( { "star 16",        { MakeContour(   16, 1.0f, 0.5f ) }, false, true } );
+	theShapes.push_back( { "star 256",       { MakeContour(  256, 1.0f, 0.5f ) }, false, true } );
+	theShapes.push_back( { "star 4096",      { MakeContour( 4096, 1.0f, 0.5f ) }, false, true } );
+	theShapes.push_back( { "comb 770",       { MakeComb( 256 ) },                 false, true } );
+	theShapes.push_back( { "spiral 1024",    { MakeSpiral( 1024 ) },              false, true } );
+	theShapes.push_back( { "hole 8+8",       { MakeContour(   8, 1.0f, 1.0f ),
+											   MakeContour(   8, 0.5f, 0.5f, true ) }, false, true } );
+	theShapes.push_back( { "hole 256+256",   { MakeContour( 256, 1.0f, 1.0f ),
+											   MakeContour( 256, 0.5f, 0.5f, true ) }, false, true } );
+	theShapes.push_back( { "crossed 5",      { { { 1.0f, 0.0f, 0.0f }, { -0.81f, 0.59f, 0.0f }, { 0.31f, -0.95f, 0.0f },
+											     { 0.31f, 0.95f, 0.0f }, { -0.81f, -0.59f, 0.0f } } }, false, false } );
+
+	for (Shape& theShape : theShapes)
+		TiltShape( theShape );
+
+	return theShapes;
+}
+
+
+
+
+
+//=============================================================================
+//      ContourVector : Get the Newell vector of a contour.
+//-----------------------------------------------------------------------------
+//		Note :	The vector is normal to the contour, with a length of twice
+//				its area.
+//-----------------------------------------------------------------------------
+static TQ3Vector3D
+ContourVector(const Contour& inContour)
+{	double		x = 0.0, y = 0.0, z = 0.0;
+	size_t		n, m;
+
+
+
+	for (n = 0, m = inContour.size() - 1; n < inContour.size(); m = n++)
+		{
+		const TQ3Point3D& p = inContour[m];
+		const TQ3Point3D& q = inContour[n];
+		x += ((double) p.y - q.y) * ((double) p.z + q.z);
+		y += ((double) p.z - q.z) * ((double) p.x + q.x);
+		z += ((double) p.x - q.x) * ((double) p.y + q.y);
+		}
+
+	TQ3Vector3D theVector = { (float) x, (float) y, (float) z };
+	return theVector;
+}
+
+
+
+
+
+//=============================================================================
+//      TriMeshArea : Get the area of a TriMesh along a normal.
+//-----------------------------------------------------------------------------
+static double
+TriMeshArea(TQ3GeometryObject inTriMesh, const TQ3Vector3D& inNormal, TQ3Uns32& outNumTriangles)
+{	TQ3TriMeshData		*theData;
+	TQ3Vector3D			edge1, edge2, theCross;
+	double				theArea = 0.0;
+	TQ3Uns32			n;
+
+
+
+	outNumTriangles = 0;
+	if (inTriMesh == nullptr || Q3TriMesh_LockData( inTriMesh, kQ3True, &theData ) != kQ3Success)
+		return 0.0;
+
+	for (n = 0; n < theData->numTriangles; ++n)
+		{
+		const TQ3Uns32* theIndices = theData->triangles[n].pointIndices;
+		Q3Point3D_Subtract( &theData->points[theIndices[1]], &theData->points[theIndices[0]], &edge1 );
+		Q3Point3D_Subtract( &theData->points[theIndices[2]], &theData->points[theIndices[0]], &edge2 );
+		Q3Vector3D_Cross( &edge1, &edge2, &theCross );
+		theArea += 0.5 * Q3Vector3D_Dot( &theCross, &inNormal );
+		}
+
+	outNumTriangles = theData->numTriangles;
+	Q3TriMesh_UnlockData( inTriMesh );
+
+	return theArea;
+}
+
+
+
+
+
+//=============================================================================
+//      Decompose : Decompose a geometry repeatedly, and time it.
+//-----------------------------------------------------------------------------
+//		Note :	Returns the time per decomposition in microseconds, and the
+//				last decomposition.
+//-----------------------------------------------------------------------------
+static double
+Decompose(TQ3ViewObject inView, TQ3GeometryObject inGeometry, TQ3Uns32 numRepeats,
+			TQ3GeometryObject& outDecomposed)
+{	TQ3BoundingBox	theBounds;
+	TQ3Uns32		n;
+
+
+
+	outDecomposed = nullptr;
+
+	auto startTime = std::chrono::steady_clock::now();
+
+	if (Q3View_StartBoundingBox( inView, kQ3ComputeBoundsExact ) == kQ3Success)
+		{
+		do
+			{
+			for (n = 0; n < numRepeats; ++n)
+				{
+				if (outDecomposed != nullptr)
+					Q3Object_Dispose( outDecomposed );
+
+				outDecomposed = Q3Geometry_GetDecomposed( inGeometry, inView );
+				}
+			}
+		while (Q3View_EndBoundingBox( inView, &theBounds ) == kQ3ViewStatusRetraverse);
+		}
+
+	std::chrono::duration<double, std::micro> theTime =
+		std::chrono::steady_clock::now() - startTime;
+
+	return theTime.count() / numRepeats;
+}
+
+
+
+
+
+//=============================================================================
+//      Public functions
+//-----------------------------------------------------------------------------
+//      main : Entry point.
+//-----------------------------------------------------------------------------
+#pragma mark -
+int
+main(void)
+{	TQ3Uns32				majorVersion = 0, minorVersion = 0;
+	bool					allCovered = true;
+
+
+
+	// Initialise ourselves
+	Initialize();
+
+	TQ3ViewObject      theView   = Q3View_New();
+	std::vector<Shape> theShapes = MakeShapes();
+	if (theView == nullptr)
+		exit(-1);
+
+	Q3GetVersion( &majorVersion, &minorVersion );
+	printf( "Quesa %u.%u\n\n", majorVersion, minorVersion );
+	printf( "%-14s %9s %10s %20s %14s %8s\n", "shape", "vertices", "triangles",
+		"GeneralPolygon (us)", "Polygon (us)", "area" );
+
+
+
+	// Decompose each shape
+	for (const Shape& theShape : theShapes)
+		{
+		std::vector<TQ3GeneralPolygonContourData>	theContours;
+		std::vector<std::vector<TQ3Vertex3D>>		theVertices;
+		TQ3GeneralPolygonData						generalPolygonData = {};
+		TQ3GeometryObject							theDecomposed;
+		TQ3Vector3D									theNormal;
+		TQ3Uns32									numVertices = 0, numTriangles = 0;
+
+
+
+		// Make the GeneralPolygon
+		for (const Contour& theContour : theShape.contours)
+			{
+			std::vector<TQ3Vertex3D> contourVertices;
+			for (const TQ3Point3D& thePoint : theContour)
+				contourVertices.push_back( { thePoint, nullptr } );
+
+			theVertices.push_back( contourVertices );
+			numVertices += (TQ3Uns32) theContour.size();
+			}
+
+		for (std::vector<TQ3Vertex3D>& contourVertices : theVertices)
+			theContours.push_back( { (TQ3Uns32) contourVertices.size(), contourVertices.data() } );
+
+		generalPolygonData.numContours = (TQ3Uns32) theContours.size();
+		generalPolygonData.contours    = theContours.data();
+		generalPolygonData.shapeHint   = theShape.isConvex ? kQ3GeneralPolygonShapeHintConvex : kQ3GeneralPolygonShapeHintComplex;
+
+		TQ3GeometryObject theGeneralPolygon = Q3GeneralPolygon_New( &generalPolygonData );
+		if (theGeneralPolygon == nullptr)
+			exit(-1);
+
+
+
+		// Time it, and check that its triangles add up to its area
+		TQ3Uns32 numRepeats = kVerticesPerRun / numVertices + 1;
+		double generalPolygonTime = Decompose( theView, theGeneralPolygon, numRepeats, theDecomposed );
+
+		theNormal = ContourVector( theShape.contours[0] );
+		Q3Vector3D_Normalize( &theNormal, &theNormal );
+
+		double polygonArea = 0.0;
+		for (const Contour& theContour : theShape.contours)
+			{
+			TQ3Vector3D theVector = ContourVector( theContour );
+			polygonArea += 0.5 * Q3Vector3D_Dot( &theVector, &theNormal );
+			}
+
+		double triMeshArea = TriMeshArea( theDecomposed, theNormal, numTriangles );
+		bool   isCovered   = !theShape.checkArea ||
+							 fabs( triMeshArea - polygonArea ) <= kAreaTolerance * fabs( polygonArea );
+
+		allCovered = allCovered && isCovered;
+
+		if (theDecomposed != nullptr)
+			Q3Object_Dispose( theDecomposed );
+
+		Q3Object_Dispose( theGeneralPolygon );
+
+
+
+		// Time convex shapes as a Polygon as well
+		char polygonTime[32] = "-";
+		if (theShape.isConvex)
+			{
+			TQ3PolygonData polygonData = { numVertices, theVertices[0].data(), nullptr };
+			TQ3GeometryObject thePolygon = Q3Polygon_New( &polygonData );
+			if (thePolygon == nullptr)
+				exit(-1);
+
+			snprintf( polygonTime, sizeof(polygonTime), "%.2f",
+				Decompose( theView, thePolygon, numRepeats, theDecomposed ) );
+
+			if (theDecomposed != nullptr)
+				Q3Object_Dispose( theDecomposed );
+
+			Q3Object_Dispose( thePolygon );
+			}
+
+		printf( "%-14s %9u %10u %20.2f %14s %8s\n", theShape.name, numVertices, numTriangles,
+			generalPolygonTime, polygonTime,
+			!theShape.checkArea ? "-" : (isCovered ? "ok" : "MISMATCH") );
+		}
+
+
+
+	// Clean up
+	Q3Object_Dispose( theView );
+	Terminate();
+
+	return allCovered ? 0 : 1;
+}
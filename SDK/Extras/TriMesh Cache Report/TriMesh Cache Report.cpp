@@ -0,0 +1,396 @@
+/*  NAME:
+        TriMesh Cache Report.cpp
+
+    DESCRIPTION:
+        Reports how well the TriMeshes in 3DMF files use a vertex cache,
+        before and after Q3TriMesh_OptimizeDataForRendering.
+
+        For each TriMesh the average cache miss ratio (ACMR, transformed
+        vertices per triangle) and average transformed vertex ratio (ATVR,
+        transformed vertices per point) are printed for FIFO caches of 16
+        and 32 vertices, with totals over all TriMeshes. With no arguments,
+        a sphere with its triangles in random order is measured instead.
+
+    COPYRIGHT:
+        Copyright (c) 2025, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+//=============================================================================
+//      Include files
+//-----------------------------------------------------------------------------
+#include "Quesa.h"
+#include "QuesaGeometry.h"
+#include "QuesaGroup.h"
+#include "QuesaIO.h"
+#include "QuesaMath.h"
+#include "QuesaStorage.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+
+
+
+
+//=============================================================================
+//      Constants
+//-----------------------------------------------------------------------------
+// Cache sizes to report, typical of older and newer hardware
+const TQ3Uns32 kCacheSizes[]						= { 16, 32 };
+const TQ3Uns32 kNumCacheSizes						= 2;
+
+// Size of the sphere measured when no files are given
+const TQ3Uns32 kSphereRings							= 64;
+const TQ3Uns32 kSphereSegments						= 128;
+
+
+
+
+
+//=============================================================================
+//      Types
+//-----------------------------------------------------------------------------
+// Totals over all the TriMeshes
+struct ReportTotals {
+	TQ3Uns32							numTriMeshes;
+	TQ3Uns32							numTriangles;
+	TQ3Uns32							numPoints;
+	TQ3Uns32							before[ kNumCacheSizes ];
+	TQ3Uns32							after[ kNumCacheSizes ];
+	double								time;
+};
+
+
+
+
+
+//=============================================================================
+//      Internal functions
+//-----------------------------------------------------------------------------
+//      Initialize : Initialize ourselves.
+//-----------------------------------------------------------------------------
+static void
+Initialize(void)
+{
+
+
+	// Initialize Quesa
+	TQ3Status qd3dStatus = Q3Initialize();
+	if (qd3dStatus != kQ3Success)
+		exit(-1);
+}
+
+
+
+
+
+//=============================================================================
+//      Terminate : Terminate ourselves.
+//-----------------------------------------------------------------------------
+static void
+Terminate(void)
+{
+	// Terminate Quesa
+	Q3Exit();
+}
+
+
+
+
+
+//=============================================================================
+//      MakeShuffledSphere : Make a sphere with its triangles in random order.
+//-----------------------------------------------------------------------------
+static TQ3GeometryObject
+MakeShuffledSphere(void)
+{	std::vector<TQ3Point3D>				thePoints;
+	std::vector<TQ3TriMeshTriangleData>	theTriangles;
+	TQ3TriMeshData						triMeshData = {};
+	TQ3Uns32							ring, segment;
+
+
+
+	for (ring = 0; ring <= kSphereRings; ++ring)
+		{
+		float theta = kQ3Pi * ring / kSphereRings;
+		for (segment = 0; segment < kSphereSegments; ++segment)
+			{
+			float phi = kQ32Pi * segment / kSphereSegments;
+			TQ3Point3D thePoint = { sinf( theta ) * cosf( phi ), cosf( theta ),
+				sinf( theta ) * sinf( phi ) };
+			thePoints.push_back( thePoint );
+			}
+		}
+
+	for (ring = 0; ring < kSphereRings; ++ring)
+		{
+		for (segment = 0; segment < kSphereSegments; ++segment)
+			{
+			TQ3Uns32 a = ring * kSphereSegments + segment;
+			TQ3Uns32 b = ring * kSphereSegments + (segment + 1) % kSphereSegments;
+			TQ3TriMeshTriangleData firstTriangle  = { { a, b, a + kSphereSegments } };
+			TQ3TriMeshTriangleData secondTriangle = { { b, b + kSphereSegments, a + kSphereSegments } };
+			theTriangles.push_back( firstTriangle );
+			theTriangles.push_back( secondTriangle );
+			}
+		}
+
+	srand( 1 );
+	for (size_t n = theTriangles.size() - 1; n > 0; --n)
+		std::swap( theTriangles[n], theTriangles[ rand() % (n + 1) ] );
+
+	triMeshData.numPoints    = (TQ3Uns32) thePoints.size();
+	triMeshData.points       = thePoints.data();
+	triMeshData.numTriangles = (TQ3Uns32) theTriangles.size();
+	triMeshData.triangles    = theTriangles.data();
+	Q3BoundingBox_SetFromPoints3D( &triMeshData.bBox, triMeshData.points,
+		triMeshData.numPoints, sizeof(TQ3Point3D) );
+
+	return Q3TriMesh_New( &triMeshData );
+}
+
+
+
+
+
+//=============================================================================
+//      ReportTriMesh : Measure and print one TriMesh.
+//-----------------------------------------------------------------------------
+static void
+ReportTriMesh(const char* inName, TQ3GeometryObject inTriMesh, ReportTotals& ioTotals)
+{	TQ3TriMeshData*				theData = nullptr;
+	TQ3TriMeshData				orderedData;
+	TQ3TriMeshCacheStatistics	beforeStats[ kNumCacheSizes ], afterStats[ kNumCacheSizes ];
+	TQ3Uns32					n;
+
+
+
+	if (Q3TriMesh_LockData( inTriMesh, kQ3True, &theData ) != kQ3Success)
+		return;
+
+	auto startTime = std::chrono::steady_clock::now();
+	TQ3Status qd3dStatus = Q3TriMesh_OptimizeDataForRendering( theData,
+		kQ3TriMeshRenderOrderMaskAll, &orderedData );
+	std::chrono::duration<double, std::milli> theTime =
+		std::chrono::steady_clock::now() - startTime;
+
+	if (qd3dStatus == kQ3Success)
+		{
+		for (n = 0; n < kNumCacheSizes; ++n)
+			{
+			Q3TriMesh_GetCacheStatistics( theData, kCacheSizes[n], &beforeStats[n] );
+			Q3TriMesh_GetCacheStatistics( &orderedData, kCacheSizes[n], &afterStats[n] );
+			ioTotals.before[n] += beforeStats[n].numTransformedVertices;
+			ioTotals.after[n]  += afterStats[n].numTransformedVertices;
+			}
+
+		printf( "%-28s %9u %9u   %5.3f -> %5.3f   %5.3f -> %5.3f   %5.3f -> %5.3f %9.2f\n",
+			inName, theData->numTriangles, theData->numPoints,
+			beforeStats[0].acmr, afterStats[0].acmr,
+			beforeStats[1].acmr, afterStats[1].acmr,
+			beforeStats[1].atvr, afterStats[1].atvr, theTime.count() );
+
+		ioTotals.numTriMeshes += 1;
+		ioTotals.numTriangles += theData->numTriangles;
+		ioTotals.numPoints    += theData->numPoints;
+		ioTotals.time         += theTime.count();
+
+		Q3TriMesh_EmptyData( &orderedData );
+		}
+
+	Q3TriMesh_UnlockData( inTriMesh );
+}
+
+
+
+
+
+//=============================================================================
+//      ReportObject : Report the TriMeshes in an object and its groups.
+//-----------------------------------------------------------------------------
+static void
+ReportObject(const char* inFileName, TQ3Object inObject, ReportTotals& ioTotals)
+{	TQ3GroupPosition	thePosition = nullptr;
+	TQ3Object			theMember;
+	char				theName[ 256 ];
+
+
+
+	if (Q3Object_IsType( inObject, kQ3GeometryTypeTriMesh ))
+		{
+		snprintf( theName, sizeof(theName), "%s #%u", inFileName, ioTotals.numTriMeshes + 1 );
+		ReportTriMesh( theName, inObject, ioTotals );
+		}
+
+	else if (Q3Object_IsType( inObject, kQ3ShapeTypeGroup ))
+		{
+		Q3Group_GetFirstPosition( inObject, &thePosition );
+		while (thePosition != nullptr)
+			{
+			if (Q3Group_GetPositionObject( inObject, thePosition, &theMember ) == kQ3Success)
+				{
+				ReportObject( inFileName, theMember, ioTotals );
+				Q3Object_Dispose( theMember );
+				}
+
+			Q3Group_GetNextPosition( inObject, &thePosition );
+			}
+		}
+}
+
+
+
+
+
+//=============================================================================
+//      ReportFile : Report the TriMeshes in a 3DMF file.
+//-----------------------------------------------------------------------------
+static bool
+ReportFile(const char* inPath, ReportTotals& ioTotals)
+{	TQ3StorageObject	theStorage;
+	TQ3FileObject		theFile;
+	TQ3FileMode			fileMode;
+	TQ3Object			theObject;
+	bool				didOpen = false;
+
+
+
+	theStorage = Q3PathStorage_New( inPath );
+	theFile    = Q3File_New();
+
+	if (theStorage != nullptr && theFile != nullptr)
+		{
+		Q3File_SetStorage( theFile, theStorage );
+
+		if (Q3File_OpenRead( theFile, &fileMode ) == kQ3Success)
+			{
+			didOpen = true;
+
+			while (Q3File_IsEndOfFile( theFile ) == kQ3False)
+				{
+				theObject = Q3File_ReadObject( theFile );
+				if (theObject != nullptr)
+					{
+					ReportObject( inPath, theObject, ioTotals );
+					Q3Object_Dispose( theObject );
+					}
+				}
+
+			Q3File_Close( theFile );
+			}
+		}
+
+	if (theFile != nullptr)
+		Q3Object_Dispose( theFile );
+
+	if (theStorage != nullptr)
+		Q3Object_Dispose( theStorage );
+
+	return didOpen;
+}
+
+
+
+
+
+//=============================================================================
+//      Public functions
+//-----------------------------------------------------------------------------
+//      main : Entry point.
+//-----------------------------------------------------------------------------
+#pragma mark -
+int
+main(int argc, char *argv[])
+{	ReportTotals	theTotals = {};
+	bool			allOpened = true;
+	TQ3Uns32		n;
+
+
+
+	// Initialise ourselves
+	Initialize();
+
+	printf( "%-28s %9s %9s   %-14s   %-14s   %-14s %9s\n", "TriMesh", "triangles", "points",
+		"ACMR (16)", "ACMR (32)", "ATVR (32)", "time (ms)" );
+
+
+
+	// Report on each file, or on a sphere if there are none
+	if (argc < 2)
+		{
+		TQ3GeometryObject theSphere = MakeShuffledSphere();
+		if (theSphere == nullptr)
+			exit(-1);
+
+		ReportTriMesh( "shuffled sphere", theSphere, theTotals );
+		Q3Object_Dispose( theSphere );
+		}
+	else
+		{
+		for (int i = 1; i < argc; ++i)
+			{
+			if (! ReportFile( argv[i], theTotals ))
+				{
+				fprintf( stderr, "Could not read %s\n", argv[i] );
+				allOpened = false;
+				}
+			}
+		}
+
+
+
+	// Report the totals
+	if (theTotals.numTriMeshes > 1 && theTotals.numTriangles != 0)
+		{
+		printf( "%-28s %9u %9u", "total", theTotals.numTriangles, theTotals.numPoints );
+		for (n = 0; n < kNumCacheSizes; ++n)
+			printf( "   %5.3f -> %5.3f", theTotals.before[n] / (float) theTotals.numTriangles,
+				theTotals.after[n] / (float) theTotals.numTriangles );
+		printf( "   %5.3f -> %5.3f %9.2f\n",
+			theTotals.before[1] / (float) theTotals.numPoints,
+			theTotals.after[1] / (float) theTotals.numPoints, theTotals.time );
+		}
+
+
+
+	// Clean up
+	Terminate();
+
+	return allOpened ? 0 : 1;
+}
@@ -8,7 +8,7 @@
 		Initial version written by James W. Walker.
 
     COPYRIGHT:
-        Copyright (c) 2008-2021, Quesa Developers. All rights reserved.
+        Copyright (c) 2008-2025, Quesa Developers. All rights reserved.
 
         For the current release of Quesa, please see:
 
@@ -52,8 +52,391 @@
 #include <Quesa/QuesaMath.h>
 #include <Quesa/QuesaSet.h>
 
-#include <vector>
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+
+/*
+	Points are sorted into a grid of cubes whose edge is twice the distance
+	threshold, so a point only needs to be compared with points in its own
+	cube and the 7 others that meet at the cube corner nearest to it.  The grid is stored as a hash table from cube to a range
+	of points, so it costs nothing for empty space.
+	
+	A point joins the earliest earlier point that is the first of a cluster
+	and is near enough, so the result depends on the order of the points.  To
+	split the work across threads, we first find, for each point, the
+	earliest few earlier points that are near enough, which can be done in
+	any order.  Then a quick serial pass picks the first of those that begins
+	a cluster.  In the rare case that none of the few does, the point is
+	checked again against its neighbors, serially.  The clusters are exactly
+	those that the plain comparison of every pair of points would give.
+*/
+
+namespace
+{
+	typedef std::vector<TQ3Uns32>	IndexVec;
+	
+	// Number of earlier near points remembered for each point
+	const TQ3Uns32	kMaxCandidates		= 4;
+	
+	// Smallest number of points worth giving a thread
+	const TQ3Uns32	kMinPointsPerThread	= 16384;
+	
+	struct Candidates
+	{
+		TQ3Uns32	count;		// kMaxCandidates + 1 means there were more
+		TQ3Uns32	index[ kMaxCandidates ];
+	};
+	
+	/*
+		Points sorted by grid cube, with the range of each cube.  Cube
+		coordinates are packed into 21 bits each, so distant cubes may share
+		a key, which only costs some extra comparisons.
+	*/
+	class PointGrid
+	{
+	public:
+						PointGrid( const TQ3Point3D* inPoints,
+									TQ3Uns32 inNumPoints,
+									float inNearDistance );
+		
+		TQ3Uns32		NumGridPoints() const { return static_cast<TQ3Uns32>( mSorted.size() ); }
+		TQ3Uns32		GridPoint( TQ3Uns32 inIndex ) const { return mSorted[ inIndex ]; }
+		
+		template <typename Func>
+		void			ForEachNeighbor( TQ3Uns32 inPoint, Func inFunc ) const;
+		
+	private:
+		// Slot of the hash table, empty if end is 0
+		struct Cube
+		{
+			std::uint64_t	key;
+			TQ3Uns32		start;
+			TQ3Uns32		end;
+		};
+		
+		bool			GetCube( const TQ3Point3D& inPt, std::int64_t* outCube,
+								std::int64_t* outNearSide = nullptr ) const;
+		static std::uint64_t	CubeKey( std::int64_t inX, std::int64_t inY,
+										std::int64_t inZ );
+		TQ3Uns32		FindSlot( std::uint64_t inKey ) const;
+		
+		const TQ3Point3D*	mPoints;
+		double				mCubesPerUnit;
+		TQ3Point3D			mMin;
+		IndexVec			mSorted;
+		std::vector< Cube >	mCubes;
+		TQ3Uns32			mSlotMask;
+	};
+	
+	struct Criteria
+	{
+		const TQ3Point3D*	points;
+		const TQ3Vector3D*	normals;
+		const TQ3Param2D*	uvs;
+		float				distSqThreshold;
+		float				uvSqThreshold;
+		float				normalDotThreshold;
+		
+		bool		AreNear( TQ3Uns32 inA, TQ3Uns32 inB ) const;
+	};
+}
+
+PointGrid::PointGrid( const TQ3Point3D* inPoints,
+						TQ3Uns32 inNumPoints,
+						float inNearDistance )
+	: mPoints( inPoints )
+{
+	// Bounds of the finite points
+	TQ3Point3D	theMax = { -HUGE_VALF, -HUGE_VALF, -HUGE_VALF };
+	mMin.x = mMin.y = mMin.z = HUGE_VALF;
+	for (TQ3Uns32 i = 0; i < inNumPoints; ++i)
+	{
+		const TQ3Point3D&	thePt( inPoints[i] );
+		if (std::isfinite( thePt.x ) && std::isfinite( thePt.y ) &&
+			std::isfinite( thePt.z ))
+		{
+			mMin.x = std::min( mMin.x, thePt.x );
+			mMin.y = std::min( mMin.y, thePt.y );
+			mMin.z = std::min( mMin.z, thePt.z );
+			theMax.x = std::max( theMax.x, thePt.x );
+			theMax.y = std::max( theMax.y, thePt.y );
+			theMax.z = std::max( theMax.z, thePt.z );
+		}
+	}
+	
+	// Cubes are twice the near distance, so a point can only be near points
+	// on the side of each face it is closest to.  Enlarge them a little so
+	// that rounding cannot break that, and enough that cube numbers fit
+	// easily in 64 bits.
+	double	maxExtent = std::max( static_cast<double>( theMax.x ) - mMin.x,
+		std::max( static_cast<double>( theMax.y ) - mMin.y,
+			static_cast<double>( theMax.z ) - mMin.z ) );
+	double	cubeSize = std::max( 2.0 * inNearDistance * (1.0 + 1.0e-6),
+		maxExtent * 1.0e-15 );
+	mCubesPerUnit = 1.0 / cubeSize;
+	
+	std::vector< std::pair< std::uint64_t, TQ3Uns32 > >	keyed;
+	keyed.reserve( inNumPoints );
+	for (TQ3Uns32 i = 0; i < inNumPoints; ++i)
+	{
+		std::int64_t	cube[3];
+		if (GetCube( inPoints[i], cube ))
+		{
+			keyed.push_back( std::make_pair( CubeKey( cube[0], cube[1], cube[2] ), i ) );
+		}
+	}
+	std::sort( keyed.begin(), keyed.end() );
+	
+	// Open addressing, at most half full
+	TQ3Uns32	numSlots = 16;
+	while (numSlots < 2 * keyed.size())
+	{
+		numSlots *= 2;
+	}
+	Cube	emptyCube = { 0, 0, 0 };
+	mCubes.assign( numSlots, emptyCube );
+	mSlotMask = numSlots - 1;
+	
+	mSorted.resize( keyed.size() );
+	TQ3Uns32	slot = 0;
+	for (TQ3Uns32 i = 0; i < keyed.size(); ++i)
+	{
+		mSorted[i] = keyed[i].second;
+		if ( (i == 0) || (keyed[i].first != keyed[i-1].first) )
+		{
+			slot = FindSlot( keyed[i].first );
+			mCubes[ slot ].key = keyed[i].first;
+			mCubes[ slot ].start = i;
+		}
+		mCubes[ slot ].end = i + 1;
+	}
+}
+
+/*!
+	@function	FindSlot
+	@abstract	Find the slot of the hash table holding a key, or the empty
+				slot where it would go.
+*/
+TQ3Uns32	PointGrid::FindSlot( std::uint64_t inKey ) const
+{
+	std::uint64_t	h = inKey * 0x9E3779B97F4A7C15ULL;
+	TQ3Uns32	slot = static_cast<TQ3Uns32>( h >> 32 ) & mSlotMask;
+	
+	while ( (mCubes[ slot ].end != 0) && (mCubes[ slot ].key != inKey) )
+	{
+		slot = (slot + 1) & mSlotMask;
+	}
+	return slot;
+}
+
+/*!
+	@function	GetCube
+	@abstract	Find the grid cube containing a point, and optionally, for each
+				axis, -1 or +1 according to which neighboring cube the point is
+				nearer.
+	@result		False if the point is not finite, in which case it is not
+				near anything.
+*/
+bool	PointGrid::GetCube( const TQ3Point3D& inPt, std::int64_t* outCube,
+							std::int64_t* outNearSide ) const
+{
+	const double	coords[3] = {
+		static_cast<double>( inPt.x ) - mMin.x,
+		static_cast<double>( inPt.y ) - mMin.y,
+		static_cast<double>( inPt.z ) - mMin.z
+	};
+	for (int i = 0; i < 3; ++i)
+	{
+		if (! std::isfinite( coords[i] ))
+		{
+			return false;
+		}
+		double	scaled = coords[i] * mCubesPerUnit;
+		double	whole = std::floor( scaled );
+		outCube[i] = static_cast<std::int64_t>( whole );
+		if (outNearSide != nullptr)
+		{
+			outNearSide[i] = (scaled - whole < 0.5)? -1 : 1;
+		}
+	}
+	return true;
+}
+
+std::uint64_t	PointGrid::CubeKey( std::int64_t inX, std::int64_t inY,
+									std::int64_t inZ )
+{
+	const std::uint64_t	kMask = (1ULL << 21) - 1;
+	return (static_cast<std::uint64_t>( inX ) & kMask) |
+		((static_cast<std::uint64_t>( inY ) & kMask) << 21) |
+		((static_cast<std::uint64_t>( inZ ) & kMask) << 42);
+}
+
+/*!
+	@function	ForEachNeighbor
+	@abstract	Call a function for each point that might be near a point,
+				including the point itself.
+	@discussion	Within each cube, points are visited in increasing order.
+*/
+template <typename Func>
+void	PointGrid::ForEachNeighbor( TQ3Uns32 inPoint, Func inFunc ) const
+{
+	std::int64_t	cube[3], side[3];
+	if (! GetCube( mPoints[ inPoint ], cube, side ))
+	{
+		return;
+	}
+	
+	std::uint64_t	visited[8];
+	int				numVisited = 0;
+	for (int dz = 0; dz < 2; ++dz)
+	{
+		for (int dy = 0; dy < 2; ++dy)
+		{
+			for (int dx = 0; dx < 2; ++dx)
+			{
+				std::uint64_t	theKey = CubeKey( cube[0] + dx * side[0],
+					cube[1] + dy * side[1], cube[2] + dz * side[2] );
+				
+				// Keys of different cubes can coincide, so do not visit twice
+				if (std::find( visited, visited + numVisited, theKey ) !=
+					visited + numVisited)
+				{
+					continue;
+				}
+				visited[ numVisited++ ] = theKey;
+				
+				const Cube&	found( mCubes[ FindSlot( theKey ) ] );
+				for (TQ3Uns32 k = found.start; k < found.end; ++k)
+				{
+					inFunc( mSorted[k] );
+				}
+			}
+		}
+	}
+}
+
+bool	Criteria::AreNear( TQ3Uns32 inA, TQ3Uns32 inB ) const
+{
+	return (Q3FastPoint3D_DistanceSquared( &points[inA],
+			&points[inB] ) < distSqThreshold) &&
+		(Q3FastParam2D_DistanceSquared( &uvs[inA],
+			&uvs[inB] ) < uvSqThreshold) &&
+		(Q3FastVector3D_Dot( &normals[inA],
+			&normals[inB] ) > normalDotThreshold );
+}
+
+/*!
+	@function	ParallelFor
+	@abstract	Run a loop body over pieces of the range [0, inCount) on
+				several threads, or on this thread if the range is small.
+*/
+static void ParallelFor( TQ3Uns32 inCount,
+						const std::function< void( TQ3Uns32, TQ3Uns32 ) >& inBody )
+{
+	TQ3Uns32	numThreads = std::max( 1U, std::thread::hardware_concurrency() );
+	numThreads = std::min( numThreads, std::max( 1U, inCount / kMinPointsPerThread ) );
+	
+	std::vector< std::thread >	workers;
+	TQ3Uns32	start = 0;
+	for (TQ3Uns32 t = 1; t < numThreads; ++t)
+	{
+		TQ3Uns32	end = static_cast<TQ3Uns32>(
+			(static_cast<std::uint64_t>( inCount ) * t) / numThreads );
+		try
+		{
+			workers.emplace_back( std::cref( inBody ), start, end );
+		}
+		catch (...)
+		{
+			inBody( start, end );
+		}
+		start = end;
+	}
+	inBody( start, inCount );
+	
+	for (std::thread& aThread : workers)
+	{
+		aThread.join();
+	}
+}
+
+/*!
+	@function	FindClusters
+	@abstract	For each point, find the first point of the cluster that it
+				belongs to.
+*/
+static void FindClusters( TQ3Uns32 inNumPoints,
+						const Criteria& inCriteria,
+						float inDistanceThreshold,
+						IndexVec& outFirstOfCluster )
+{
+	PointGrid	theGrid( inCriteria.points, inNumPoints, inDistanceThreshold );
+	
+	// Find the earliest few near earlier points of each point.  Points that
+	// are not in the grid are not near anything.  Going in grid order keeps
+	// neighboring cubes in the cache.
+	Candidates	noCandidates = { 0, { 0 } };
+	std::vector< Candidates >	candidates( inNumPoints, noCandidates );
+	ParallelFor( theGrid.NumGridPoints(), [&]( TQ3Uns32 inStart, TQ3Uns32 inEnd )
+	{
+		for (TQ3Uns32 n = inStart; n < inEnd; ++n)
+		{
+			TQ3Uns32	i = theGrid.GridPoint( n );
+			Candidates&	found( candidates[i] );
+			theGrid.ForEachNeighbor( i, [&]( TQ3Uns32 j )
+			{
+				if ( (j < i) && inCriteria.AreNear( i, j ) )
+				{
+					TQ3Uns32	numKept = std::min( found.count, kMaxCandidates );
+					TQ3Uns32*	insertAt = std::lower_bound( found.index,
+						found.index + numKept, j );
+					if (insertAt < found.index + kMaxCandidates)
+					{
+						std::copy_backward( insertAt,
+							found.index + std::min( numKept, kMaxCandidates - 1 ),
+							found.index + std::min( numKept + 1, kMaxCandidates ) );
+						*insertAt = j;
+					}
+					found.count = std::min( found.count + 1, kMaxCandidates + 1 );
+				}
+			} );
+		}
+	} );
+	
+	// Choose the first candidate that begins a cluster.
+	outFirstOfCluster.resize( inNumPoints );
+	for (TQ3Uns32 i = 0; i < inNumPoints; ++i)
+	{
+		outFirstOfCluster[i] = i;	// until further notice
+		const Candidates&	found( candidates[i] );
+		TQ3Uns32	numKept = std::min( found.count, kMaxCandidates );
+		
+		for (TQ3Uns32 k = 0; k < numKept; ++k)
+		{
+			if (outFirstOfCluster[ found.index[k] ] == found.index[k])
+			{
+				outFirstOfCluster[i] = found.index[k];
+				break;
+			}
+		}
+		
+		if ( (outFirstOfCluster[i] == i) && (found.count > kMaxCandidates) )
+		{
+			theGrid.ForEachNeighbor( i, [&]( TQ3Uns32 j )
+			{
+				if ( (j < outFirstOfCluster[i]) && (outFirstOfCluster[j] == j) &&
+					inCriteria.AreNear( i, j ) )
+				{
+					outFirstOfCluster[i] = j;
+				}
+			} );
+		}
+	}
+}
 
 /*!
 	@function	MergeNearTriMeshPoints
@@ -65,8 +448,10 @@
 				normal and UV, it will be discarded.  We assume that the normal
 				vectors are unit length.
 				
-				The time taken by the algorithm is approximately proportional to
-				the square of the number of points.
+				Points are compared only with points in nearby cells of a grid,
+				so the time taken is roughly proportional to the number of
+				points, unless many points are within the distance threshold of
+				each other.  Large TriMeshes are processed on several threads.
 	
 	@param		ioMesh					A TriMesh object to be updated.
 	@param		inDistanceThreshold		If the distance between two points is
@@ -114,36 +499,23 @@ TQ3Uns32	MergeNearTriMeshPoints( TQ3GeometryObject ioMesh,
 			float uvSqThreshold = inUVThreshold * inUVThreshold;
 			float normalDotThreshold = std::cos( inNormalThreshold );
 			
-			std::vector<TQ3Uns32>	firstOfCluster( kNumOrigPoints );
+			IndexVec	firstOfCluster;
 			TQ3Uns32	i, j;
 			
-			for (i = 0; i < kNumOrigPoints; ++i)
+			if (inDistanceThreshold > 0.0f)
 			{
-				firstOfCluster[i] = i;	// until further notice
-
-			#if PP_Debug
-				TQ3Point3D	pt_i = points[i];	// debug
-				TQ3Param2D	uv_i = uvArray[i];
-				TQ3Vector3D	norm_i = normalArray[i];
-			#endif
+				Criteria	theCriteria = {
+					points, normalArray, uvArray,
+					distSqThreshold, uvSqThreshold, normalDotThreshold
+				};
+				FindClusters( kNumOrigPoints, theCriteria, inDistanceThreshold,
+					firstOfCluster );
 				
-				for (j = 0; j < i; ++j)
+				for (i = 0; i < kNumOrigPoints; ++i)
 				{
-					if (firstOfCluster[j] == j)
+					if (firstOfCluster[i] != i)
 					{
-						// Is point i equivalent to point j?
-						if ( (Q3FastPoint3D_DistanceSquared( &points[i],
-								&points[j] ) < distSqThreshold) &&
-							(Q3FastParam2D_DistanceSquared( &uvArray[i],
-								&uvArray[j] ) < uvSqThreshold) &&
-							(Q3FastVector3D_Dot( &normalArray[i],
-								&normalArray[j] ) > normalDotThreshold )
-						)
-						{
-							firstOfCluster[i] = j;
-							pointCountReduction += 1;
-							break;
-						}
+						pointCountReduction += 1;
 					}
 				}
 			}
@@ -8,7 +8,7 @@
 		Initial version written by James W. Walker.
 
     COPYRIGHT:
-        Copyright (c) 2008-2021, Quesa Developers. All rights reserved.
+        Copyright (c) 2008-2025, Quesa Developers. All rights reserved.
 
         For the current release of Quesa, please see:
 
@@ -63,8 +63,10 @@ extern "C" {
 				normal and UV, it will be discarded.  We assume that the normal
 				vectors are unit length.
 				
-				The time taken by the algorithm is approximately proportional to
-				the square of the number of points.
+				Points are compared only with points in nearby cells of a grid,
+				so the time taken is roughly proportional to the number of
+				points, unless many points are within the distance threshold of
+				each other.  Large TriMeshes are processed on several threads.
 	
 	@param		ioMesh					A TriMesh object to be updated.
 	@param		inDistanceThreshold		If the distance between two points is
@@ -0,0 +1,947 @@
+/*  NAME:
+        SimplifyTriMesh.cpp
+
+    DESCRIPTION:
+        Quesa utility source.
+
+    COPYRIGHT:
+        Copyright (c) 2025, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+
+#include "SimplifyTriMesh.h"
+
+#include <Quesa/QuesaGeometry.h>
+#include <Quesa/QuesaMath.h>
+#include <Quesa/QuesaMathOperators.hpp>
+#include <Quesa/QuesaSet.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+	typedef std::vector<TQ3Uns32>	IndexVec;
+	
+	// Collapses that would turn a triangle further than this (as the cosine
+	// of the angle) are refused.
+	const float		kMinNormalCosine	= 0.25f;
+	
+	// Weight of the planes that hold seams and boundaries in place, relative
+	// to the planes of the triangles.
+	const double	kBoundaryWeight		= 10.0;
+	
+	/*
+		Sum of squared distances to weighted planes, stored as the
+		symmetric matrix A, vector b and constant c such that the error at x
+		is x.A.x + 2 b.x + c.  The weight only counts triangle planes, and is
+		used to make the error an average.
+	*/
+	struct Quadric
+	{
+		double	a00, a01, a02, a11, a12, a22;
+		double	b0, b1, b2;
+		double	c;
+		double	weight;
+		
+		void	AddPlane( const TQ3Vector3D& inNormal, double inDist, double inWeight );
+		void	Add( const Quadric& inOther );
+		double	Evaluate( const TQ3Point3D& inPt ) const;
+	};
+	
+	struct Collapse
+	{
+		double		cost;
+		TQ3Uns32	from;
+		TQ3Uns32	to;
+		TQ3Uns32	fromStamp;
+		TQ3Uns32	toStamp;
+		
+		bool		operator>( const Collapse& inOther ) const;
+	};
+	
+	// Points of a triangle that contains the collapsing edge, matched up.
+	struct WedgePair
+	{
+		TQ3Uns32	fromPt;
+		TQ3Uns32	toPt;
+	};
+	
+	typedef std::vector<WedgePair>	WedgeVec;
+	
+	struct PositionKey
+	{
+		float		x, y, z;
+		
+		bool		operator==( const PositionKey& inOther ) const;
+	};
+	
+	struct PositionHash
+	{
+		size_t		operator()( const PositionKey& inKey ) const;
+	};
+	
+	typedef std::priority_queue< Collapse, std::vector<Collapse>,
+		std::greater<Collapse> >	CollapseQueue;
+	
+	/*
+		Working state of the simplification.  Points with equal positions
+		are welded for the sake of topology: a "position" is named by the
+		lowest index of the points at it, and collapses move one position
+		onto another.
+	*/
+	class Simplifier
+	{
+	public:
+							Simplifier( const TQ3TriMeshData& inData );
+		
+		void				Run( TQ3Uns32 inTargetTriangleCount, double inMaxError );
+		TQ3GeometryObject	MakeResult() const;
+		
+		double				MaxError() const { return mMaxError; }
+		
+	private:
+		void				WeldPositions();
+		void				ClassifyEdges();
+		void				BuildQuadrics();
+		void				GatherRing( TQ3Uns32 inPos, IndexVec& outRing ) const;
+		TQ3Uns32			CornerOf( TQ3Uns32 inTriangle, TQ3Uns32 inPos ) const;
+		double				CollapseCost( TQ3Uns32 inFrom, TQ3Uns32 inTo ) const;
+		void				QueueBestCollapse( TQ3Uns32 inFrom );
+		bool				CanCollapse( TQ3Uns32 inFrom, TQ3Uns32 inTo,
+										WedgeVec& outWedges );
+		void				DoCollapse( TQ3Uns32 inFrom, TQ3Uns32 inTo,
+										const WedgeVec& inWedges );
+		
+		const TQ3TriMeshData&	mData;
+		IndexVec				mPosition;		// point -> position
+		std::vector<TQ3TriMeshTriangleData>	mTriangles;
+		std::vector<bool>		mAlive;
+		TQ3Uns32				mNumAlive;
+		std::vector<IndexVec>	mPosTriangles;	// position -> triangles, some dead
+		std::vector<bool>		mBorder;
+		std::vector<bool>		mLocked;
+		std::vector<bool>		mRemoved;
+		IndexVec				mStamp;
+		std::vector<Quadric>	mQuadrics;
+		CollapseQueue			mQueue;
+		double					mMaxError;
+	};
+}
+
+void	Quadric::AddPlane( const TQ3Vector3D& inNormal, double inDist, double inWeight )
+{
+	double	nx = inNormal.x;
+	double	ny = inNormal.y;
+	double	nz = inNormal.z;
+	
+	a00 += inWeight * nx * nx;
+	a01 += inWeight * nx * ny;
+	a02 += inWeight * nx * nz;
+	a11 += inWeight * ny * ny;
+	a12 += inWeight * ny * nz;
+	a22 += inWeight * nz * nz;
+	b0 += inWeight * nx * inDist;
+	b1 += inWeight * ny * inDist;
+	b2 += inWeight * nz * inDist;
+	c += inWeight * inDist * inDist;
+}
+
+void	Quadric::Add( const Quadric& inOther )
+{
+	a00 += inOther.a00;
+	a01 += inOther.a01;
+	a02 += inOther.a02;
+	a11 += inOther.a11;
+	a12 += inOther.a12;
+	a22 += inOther.a22;
+	b0 += inOther.b0;
+	b1 += inOther.b1;
+	b2 += inOther.b2;
+	c += inOther.c;
+	weight += inOther.weight;
+}
+
+double	Quadric::Evaluate( const TQ3Point3D& inPt ) const
+{
+	double	x = inPt.x;
+	double	y = inPt.y;
+	double	z = inPt.z;
+	
+	double	result = x * (a00 * x + 2.0 * (a01 * y + a02 * z + b0)) +
+		y * (a11 * y + 2.0 * (a12 * z + b1)) +
+		z * (a22 * z + 2.0 * b2) + c;
+	
+	return std::max( result, 0.0 );
+}
+
+bool	Collapse::operator>( const Collapse& inOther ) const
+{
+	// Break ties by index so that the result does not depend on the queue
+	if (cost != inOther.cost)
+	{
+		return cost > inOther.cost;
+	}
+	if (from != inOther.from)
+	{
+		return from > inOther.from;
+	}
+	return to > inOther.to;
+}
+
+bool	PositionKey::operator==( const PositionKey& inOther ) const
+{
+	return (x == inOther.x) && (y == inOther.y) && (z == inOther.z);
+}
+
+size_t	PositionHash::operator()( const PositionKey& inKey ) const
+{
+	TQ3Uns32	bits[3];
+	std::memcpy( bits, &inKey, sizeof(bits) );
+	
+	// Mix all the bits, as nearby floats differ only in their low bits
+	std::uint64_t theHash = bits[0];
+	theHash = (theHash * 0x9E3779B97F4A7C15ULL) ^ bits[1];
+	theHash = (theHash * 0x9E3779B97F4A7C15ULL) ^ bits[2];
+	theHash ^= theHash >> 29;
+	theHash *= 0xBF58476D1CE4E5B9ULL;
+	theHash ^= theHash >> 32;
+	return static_cast<size_t>( theHash );
+}
+
+static inline std::uint64_t EdgeKey( TQ3Uns32 inStart, TQ3Uns32 inEnd )
+{
+	return (static_cast<std::uint64_t>( inStart ) << 32) | inEnd;
+}
+
+static TQ3Uns32 GetAttributeSize( TQ3AttributeType inType )
+{
+	TQ3Uns32	theSize = 0;
+	
+	switch (inType)
+	{
+		case kQ3AttributeTypeSurfaceUV:
+		case kQ3AttributeTypeShadingUV:
+			theSize = sizeof(TQ3Param2D);
+			break;
+		
+		case kQ3AttributeTypeNormal:
+			theSize = sizeof(TQ3Vector3D);
+			break;
+		
+		case kQ3AttributeTypeAmbientCoefficient:
+		case kQ3AttributeTypeSpecularControl:
+		case kQ3AttributeTypeMetallic:
+			theSize = sizeof(float);
+			break;
+		
+		case kQ3AttributeTypeDiffuseColor:
+		case kQ3AttributeTypeSpecularColor:
+		case kQ3AttributeTypeTransparencyColor:
+		case kQ3AttributeTypeEmissiveColor:
+			theSize = sizeof(TQ3ColorRGB);
+			break;
+		
+		case kQ3AttributeTypeSurfaceTangent:
+			theSize = sizeof(TQ3Tangent2D);
+			break;
+		
+		case kQ3AttributeTypeHighlightState:
+			theSize = sizeof(TQ3Switch);
+			break;
+		
+		case kQ3AttributeTypeSurfaceShader:
+			theSize = sizeof(TQ3SurfaceShaderObject);
+			break;
+	}
+	
+	return theSize;
+}
+
+/*
+	Copy the values of the kept elements of each attribute array whose
+	type we know.  The copies hold the surface shader objects without
+	references of their own, so they must not outlive the source data.
+*/
+static void CompactAttributes( TQ3Uns32 inNumTypes,
+								const TQ3TriMeshAttributeData* inAtts,
+								const IndexVec& inKept,
+								std::vector<TQ3TriMeshAttributeData>& outAtts,
+								std::vector< std::vector<char> >& outStorage )
+{
+	outStorage.resize( 2 * inNumTypes );
+	
+	for (TQ3Uns32 i = 0; i < inNumTypes; ++i)
+	{
+		const TQ3TriMeshAttributeData& theAtt( inAtts[i] );
+		TQ3Uns32 attSize = GetAttributeSize( theAtt.attributeType );
+		
+		if ( (attSize > 0) && (theAtt.data != nullptr) && (! inKept.empty()) )
+		{
+			std::vector<char>& theData( outStorage[ 2 * i ] );
+			std::vector<char>& theUses( outStorage[ 2 * i + 1 ] );
+			const char* srcData = static_cast<const char*>( theAtt.data );
+			
+			theData.resize( inKept.size() * attSize );
+			for (size_t k = 0; k < inKept.size(); ++k)
+			{
+				std::memcpy( &theData[ k * attSize ], srcData + inKept[k] * attSize,
+					attSize );
+			}
+			
+			TQ3TriMeshAttributeData newAtt = { theAtt.attributeType, &theData[0], nullptr };
+			
+			if (theAtt.attributeUseArray != nullptr)
+			{
+				theUses.resize( inKept.size() );
+				for (size_t k = 0; k < inKept.size(); ++k)
+				{
+					theUses[k] = theAtt.attributeUseArray[ inKept[k] ];
+				}
+				newAtt.attributeUseArray = &theUses[0];
+			}
+			
+			outAtts.push_back( newAtt );
+		}
+	}
+}
+
+Simplifier::Simplifier( const TQ3TriMeshData& inData )
+	: mData( inData )
+	, mPosition( inData.numPoints )
+	, mTriangles( inData.triangles, inData.triangles + inData.numTriangles )
+	, mAlive( inData.numTriangles, true )
+	, mNumAlive( inData.numTriangles )
+	, mPosTriangles( inData.numPoints )
+	, mBorder( inData.numPoints, false )
+	, mLocked( inData.numPoints, false )
+	, mRemoved( inData.numPoints, false )
+	, mStamp( inData.numPoints, 0 )
+	, mQuadrics( inData.numPoints, Quadric() )
+	, mMaxError( 0.0 )
+{
+	WeldPositions();
+	
+	// Drop triangles that do not have 3 distinct positions, and list the
+	// triangles at each position.
+	for (TQ3Uns32 t = 0; t < inData.numTriangles; ++t)
+	{
+		const TQ3Uns32* pts = mTriangles[t].pointIndices;
+		TQ3Uns32 p0 = mPosition[ pts[0] ];
+		TQ3Uns32 p1 = mPosition[ pts[1] ];
+		TQ3Uns32 p2 = mPosition[ pts[2] ];
+		
+		if ( (p0 == p1) || (p1 == p2) || (p2 == p0) )
+		{
+			mAlive[t] = false;
+			mNumAlive -= 1;
+		}
+		else
+		{
+			mPosTriangles[ p0 ].push_back( t );
+			mPosTriangles[ p1 ].push_back( t );
+			mPosTriangles[ p2 ].push_back( t );
+		}
+	}
+	
+	ClassifyEdges();
+	BuildQuadrics();
+}
+
+void	Simplifier::WeldPositions()
+{
+	std::unordered_map< PositionKey, TQ3Uns32, PositionHash >	firstAtPosition;
+	firstAtPosition.reserve( mData.numPoints );
+	
+	for (TQ3Uns32 i = 0; i < mData.numPoints; ++i)
+	{
+		// Adding 0 turns -0 into +0, so that they weld
+		const TQ3Point3D& thePt( mData.points[i] );
+		PositionKey theKey = { thePt.x + 0.0f, thePt.y + 0.0f, thePt.z + 0.0f };
+		
+		mPosition[i] = firstAtPosition.insert( std::make_pair( theKey, i ) ).first->second;
+	}
+}
+
+/*
+	An edge between positions used by one triangle is on the boundary.  An
+	edge used by more than two triangles, or by two that disagree about its
+	direction, locks its ends in place.  An edge whose two triangles use
+	different points at either end is a seam.  Boundaries and seams get
+	planes through the edge, perpendicular to the triangle, that hold
+	them in place.
+*/
+void	Simplifier::ClassifyEdges()
+{
+	// Sorted lists of directed edges, with repeats
+	std::vector<std::uint64_t>	posEdges, pointEdges;
+	TQ3Uns32 t, k;
+	
+	posEdges.reserve( 3 * mNumAlive );
+	pointEdges.reserve( 3 * mNumAlive );
+	for (t = 0; t < mData.numTriangles; ++t)
+	{
+		if (mAlive[t])
+		{
+			for (k = 0; k < 3; ++k)
+			{
+				TQ3Uns32 a = mTriangles[t].pointIndices[k];
+				TQ3Uns32 b = mTriangles[t].pointIndices[ (k + 1) % 3 ];
+				
+				posEdges.push_back( EdgeKey( mPosition[a], mPosition[b] ) );
+				pointEdges.push_back( EdgeKey( a, b ) );
+			}
+		}
+	}
+	std::sort( posEdges.begin(), posEdges.end() );
+	std::sort( pointEdges.begin(), pointEdges.end() );
+	
+	for (t = 0; t < mData.numTriangles; ++t)
+	{
+		if (! mAlive[t])
+		{
+			continue;
+		}
+		
+		for (k = 0; k < 3; ++k)
+		{
+			TQ3Uns32 a = mTriangles[t].pointIndices[k];
+			TQ3Uns32 b = mTriangles[t].pointIndices[ (k + 1) % 3 ];
+			TQ3Uns32 pa = mPosition[a];
+			TQ3Uns32 pb = mPosition[b];
+			
+			auto forward = std::equal_range( posEdges.begin(), posEdges.end(),
+				EdgeKey( pa, pb ) );
+			auto backward = std::equal_range( posEdges.begin(), posEdges.end(),
+				EdgeKey( pb, pa ) );
+			auto numForward = forward.second - forward.first;
+			auto numBackward = backward.second - backward.first;
+			bool isBoundary = false;
+			
+			if ( (numForward == 1) && (numBackward == 0) )
+			{
+				mBorder[ pa ] = true;
+				mBorder[ pb ] = true;
+				isBoundary = true;
+			}
+			else if ( (numForward != 1) || (numBackward != 1) )
+			{
+				mLocked[ pa ] = true;
+				mLocked[ pb ] = true;
+			}
+			else if (! std::binary_search( pointEdges.begin(), pointEdges.end(),
+				EdgeKey( b, a ) ))
+			{
+				isBoundary = true;	// a seam
+			}
+			
+			if (isBoundary)
+			{
+				const TQ3Point3D& pt0( mData.points[ pa ] );
+				const TQ3Point3D& pt1( mData.points[ pb ] );
+				const TQ3Point3D& pt2( mData.points[ mPosition[
+					mTriangles[t].pointIndices[ (k + 2) % 3 ] ] ] );
+				TQ3Vector3D faceNormal = Q3Cross3D( pt1 - pt0, pt2 - pt0 );
+				TQ3Vector3D edgeVec = pt1 - pt0;
+				TQ3Vector3D sideNormal = Q3Cross3D( edgeVec, faceNormal );
+				float sideLength = Q3Length3D( sideNormal );
+				
+				if (sideLength > 0.0f)
+				{
+					sideNormal = (1.0f / sideLength) * sideNormal;
+					double theDist = - (sideNormal.x * pt0.x + sideNormal.y * pt0.y +
+						sideNormal.z * pt0.z);
+					double theWeight = kBoundaryWeight * Q3LengthSquared3D( edgeVec );
+					
+					mQuadrics[ pa ].AddPlane( sideNormal, theDist, theWeight );
+					mQuadrics[ pb ].AddPlane( sideNormal, theDist, theWeight );
+				}
+			}
+		}
+	}
+}
+
+void	Simplifier::BuildQuadrics()
+{
+	for (TQ3Uns32 t = 0; t < mData.numTriangles; ++t)
+	{
+		if (! mAlive[t])
+		{
+			continue;
+		}
+		
+		const TQ3Uns32* pts = mTriangles[t].pointIndices;
+		TQ3Uns32 p0 = mPosition[ pts[0] ];
+		TQ3Uns32 p1 = mPosition[ pts[1] ];
+		TQ3Uns32 p2 = mPosition[ pts[2] ];
+		const TQ3Point3D& pt0( mData.points[ p0 ] );
+		TQ3Vector3D theNormal = Q3Cross3D( mData.points[ p1 ] - pt0,
+			mData.points[ p2 ] - pt0 );
+		float twiceArea = Q3Length3D( theNormal );
+		
+		if (twiceArea > 0.0f)
+		{
+			theNormal = (1.0f / twiceArea) * theNormal;
+			double theDist = - (theNormal.x * pt0.x + theNormal.y * pt0.y +
+				theNormal.z * pt0.z);
+			double theArea = 0.5 * twiceArea;
+			
+			for (TQ3Uns32 thePos : { p0, p1, p2 })
+			{
+				mQuadrics[ thePos ].AddPlane( theNormal, theDist, theArea );
+				mQuadrics[ thePos ].weight += theArea;
+			}
+		}
+	}
+}
+
+void	Simplifier::GatherRing( TQ3Uns32 inPos, IndexVec& outRing ) const
+{
+	outRing.clear();
+	
+	for (TQ3Uns32 t : mPosTriangles[ inPos ])
+	{
+		if (mAlive[t])
+		{
+			for (TQ3Uns32 k = 0; k < 3; ++k)
+			{
+				TQ3Uns32 thePos = mPosition[ mTriangles[t].pointIndices[k] ];
+				if (thePos != inPos)
+				{
+					outRing.push_back( thePos );
+				}
+			}
+		}
+	}
+	
+	std::sort( outRing.begin(), outRing.end() );
+	outRing.erase( std::unique( outRing.begin(), outRing.end() ), outRing.end() );
+}
+
+// Corner (0, 1 or 2) of a triangle at a position, or 3 if none.
+TQ3Uns32	Simplifier::CornerOf( TQ3Uns32 inTriangle, TQ3Uns32 inPos ) const
+{
+	TQ3Uns32 k = 0;
+	
+	while ( (k < 3) && (mPosition[ mTriangles[ inTriangle ].pointIndices[k] ] != inPos) )
+	{
+		++k;
+	}
+	
+	return k;
+}
+
+double	Simplifier::CollapseCost( TQ3Uns32 inFrom, TQ3Uns32 inTo ) const
+{
+	Quadric theQuadric( mQuadrics[ inFrom ] );
+	theQuadric.Add( mQuadrics[ inTo ] );
+	
+	double theCost = theQuadric.Evaluate( mData.points[ inTo ] );
+	if (theQuadric.weight > 0.0)
+	{
+		theCost /= theQuadric.weight;
+	}
+	
+	return theCost;
+}
+
+/*
+	Queue the cheapest allowed collapse of a position onto one of its
+	neighbors.  Keeping one entry per position, rather than one per edge,
+	keeps the queue small.
+*/
+void	Simplifier::QueueBestCollapse( TQ3Uns32 inFrom )
+{
+	if (mLocked[ inFrom ] || mRemoved[ inFrom ])
+	{
+		return;
+	}
+	
+	IndexVec	theRing;
+	GatherRing( inFrom, theRing );
+	
+	std::vector<Collapse>	theChoices;
+	theChoices.reserve( theRing.size() );
+	for (TQ3Uns32 theNeighbor : theRing)
+	{
+		if (! mLocked[ theNeighbor ])
+		{
+			Collapse theCollapse = { CollapseCost( inFrom, theNeighbor ), inFrom,
+				theNeighbor, mStamp[ inFrom ], mStamp[ theNeighbor ] };
+			theChoices.push_back( theCollapse );
+		}
+	}
+	std::sort( theChoices.begin(), theChoices.end(), std::greater<Collapse>() );
+	
+	WedgeVec	theWedges;
+	while (! theChoices.empty())
+	{
+		if (CanCollapse( inFrom, theChoices.back().to, theWedges ))
+		{
+			mQueue.push( theChoices.back() );
+			break;
+		}
+		theChoices.pop_back();
+	}
+}
+
+bool	Simplifier::CanCollapse( TQ3Uns32 inFrom, TQ3Uns32 inTo, WedgeVec& outWedges )
+{
+	TQ3Uns32	numShared = 0;
+	
+	outWedges.clear();
+	
+	// Each point at the moving position must go to one point at the fixed
+	// position, as decided by the triangles that contain the edge.
+	for (TQ3Uns32 t : mPosTriangles[ inFrom ])
+	{
+		TQ3Uns32 toCorner = mAlive[t]? CornerOf( t, inTo ) : 3;
+		
+		if (toCorner < 3)
+		{
+			TQ3Uns32 fromPt = mTriangles[t].pointIndices[ CornerOf( t, inFrom ) ];
+			TQ3Uns32 toPt = mTriangles[t].pointIndices[ toCorner ];
+			auto found = std::find_if( outWedges.begin(), outWedges.end(),
+				[fromPt]( const WedgePair& inPair ) { return inPair.fromPt == fromPt; } );
+			
+			if (found == outWedges.end())
+			{
+				WedgePair thePair = { fromPt, toPt };
+				outWedges.push_back( thePair );
+			}
+			else if (found->toPt != toPt)
+			{
+				return false;	// would cross a seam
+			}
+			
+			numShared += 1;
+		}
+	}
+	
+	// A boundary may only shrink along itself
+	if (numShared != (mBorder[ inFrom ]? 1U : 2U))
+	{
+		return false;
+	}
+	
+	for (TQ3Uns32 t : mPosTriangles[ inFrom ])
+	{
+		if (mAlive[t])
+		{
+			TQ3Uns32 fromPt = mTriangles[t].pointIndices[ CornerOf( t, inFrom ) ];
+			if (std::none_of( outWedges.begin(), outWedges.end(),
+				[fromPt]( const WedgePair& inPair ) { return inPair.fromPt == fromPt; } ))
+			{
+				return false;	// a seam point would be left behind
+			}
+		}
+	}
+	
+	// Link condition: the edge's triangles must account for all the
+	// neighbors in common, or the result would not be a manifold.
+	IndexVec	fromRing, toRing, commonRing;
+	GatherRing( inFrom, fromRing );
+	GatherRing( inTo, toRing );
+	std::set_intersection( fromRing.begin(), fromRing.end(),
+		toRing.begin(), toRing.end(), std::back_inserter( commonRing ) );
+	if (commonRing.size() != numShared)
+	{
+		return false;
+	}
+	
+	// Refuse to fold or badly turn the triangles that stay
+	const TQ3Point3D& toPt( mData.points[ inTo ] );
+	for (TQ3Uns32 t : mPosTriangles[ inFrom ])
+	{
+		if ( (! mAlive[t]) || (CornerOf( t, inTo ) < 3) )
+		{
+			continue;
+		}
+		
+		TQ3Uns32 fromCorner = CornerOf( t, inFrom );
+		const TQ3Uns32* pts = mTriangles[t].pointIndices;
+		const TQ3Point3D& pt1( mData.points[ mPosition[ pts[ (fromCorner + 1) % 3 ] ] ] );
+		const TQ3Point3D& pt2( mData.points[ mPosition[ pts[ (fromCorner + 2) % 3 ] ] ] );
+		TQ3Vector3D oldNormal = Q3Cross3D( pt1 - mData.points[ inFrom ],
+			pt2 - mData.points[ inFrom ] );
+		TQ3Vector3D newNormal = Q3Cross3D( pt1 - toPt, pt2 - toPt );
+		
+		if (Q3Dot3D( oldNormal, newNormal ) <=
+			kMinNormalCosine * Q3Length3D( oldNormal ) * Q3Length3D( newNormal ))
+		{
+			return false;
+		}
+	}
+	
+	return true;
+}
+
+void	Simplifier::DoCollapse( TQ3Uns32 inFrom, TQ3Uns32 inTo, const WedgeVec& inWedges )
+{
+	IndexVec& toTriangles( mPosTriangles[ inTo ] );
+	IndexVec	theRing;
+	GatherRing( inFrom, theRing );
+	
+	for (TQ3Uns32 t : mPosTriangles[ inFrom ])
+	{
+		if (! mAlive[t])
+		{
+			continue;
+		}
+		
+		if (CornerOf( t, inTo ) < 3)
+		{
+			mAlive[t] = false;
+			mNumAlive -= 1;
+		}
+		else
+		{
+			TQ3Uns32& thePt( mTriangles[t].pointIndices[ CornerOf( t, inFrom ) ] );
+			for (const WedgePair& thePair : inWedges)
+			{
+				if (thePair.fromPt == thePt)
+				{
+					thePt = thePair.toPt;
+					break;
+				}
+			}
+			toTriangles.push_back( t );
+		}
+	}
+	
+	mPosTriangles[ inFrom ].clear();
+	mRemoved[ inFrom ] = true;
+	mQuadrics[ inTo ].Add( mQuadrics[ inFrom ] );
+	
+	// The neighbors of the moved position have new neighborhoods.  Other
+	// collapses onto the fixed position are refreshed when they come up.
+	for (TQ3Uns32 thePos : theRing)
+	{
+		IndexVec& posTriangles( mPosTriangles[ thePos ] );
+		posTriangles.erase( std::remove_if( posTriangles.begin(), posTriangles.end(),
+			[this]( TQ3Uns32 t ) { return ! mAlive[t]; } ), posTriangles.end() );
+		mStamp[ thePos ] += 1;
+	}
+	for (TQ3Uns32 thePos : theRing)
+	{
+		QueueBestCollapse( thePos );
+	}
+}
+
+void	Simplifier::Run( TQ3Uns32 inTargetTriangleCount, double inMaxError )
+{
+	double		maxCost = (inMaxError < 0.0)? HUGE_VAL : inMaxError * inMaxError;
+	double		doneCost = 0.0;
+	WedgeVec	theWedges;
+	TQ3Uns32	thePos;
+	
+	for (thePos = 0; thePos < mData.numPoints; ++thePos)
+	{
+		if (mPosition[ thePos ] == thePos)
+		{
+			QueueBestCollapse( thePos );
+		}
+	}
+	
+	while ( (mNumAlive > inTargetTriangleCount) && (! mQueue.empty()) )
+	{
+		Collapse theCollapse = mQueue.top();
+		mQueue.pop();
+		
+		if ( mRemoved[ theCollapse.from ] ||
+			(mStamp[ theCollapse.from ] != theCollapse.fromStamp) )
+		{
+			continue;	// replaced by a newer entry
+		}
+		
+		if ( mRemoved[ theCollapse.to ] ||
+			(mStamp[ theCollapse.to ] != theCollapse.toStamp) )
+		{
+			QueueBestCollapse( theCollapse.from );
+			continue;
+		}
+		
+		if (theCollapse.cost > maxCost)
+		{
+			break;
+		}
+		
+		if (CanCollapse( theCollapse.from, theCollapse.to, theWedges ))
+		{
+			DoCollapse( theCollapse.from, theCollapse.to, theWedges );
+			doneCost = std::max( doneCost, theCollapse.cost );
+		}
+		else
+		{
+			QueueBestCollapse( theCollapse.from );
+		}
+	}
+	
+	mMaxError = std::sqrt( doneCost );
+}
+
+TQ3GeometryObject	Simplifier::MakeResult() const
+{
+	// Keep the points still in use, in their original order
+	IndexVec	keptPoints, keptTriangles;
+	IndexVec	newIndex( mData.numPoints, 0 );
+	std::vector<bool>	isUsed( mData.numPoints, false );
+	TQ3Uns32	i;
+	
+	for (i = 0; i < mData.numTriangles; ++i)
+	{
+		if (mAlive[i])
+		{
+			keptTriangles.push_back( i );
+			for (TQ3Uns32 thePt : mTriangles[i].pointIndices)
+			{
+				isUsed[ thePt ] = true;
+			}
+		}
+	}
+	
+	std::vector<TQ3Point3D>	newPoints;
+	for (i = 0; i < mData.numPoints; ++i)
+	{
+		if (isUsed[i])
+		{
+			newIndex[i] = static_cast<TQ3Uns32>( keptPoints.size() );
+			keptPoints.push_back( i );
+			newPoints.push_back( mData.points[i] );
+		}
+	}
+	
+	std::vector<TQ3TriMeshTriangleData>	newTriangles( keptTriangles.size() );
+	for (i = 0; i < keptTriangles.size(); ++i)
+	{
+		for (TQ3Uns32 k = 0; k < 3; ++k)
+		{
+			newTriangles[i].pointIndices[k] =
+				newIndex[ mTriangles[ keptTriangles[i] ].pointIndices[k] ];
+		}
+	}
+	
+	std::vector<TQ3TriMeshAttributeData>	vertAtts, faceAtts;
+	std::vector< std::vector<char> >		vertStorage, faceStorage;
+	CompactAttributes( mData.numVertexAttributeTypes, mData.vertexAttributeTypes,
+		keptPoints, vertAtts, vertStorage );
+	CompactAttributes( mData.numTriangleAttributeTypes, mData.triangleAttributeTypes,
+		keptTriangles, faceAtts, faceStorage );
+	
+	TQ3TriMeshData tmData = {
+		mData.triMeshAttributeSet,
+		static_cast<TQ3Uns32>( newTriangles.size() ),
+		newTriangles.empty()? nullptr : &newTriangles[0],
+		static_cast<TQ3Uns32>( faceAtts.size() ),
+		faceAtts.empty()? nullptr : &faceAtts[0],
+		0,
+		nullptr,
+		0,
+		nullptr,
+		static_cast<TQ3Uns32>( newPoints.size() ),
+		newPoints.empty()? nullptr : &newPoints[0],
+		static_cast<TQ3Uns32>( vertAtts.size() ),
+		vertAtts.empty()? nullptr : &vertAtts[0],
+		mData.bBox
+	};
+	
+	if (! newPoints.empty())
+	{
+		Q3BoundingBox_SetFromPoints3D( &tmData.bBox, &newPoints[0],
+			tmData.numPoints, sizeof(TQ3Point3D) );
+	}
+	
+	return Q3TriMesh_New( &tmData );
+}
+
+/*!
+	@function	SimplifyTriMesh
+	
+	@abstract	Make a TriMesh with fewer triangles that approximates a given
+				TriMesh, for use as a lower level of detail.
+	
+	@discussion	See the header for details.
+	
+	@param		inTriMesh				A TriMesh object.
+	@param		inTargetTriangleCount	Number of triangles to stop at.
+	@param		inMaxError				Largest error allowed for a collapse.
+	@param		outError				Receives the largest error of the
+										collapses that were done.  May be
+										nullptr.
+	@result		A new TriMesh, or nullptr on failure.
+*/
+TQ3GeometryObject	SimplifyTriMesh( TQ3GeometryObject inTriMesh,
+									TQ3Uns32 inTargetTriangleCount,
+									float inMaxError,
+									float* outError )
+{
+	TQ3GeometryObject result = nullptr;
+	// Test for bad parameters
+	if ( (inTriMesh == nullptr) ||
+		(! Q3Object_IsType( inTriMesh, kQ3GeometryTypeTriMesh )) )
+	{
+		return result;
+	}
+	
+	TQ3TriMeshData* oldData = nullptr;
+	if (kQ3Success == Q3TriMesh_LockData( inTriMesh, kQ3True, &oldData ))
+	{
+		try
+		{
+			Simplifier	theSimplifier( *oldData );
+			theSimplifier.Run( inTargetTriangleCount, inMaxError );
+			result = theSimplifier.MakeResult();
+			
+			if (outError != nullptr)
+			{
+				*outError = static_cast<float>( theSimplifier.MaxError() );
+			}
+		}
+		catch (const std::bad_alloc&)
+		{
+			result = nullptr;
+		}
+		
+		Q3TriMesh_UnlockData( inTriMesh );
+	}
+	
+	return result;
+}
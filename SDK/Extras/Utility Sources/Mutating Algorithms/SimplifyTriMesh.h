@@ -0,0 +1,103 @@
+/*  NAME:
+        SimplifyTriMesh.h
+
+    DESCRIPTION:
+        Quesa utility header.
+
+    COPYRIGHT:
+        Copyright (c) 2025, Quesa Developers. All rights reserved.
+
+        For the current release of Quesa, please see:
+
+            <https://github.com/jwwalker/Quesa>
+        
+        Redistribution and use in source and binary forms, with or without
+        modification, are permitted provided that the following conditions
+        are met:
+        
+            o Redistributions of source code must retain the above copyright
+              notice, this list of conditions and the following disclaimer.
+        
+            o Redistributions in binary form must reproduce the above
+              copyright notice, this list of conditions and the following
+              disclaimer in the documentation and/or other materials provided
+              with the distribution.
+        
+            o Neither the name of Quesa nor the names of its contributors
+              may be used to endorse or promote products derived from this
+              software without specific prior written permission.
+        
+        THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+        "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+        LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+        A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+        OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+        SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+        TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+        PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+        LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+        NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+        SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+    ___________________________________________________________________________
+*/
+#ifndef QUESA_SIMPLIFYTRIMESH_HDR
+#define QUESA_SIMPLIFYTRIMESH_HDR
+
+#include <Quesa/Quesa.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+	@function	SimplifyTriMesh
+	
+	@abstract	Make a TriMesh with fewer triangles that approximates a given
+				TriMesh, for use as a lower level of detail.
+	
+	@discussion	Edges are collapsed one at a time, cheapest first, where the
+				cost of moving a point is measured with the quadric error
+				metric of Garland and Heckbert.  A point is always moved onto a
+				neighboring point, so the surviving points keep their original
+				positions and attributes.
+				
+				Points with equal positions but different attributes, such as
+				the two sides of a texture seam, are moved together, and only
+				along the seam.  Seams and the boundary of the mesh are kept in
+				place by extra error terms.  Parts of the mesh where more than
+				two triangles share an edge are left alone.
+				
+				The error of a point is the root mean square distance from it
+				to the planes of the original triangles that were merged into
+				it, weighted by area.  Collapses stop when the triangle count
+				reaches the target, or when no collapse has an error within the
+				bound.
+				
+				Vertex and triangle attributes of the standard types are kept.
+				Attributes of custom types and edges are discarded.  The result
+				depends only on the input, and the time taken is approximately
+				proportional to n log n, for n triangles.
+	
+	@param		inTriMesh				A TriMesh object.
+	@param		inTargetTriangleCount	Number of triangles to stop at.  Pass 0
+										to limit only by error.
+	@param		inMaxError				Largest error allowed for a collapse,
+										in the units of the TriMesh.  Pass a
+										negative value to limit only by the
+										triangle count.
+	@param		outError				Receives the largest error of the
+										collapses that were done.  May be
+										nullptr.
+	@result		A new TriMesh, or nullptr on failure.
+*/
+TQ3GeometryObject	SimplifyTriMesh( TQ3GeometryObject inTriMesh,
+									TQ3Uns32 inTargetTriangleCount,
+									float inMaxError,
+									float* outError );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -638,6 +638,9 @@ enum QUESA_ENUM_BASE(TQ3Int32) {
         kQ3PickTypeWindowPoint                  = Q3_OBJECT_TYPE('p', 'k', 'w', 'p'),
         kQ3PickTypeWindowRect                   = Q3_OBJECT_TYPE('p', 'k', 'w', 'r'),
         kQ3PickTypeWorldRay                     = Q3_OBJECT_TYPE('p', 'k', 'r', 'y'),
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+        kQ3PickTypeWorldRayBatch                = Q3_OBJECT_TYPE('p', 'k', 'r', 'b'),
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
     kQ3ObjectTypeShared                         = Q3_OBJECT_TYPE('s', 'h', 'r', 'd'),
         kQ3SharedTypeRenderer                   = Q3_OBJECT_TYPE('r', 'd', 'd', 'r'),
             kQ3RendererTypeWireFrame            = Q3_OBJECT_TYPE('w', 'r', 'f', 'r'),
@@ -670,6 +673,9 @@ enum QUESA_ENUM_BASE(TQ3Int32) {
                 kQ3GeometryTypeTorus            = Q3_OBJECT_TYPE('t', 'o', 'r', 's'),
                 kQ3GeometryTypeTriMesh          = Q3_OBJECT_TYPE('t', 'm', 's', 'h'),
                 kQ3GeometryTypeNakedTriMesh     = Q3_OBJECT_TYPE('n', 't', 'm', 's'),
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+                kQ3GeometryTypeInstanceArray    = Q3_OBJECT_TYPE('i', 'n', 's', 'a'),
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
             kQ3ShapeTypeShader                  = Q3_OBJECT_TYPE('s', 'h', 'd', 'r'),
                 kQ3ShaderTypeSurface            = Q3_OBJECT_TYPE('s', 'u', 's', 'h'),
                     kQ3SurfaceShaderTypeTexture = Q3_OBJECT_TYPE('t', 'x', 's', 'u'),
@@ -729,6 +735,9 @@ enum QUESA_ENUM_BASE(TQ3Int32) {
                 kQ3GroupTypeDisplay             = Q3_OBJECT_TYPE('d', 's', 'p', 'g'),
                     kQ3DisplayGroupTypeOrdered  = Q3_OBJECT_TYPE('o', 'r', 'd', 'g'),
                     kQ3DisplayGroupTypeIOProxy  = Q3_OBJECT_TYPE('i', 'o', 'p', 'x'),
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+                    kQ3DisplayGroupTypeLOD      = Q3_OBJECT_TYPE('l', 'o', 'd', 'g'),
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
                 kQ3GroupTypeLight               = Q3_OBJECT_TYPE('l', 'g', 'h', 'g'),
                 kQ3GroupTypeInfo                = Q3_OBJECT_TYPE('i', 'n', 'f', 'o'),
             kQ3ShapeTypeUnknown                 = Q3_OBJECT_TYPE('u', 'n', 'k', 'n'),
@@ -2568,6 +2577,44 @@ Q3Shared_GetEditIndex (
 
 
 
+
+/*!
+ *  @function
+ *      Q3Shared_GetSubtreeEditStamp
+ *  @discussion
+ *      Get a stamp which changes whenever an object, or anything it contains,
+ *      is edited.
+ *
+ *      Edit indexes only change when the object itself is edited, so finding
+ *      out whether anything within a group has changed would mean walking
+ *      the whole group.  Edit stamps instead come from one counter shared by
+ *      all objects, and the subtree stamp of a group is the latest stamp of
+ *      the group and of everything it contains.  It grows whenever a member
+ *      at any depth is edited, or a member is added or removed.  For a
+ *      geometry, edits to its attribute set are included.
+ *
+ *      A cache can record the subtree stamp, and skip its whole subtree
+ *      later if the stamp is unchanged.  Groups remember their subtree stamp
+ *      until the next edit to any object, so repeated queries on an unchanged
+ *      scene take constant time, and the first query after an edit visits
+ *      each group at most once.
+ *
+ *      <em>This function is not available in QD3D.</em>
+ *
+ *  @param sharedObject     The object to query.
+ *  @result                 The latest edit stamp within the object.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Uns32  )
+Q3Shared_GetSubtreeEditStamp (
+    TQ3SharedObject _Nonnull               sharedObject
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
 /*!
 	@function	Q3Shared_SetEditIndex
 	@abstract	Set the edit index of a shared object.
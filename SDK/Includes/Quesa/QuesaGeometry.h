@@ -483,6 +483,49 @@ typedef struct TQ3GeneralPolygonData {
 } TQ3GeneralPolygonData;
 
 
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+/*!
+ *	@struct
+ *      TQ3InstanceArrayData
+ *	@discussion
+ *		Data describing an instance array, a single shared object drawn once for
+ *		each of an array of transforms.
+ *
+ *		Each instance is drawn as if the shared object had been submitted after
+ *		its transform, so the transform of instance i maps the local coordinates
+ *		of the shared object into the local coordinates of the instance array.
+ *
+ *		<em>This structure is not available in QD3D.</em>
+ *
+ *	@field		instancedObject			The geometry or group to be instanced.
+ *	@field		numInstances			Number of instances.
+ *	@field		transforms				Array of numInstances transforms.  May be nullptr,
+ *										so long as <code>numInstances</code> is 0.
+ *	@field		instanceAttributeSets	Array of numInstances attribute sets which override
+ *										the current attributes for individual instances.
+ *										This field may be nullptr, or individual sets in
+ *										the array may be nullptr.
+ *	@field		bBox					Bounding box of the instanced object, in its own
+ *										local coordinates.  This is used to cull individual
+ *										instances.  If the box is empty, Quesa uses the
+ *										bounding box of a TriMesh or of a display group
+ *										with a bounding box, otherwise instances are not
+ *										culled.
+ *	@field		instanceArrayAttributeSet	Set of attributes for the whole array.  May be nullptr.
+ */
+typedef struct TQ3InstanceArrayData {
+    TQ3Object _Nonnull                          instancedObject;
+    TQ3Uns32                                    numInstances;
+    TQ3Matrix4x4                                * _Nullable transforms;
+    TQ3AttributeSet _Nullable * _Nullable       instanceAttributeSets;
+    TQ3BoundingBox                              bBox;
+    TQ3AttributeSet _Nullable                   instanceArrayAttributeSet;
+} TQ3InstanceArrayData;
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
 /*!
  *	@struct
  *      TQ3LineData
@@ -1228,6 +1271,90 @@ typedef struct TQ3LayerShifts
 #endif
 
 
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+/*!
+ *	@struct		TQ3TriMeshPickTreeInfo
+ *	@discussion
+ *		Information about the bounding volume hierarchy that Quesa uses to
+ *		ray pick a TriMesh, returned by <code>Q3TriMesh_BuildPickTree</code>.
+ *
+ *		<em>This structure is not available in QD3D.</em>
+ *
+ *	@field		numTriangles	Number of triangles in the hierarchy.
+ *	@field		numNodes		Number of nodes in the hierarchy.
+ *	@field		memorySize		Number of bytes used by the hierarchy.
+ *	@field		buildTime		Time taken to build the hierarchy, in seconds.
+ */
+typedef struct TQ3TriMeshPickTreeInfo {
+    TQ3Uns32                                    numTriangles;
+    TQ3Uns32                                    numNodes;
+    TQ3Uns32                                    memorySize;
+    float                                       buildTime;
+} TQ3TriMeshPickTreeInfo;
+
+
+/*!
+ *	@enum
+ *      TQ3TriMeshRenderOrderMasks
+ *	@discussion
+ *		Steps performed by <code>Q3TriMesh_OptimizeForRendering</code>.
+ *
+ *		<em>This enumeration is not available in QD3D.</em>
+ *
+ *	@constant	kQ3TriMeshRenderOrderMaskNone			No step.
+ *	@constant	kQ3TriMeshRenderOrderMaskVertexCache	Order triangles so that they
+ *							reuse vertices held in the post-transform vertex cache.
+ *	@constant	kQ3TriMeshRenderOrderMaskOverdraw		Order clusters of triangles
+ *							so that those facing away from the center of the
+ *							mesh are drawn first.
+ *	@constant	kQ3TriMeshRenderOrderMaskVertexFetch	Number points in the order
+ *							that triangles first use them.
+ *	@constant	kQ3TriMeshRenderOrderMaskAll			All steps.
+ */
+typedef enum TQ3TriMeshRenderOrderMasks QUESA_ENUM_BASE(TQ3Uns32) {
+    kQ3TriMeshRenderOrderMaskNone               = 0,
+    kQ3TriMeshRenderOrderMaskVertexCache        = (1 << 0),
+    kQ3TriMeshRenderOrderMaskOverdraw           = (1 << 1),
+    kQ3TriMeshRenderOrderMaskVertexFetch        = (1 << 2),
+    kQ3TriMeshRenderOrderMaskAll                = (kQ3TriMeshRenderOrderMaskVertexCache |
+                                                   kQ3TriMeshRenderOrderMaskOverdraw |
+                                                   kQ3TriMeshRenderOrderMaskVertexFetch),
+    kQ3TriMeshRenderOrderMaskSize32             = 0xFFFFFFFF
+} TQ3TriMeshRenderOrderMasks;
+
+typedef TQ3Uns32                                TQ3TriMeshRenderOrderMask;
+
+
+/*!
+ *	@struct		TQ3TriMeshCacheStatistics
+ *	@discussion
+ *		How well the triangle order of a TriMesh uses a vertex cache, returned
+ *		by <code>Q3TriMesh_GetCacheStatistics</code>.
+ *
+ *		<em>This structure is not available in QD3D.</em>
+ *
+ *	@field		cacheSize				Number of vertices in the simulated cache.
+ *	@field		numTransformedVertices	Number of vertices which missed the cache.
+ *	@field		acmr					Average cache miss ratio, the number of
+ *										transformed vertices per triangle.  This
+ *										is 3 with no reuse, and can approach 0.5
+ *										for a regular grid.
+ *	@field		atvr					Average transformed vertex ratio, the
+ *										number of transformed vertices per point
+ *										used by the triangles.  The best possible
+ *										value is 1.
+ */
+typedef struct TQ3TriMeshCacheStatistics {
+    TQ3Uns32                                    cacheSize;
+    TQ3Uns32                                    numTransformedVertices;
+    float                                       acmr;
+    float                                       atvr;
+} TQ3TriMeshCacheStatistics;
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
 
 
 //=============================================================================
@@ -3674,6 +3801,193 @@ Q3GeneralPolygon_GetShapeHint (
 
 
 
+/*!
+	@functiongroup	Instance Array Functions
+*/
+
+
+
+/*!
+ *  @function
+ *      Q3InstanceArray_New
+ *  @discussion
+ *      Create a new instance array geometry object.
+ *
+ *		An instance array draws a single shared geometry or group once for each
+ *		transform in an array, which is much cheaper than submitting the shared
+ *		object once per transform from a separate group.  Renderers may draw all
+ *		instances in one call; otherwise Quesa submits the instances itself
+ *		without pushing the view state for each one.
+ *
+ *		<em>This function is not available in QD3D.</em>
+ *
+ *  @param instanceArrayData	Data describing the instance array.
+ *  @result						A reference to the new geometry object, or nullptr on failure.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3GeometryObject _Nullable  )
+Q3InstanceArray_New (
+    const TQ3InstanceArrayData    * _Nonnull instanceArrayData
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
+/*!
+ *  @function
+ *      Q3InstanceArray_Submit
+ *  @discussion
+ *		Submits an instance array for drawing, picking, bounding, or writing in
+ *		immediate mode.
+ *
+ *		This function should only be called in a submitting loop.
+ *
+ *		<em>This function is not available in QD3D.</em>
+ *
+ *  @param instanceArrayData	Data describing the instance array.
+ *  @param view					The view to submit the instance array to.
+ *  @result						Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3InstanceArray_Submit (
+    const TQ3InstanceArrayData    * _Nonnull instanceArrayData,
+    TQ3ViewObject _Nonnull                 view
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
+/*!
+ *  @function
+ *      Q3InstanceArray_SetData
+ *  @discussion
+ *      Modify an instance array object by supplying a full new set of data.
+ *
+ *		<em>This function is not available in QD3D.</em>
+ *
+ *  @param instanceArray		An instance array object.
+ *  @param instanceArrayData	Data describing the instance array.
+ *  @result						Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3InstanceArray_SetData (
+    TQ3GeometryObject _Nonnull             instanceArray,
+    const TQ3InstanceArrayData    * _Nonnull instanceArrayData
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
+/*!
+ *  @function
+ *      Q3InstanceArray_GetData
+ *  @discussion
+ *      Get the data of an instance array object.
+ *
+ *		This function may allocate memory, which should be freed using
+ *		<code>Q3InstanceArray_EmptyData</code>.
+ *
+ *		<em>This function is not available in QD3D.</em>
+ *
+ *  @param instanceArray		An instance array object.
+ *  @param instanceArrayData	Receives data describing the instance array.
+ *  @result						Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3InstanceArray_GetData (
+    TQ3GeometryObject _Nonnull             instanceArray,
+    TQ3InstanceArrayData          * _Nonnull instanceArrayData
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
+/*!
+ *  @function
+ *      Q3InstanceArray_EmptyData
+ *  @discussion
+ *      Release memory allocated by <code>Q3InstanceArray_GetData</code>.
+ *
+ *		<em>This function is not available in QD3D.</em>
+ *
+ *  @param instanceArrayData	Data describing an instance array, previously obtained
+ *								with <code>Q3InstanceArray_GetData</code>.
+ *  @result						Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3InstanceArray_EmptyData (
+    TQ3InstanceArrayData          * _Nonnull instanceArrayData
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
+/*!
+ *  @function
+ *      Q3InstanceArray_GetTransform
+ *  @discussion
+ *      Get the transform of one instance of an instance array.
+ *
+ *		<em>This function is not available in QD3D.</em>
+ *
+ *  @param instanceArray	An instance array object.
+ *  @param index			A 0-based index into the array of instances.
+ *  @param transform		Receives the transform of the instance.
+ *  @result					Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3InstanceArray_GetTransform (
+    TQ3GeometryObject _Nonnull             instanceArray,
+    TQ3Uns32                               index,
+    TQ3Matrix4x4                  * _Nonnull transform
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
+/*!
+ *  @function
+ *      Q3InstanceArray_SetTransform
+ *  @discussion
+ *      Set the transform of one instance of an instance array.
+ *
+ *		<em>This function is not available in QD3D.</em>
+ *
+ *  @param instanceArray	An instance array object.
+ *  @param index			A 0-based index into the array of instances.
+ *  @param transform		The new transform of the instance.
+ *  @result					Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3InstanceArray_SetTransform (
+    TQ3GeometryObject _Nonnull             instanceArray,
+    TQ3Uns32                               index,
+    const TQ3Matrix4x4            * _Nonnull transform
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
 /*!
 	@functiongroup	Line Functions
 */
@@ -4865,7 +5179,8 @@ Q3Mesh_GetEdgeVertices (
  *  @param mesh             The mesh to query.
  *  @param edge             The edge to query.
  *  @param face1            Receives the first face of the mesh edge.
- *  @param face2            Receives the second face of the mesh edge.
+ *  @param face2            Receives the second face of the mesh edge, or
+ *                          nullptr if the edge is on a boundary.
  *  @result                 Success or failure of the operation.
  */
 Q3_EXTERN_API_C ( TQ3Status  )
@@ -4873,7 +5188,7 @@ Q3Mesh_GetEdgeFaces (
     TQ3GeometryObject _Nonnull             mesh,
     TQ3MeshEdge _Nonnull                   edge,
     TQ3MeshFace _Nonnull                   * _Nonnull face1,
-    TQ3MeshFace _Nonnull                   * _Nonnull face2
+    TQ3MeshFace _Nullable                  * _Nonnull face2
 );
 
 
@@ -7996,6 +8311,156 @@ Q3TriMesh_Optimize(
 
 
 
+/*!
+ *	@function
+ *		Q3TriMesh_OptimizeDataForRendering
+ *	@abstract
+ *		Reorder TriMesh data for efficient drawing as an indexed triangle list.
+ *	
+ *	@discussion
+ *		The steps to perform are chosen by inSteps:
+ *				<ol>
+ *					<li><code>kQ3TriMeshRenderOrderMaskVertexCache</code> orders
+ *						triangles so that each reuses vertices which are likely
+ *						to be in the post-transform vertex cache of the GPU.</li>
+ *					<li><code>kQ3TriMeshRenderOrderMaskOverdraw</code> splits
+ *						that order into clusters which keep most of the cache
+ *						benefit, and draws the clusters facing away from the
+ *						center of the mesh first, so that hidden surfaces are
+ *						more often rejected by the depth test.</li>
+ *					<li><code>kQ3TriMeshRenderOrderMaskVertexFetch</code>
+ *						renumbers points in the order that the triangles first
+ *						use them, so that vertex data is read in order.</li>
+ *				</ol>
+ *		Attributes and edges are carried along with the triangles and points
+ *		they belong to, so the result renders the same as the original.
+ *
+ *		You are responsible for calling Q3TriMesh_EmptyData on the outData
+ *		structure when you are done with it.
+ *	
+ *      <em>This function is not available in QD3D.</em>
+ *
+ *	@param		inData			TriMesh data.
+ *	@param		inSteps			A combination of TQ3TriMeshRenderOrderMasks.
+ *	@param		outData			Receives new TriMesh data.
+ *	@result		Success or failure of the operation.
+*/
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C( TQ3Status )
+Q3TriMesh_OptimizeDataForRendering( const TQ3TriMeshData* _Nonnull inData,
+								TQ3TriMeshRenderOrderMask inSteps,
+								TQ3TriMeshData* _Nonnull outData
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
+/*!
+ *	@function
+ *		Q3TriMesh_OptimizeForRendering
+ *	@abstract
+ *		Make a copy of a TriMesh reordered for efficient drawing.
+ *	
+ *	@discussion
+ *		See discussion of Q3TriMesh_OptimizeDataForRendering for the steps
+ *		that are performed.  The OpenGL renderer does this itself for large
+ *		TriMeshes, unless the <code>kQ3RendererPropertyAutomaticRenderOrder</code>
+ *		property of the renderer is false.
+ *	
+ *      <em>This function is not available in QD3D.</em>
+ *
+ *	@param		inTriMesh		A TriMesh geometry.
+ *	@param		inSteps			A combination of TQ3TriMeshRenderOrderMasks.
+ *	@result		A new TriMesh, or nullptr on failure.
+*/
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C( TQ3GeometryObject _Nullable )
+Q3TriMesh_OptimizeForRendering(
+	TQ3GeometryObject _Nonnull inTriMesh,
+	TQ3TriMeshRenderOrderMask inSteps
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
+/*!
+ *	@function
+ *		Q3TriMesh_GetCacheStatistics
+ *	@abstract
+ *		Measure how well the triangle order of TriMesh data uses a vertex cache.
+ *	
+ *	@discussion
+ *		The triangles are fed in order through a first-in first-out cache of
+ *		inCacheSize vertices.  Each vertex which is not found in the cache
+ *		counts as a transformed vertex.  Comparing the statistics before and
+ *		after <code>Q3TriMesh_OptimizeDataForRendering</code> shows the gain
+ *		for a given model.  Typical hardware caches hold 16 to 32 vertices.
+ *	
+ *      <em>This function is not available in QD3D.</em>
+ *
+ *	@param		inData			TriMesh data.
+ *	@param		inCacheSize		Number of vertices the cache holds.  Must be
+ *								greater than 0.
+ *	@param		outStats		Receives the statistics.
+ *	@result		Success or failure of the operation.
+*/
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C( TQ3Status )
+Q3TriMesh_GetCacheStatistics( const TQ3TriMeshData* _Nonnull inData,
+								TQ3Uns32 inCacheSize,
+								TQ3TriMeshCacheStatistics* _Nonnull outStats
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
+/*!
+ *	@function
+ *		Q3TriMesh_AddVertexNormals
+ *	@abstract
+ *		Add vertex normals to a TriMesh that lacks them.
+ *	
+ *	@discussion
+ *		Each corner of each triangle gets the average of the normals of the
+ *		triangles around its point which are within inCreaseAngle of its own
+ *		triangle, weighted by the angle of each triangle at the point.  Points
+ *		with identical coordinates are smoothed together, so that points which
+ *		were split for a texture seam do not show a crease.  When the corners
+ *		of a point get different normals, the point is duplicated along with
+ *		its vertex attributes, and the triangles are changed to match.
+ *
+ *		Triangle normals are used if the TriMesh has them.  Otherwise they are
+ *		computed by cross products of edges, assuming counterclockwise
+ *		orientation.  Large TriMeshes are processed on several threads.
+ *
+ *		If the TriMesh already has vertex normals, nothing is done.
+ *	
+ *      <em>This function is not available in QD3D.</em>
+ *
+ *	@param		inTriMesh		A TriMesh geometry.
+ *	@param		inCreaseAngle	Largest angle in radians between triangles that
+ *								are smoothed together.  Use kQ3Pi or more to
+ *								smooth every point, or 0 for faceted shading.
+ *	@result		Success or failure of the operation.
+*/
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C( TQ3Status )
+Q3TriMesh_AddVertexNormals(
+	TQ3GeometryObject _Nonnull inTriMesh,
+	float inCreaseAngle
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
 /*!
 	@function		Q3TriMesh_MakeTriangleStrip
 	@abstract		Compute a triangle strip.
@@ -8082,6 +8547,74 @@ Q3_EXTERN_API_C( void )
 Q3TriMesh_SetNakedGeometry( TQ3GeometryObject _Nonnull inTriMesh,
 							TQ3GeometryObject _Nonnull inNaked );
 
+
+
+/*!
+ *	@function
+ *		Q3TriMesh_BuildPickTree
+ *	@abstract
+ *		Build the bounding volume hierarchy used to ray pick a TriMesh.
+ *
+ *	@discussion
+ *		When a retained TriMesh is picked with a window-point or world-ray
+ *		pick, Quesa builds a bounding volume hierarchy over its triangles in
+ *		local coordinates, and keeps it until the TriMesh is edited.  The
+ *		pick ray is then transformed into local coordinates and only tested
+ *		against triangles whose boxes it passes through.
+ *
+ *		The hierarchy is normally built by the first pick.  For large meshes
+ *		this can take a noticeable time, so an application may call this
+ *		function beforehand, for instance after loading a model.  If the
+ *		hierarchy is already up to date, it is not rebuilt.
+ *
+ *		Picks with a face tolerance, or under a projective local to world
+ *		transform, still test every triangle.  TriMeshes with only a few
+ *		triangles do not use a hierarchy.
+ *
+ *      <em>This function is not available in QD3D.</em>
+ *
+ *	@param		triMesh			A TriMesh object.
+ *	@param		outInfo			Receives information about the hierarchy.
+ *								May be nullptr.
+ *	@result		Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C( TQ3Status )
+Q3TriMesh_BuildPickTree(
+	TQ3GeometryObject _Nonnull triMesh,
+	TQ3TriMeshPickTreeInfo* _Nullable outInfo
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
+/*!
+ *	@function
+ *		Q3TriMesh_DisposePickTree
+ *	@abstract
+ *		Release the bounding volume hierarchy used to ray pick a TriMesh.
+ *
+ *	@discussion
+ *		Frees the memory of the hierarchy built by
+ *		<code>Q3TriMesh_BuildPickTree</code> or by an earlier pick.  It will
+ *		be built again if the TriMesh is picked later.
+ *
+ *      <em>This function is not available in QD3D.</em>
+ *
+ *	@param		triMesh			A TriMesh object.
+ *	@result		Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C( TQ3Status )
+Q3TriMesh_DisposePickTree(
+	TQ3GeometryObject _Nonnull triMesh
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
 // Work around a HeaderDoc bug
 /*!
 	@functiongroup
@@ -262,6 +262,36 @@ typedef Q3_CALLBACK_API_C(TQ3Status,           TQ3XGroupEndReadMethod)(
                             TQ3GroupObject _Nonnull     theGroup);
 
 
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+/*!
+ *	@struct		TQ3GroupPickTreeInfo
+ *	@discussion
+ *		Information about the bounding volume hierarchy that Quesa uses to
+ *		ray pick the contents of a group, returned by
+ *		<code>Q3Group_BuildPickTree</code>.
+ *
+ *		<em>This structure is not available in QD3D.</em>
+ *
+ *	@field		numObjects			Number of objects found in the group and
+ *									the groups nested inside it.
+ *	@field		numUnboundedObjects	Number of those objects which are
+ *									submitted to every pick.
+ *	@field		numNodes			Number of nodes in the hierarchy.
+ *	@field		memorySize			Number of bytes used by the hierarchy.
+ *	@field		buildTime			Time taken to build the hierarchy, in seconds.
+ */
+typedef struct TQ3GroupPickTreeInfo {
+    TQ3Uns32                                    numObjects;
+    TQ3Uns32                                    numUnboundedObjects;
+    TQ3Uns32                                    numNodes;
+    TQ3Uns32                                    memorySize;
+    float                                       buildTime;
+} TQ3GroupPickTreeInfo;
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
 
 
 
@@ -891,6 +921,85 @@ Q3Group_GetPreviousObjectPosition (
 
 
 
+/*!
+ *	@function
+ *		Q3Group_BuildPickTree
+ *	@abstract
+ *		Build a bounding volume hierarchy used to ray pick the contents of
+ *		a group.
+ *
+ *	@discussion
+ *		Once a group has a pick tree, window-point and world-ray picks of the
+ *		group submit only the objects whose bounding boxes the pick ray
+ *		passes through, instead of every object in the group and the groups
+ *		nested inside it.  The hits, including their hit paths, are the same
+ *		as without the tree.  When the pick sorts its hits near to far and
+ *		returns only one, objects are visited near to far and the search
+ *		stops once no remaining object can be nearer than the best hit.
+ *
+ *		The tree follows edits to the group and its contents.  When objects
+ *		are edited, only their bounds are measured again; when groups gain or
+ *		lose members, the tree is rebuilt by the next pick.
+ *
+ *		Nested groups are looked into if they are plain, display or ordered
+ *		display groups.  Other groups, and objects such as markers whose
+ *		bounds do not limit where they can be hit, are submitted to every
+ *		pick.  Picks with a face tolerance, window-rect picks, and picks
+ *		under a projective local to world transform traverse the group as
+ *		usual, as do lines and points when the pick has a vertex or edge
+ *		tolerance.
+ *
+ *		This function fails if the group is not a plain, display or ordered
+ *		display group, or contains state operators or state changes that
+ *		leak out of nested groups.  The tree is not copied by
+ *		<code>Q3Object_Duplicate</code>.
+ *
+ *      <em>This function is not available in QD3D.</em>
+ *
+ *	@param		group			A group.
+ *	@param		outInfo			Receives information about the hierarchy.
+ *								May be nullptr.
+ *	@result		Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3Group_BuildPickTree (
+    TQ3GroupObject _Nonnull               group,
+    TQ3GroupPickTreeInfo                  * _Nullable outInfo
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
+/*!
+ *	@function
+ *		Q3Group_DisposePickTree
+ *	@abstract
+ *		Dispose of the bounding volume hierarchy built by
+ *		<code>Q3Group_BuildPickTree</code>.
+ *
+ *	@discussion
+ *		Picks of the group then traverse all of its contents again.  It is
+ *		not an error to call this function for a group without a tree.
+ *
+ *      <em>This function is not available in QD3D.</em>
+ *
+ *	@param		group			A group.
+ *	@result		Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3Group_DisposePickTree (
+    TQ3GroupObject _Nonnull               group
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
 /*!
 	@functiongroup Display Groups
 */
@@ -1208,6 +1317,250 @@ Q3IOProxyDisplayGroup_New (
 
 
 
+/*!
+ *  @function
+ *      Q3LODDisplayGroup_New
+ *  @discussion
+ *      Create a new level of detail display group.
+ *
+ *		A level of detail (LOD) display group contains several alternate
+ *		representations of the same object, from the most detailed first to
+ *		the least detailed last.  When the group is drawn, only one of them
+ *		is submitted, chosen by comparing the window area covered by the
+ *		group's bounding box with a list of thresholds set by
+ *		<code>Q3LODDisplayGroup_SetThresholds</code>.
+ *
+ *		The group must have a bounding box, set with
+ *		<code>Q3DisplayGroup_SetAndUseBoundingBox</code> or
+ *		<code>Q3DisplayGroup_CalcAndUseBoundingBox</code>, for any choice to
+ *		be made.  Without one, or without thresholds, the first object is
+ *		always used.  When computing bounds, the first object is used.  When
+ *		writing, all objects are written.
+ *
+ *      This function returns a newly created, empty LOD display group.  If
+ *		some error occurs during creation, this returns nullptr.
+ *
+ *		<em>This function is not available in QD3D.</em>
+ *
+ *  @result                 Newly created LOD display group, or nullptr.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3GroupObject _Nullable )
+Q3LODDisplayGroup_New (
+    void
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
+/*!
+ *  @function
+ *      Q3LODDisplayGroup_SetThresholds
+ *  @discussion
+ *      Set the window areas at which an LOD display group switches between
+ *		representations.
+ *
+ *		Each threshold is an area in square pixels, and they should be in
+ *		decreasing order.  Object i in the group is drawn when the window
+ *		area of the group's bounding box, multiplied by the LOD bias of the
+ *		view, is at least threshold i.  If the area is smaller than every
+ *		threshold, the object following the last threshold is drawn.  If
+ *		there is no such object, because there are at least as many
+ *		thresholds as objects, nothing is drawn.
+ *
+ *		<em>This function is not available in QD3D.</em>
+ *
+ *  @param group            The LOD display group to update.
+ *  @param numThresholds    The number of thresholds.
+ *  @param thresholds       The thresholds, in square pixels.  May be nullptr
+ *							if numThresholds is 0.
+ *  @result                 Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3LODDisplayGroup_SetThresholds (
+    TQ3GroupObject _Nonnull                group,
+    TQ3Uns32                      numThresholds,
+    const float                   * _Nullable thresholds
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
+/*!
+ *  @function
+ *      Q3LODDisplayGroup_GetThresholds
+ *  @discussion
+ *      Get the window area thresholds of an LOD display group.
+ *
+ *		Up to bufferCount thresholds are copied to outThresholds, and the
+ *		total number of thresholds is returned in outNumThresholds.  You can
+ *		pass 0 and nullptr to find out how large a buffer is needed.
+ *
+ *		<em>This function is not available in QD3D.</em>
+ *
+ *  @param group            The LOD display group to query.
+ *  @param bufferCount      The number of floats that outThresholds can hold.
+ *  @param outThresholds    Receives the thresholds.  May be nullptr.
+ *  @param outNumThresholds Receives the number of thresholds.
+ *  @result                 Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3LODDisplayGroup_GetThresholds (
+    TQ3GroupObject _Nonnull                group,
+    TQ3Uns32                      bufferCount,
+    float                         * _Nullable outThresholds,
+    TQ3Uns32                      * _Nonnull outNumThresholds
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
+/*!
+ *  @function
+ *      Q3LODDisplayGroup_SetHysteresis
+ *  @discussion
+ *      Set the hysteresis of an LOD display group.
+ *
+ *		To stop an object popping back and forth between two representations
+ *		when its window area is close to a threshold, the group remembers
+ *		which representation it last drew.  A more detailed representation
+ *		is only chosen once the area exceeds its threshold by this fraction,
+ *		and the current one is kept until the area falls below its threshold
+ *		by this fraction.  The default is 0.1, and values are clamped to
+ *		the range 0 to 1.
+ *
+ *		<em>This function is not available in QD3D.</em>
+ *
+ *  @param group            The LOD display group to update.
+ *  @param hysteresis       The hysteresis fraction.
+ *  @result                 Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3LODDisplayGroup_SetHysteresis (
+    TQ3GroupObject _Nonnull                group,
+    float                         hysteresis
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
+/*!
+ *  @function
+ *      Q3LODDisplayGroup_GetHysteresis
+ *  @discussion
+ *      Get the hysteresis of an LOD display group.
+ *
+ *		<em>This function is not available in QD3D.</em>
+ *
+ *  @param group            The LOD display group to query.
+ *  @param hysteresis       Receives the hysteresis fraction.
+ *  @result                 Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3LODDisplayGroup_GetHysteresis (
+    TQ3GroupObject _Nonnull                group,
+    float                         * _Nonnull hysteresis
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
+/*!
+ *  @function
+ *      Q3LODDisplayGroup_SetPickFinest
+ *  @discussion
+ *      Set whether picking an LOD display group uses its most detailed
+ *		representation.
+ *
+ *		By default, picking uses the same choice of representation as
+ *		drawing, so that what is picked matches what is seen.  If this is
+ *		set, the first (most detailed) object is always picked instead.
+ *
+ *		<em>This function is not available in QD3D.</em>
+ *
+ *  @param group            The LOD display group to update.
+ *  @param pickFinest       Whether to pick the most detailed object.
+ *  @result                 Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3LODDisplayGroup_SetPickFinest (
+    TQ3GroupObject _Nonnull                group,
+    TQ3Boolean                    pickFinest
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
+/*!
+ *  @function
+ *      Q3LODDisplayGroup_GetPickFinest
+ *  @discussion
+ *      Get whether picking an LOD display group uses its most detailed
+ *		representation.
+ *
+ *		<em>This function is not available in QD3D.</em>
+ *
+ *  @param group            The LOD display group to query.
+ *  @param pickFinest       Receives whether the most detailed object is picked.
+ *  @result                 Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3LODDisplayGroup_GetPickFinest (
+    TQ3GroupObject _Nonnull                group,
+    TQ3Boolean                    * _Nonnull pickFinest
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
+/*!
+ *  @function
+ *      Q3LODDisplayGroup_GetCurrentIndex
+ *  @discussion
+ *      Get the index of the representation most recently drawn by an LOD
+ *		display group.
+ *
+ *		The result is kQ3ArrayIndexNULL if nothing was drawn because the group
+ *		was smaller than every threshold.
+ *
+ *		<em>This function is not available in QD3D.</em>
+ *
+ *  @param group            The LOD display group to query.
+ *  @param currentIndex     Receives the index of the last drawn object.
+ *  @result                 Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3LODDisplayGroup_GetCurrentIndex (
+    TQ3GroupObject _Nonnull                group,
+    TQ3Uns32                      * _Nonnull currentIndex
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
 /*!
  *  @function
  *      Q3LightGroup_New
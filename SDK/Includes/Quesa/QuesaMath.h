@@ -106,6 +106,80 @@ extern "C" {
 #define kQ33PiOver2                             ((TQ3Float32) (3.0 * 3.1415926535898 / 2.0))
 
 
+/*!
+ *  @enum
+ *      TQ3MathKernelSet
+ *  @discussion
+ *      Implementations of the math array functions.
+ *
+ *      Array functions such as Q3Point3D_To3DTransformArray have plain
+ *      implementations and implementations using vector instructions.  The
+ *      vector instructions do the same arithmetic in the same order as the
+ *      plain loops, so they give the same results unless the compiler fuses
+ *      multiplications and additions in the plain loops.
+ *
+ *  @constant kQ3MathKernelSetAutomatic     Use the fastest implementation the
+ *                                          processor supports.
+ *  @constant kQ3MathKernelSetScalar        Use the plain loops.
+ *  @constant kQ3MathKernelSetSSE2          Use SSE2 instructions.
+ *  @constant kQ3MathKernelSetAVX2          Use AVX2 instructions.
+ *  @constant kQ3MathKernelSetNEON          Use NEON instructions.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+typedef enum TQ3MathKernelSet QUESA_ENUM_BASE(TQ3Uns32) {
+    kQ3MathKernelSetAutomatic                   = 0,
+    kQ3MathKernelSetScalar                      = 1,
+    kQ3MathKernelSetSSE2                        = 2,
+    kQ3MathKernelSetAVX2                        = 3,
+    kQ3MathKernelSetNEON                        = 4,
+    kQ3MathKernelSetSize32                      = 0xFFFFFFFF
+} TQ3MathKernelSet;
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
+
+
+//=============================================================================
+//      Types
+//-----------------------------------------------------------------------------
+/*!
+ *  @struct
+ *      TQ3Point3DArraySoA
+ *  @discussion
+ *      An array of 3D points or vectors stored as separate arrays of x, y
+ *      and z coordinates (structure of arrays).
+ *
+ *      Processing coordinates stored this way lets vector instructions work
+ *      on several points at once without first gathering their coordinates.
+ *      Use the Q3Point3DArraySoA functions to operate on whole arrays.
+ *
+ *      Arrays made by Q3Point3DArraySoA_Allocate are aligned to 32 bytes
+ *      and must be released by Q3Point3DArraySoA_Free.  You may instead
+ *      point x, y and z at float arrays of your own, in which case storage
+ *      must be NULL and nothing is copied or freed.
+ *
+ *  @field x                The x coordinates.
+ *  @field y                The y coordinates.
+ *  @field z                The z coordinates.
+ *  @field count            The number of points.
+ *  @field storage          The memory block allocated by Quesa, or NULL.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+typedef struct TQ3Point3DArraySoA {
+    float                               * _Nullable x;
+    float                               * _Nullable y;
+    float                               * _Nullable z;
+    TQ3Uns32                            count;
+    void                                * _Nullable storage;
+} TQ3Point3DArraySoA;
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
 
 
 
@@ -2802,6 +2876,41 @@ Q3Matrix4x4_SetQuaternion (
 
 
 
+/*!
+ *  @function
+ *      Q3Matrix4x4_SetQuaternionArray
+ *  @discussion
+ *      Set 4x4 matrices from arrays of rotations, scales and translations.
+ *
+ *		Each matrix scales, then rotates, then translates, which is the order
+ *		in which animation channels are usually combined.  With no scales or
+ *		translations, each matrix is the same as the result of
+ *		Q3Matrix4x4_SetQuaternion.
+ *
+ *		<em>This function is not available in QD3D.</em>
+ *
+ *  @param outMatrices      Array of matrices to set.
+ *  @param quaternions      Array of rotations.
+ *  @param scales           Array of scale factors, or NULL for no scaling.
+ *  @param translations     Array of translations, or NULL for no translation.
+ *  @param numMatrices      How many matrices to set.
+ *  @result                 Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3Matrix4x4_SetQuaternionArray (
+    TQ3Matrix4x4                  * _Nullable outMatrices,
+    const TQ3Quaternion           * _Nullable quaternions,
+    const TQ3Vector3D             * _Nullable scales,
+    const TQ3Vector3D             * _Nullable translations,
+    TQ3Uns32                      numMatrices
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
 /*!
  *  @function
  *      Q3Matrix3x3_Copy
@@ -3006,6 +3115,84 @@ Q3Matrix4x4_Multiply (
 
 
 
+/*!
+ *  @function
+ *      Q3Matrix4x4_MultiplyArray
+ *  @discussion
+ *		Multiply pairs of 4x4 matrices from two arrays.
+ *
+ *		When you have many matrices to multiply, this is a more efficient
+ *		alternative to calling Q3Matrix4x4_Multiply repeatedly.  A struct size
+ *		of 0 uses the same matrix for every pair, so for example a whole array
+ *		of local matrices can be multiplied by one parent matrix.
+ *
+ *		<em>This function is not available in QD3D.</em>
+ *
+ *  @param inMatrices1      Array of first matrices.  Must not be NULL unless numMatrices == 0.
+ *  @param inMatrices2      Array of second matrices.  Must not be NULL unless numMatrices == 0.
+ *  @param outMatrices      Array of matrices to receive the products (each may be the
+ *                          same as either of its inputs).
+ *  @param numMatrices      How many products to compute.
+ *  @param inStructSize1    Distance between elements of the first array, typically
+ *                          sizeof(TQ3Matrix4x4), or 0.
+ *  @param inStructSize2    Distance between elements of the second array, typically
+ *                          sizeof(TQ3Matrix4x4), or 0.
+ *  @param outStructSize    Size of one element of the output array, typically
+ *                          sizeof(TQ3Matrix4x4).
+ *  @result                 kQ3Success or some error code.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3Matrix4x4_MultiplyArray (
+    const TQ3Matrix4x4            * _Nullable inMatrices1,
+    const TQ3Matrix4x4            * _Nullable inMatrices2,
+    TQ3Matrix4x4                  * _Nullable outMatrices,
+    TQ3Uns32                      numMatrices,
+    TQ3Uns32                      inStructSize1,
+    TQ3Uns32                      inStructSize2,
+    TQ3Uns32                      outStructSize
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
+/*!
+ *  @function
+ *      Q3Matrix4x4_ComposeHierarchy
+ *  @discussion
+ *		Concatenate the local matrices of a hierarchy, such as the bones of
+ *		a skeleton, into matrices relative to its roots.
+ *
+ *		Each node's result is its local matrix times the result of its parent.
+ *		Parents must come before their children in the arrays, and a root has
+ *		the parent index kQ3ArrayIndexNULL.  The output array may be the same
+ *		as the input array.
+ *
+ *		<em>This function is not available in QD3D.</em>
+ *
+ *  @param localMatrices    Array of matrices relative to each node's parent.
+ *  @param parentIndices    Array of parent indices.
+ *  @param numMatrices      Number of nodes in the hierarchy.
+ *  @param outMatrices      Array of matrices to receive the composed matrices.
+ *  @result                 kQ3Success, or kQ3Failure if a parent index does not
+ *                          refer to an earlier node.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3Matrix4x4_ComposeHierarchy (
+    const TQ3Matrix4x4            * _Nullable localMatrices,
+    const TQ3Uns32                * _Nullable parentIndices,
+    TQ3Uns32                      numMatrices,
+    TQ3Matrix4x4                  * _Nullable outMatrices
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
 
 
 //=============================================================================
@@ -3424,6 +3611,72 @@ Q3Quaternion_InterpolateLinear (
 
 
 
+/*!
+ *  @function
+ *      Q3Quaternion_InterpolateFastArray
+ *  @discussion
+ *      Compute straight linear interpolations between pairs of quaternions.
+ *
+ *		Each result is the same as that of Q3Quaternion_InterpolateFast, but
+ *		when you have many quaternions to interpolate this is much faster than
+ *		calling it repeatedly.
+ *
+ *		<em>This function is not available in QD3D.</em>
+ *
+ *  @param q1               Array of first quaternions.
+ *  @param q2               Array of second quaternions.
+ *  @param t                Array of fractions (0-1) of the way from q1 to q2.
+ *  @param numQuaternions   How many quaternions to interpolate.
+ *  @param results          Array of quaternions to set (may be the same as q1 and/or q2).
+ *  @result                 Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3Quaternion_InterpolateFastArray (
+    const TQ3Quaternion           * _Nullable q1,
+    const TQ3Quaternion           * _Nullable q2,
+    const float                   * _Nullable t,
+    TQ3Uns32                      numQuaternions,
+    TQ3Quaternion                 * _Nullable results
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
+/*!
+ *  @function
+ *      Q3Quaternion_InterpolateLinearArray
+ *  @discussion
+ *      Compute spherical linear interpolations between pairs of quaternions.
+ *
+ *		Each result is the same as that of Q3Quaternion_InterpolateLinear.
+ *
+ *		<em>This function is not available in QD3D.</em>
+ *
+ *  @param q1               Array of first quaternions.
+ *  @param q2               Array of second quaternions.
+ *  @param t                Array of fractions (0-1) of the way from q1 to q2.
+ *  @param numQuaternions   How many quaternions to interpolate.
+ *  @param results          Array of quaternions to set (may be the same as q1 and/or q2).
+ *  @result                 Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3Quaternion_InterpolateLinearArray (
+    const TQ3Quaternion           * _Nullable q1,
+    const TQ3Quaternion           * _Nullable q2,
+    const float                   * _Nullable t,
+    TQ3Uns32                      numQuaternions,
+    TQ3Quaternion                 * _Nullable results
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
 /*!
  *  @function
  *      Q3Quaternion_GetAxisAndAngle
@@ -3998,6 +4251,352 @@ Q3Ray3D_IntersectTriangle (
 
 
 
+//=============================================================================
+//      Structure of arrays functions
+//-----------------------------------------------------------------------------
+/*!
+	@functiongroup Structure of arrays functions
+*/
+
+/*!
+ *  @function
+ *      Q3Point3DArraySoA_Allocate
+ *  @discussion
+ *      Allocate the coordinate arrays of a TQ3Point3DArraySoA.
+ *
+ *      Each coordinate array starts on a 32 byte boundary and has room for
+ *      a multiple of 8 floats.  The contents are not initialized.
+ *
+ *		<em>This function is not available in QD3D.</em>
+ *
+ *  @param numPoints        The number of points.
+ *  @param outArray         Receives the arrays.  Release them with
+ *                          Q3Point3DArraySoA_Free.
+ *  @result                 Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3Point3DArraySoA_Allocate (
+    TQ3Uns32                      numPoints,
+    TQ3Point3DArraySoA            * _Nonnull outArray
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
+/*!
+ *  @function
+ *      Q3Point3DArraySoA_Free
+ *  @discussion
+ *      Release arrays allocated by Q3Point3DArraySoA_Allocate, and clear the
+ *      structure.  Arrays not allocated by Quesa are not freed.
+ *
+ *		<em>This function is not available in QD3D.</em>
+ *
+ *  @param ioArray          The arrays to release.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( void  )
+Q3Point3DArraySoA_Free (
+    TQ3Point3DArraySoA            * _Nonnull ioArray
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
+/*!
+ *  @function
+ *      Q3Point3DArraySoA_SetFromPoints3D
+ *  @discussion
+ *      Copy an array of TQ3Point3D, such as the points of a TriMesh, into
+ *      the coordinate arrays.
+ *
+ *      ioArray->count points are copied.  The function may also be used
+ *      with arrays of TQ3Vector3D.
+ *
+ *		<em>This function is not available in QD3D.</em>
+ *
+ *  @param inPoints         The points to copy.
+ *  @param inStructSize     Size of one element of the input array, typically
+ *                          sizeof(TQ3Point3D).
+ *  @param ioArray          The arrays to fill.
+ *  @result                 Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3Point3DArraySoA_SetFromPoints3D (
+    const TQ3Point3D              * _Nullable inPoints,
+    TQ3Uns32                      inStructSize,
+    const TQ3Point3DArraySoA      * _Nonnull ioArray
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
+/*!
+ *  @function
+ *      Q3Point3DArraySoA_GetPoints3D
+ *  @discussion
+ *      Copy the coordinate arrays into an array of TQ3Point3D, such as the
+ *      points of a TriMesh.
+ *
+ *		<em>This function is not available in QD3D.</em>
+ *
+ *  @param inArray          The arrays to copy.
+ *  @param outPoints        Receives inArray->count points.
+ *  @param outStructSize    Size of one element of the output array, typically
+ *                          sizeof(TQ3Point3D).
+ *  @result                 Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3Point3DArraySoA_GetPoints3D (
+    const TQ3Point3DArraySoA      * _Nonnull inArray,
+    TQ3Point3D                    * _Nullable outPoints,
+    TQ3Uns32                      outStructSize
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
+/*!
+ *  @function
+ *      Q3Point3DArraySoA_TransformPoints
+ *  @discussion
+ *      Transform points by a 4x4 matrix.
+ *
+ *      The results are the same as those of Q3Point3D_To3DTransformArray.
+ *
+ *		<em>This function is not available in QD3D.</em>
+ *
+ *  @param inArray          The points to transform.
+ *  @param matrix4x4        Transformation matrix.
+ *  @param outArray         Receives the points (may be the same as inArray).
+ *                          Must have the same count as inArray.
+ *  @result                 Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3Point3DArraySoA_TransformPoints (
+    const TQ3Point3DArraySoA      * _Nonnull inArray,
+    const TQ3Matrix4x4            * _Nonnull matrix4x4,
+    const TQ3Point3DArraySoA      * _Nonnull outArray
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
+/*!
+ *  @function
+ *      Q3Point3DArraySoA_TransformVectors
+ *  @discussion
+ *      Transform vectors by a 4x4 matrix, ignoring translation.
+ *
+ *      The results are the same as those of Q3Vector3D_To3DTransformArray.
+ *
+ *		<em>This function is not available in QD3D.</em>
+ *
+ *  @param inArray          The vectors to transform.
+ *  @param matrix4x4        Transformation matrix.
+ *  @param outArray         Receives the vectors (may be the same as inArray).
+ *                          Must have the same count as inArray.
+ *  @result                 Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3Point3DArraySoA_TransformVectors (
+    const TQ3Point3DArraySoA      * _Nonnull inArray,
+    const TQ3Matrix4x4            * _Nonnull matrix4x4,
+    const TQ3Point3DArraySoA      * _Nonnull outArray
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
+/*!
+ *  @function
+ *      Q3Point3DArraySoA_ProjectTo2D
+ *  @discussion
+ *      Transform points by a 4x4 matrix and keep the x and y coordinates,
+ *      for example to project local points to window coordinates.
+ *
+ *      The results are the same as transforming with
+ *      Q3Point3D_To3DTransformArray and dropping z.
+ *
+ *		<em>This function is not available in QD3D.</em>
+ *
+ *  @param inArray          The points to transform.
+ *  @param matrix4x4        Transformation matrix.
+ *  @param outPoints        Receives inArray->count 2D points.
+ *  @param outStructSize    Size of one element of the output array, typically
+ *                          sizeof(TQ3Point2D).
+ *  @result                 Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3Point3DArraySoA_ProjectTo2D (
+    const TQ3Point3DArraySoA      * _Nonnull inArray,
+    const TQ3Matrix4x4            * _Nonnull matrix4x4,
+    TQ3Point2D                    * _Nullable outPoints,
+    TQ3Uns32                      outStructSize
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
+/*!
+ *  @function
+ *      Q3Point3DArraySoA_Normalize
+ *  @discussion
+ *      Normalize vectors, with the same results as Q3FastVector3D_Normalize.
+ *
+ *		<em>This function is not available in QD3D.</em>
+ *
+ *  @param inArray          The vectors to normalize.
+ *  @param outArray         Receives the vectors (may be the same as inArray).
+ *                          Must have the same count as inArray.
+ *  @result                 Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3Point3DArraySoA_Normalize (
+    const TQ3Point3DArraySoA      * _Nonnull inArray,
+    const TQ3Point3DArraySoA      * _Nonnull outArray
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
+/*!
+ *  @function
+ *      Q3Point3DArraySoA_Dot
+ *  @discussion
+ *      Compute the dot products of corresponding vectors of two arrays.
+ *
+ *		<em>This function is not available in QD3D.</em>
+ *
+ *  @param inArray1         The first vectors.
+ *  @param inArray2         The second vectors.  Must have the same count as
+ *                          inArray1.
+ *  @param outDotProducts   Receives inArray1->count dot products.
+ *  @result                 Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3Point3DArraySoA_Dot (
+    const TQ3Point3DArraySoA      * _Nonnull inArray1,
+    const TQ3Point3DArraySoA      * _Nonnull inArray2,
+    float                         * _Nullable outDotProducts
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
+/*!
+ *  @function
+ *      Q3Point3DArraySoA_Cross
+ *  @discussion
+ *      Compute the cross products of corresponding vectors of two arrays.
+ *
+ *		<em>This function is not available in QD3D.</em>
+ *
+ *  @param inArray1         The first vectors.
+ *  @param inArray2         The second vectors.  Must have the same count as
+ *                          inArray1.
+ *  @param outArray         Receives the cross products (may be the same as
+ *                          either input).  Must have the same count as
+ *                          inArray1.
+ *  @result                 Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3Point3DArraySoA_Cross (
+    const TQ3Point3DArraySoA      * _Nonnull inArray1,
+    const TQ3Point3DArraySoA      * _Nonnull inArray2,
+    const TQ3Point3DArraySoA      * _Nonnull outArray
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
+/*!
+ *  @function
+ *      Q3Point3DArraySoA_DistanceToPlane
+ *  @discussion
+ *      Evaluate a plane equation at each point.
+ *
+ *      The result for each point is normal . point + constant, which is the
+ *      signed distance to the plane when the normal has unit length.
+ *
+ *		<em>This function is not available in QD3D.</em>
+ *
+ *  @param inArray          The points.
+ *  @param plane            The plane.
+ *  @param outDistances     Receives inArray->count distances.
+ *  @result                 Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3Point3DArraySoA_DistanceToPlane (
+    const TQ3Point3DArraySoA      * _Nonnull inArray,
+    const TQ3PlaneEquation        * _Nonnull plane,
+    float                         * _Nullable outDistances
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
+/*!
+ *  @function
+ *      Q3Point3DArraySoA_GetBoundingBox
+ *  @discussion
+ *      Find the bounding box of the points.
+ *
+ *      The result is the same as that of Q3BoundingBox_SetFromPoints3D.
+ *
+ *		<em>This function is not available in QD3D.</em>
+ *
+ *  @param inArray          The points.
+ *  @param outBounds        Receives the bounding box, which is empty if
+ *                          there are no points.
+ *  @result                 Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3Point3DArraySoA_GetBoundingBox (
+    const TQ3Point3DArraySoA      * _Nonnull inArray,
+    TQ3BoundingBox                * _Nonnull outBounds
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
+
+
 //=============================================================================
 //      General math functions
 //-----------------------------------------------------------------------------
@@ -4057,6 +4656,57 @@ Q3Math_InvSquareRoot (
 
 
 
+/*!
+ *  @function
+ *      Q3Math_SetKernelSet
+ *  @discussion
+ *      Choose the implementation used by the math array functions.
+ *
+ *      By default the fastest implementation supported by the processor is
+ *      chosen when first needed.  Choosing a particular one is mainly useful
+ *      to compare their speed or their results.
+ *
+ *	@availability			This function is not available in QD3D.
+ *
+ *  @param kernelSet        The implementation to use.
+ *  @result                 Success, or failure if the processor or the build
+ *                          does not support the implementation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3Math_SetKernelSet (
+    TQ3MathKernelSet              kernelSet
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
+/*!
+ *  @function
+ *      Q3Math_GetKernelSet
+ *  @discussion
+ *      Get the implementation used by the math array functions.
+ *
+ *      The result is never kQ3MathKernelSetAutomatic, it is the implementation
+ *      that was actually chosen.
+ *
+ *	@availability			This function is not available in QD3D.
+ *
+ *  @result                 The implementation in use.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3MathKernelSet  )
+Q3Math_GetKernelSet (
+    void
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
 
 
 //=============================================================================
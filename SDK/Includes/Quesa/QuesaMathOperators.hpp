@@ -291,6 +291,16 @@ inline TQ3Matrix4x4& operator*=( TQ3Matrix4x4& ioMat, const TQ3Matrix4x4& inMat2
 	return ioMat;
 }
 
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+// matrices[i] * matrix, for an array of matrices
+inline void Q3Multiply( const TQ3Matrix4x4* inMats, TQ3Uns32 inCount,
+						const TQ3Matrix4x4& inMat2, TQ3Matrix4x4* outMats )
+{
+	Q3Matrix4x4_MultiplyArray( inMats, &inMat2, outMats, inCount,
+		sizeof(TQ3Matrix4x4), 0, sizeof(TQ3Matrix4x4) );
+}
+#endif
+
 // pt * matrix (transform point)
 inline TQ3Point3D operator*( const TQ3Point3D& inPt, const TQ3Matrix4x4& inMat )
 {
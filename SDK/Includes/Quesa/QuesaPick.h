@@ -188,6 +188,12 @@ typedef TQ3Uns32 TQ3PickDetail;
  *  @discussion
  *      Describes the common state for a pick object.
  *
+ *      A pick sorted near to far which returns only 1 hit just keeps the
+ *      nearest hit.  Quesa recognises this case: geometry which cannot be
+ *      nearer than the best hit so far is skipped, and the hit details are
+ *      only computed for hits that improve on it, so this is much cheaper
+ *      than collecting every hit.
+ *
  *  @field sort             The type of sorting, if any, to performed on the results.
  *  @field mask             The type of pick information to be returned.
  *  @field numHitsToReturn  The number of hits to return. Set to <code>kQ3ReturnAllHits</code>
@@ -257,6 +263,35 @@ typedef struct TQ3WorldRayPickData {
 } TQ3WorldRayPickData;
 
 
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+/*!
+ *  @struct
+ *      TQ3WorldRayBatchPickData
+ *  @discussion
+ *      Describes the state for a world-ray batch pick object.
+ *
+ *		The <code>sort</code> and <code>numHitsToReturn</code> fields of the
+ *		common state are ignored, since a batch pick keeps the nearest hit
+ *		for each ray.
+ *
+ *		<em>This structure is not available in QD3D.</em>
+ *
+ *  @field data             The common state for the pick.
+ *  @field numRays          The number of rays.
+ *  @field rays             The pick rays in world coordinates.  The pick
+ *							keeps its own copy of the rays, with normalized
+ *							directions.
+ */
+typedef struct TQ3WorldRayBatchPickData {
+    TQ3PickData                                 data;
+    TQ3Uns32                                    numRays;
+    const TQ3Ray3D                              * _Nullable rays;
+} TQ3WorldRayBatchPickData;
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
 /*!
  *  @struct
  *      TQ3HitPath
@@ -868,6 +903,98 @@ Q3WorldRayPick_SetData (
     const TQ3WorldRayPickData     * _Nonnull data
 );
 
+
+
+/*!
+	@functiongroup	World Ray Batch Picking
+*/
+
+/*!
+ *  @function
+ *      Q3WorldRayBatchPick_New
+ *  @discussion
+ *      Create a new world-ray batch pick object.
+ *
+ *		A batch pick finds the nearest surface hit by each of many rays in a
+ *		single traversal of the model, which is much cheaper than running a
+ *		world-ray pick for each ray.  Rays are tested against bounds and
+ *		triangles four at a time, and geometry is tested through its TriMesh
+ *		or triangle decomposition.  Points, lines and markers are ignored, as
+ *		a ray without a tolerance cannot hit them.
+ *
+ *		The hit list of a batch pick has one entry for each ray, in the
+ *		order of the rays, so <code>Q3Pick_GetNumHits</code> returns the
+ *		number of rays.  The entry for a ray that hit nothing has an empty
+ *		valid mask.  Hit details are obtained with
+ *		<code>Q3Pick_GetPickDetailData</code> as for other picks, and hit
+ *		distances are measured from the origin of each ray.  Rays with a zero
+ *		direction hit nothing.
+ *
+ *		<em>This function is not available in QD3D.</em>
+ *
+ *  @param data             The data for the pick object.
+ *  @result                 The new pick object.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3PickObject _Nullable )
+Q3WorldRayBatchPick_New (
+    const TQ3WorldRayBatchPickData * _Nonnull data
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
+/*!
+ *  @function
+ *      Q3WorldRayBatchPick_GetNumRays
+ *  @discussion
+ *      Get the number of rays of a world-ray batch pick object.
+ *
+ *		<em>This function is not available in QD3D.</em>
+ *
+ *  @param pick             The pick object to query.
+ *  @param numRays          Receives the number of rays.
+ *  @result                 Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3WorldRayBatchPick_GetNumRays (
+    TQ3PickObject _Nonnull                pick,
+    TQ3Uns32                      * _Nonnull numRays
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
+/*!
+ *  @function
+ *      Q3WorldRayBatchPick_GetRay
+ *  @discussion
+ *      Get one of the rays of a world-ray batch pick object.  The direction
+ *		of the ray is normalized.
+ *
+ *		<em>This function is not available in QD3D.</em>
+ *
+ *  @param pick             The pick object to query.
+ *  @param index            The index of the ray.
+ *  @param ray              Receives the ray.
+ *  @result                 Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3WorldRayBatchPick_GetRay (
+    TQ3PickObject _Nonnull                pick,
+    TQ3Uns32                              index,
+    TQ3Ray3D                      * _Nonnull ray
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
 /*!
 	@functiongroup	Object Parts
 */
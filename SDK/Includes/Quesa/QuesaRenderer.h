@@ -123,6 +123,14 @@ enum QUESA_ENUM_BASE(TQ3Int32)
 					for a TriMesh that lacks one.  Only used by the OpenGL
 					renderer.  Data type: TQ3Boolean.  Default value: kQ3True.
 
+	@constant	kQ3RendererPropertyAutomaticRenderOrder
+					Whether a large TriMesh should be reordered with
+					Q3TriMesh_OptimizeForRendering and drawn as a triangle list
+					rather than a computed triangle strip.  TriMeshes which
+					already have a triangle strip element are left alone.
+					Only used by the OpenGL renderer.  Data type: TQ3Boolean.
+					Default value: kQ3True.
+
 	@constant	kQ3RendererPropertyPerPixelLighting
 					Whether we should used per-pixel lighting if possible.
 					OBSOLETE, now the OpenGL renderer always uses a
@@ -286,6 +294,7 @@ enum QUESA_ENUM_BASE(TQ3Int32)
 enum QUESA_ENUM_BASE(TQ3Int32)
 {
 	kQ3RendererPropertyAutomaticTriangleStrips      = Q3_OBJECT_TYPE('a', 't', 'r', 's'),
+	kQ3RendererPropertyAutomaticRenderOrder         = Q3_OBJECT_TYPE('a', 'r', 'o', 'r'),
 	kQ3RendererPropertyPerPixelLighting             = Q3_OBJECT_TYPE('p', 'p', 'x', 'l'),
 	kQ3RendererPropertyConvertToPremultipliedAlpha	= Q3_OBJECT_TYPE('c', 'p', 'm', 'a'),
 	kQ3RendererPropertyShadows                      = Q3_OBJECT_TYPE('s', 'h', 'd', 'w'),
@@ -986,6 +995,13 @@ typedef Q3_CALLBACK_API_C(TQ3Status,           TQ3XRendererSubmitGeometryMethod)
  *          kQ3GeometryTypeMarker
  *          kQ3GeometryTypePixmapMarker
  *
+ *      A renderer which can draw many copies of a geometry in one call may return
+ *      a method for kQ3GeometryTypeInstanceArray.  The public data is then a
+ *      TQ3InstanceArrayData whose instances have already been culled against the
+ *      view frustum, and whose transforms are relative to the current local to
+ *      world matrix.  If no such method is returned, Quesa submits each visible
+ *      instance to the renderer in turn.
+ *
  *      This method is required.
  *
  *  @param geometryType     The geometry type whose submit method is requested.
@@ -85,6 +85,11 @@ extern "C" {
  *  @discussion
  *      Subdivision methods.
  *
+ *      NURB patches are subdivided adaptively under the world-space and
+ *      screen-space methods: the size is the largest distance allowed between
+ *      the surface and its triangles, so flat regions get few triangles and
+ *      curved regions many.
+ *
  *  @constant kQ3SubdivisionMethodConstant      Surfaces are divided into the specified
  *                                              number of segments.
  *  @constant kQ3SubdivisionMethodWorldSpace    Surfaces are divided into segments smaller
@@ -308,6 +308,37 @@ Q3MatrixTransform_Get (
 );
 
 
+
+/*!
+ *  @function
+ *      Q3MatrixTransform_SetArray
+ *  @discussion
+ *      Change the matrices of many matrix transforms at once.
+ *
+ *      Every transform is checked before any is changed, so on failure none
+ *      of them have been changed.  This is intended for animation, where many
+ *      transforms change every frame: it avoids the checks and edit overhead
+ *      of calling Q3MatrixTransform_Set for each one.
+ *
+ *      <em>This function is not available in QD3D.</em>
+ *
+ *  @param numTransforms    How many transforms to change.
+ *  @param transforms       Array of matrix transform objects.
+ *  @param matrices         Array of new matrices, one per transform.
+ *  @result                 Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3MatrixTransform_SetArray (
+    TQ3Uns32                              numTransforms,
+    const TQ3TransformObject _Nonnull * _Nullable transforms,
+    const TQ3Matrix4x4            * _Nullable matrices
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
 /*!
 	@functiongroup Rotate
 */
@@ -1051,6 +1082,37 @@ Q3QuaternionTransform_Get (
 );
 
 
+
+/*!
+ *  @function
+ *      Q3QuaternionTransform_SetArray
+ *  @discussion
+ *      Change the quaternions of many quaternion transforms at once.
+ *
+ *      Every transform is checked before any is changed, so on failure none
+ *      of them have been changed.  This is intended for animation, where many
+ *      transforms change every frame: it avoids the checks and edit overhead
+ *      of calling Q3QuaternionTransform_Set for each one.
+ *
+ *      <em>This function is not available in QD3D.</em>
+ *
+ *  @param numTransforms    How many transforms to change.
+ *  @param transforms       Array of quaternion transform objects.
+ *  @param quaternions      Array of new quaternions, one per transform.
+ *  @result                 Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3QuaternionTransform_SetArray (
+    TQ3Uns32                              numTransforms,
+    const TQ3TransformObject _Nonnull * _Nullable transforms,
+    const TQ3Quaternion           * _Nullable quaternions
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
 /*!
 	@functiongroup Reset
 */
@@ -817,6 +817,180 @@ Q3View_AllowAllGroupCulling (
 
 
 
+/*!
+ *  @function
+ *      Q3View_SetLODBias
+ *  @discussion
+ *      Set the level of detail bias of a view.
+ *
+ *		LOD display groups choose a representation by comparing the window
+ *		area they cover with their thresholds.  That area is multiplied by
+ *		the LOD bias of the view first, so a bias above 1 gives more detailed
+ *		representations and a bias below 1 gives less detailed ones.  The
+ *		default bias is 1.
+ *
+ *      <em>This function is not available in QD3D.</em>
+ *
+ *  @param view             The view to update.
+ *  @param bias             The new LOD bias.
+ *  @result                 Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3View_SetLODBias (
+    TQ3ViewObject _Nonnull                view,
+    float                         bias
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
+/*!
+ *  @function
+ *      Q3View_GetLODBias
+ *  @discussion
+ *      Get the level of detail bias of a view.
+ *
+ *      <em>This function is not available in QD3D.</em>
+ *
+ *  @param view             The view to query.
+ *  @param bias             Receives the LOD bias.
+ *  @result                 Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3View_GetLODBias (
+    TQ3ViewObject _Nonnull                view,
+    float                         * _Nonnull bias
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
+/*!
+ *  @function
+ *      Q3View_AddMultiViewMember
+ *  @discussion
+ *      Add a member view to a multi-view.
+ *
+ *		A view with members becomes a multi-view: a single rendering loop on
+ *		it draws the same scene into every member, each with its own camera,
+ *		draw context and renderer.  Starting a rendering loop on the multi-view
+ *		starts each member, and ending it ends each member.  Members which
+ *		ask for another pass take part in the next pass, the others drop out.
+ *
+ *		The scene is traversed only once per pass.  Display groups are culled
+ *		against the frustum of every member in one visit, and their contents
+ *		are then forwarded only to the members that can see them.  Geometry,
+ *		transforms, styles and LOD display groups are forwarded to each of
+ *		those members.
+ *
+ *		Members should not share a draw context.  The camera, renderer and
+ *		draw context of the multi-view itself are not used, so state queries
+ *		during submission should be made on the member views.
+ *
+ *		A multi-view can hold up to 32 members.  Members can not be
+ *		multi-views themselves.  Views are not reference counted, so each
+ *		member must stay alive until it is removed or the multi-view is
+ *		disposed.  Members can not be changed during a rendering loop.
+ *
+ *      <em>This function is not available in QD3D.</em>
+ *
+ *  @param view             The multi-view to update.
+ *  @param member           The view to add.
+ *  @result                 Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3View_AddMultiViewMember (
+    TQ3ViewObject _Nonnull                view,
+    TQ3ViewObject _Nonnull                member
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
+/*!
+ *  @function
+ *      Q3View_RemoveAllMultiViewMembers
+ *  @discussion
+ *      Remove all members from a multi-view, making it an ordinary view again.
+ *
+ *      <em>This function is not available in QD3D.</em>
+ *
+ *  @param view             The multi-view to update.
+ *  @result                 Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3View_RemoveAllMultiViewMembers (
+    TQ3ViewObject _Nonnull                view
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
+/*!
+ *  @function
+ *      Q3View_CountMultiViewMembers
+ *  @discussion
+ *      Count the members of a multi-view.
+ *
+ *      <em>This function is not available in QD3D.</em>
+ *
+ *  @param view             The view to query.
+ *  @param count            Receives the number of members.
+ *  @result                 Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3View_CountMultiViewMembers (
+    TQ3ViewObject _Nonnull                view,
+    TQ3Uns32                      * _Nonnull count
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
+/*!
+ *  @function
+ *      Q3View_GetMultiViewMember
+ *  @discussion
+ *      Get a member of a multi-view.
+ *
+ *		The member is not retained, since views are not reference counted.
+ *
+ *      <em>This function is not available in QD3D.</em>
+ *
+ *  @param view             The view to query.
+ *  @param index            The index of the member, from 0 to one less than
+ *                          the member count.
+ *  @param member           Receives the member view.
+ *  @result                 Success or failure of the operation.
+ */
+#if QUESA_ALLOW_QD3D_EXTENSIONS
+
+Q3_EXTERN_API_C ( TQ3Status  )
+Q3View_GetMultiViewMember (
+    TQ3ViewObject _Nonnull                view,
+    TQ3Uns32                      index,
+    TQ3ViewObject _Nullable       * _Nonnull member
+);
+
+#endif // QUESA_ALLOW_QD3D_EXTENSIONS
+
+
+
 /*!
  *  @function
  *      Q3View_TransformLocalToWorld